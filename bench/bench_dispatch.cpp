@@ -0,0 +1,167 @@
+/// Per-sample cost of virtual, static (CRTP) and type-erased evaluation
+///
+/// ```
+/// $ make bench OPTFLAGS=-O2
+/// $ ./bin/bench_dispatch [axes] [rate] [seconds]
+/// ```
+///
+/// - axes    : the number of axes (default: 32)
+/// - rate    : control rate [Hz] (default: 4000)
+/// - seconds : measured duration of the motion [s] (default: 60)
+///
+/// Every axis is a cubic spline of the same 8 points, evaluated at every control cycle
+/// through SplineInterpolator::pop() (virtual), FixedCubicSpline<8>::evaluate() (static),
+/// its position-only evaluate<OUTPUT_POS>(), Trajectory::evaluate() (type-erased)
+/// and TrajectoryLUT::evaluate<OUTPUT_POS>() (pre-sampled table within 1.0e-9).
+/// The sums of positions are printed to keep the loops and to check that all paths
+/// give the same positions (the table within its deviation).
+#include "cubic_spline_interpolator.hpp"
+#include "fixed_spline.hpp"
+#include "trajectory.hpp"
+#include "trajectory_lut.hpp"
+
+#include <time.h>
+#include <math.h>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace interp;
+
+/// the number of points of each axis
+#define POINT_NUM 8
+
+/// current monotonic time
+/// @return [sec]
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec + ts.tv_nsec * 1.0e-9;
+}
+
+/// print the result of a measurement
+/// @param[in] name       name of the evaluation path
+/// @param[in] sec        elapsed time [s]
+/// @param[in] sample_num the number of evaluated samples
+/// @param[in] sum        sum of positions
+static void print_result( const char* name, const double& sec,
+                          const std::size_t& sample_num, const double& sum ) {
+  std::printf( "%-12s : %8.4f [s] %8.2f [ns/sample] sum %.15e\n",
+               name, sec, sec / sample_num * 1.0e9, sum );
+}
+
+
+int main( int argc, char* argv[] ) {
+  const std::size_t axis_num =
+    ( argc > 1 ) ? (std::size_t)std::atol( argv[1] ) : 32;
+  const double rate =
+    ( argc > 2 ) ? std::atof( argv[2] ) : 4000.0;
+  const double duration =
+    ( argc > 3 ) ? std::atof( argv[3] ) : 60.0;
+  if( axis_num == 0 || rate <= 0.0 || duration <= 0.0 ) {
+    std::fprintf( stderr, "axes, rate and seconds must be positive\n" );
+    return 1;
+  }
+
+  double times[POINT_NUM]     = {};
+  double positions[POINT_NUM] = {};
+  TPQueue target_tp_queue;
+  for( std::size_t i=0; i < POINT_NUM; i++ ) {
+    times[i]     = duration / ( POINT_NUM - 1 ) * i;
+    positions[i] = 10.0 * sin( 0.7 * i );
+    target_tp_queue.push( TimePosition( times[i], positions[i] ) );
+  }
+  times[POINT_NUM - 1] = duration;
+
+  std::vector<CubicSplineInterpolator> interpolators( axis_num );
+  std::vector<SplineInterpolator*>     virtual_axes;
+  std::vector<FixedCubicSpline<POINT_NUM> > static_axes( axis_num );
+  std::vector<Trajectory>              erased_axes;
+  std::vector<TrajectoryLUT>           lut_axes( axis_num );
+  for( std::size_t axis=0; axis < axis_num; axis++ ) {
+    if( interpolators[axis].generate_path( target_tp_queue ) != SPLINE_SUCCESS
+        || static_axes[axis].generate_path( times, positions ) != SPLINE_SUCCESS ) {
+      std::fprintf( stderr, "failed to generate\n" );
+      return 1;
+    }
+    virtual_axes.push_back( &interpolators[axis] );
+    erased_axes.push_back( Trajectory( static_axes[axis] ) );
+    if( lut_axes[axis].build_adaptive( interpolators[axis], duration / 64, 1.0e-9 ) != SPLINE_SUCCESS ) {
+      std::fprintf( stderr, "failed to build the table\n" );
+      return 1;
+    }
+  }
+
+  const double dT = 1.0 / rate;
+  const std::size_t cycle_num = (std::size_t)( duration * rate );
+  const std::size_t sample_num = cycle_num * axis_num;
+  std::printf( "%lu axes x %.0f [Hz] x %.1f [s] = %lu samples\n",
+               (unsigned long)axis_num, rate, duration, (unsigned long)sample_num );
+
+  // virtual call of SplineInterpolator::pop()
+  double sum = 0.0;
+  double start = now_sec();
+  for( std::size_t cycle=0; cycle < cycle_num; cycle++ ) {
+    const double t = dT * cycle;
+    for( std::size_t axis=0; axis < axis_num; axis++ ) {
+      sum += virtual_axes[axis]->pop( t ).P.pos;
+    }
+  }
+  print_result( "virtual", now_sec() - start, sample_num, sum );
+
+  // static dispatch of FixedCubicSpline<N>::evaluate()
+  sum = 0.0;
+  start = now_sec();
+  for( std::size_t cycle=0; cycle < cycle_num; cycle++ ) {
+    const double t = dT * cycle;
+    for( std::size_t axis=0; axis < axis_num; axis++ ) {
+      double pos = 0.0, vel = 0.0, acc = 0.0;
+      static_axes[axis].evaluate( t, pos, vel, acc );
+      sum += pos;
+    }
+  }
+  print_result( "static", now_sec() - start, sample_num, sum );
+
+  // static dispatch of FixedCubicSpline<N>::evaluate<OUTPUT_POS>() (position only)
+  sum = 0.0;
+  start = now_sec();
+  for( std::size_t cycle=0; cycle < cycle_num; cycle++ ) {
+    const double t = dT * cycle;
+    for( std::size_t axis=0; axis < axis_num; axis++ ) {
+      double pos = 0.0, vel = 0.0, acc = 0.0;
+      static_axes[axis].evaluate<OUTPUT_POS>( t, pos, vel, acc );
+      sum += pos;
+    }
+  }
+  print_result( "static pos", now_sec() - start, sample_num, sum );
+
+  // type-erased Trajectory::evaluate()
+  sum = 0.0;
+  start = now_sec();
+  for( std::size_t cycle=0; cycle < cycle_num; cycle++ ) {
+    const double t = dT * cycle;
+    for( std::size_t axis=0; axis < axis_num; axis++ ) {
+      double pos = 0.0, vel = 0.0, acc = 0.0;
+      erased_axes[axis].evaluate( t, pos, vel, acc );
+      sum += pos;
+    }
+  }
+  print_result( "type-erased", now_sec() - start, sample_num, sum );
+
+  // pre-sampled TrajectoryLUT::evaluate<OUTPUT_POS>() (position only)
+  sum = 0.0;
+  start = now_sec();
+  for( std::size_t cycle=0; cycle < cycle_num; cycle++ ) {
+    const double t = dT * cycle;
+    for( std::size_t axis=0; axis < axis_num; axis++ ) {
+      double pos = 0.0, vel = 0.0, acc = 0.0;
+      lut_axes[axis].evaluate<OUTPUT_POS>( t, pos, vel, acc );
+      sum += pos;
+    }
+  }
+  print_result( "lut pos", now_sec() - start, sample_num, sum );
+  std::printf( "lut: %lu entries, deviation %.3e\n",
+               (unsigned long)lut_axes[0].size(), lut_axes[0].max_deviation() );
+
+  return 0;
+}
@@ -0,0 +1,107 @@
+/// Baking many trajectories offline with SplineExecutor
+///
+/// ```
+/// $ make bench OPTFLAGS=-O2
+/// $ ./bin/bench_executor [axes] [threads] [samples]
+/// ```
+///
+/// - axes    : the number of trajectories (default: 2000)
+/// - threads : the maximum number of threads (default: 0 -> the number of processors)
+/// - samples : the number of samples of each trajectory (default: 2000)
+///
+/// Every axis is a cubic spline of 100 points of its own,
+/// and is baked by a GeneratePathJob followed by a SampleJob.
+/// The batch is executed with 1, 2, 4, ... threads up to the maximum.
+/// The sums of positions are printed to keep the loops and to compare the results.
+#include "cubic_spline_interpolator.hpp"
+#include "spline_executor.hpp"
+#include "spline_thread_pool.hpp"
+
+#include <time.h>
+#include <math.h>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace interp;
+
+/// the number of points of each axis
+#define POINT_NUM 100
+
+/// current monotonic time
+/// @return [sec]
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec + ts.tv_nsec * 1.0e-9;
+}
+
+
+int main( int argc, char* argv[] ) {
+  const std::size_t axis_num =
+    ( argc > 1 ) ? (std::size_t)std::atol( argv[1] ) : 2000;
+  std::size_t max_thread_num =
+    ( argc > 2 ) ? (std::size_t)std::atol( argv[2] ) : 0;
+  const std::size_t sample_num =
+    ( argc > 3 ) ? (std::size_t)std::atol( argv[3] ) : 2000;
+  if( axis_num == 0 || sample_num == 0 ) {
+    std::fprintf( stderr, "axes and samples must be positive\n" );
+    return 1;
+  }
+  if( max_thread_num == 0 ) {
+    max_thread_num = SplineThreadPool::hardware_concurrency();
+  }
+
+  std::vector<TPQueue> tp_queues( axis_num );
+  for( std::size_t axis=0; axis < axis_num; axis++ ) {
+    for( std::size_t i=0; i < POINT_NUM; i++ ) {
+      tp_queues[axis].push( TimePosition( 1.0 * i, 10.0 * sin( 0.7 * i + 0.001 * axis ) ) );
+    }
+  }
+  const double dT = ( POINT_NUM - 1.0 ) / sample_num;
+  std::vector<double> pos( axis_num * sample_num );
+  std::printf( "%lu axes x %lu samples\n", (unsigned long)axis_num, (unsigned long)sample_num );
+
+  double base_sec = 0.0;
+  for( std::size_t thread_num=1; thread_num <= max_thread_num; thread_num*=2 ) {
+    std::vector<CubicSplineInterpolator> interpolators( axis_num );
+    std::vector<SampleJob*>       sample_jobs( axis_num );
+    std::vector<GeneratePathJob*> generate_jobs( axis_num );
+    SplineExecutor executor( thread_num );
+    for( std::size_t axis=0; axis < axis_num; axis++ ) {
+      sample_jobs[axis]   = new SampleJob( interpolators[axis], 0.0, dT, sample_num,
+                                           &pos[axis * sample_num] );
+      generate_jobs[axis] = new GeneratePathJob( interpolators[axis], tp_queues[axis],
+                                                 sample_jobs[axis] );
+      executor.submit( *generate_jobs[axis] );
+    }
+
+    const double start = now_sec();
+    const RetCode retcode = executor.run_all();
+    const double sec = now_sec() - start;
+    if( retcode != SPLINE_SUCCESS ) {
+      std::fprintf( stderr, "failed to bake (%d)\n", (int)retcode );
+      return 1;
+    }
+    if( thread_num == 1 ) {
+      base_sec = sec;
+    }
+    std::size_t stolen_num = 0;
+    for( std::size_t i=0; i < executor.thread_num(); i++ ) {
+      stolen_num += executor.stolen_job_num( i );
+    }
+    double sum = 0.0;
+    for( std::size_t i=0; i < pos.size(); i++ ) {
+      sum += pos[i];
+    }
+    std::printf( "%2lu threads : %8.4f [s] x%5.2f stolen %6lu sum %.9e\n",
+                 (unsigned long)executor.thread_num(), sec, base_sec / sec,
+                 (unsigned long)stolen_num, sum );
+
+    for( std::size_t axis=0; axis < axis_num; axis++ ) {
+      delete generate_jobs[axis];
+      delete sample_jobs[axis];
+    }
+  }
+  return 0;
+}
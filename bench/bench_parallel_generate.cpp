@@ -0,0 +1,159 @@
+/// Scaling benchmark of parallel per-segment generation from TPVAQueue
+///
+/// ```
+/// $ make bench OPTFLAGS=-O2
+/// $ ./bin/bench_parallel_generate [max_cubic_segments] [max_trapezoid_segments] [max_threads]
+/// ```
+///
+/// - max_cubic_segments     : CubicSplineInterpolator is measured on 10^5 .. this (default: 10^7)
+/// - max_trapezoid_segments : TrapezoidalInterpolator is measured on 10^5 .. this (default: 10^6)
+/// - max_threads            : threads are doubled from 1 up to this (default: online processors)
+///
+/// Every parallel result is compared with the serial one at sampled times
+/// and reported as "identical" only when all samples match bit by bit.
+#include "cubic_spline_interpolator.hpp"
+#include "trapezoid_5251525_interpolator.hpp"
+#include "spline_thread_pool.hpp"
+
+#include <time.h>
+#include <math.h>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace interp;
+
+/// the number of sampled times to compare parallel and serial results
+#define SAMPLE_NUM 1000
+
+/// current monotonic time
+/// @return [sec]
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec + ts.tv_nsec * 1.0e-9;
+}
+
+/// make the target queue of segment_num segments (dT=1.0[s])
+/// @param[in] segment_num the number of segments
+/// @param[in] with_velocity true: sinusoidal velocity, false: zero velocity
+/// @return target Time, Position, Velocity queue
+static TPVAQueue make_target_tpva_queue( const std::size_t& segment_num,
+                                         const bool& with_velocity ) {
+  TPVAQueue target_tpva_queue;
+  for( std::size_t i=0; i <= segment_num; i++ ) {
+    const double pos = 10.0 * sin( 0.7 * i );
+    const double vel = with_velocity ? 7.0 * cos( 0.7 * i ) : 0.0;
+    target_tpva_queue.push_on_clocktime( (double)i, PosVelAcc( pos, vel, 0.0 ) );
+  }
+  return target_tpva_queue;
+}
+
+/// sample the generated path
+/// @param[in]  interpolator generated interpolator
+/// @param[in]  tf           finish time
+/// @param[out] out_samples  sampled TPVA
+static void sample_path( const SplineInterpolator& interpolator,
+                         const double& tf,
+                         std::vector<PosVelAcc>& out_samples ) {
+  out_samples.clear();
+  for( std::size_t i=0; i < SAMPLE_NUM; i++ ) {
+    const double t = tf * ( i + 0.5 ) / SAMPLE_NUM;
+    out_samples.push_back( interpolator.pop( t ).value );
+  }
+}
+
+/// compare sampled results bit by bit
+/// @return true if all samples are identical
+static bool is_identical( const std::vector<PosVelAcc>& a,
+                          const std::vector<PosVelAcc>& b ) {
+  if( a.size() != b.size() ) {
+    return false;
+  }
+  for( std::size_t i=0; i < a.size(); i++ ) {
+    if( a[i].pos != b[i].pos || a[i].vel != b[i].vel || a[i].acc != b[i].acc ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// measure generate_path() for 1 .. max_threads threads
+/// @param[in] name          name of the interpolator
+/// @param[in] interpolator  interpolator to measure
+/// @param[in] target_tpva_queue target queue
+/// @param[in] max_threads   the max number of threads
+static void measure( const char* name,
+                     SplineInterpolator& interpolator,
+                     const TPVAQueue& target_tpva_queue,
+                     const std::size_t& max_threads ) {
+  const std::size_t segment_num = target_tpva_queue.size() - 1;
+  const double tf = target_tpva_queue.back().time;
+
+  std::vector<PosVelAcc> serial_samples;
+  double serial_sec = 0.0;
+  for( std::size_t thread_num=1; thread_num <= max_threads; thread_num *= 2 ) {
+    SplineThreadPool* pool = NULL;
+    if( thread_num > 1 ) {
+      pool = new SplineThreadPool( thread_num );
+    }
+    interpolator.set_thread_pool( pool );
+
+    const double start_sec = now_sec();
+    const RetCode retcode = interpolator.generate_path( target_tpva_queue );
+    const double elapsed_sec = now_sec() - start_sec;
+
+    if( retcode != SPLINE_SUCCESS ) {
+      std::printf( "%-12s %10lu segments %3lu threads : failed (RetCode=%d)\n",
+                   name, (unsigned long)segment_num, (unsigned long)thread_num, retcode );
+    } else {
+      std::vector<PosVelAcc> samples;
+      sample_path( interpolator, tf, samples );
+      if( thread_num == 1 ) {
+        serial_samples = samples;
+        serial_sec     = elapsed_sec;
+      }
+      std::printf( "%-12s %10lu segments %3lu threads : %10.4f [s] %8.2f [Msegments/s]"
+                   " speedup %5.2f  %s\n",
+                   name, (unsigned long)segment_num, (unsigned long)thread_num,
+                   elapsed_sec, segment_num / elapsed_sec * 1.0e-6,
+                   serial_sec / elapsed_sec,
+                   is_identical( serial_samples, samples ) ? "identical" : "DIFFERENT" );
+    }
+
+    interpolator.set_thread_pool( NULL );
+    delete pool;
+  }
+}
+
+
+int main( int argc, char* argv[] ) {
+  const std::size_t max_cubic_segments =
+    ( argc > 1 ) ? (std::size_t)std::atol( argv[1] ) : 10000000;
+  const std::size_t max_trapezoid_segments =
+    ( argc > 2 ) ? (std::size_t)std::atol( argv[2] ) : 1000000;
+  const std::size_t max_threads =
+    ( argc > 3 ) ? (std::size_t)std::atol( argv[3] ) : SplineThreadPool::hardware_concurrency();
+
+  for( std::size_t segment_num=100000;
+       segment_num <= max_cubic_segments;
+       segment_num *= 10 ) {
+    const TPVAQueue target_tpva_queue = make_target_tpva_queue( segment_num, true );
+    CubicSplineInterpolator cubic;
+    measure( "cubic", cubic, target_tpva_queue, max_threads );
+  }
+
+  for( std::size_t segment_num=100000;
+       segment_num <= max_trapezoid_segments;
+       segment_num *= 10 ) {
+    const TPVAQueue target_tpva_queue = make_target_tpva_queue( segment_num, false );
+    TrapezoidConfigQueue trapzd_config_que;
+    for( std::size_t i=0; i < segment_num; i++ ) {
+      trapzd_config_que.push_back( TrapezoidConfig( 1200, 1200, 170, 0.8, 0.8, 0.5 ) );
+    }
+    TrapezoidalInterpolator trapezoid( trapzd_config_que );
+    measure( "trapezoid", trapezoid, target_tpva_queue, max_threads );
+  }
+
+  return 0;
+}
@@ -0,0 +1,131 @@
+/// Accuracy and speed benchmark of float vs double cubic splines
+///
+/// ```
+/// $ make bench OPTFLAGS=-O2
+/// $ ./bin/bench_scalar_type [max_points] [samples]
+/// ```
+///
+/// - max_points : the number of points is multiplied by 10 from 10^3 up to this (default: 10^6)
+/// - samples    : the number of samples of the whole path (default: 10^7)
+///
+/// For each scalar type, generate_path() and sample() are measured,
+/// and the max absolute error of float against double is reported.
+#include "cubic_spline_kernel.hpp"
+
+#include <time.h>
+#include <math.h>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace interp;
+
+/// current monotonic time
+/// @return [sec]
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec + ts.tv_nsec * 1.0e-9;
+}
+
+/// max absolute difference
+/// @param[in] a list of double
+/// @param[in] b list of float (same size as a)
+/// @return max |a[i] - b[i]|
+static double max_error( const std::vector<double>& a, const std::vector<float>& b ) {
+  double error = 0.0;
+  for( std::size_t i=0; i < a.size(); i++ ) {
+    const double diff = fabs( a[i] - b[i] );
+    if( diff > error ) {
+      error = diff;
+    }
+  }
+  return error;
+}
+
+/// Sampled path of scalar type T
+template<class T>
+struct SampledPath {
+  /// positions
+  std::vector<T> pos;
+  /// velocities
+  std::vector<T> vel;
+  /// accelerations
+  std::vector<T> acc;
+  /// elapsed time of generate_path() [s]
+  double generate_sec;
+  /// elapsed time of sample() [s]
+  double sample_sec;
+};
+
+/// generate and sample the path
+/// @param[in]  times       target times
+/// @param[in]  positions   target positions
+/// @param[in]  sample_num  the number of samples
+/// @param[out] out_path    sampled path
+/// @return false if failed to generate
+template<class T>
+static bool measure( const std::vector<double>& times,
+                     const std::vector<T>&      positions,
+                     const std::size_t&         sample_num,
+                     SampledPath<T>&            out_path ) {
+  BasicCubicSpline<T> spline;
+  double start_sec = now_sec();
+  if( spline.generate_path( times, positions ) != SPLINE_SUCCESS ) {
+    return false;
+  }
+  out_path.generate_sec = now_sec() - start_sec;
+
+  out_path.pos.resize( sample_num );
+  out_path.vel.resize( sample_num );
+  out_path.acc.resize( sample_num );
+  const double dT = ( times.back() - times.front() ) / ( sample_num - 1 );
+  start_sec = now_sec();
+  spline.sample( times.front(), dT, sample_num,
+                 &out_path.pos[0], &out_path.vel[0], &out_path.acc[0] );
+  out_path.sample_sec = now_sec() - start_sec;
+  return true;
+}
+
+
+int main( int argc, char* argv[] ) {
+  const std::size_t max_points =
+    ( argc > 1 ) ? (std::size_t)std::atol( argv[1] ) : 1000000;
+  const std::size_t sample_num =
+    ( argc > 2 ) ? (std::size_t)std::atol( argv[2] ) : 10000000;
+  if( sample_num < 2 ) {
+    std::fprintf( stderr, "samples must be >= 2\n" );
+    return 1;
+  }
+
+  for( std::size_t point_num=1000; point_num <= max_points; point_num *= 10 ) {
+    std::vector<double> times( point_num );
+    std::vector<double> positions( point_num );
+    std::vector<float>  positions_f( point_num );
+    for( std::size_t i=0; i < point_num; i++ ) {
+      times[i]       = 0.01 * i;
+      positions[i]   = 10.0 * sin( 0.7 * i );
+      positions_f[i] = static_cast<float>( positions[i] );
+    }
+
+    SampledPath<double> path;
+    SampledPath<float>  path_f;
+    if( !measure( times, positions, sample_num, path )
+        || !measure( times, positions_f, sample_num, path_f ) ) {
+      std::printf( "%10lu points : failed to generate\n", (unsigned long)point_num );
+      continue;
+    }
+    std::printf( "%10lu points double : generate %8.4f [s] sample %8.4f [s] %8.2f [Msamples/s]\n",
+                 (unsigned long)point_num, path.generate_sec, path.sample_sec,
+                 sample_num / path.sample_sec * 1.0e-6 );
+    std::printf( "%10lu points float  : generate %8.4f [s] sample %8.4f [s] %8.2f [Msamples/s]"
+                 " max error pos %.3e vel %.3e acc %.3e\n",
+                 (unsigned long)point_num, path_f.generate_sec, path_f.sample_sec,
+                 sample_num / path_f.sample_sec * 1.0e-6,
+                 max_error( path.pos, path_f.pos ),
+                 max_error( path.vel, path_f.vel ),
+                 max_error( path.acc, path_f.acc ) );
+  }
+
+  return 0;
+}
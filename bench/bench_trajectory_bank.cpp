@@ -0,0 +1,123 @@
+/// Stepping many independent trajectories at one time instant
+///
+/// ```
+/// $ make bench OPTFLAGS=-O2
+/// $ ./bin/bench_trajectory_bank [axes] [threads] [steps]
+/// ```
+///
+/// - axes    : the number of trajectories (default: 10000)
+/// - threads : the number of threads of TrajectoryBank (default: 0 -> the number of processors)
+/// - steps   : the number of simulation steps (default: 1000)
+///
+/// Every axis is a cubic spline of 20 points of its own.
+/// The fleet is stepped by SplineInterpolator::pop() on each object (virtual),
+/// by TrajectoryBank::evaluate_all() serially and in parallel.
+/// The sums of positions are printed to keep the loops and to compare the results.
+#include "cubic_spline_interpolator.hpp"
+#include "trajectory_bank.hpp"
+#include "spline_thread_pool.hpp"
+
+#include <time.h>
+#include <math.h>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace interp;
+
+/// the number of points of each axis
+#define POINT_NUM 20
+
+/// current monotonic time
+/// @return [sec]
+static double now_sec() {
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec + ts.tv_nsec * 1.0e-9;
+}
+
+/// print the result of a measurement
+/// @param[in] name       name of the evaluation path
+/// @param[in] sec        elapsed time [s]
+/// @param[in] step_num   the number of steps
+/// @param[in] sum        sum of positions
+static void print_result( const char* name, const double& sec,
+                          const std::size_t& step_num, const double& sum ) {
+  std::printf( "%-16s : %8.4f [s] %10.2f [us/step] sum %.9e\n",
+               name, sec, sec / step_num * 1.0e6, sum );
+}
+
+
+int main( int argc, char* argv[] ) {
+  const std::size_t axis_num =
+    ( argc > 1 ) ? (std::size_t)std::atol( argv[1] ) : 10000;
+  const std::size_t thread_num =
+    ( argc > 2 ) ? (std::size_t)std::atol( argv[2] ) : 0;
+  const std::size_t step_num =
+    ( argc > 3 ) ? (std::size_t)std::atol( argv[3] ) : 1000;
+  if( axis_num == 0 || step_num == 0 ) {
+    std::fprintf( stderr, "axes and steps must be positive\n" );
+    return 1;
+  }
+
+  std::vector<CubicSplineInterpolator> interpolators( axis_num );
+  TrajectoryBank bank;
+  bank.reserve( axis_num, axis_num * POINT_NUM );
+  for( std::size_t axis=0; axis < axis_num; axis++ ) {
+    TPQueue target_tp_queue;
+    for( std::size_t i=0; i < POINT_NUM; i++ ) {
+      target_tp_queue.push( TimePosition( 1.0 * i, 10.0 * sin( 0.7 * i + 0.001 * axis ) ) );
+    }
+    std::size_t index = 0;
+    if( interpolators[axis].generate_path( target_tp_queue ) != SPLINE_SUCCESS
+        || bank.add( interpolators[axis], index ) != SPLINE_SUCCESS ) {
+      std::fprintf( stderr, "failed to generate\n" );
+      return 1;
+    }
+  }
+
+  const double dT = ( POINT_NUM - 1.0 ) / step_num;
+  std::vector<double> pos( axis_num );
+  std::printf( "%lu axes x %lu steps\n", (unsigned long)axis_num, (unsigned long)step_num );
+
+  // virtual call of SplineInterpolator::pop() on each object
+  double sum = 0.0;
+  double start = now_sec();
+  for( std::size_t step=0; step < step_num; step++ ) {
+    const double t = dT * step;
+    for( std::size_t axis=0; axis < axis_num; axis++ ) {
+      const SplineInterpolator& interpolator = interpolators[axis];
+      sum += interpolator.pop( t ).P.pos;
+    }
+  }
+  print_result( "pop", now_sec() - start, step_num, sum );
+
+  // TrajectoryBank::evaluate_all() in the calling thread
+  sum = 0.0;
+  start = now_sec();
+  for( std::size_t step=0; step < step_num; step++ ) {
+    bank.evaluate_all<OUTPUT_POS>( dT * step, &pos[0], NULL, NULL );
+    for( std::size_t axis=0; axis < axis_num; axis++ ) {
+      sum += pos[axis];
+    }
+  }
+  print_result( "bank serial", now_sec() - start, step_num, sum );
+
+  // TrajectoryBank::evaluate_all() across threads
+  SplineThreadPool thread_pool( thread_num );
+  bank.set_thread_pool( &thread_pool );
+  bank.reset_cursors();
+  sum = 0.0;
+  start = now_sec();
+  for( std::size_t step=0; step < step_num; step++ ) {
+    bank.evaluate_all<OUTPUT_POS>( dT * step, &pos[0], NULL, NULL );
+    for( std::size_t axis=0; axis < axis_num; axis++ ) {
+      sum += pos[axis];
+    }
+  }
+  char name[32];
+  std::sprintf( name, "bank %lu threads", (unsigned long)thread_pool.thread_num() );
+  print_result( name, now_sec() - start, step_num, sum );
+
+  return 0;
+}
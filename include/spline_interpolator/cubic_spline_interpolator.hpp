@@ -6,6 +6,75 @@
 #include <iomanip>
 
 namespace interp{
+
+class CubicSplineInterpolator;
+
+/// Reusable work area of CubicSplineInterpolator::generate_path()
+/// @details
+/// Keeps the capacity of the tridiagonal matrix and the target lists across plans,
+/// so re-planning of paths up to the reserved size allocates no memory. \n
+/// Without a workspace, generate_path() takes the scratch buffers from the arena
+/// (SplineInterpolator::set_arena()) or the heap and returns them at the end,
+/// so an interpolator keeps no matrix memory after planning
+/// except the factorization of the uniform-knot matrix.
+/// A workspace owned by the caller can be shared by interpolators with set_workspace()
+/// if they generate paths one at a time (not thread-safe).
+class CubicSplineWorkspace {
+  friend class CubicSplineInterpolator;
+public:
+  /// Constructor
+  /// @param[in] point_num the number of points to reserve (default: 0)
+  explicit CubicSplineWorkspace( const std::size_t& point_num=0 );
+
+  /// Destructor
+  ~CubicSplineWorkspace();
+
+  /// Reserve the capacity for paths of the number of points
+  /// @param[in] point_num the number of points
+  void reserve( const std::size_t& point_num );
+
+  /// Get the number of points which can be planned without allocation
+  /// @return the reserved number of points
+  const std::size_t capacity() const;
+
+  /// Return all memory of the workspace
+  void release();
+
+private:
+  /// Copy Constructor (prohibited)
+  CubicSplineWorkspace( const CubicSplineWorkspace& src );
+
+  /// Copy(insert) Operator (prohibited)
+  CubicSplineWorkspace& operator=( const CubicSplineWorkspace& src );
+
+  /// resize all lists without releasing the capacity
+  /// @param[in] point_num the number of points
+  void resize( const std::size_t& point_num );
+
+  /// upper elements of tridiagonal matrix
+  std::vector<double> upper_;
+
+  /// diagonal elements of tridiagonal matrix (overwritten by the solver)
+  std::vector<double> diago_;
+
+  /// lower elements of tridiagonal matrix
+  std::vector<double> lower_;
+
+  /// pushed out parameters of tridiagonal matrix (overwritten by the solver)
+  std::vector<double> param_;
+
+  /// times of target points
+  std::vector<double> times_;
+
+  /// position, velocity, acceleration of target points
+  std::vector<PosVelAcc> pva_list_;
+
+  /// factorization of the uniform-knot matrix (only extended, see g_uniform_tridiagonal_factorize())
+  std::vector<double> uniform_inverse_diago_;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Cubic Spline Interpolator
 /// @brief parameters are kept internally.
 /// @details Cubic spline is defined as.
@@ -15,6 +84,7 @@ namespace interp{
 /// ```
 class CubicSplineInterpolator : public SplineInterpolator {
   friend class CubicSplineTest;
+  friend class TrajectoryBank;
 public:
   /// Constructor
   CubicSplineInterpolator();
@@ -32,6 +102,17 @@ public:
   /// @return *this
   CubicSplineInterpolator& operator=( const CubicSplineInterpolator& src );
 
+#ifdef SPLINE_CXX11
+  /// Move Constructor
+  /// @param[in] src source of the move CubicSplineInterpolator (not generated after the move)
+  CubicSplineInterpolator( CubicSplineInterpolator&& src ) SPLINE_NOEXCEPT;
+
+  /// Move(insert) Operator
+  /// @param[in] src source of the move CubicSplineInterpolator (not generated after the move)
+  /// @return *this
+  CubicSplineInterpolator& operator=( CubicSplineInterpolator&& src ) SPLINE_NOEXCEPT;
+#endif
+
   /// Generate a cubic-spline-path from Time, Position queue
   /// @param[in] target_tp_queue target Time,Position queue
   /// @param[in] vs              start velocity (default: 0.0)
@@ -60,10 +141,43 @@ public:
                                  const double vs=0.0, const double vf=0.0,
                                  const double as=0.0, const double af=0.0 );
 
+  /// Set the workspace of generate_path(const TPQueue&, ...)
+  /// @param[in] workspace pointer to the workspace owned by the caller (not owned).
+  ///                      NULL means the temporary buffers on the arena or the heap (default).
+  /// @details The matrix is solved in place in the workspace
+  /// and the coefficients are written straight into the path parameters.
+  void set_workspace( CubicSplineWorkspace* workspace );
+
+  /// Get the workspace in use
+  /// @return pointer to the workspace set by set_workspace() (NULL if not set)
+  CubicSplineWorkspace* workspace();
+
+  /// Enable or disable the uniform-knot fast path (default: enabled)
+  /// @param[in] enable true: detect the uniform interval time at generate_path()
+  /// @details
+  /// If all interval times of the target queue are the same
+  /// (within the relative error UNIFORM_KNOT_TOLERANCE),
+  /// - generate_path(const TPQueue&, ...) solves the constant-coefficient matrix
+  ///   with the factorization cached in the workspace
+  ///   (in the interpolator without a workspace), extended only for longer queues,
+  /// - pop() finds the segment by floor((t - t0) / dT) in O(1) instead of the binary search. \n
+  /// The path equals the generic one within the rounding error.
+  void set_uniform_knot_detection( const bool& enable );
+
+  /// Check if the generated path uses the uniform-knot fast path
+  /// @return true if the interval times of the generated path are uniform
+  const bool is_uniform_knot() const;
+
+  /// relative tolerance of interval times regarded as uniform
+  static const double UNIFORM_KNOT_TOLERANCE;
+
   /// Generate a cubic-spline-path from Time, Position(, Velocity) queue
   /// @param[in] target_tpva_queue target Time, Position(, Velocity, Acceleration) queue
   /// @return
   /// - SPLINE_SUCCESS: no error
+  /// @details
+  /// Segments are independent, so they are generated in parallel
+  /// if the thread pool is set by set_thread_pool().
   virtual RetCode generate_path( const TPVAQueue& target_tpva_queue );
 
   /// Generate a spline-path from start and finish Position(, Velocity, Acceleration) queue
@@ -91,10 +205,83 @@ public:
   /// - TimeOutOfRange : time is not within the range of generated spline-path
   virtual const TimePVA pop( const double& t ) const;
 
+  /// Pop the selected outputs at the input-time from generated trajectory
+  /// @param[in] t input time
+  /// @return output TPVA at the input time (unselected outputs are 0.0)
+  /// @tparam Mask combination of OutputMask
+  /// (instantiated in the source for every combination)
+  /// @exception the same as pop()
+  template<unsigned int Mask>
+  const TimePVA pop( const double& t ) const;
+
   /// clear target TPVAQueue (target_tpva_queue_)
   ///       & path parameter queue (depend on each interpolator class)
   virtual RetCode clear();
 
+  /// Set the limits checked by check_limit() and enforced by retime()
+  /// @param[in] v_limit limit of |velocity| (<= 0.0: not limited)
+  /// @param[in] a_limit limit of |acceleration| (default: 0.0, <= 0.0: not limited)
+  void set_limit( const double& v_limit, const double& a_limit=0.0 );
+
+  /// Get the limit of acceleration
+  /// @return limit of |acceleration| (0.0: not limited)
+  const double a_limit() const;
+
+  /// Get the peaks of the segment analytically
+  /// @param[in]  index       index of the segment (< the number of points - 1)
+  /// @param[out] max_abs_vel maximum of |velocity| in the segment
+  /// @param[out] max_abs_acc maximum of |acceleration| in the segment
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_UNINITIALIZED_INTERPOLATOR : path is not generated
+  /// - SPLINE_INVALID_INPUT_INDEX : index is out of the segments
+  /// @details see g_cubic_peak().
+  /// The peaks are those of pop(), i.e. velocity times s and acceleration times s^2
+  /// with the time scale s of set_time_scale().
+  RetCode segment_peak( const std::size_t& index,
+                        double& max_abs_vel, double& max_abs_acc ) const;
+
+  /// Get the peaks of the whole path in O(segments)
+  /// @param[out] max_abs_vel maximum of |velocity| in the path
+  /// @param[out] max_abs_acc maximum of |acceleration| in the path
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_UNINITIALIZED_INTERPOLATOR : path is not generated
+  /// @details The peaks include the time scale, the same as segment_peak().
+  RetCode path_peak( double& max_abs_vel, double& max_abs_acc ) const;
+
+  /// Check the limits set by set_limit() on every segment analytically
+  /// @param[out] violated_indexes indexes of the segments over the limits (may be NULL)
+  /// @return
+  /// - SPLINE_SUCCESS : the path is within the limits
+  /// - SPLINE_UNINITIALIZED_INTERPOLATOR : path is not generated
+  /// - SPLINE_LIMIT_EXCEEDED : a segment is over the limits
+  /// @details The peaks include the time scale, the same as segment_peak().
+  RetCode check_limit( std::vector<std::size_t>* violated_indexes=NULL ) const;
+
+  /// Stretch the interval times of the segments over the limits and re-solve the path
+  /// @param[in] max_iteration the maximum number of re-solving (default: 50)
+  /// @return
+  /// - SPLINE_SUCCESS : the path is within the limits
+  /// - SPLINE_UNINITIALIZED_INTERPOLATOR : path is not generated
+  /// - SPLINE_LIMIT_EXCEEDED : the limits are not met within max_iteration,
+  ///   or the start or finish velocity is over the velocity limit
+  /// - the error of generate_path()
+  /// @details
+  /// The interval time of an offending segment is multiplied by
+  /// max( peak velocity / v_limit, sqrt( peak acceleration / a_limit ) ) (with a small margin),
+  /// and the path is re-solved by generate_path(const TPQueue&, vs, vf)
+  /// with the same positions, start time, start and finish velocities.
+  /// Re-solving changes the neighbors a little, so it is repeated until no segment offends. \n
+  /// A path generated from TPVAQueue is also re-solved as a TPQueue path,
+  /// i.e. the velocities of the intermediate points are recalculated. \n
+  /// The peaks include the time scale s (the same as segment_peak()), and the scale is kept,
+  /// so the retimed path is within the limits when played back by pop() at the scale s.
+  RetCode retime( const std::size_t& max_iteration=50 );
+
+  /// relative margin added to the stretch of retime()
+  static const double RETIME_MARGIN;
+
 
 private:
   /// Tridiagonal Matrix Equation Solver
@@ -142,6 +329,28 @@ private:
             std::vector<double>& out_solved_x );
 
 private:
+  /// Solve the path of generate_path(const TPQueue&, ...) on the scratch buffers
+  /// @param[in] target_tp_queue target time & position queue (size >= 3)
+  /// @param[in] vs start velocity
+  /// @param[in] vf finish velocity
+  /// @param[in,out] upper upper diagonal elements (size of the queue)
+  /// @param[in,out] diago diagonal elements (size of the queue)
+  /// @param[in,out] lower lower diagonal elements (size of the queue)
+  /// @param[in,out] param right side, then the second-order parameters (size of the queue)
+  /// @param[in,out] times time list of target_tpva_queue_ (size of the queue)
+  /// @param[in,out] pva_list PVA list of target_tpva_queue_ (size of the queue)
+  /// @param[in,out] uniform_inverse_diago cached factorization of the uniform interval time
+  ///                 (of the workspace or uniform_inverse_diago_)
+  /// @return the same as generate_path(const TPQueue&, ...)
+  /// @tparam Vector    vector of double (with any allocator)
+  /// @tparam PVAVector vector of PosVelAcc (with any allocator)
+  template<class Vector, class PVAVector>
+  RetCode solve_path( const TPQueue& target_tp_queue,
+                      const double& vs, const double& vf,
+                      Vector& upper, Vector& diago, Vector& lower, Vector& param,
+                      Vector& times, PVAVector& pva_list,
+                      std::vector<double>& uniform_inverse_diago );
+
   /// third-order parameter of cubic formula.
   std::vector<double> a_;
 
@@ -153,6 +362,38 @@ private:
 
   /// zero-order parameter of cubic formula.
   std::vector<double> d_;
+
+  /// workspace set by set_workspace() (not owned, NULL: buffers on the arena or the heap)
+  CubicSplineWorkspace* workspace_;
+
+  /// detect the uniform interval time at generate_path() (default: true)
+  bool uniform_knot_detection_;
+
+  /// the generated path has the uniform interval time
+  bool is_uniform_knot_;
+
+  /// inverse of the uniform interval time (valid if is_uniform_knot_)
+  double inverse_uniform_dT_;
+
+  /// factorization of the uniform-knot matrix without a workspace
+  /// (only extended, see g_uniform_tridiagonal_factorize())
+  std::vector<double> uniform_inverse_diago_;
+
+  /// limit of |acceleration| (0.0: not limited)
+  double a_limit_;
+
+  /// check the uniform interval time of the queue
+  /// @param[in]  queue       target queue (size >= 2)
+  /// @param[out] out_mean_dT mean interval time
+  /// @return true if the interval time is uniform and the detection is enabled
+  template<class QueueT>
+  bool detect_uniform_knot( const QueueT& queue, double& out_mean_dT ) const;
+
+  /// Get the trajectory index of the input time on the uniform knots in O(1)
+  /// @param[in]  t            time of the generated path (see SplineInterpolator::index_of_time())
+  /// @param[out] output_index output index matched the input time
+  /// @return the same as SplineInterpolator::index_of_time()
+  const RetCode uniform_index_of_time( const double& t, std::size_t& output_index ) const;
 };
 
 }
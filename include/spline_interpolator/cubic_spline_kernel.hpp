@@ -0,0 +1,632 @@
+#ifndef INCLUDE_CUBIC_SPLINE_KERNEL_HPP_
+#define INCLUDE_CUBIC_SPLINE_KERNEL_HPP_
+
+#include <vector>
+#include <algorithm> // for upper_bound
+#include <sstream>
+#include <iomanip>
+#include <cstddef> // for size_t
+#include <limits>
+
+#include "spline_data.hpp"
+
+namespace interp {
+
+/// judge nearly zero in constant expressions
+/// @param[in] value value
+/// @return true if |value| <= epsilon of T (the same tolerance as g_isNearlyZero())
+/// @tparam T scalar type (float, double)
+template<class T>
+inline SPLINE_CONSTEXPR14 bool g_cubic_is_nearly_zero( const T& value ) {
+  return ( value < T(0.0) ? -value : value ) <= std::numeric_limits<T>::epsilon();
+}
+
+/// Hermite coefficients of the cubic segment with the inverse of the interval time
+/// @param[in]  pos0       start position
+/// @param[in]  vel0       start velocity
+/// @param[in]  pos1       finish position
+/// @param[in]  vel1       finish velocity
+/// @param[in]  dT         interval time of the segment
+/// @param[in]  inverse_dT 1 / dT
+/// @param[out] a          third-order parameter
+/// @param[out] b          second-order parameter
+/// @param[out] c          first-order parameter
+/// @param[out] d          zero-order parameter
+/// @tparam T scalar type (float, double)
+/// @details The only formula of the coefficients of all cubic paths.
+template<class T>
+inline SPLINE_CONSTEXPR14 void g_cubic_hermite( const T& pos0, const T& vel0,
+                             const T& pos1, const T& vel1,
+                             const T& dT, const T& inverse_dT,
+                             T& a, T& b, T& c, T& d ) {
+  const T dp = pos1 - pos0;
+  a = ( (vel1 + vel0) * dT - T(2.0) * dp ) * inverse_dT * inverse_dT * inverse_dT;
+  b = ( T(-1.0) * (vel1 + T(2.0) * vel0) * dT + T(3.0) * dp ) * inverse_dT * inverse_dT;
+  c = vel0;
+  d = pos0;
+}
+
+/// Hermite coefficients of the cubic segment
+/// @param[in]  pos0 start position
+/// @param[in]  vel0 start velocity
+/// @param[in]  pos1 finish position
+/// @param[in]  vel1 finish velocity
+/// @param[in]  dT   interval time of the segment
+/// @param[out] a    third-order parameter
+/// @param[out] b    second-order parameter
+/// @param[out] c    first-order parameter
+/// @param[out] d    zero-order parameter
+/// @tparam T scalar type (float, double)
+template<class T>
+inline SPLINE_CONSTEXPR14 void g_cubic_hermite( const T& pos0, const T& vel0,
+                             const T& pos1, const T& vel1,
+                             const T& dT,
+                             T& a, T& b, T& c, T& d ) {
+  g_cubic_hermite( pos0, vel0, pos1, vel1, dT, T(T(1.0) / dT), a, b, c, d );
+}
+
+/// Evaluate the selected outputs of the cubic segment
+/// @param[in]  a   third-order parameter
+/// @param[in]  b   second-order parameter
+/// @param[in]  c   first-order parameter
+/// @param[in]  d   zero-order parameter
+/// @param[in]  dTi elapsed time from the start of the segment
+/// @param[out] pos position (written if Mask has OUTPUT_POS)
+/// @param[out] vel velocity (written if Mask has OUTPUT_VEL)
+/// @param[out] acc acceleration (written if Mask has OUTPUT_ACC)
+/// @tparam Mask combination of OutputMask
+/// @tparam T scalar type (float, double)
+/// @details The selected outputs are bitwise equal to g_cubic_evaluate().
+template<unsigned int Mask, class T>
+inline SPLINE_CONSTEXPR14 void g_cubic_evaluate_masked( const T& a, const T& b, const T& c, const T& d,
+                                                        const T& dTi,
+                                                        T& pos, T& vel, T& acc ) {
+  const T square = dTi * dTi;
+  if( Mask & OUTPUT_POS ) {
+    const T cube = dTi * dTi * dTi;
+    pos = a * cube + b * square + c * dTi + d;
+  }
+  if( Mask & OUTPUT_VEL ) {
+    vel = T(3.0) * a * square + T(2.0) * b * dTi + c;
+  }
+  if( Mask & OUTPUT_ACC ) {
+    acc = T(6.0) * a * dTi + T(2.0) * b;
+  }
+}
+
+/// Evaluate the cubic segment
+/// @param[in]  a   third-order parameter
+/// @param[in]  b   second-order parameter
+/// @param[in]  c   first-order parameter
+/// @param[in]  d   zero-order parameter
+/// @param[in]  dTi elapsed time from the start of the segment
+/// @param[out] pos position
+/// @param[out] vel velocity
+/// @param[out] acc acceleration
+/// @tparam T scalar type (float, double)
+template<class T>
+inline SPLINE_CONSTEXPR14 void g_cubic_evaluate( const T& a, const T& b, const T& c, const T& d,
+                              const T& dTi,
+                              T& pos, T& vel, T& acc ) {
+  g_cubic_evaluate_masked<OUTPUT_PVA>( a, b, c, d, dTi, pos, vel, acc );
+}
+
+/// Peaks of the absolute velocity and acceleration of the cubic segment
+/// @param[in]  a           third-order parameter
+/// @param[in]  b           second-order parameter
+/// @param[in]  c           first-order parameter
+/// @param[in]  dT          interval time of the segment
+/// @param[out] max_abs_vel maximum of |velocity| in [0, dT]
+/// @param[out] max_abs_acc maximum of |acceleration| in [0, dT]
+/// @tparam T scalar type (float, double)
+/// @details
+/// The velocity 3a t^2 + 2b t + c is checked at both ends
+/// and at the root of its derivative t = -b / (3a) if it is inside the segment.
+/// The acceleration 6a t + 2b is linear, so its peak is at one of the ends.
+template<class T>
+inline SPLINE_CONSTEXPR14 void g_cubic_peak( const T& a, const T& b, const T& c, const T& dT,
+                                             T& max_abs_vel, T& max_abs_acc ) {
+  const T vel0 = c;
+  const T vel1 = T(3.0) * a * dT * dT + T(2.0) * b * dT + c;
+  const T abs_vel0 = ( vel0 < T(0.0) ) ? -vel0 : vel0;
+  const T abs_vel1 = ( vel1 < T(0.0) ) ? -vel1 : vel1;
+  max_abs_vel = ( abs_vel0 > abs_vel1 ) ? abs_vel0 : abs_vel1;
+  if( a != T(0.0) ) {
+    const T t_extremum = -b / ( T(3.0) * a );
+    if( t_extremum > T(0.0) && t_extremum < dT ) {
+      const T vel_extremum = c - b * b / ( T(3.0) * a );
+      const T abs_vel_extremum = ( vel_extremum < T(0.0) ) ? -vel_extremum : vel_extremum;
+      if( abs_vel_extremum > max_abs_vel ) {
+        max_abs_vel = abs_vel_extremum;
+      }
+    }
+  }
+  const T acc0 = T(2.0) * b;
+  const T acc1 = T(6.0) * a * dT + T(2.0) * b;
+  const T abs_acc0 = ( acc0 < T(0.0) ) ? -acc0 : acc0;
+  const T abs_acc1 = ( acc1 < T(0.0) ) ? -acc1 : acc1;
+  max_abs_acc = ( abs_acc0 > abs_acc1 ) ? abs_acc0 : abs_acc1;
+}
+
+/// Tridiagonal Matrix Equation Solver on flat arrays (in place)
+/// @param[in]     size the number of rows (>= 1)
+/// @param[in,out] d diagonal elements (overwritten by the forward elimination)
+/// @param[in]     u upper elements
+/// @param[in]     l lower elements
+/// @param[in,out] p pushed out parameters (overwritten by the forward elimination)
+/// @param[out]    x solved elements (size elements)
+/// @return
+/// - SPLINE_SUCCESS: no error
+/// - SPLINE_INVALID_MATRIX_ARGUMENT_VALUE_ZERO: d[i] is nearly zero (x is not written)
+/// @tparam T scalar type (float, double)
+/// @details Solves without any allocation. x may be the same array as p.
+template<class T>
+inline SPLINE_CONSTEXPR14 RetCode g_tridiagonal_solve_in_place( const std::size_t& size,
+                                      T* d, const T* u, const T* l, T* p, T* x ) {
+  // first loop from top
+  for( std::size_t i=0; i<size; i++ ) {
+    if( g_cubic_is_nearly_zero( d[i] ) ) {
+      return SPLINE_INVALID_MATRIX_ARGUMENT_VALUE_ZERO;
+    }
+    if( i >= 1 ) {
+      const T temp = l[i] / d[i-1];
+      d[i] = d[i] - temp * u[i-1];
+      p[i] = p[i] - temp * p[i-1];
+    }
+  }
+  //
+  // solve x
+  //
+  std::size_t last_index = size-1;
+  x[last_index] = p[last_index] / d[last_index];
+  if( size == 1 ) {
+    return SPLINE_SUCCESS;
+  }
+  // second loop from bottom
+  // list size must be >= 2.
+  for( std::size_t i=last_index; i >= 1; i-- ) {
+    x[i-1] = ( p[i-1] - u[i-1] * x[i] ) / d[i-1];
+  }
+  //
+  return SPLINE_SUCCESS;
+}
+
+/// Check the times of the points of the cubic spline
+/// @param[in] size  the number of points
+/// @param[in] times times of the points (times[0] .. times[size-1])
+/// @return
+/// - SPLINE_SUCCESS: no error
+/// - SPLINE_INVALID_INPUT_TIME: times are not strictly increasing
+/// - SPLINE_INVALID_INPUT_INTERVAL_TIME_DT: interval time is nearly zero in T
+/// @tparam T     scalar type of the coefficients (float, double)
+/// @tparam Times array, pointer or accessor of the times with operator[]
+template<class T, class Times>
+inline SPLINE_CONSTEXPR14 RetCode g_cubic_spline_check_times( const std::size_t& size,
+                                                              const Times&       times ) {
+  for( std::size_t i=1; i < size; i++ ) {
+    if( !( times[i] > times[i-1] ) ) {
+      return SPLINE_INVALID_INPUT_TIME;
+    }
+    if( g_cubic_is_nearly_zero( T( times[i] - times[i-1] ) ) ) {
+      return SPLINE_INVALID_INPUT_INTERVAL_TIME_DT;
+    }
+  }
+  return SPLINE_SUCCESS;
+}
+
+/// Tridiagonal matrix of the velocities of the cubic spline
+/// @param[in]  size      the number of points (>= 2)
+/// @param[in]  times     times of the points (checked by g_cubic_spline_check_times())
+/// @param[in]  positions positions of the points
+/// @param[in]  vs        start velocity
+/// @param[in]  vf        finish velocity
+/// @param[out] lower     lower elements (size elements)
+/// @param[out] diago     diagonal elements (size elements)
+/// @param[out] upper     upper elements (size elements)
+/// @param[out] param     pushed out parameters (size elements)
+/// @tparam T         scalar type of the matrix (float, double)
+/// @tparam Times     array, pointer or accessor of the times with operator[]
+/// @tparam Positions array, pointer or accessor of the positions with operator[]
+/// @details
+/// The continuity of the acceleration at the points between the fixed start and finish
+/// velocities. Solved by g_tridiagonal_solve_in_place().
+template<class T, class Times, class Positions>
+inline SPLINE_CONSTEXPR14 void g_cubic_spline_matrix( const std::size_t& size,
+                                                      const Times&       times,
+                                                      const Positions&   positions,
+                                                      const T& vs, const T& vf,
+                                                      T* lower, T* diago, T* upper, T* param ) {
+  const std::size_t finish_index = size - 1;
+  // the start index = 0
+  lower[0] = T(0.0);
+  diago[0] = T(1.0);
+  upper[0] = T(0.0);
+  param[0] = vs;
+  // index >= 1
+  for( std::size_t i=1; i < finish_index; i++ ) {
+    const T inverse_dT     = T(1.0) / T( times[i+1] - times[i] );
+    const T inverse_pre_dT = T(1.0) / T( times[i]   - times[i-1] );
+    lower[i] = T(2.0) * inverse_dT;
+    diago[i] = T(4.0) * (inverse_dT + inverse_pre_dT);
+    upper[i] = T(2.0) * inverse_dT;
+    param[i] = T(6.0) * (positions[i+1] - positions[i]) * inverse_dT * inverse_dT
+               + T(6.0) * (positions[i] - positions[i-1]) * inverse_pre_dT * inverse_pre_dT;
+  }
+  // the finish index
+  lower[finish_index] = T(0.0);
+  diago[finish_index] = T(1.0);
+  upper[finish_index] = T(0.0);
+  param[finish_index] = vf;
+}
+
+/// Coefficients of the cubic spline from the solved velocities
+/// @param[in]  size       the number of points (>= 2)
+/// @param[in]  times      times of the points
+/// @param[in]  positions  positions of the points
+/// @param[in]  vel        velocities of the points (size elements)
+/// @param[out] a          third-order parameters (size elements)
+/// @param[out] b          second-order parameters (size elements)
+/// @param[out] c          first-order parameters (size elements, may be the same array as vel)
+/// @param[out] d          zero-order parameters (size elements)
+/// @param[in]  uniform_dT the uniform interval time, or 0.0 for the interval times of times
+/// @tparam T         scalar type of the coefficients (float, double)
+/// @tparam Times     array, pointer or accessor of the times with operator[]
+/// @tparam Positions array, pointer or accessor of the positions with operator[]
+/// @details
+/// Each segment is g_cubic_hermite(). The uniform interval time needs no division per row.
+/// The finish point has jerk = acceleration = 0.
+template<class T, class Times, class Positions>
+inline SPLINE_CONSTEXPR14 void g_cubic_spline_coefficients( const std::size_t& size,
+                                                            const Times&       times,
+                                                            const Positions&   positions,
+                                                            const T* vel,
+                                                            T* a, T* b, T* c, T* d,
+                                                            const T& uniform_dT=T(0.0) ) {
+  const std::size_t finish_index = size - 1;
+  const bool is_uniform         = uniform_dT > T(0.0);
+  const T    uniform_inverse_dT = is_uniform ? T(1.0) / uniform_dT : T(0.0);
+  for( std::size_t i=0; i < finish_index; i++ ) {
+    const T dT         = is_uniform ? uniform_dT : T( times[i+1] - times[i] );
+    const T inverse_dT = is_uniform ? uniform_inverse_dT : T(1.0) / dT;
+    g_cubic_hermite( T( positions[i] ), vel[i], T( positions[i+1] ), vel[i+1],
+                     dT, inverse_dT, a[i], b[i], c[i], d[i] );
+  }
+  // the finish index (jerk = acceleration = 0)
+  a[finish_index] = T(0.0);
+  b[finish_index] = T(0.0);
+  c[finish_index] = vel[finish_index];
+  d[finish_index] = positions[finish_index];
+}
+
+/// Extend the factorization of the uniform-knot cubic spline matrix
+/// @param[in]     size          the number of rows to factorize
+/// @param[in,out] inverse_diago inverse of the eliminated diagonal elements (extended to size)
+/// @tparam T     scalar type (float, double)
+/// @tparam Alloc allocator of the vector
+/// @details
+/// With the uniform interval time, the rows of the cubic spline matrix scaled by dT/2 are
+/// [1 4 1] between the fixed start and finish velocities,
+/// so the eliminated diagonal elements depend only on the row index
+/// ( d'_1 = 4, d'_i = 4 - 1/d'_{i-1} ). \n
+/// The factorization is shared by all sizes and data, and calculated only for new rows.
+template<class T, class Alloc>
+void g_uniform_tridiagonal_factorize( const std::size_t&     size,
+                                      std::vector<T, Alloc>& inverse_diago ) {
+  if( inverse_diago.empty() ) {
+    // row 0 is the start velocity
+    inverse_diago.push_back( T(1.0) );
+  }
+  for( std::size_t i=inverse_diago.size(); i < size; i++ ) {
+    const T diago = ( i == 1 ) ? T(4.0) : T(4.0) - inverse_diago[i-1];
+    inverse_diago.push_back( T(1.0) / diago );
+  }
+}
+
+/// Uniform-knot cubic spline matrix solver on flat arrays (in place)
+/// @param[in]     size          the number of rows (>= 3)
+/// @param[in]     inverse_diago factorization by g_uniform_tridiagonal_factorize() (>= size)
+/// @param[in,out] p             right-hand side 3/dT * (x_{i+1} - x_{i-1}) of rows 1 .. size-2,
+///                              the start & finish velocity at row 0 & size-1.
+///                              Overwritten by the solved velocities.
+/// @tparam T scalar type (float, double)
+/// @details Constant-coefficient Thomas algorithm with one multiply-add per row in each pass.
+template<class T>
+void g_uniform_tridiagonal_solve_in_place( const std::size_t& size,
+                                           const T*           inverse_diago,
+                                           T*                 p ) {
+  const std::size_t last_index = size - 1;
+  // first loop from top (lower elements are 1, and the diagonal element of row 0 is 1)
+  for( std::size_t i=1; i < last_index; i++ ) {
+    p[i] -= p[i-1] * inverse_diago[i-1];
+  }
+  // second loop from bottom (the finish velocity is fixed and upper elements are 1)
+  for( std::size_t i=last_index-1; i >= 1; i-- ) {
+    p[i] = ( p[i] - p[i+1] ) * inverse_diago[i];
+  }
+}
+
+/// Tridiagonal Matrix Equation Solver
+/// @param[in]  d diagonal elements list
+/// @param[in]  u upper elements list
+/// @param[in]  l lower elements list
+/// @param[in]  p pushed out parameters list of Matrix Conversion
+/// @param[out] out_solved_x solved list of tridiagonal matrix equation
+/// @return
+/// - SPLINE_SUCCESS: no error
+/// - SPLINE_INVALID_MATRIX_ARGUMENT_VALUE_ZERO: d[i] is nearly zero
+/// @exception InvalidArgumentSize If the sizes of lists are different or zero.
+/// @tparam T scalar type (float, double)
+/// @tparam A allocator of lists (std::allocator, ArenaAllocator)
+/// @details See CubicSplineInterpolator::tridiagonal_matrix_eq_solver().
+template<class T, class A>
+RetCode g_tridiagonal_solve( std::vector<T, A> d, const std::vector<T, A>& u,
+                             const std::vector<T, A>& l, std::vector<T, A> p,
+                             std::vector<T, A>& out_solved_x ) {
+  out_solved_x.clear();
+  if( d.size() != u.size() || d.size() != l.size() || d.size() != p.size() ) {
+    const std::string err_msg = "all input parmeter size must be same.";
+    std::cerr << err_msg << std::endl;
+    THROW( InvalidArgumentSize, err_msg );
+  }
+  if( d.size() < 1 ) {
+    const std::string err_msg = "input parmeter size must be >= 1.";
+    std::cerr << err_msg << std::endl;
+    THROW( InvalidArgumentSize, err_msg );
+  }
+  // d and p are copies, so they can be overwritten
+  const RetCode retcode
+    = g_tridiagonal_solve_in_place( d.size(), &d[0], &u[0], &l[0], &p[0], &p[0] );
+  if( retcode != SPLINE_SUCCESS ) {
+    return retcode;
+  }
+  out_solved_x.swap( p );
+  return SPLINE_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+/// Light-weight cubic spline of scalar type T
+/// @tparam T scalar type of positions and coefficients (float, double)
+/// @details
+/// The same path as CubicSplineInterpolator (bitwise equal for double),
+/// with coefficients kept in T and times kept in double. \n
+/// float halves the memory of coefficients and sampled outputs.
+/// The elapsed time in a segment is calculated in double before it is converted to T,
+/// so the error of float does not grow with the absolute time.
+///
+/// ```
+/// x_n(t) = a_n (t - t_n)^3 + b_n (t - t_n)^2 + c_n (t - t_n) + d_n
+/// ```
+template<class T>
+class BasicCubicSpline {
+public:
+  /// Constructor
+  BasicCubicSpline() {
+  }
+
+  /// Generate a cubic-spline-path from times and positions
+  /// @param[in] times     target times (strictly increasing)
+  /// @param[in] positions target positions
+  /// @param[in] vs        start velocity (default: 0.0)
+  /// @param[in] vf        finish velocity (default: 0.0)
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_QUEUE_SIZE: sizes are different or less than 3
+  /// - SPLINE_INVALID_INPUT_TIME: times are not strictly increasing
+  /// - SPLINE_INVALID_INPUT_INTERVAL_TIME_DT: interval time is nearly zero
+  /// - SPLINE_INVALID_MATRIX_ARGUMENT_VALUE_ZERO: failed to solve velocities
+  /// @details See CubicSplineInterpolator::generate_path( const TPQueue&, ... ).
+  RetCode generate_path( const std::vector<double>& times,
+                         const std::vector<T>&      positions,
+                         const T& vs=T(0.0), const T& vf=T(0.0) ) {
+    if( times.size() != positions.size() || times.size() < 3 ) {
+      return SPLINE_INVALID_QUEUE_SIZE;
+    }
+    const std::size_t size = times.size();
+    RetCode retcode = g_cubic_spline_check_times<T>( size, times );
+    if( retcode != SPLINE_SUCCESS ) {
+      return retcode;
+    }
+    std::vector<T> upper( size ), diago( size ), lower( size ), c( size );
+    g_cubic_spline_matrix( size, times, positions, vs, vf, &lower[0], &diago[0], &upper[0], &c[0] );
+    retcode = g_tridiagonal_solve_in_place( size, &diago[0], &upper[0], &lower[0], &c[0], &c[0] );
+    if( retcode != SPLINE_SUCCESS ) {
+      return retcode;
+    }
+    //
+    times_ = times;
+    a_.resize( size );
+    b_.resize( size );
+    c_.swap( c );
+    d_.resize( size );
+    g_cubic_spline_coefficients( size, times, positions, &c_[0], &a_[0], &b_[0], &c_[0], &d_[0] );
+    return SPLINE_SUCCESS;
+  }
+
+  /// Generate a cubic-spline-path from Time, Position, Velocity queue
+  /// @param[in] target_queue target Time, Position, Velocity (, Acceleration at the finish)
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_QUEUE_SIZE: size is less than 2
+  /// @details See CubicSplineInterpolator::generate_path( const TPVAQueue& ).
+  RetCode generate_path( const TimeQueue<BasicPosVelAcc<T> >& target_queue ) {
+    if( target_queue.size() < 2 ) {
+      return SPLINE_INVALID_QUEUE_SIZE;
+    }
+    const std::size_t finish_index = target_queue.size() - 1;
+    times_.resize( target_queue.size() );
+    a_.resize( target_queue.size() );
+    b_.resize( target_queue.size() );
+    c_.resize( target_queue.size() );
+    d_.resize( target_queue.size() );
+    for( std::size_t i=0; i < finish_index; i++ ) {
+      const TimeVal<BasicPosVelAcc<T> >& tpva0 = target_queue.at( i   );
+      const TimeVal<BasicPosVelAcc<T> >& tpva1 = target_queue.at( i+1 );
+      times_[i] = tpva0.time;
+      g_cubic_hermite( tpva0.value.pos, tpva0.value.vel,
+                       tpva1.value.pos, tpva1.value.vel,
+                       T( target_queue.dT( i ) ),
+                       a_[i], b_[i], c_[i], d_[i] );
+    }
+    const TimeVal<BasicPosVelAcc<T> >& finish = target_queue.at( finish_index );
+    times_[finish_index] = finish.time;
+    a_[finish_index] = T(0.0);
+    b_[finish_index] = finish.value.acc * T(0.5);
+    c_[finish_index] = finish.value.vel;
+    d_[finish_index] = finish.value.pos;
+    return SPLINE_SUCCESS;
+  }
+
+  /// Pop the position, velocity and acceleration at the input-time
+  /// @param[in] t input time
+  /// @return output TimeVal<BasicPosVelAcc<T> > at the input time
+  /// @exception
+  /// - NotSplineGenerated : spline-path is not genrated
+  /// - TimeOutOfRange : time is not within the range of generated spline-path
+  const TimeVal<BasicPosVelAcc<T> > pop( const double& t ) const {
+    const std::size_t index = index_of_time( t );
+    BasicPosVelAcc<T> pva;
+    g_cubic_evaluate( a_[index], b_[index], c_[index], d_[index],
+                      T( t - times_[index] ),
+                      pva.pos, pva.vel, pva.acc );
+    return TimeVal<BasicPosVelAcc<T> >( t, pva );
+  }
+
+  /// Sample positions, velocities and accelerations at ts, ts+dT, ts+2dT, ...
+  /// @param[in]  ts   start time of sampling
+  /// @param[in]  dT   sampling cycle time (> 0)
+  /// @param[in]  size the number of samples
+  /// @param[out] pos  positions (size elements)
+  /// @param[out] vel  velocities (size elements)
+  /// @param[out] acc  accelerations (size elements)
+  /// @exception the same as pop()
+  /// @details Segments are walked forward without binary search of each sample.
+  void sample( const double& ts, const double& dT, const std::size_t& size,
+               T* pos, T* vel, T* acc ) const {
+    sample<OUTPUT_PVA>( ts, dT, size, pos, vel, acc );
+  }
+
+  /// Sample the selected outputs at ts, ts+dT, ts+2dT, ...
+  /// @param[in]  ts   start time of sampling
+  /// @param[in]  dT   sampling cycle time (> 0)
+  /// @param[in]  size the number of samples
+  /// @param[out] pos  positions (size elements, may be NULL without OUTPUT_POS)
+  /// @param[out] vel  velocities (size elements, may be NULL without OUTPUT_VEL)
+  /// @param[out] acc  accelerations (size elements, may be NULL without OUTPUT_ACC)
+  /// @tparam Mask combination of OutputMask
+  /// @exception the same as pop()
+  template<unsigned int Mask>
+  void sample( const double& ts, const double& dT, const std::size_t& size,
+               T* pos, T* vel, T* acc ) const {
+    if( size == 0 ) {
+      return;
+    }
+    // range check of the first & last samples
+    std::size_t index = index_of_time( ts );
+    index_of_time( ts + dT * ( size - 1 ) );
+    const std::size_t last_index = times_.size() - 1;
+    T unused = T(0.0);
+    for( std::size_t i=0; i < size; i++ ) {
+      const double t = ts + dT * i;
+      while( index < last_index && times_[index + 1] <= t ) {
+        index++;
+      }
+      g_cubic_evaluate_masked<Mask>( a_[index], b_[index], c_[index], d_[index],
+                                     T( t - times_[index] ),
+                                     ( Mask & OUTPUT_POS ) ? pos[i] : unused,
+                                     ( Mask & OUTPUT_VEL ) ? vel[i] : unused,
+                                     ( Mask & OUTPUT_ACC ) ? acc[i] : unused );
+    }
+  }
+
+  /// check if the path is generated
+  /// @return true if generated
+  const bool is_generated() const {
+    return !times_.empty();
+  }
+
+  /// get the number of points
+  /// @return the number of points (segments + 1)
+  const std::size_t size() const {
+    return times_.size();
+  }
+
+  /// get the start time
+  /// @return start time
+  /// @exception NotSplineGenerated : spline-path is not genrated
+  const double start_time() const {
+    check_generated();
+    return times_.front();
+  }
+
+  /// get the finish time
+  /// @return finish time
+  /// @exception NotSplineGenerated : spline-path is not genrated
+  const double finish_time() const {
+    check_generated();
+    return times_.back();
+  }
+
+  /// clear the path
+  void clear() {
+    times_.clear();
+    a_.clear();
+    b_.clear();
+    c_.clear();
+    d_.clear();
+  }
+
+private:
+  /// throw if not generated
+  /// @exception NotSplineGenerated : spline-path is not genrated
+  void check_generated() const {
+    if( times_.empty() ) {
+      const std::string err_msg = "pop data does not exist -- Path has not be generated yet.";
+      std::cerr << err_msg << std::endl;
+      THROW( NotSplineGenerated, err_msg );
+    }
+  }
+
+  /// get the index of segment of the input time
+  /// @param[in] t input time
+  /// @return the index i which satisfies times_[i] <= t < times_[i+1] (last index at the finish)
+  /// @exception the same as pop()
+  const std::size_t index_of_time( const double& t ) const {
+    check_generated();
+    if( t < times_.front() || t > times_.back() ) {
+      std::stringstream ss;
+      ss << std::fixed << std::setprecision(15);
+      ss << "time value = " << t
+         << " is out of range of generated path between t0(=" << times_.front()
+         << ") and tf(=" << times_.back() << ").";
+      std::cerr << ss.str() << std::endl;
+      THROW( TimeOutOfRange, ss.str() );
+    }
+    return ( std::upper_bound( times_.begin(), times_.end(), t ) - times_.begin() ) - 1;
+  }
+
+  /// times of points
+  std::vector<double> times_;
+
+  /// third-order parameter of cubic formula.
+  std::vector<T> a_;
+
+  /// second-order parameter of cubic formula.
+  std::vector<T> b_;
+
+  /// first-order parameter of cubic formula.
+  std::vector<T> c_;
+
+  /// zero-order parameter of cubic formula.
+  std::vector<T> d_;
+};
+
+/// Light-weight cubic spline of double
+typedef BasicCubicSpline<double> CubicSpline;
+
+/// Light-weight cubic spline of float
+typedef BasicCubicSpline<float> CubicSplineF;
+
+} // End of namespace interp
+
+#endif // INCLUDE_CUBIC_SPLINE_KERNEL_HPP_
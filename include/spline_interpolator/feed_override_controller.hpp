@@ -0,0 +1,136 @@
+#ifndef INCLUDE_FEED_OVERRIDE_CONTROLLER_HPP_
+#define INCLUDE_FEED_OVERRIDE_CONTROLLER_HPP_
+
+#include "spline_data.hpp"
+
+namespace interp {
+
+class SplineInterpolator;
+
+/// Smooth feed-rate override of the playback of a generated interpolator
+/// @details
+/// The controller keeps the path time tau of the interpolator and the override ratio s,
+/// and every step(dT) advances them as dtau/dt = s. \n
+/// The ratio follows the target (the override knob) with the limited rate |ds/dt| <= max_rate
+/// and the limited change of the rate |d^2s/dt^2| <= max_rate_change,
+/// so that s and ds/dt are continuous and the outputs
+/// - position     x(tau)
+/// - velocity     s x'(tau)
+/// - acceleration s^2 x''(tau) + ds/dt x'(tau)
+///
+/// are continuous when the knob is turned during the motion. \n
+/// The trajectory is not regenerated, and a step costs one pop() of the interpolator.
+/// s = 0 holds the motion (feed hold) and a positive s resumes it.
+///
+/// ```
+/// FeedOverrideController controller;
+/// controller.set_limit( 2.0, 10.0 );
+/// controller.start( interpolator );
+/// while( !controller.is_finished() ) {
+///   controller.set_override( knob );
+///   controller.step( dT, tpva );
+/// }
+/// ```
+class FeedOverrideController {
+public:
+  /// Constructor (max_rate: 1.0 [1/s], max_rate_change: 4.0 [1/s^2])
+  FeedOverrideController();
+
+  /// Set the limits of the override ratio
+  /// @param[in] max_rate        maximum |ds/dt| [1/s]
+  /// @param[in] max_rate_change maximum |d^2s/dt^2| [1/s^2]
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_INVALID_ARGUMENT_VALUE_ZERO : a limit is not positive
+  RetCode set_limit( const double& max_rate, const double& max_rate_change );
+
+  /// Start the playback from the start time of the interpolator
+  /// @param[in] interpolator generated interpolator (not owned, must outlive the playback)
+  /// @param[in] ratio        initial override ratio (>= 0.0, default: 1.0)
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_SEGMENT_NOT_GENERATED : path is not generated
+  /// - SPLINE_INVALID_ARGUMENT_VALUE_ZERO : ratio is negative
+  RetCode start( const SplineInterpolator& interpolator, const double& ratio=1.0 );
+
+  /// Set the target override ratio (the override knob)
+  /// @param[in] ratio target ratio (>= 0.0). 0.0: feed hold, 1.0: as generated
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_INVALID_ARGUMENT_VALUE_ZERO : ratio is negative
+  RetCode set_override( const double& ratio );
+
+  /// Advance the playback by one tick
+  /// @param[in]  dT   interval time of the tick
+  /// @param[out] tpva time (start time + elapsed time), position, velocity and acceleration
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_UNINITIALIZED_INTERPOLATOR : start() is not called
+  /// - SPLINE_INVALID_INPUT_INTERVAL_TIME_DT : dT is not positive
+  /// @details After the finish time of the path, the state at the finish is output.
+  RetCode step( const double& dT, TimePVA& tpva );
+
+  /// Get the current override ratio s
+  /// @return override ratio
+  const double override_ratio() const;
+
+  /// Get the current rate of the override ratio ds/dt
+  /// @return rate [1/s]
+  const double override_rate() const;
+
+  /// Get the target override ratio
+  /// @return target ratio
+  const double target_override() const;
+
+  /// Get the current path time tau (input time of pop() of the interpolator)
+  /// @return path time
+  const double path_time() const;
+
+  /// Get the elapsed time from start()
+  /// @return elapsed time
+  const double elapsed_time() const;
+
+  /// Check if the path time reached the finish time of the interpolator
+  /// @return true if finished
+  const bool is_finished() const;
+
+private:
+  /// Advance the override ratio toward the target
+  /// @param[in] dT interval time of the tick
+  /// @return constant d^2s/dt^2 during the tick
+  const double advance_ratio( const double& dT );
+
+  /// interpolator of the playback (NULL before start())
+  const SplineInterpolator* interpolator_;
+
+  /// maximum |ds/dt|
+  double max_rate_;
+
+  /// maximum |d^2s/dt^2|
+  double max_rate_change_;
+
+  /// target override ratio
+  double target_;
+
+  /// override ratio s
+  double ratio_;
+
+  /// rate of the override ratio ds/dt
+  double rate_;
+
+  /// path time tau
+  double path_time_;
+
+  /// finish time of the interpolator
+  double finish_time_;
+
+  /// start time of the interpolator
+  double start_time_;
+
+  /// elapsed time from start()
+  double elapsed_time_;
+};
+
+} // End of namespace interp
+
+#endif // INCLUDE_FEED_OVERRIDE_CONTROLLER_HPP_
@@ -0,0 +1,331 @@
+#ifndef INCLUDE_FIXED_SPLINE_HPP_
+#define INCLUDE_FIXED_SPLINE_HPP_
+
+#include <cstddef> // for size_t
+#include <stdexcept>
+
+#include "cubic_spline_kernel.hpp"
+#include "trapezoid_5251525.hpp"
+#include "trajectory.hpp"
+
+namespace interp {
+
+/// Cubic spline of the fixed number of points in inline buffers
+/// @tparam N the number of points (>= 3)
+/// @tparam T scalar type of positions and coefficients (float, double)
+/// @details
+/// The same path as BasicCubicSpline<T>::generate_path( times, positions, vs, vf )
+/// (bitwise equal), for short moves of a few points. \n
+/// All buffers are arrays in the object (no heap allocation),
+/// no virtual function, and every loop has the compile-time count N
+/// so that the compiler can unroll the solver and the segment search. \n
+/// Since C++14 (SPLINE_CXX14), generate_path() and evaluate() are constexpr,
+/// so the path of constant waypoints can be calculated at compile time.
+///
+/// ```
+/// constexpr double times[4]     = { 0.0, 1.0, 2.0, 3.0 };
+/// constexpr double positions[4] = { 0.0, 1.0, 0.5, 2.0 };
+/// FixedCubicSpline<4> spline;
+/// spline.generate_path( times, positions );
+/// ```
+template<std::size_t N, class T=double>
+class FixedCubicSpline : public TrajectoryBase<FixedCubicSpline<N, T>, T> {
+public:
+  /// Constructor
+  SPLINE_CONSTEXPR14 FixedCubicSpline() :
+    times_(), a_(), b_(), c_(), d_(), is_generated_(false) {
+    // compile error if N < 3
+    typedef char size_must_be_3_or_more[ ( N >= 3 ) ? 1 : -1 ];
+    (void)sizeof( size_must_be_3_or_more );
+  }
+
+  /// Generate a cubic-spline-path from times and positions
+  /// @param[in] times     target times (strictly increasing)
+  /// @param[in] positions target positions
+  /// @param[in] vs        start velocity (default: 0.0)
+  /// @param[in] vf        finish velocity (default: 0.0)
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_INPUT_TIME: times are not strictly increasing
+  /// - SPLINE_INVALID_INPUT_INTERVAL_TIME_DT: interval time is nearly zero
+  /// - SPLINE_INVALID_MATRIX_ARGUMENT_VALUE_ZERO: failed to solve velocities
+  /// @details The path is not changed on error.
+  SPLINE_CONSTEXPR14 RetCode generate_path( const double (&times)[N],
+                                            const T      (&positions)[N],
+                                            const T& vs=T(0.0), const T& vf=T(0.0) ) {
+    RetCode retcode = g_cubic_spline_check_times<T>( N, times );
+    if( retcode != SPLINE_SUCCESS ) {
+      return retcode;
+    }
+    // the same kernels as BasicCubicSpline
+    T upper[N] = {};
+    T diago[N] = {};
+    T lower[N] = {};
+    T vel[N]   = {};
+    g_cubic_spline_matrix( N, times, positions, vs, vf, lower, diago, upper, vel );
+    retcode = g_tridiagonal_solve_in_place( N, diago, upper, lower, vel, vel );
+    if( retcode != SPLINE_SUCCESS ) {
+      return retcode;
+    }
+    g_cubic_spline_coefficients( N, times, positions, vel, a_, b_, c_, d_ );
+    for( std::size_t i=0; i < N; i++ ) {
+      times_[i] = times[i];
+    }
+    is_generated_ = true;
+    return SPLINE_SUCCESS;
+  }
+
+  /// Evaluate the position, velocity and acceleration at the input-time
+  /// @param[in]  t   input time
+  /// @param[out] pos position
+  /// @param[out] vel velocity
+  /// @param[out] acc acceleration
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_SEGMENT_NOT_GENERATED: spline-path is not generated
+  /// - SPLINE_INVALID_INPUT_TIME: time is not within the range of generated spline-path
+  SPLINE_CONSTEXPR14 RetCode evaluate( const double& t, T& pos, T& vel, T& acc ) const {
+    return evaluate<OUTPUT_PVA>( t, pos, vel, acc );
+  }
+
+  /// Evaluate the selected outputs at the input-time
+  /// @param[in]  t   input time
+  /// @param[out] pos position (written if Mask has OUTPUT_POS)
+  /// @param[out] vel velocity (written if Mask has OUTPUT_VEL)
+  /// @param[out] acc acceleration (written if Mask has OUTPUT_ACC)
+  /// @tparam Mask combination of OutputMask
+  /// @return the same as evaluate()
+  template<unsigned int Mask>
+  SPLINE_CONSTEXPR14 RetCode evaluate( const double& t, T& pos, T& vel, T& acc ) const {
+    if( !is_generated_ ) {
+      return SPLINE_SEGMENT_NOT_GENERATED;
+    }
+    if( t < times_[0] || t > times_[N-1] ) {
+      return SPLINE_INVALID_INPUT_TIME;
+    }
+    const std::size_t index = index_of_time( t );
+    g_cubic_evaluate_masked<Mask>( a_[index], b_[index], c_[index], d_[index],
+                                   T( t - times_[index] ),
+                                   pos, vel, acc );
+    return SPLINE_SUCCESS;
+  }
+
+  /// check if the path is generated
+  /// @return true if generated
+  SPLINE_CONSTEXPR14 const bool is_generated() const {
+    return is_generated_;
+  }
+
+  /// get the number of points
+  /// @return N
+  SPLINE_CONSTEXPR14 const std::size_t size() const {
+    return N;
+  }
+
+  /// get the start time
+  /// @return start time (0.0 if not generated)
+  SPLINE_CONSTEXPR14 const double start_time() const {
+    return times_[0];
+  }
+
+  /// get the finish time
+  /// @return finish time (0.0 if not generated)
+  SPLINE_CONSTEXPR14 const double finish_time() const {
+    return times_[N-1];
+  }
+
+private:
+  /// get the index of segment of the input time within the range
+  /// @param[in] t input time
+  /// @return the index i which satisfies times_[i] <= t < times_[i+1] (N-1 at the finish)
+  SPLINE_CONSTEXPR14 std::size_t index_of_time( const double& t ) const {
+    // linear search is faster than the binary search for the small N
+    std::size_t index = 0;
+    for( std::size_t i=1; i < N; i++ ) {
+      index += ( times_[i] <= t ) ? 1 : 0;
+    }
+    return index;
+  }
+
+  /// times of points
+  double times_[N];
+
+  /// third-order parameter of cubic formula
+  T a_[N];
+
+  /// second-order parameter of cubic formula
+  T b_[N];
+
+  /// first-order parameter of cubic formula
+  T c_[N];
+
+  /// zero-order parameter of cubic formula
+  T d_[N];
+
+  /// generated flag
+  bool is_generated_;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+/// 固定点数の台形型5251525次軌道 (バッファはオブジェクト内の配列)
+/// @tparam N 目標点数 (>= 2)
+/// @details
+/// TrapezoidalInterpolator::generate_path( const TPQueue&, vs, vf ) と同じ軌道を,
+/// ヒープ確保・仮想関数呼び出しなしで計画・出力する. \n
+/// 中間点の速度は NonUniformRoundingSpline::compute_velocities() と同じ式で計算する.
+template<std::size_t N>
+class FixedTrapezoid : public TrajectoryBase<FixedTrapezoid<N> > {
+public:
+  /// コンストラクタ
+  /// @param[in] a_limit 第一加速(減速)度上限値
+  /// @param[in] d_limit 第二加速(減速)度上限値
+  /// @param[in] v_limit 最大速度リミット
+  /// @param[in] asr 第一丸め率
+  /// @param[in] dsr 第二丸め率
+  /// @param[in] ratio_acc_dec 第一＆第二加速度上限値に対する下限値の比率
+  FixedTrapezoid( const double& a_limit=1200,
+                  const double& d_limit=1200,
+                  const double& v_limit=170,
+                  const double& asr=0.8,
+                  const double& dsr=0.8,
+                  const double& ratio_acc_dec=0.5 ) :
+    times_(), is_generated_(false) {
+    // N < 2 ならコンパイルエラー
+    typedef char size_must_be_2_or_more[ ( N >= 2 ) ? 1 : -1 ];
+    (void)sizeof( size_must_be_2_or_more );
+    for( std::size_t i=0; i < N-1; i++ ) {
+      segments_[i].initialize( a_limit, d_limit, v_limit, asr, dsr, ratio_acc_dec );
+    }
+  }
+
+  /// 目標時刻・位置から全区間軌道を計画
+  /// @param[in] times     目標時刻 (単調増加)
+  /// @param[in] positions 目標位置
+  /// @param[in] vs        開始速度 (default: 0.0)
+  /// @param[in] vf        終端速度 (default: 0.0)
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_INVALID_INPUT_TIME : 目標時刻が単調増加でない
+  /// - SPLINE_FAIL_TO_GENERATE_PATH : 到達不可能等で区間軌道の計画に失敗
+  RetCode generate_path( const double (&times)[N],
+                         const double (&positions)[N],
+                         const double& vs=0.0, const double& vf=0.0 ) {
+    is_generated_ = false;
+    for( std::size_t i=1; i < N; i++ ) {
+      if( times[i] <= times[i-1] ) {
+        return SPLINE_INVALID_INPUT_TIME;
+      }
+    }
+    // 各区間の単位弦ベクトルから中間点の速度を計算
+    double unit_t[N] = {};
+    double unit_x[N] = {};
+    for( std::size_t i=0; i < N-1; i++ ) {
+      const double dt       = times[i+1] - times[i];
+      const double dx       = positions[i+1] - positions[i];
+      const double distance = sqrt( dt*dt + dx*dx );
+      unit_t[i] = dt / distance;
+      unit_x[i] = dx / distance;
+    }
+    double velocities[N] = {};
+    velocities[0]   = vs;
+    velocities[N-1] = vf;
+    for( std::size_t i=1; i < N-1; i++ ) {
+      velocities[i] = ( unit_x[i] + unit_x[i-1] ) / ( unit_t[i] + unit_t[i-1] );
+    }
+
+    for( std::size_t i=0; i < N-1; i++ ) {
+      try {
+        const double dT_total = segments_[i].generate_path( times[i],      times[i+1],
+                                                            positions[i],  positions[i+1],
+                                                            velocities[i], velocities[i+1] );
+        if( dT_total < 0.0 && !segments_[i].no_movement() ) {
+          return SPLINE_FAIL_TO_GENERATE_PATH;
+        }
+      } catch( const std::exception& e ) {
+        // 到達不可能等の入力エラーは計画失敗
+        return SPLINE_FAIL_TO_GENERATE_PATH;
+      }
+    }
+    for( std::size_t i=0; i < N; i++ ) {
+      times_[i] = times[i];
+    }
+    is_generated_ = true;
+    return SPLINE_SUCCESS;
+  }
+
+  /// 入力時刻の位置・速度・加速度を出力
+  /// @param[in]  t   入力時刻
+  /// @param[out] pos 位置
+  /// @param[out] vel 速度
+  /// @param[out] acc 加速度
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_SEGMENT_NOT_GENERATED : 軌道未計画
+  /// - SPLINE_INVALID_INPUT_TIME : 入力時刻が軌道の範囲外
+  RetCode evaluate( const double& t, double& pos, double& vel, double& acc ) const {
+    return evaluate<OUTPUT_PVA>( t, pos, vel, acc );
+  }
+
+  /// 入力時刻の選択した出力のみを出力
+  /// @tparam Mask OutputMask の組合せ
+  /// @param[in]  t   入力時刻
+  /// @param[out] pos 位置 (Mask に OUTPUT_POS があれば出力)
+  /// @param[out] vel 速度 (Mask に OUTPUT_VEL があれば出力)
+  /// @param[out] acc 加速度 (Mask に OUTPUT_ACC があれば出力)
+  /// @return evaluate() と同じ
+  template<unsigned int Mask>
+  RetCode evaluate( const double& t, double& pos, double& vel, double& acc ) const {
+    if( !is_generated_ ) {
+      return SPLINE_SEGMENT_NOT_GENERATED;
+    }
+    if( t < times_[0] || t > times_[N-1] ) {
+      return SPLINE_INVALID_INPUT_TIME;
+    }
+    // 点数が少ないため線形探索 (終端時刻は最終区間軌道の終端)
+    std::size_t index = 0;
+    for( std::size_t i=1; i < N-1; i++ ) {
+      index += ( times_[i] <= t ) ? 1 : 0;
+    }
+    segments_[index].template pop<Mask>( t, pos, vel, acc );
+    return SPLINE_SUCCESS;
+  }
+
+  /// 軌道計画済みか
+  /// @return 計画済みならtrue
+  const bool is_generated() const {
+    return is_generated_;
+  }
+
+  /// 目標点数
+  /// @return N
+  const std::size_t size() const {
+    return N;
+  }
+
+  /// 開始時刻
+  /// @return 開始時刻
+  const double start_time() const {
+    return times_[0];
+  }
+
+  /// 終端時刻
+  /// @return 終端時刻
+  const double finish_time() const {
+    return times_[N-1];
+  }
+
+private:
+  /// 目標時刻
+  double times_[N];
+
+  /// 区間軌道
+  Trapezoid5251525 segments_[N-1];
+
+  /// 軌道計画済みフラグ
+  bool is_generated_;
+};
+
+} // End of namespace interp
+
+#endif // INCLUDE_FIXED_SPLINE_HPP_
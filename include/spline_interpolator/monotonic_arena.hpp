@@ -0,0 +1,346 @@
+#ifndef INCLUDE_MONOTONIC_ARENA_HPP_
+#define INCLUDE_MONOTONIC_ARENA_HPP_
+
+#include <vector>
+#include <new> // for bad_alloc
+#include <limits>
+#include <cstddef> // for size_t, ptrdiff_t
+
+#include "spline_exception.hpp"
+
+#ifdef SPLINE_CXX11
+#include <type_traits> // for true_type
+#include <utility> // for forward
+#endif
+
+namespace interp {
+
+/// Alignment of the type (alignof of C++03)
+/// @tparam T type
+template<class T>
+struct AlignmentOf {
+  /// padding of char before T is the alignment of T
+  struct Padded {
+    /// leading char
+    char c;
+    /// aligned T
+    T t;
+  };
+  /// alignment [byte]
+  static const std::size_t value = sizeof(Padded) - sizeof(T);
+};
+
+template<class T>
+const std::size_t AlignmentOf<T>::value;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+/// Monotonic memory arena
+/// @details
+/// Memory is handed out by bumping the offset in large chunks, and deallocation does nothing.
+/// reset() (or rewind() to a mark()) makes all chunks reusable without returning them to the heap,
+/// so repeated plans of the same size cause no heap allocation after the first plan. \n
+/// Chunks are returned to the heap only by release() and the destructor. \n
+/// Not thread-safe: allocate from one thread at a time.
+class MonotonicArena {
+public:
+  /// Position of the arena to rewind to
+  struct Mark {
+    /// Constructor (the beginning of the arena)
+    Mark() : chunk_index(0), offset(0) {}
+    /// the index of the current chunk
+    std::size_t chunk_index;
+    /// used size of the current chunk [byte]
+    std::size_t offset;
+  };
+
+  /// default size of a chunk [byte]
+  static const std::size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+  /// default alignment of allocate() [byte]
+  static const std::size_t MAX_ALIGNMENT = 16;
+
+  /// Constructor
+  /// @param[in] chunk_size size of the first chunk [byte] (default: DEFAULT_CHUNK_SIZE).
+  ///                       the next chunk is twice the size of the last one.
+  /// @details No memory is allocated until the first allocate().
+  explicit MonotonicArena( const std::size_t& chunk_size=DEFAULT_CHUNK_SIZE );
+
+  /// Destructor
+  /// @brief return all chunks to the heap
+  ~MonotonicArena();
+
+  /// Allocate memory from the arena
+  /// @param[in] size      size [byte]
+  /// @param[in] alignment alignment [byte] of the power of 2 (default: MAX_ALIGNMENT)
+  /// @return pointer to the memory valid until reset(), rewind() or release()
+  /// @exception std::bad_alloc If a new chunk cannot be allocated.
+  void* allocate( const std::size_t& size, const std::size_t& alignment=MAX_ALIGNMENT );
+
+  /// Get the current position to rewind to
+  /// @return current position
+  const Mark mark() const;
+
+  /// Rewind the arena to the position
+  /// @param[in] position position got by mark() (memory after it is reused)
+  void rewind( const Mark& position );
+
+  /// Reuse all memory of the arena (keeps chunks)
+  void reset();
+
+  /// Return all chunks to the heap
+  void release();
+
+  /// Get the size handed out since the last reset() including padding
+  /// @return used size [byte]
+  const std::size_t used_size() const;
+
+  /// Get the total size of chunks
+  /// @return capacity [byte]
+  const std::size_t capacity() const;
+
+  /// Get the number of chunks
+  /// @return the number of chunks
+  const std::size_t chunk_num() const;
+
+  /// Get the number of chunk allocations from the heap since the construction
+  /// @return the number of heap allocations
+  const std::size_t heap_allocation_num() const;
+
+private:
+  /// Copy Constructor (prohibited)
+  MonotonicArena( const MonotonicArena& src );
+
+  /// Copy(insert) Operator (prohibited)
+  MonotonicArena& operator=( const MonotonicArena& src );
+
+  /// Chunk of memory
+  struct Chunk {
+    /// head of the memory
+    char* data;
+    /// size of the memory [byte]
+    std::size_t size;
+  };
+
+  /// chunks in the order of use
+  std::vector<Chunk> chunks_;
+
+  /// the index of the current chunk
+  std::size_t chunk_index_;
+
+  /// used size of the current chunk [byte]
+  std::size_t offset_;
+
+  /// size of the first chunk [byte]
+  std::size_t chunk_size_;
+
+  /// the number of chunk allocations from the heap
+  std::size_t heap_allocation_num_;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+/// Rewinder of the arena at the end of the scope
+/// @details Scratch buffers declared after this object are released first, then the arena is rewound.
+class ArenaScope {
+public:
+  /// Constructor
+  /// @param[in] arena arena to rewind (NULL: nothing to do)
+  explicit ArenaScope( MonotonicArena* arena ) :
+    arena_(arena) {
+    if( arena_ != NULL ) {
+      mark_ = arena_->mark();
+    }
+  }
+
+  /// Destructor
+  /// @brief rewind the arena to the position at the construction
+  ~ArenaScope() {
+    if( arena_ != NULL ) {
+      arena_->rewind( mark_ );
+    }
+  }
+
+private:
+  /// Copy Constructor (prohibited)
+  ArenaScope( const ArenaScope& src );
+
+  /// Copy(insert) Operator (prohibited)
+  ArenaScope& operator=( const ArenaScope& src );
+
+  /// arena to rewind
+  MonotonicArena* arena_;
+
+  /// position at the construction
+  MonotonicArena::Mark mark_;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+/// STL allocator on MonotonicArena
+/// @tparam T value type
+/// @details
+/// Without arena (default constructor or NULL), memory is allocated from the heap
+/// like std::allocator, so containers work the same before the arena is given. \n
+/// Copies of the allocator share the arena, and the arena must outlive the containers.
+/// Moving or swapping containers carries the arena together.
+template<class T>
+class ArenaAllocator {
+public:
+  /// value type
+  typedef T              value_type;
+  /// pointer
+  typedef T*             pointer;
+  /// constant pointer
+  typedef const T*       const_pointer;
+  /// reference
+  typedef T&             reference;
+  /// constant reference
+  typedef const T&       const_reference;
+  /// size type
+  typedef std::size_t    size_type;
+  /// difference type
+  typedef std::ptrdiff_t difference_type;
+
+  /// allocator of the other type on the same arena
+  template<class U>
+  struct rebind {
+    /// rebound allocator
+    typedef ArenaAllocator<U> other;
+  };
+
+  /// Constructor (heap allocation)
+  ArenaAllocator() :
+    arena_(NULL) {
+  }
+
+  /// Constructor
+  /// @param[in] arena arena to allocate from (NULL: heap)
+  explicit ArenaAllocator( MonotonicArena* arena ) :
+    arena_(arena) {
+  }
+
+  /// Copy Constructor from the allocator of the other type
+  /// @param[in] src source allocator
+  template<class U>
+  ArenaAllocator( const ArenaAllocator<U>& src ) :
+    arena_(src.arena()) {
+  }
+
+  /// Allocate memory of n elements
+  /// @param[in] n    the number of elements
+  /// @param[in] hint unused
+  /// @return pointer to the memory
+  /// @exception std::bad_alloc If the memory cannot be allocated.
+  pointer allocate( size_type n, const void* hint=0 ) {
+    (void)hint;
+    if( n > max_size() ) {
+      throw std::bad_alloc();
+    }
+    if( arena_ == NULL ) {
+      return static_cast<pointer>( ::operator new( n * sizeof(T) ) );
+    }
+    return static_cast<pointer>( arena_->allocate( n * sizeof(T), AlignmentOf<T>::value ) );
+  }
+
+  /// Deallocate memory (nothing to do on the arena)
+  /// @param[in] p pointer to the memory
+  /// @param[in] n the number of elements
+  void deallocate( pointer p, size_type n ) {
+    (void)n;
+    if( arena_ == NULL ) {
+      ::operator delete( p );
+    }
+  }
+
+  /// the max number of elements
+  /// @return max number of elements
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(T);
+  }
+
+  /// address of the element
+  /// @param[in] x element
+  /// @return pointer to x
+  pointer address( reference x ) const {
+    return &x;
+  }
+
+  /// address of the element
+  /// @param[in] x element
+  /// @return constant pointer to x
+  const_pointer address( const_reference x ) const {
+    return &x;
+  }
+
+#ifdef SPLINE_CXX11
+  /// carry the arena with the moved container
+  typedef std::true_type propagate_on_container_move_assignment;
+  /// carry the arena with the swapped container
+  typedef std::true_type propagate_on_container_swap;
+
+  /// construct the element in place
+  /// @param[in] p    pointer to the memory
+  /// @param[in] args arguments of the constructor
+  template<class U, class... Args>
+  void construct( U* p, Args&&... args ) {
+    ::new( static_cast<void*>( p ) ) U( std::forward<Args>( args )... );
+  }
+
+  /// destroy the element
+  /// @param[in] p pointer to the element
+  template<class U>
+  void destroy( U* p ) {
+    p->~U();
+  }
+#else
+  /// construct the element by copy
+  /// @param[in] p   pointer to the memory
+  /// @param[in] val source of copy
+  void construct( pointer p, const T& val ) {
+    ::new( static_cast<void*>( p ) ) T( val );
+  }
+
+  /// destroy the element
+  /// @param[in] p pointer to the element
+  void destroy( pointer p ) {
+    p->~T();
+  }
+#endif
+
+  /// Get the arena
+  /// @return arena (NULL: heap)
+  MonotonicArena* arena() const {
+    return arena_;
+  }
+
+private:
+  /// arena to allocate from (NULL: heap)
+  MonotonicArena* arena_;
+};
+
+/// Allocators are equal if they share the arena
+/// @return true if the memory of one can be deallocated by the other
+template<class T, class U>
+bool operator==( const ArenaAllocator<T>& a, const ArenaAllocator<U>& b ) {
+  return a.arena() == b.arena();
+}
+
+/// Allocators are different if they do not share the arena
+/// @return true if the memory of one cannot be deallocated by the other
+template<class T, class U>
+bool operator!=( const ArenaAllocator<T>& a, const ArenaAllocator<U>& b ) {
+  return a.arena() != b.arena();
+}
+
+/// std::vector on MonotonicArena (ArenaVector<T>::type)
+/// @tparam T value type
+template<class T>
+struct ArenaVector {
+  /// vector type
+  typedef std::vector<T, ArenaAllocator<T> > type;
+};
+
+} // End of namespace interp
+
+#endif // INCLUDE_MONOTONIC_ARENA_HPP_
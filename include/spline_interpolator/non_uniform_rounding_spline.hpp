@@ -28,7 +28,18 @@ public:
   /// copy operator
   /// @param[in] src source of NonUniformRoundingSpline object,
   /// @return *this
-  NonUniformRoundingSpline operator=( const NonUniformRoundingSpline& src );
+  NonUniformRoundingSpline& operator=( const NonUniformRoundingSpline& src );
+
+#ifdef SPLINE_CXX11
+  /// Move Constructor
+  /// @param[in] src source of NonUniformRoundingSpline object (empty after the move)
+  NonUniformRoundingSpline( NonUniformRoundingSpline&& src ) SPLINE_NOEXCEPT;
+
+  /// move operator
+  /// @param[in] src source of NonUniformRoundingSpline object (empty after the move)
+  /// @return *this
+  NonUniformRoundingSpline& operator=( NonUniformRoundingSpline&& src ) SPLINE_NOEXCEPT;
+#endif
 
   /// velocity calculating
   /// @param[in] tp0 time-position,velocity,accerlation point0.
@@ -40,6 +51,49 @@ public:
                              const TimePVA& tp1,
                              const TimePVA& tp2 );
 
+  /// calculate velocities of all points at once
+  /// @param[in]  times          clock times of points (strictly increasing)
+  /// @param[in]  positions      positions of points (the same size as times)
+  /// @param[out] out_velocities velocities of points (resized to the size of times)
+  /// @param[in]  vs             start velocity (default: 0.0)
+  /// @param[in]  vf             finish velocity (default: 0.0)
+  /// @param[in]  thread_pool    thread pool for parallel calculation (default: NULL -> serial)
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_QUEUE_SIZE: the size is less than 2 or sizes of times and positions differ
+  /// - SPLINE_INVALID_INPUT_TIME: times are not strictly increasing
+  /// @details
+  /// Gives the same velocities as calculate_velocity() through push() point by point,
+  /// but each chord length between neighboring points is calculated only once
+  /// over flat arrays in two passes (chord -> velocity). \n
+  /// The first and last velocities are vs and vf.
+  static RetCode compute_velocities( const std::vector<double>& times,
+                                     const std::vector<double>& positions,
+                                     std::vector<double>&       out_velocities,
+                                     const double&              vs=0.0,
+                                     const double&              vf=0.0,
+                                     SplineThreadPool*          thread_pool=NULL );
+
+  /// generate time-position-velocity queue from time-position queue at once
+  /// @param[in]  tp_queue       target time-position queue
+  /// @param[out] out_tpva_queue time-position-velocity queue (acceleration = 0.0)
+  /// @param[in]  vs             start velocity (default: 0.0)
+  /// @param[in]  vf             finish velocity (default: 0.0)
+  /// @param[in]  thread_pool    thread pool for parallel calculation (default: NULL -> serial)
+  /// @param[in]  arena          arena for scratch buffers (default: NULL -> heap)
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_QUEUE_SIZE: the size of tp_queue is less than 2
+  /// - SPLINE_INVALID_INPUT_TIME: times are not strictly increasing
+  /// @details the velocities are calculated by compute_velocities(). \n
+  /// out_tpva_queue is not changed on error.
+  static RetCode compute_tpva_queue( const TPQueue&    tp_queue,
+                                     TPVAQueue&        out_tpva_queue,
+                                     const double&     vs=0.0,
+                                     const double&     vf=0.0,
+                                     SplineThreadPool* thread_pool=NULL,
+                                     MonotonicArena*   arena=NULL );
+
   /// push(queue) the data next to the last index
   /// @param[in] clock_time  target clock time
   /// @param[in] position    target position
@@ -150,20 +204,20 @@ public:
   RetCode force_set_velocity( const std::size_t& index , const double& velocity );
 
   /// get the tpva_buffer_
-  /// @return tpva_buffer_
-  const TPVAQueue tpva_queue() const;
+  /// @return the constant reference of tpva_buffer_
+  const TPVAQueue& tpva_queue() const;
 
   /// get the TimePVA at the index of the tpva_buffer_
   /// @return TimePVA reference at the index of tpva_buffer_
-  const TimePVA get( const std::size_t& index ) const;
+  const TimePVA& get( const std::size_t& index ) const;
 
   /// get the TimePVA at the last index of the tpva_buffer_
   /// @return TimePVA reference at the last index of tpva_buffer_
-  const TimePVA front() const;
+  const TimePVA& front() const;
 
   /// get the TimePVA at the first index of the tpva_buffer_
   /// @return TimePVA reference at the first index of tpva_buffer_
-  const TimePVA back() const;
+  const TimePVA& back() const;
 
   /// pop the Time-Position-Velocity data
   /// @param[out] output ouput TimePVA(Time-Position-Velocity-(Acceleration=0)) structure data.
@@ -202,7 +256,7 @@ public:
   /// @return dT at the input-index
   /// @exception If invalid index is accessed.
   const double dT( const std::size_t& index ) const
-        throw(InvalidIndexAccess);
+        SPLINE_THROW_SPEC(InvalidIndexAccess);
 
   /// Get total interval time summarized each dT in tpva_queue
   /// @return total_dT();
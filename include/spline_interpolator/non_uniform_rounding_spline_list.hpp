@@ -0,0 +1,164 @@
+#ifndef INCLUDE_NON_UNIFORM_ROUNDING_SPLINE_LIST_HPP_
+#define INCLUDE_NON_UNIFORM_ROUNDING_SPLINE_LIST_HPP_
+
+#include "spline_interpolator.hpp"
+
+namespace interp {
+
+/// Class of calculating multi-axis velocity by Non-Uniform spline
+/// @details
+/// The chord between neighboring points is measured jointly in (t, x_0, x_1, ..., x_N-1),
+///
+/// ```
+/// d_i = sqrt( dt_i^2 + dx_0,i^2 + ... + dx_N-1,i^2 )
+/// ```
+///
+/// so one square root per point serves every axis,
+/// and the velocity vector of each point is tangent to the joint path.
+/// With one axis, velocities are the same as NonUniformRoundingSpline.
+class NonUniformRoundingSplineList {
+public:
+  /// Constructor
+  NonUniformRoundingSplineList();
+
+  /// Copy Constructor
+  /// @param[in] src source of NonUniformRoundingSplineList object
+  NonUniformRoundingSplineList( const NonUniformRoundingSplineList& src );
+
+  /// Destructor
+  ~NonUniformRoundingSplineList();
+
+  /// copy operator
+  /// @param[in] src source of NonUniformRoundingSplineList object
+  /// @return *this
+  NonUniformRoundingSplineList& operator=( const NonUniformRoundingSplineList& src );
+
+#ifdef SPLINE_CXX11
+  /// Move Constructor
+  /// @param[in] src source of NonUniformRoundingSplineList object (empty after the move)
+  NonUniformRoundingSplineList( NonUniformRoundingSplineList&& src ) SPLINE_NOEXCEPT;
+
+  /// move operator
+  /// @param[in] src source of NonUniformRoundingSplineList object (empty after the move)
+  /// @return *this
+  NonUniformRoundingSplineList& operator=( NonUniformRoundingSplineList&& src ) SPLINE_NOEXCEPT;
+#endif
+
+  /// calculate velocities of all points of all axes at once
+  /// @param[in]  times          clock times of points (strictly increasing)
+  /// @param[in]  positions      positions of points for each axis [axis][point]
+  /// @param[out] out_velocities velocities of points for each axis [axis][point]
+  /// @param[in]  vs             start velocity of each axis (empty: all 0.0)
+  /// @param[in]  vf             finish velocity of each axis (empty: all 0.0)
+  /// @param[in]  thread_pool    thread pool for parallel calculation (default: NULL -> serial)
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_QUEUE_SIZE: the size of points is less than 2,
+  ///                              or sizes of axes, points, vs, vf are not matched
+  /// - SPLINE_INVALID_INPUT_TIME: times are not strictly increasing
+  static RetCode compute_velocities( const std::vector<double>&                times,
+                                     const std::vector< std::vector<double> >& positions,
+                                     std::vector< std::vector<double> >&       out_velocities,
+                                     const std::vector<double>&                vs=std::vector<double>(),
+                                     const std::vector<double>&                vf=std::vector<double>(),
+                                     SplineThreadPool*                         thread_pool=NULL );
+
+  /// generate time-position-velocity list queue from target positions at once
+  /// @param[in]  target_queue   target time-position list queue (velocities are ignored)
+  /// @param[out] out_tpva_queue time-position-velocity list queue (acceleration = 0.0)
+  /// @param[in]  vs             start velocity of each axis (empty: all 0.0)
+  /// @param[in]  vf             finish velocity of each axis (empty: all 0.0)
+  /// @param[in]  thread_pool    thread pool for parallel calculation (default: NULL -> serial)
+  /// @return the same as compute_velocities()
+  static RetCode compute_tpva_list_queue( const TPVAListQueue&       target_queue,
+                                          TPVAListQueue&             out_tpva_queue,
+                                          const std::vector<double>& vs=std::vector<double>(),
+                                          const std::vector<double>& vf=std::vector<double>(),
+                                          SplineThreadPool*          thread_pool=NULL );
+
+  /// push(queue) the data next to the last index
+  /// @param[in] clock_time target clock time
+  /// @param[in] positions  target positions of all axes
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_INPUT_TIME: the time is less than the one of previous index
+  /// - SPLINE_INVALID_QUEUE_SIZE: the axis size differs from the one of previous index
+  /// @details
+  /// If the queue has data greater than or equal to 3 (>=3),
+  /// this function calculates the velocities of all axes of the previous index
+  /// and adds a new time-position data with velocity 0.0 into the queue.
+  RetCode push( const double& clock_time, const std::vector<double>& positions );
+
+  /// push(queue) the data next to the last index
+  /// @param[in] time_pva_list target time-position list (velocities are ignored)
+  /// @return the same as push( clock_time, positions )
+  RetCode push( const TimePVAList& time_pva_list );
+
+  /// get the tpva_list_buffer_
+  /// @return tpva_list_buffer_
+  const TPVAListQueue& tpva_list_queue() const;
+
+  /// get the TimePVAList at the index of the tpva_list_buffer_
+  /// @return the constant reference of TimePVAList at the index of tpva_list_buffer_
+  const TimePVAList& get( const std::size_t& index ) const;
+
+  /// get the TimePVAList at the first index of the tpva_list_buffer_
+  /// @return the constant reference of TimePVAList at the first index of tpva_list_buffer_
+  const TimePVAList& front() const;
+
+  /// get the TimePVAList at the last index of the tpva_list_buffer_
+  /// @return the constant reference of TimePVAList at the last index of tpva_list_buffer_
+  const TimePVAList& back() const;
+
+  /// pop the oldest Time-Position-Velocity list data in the queue (FIFO)
+  /// @return oldest TimePVAList
+  const TimePVAList pop();
+
+  /// delete front(oldest) data from buffer queue(FIFO)
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  RetCode pop_delete();
+
+  /// clear all data from the queue.
+  void clear();
+
+  /// get the size of queue.
+  /// @return queue size.
+  const std::size_t size() const;
+
+  /// get the axis size.
+  /// @return axis size (0 if no data has been pushed)
+  const std::size_t axis_size() const;
+
+private:
+  /// calculate the joint unit chord from the point (time0, pva_list0) to (time1, pva_list1)
+  /// @param[in]  time0     time of the start point
+  /// @param[in]  pva_list0 positions of the start point
+  /// @param[in]  time1     time of the end point
+  /// @param[in]  pva_list1 positions of the end point
+  /// @param[out] out_unit  unit chord (t, x_0, ..., x_N-1)
+  static void calculate_unit_chord( const double&        time0,
+                                    const PVAList&       pva_list0,
+                                    const double&        time1,
+                                    const PVAList&       pva_list1,
+                                    std::vector<double>& out_unit );
+
+  /// time, position, calculated velocity of all axes.
+  TPVAListQueue tpva_list_buffer_;
+
+  /// the axis size
+  std::size_t axis_size_;
+
+  /// unit chord (t, x_0, ..., x_N-1) to the last point
+  std::vector<double> last_unit_chord_;
+
+  /// time of the last point which last_unit_chord_ ends at
+  double last_chord_time_;
+
+  /// flag if last_unit_chord_ is valid
+  bool has_last_chord_;
+};
+
+} // End of namespace interp
+
+#endif // INCLUDE_NON_UNIFORM_ROUNDING_SPLINE_LIST_HPP_
@@ -1,12 +1,14 @@
 #ifndef INCLUDE_SPLINE_DATA_HPP_
 #define INCLUDE_SPLINE_DATA_HPP_
 
-#include <typeinfo>
 #include <math.h>
 #include <vector>
 #include <deque>
+#include <memory> // for allocator
 #include <cstddef> // for size_t
 #include <iterator> // for back_inserter
+#include <algorithm> // for swap
+#include <utility> // for move
 #include <limits> // for PRECISION ( using epsilon )
 
 #include "spline_exception.hpp"
@@ -27,27 +29,88 @@ enum RetCode{
   SPLINE_NOT_DEF_FUNCTION,
   SPLINE_NOT_RETURN,
   SPLINE_FAIL_TO_GENERATE_PATH,
-  SPLINE_UNINITIALIZED_INTERPOLATOR
+  SPLINE_UNINITIALIZED_INTERPOLATOR,
+  SPLINE_SEGMENT_NOT_GENERATED,
+  SPLINE_FILE_IO_ERROR,
+  SPLINE_INVALID_FILE_FORMAT,
+  SPLINE_LIMIT_EXCEEDED
+};
+
+/// Output mask of the masked evaluation (combined by |)
+/// @details
+/// Evaluators with the template parameter Mask compute only the selected outputs,
+/// and leave the unselected outputs untouched (or 0.0 in returned TimePVA).
+enum OutputMask {
+  OUTPUT_POS=1,                                      ///< position
+  OUTPUT_VEL=2,                                      ///< velocity
+  OUTPUT_ACC=4,                                      ///< acceleration
+  OUTPUT_POS_VEL=OUTPUT_POS|OUTPUT_VEL,              ///< position and velocity
+  OUTPUT_PVA=OUTPUT_POS|OUTPUT_VEL|OUTPUT_ACC        ///< all (the same as pop())
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
 const double PRECISION = std::numeric_limits<double>::epsilon();
 
+/// Traits of scalar type
+/// @details
+/// is_numeric is false except for the specializations (int, float, double).
+/// precision() is the tolerance of g_isNearlyEq() and g_isNearlyZero().
+template<class T>
+struct ScalarTraits {
+  /// flag if the type is numerical value
+  static const bool is_numeric = false;
+
+  /// tolerance of nearly equal
+  /// @return PRECISION
+  static double precision() { return PRECISION; }
+};
+
+template<class T> const bool ScalarTraits<T>::is_numeric;
+
+/// Traits of int
+template<>
+struct ScalarTraits<int> {
+  /// flag if the type is numerical value
+  static const bool is_numeric = true;
+
+  /// tolerance of nearly equal
+  /// @return PRECISION (same as double)
+  static double precision() { return PRECISION; }
+};
+
+/// Traits of float
+template<>
+struct ScalarTraits<float> {
+  /// flag if the type is numerical value
+  static const bool is_numeric = true;
+
+  /// tolerance of nearly equal
+  /// @return epsilon of float
+  static float precision() { return std::numeric_limits<float>::epsilon(); }
+};
+
+/// Traits of double
+template<>
+struct ScalarTraits<double> {
+  /// flag if the type is numerical value
+  static const bool is_numeric = true;
+
+  /// tolerance of nearly equal
+  /// @return PRECISION
+  static double precision() { return PRECISION; }
+};
+
 /// judge nearly equal
 /// @param[in] a
 /// @param[in] b
-/// @return true if a is nearly equal b within PRECISION, else returns false
+/// @return true if a is nearly equal b within ScalarTraits<T>::precision(), else returns false
+/// @exception InvalidTypeArgument If the type is not numerical value (see ScalarTraits).
 template<class T> bool g_isNearlyEq(T a, T b) {
-  if ( typeid(a) != typeid(int)
-       && typeid(a) != typeid(float)
-       && typeid(a) != typeid(double)
-       && typeid(b) != typeid(int)
-       && typeid(b) != typeid(float)
-       && typeid(b) != typeid(double) ) {
+  if ( !ScalarTraits<T>::is_numeric ) {
     THROW( InvalidTypeArgument, "type must be numerical value");
   }
-  if ( fabs(a - b) > PRECISION ) {
+  if ( fabs(a - b) > ScalarTraits<T>::precision() ) {
     return false;
   }
   return true;
@@ -55,14 +118,13 @@ template<class T> bool g_isNearlyEq(T a, T b) {
 
 /// judge nearly zero
 /// @param[in] a
-/// @return true if a is nearly 0 within PRECISION, else returns false
+/// @return true if a is nearly 0 within ScalarTraits<T>::precision(), else returns false
+/// @exception InvalidTypeArgument If the type is not numerical value (see ScalarTraits).
 template<class T> bool g_isNearlyZero(T a) {
-  if ( typeid(a) != typeid(int)
-       && typeid(a) != typeid(float)
-       && typeid(a) != typeid(double) ) {
+  if ( !ScalarTraits<T>::is_numeric ) {
     THROW( InvalidTypeArgument, "type must be numerical value");
   }
-  if ( fabs(a) > PRECISION ) {
+  if ( fabs(a) > ScalarTraits<T>::precision() ) {
     return false;
   }
   return true;
@@ -72,18 +134,20 @@ template<class T> bool g_isNearlyZero(T a) {
 
 
 /// Struct data of Position, Velocity, Acceleration
-struct PosVelAcc {
+/// @tparam T scalar type (double: PosVelAcc, float: PosVelAccF)
+template<class T>
+struct BasicPosVelAcc {
 public:
   /// Constructor
-  // PosVelAcc(): position(0.0),velocity(0.0),acceleration(0.0) {};
-  PosVelAcc() :
+  // BasicPosVelAcc(): position(0.0),velocity(0.0),acceleration(0.0) {};
+  BasicPosVelAcc() :
     pos(0.0),
     vel(0.0),
     acc(0.0) {};
 
   /// Copy Constructor
-  /// @param[in] src source PosVelAcc
-  PosVelAcc( const PosVelAcc& src ) :
+  /// @param[in] src source BasicPosVelAcc
+  BasicPosVelAcc( const BasicPosVelAcc& src ) :
     pos(src.pos),
     vel(src.vel),
     acc(src.acc) {};
@@ -92,36 +156,39 @@ public:
   /// @param[in] _position     initial position insert into pos
   /// @param[in] _velocity     initial velocity insert into vel
   /// @param[in] _acceleration initial acceleration insert into acc
-  PosVelAcc( const double& _position,
-             const double& _velocity=0.0,
-             const double& _acceleration=0.0) :
+  BasicPosVelAcc( const T& _position,
+                  const T& _velocity=0.0,
+                  const T& _acceleration=0.0) :
     pos(_position),
     vel(_velocity),
     acc(_acceleration) {};
 
   /// Destructor
-  ~PosVelAcc(){};
+  ~BasicPosVelAcc(){};
 
   /// Copy operator
-  /// @param[in] src source of copy which is type of PosVelAcc
-  PosVelAcc& operator=( const PosVelAcc& src ) {
-    // against self copy
-    PosVelAcc dest( src.pos,
-                    src.vel,
-                    src.acc );
-    this->pos = dest.pos;
-    this->vel = dest.vel;
-    this->acc = dest.acc;
+  /// @param[in] src source of copy which is type of BasicPosVelAcc
+  BasicPosVelAcc& operator=( const BasicPosVelAcc& src ) {
+    // self copy is harmless for scalars
+    this->pos = src.pos;
+    this->vel = src.vel;
+    this->acc = src.acc;
     return *this;
   };
   /// position [m, rad, ...etc.]
-  double pos;
+  T pos;
   /// velocity [m/s, rad/s, ...etc.]
-  double vel;
+  T vel;
   /// acceleration [m/s^2, rad/s^2, ...etc.]
-  double acc;
+  T acc;
+
+}; // End of struct BasicPosVelAcc
+
+/// Position, Velocity, Acceleration of double
+typedef BasicPosVelAcc<double> PosVelAcc;
 
-}; // End of struct TPV
+/// Position, Velocity, Acceleration of float
+typedef BasicPosVelAcc<float> PosVelAccF;
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
@@ -134,19 +201,31 @@ struct PVAList {
 
   /// Constructor(data copy)
   /// @param[in] src source of PVAList type
-  PVAList( const PVAList& src ) {
-    this->pvalist.resize( 0 );
-    std::copy( src.pvalist.begin(), src.pvalist.begin() + src.pvalist.size(),
-               std::back_inserter(this->pvalist) );
+  PVAList( const PVAList& src ) :
+    pvalist( src.pvalist ) {
   };
 
   /// Constructor(data copy)
   /// @param[in] src source of vector<PosVelAcc> type
-  PVAList( const std::vector<PosVelAcc>& src ) {
-    this->pvalist.resize( 0 );
-    std::copy( src.begin(), src.begin() + src.size(),
-               std::back_inserter(this->pvalist) );
+  PVAList( const std::vector<PosVelAcc>& src ) :
+    pvalist( src ) {
+  };
+
+#ifdef SPLINE_CXX11
+  /// Move Constructor
+  /// @param[in] src source of move (empty after the move)
+  PVAList( PVAList&& src ) SPLINE_NOEXCEPT :
+    pvalist( std::move( src.pvalist ) ) {
+  };
+
+  /// Move operator
+  /// @param[in] src source of move (empty after the move)
+  /// @return *this
+  PVAList& operator=( PVAList&& src ) SPLINE_NOEXCEPT {
+    this->pvalist = std::move( src.pvalist );
+    return *this;
   };
+#endif
 
   /// Constructor(data copy)
   /// @param[in] _pos  the source of position
@@ -172,12 +251,8 @@ struct PVAList {
   /// @param[in] src source of copy which is type of PVAList
   /// @return *this
   PVAList& operator=( const PVAList& src ) {
-    // for self copy
-    PVAList dest( src );
-    this->pvalist.clear();
-    this->pvalist.resize(0);
-    std::copy( dest.pvalist.begin(), dest.pvalist.begin() + dest.pvalist.size(),
-               std::back_inserter(this->pvalist) );
+    // vector handles self copy and reuses the allocated memory
+    this->pvalist = src.pvalist;
     return *this;
   };
 
@@ -185,21 +260,28 @@ struct PVAList {
   /// @param[in] src the source of copy which is type of PVAList
   /// @return *this
   PVAList& operator=( const std::vector<PosVelAcc>& src ) {
-    // for self copy
-    std::vector<PosVelAcc> dest = src;
-    this->pvalist.clear();
-    this->pvalist.resize(0);
-    std::copy( dest.begin(), dest.begin() + dest.size(),
-               std::back_inserter(this->pvalist) );
+    this->pvalist = src;
     return *this;
   };
 
+  /// swap the list with other without copy
+  /// @param[in,out] other the list to swap
+  void swap( PVAList& other ) {
+    this->pvalist.swap( other.pvalist );
+  };
+
   /// @param[in] index the index of list
   /// @return the reference of PosVelAcc[index]
   PosVelAcc& operator[]( const std::size_t& index ) {
     return this->pvalist[index];
   };
 
+  /// @param[in] index the index of list
+  /// @return the constant reference of PosVelAcc[index]
+  const PosVelAcc& operator[]( const std::size_t& index ) const {
+    return this->pvalist[index];
+  };
+
   /// @param[in] index the index of list
   /// @return the reference of PosVelAcc[index].pos
   double& pos( const std::size_t& index ) {
@@ -220,7 +302,7 @@ struct PVAList {
 
   /// returns the list size of PVAList
   /// @return the list size of PVAList
-  std::size_t size() {
+  std::size_t size() const {
     return this->pvalist.size();
   };
 
@@ -273,12 +355,26 @@ struct TimeVal {
   /// Copy operator
   /// @param[in] src source which is TimeVal type
   TimeVal& operator=( const TimeVal<T>& src ) {
-    // against self copy
-    TimeVal<T> dest( src.time, src.value );
-    this->time  = dest.time;
-    this->value = dest.value;
+    // P keeps referring to this->value
+    this->time  = src.time;
+    this->value = src.value;
+    return *this;
+  };
+
+#ifdef SPLINE_CXX11
+  /// Move Constructor
+  /// @param[in] src source of move
+  TimeVal( TimeVal&& src ) SPLINE_NOEXCEPT :
+    time(src.time), value(std::move(src.value)), P(value) {};
+
+  /// Move operator
+  /// @param[in] src source of move
+  TimeVal& operator=( TimeVal<T>&& src ) SPLINE_NOEXCEPT {
+    this->time  = src.time;
+    this->value = std::move( src.value );
     return *this;
   };
+#endif
   /// clock time [sec]
   double time;
   /// value [m, rad, ...etc.]
@@ -303,6 +399,12 @@ struct TimeVal<PosVelAcc>;
 
 typedef TimeVal<PosVelAcc> TimePVA;
 
+template
+struct TimeVal<PosVelAccF>;
+
+/// Time-PosVelAcc of float (time is kept in double)
+typedef TimeVal<PosVelAccF> TimePVAF;
+
 template
 struct TimeVal<PVAList>;
 
@@ -313,21 +415,35 @@ typedef TimeVal<PVAList> TimePVAList;
 /////////////////////////////////////////////////////////////////////////////////////////
 
 /// Time Queue buffer base-class
-template<class T>
+/// @tparam T     value type
+/// @tparam Alloc allocator of TimeVal<T> (default: std::allocator).
+///               ex. ArenaAllocator<TimeVal<T> > (monotonic_arena.hpp) for per-plan queues
+template<class T, class Alloc=std::allocator<TimeVal<T> > >
 class TimeQueue {
 public:
+  /// allocator type of TimeVal<T>
+  typedef Alloc allocator_type;
+
   /// Constructor
   TimeQueue() :
     total_dT_(0.0) {
   };
 
+  /// Constructor with the allocator
+  /// @param[in] alloc allocator of TimeVal<T> and dT (copies share the same memory resource)
+  explicit TimeQueue( const Alloc& alloc ) :
+    queue_buffer_( alloc ),
+    dT_queue_    ( typename DTQueue::allocator_type( alloc ) ),
+    total_dT_    ( 0.0 ) {
+  };
+
   /// Destructor
   virtual ~TimeQueue() {
   };
 
   /// Copy Constructor
   /// @param[in] src source of copy
-  TimeQueue( const TimeQueue<T>& src ) :
+  TimeQueue( const TimeQueue& src ) :
     queue_buffer_( src.queue_buffer_ ),
     dT_queue_    ( src.dT_queue_ ),
     total_dT_    ( src.total_dT_ ) {
@@ -336,19 +452,50 @@ public:
   /// Copy operator
   /// @param[in] src TimeQueue<T> source for copy
   /// @return copied instance of TimeQueue<T>
-  TimeQueue<T>& operator=( const TimeQueue<T>& src ) {
+  TimeQueue& operator=( const TimeQueue& src ) {
 
     if( src.size() < 1 ) {
       THROW( InvalidIndexAccess, "source queue size is empty." );
     }
-    TimeQueue<T> dest(src);
-    this->clear();
-    queue_buffer_ = dest.queue_buffer_;
-    dT_queue_     = dest.dT_queue_;
-    total_dT_     = dest.total_dT_;
+    // deque handles self copy and reuses the allocated memory
+    queue_buffer_ = src.queue_buffer_;
+    dT_queue_     = src.dT_queue_;
+    total_dT_     = src.total_dT_;
     return *this;
   };
 
+#ifdef SPLINE_CXX11
+  /// Move Constructor
+  /// @param[in] src source of move (empty after the move)
+  TimeQueue( TimeQueue&& src ) SPLINE_NOEXCEPT :
+    queue_buffer_( src.queue_buffer_.get_allocator() ),
+    dT_queue_    ( src.dT_queue_.get_allocator() ),
+    total_dT_    ( 0.0 ) {
+    this->swap( src );
+  };
+
+  /// Move operator
+  /// @param[in] src source of move (empty after the move)
+  /// @return *this
+  /// @details Unlike the copy operator, an empty source is allowed.
+  TimeQueue& operator=( TimeQueue&& src ) SPLINE_NOEXCEPT {
+    if( this != &src ) {
+      this->clear();
+      this->swap( src );
+    }
+    return *this;
+  };
+#endif
+
+  /// Swap all data with other queue without copy
+  /// @param[in,out] other the queue to swap
+  /// @details Hands a generated queue over to another owner in O(1) also in C++03.
+  void swap( TimeQueue& other ) {
+    queue_buffer_.swap( other.queue_buffer_ );
+    dT_queue_.swap( other.dT_queue_ );
+    std::swap( total_dT_, other.total_dT_ );
+  };
+
   /// Push TimeVal<T> data into buffer queue(FIFO)
   /// @param[in] newval TimVal<T> value source
   /// @brief push data TimVal<T> into the queue_buffer_
@@ -429,6 +576,43 @@ public:
     return SPLINE_SUCCESS;
   };
 
+  /// Replace all data of the queue by the arrays of clock time and value at once
+  /// @param[in] times  clock times (strictly increasing)
+  /// @param[in] values values at each clock time (the same size as times)
+  /// @brief build queue_buffer_ and dT at once without checking each push
+  ///        (elements allocated by the previous data are overwritten and reused)
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_QUEUE_SIZE: the sizes of times and values are different
+  /// - SPLINE_INVALID_INPUT_TIME: times are not strictly increasing (the queue is not changed)
+  template<class TimeAlloc, class ValueAlloc>
+  RetCode assign( const std::vector<double, TimeAlloc>& times,
+                  const std::vector<T, ValueAlloc>&     values ) {
+
+    if( times.size() != values.size() ) {
+      return SPLINE_INVALID_QUEUE_SIZE;
+    }
+    for( std::size_t i=1; i < times.size(); i++ ) {
+      if( times[i] <= times[i-1] ) {
+        return SPLINE_INVALID_INPUT_TIME;
+      }
+    }
+
+    // resize() keeps the allocated blocks unlike clear() & push_back()
+    queue_buffer_.resize( times.size() );
+    dT_queue_.resize( ( times.size() > 0 ) ? times.size() - 1 : 0 );
+    total_dT_ = 0.0;
+    for( std::size_t i=0; i < times.size(); i++ ) {
+      queue_buffer_[i] = TimeVal<T>( times[i], values[i] );
+    }
+    for( std::size_t i=1; i < times.size(); i++ ) {
+      double dT = calc_dT( i );
+      dT_queue_[i-1] = dT;
+      total_dT_ += dT;
+    }
+    return SPLINE_SUCCESS;
+  };
+
   /// Pop T (oldest) data from buffer queue(FIFO)
   /// @brief delete the pop data from queue_buffer_
   /// @return output oldest T data
@@ -497,10 +681,18 @@ public:
   };
 
   /// Get a time-value at the index
-  /// @return constant a value at the index
+  /// @return constant reference of a value at the index (same as at())
+  /// @exception If invalid index is accessed.
+  const TimeVal<T>& get( const std::size_t& index ) const
+    SPLINE_THROW_SPEC(InvalidIndexAccess) {
+    return this->at( index );
+  };
+
+  /// Get a reference of the time-value at the index without copy
+  /// @return constant reference of a value at the index
   /// @exception If invalid index is accessed.
-  const TimeVal<T> get( const std::size_t& index ) const
-    throw(InvalidIndexAccess) {
+  const TimeVal<T>& at( const std::size_t& index ) const
+    SPLINE_THROW_SPEC(InvalidIndexAccess) {
 
     if( index < 0 || index > queue_buffer_.size() -1 ) {
       std::stringstream err_ss;
@@ -510,14 +702,14 @@ public:
              << index;
       THROW( InvalidIndexAccess, err_ss.str() );
     }
-    return queue_buffer_.at(index);
+    return queue_buffer_[index];
   };
 
   /// Get a time-value at the first inputted index(oldest data)
-  /// @return constant a value at the first index
+  /// @return constant reference of a value at the first index
   /// @exception If invalid index is accessed.
-  const TimeVal<T> front() const
-    throw(InvalidIndexAccess) {
+  const TimeVal<T>& front() const
+    SPLINE_THROW_SPEC(InvalidIndexAccess) {
 
     if( queue_buffer_.empty() ) {
       THROW( InvalidIndexAccess, "Queue size is empty." );
@@ -526,10 +718,10 @@ public:
   };
 
   /// Get a time-value at the last inputted index(newest data)
-  /// @return constant a value at the last index
+  /// @return constant reference of a value at the last index
   /// @exception If invalid index is accessed.
-  const TimeVal<T> back() const
-    throw(InvalidIndexAccess) {
+  const TimeVal<T>& back() const
+    SPLINE_THROW_SPEC(InvalidIndexAccess) {
 
     if( queue_buffer_.empty() ) {
       THROW( InvalidIndexAccess, "Queue size is empty." );
@@ -604,6 +796,12 @@ public:
   };
 
 
+  /// Get the allocator
+  /// @return allocator of TimeVal<T>
+  allocator_type get_allocator() const {
+    return queue_buffer_.get_allocator();
+  };
+
   /// Clear all data of queue buffer
   void clear() {
     queue_buffer_.clear();
@@ -628,7 +826,7 @@ public:
   /// @return dT at the input-index
   /// @exception If invalid index is accessed.
   const double dT( const std::size_t& index ) const
-        throw(InvalidIndexAccess) {
+        SPLINE_THROW_SPEC(InvalidIndexAccess) {
 
     if( index < 0 || index > dT_queue_.size() - 1 ) {
       std::stringstream ss;
@@ -663,12 +861,15 @@ protected:
   };
 
 
+  /// dT queue type on the same allocator
+  typedef std::deque<double, typename Alloc::template rebind<double>::other> DTQueue;
+
   /// The buffer instance
-  std::deque<TimeVal<T> > queue_buffer_;
+  std::deque<TimeVal<T>, Alloc> queue_buffer_;
 
   /// The intervaltime(dT) (t[index] - t[index-1]) queue
   ///   calculated internally & automatically at the push()
-  std::deque<double> dT_queue_;
+  DTQueue dT_queue_;
 
   /// total interval time summarized each dT in dT_queue_
   double total_dT_;
@@ -686,6 +887,27 @@ public:
   /// Destructor
   virtual ~TPQueue();
 
+#ifdef SPLINE_CXX11
+  /// Copy Constructor
+  TPQueue( const TPQueue& src ) = default;
+
+  /// Copy operator
+  TPQueue& operator=( const TPQueue& src ) = default;
+
+  /// Move Constructor
+  /// @param[in] src source of move (empty after the move)
+  TPQueue( TPQueue&& src ) SPLINE_NOEXCEPT :
+    TimeQueue<double>( std::move( src ) ) {};
+
+  /// Move operator
+  /// @param[in] src source of move (empty after the move)
+  /// @return *this
+  TPQueue& operator=( TPQueue&& src ) SPLINE_NOEXCEPT {
+    TimeQueue<double>::operator=( std::move( src ) );
+    return *this;
+  };
+#endif
+
   /// dump all queue list
   /// @param[out] dest_queue_dump output of all queue data as string.
   virtual RetCode dump( std::string& destt_queue_dump );
@@ -704,6 +926,27 @@ public:
   /// Destructor
   virtual ~TPVAQueue();
 
+#ifdef SPLINE_CXX11
+  /// Copy Constructor
+  TPVAQueue( const TPVAQueue& src ) = default;
+
+  /// Copy operator
+  TPVAQueue& operator=( const TPVAQueue& src ) = default;
+
+  /// Move Constructor
+  /// @param[in] src source of move (empty after the move)
+  TPVAQueue( TPVAQueue&& src ) SPLINE_NOEXCEPT :
+    TimeQueue<PosVelAcc>( std::move( src ) ) {};
+
+  /// Move operator
+  /// @param[in] src source of move (empty after the move)
+  /// @return *this
+  TPVAQueue& operator=( TPVAQueue&& src ) SPLINE_NOEXCEPT {
+    TimeQueue<PosVelAcc>::operator=( std::move( src ) );
+    return *this;
+  };
+#endif
+
   /// Push TimePVA data into buffer queue(FIFO)
   /// @brief push TPV into the tpv_buffer_
   /// @param[in] TPV new target time position, velocity, acceleration
@@ -751,6 +994,9 @@ public:
 
 }; // End of class TPVQueue
 
+/// TPV Queue buffer of float (push(TimePVAF), assign(), at(), ...)
+typedef TimeQueue<PosVelAccF> TPVAQueueF;
+
 /////////////////////////////////////////////////////////////////////////////////////////
 
 /// TPVList Queue buffer class
@@ -763,6 +1009,27 @@ public:
   /// Destructor
   virtual ~TPVAListQueue();
 
+#ifdef SPLINE_CXX11
+  /// Copy Constructor
+  TPVAListQueue( const TPVAListQueue& src ) = default;
+
+  /// Copy operator
+  TPVAListQueue& operator=( const TPVAListQueue& src ) = default;
+
+  /// Move Constructor
+  /// @param[in] src source of move (empty after the move)
+  TPVAListQueue( TPVAListQueue&& src ) SPLINE_NOEXCEPT :
+    TimeQueue<PVAList>( std::move( src ) ) {};
+
+  /// Move operator
+  /// @param[in] src source of move (empty after the move)
+  /// @return *this
+  TPVAListQueue& operator=( TPVAListQueue&& src ) SPLINE_NOEXCEPT {
+    TimeQueue<PVAList>::operator=( std::move( src ) );
+    return *this;
+  };
+#endif
+
   /// Push TimePVAList data into buffer queue(FIFO)
   /// @brief push TimePVAList into the tpv_buffer_
   /// @param[in] newval TimePVAList new target time position
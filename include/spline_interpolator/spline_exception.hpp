@@ -40,6 +40,33 @@ template<class T> const std::string g_num2str(const T& num) {
   return s.str();
 };
 
+/// defined if the compiler supports C++11 or later (move semantics, noexcept)
+#if __cplusplus >= 201103L
+#define SPLINE_CXX11
+#endif
+
+#ifdef SPLINE_CXX11
+/// no-throw exception specification
+#define SPLINE_NOEXCEPT noexcept
+/// dynamic exception specification (only for C++03, ill-formed since C++17)
+#define SPLINE_THROW_SPEC( exception_class_name )
+#else
+#define SPLINE_NOEXCEPT throw()
+#define SPLINE_THROW_SPEC( exception_class_name ) throw( exception_class_name )
+#endif
+
+/// defined if the compiler supports C++14 or later (relaxed constexpr)
+#if __cplusplus >= 201402L
+#define SPLINE_CXX14
+#endif
+
+#ifdef SPLINE_CXX14
+/// constexpr of C++14 (functions with loops and assignments), empty before C++14
+#define SPLINE_CONSTEXPR14 constexpr
+#else
+#define SPLINE_CONSTEXPR14
+#endif
+
 /// wrapper of throw()
 #define THROW( exception_class_name, message )                          \
   throw exception_class_name( message + std::string(" -- at ")      \
@@ -60,7 +87,7 @@ public:
     std::runtime_error( "["+ name +"]: "+ message ) {}
 
   /// Destructor
-  ~SplineException() throw() {}
+  ~SplineException() SPLINE_NOEXCEPT {}
 
   /// get Exception Code
   /// @return SPLINE_EXCEPTION
@@ -0,0 +1,339 @@
+#ifndef INCLUDE_SPLINE_EXECUTOR_HPP_
+#define INCLUDE_SPLINE_EXECUTOR_HPP_
+
+#include <pthread.h>
+#include <vector>
+#include <deque>
+#include <cstddef> // for size_t
+
+#include "spline_data.hpp"
+#include "monotonic_arena.hpp"
+#include "spline_thread_pool.hpp"
+
+namespace interp {
+
+class SplineExecutor;
+class SplineWorkerContext;
+class SplineInterpolator;
+
+/// size of a cache line [byte] to separate the state of workers
+#define SPLINE_CACHE_LINE_SIZE 64
+
+/// Job executed by SplineExecutor
+/// @details
+/// run() is called once on one of the worker threads.
+/// Jobs of a batch run concurrently, so a job must write only its own outputs. \n
+/// An exception thrown from run() is recorded as SPLINE_FAIL_TO_GENERATE_PATH.
+class SplineJob {
+  friend class SplineExecutor;
+public:
+  /// Constructor
+  SplineJob();
+
+  /// Destructor
+  virtual ~SplineJob();
+
+  /// Execute the job
+  /// @param[in] context context of the worker thread executing the job
+  /// @return status of the job
+  virtual RetCode run( SplineWorkerContext& context ) = 0;
+
+  /// Get the status of the last execution
+  /// @return
+  /// - SPLINE_NOT_RETURN : not executed yet
+  /// - the return value of run()
+  const RetCode status() const;
+
+private:
+  /// status of the last execution
+  RetCode status_;
+};
+
+
+/// Context of the worker thread given to SplineJob::run()
+class SplineWorkerContext {
+  friend class SplineExecutor;
+public:
+  /// Get the index of the worker
+  /// @return index of the worker slot (< SplineExecutor::thread_num())
+  const std::size_t worker_index() const;
+
+  /// Get the scratch arena of the worker
+  /// @return arena owned by the worker (reset after every job)
+  MonotonicArena* arena() const;
+
+  /// Submit a job to run in the current batch (e.g. a job depending on this one)
+  /// @param[in] job job to execute (not owned, must outlive SplineExecutor::run_all())
+  /// @details The job is pushed to the queue of this worker, and idle workers steal it.
+  void submit( SplineJob& job );
+
+private:
+  /// Constructor
+  /// @param[in] executor     executor of the worker
+  /// @param[in] worker_index index of the worker
+  SplineWorkerContext( SplineExecutor& executor, const std::size_t& worker_index );
+
+  /// executor of the worker
+  SplineExecutor& executor_;
+
+  /// index of the worker
+  std::size_t worker_index_;
+};
+
+
+/// Job generating the path of the interpolator
+/// @details The scratch buffers of generate_path() are taken from the arena of the worker
+/// (a CubicSplineInterpolator with a workspace set by set_workspace() plans on the workspace).
+class GeneratePathJob : public SplineJob {
+public:
+  /// Constructor
+  /// @param[in] interpolator    interpolator to generate (not owned)
+  /// @param[in] target_tp_queue target Time, Position queue (not owned)
+  /// @param[in] next            job submitted after the successful generation (default: NULL)
+  GeneratePathJob( SplineInterpolator& interpolator, const TPQueue& target_tp_queue,
+                   SplineJob* next=NULL );
+
+  /// Constructor
+  /// @param[in] interpolator      interpolator to generate (not owned)
+  /// @param[in] target_tpva_queue target Time, Position, Velocity, Acceleration queue (not owned)
+  /// @param[in] next              job submitted after the successful generation (default: NULL)
+  GeneratePathJob( SplineInterpolator& interpolator, const TPVAQueue& target_tpva_queue,
+                   SplineJob* next=NULL );
+
+  /// Generate the path
+  /// @param[in] context context of the worker thread
+  /// @return the return value of SplineInterpolator::generate_path()
+  virtual RetCode run( SplineWorkerContext& context );
+
+private:
+  /// interpolator to generate
+  SplineInterpolator& interpolator_;
+
+  /// target Time, Position queue (NULL if TPVAQueue is given)
+  const TPQueue* target_tp_queue_;
+
+  /// target Time, Position, Velocity, Acceleration queue (NULL if TPQueue is given)
+  const TPVAQueue* target_tpva_queue_;
+
+  /// job submitted after the successful generation
+  SplineJob* next_;
+};
+
+
+/// Job sampling the path of the interpolator uniformly
+class SampleJob : public SplineJob {
+public:
+  /// Constructor
+  /// @param[in]  interpolator generated interpolator (not owned)
+  /// @param[in]  ts           start time of sampling
+  /// @param[in]  dT           sampling cycle time
+  /// @param[in]  size         the number of samples
+  /// @param[out] pos          positions (size elements)
+  /// @param[out] vel          velocities (size elements, may be NULL)
+  /// @param[out] acc          accelerations (size elements, may be NULL)
+  SampleJob( const SplineInterpolator& interpolator,
+             const double& ts, const double& dT, const std::size_t& size,
+             double* pos, double* vel=NULL, double* acc=NULL );
+
+  /// Sample the path at ts, ts+dT, ts+2dT, ...
+  /// @param[in] context context of the worker thread
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_SEGMENT_NOT_GENERATED : path is not generated
+  /// - SPLINE_INVALID_INPUT_TIME : a sample time is out of the path
+  virtual RetCode run( SplineWorkerContext& context );
+
+private:
+  /// generated interpolator
+  const SplineInterpolator& interpolator_;
+
+  /// start time of sampling
+  double ts_;
+
+  /// sampling cycle time
+  double dT_;
+
+  /// the number of samples
+  std::size_t size_;
+
+  /// positions
+  double* pos_;
+
+  /// velocities
+  double* vel_;
+
+  /// accelerations
+  double* acc_;
+};
+
+
+/// Work-stealing executor of planning and sampling jobs
+/// @details
+/// Each worker has its own job queue, scratch arena and counters
+/// in a cache-line-padded slot, so that workers do not share cache lines. \n
+/// run_all() deals the submitted jobs round-robin to the queues.
+/// A worker takes jobs from the back of its own queue,
+/// and steals from the front of the other queues when its queue is empty. \n
+/// The threads are those of a SplineThreadPool owned by the executor,
+/// so they are created once and sleep between batches like the other parallel planning:
+/// run_all() hands one chunk per worker slot to SplineThreadPool::parallel_for(),
+/// and each slot runs its queue and steals until the batch has finished.
+/// The calling thread of run_all() works as one of the slots.
+///
+/// ```
+/// SplineExecutor executor;
+/// SampleJob       sample_x( interpolator_x, 0.0, 0.01, 1000, &pos_x[0] );
+/// GeneratePathJob generate_x( interpolator_x, tp_queue_x, &sample_x );
+/// executor.submit( generate_x );
+/// ...
+/// executor.run_all();
+/// ```
+class SplineExecutor {
+  friend class SplineWorkerContext;
+public:
+  /// Constructor
+  /// @param[in] thread_num       the number of threads including the calling thread
+  ///                             (default: 0 -> the number of online processors)
+  /// @param[in] arena_chunk_size size of the first chunk of the arena of each worker [byte]
+  explicit SplineExecutor( const std::size_t& thread_num=0,
+                           const std::size_t& arena_chunk_size=MonotonicArena::DEFAULT_CHUNK_SIZE );
+
+  /// Destructor
+  /// @brief stop and join all worker threads
+  ~SplineExecutor();
+
+  /// Submit a job to the next batch
+  /// @param[in] job job to execute (not owned, must outlive run_all())
+  void submit( SplineJob& job );
+
+  /// Execute the submitted jobs and the jobs submitted by them
+  /// @return
+  /// - SPLINE_SUCCESS : all jobs succeeded
+  /// - the status of a failed job (see SplineJob::status() of each job)
+  /// @details Returns after every job has finished. The submitted jobs are cleared.
+  RetCode run_all();
+
+  /// The number of threads including the calling thread
+  /// @return the number of worker threads + 1
+  const std::size_t thread_num() const;
+
+  /// The number of jobs executed by the worker in the last run_all()
+  /// @param[in] worker_index index of the worker (< thread_num())
+  /// @return the number of executed jobs
+  const std::size_t executed_job_num( const std::size_t& worker_index ) const;
+
+  /// The number of jobs stolen by the worker in the last run_all()
+  /// @param[in] worker_index index of the worker (< thread_num())
+  /// @return the number of stolen jobs
+  const std::size_t stolen_job_num( const std::size_t& worker_index ) const;
+
+private:
+  /// Copy Constructor (prohibited)
+  SplineExecutor( const SplineExecutor& src );
+
+  /// Copy(insert) Operator (prohibited)
+  SplineExecutor& operator=( const SplineExecutor& src );
+
+  /// State of a worker
+  struct WorkerState {
+    /// Constructor
+    /// @param[in] arena_chunk_size size of the first chunk of the arena [byte]
+    explicit WorkerState( const std::size_t& arena_chunk_size );
+
+    /// Destructor
+    ~WorkerState();
+
+    /// protects jobs
+    pthread_mutex_t mutex;
+
+    /// job queue (the owner takes the back, thieves take the front)
+    std::deque<SplineJob*> jobs;
+
+    /// scratch arena
+    MonotonicArena arena;
+
+    /// the number of executed jobs
+    std::size_t executed_num;
+
+    /// the number of stolen jobs
+    std::size_t stolen_num;
+  };
+
+  /// State of a worker separated from the neighbors by cache lines
+  struct PaddedWorkerState {
+    /// Constructor
+    /// @param[in] arena_chunk_size size of the first chunk of the arena [byte]
+    explicit PaddedWorkerState( const std::size_t& arena_chunk_size ) :
+      state(arena_chunk_size) {
+    }
+    /// padding before the state
+    char head_padding[SPLINE_CACHE_LINE_SIZE];
+    /// state
+    WorkerState state;
+    /// padding after the state
+    char tail_padding[SPLINE_CACHE_LINE_SIZE];
+  };
+
+  /// Task of a batch on the thread pool, one index per worker slot
+  class BatchTask : public RangeTask {
+  public:
+    /// Constructor
+    /// @param[in] executor executor of the batch
+    explicit BatchTask( SplineExecutor& executor ) : executor_(executor) {}
+
+    /// Run the worker slots [begin, end)
+    /// @param[in] begin the first index of the worker slots
+    /// @param[in] end   the index next to the last of the worker slots
+    virtual void run( const std::size_t& begin, const std::size_t& end );
+
+  private:
+    /// executor of the batch
+    SplineExecutor& executor_;
+  };
+  friend class BatchTask;
+
+  /// Execute jobs of the current batch until all jobs have finished
+  /// @param[in] worker_index index of the worker
+  void run_jobs( const std::size_t& worker_index );
+
+  /// Take a job from the own queue or steal from the others
+  /// @param[in] worker_index index of the worker
+  /// @return job (NULL: no job in any queue)
+  SplineJob* take_job( const std::size_t& worker_index );
+
+  /// Push the job to the queue of the worker
+  /// @param[in] worker_index index of the worker
+  /// @param[in] job          job
+  void push_job( const std::size_t& worker_index, SplineJob& job );
+
+  /// threads running the worker slots
+  SplineThreadPool pool_;
+
+  /// states of the worker slots (one per thread of pool_)
+  std::vector<PaddedWorkerState*> workers_;
+
+  /// jobs submitted to the next batch
+  std::vector<SplineJob*> submitted_jobs_;
+
+  /// serializes callers of run_all()
+  pthread_mutex_t call_mutex_;
+
+  /// protects the batch state below
+  pthread_mutex_t mutex_;
+
+  /// signaled when a job is submitted or the batch has finished
+  pthread_cond_t idle_cond_;
+
+  /// the number of jobs not finished in the current batch
+  std::size_t remaining_num_;
+
+  /// incremented every submission from jobs
+  unsigned long submit_sequence_;
+
+  /// status of a failed job in the current batch
+  RetCode failed_status_;
+};
+
+} // End of namespace interp
+
+#endif // INCLUDE_SPLINE_EXECUTOR_HPP_
@@ -10,6 +10,10 @@
 
 namespace interp {
 
+class SplineThreadPool;
+class RangeTask;
+class MonotonicArena;
+
 /// Base class of spline-path interpolator
 class SplineInterpolator
 {
@@ -24,6 +28,22 @@ public:
   /// @param[in] src source to copy SplineInterpolator
   SplineInterpolator( const SplineInterpolator& src );
 
+  /// Copy(insert) Operator
+  /// @param[in] src source to copy SplineInterpolator
+  /// @return *this
+  SplineInterpolator& operator=( const SplineInterpolator& src );
+
+#ifdef SPLINE_CXX11
+  /// Move Constructor
+  /// @param[in] src source to move SplineInterpolator (not generated after the move)
+  SplineInterpolator( SplineInterpolator&& src ) SPLINE_NOEXCEPT;
+
+  /// Move(insert) Operator
+  /// @param[in] src source to move SplineInterpolator (not generated after the move)
+  /// @return *this
+  SplineInterpolator& operator=( SplineInterpolator&& src ) SPLINE_NOEXCEPT;
+#endif
+
   /// Copy Constructor - value copy
   /// @param[in] is_path_generated   flag if the spline-path is generated
   /// @param[in] is_v_limitation    flag if velocity limit (v_limit) is defined or not
@@ -35,7 +55,7 @@ public:
                       const TPVAQueue& target_tpva_queue );
 
   /// Get total interval time
-  /// @return total interval time of spline-path
+  /// @return total interval time of spline-path (in the input time of pop() if the time scale is set)
   /// @exception
   /// - NotSplineGenerated : spline-path is not genrated
   const double total_dT() const;
@@ -47,19 +67,19 @@ public:
   const double v_limit() const;
 
   /// Get start time
-  /// @return start time
+  /// @return start time (in the input time of pop() if the time scale is set)
   /// @exception
   /// - NotSplineGenerated : spline-path is not genrated
   const double start_time() const;
 
   /// Get finish time
-  /// @return finish time
+  /// @return finish time (in the input time of pop() if the time scale is set)
   /// @exception
   /// - NotSplineGenerated : spline-path is not genrated
   const double finish_time() const;
 
   /// Get the trajectory index of the input time
-  /// @param[in] t            input time
+  /// @param[in] t            time of the generated path, i.e. path_time() of the input time of pop()
   /// @param[in] output_index output index matched the input time
   /// @return
   /// - SPLINE_INVALID_INPUT_TIME : fail. The input time is out of range of target_tpva_queue.
@@ -67,6 +87,9 @@ public:
   /// @exception
   /// - QueueSizeEmpty : failed to pop a point from trajectory
   ///                    because the size of target_tpva_queue is zero.
+  /// @details
+  /// Binary search ( O(log n) ) over the monotonically increasing time of target_tpva_queue_. \n
+  /// Unlike start_time() and finish_time(), t is not converted by the time scale.
   const RetCode index_of_time( const double& t,
                                std::size_t&  output_index ) const;
 
@@ -158,11 +181,82 @@ public:
   ///       & path parameter queue (depend on each interpolator class)
   virtual RetCode clear();
 
+  /// Set the time scale (feed override) of pop() without regenerating the path
+  /// @param[in] scale time scale s (> 0.0). 1.0: as generated, 0.5: half speed, 2.0: double speed
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_UNINITIALIZED_INTERPOLATOR : path is not generated
+  /// - SPLINE_INVALID_ARGUMENT_VALUE_ZERO : scale is not positive
+  /// @details
+  /// pop(t) evaluates the path at t' = t0 + s (t - t0) with the start time t0,
+  /// and scales the velocity by s and the acceleration by s^2.
+  /// The coefficients are not touched, so the change is O(1). \n
+  /// start_time(), finish_time() and total_dT() are given in the input time of pop(),
+  /// while index_of_time() takes the time of the generated path (see path_time()). \n
+  /// The scale is kept until clear() or the next set_time_scale().
+  RetCode set_time_scale( const double& scale );
+
+  /// Set the time scale (feed override) of pop() keeping the path time at the anchor
+  /// @param[in] scale  time scale s (> 0.0)
+  /// @param[in] anchor input time of pop() where the path time is kept (e.g. the current time)
+  /// @return the same as set_time_scale( scale )
+  /// @details
+  /// pop(t) evaluates the path at t' = path_time( anchor ) + s (t - anchor),
+  /// so the position is continuous when the scale is changed during the playback.
+  RetCode set_time_scale( const double& scale, const double& anchor );
+
+  /// Get the time scale
+  /// @return time scale s (default: 1.0)
+  const double time_scale() const;
+
+  /// Convert the input time of pop() into the time of the generated path
+  /// @param[in] t input time of pop()
+  /// @return time of the generated path (t itself without time scale)
+  const double path_time( const double& t ) const;
+
   /// Return the size of target TPVAQueue (target_tpva_queue_)
   /// @return targt_tpva_queue_
   const std::size_t target_tpva_queue_size() const;
 
+  /// Set the thread pool for parallel generation of independent segments
+  /// @param[in] thread_pool pointer to the thread pool (not owned).
+  ///                        NULL means serial generation (default).
+  /// @param[in] grain       the number of segments per chunk (default: 0 -> automatic)
+  /// @details
+  /// The pool must outlive the interpolator or be reset by set_thread_pool(NULL).
+  /// Parallel generation gives the same result as serial generation.
+  void set_thread_pool( SplineThreadPool* thread_pool, const std::size_t& grain=0 );
+
+  /// Get the thread pool for parallel generation
+  /// @return pointer to the thread pool. NULL if not set.
+  SplineThreadPool* thread_pool() const;
+
+  /// Set the arena for scratch buffers of generate_path()
+  /// @param[in] arena pointer to the arena (not owned).
+  ///                  NULL means scratch buffers on the heap (default).
+  /// @details
+  /// Scratch buffers are allocated from the arena and the arena is rewound
+  /// at the end of generate_path(), so one arena can be shared by the planners of a thread
+  /// and repeated plans cause no heap allocation for scratch buffers. \n
+  /// The generated path itself is kept in the interpolator, reusing its own buffers. \n
+  /// The arena must outlive the interpolator or be reset by set_arena(NULL).
+  /// CubicSplineInterpolator plans on the workspace instead if set_workspace() is called.
+  void set_arena( MonotonicArena* arena );
+
+  /// Get the arena for scratch buffers
+  /// @return pointer to the arena. NULL if not set.
+  MonotonicArena* arena() const;
+
 protected:
+  /// Execute the task for each segment index in [begin, end)
+  /// @param[in] begin the first segment index
+  /// @param[in] end   the segment index next to the last
+  /// @param[in] task  task body executed on sub-ranges
+  /// @details In parallel if the thread pool is set, else serially in the calling thread.
+  void for_each_segment( const std::size_t& begin,
+                         const std::size_t& end,
+                         RangeTask&         task ) const;
+
   /// flag if the spline-path is generated. (default: false)
   bool is_path_generated_;
 
@@ -175,6 +269,32 @@ protected:
 
   /// target TPVQueue
   TPVAQueue target_tpva_queue_;
+
+  /// flag if the time scale differs from the identity (default: false)
+  bool is_time_scaled_;
+
+  /// time scale of pop() (default: 1.0)
+  double time_scale_;
+
+  /// input time of pop() at the origin of the time scale
+  double scale_input_origin_;
+
+  /// path time at the origin of the time scale
+  double scale_path_origin_;
+
+  /// thread pool for parallel generation (not owned, default: NULL)
+  SplineThreadPool* thread_pool_;
+
+  /// the number of segments per chunk of parallel generation (default: 0 -> automatic)
+  std::size_t parallel_grain_;
+
+  /// arena for scratch buffers of generate_path() (not owned, default: NULL)
+  MonotonicArena* arena_;
+
+  /// Convert the time of the generated path into the input time of pop()
+  /// @param[in] t time of the generated path
+  /// @return input time of pop()
+  const double input_time( const double& t ) const;
 }; // End of class SplineInterpolator
 
 } // End of namespace interp
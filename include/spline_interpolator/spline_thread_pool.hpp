@@ -0,0 +1,149 @@
+#ifndef INCLUDE_SPLINE_THREAD_POOL_HPP_
+#define INCLUDE_SPLINE_THREAD_POOL_HPP_
+
+#include <pthread.h>
+#include <vector>
+#include <string>
+#include <cstddef> // for size_t
+
+#include "spline_data.hpp"
+
+namespace interp {
+
+/// Task body executed on a sub-range by SplineThreadPool::parallel_for()
+/// @details
+/// run() is called concurrently from several threads with disjoint sub-ranges,
+/// so each index must write only its own output slot. \n
+/// An exception thrown by run() cancels the chunks not handed out yet,
+/// and parallel_for() rethrows it as std::runtime_error of the same message
+/// after the running chunks have finished.
+class RangeTask {
+public:
+  /// Destructor
+  virtual ~RangeTask() {}
+
+  /// Execute the task on the sub-range [begin, end)
+  /// @param[in] begin the first index of the sub-range
+  /// @param[in] end   the index next to the last of the sub-range
+  virtual void run( const std::size_t& begin, const std::size_t& end ) = 0;
+};
+
+
+/// Persistent thread pool for parallel generation of independent segments
+/// @details
+/// Worker threads are created once in the constructor and sleep between jobs. \n
+/// parallel_for() splits the index range into chunks of grain size
+/// and hands them out dynamically to the workers and the calling thread.
+/// Only one parallel_for() runs at a time; concurrent callers are serialized. \n
+/// parallel_for() called from run() of a task of the same pool runs serially
+/// on the calling thread instead of waiting for the busy pool.
+class SplineThreadPool {
+public:
+  /// Constructor
+  /// @param[in] thread_num the number of threads including the calling thread
+  ///                       (default: 0 -> the number of online processors)
+  explicit SplineThreadPool( const std::size_t& thread_num=0 );
+
+  /// Destructor
+  /// @brief stop and join all worker threads
+  ~SplineThreadPool();
+
+  /// Execute the task on [begin, end) in parallel
+  /// @param[in] begin the first index
+  /// @param[in] end   the index next to the last
+  /// @param[in] task  task body to execute
+  /// @param[in] grain the number of indices per chunk
+  ///                  (default: 0 -> (end - begin) / (4 * thread_num()))
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_INVALID_INPUT_INDEX : begin > end
+  /// @exception std::runtime_error task.run() threw on a worker or the calling thread
+  /// @details Returns after every chunk has finished. \n
+  /// If the range is not shared, i.e. a single thread, a single chunk,
+  /// or a nested call from a task of this pool, task.run() is called directly
+  /// and its exception propagates as it is.
+  RetCode parallel_for( const std::size_t& begin,
+                        const std::size_t& end,
+                        RangeTask&         task,
+                        const std::size_t& grain=0 );
+
+  /// The number of threads including the calling thread
+  /// @return the number of worker threads + 1
+  const std::size_t thread_num() const;
+
+  /// The number of online processors
+  /// @return the number of online processors (>= 1)
+  static const std::size_t hardware_concurrency();
+
+private:
+  /// Copy Constructor (prohibited)
+  SplineThreadPool( const SplineThreadPool& src );
+
+  /// Copy(insert) Operator (prohibited)
+  SplineThreadPool& operator=( const SplineThreadPool& src );
+
+  /// entry point of worker threads
+  /// @param[in] arg pointer to SplineThreadPool
+  static void* worker_entry( void* arg );
+
+  /// loop of worker threads
+  void worker_loop();
+
+  /// Execute chunks of the current job until the range is exhausted
+  /// @details Call with mutex_ locked. mutex_ is unlocked while the task runs.
+  void run_chunks();
+
+  /// Record the first error of the current job and stop handing out chunks
+  /// @param[in] error_message what() of the exception thrown by the task
+  /// @details Call with mutex_ locked.
+  void cancel_job( const std::string& error_message );
+
+  /// worker threads
+  std::vector<pthread_t> workers_;
+
+  /// serializes callers of parallel_for()
+  pthread_mutex_t call_mutex_;
+
+  /// protects the job state below
+  pthread_mutex_t mutex_;
+
+  /// signaled when a new job is posted or the pool stops
+  pthread_cond_t work_cond_;
+
+  /// signaled when the last busy worker leaves the job
+  pthread_cond_t done_cond_;
+
+  /// task of the current job
+  RangeTask* task_;
+
+  /// the first index not handed out yet
+  std::size_t next_;
+
+  /// the index next to the last of the current job
+  std::size_t end_;
+
+  /// the number of indices per chunk of the current job
+  std::size_t grain_;
+
+  /// the number of workers running chunks of the current job
+  std::size_t busy_;
+
+  /// incremented every job posting
+  unsigned long generation_;
+
+  /// flag if the pool is stopping
+  bool is_stop_;
+
+  /// flag if a task of the current job threw
+  bool is_failed_;
+
+  /// what() of the first exception of the current job
+  std::string error_message_;
+
+  /// set to this pool on threads running chunks, to detect nested parallel_for()
+  pthread_key_t running_key_;
+};
+
+} // End of namespace interp
+
+#endif // INCLUDE_SPLINE_THREAD_POOL_HPP_
@@ -0,0 +1,480 @@
+#ifndef INCLUDE_TPVA_ARRAY_QUEUE_HPP_
+#define INCLUDE_TPVA_ARRAY_QUEUE_HPP_
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <cstddef> // for size_t
+
+#include "spline_data.hpp"
+
+namespace interp {
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+/// Struct data of Position, Velocity, Acceleration of N axes (N is fixed at compile time)
+/// @details
+/// The same accessors as PVAList, but all axes are stored inline without heap allocation.
+template<std::size_t N>
+struct PVAArray {
+  /// Constructor
+  /// @brief all positions, velocities, accelerations are 0.0
+  PVAArray() {
+  };
+
+  /// Constructor(data copy)
+  /// @param[in] src source of PVAList type
+  /// @exception InvalidArgumentSize the size of src is not N
+  PVAArray( const PVAList& src ) {
+    if( src.size() != N ) {
+      THROW( InvalidArgumentSize,
+             "the size of PVAList must be the same as the axis size of PVAArray." );
+    }
+    for( std::size_t i=0; i < N; i++ ) {
+      this->pvaarray[i] = src[i];
+    }
+  };
+
+  /// Constructor(data copy)
+  /// @param[in] _pos  the source of position
+  /// @param[in] _vel  the source of velocity
+  /// @param[in] _acc  the source of acceleration
+  /// @exception InvalidArgumentSize the sizes of arguments are not N
+  PVAArray( const std::vector<double>& _pos,
+            const std::vector<double>& _vel,
+            const std::vector<double>& _acc ) {
+    if( _pos.size() != N || _vel.size() != N || _acc.size() != N ) {
+      THROW( InvalidArgumentSize,
+             "all argument sizes must be the same as the axis size of PVAArray." );
+    }
+    for( std::size_t i=0; i < N; i++ ) {
+      this->pvaarray[i] = PosVelAcc( _pos[i], _vel[i], _acc[i] );
+    }
+  };
+
+  /// @param[in] index the index of axis
+  /// @return the reference of PosVelAcc[index]
+  PosVelAcc& operator[]( const std::size_t& index ) {
+    return this->pvaarray[index];
+  };
+
+  /// @param[in] index the index of axis
+  /// @return the constant reference of PosVelAcc[index]
+  const PosVelAcc& operator[]( const std::size_t& index ) const {
+    return this->pvaarray[index];
+  };
+
+  /// @param[in] index the index of axis
+  /// @return the reference of PosVelAcc[index].pos
+  double& pos( const std::size_t& index ) {
+    return this->pvaarray[index].pos;
+  }
+
+  /// @param[in] index the index of axis
+  /// @return the reference of PosVelAcc[index].vel
+  double& vel( const std::size_t& index ) {
+    return this->pvaarray[index].vel;
+  }
+
+  /// @param[in] index the index of axis
+  /// @return the reference of PosVelAcc[index].acc
+  double& acc( const std::size_t& index ) {
+    return this->pvaarray[index].acc;
+  }
+
+  /// returns the axis size N
+  /// @return N
+  std::size_t size() const {
+    return N;
+  };
+
+  /// convert into PVAList
+  /// @return PVAList of N axes
+  PVAList to_list() const {
+    return PVAList( std::vector<PosVelAcc>( this->pvaarray, this->pvaarray + N ) );
+  };
+
+  /// PosVelAcc of each axis
+  PosVelAcc pvaarray[N];
+
+  /// the axis size must be >= 1 (compile error if N == 0)
+  typedef char axis_size_must_be_positive[ ( N > 0 ) ? 1 : -1 ];
+
+}; // End of struct PVAArray
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+/// TimePVAArray Queue buffer class of N axes
+/// @details
+/// All times and all axes of all points are stored in two flat arrays,
+/// so no heap allocation is needed per point and copying the queue is memcpy. \n
+/// pop() only moves the head index forward,
+/// and the popped area is reused when it becomes larger than the half of the buffer. \n
+/// TimeVal< PVAArray<N> > is returned by value
+/// because the values of axes are not stored as TimeVal internally.
+template<std::size_t N>
+class TPVAArrayQueue {
+public:
+  /// the number of doubles per point (pos, vel, acc of N axes)
+  static const std::size_t STRIDE = 3 * N;
+
+  /// Constructor
+  TPVAArrayQueue() :
+    head_(0) {
+  };
+
+  /// Destructor
+  ~TPVAArrayQueue() {
+  };
+
+  /// Push TimeVal< PVAArray<N> > data into buffer queue(FIFO)
+  /// @param[in] newval new target time & PVAArray<N>
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_INPUT_TIME: the time is less than the one of previous index
+  RetCode push( const TimeVal< PVAArray<N> >& newval ) {
+    return push( newval.time, newval.value );
+  };
+
+  /// Push time & PVAArray<N> data into buffer queue(FIFO) (overload)
+  /// @param[in] time      target time
+  /// @param[in] pva_array target PVAArray<N>
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_INPUT_TIME: the time is less than the one of previous index
+  RetCode push( const double& time, const PVAArray<N>& pva_array ) {
+    if( size() > 0 && time <= times_.back() ) {
+      return SPLINE_INVALID_INPUT_TIME;
+    }
+    times_.push_back( time );
+    for( std::size_t k=0; k < N; k++ ) {
+      values_.push_back( pva_array[k].pos );
+      values_.push_back( pva_array[k].vel );
+      values_.push_back( pva_array[k].acc );
+    }
+    return SPLINE_SUCCESS;
+  };
+
+  /// Push clock time and PVAArray<N> into buffer queue(FIFO)
+  /// @param[in] clocktime target clock time
+  /// @param[in] pva_array target PVAArray<N>
+  /// @return the same as push()
+  RetCode push_on_clocktime( const double& clocktime, const PVAArray<N>& pva_array ) {
+    return push( clocktime, pva_array );
+  };
+
+  /// Push interval time(dT) and PVAArray<N> into buffer queue(FIFO)
+  /// @param[in] dT        interval time from the last clock time (the first clock time if empty)
+  /// @param[in] pva_array target PVAArray<N>
+  /// @return the same as push()
+  RetCode push_on_dT( const double& dT, const PVAArray<N>& pva_array ) {
+    const double clocktime = ( size() > 0 ) ? times_.back() + dT : dT;
+    return push( clocktime, pva_array );
+  };
+
+  /// Replace all data of the queue by TPVAListQueue
+  /// @param[in] src TPVAListQueue of N axes
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_QUEUE_SIZE: the axis size of src is not N (the queue is not changed)
+  RetCode assign( const TPVAListQueue& src ) {
+    for( std::size_t i=0; i < src.size(); i++ ) {
+      if( src.at( i ).value.size() != N ) {
+        return SPLINE_INVALID_QUEUE_SIZE;
+      }
+    }
+    this->clear();
+    times_.reserve( src.size() );
+    values_.reserve( src.size() * STRIDE );
+    for( std::size_t i=0; i < src.size(); i++ ) {
+      const TimePVAList& tpva_list = src.at( i );
+      times_.push_back( tpva_list.time );
+      for( std::size_t k=0; k < N; k++ ) {
+        values_.push_back( tpva_list.value[k].pos );
+        values_.push_back( tpva_list.value[k].vel );
+        values_.push_back( tpva_list.value[k].acc );
+      }
+    }
+    return SPLINE_SUCCESS;
+  };
+
+  /// Convert into TPVAListQueue
+  /// @param[out] dest TPVAListQueue of N axes
+  void to_list_queue( TPVAListQueue& dest ) const {
+    dest.clear();
+    for( std::size_t i=0; i < size(); i++ ) {
+      dest.push( time( i ), get( i ).value.to_list() );
+    }
+  };
+
+  /// Extract the one axis as TPVAQueue for generating the path of the axis
+  /// @param[in]  axis the index of axis
+  /// @param[out] dest TPVAQueue of the axis
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_INPUT_INDEX: axis >= N
+  RetCode axis_queue( const std::size_t& axis, TPVAQueue& dest ) const {
+    if( axis >= N ) {
+      return SPLINE_INVALID_INPUT_INDEX;
+    }
+    dest.clear();
+    for( std::size_t i=0; i < size(); i++ ) {
+      const double* row = data( i ) + 3 * axis;
+      dest.push( time( i ), row[0], row[1], row[2] );
+    }
+    return SPLINE_SUCCESS;
+  };
+
+  /// Pop the oldest data from buffer queue(FIFO)
+  /// @return the oldest TimeVal< PVAArray<N> >
+  /// @exception QueueSizeEmpty buffer size is not enough to pop.
+  const TimeVal< PVAArray<N> > pop() {
+    if( size() == 0 ) {
+      THROW( QueueSizeEmpty, "the size of time queue is empty" );
+    }
+    const TimeVal< PVAArray<N> > output = get( 0 );
+    pop_delete();
+    return output;
+  };
+
+  /// Pop the newest data from buffer queue(LILO)
+  /// @return the newest TimeVal< PVAArray<N> >
+  /// @exception QueueSizeEmpty buffer size is not enough to pop.
+  const TimeVal< PVAArray<N> > pop_back() {
+    if( size() == 0 ) {
+      THROW( QueueSizeEmpty, "the size of time queue is empty" );
+    }
+    const TimeVal< PVAArray<N> > output = get( size() - 1 );
+    times_.pop_back();
+    values_.resize( values_.size() - STRIDE );
+    if( size() == 0 ) {
+      this->clear();
+    }
+    return output;
+  };
+
+  /// delete the front(oldest) data from buffer queue(FIFO)
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// @exception QueueSizeEmpty buffer size is not enough to pop and delete.
+  RetCode pop_delete() {
+    if( size() == 0 ) {
+      THROW( QueueSizeEmpty, "the size of time queue is empty" );
+    }
+    head_++;
+    // reuse the popped area when it becomes larger than the rest
+    if( head_ * 2 >= times_.size() ) {
+      times_.erase( times_.begin(), times_.begin() + head_ );
+      values_.erase( values_.begin(), values_.begin() + head_ * STRIDE );
+      head_ = 0;
+    }
+    return SPLINE_SUCCESS;
+  };
+
+  /// Get a time & PVAArray<N> at the index
+  /// @param[in] index the index of queue
+  /// @return TimeVal< PVAArray<N> > at the index
+  /// @exception InvalidIndexAccess If invalid index is accessed.
+  const TimeVal< PVAArray<N> > get( const std::size_t& index ) const
+    SPLINE_THROW_SPEC(InvalidIndexAccess) {
+    check_index( index );
+    TimeVal< PVAArray<N> > output( times_[head_ + index] );
+    const double* row = data( index );
+    for( std::size_t k=0; k < N; k++ ) {
+      output.value[k] = PosVelAcc( row[3*k], row[3*k + 1], row[3*k + 2] );
+    }
+    return output;
+  };
+
+  /// Get a time & PVAArray<N> at the first index(oldest data)
+  /// @return TimeVal< PVAArray<N> > at the first index
+  /// @exception InvalidIndexAccess If the queue is empty.
+  const TimeVal< PVAArray<N> > front() const
+    SPLINE_THROW_SPEC(InvalidIndexAccess) {
+    if( size() == 0 ) {
+      THROW( InvalidIndexAccess, "Queue size is empty." );
+    }
+    return get( 0 );
+  };
+
+  /// Get a time & PVAArray<N> at the last index(newest data)
+  /// @return TimeVal< PVAArray<N> > at the last index
+  /// @exception InvalidIndexAccess If the queue is empty.
+  const TimeVal< PVAArray<N> > back() const
+    SPLINE_THROW_SPEC(InvalidIndexAccess) {
+    if( size() == 0 ) {
+      THROW( InvalidIndexAccess, "Queue size is empty." );
+    }
+    return get( size() - 1 );
+  };
+
+  /// Get the clock time at the index without copying values
+  /// @param[in] index the index of queue
+  /// @return clock time at the index
+  /// @exception InvalidIndexAccess If invalid index is accessed.
+  const double time( const std::size_t& index ) const
+    SPLINE_THROW_SPEC(InvalidIndexAccess) {
+    check_index( index );
+    return times_[head_ + index];
+  };
+
+  /// Get the pointer of values at the index without copying
+  /// @param[in] index the index of queue (must be < size())
+  /// @return pointer of [pos, vel, acc] x N at the index
+  const double* data( const std::size_t& index ) const {
+    return &values_[ ( head_ + index ) * STRIDE ];
+  };
+
+  /// Set time & PVAArray<N> at the index
+  /// @param[in] index  the index for setting data
+  /// @param[in] newval setting TimeVal< PVAArray<N> > value
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_INPUT_INDEX: Not exist input-index
+  /// - SPLINE_INVALID_INPUT_TIME: the time is not between the ones of neighboring indices
+  RetCode set( const std::size_t& index, const TimeVal< PVAArray<N> >& newval ) {
+    if( index >= size() ) {
+      return SPLINE_INVALID_INPUT_INDEX;
+    }
+    if( ( index >= 1
+          && newval.time <= times_[head_ + index - 1] )
+        || ( index < size() - 1
+             && newval.time >= times_[head_ + index + 1] ) ) {
+      return SPLINE_INVALID_INPUT_TIME;
+    }
+    times_[head_ + index] = newval.time;
+    write_row( index, newval.value );
+    return SPLINE_SUCCESS;
+  };
+
+  /// Set an only PVAArray<N> without time at the index
+  /// @param[in] index  the index for setting data
+  /// @param[in] newval setting PVAArray<N> value
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_INPUT_INDEX: Not exist input-index
+  RetCode set_value( const std::size_t& index, const PVAArray<N>& newval ) {
+    if( index >= size() ) {
+      return SPLINE_INVALID_INPUT_INDEX;
+    }
+    write_row( index, newval );
+    return SPLINE_SUCCESS;
+  };
+
+  /// Clear all data of queue buffer
+  void clear() {
+    times_.clear();
+    values_.clear();
+    head_ = 0;
+  };
+
+  /// Reserve the buffer for the number of points
+  /// @param[in] point_size the number of points
+  void reserve( const std::size_t& point_size ) {
+    times_.reserve( head_ + point_size );
+    values_.reserve( ( head_ + point_size ) * STRIDE );
+  };
+
+  /// Get queue size
+  /// @return the number of points
+  const std::size_t size() const {
+    return times_.size() - head_;
+  };
+
+  /// Get the axis size
+  /// @return N
+  const std::size_t axis_size() const {
+    return N;
+  };
+
+  /// Get dT at the index
+  /// @param[in] index the index getting dT (t[index+1] - t[index])
+  /// @return dT at the index
+  /// @exception InvalidIndexAccess If invalid index is accessed.
+  const double dT( const std::size_t& index ) const
+    SPLINE_THROW_SPEC(InvalidIndexAccess) {
+    if( index + 1 >= size() ) {
+      std::stringstream ss;
+      ss << "the index=" << index
+         << " is out of range between 0<= and < the number of dT=" << ( size() - 1 );
+      THROW( InvalidIndexAccess, ss.str() );
+    }
+    return times_[head_ + index + 1] - times_[head_ + index];
+  };
+
+  /// Get total interval time from the first to the last point
+  /// @return total interval time (0.0 if the size is less than 2)
+  const double total_dT() const {
+    if( size() < 2 ) {
+      return 0.0;
+    }
+    return times_.back() - times_[head_];
+  };
+
+  /// dump all queue list (the same format as TPVAListQueue::dump())
+  /// @param[out] dest_queue_dump output of all queue data as string.
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  RetCode dump( std::string& dest_queue_dump ) const {
+    dest_queue_dump.clear();
+    std::stringstream ss;
+    for( std::size_t i=0; i < size(); i++ ) {
+      const double* row = data( i );
+      ss << times_[head_ + i] << ", [";
+      for( std::size_t k=0; k < N; k++ ) {
+        ss << "["
+           << row[3*k] << ", "
+           << row[3*k + 1] << ", "
+           << row[3*k + 2] << "]";
+        if( k < N-1 ) { ss << ", "; }
+      }
+      ss << "]" << std::endl;
+    }
+    dest_queue_dump = ss.str();
+    return SPLINE_SUCCESS;
+  };
+
+private:
+  /// check the index is valid
+  /// @param[in] index the index of queue
+  /// @exception InvalidIndexAccess If invalid index is accessed.
+  void check_index( const std::size_t& index ) const {
+    if( index >= size() ) {
+      std::stringstream err_ss;
+      err_ss << "Queue index is invalid. the size of queue_buffer : "
+             << size()
+             << ", but input index : "
+             << index;
+      THROW( InvalidIndexAccess, err_ss.str() );
+    }
+  };
+
+  /// write PVAArray<N> into the values at the index
+  /// @param[in] index     the index of queue (must be < size())
+  /// @param[in] pva_array source PVAArray<N>
+  void write_row( const std::size_t& index, const PVAArray<N>& pva_array ) {
+    double* row = &values_[ ( head_ + index ) * STRIDE ];
+    for( std::size_t k=0; k < N; k++ ) {
+      row[3*k]     = pva_array[k].pos;
+      row[3*k + 1] = pva_array[k].vel;
+      row[3*k + 2] = pva_array[k].acc;
+    }
+  };
+
+  /// clock times of all points
+  std::vector<double> times_;
+
+  /// [pos, vel, acc] x N of all points
+  std::vector<double> values_;
+
+  /// the index of the oldest point in times_
+  std::size_t head_;
+
+}; // End of class TPVAArrayQueue
+
+template<std::size_t N>
+const std::size_t TPVAArrayQueue<N>::STRIDE;
+
+} // End of namespace interp
+
+#endif // INCLUDE_TPVA_ARRAY_QUEUE_HPP_
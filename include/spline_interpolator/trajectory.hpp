@@ -0,0 +1,346 @@
+#ifndef INCLUDE_TRAJECTORY_HPP_
+#define INCLUDE_TRAJECTORY_HPP_
+
+#include <cstddef> // for size_t
+#include <new> // for placement new
+#include <iomanip>
+
+#include "spline_data.hpp"
+#include "spline_exception.hpp"
+#include "monotonic_arena.hpp" // for AlignmentOf
+
+namespace interp {
+
+/// Static-dispatch base of trajectories (CRTP)
+/// @tparam Derived trajectory class inheriting TrajectoryBase<Derived, T>
+/// @tparam T       scalar type of positions (float, double)
+/// @details
+/// Derived implements the following non-virtual functions,
+/// and pop() and sample() are built on them without virtual call,
+/// so that the evaluation is inlined into the caller that knows Derived statically.
+///
+/// ```
+/// RetCode evaluate( const double& t, T& pos, T& vel, T& acc ) const;
+/// template<unsigned int Mask>
+/// RetCode evaluate( const double& t, T& pos, T& vel, T& acc ) const; // only the outputs of Mask
+/// double  start_time() const;
+/// double  finish_time() const;
+/// ```
+///
+/// evaluate() returns
+/// - SPLINE_SUCCESS: no error
+/// - SPLINE_SEGMENT_NOT_GENERATED: path is not generated
+/// - SPLINE_INVALID_INPUT_TIME: time is not within the range of the path
+template<class Derived, class T=double>
+class TrajectoryBase {
+public:
+  /// Pop the position, velocity and acceleration at the input-time
+  /// @param[in] t input time
+  /// @return output TimeVal<BasicPosVelAcc<T> > at the input time
+  /// @exception
+  /// - NotSplineGenerated : spline-path is not genrated
+  /// - TimeOutOfRange : time is not within the range of generated spline-path
+  const TimeVal<BasicPosVelAcc<T> > pop( const double& t ) const {
+    BasicPosVelAcc<T> pva;
+    const RetCode retcode = derived().evaluate( t, pva.pos, pva.vel, pva.acc );
+    if( retcode == SPLINE_SEGMENT_NOT_GENERATED ) {
+      const std::string err_msg = "pop data does not exist -- Path has not be generated yet.";
+      std::cerr << err_msg << std::endl;
+      THROW( NotSplineGenerated, err_msg );
+    } else if( retcode != SPLINE_SUCCESS ) {
+      std::stringstream ss;
+      ss << std::fixed << std::setprecision(15);
+      ss << "time value = " << t
+         << " is out of range of generated path between t0(=" << derived().start_time()
+         << ") and tf(=" << derived().finish_time() << ").";
+      std::cerr << ss.str() << std::endl;
+      THROW( TimeOutOfRange, ss.str() );
+    }
+    return TimeVal<BasicPosVelAcc<T> >( t, pva );
+  }
+
+  /// Sample positions, velocities and accelerations at ts, ts+dT, ts+2dT, ...
+  /// @param[in]  ts   start time of sampling
+  /// @param[in]  dT   sampling cycle time
+  /// @param[in]  size the number of samples
+  /// @param[out] pos  positions (size elements)
+  /// @param[out] vel  velocities (size elements)
+  /// @param[out] acc  accelerations (size elements)
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - the error of evaluate() at the first failed sample (later samples are not written)
+  RetCode sample( const double& ts, const double& dT, const std::size_t& size,
+                  T* pos, T* vel, T* acc ) const {
+    return sample<OUTPUT_PVA>( ts, dT, size, pos, vel, acc );
+  }
+
+  /// Sample the selected outputs at ts, ts+dT, ts+2dT, ...
+  /// @param[in]  ts   start time of sampling
+  /// @param[in]  dT   sampling cycle time
+  /// @param[in]  size the number of samples
+  /// @param[out] pos  positions (size elements, may be NULL without OUTPUT_POS)
+  /// @param[out] vel  velocities (size elements, may be NULL without OUTPUT_VEL)
+  /// @param[out] acc  accelerations (size elements, may be NULL without OUTPUT_ACC)
+  /// @tparam Mask combination of OutputMask
+  /// @return the same as sample()
+  template<unsigned int Mask>
+  RetCode sample( const double& ts, const double& dT, const std::size_t& size,
+                  T* pos, T* vel, T* acc ) const {
+    T unused = T(0.0);
+    for( std::size_t i=0; i < size; i++ ) {
+      const RetCode retcode = derived().template evaluate<Mask>(
+        ts + dT * i,
+        ( Mask & OUTPUT_POS ) ? pos[i] : unused,
+        ( Mask & OUTPUT_VEL ) ? vel[i] : unused,
+        ( Mask & OUTPUT_ACC ) ? acc[i] : unused );
+      if( retcode != SPLINE_SUCCESS ) {
+        return retcode;
+      }
+    }
+    return SPLINE_SUCCESS;
+  }
+
+protected:
+  /// Constructor (only for Derived, constexpr since C++14)
+  SPLINE_CONSTEXPR14 TrajectoryBase() {
+  }
+
+private:
+  /// get the derived trajectory
+  /// @return *this as Derived
+  const Derived& derived() const {
+    return static_cast<const Derived&>( *this );
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+/// Type-erased trajectory in a small buffer
+/// @tparam Size size of the inline buffer [byte]
+/// @details
+/// A value type holding a copy of any trajectory which has
+/// evaluate(), evaluate<Mask>(), start_time() and finish_time() of TrajectoryBase
+/// (e.g. FixedCubicSpline<N>, FixedTrapezoid<N>, Trapezoid5251525Profile). \n
+/// The trajectory is placed in the buffer in the object, so no heap allocation occurs
+/// by construction, copy or assignment.
+/// A trajectory larger than Size is a compile error (use the larger Size). \n
+/// Evaluation costs one indirect call through the table of the held type,
+/// which replaces the virtual call of SplineInterpolator::pop() for containers of
+/// mixed trajectories (e.g. std::vector<Trajectory> of axes).
+///
+/// ```
+/// FixedCubicSpline<4> spline;
+/// spline.generate_path( times, positions );
+/// Trajectory trajectory( spline );
+/// trajectory.evaluate( t, pos, vel, acc );
+/// ```
+template<std::size_t Size>
+class BasicTrajectory : public TrajectoryBase<BasicTrajectory<Size> > {
+public:
+  /// size of the inline buffer [byte]
+  static const std::size_t BUFFER_SIZE = Size;
+
+  /// Constructor (empty)
+  BasicTrajectory() :
+    table_(NULL) {
+  }
+
+  /// Constructor
+  /// @param[in] src trajectory to copy into the buffer
+  template<class TrajectoryT>
+  BasicTrajectory( const TrajectoryT& src ) :
+    table_(NULL) {
+    assign( src );
+  }
+
+  /// Copy Constructor
+  /// @param[in] src source
+  BasicTrajectory( const BasicTrajectory& src ) :
+    TrajectoryBase<BasicTrajectory<Size> >(),
+    table_(NULL) {
+    if( src.table_ != NULL ) {
+      src.table_->copy( src.storage_.bytes, storage_.bytes );
+      table_ = src.table_;
+    }
+  }
+
+  /// Destructor
+  ~BasicTrajectory() {
+    reset();
+  }
+
+  /// Copy(insert) Operator
+  /// @param[in] src source
+  /// @return *this
+  BasicTrajectory& operator=( const BasicTrajectory& src ) {
+    if( this != &src ) {
+      reset();
+      if( src.table_ != NULL ) {
+        src.table_->copy( src.storage_.bytes, storage_.bytes );
+        table_ = src.table_;
+      }
+    }
+    return *this;
+  }
+
+  /// Hold the copy of the trajectory
+  /// @param[in] src trajectory to copy into the buffer
+  template<class TrajectoryT>
+  void assign( const TrajectoryT& src ) {
+    // compile error if TrajectoryT does not fit in the buffer
+    typedef char trajectory_must_fit_in_buffer[
+      ( sizeof(TrajectoryT) <= Size
+        && AlignmentOf<TrajectoryT>::value <= AlignmentOf<Storage>::value ) ? 1 : -1 ];
+    (void)sizeof( trajectory_must_fit_in_buffer );
+    reset();
+    ::new( static_cast<void*>( storage_.bytes ) ) TrajectoryT( src );
+    table_ = Model<TrajectoryT>::table();
+  }
+
+  /// Release the held trajectory (empty)
+  void reset() {
+    if( table_ != NULL ) {
+      table_->destroy( storage_.bytes );
+      table_ = NULL;
+    }
+  }
+
+  /// check if no trajectory is held
+  /// @return true if empty
+  const bool empty() const {
+    return table_ == NULL;
+  }
+
+  /// Evaluate the position, velocity and acceleration at the input-time
+  /// @param[in]  t   input time
+  /// @param[out] pos position
+  /// @param[out] vel velocity
+  /// @param[out] acc acceleration
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_SEGMENT_NOT_GENERATED: empty, or the held path is not generated
+  /// - SPLINE_INVALID_INPUT_TIME: time is not within the range of the held path
+  RetCode evaluate( const double& t, double& pos, double& vel, double& acc ) const {
+    return evaluate<OUTPUT_PVA>( t, pos, vel, acc );
+  }
+
+  /// Evaluate the selected outputs at the input-time
+  /// @param[in]  t   input time
+  /// @param[out] pos position (written if Mask has OUTPUT_POS)
+  /// @param[out] vel velocity (written if Mask has OUTPUT_VEL)
+  /// @param[out] acc acceleration (written if Mask has OUTPUT_ACC)
+  /// @tparam Mask combination of OutputMask
+  /// @return the same as evaluate()
+  template<unsigned int Mask>
+  RetCode evaluate( const double& t, double& pos, double& vel, double& acc ) const {
+    if( table_ == NULL ) {
+      return SPLINE_SEGMENT_NOT_GENERATED;
+    }
+    return table_->evaluate[Mask & OUTPUT_PVA]( storage_.bytes, t, pos, vel, acc );
+  }
+
+  /// get the start time
+  /// @return start time of the held trajectory (0.0 if empty)
+  const double start_time() const {
+    return ( table_ == NULL ) ? 0.0 : table_->start_time( storage_.bytes );
+  }
+
+  /// get the finish time
+  /// @return finish time of the held trajectory (0.0 if empty)
+  const double finish_time() const {
+    return ( table_ == NULL ) ? 0.0 : table_->finish_time( storage_.bytes );
+  }
+
+private:
+  /// Table of the functions of the held type
+  struct Table {
+    /// evaluate<Mask>() indexed by Mask (0: the same as OUTPUT_PVA)
+    RetCode (*evaluate[OUTPUT_PVA + 1])( const void* object, const double& t,
+                                         double& pos, double& vel, double& acc );
+    /// start_time()
+    double (*start_time)( const void* object );
+    /// finish_time()
+    double (*finish_time)( const void* object );
+    /// copy construction into the other buffer
+    void (*copy)( const void* object, void* destination );
+    /// destruction
+    void (*destroy)( void* object );
+  };
+
+  /// Functions of the held type
+  /// @tparam TrajectoryT held trajectory type
+  template<class TrajectoryT>
+  struct Model {
+    /// evaluate<Mask>()
+    template<unsigned int Mask>
+    static RetCode evaluate( const void* object, const double& t,
+                             double& pos, double& vel, double& acc ) {
+      return static_cast<const TrajectoryT*>( object )->template evaluate<Mask>( t, pos, vel, acc );
+    }
+
+    /// start_time()
+    static double start_time( const void* object ) {
+      return static_cast<const TrajectoryT*>( object )->start_time();
+    }
+
+    /// finish_time()
+    static double finish_time( const void* object ) {
+      return static_cast<const TrajectoryT*>( object )->finish_time();
+    }
+
+    /// copy construction into the other buffer
+    static void copy( const void* object, void* destination ) {
+      ::new( destination ) TrajectoryT( *static_cast<const TrajectoryT*>( object ) );
+    }
+
+    /// destruction
+    static void destroy( void* object ) {
+      static_cast<TrajectoryT*>( object )->~TrajectoryT();
+    }
+
+    /// get the table of the type (statically initialized)
+    /// @return pointer to the table
+    static const Table* table() {
+      static const Table model_table = {
+        { &evaluate<OUTPUT_PVA>,
+          &evaluate<OUTPUT_POS>,
+          &evaluate<OUTPUT_VEL>,
+          &evaluate<OUTPUT_POS_VEL>,
+          &evaluate<OUTPUT_ACC>,
+          &evaluate<OUTPUT_POS | OUTPUT_ACC>,
+          &evaluate<OUTPUT_VEL | OUTPUT_ACC>,
+          &evaluate<OUTPUT_PVA> },
+        &start_time, &finish_time, &copy, &destroy };
+      return &model_table;
+    }
+  };
+
+  /// Inline buffer aligned for any scalar member
+  union Storage {
+    /// buffer
+    char bytes[Size];
+    /// alignment of double
+    double align_double;
+    /// alignment of long double
+    long double align_long_double;
+    /// alignment of pointer
+    void* align_pointer;
+  };
+
+  /// buffer of the held trajectory
+  Storage storage_;
+
+  /// table of the held type (NULL: empty)
+  const Table* table_;
+};
+
+template<std::size_t Size>
+const std::size_t BasicTrajectory<Size>::BUFFER_SIZE;
+
+/// Type-erased trajectory of the default buffer size
+/// (FixedCubicSpline<N> of N <= 12, Trapezoid5251525Profile)
+typedef BasicTrajectory<512> Trajectory;
+
+} // End of namespace interp
+
+#endif // INCLUDE_TRAJECTORY_HPP_
@@ -0,0 +1,149 @@
+#ifndef INCLUDE_TRAJECTORY_BAKER_HPP_
+#define INCLUDE_TRAJECTORY_BAKER_HPP_
+
+#include <string>
+#include <vector>
+#include <cstddef> // for size_t
+
+#include "spline_data.hpp"
+#include "trajectory_exporter.hpp"
+
+namespace interp {
+
+class SplineThreadPool;
+
+/// Interpolator used by TrajectoryBaker
+enum BakeInterpolator {
+  BAKE_CUBIC=1,    ///< CubicSplineInterpolator
+  BAKE_TRAPEZOID   ///< TrapezoidalInterpolator (5251525)
+};
+
+/// Configuration of TrajectoryBaker
+struct BakeConfig {
+  /// Constructor (default values)
+  BakeConfig();
+
+  /// interpolator (default: BAKE_CUBIC)
+  BakeInterpolator interpolator;
+
+  /// configuration of every segment of BAKE_TRAPEZOID (default: TrapezoidConfig())
+  TrapezoidConfig trapezoid;
+
+  /// sampling control cycle [s] (default: 0.001)
+  double cycle;
+
+  /// the index of time column (default: WaypointLoader::NO_COLUMN)
+  std::size_t time_column;
+
+  /// time interval between waypoints if time_column is NO_COLUMN [s] (default: 1.0)
+  double waypoint_interval;
+
+  /// the indices of position columns (default: empty -> all columns except time_column)
+  std::vector<std::size_t> position_columns;
+
+  /// output format (default: EXPORT_CSV)
+  ExportFormat format;
+
+  /// output directory (default: "./")
+  std::string output_dir;
+
+  /// flag to write on a background writer thread (default: false)
+  bool background;
+};
+
+/// Result of baking one waypoint file
+struct BakeResult {
+  /// Constructor
+  BakeResult();
+
+  /// input waypoint file path
+  std::string input_path;
+
+  /// output trajectory file path
+  std::string output_path;
+
+  /// status
+  /// - SPLINE_SUCCESS: no error
+  /// - the return code of WaypointLoader, interpolator, or TrajectoryExporter
+  RetCode status;
+
+  /// error message (empty if no error)
+  std::string message;
+
+  /// the number of waypoints
+  std::size_t waypoint_size;
+
+  /// the number of axes
+  std::size_t axis_size;
+
+  /// the number of written samples
+  std::size_t sample_size;
+
+  /// elapsed time of loading [s]
+  double load_sec;
+
+  /// elapsed time of path generation [s]
+  double plan_sec;
+
+  /// elapsed time of sampling and writing [s]
+  double export_sec;
+
+  /// elapsed time of all steps
+  /// @return load_sec + plan_sec + export_sec [s]
+  const double total_sec() const;
+};
+
+/// Batch baker of waypoint files into sampled trajectory files
+/// @details
+/// Each waypoint file is loaded by WaypointLoader, every position column is
+/// interpolated as an independent axis by the configured interpolator,
+/// and the trajectory is sampled at every control cycle from the first to the last waypoint
+/// and written by TrajectoryExporter as rows of time, [pos, vel, acc] x axes. \n
+/// The output file is "{output_dir}/{basename of input without extension}.csv" (or ".bin").
+/// Files are baked in parallel on the thread pool, one file per thread.
+class TrajectoryBaker {
+public:
+  /// Constructor
+  /// @param[in] config configuration
+  explicit TrajectoryBaker( const BakeConfig& config );
+
+  /// Destructor
+  ~TrajectoryBaker();
+
+  /// bake one waypoint file
+  /// @param[in]  input_path waypoint file path
+  /// @param[out] result     result of baking
+  /// @return result.status
+  RetCode bake( const std::string& input_path, BakeResult& result ) const;
+
+  /// bake waypoint files
+  /// @param[in]  input_paths waypoint file paths
+  /// @param[out] results     results of baking in the order of input_paths
+  /// @param[in]  thread_pool thread pool to bake files in parallel (default: NULL -> serial)
+  /// @return
+  /// - SPLINE_SUCCESS: all files are baked
+  /// - SPLINE_FAIL_TO_GENERATE_PATH: some files failed (see results)
+  /// @details
+  /// Files of the same output path (the same basename in other directories) are not baked
+  /// except the first of them, and their results are SPLINE_FILE_IO_ERROR.
+  RetCode bake( const std::vector<std::string>& input_paths,
+                std::vector<BakeResult>&        results,
+                SplineThreadPool*               thread_pool=NULL ) const;
+
+  /// get the output file path of the input file
+  /// @param[in] input_path waypoint file path
+  /// @return output trajectory file path
+  const std::string output_path( const std::string& input_path ) const;
+
+  /// get the configuration
+  /// @return configuration
+  const BakeConfig& config() const;
+
+private:
+  /// configuration
+  BakeConfig config_;
+};
+
+} // End of namespace interp
+
+#endif // INCLUDE_TRAJECTORY_BAKER_HPP_
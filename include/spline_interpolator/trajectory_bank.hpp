@@ -0,0 +1,230 @@
+#ifndef INCLUDE_TRAJECTORY_BANK_HPP_
+#define INCLUDE_TRAJECTORY_BANK_HPP_
+
+#include <vector>
+#include <cstddef> // for size_t
+
+#include "spline_data.hpp"
+
+namespace interp {
+
+class SplineThreadPool;
+class CubicSplineInterpolator;
+class TrapezoidalInterpolator;
+class Trapezoid5251525;
+
+/// Polynomial piece of a trajectory (up to fifth order)
+/// @details
+/// x(t) = coef[0] + coef[1] * dt + ... + coef[5] * dt^5, dt = t - start_time. \n
+/// Cubic spline segments use coef[0..3] and the steps of Trapezoid5251525 use coef[0..5].
+struct PolynomialPiece {
+  /// the number of coefficients
+  static const std::size_t COEF_NUM = 6;
+
+  /// Constructor (zero polynomial at time 0.0)
+  PolynomialPiece();
+
+  /// Constructor
+  /// @param[in] start_time start time of the piece
+  /// @param[in] c0 zero-order coefficient
+  /// @param[in] c1 first-order coefficient
+  /// @param[in] c2 second-order coefficient
+  /// @param[in] c3 third-order coefficient
+  /// @param[in] c4 fourth-order coefficient
+  /// @param[in] c5 fifth-order coefficient
+  PolynomialPiece( const double& start_time,
+                   const double& c0,     const double& c1=0.0,
+                   const double& c2=0.0, const double& c3=0.0,
+                   const double& c4=0.0, const double& c5=0.0 );
+
+  /// start time of the piece
+  double start_time;
+
+  /// coefficients of dt^0, ..., dt^5
+  double coef[COEF_NUM];
+};
+
+
+/// Bank of many independent trajectories evaluated at one time instant
+/// @details
+/// Trajectories are baked into polynomial pieces and stored in structure-of-arrays form
+/// (start times and each order of coefficients in flat arrays),
+/// with a cursor of the current piece per trajectory. \n
+/// evaluate_all() steps every trajectory at the time t without virtual call:
+/// cursors are advanced forward (binary search only if t goes backward),
+/// then every trajectory is evaluated by Horner's method in one branch-free loop
+/// over the flat arrays, so that the compiler can vectorize it. \n
+/// If the thread pool is set, trajectories are split into chunks across the threads. \n
+/// A time outside [start_time(i), finish_time(i)] is clamped,
+/// i.e. a trajectory holds its state at the start (or finish). \n
+/// Positions agree with pop() of the source trajectory within rounding errors
+/// (the coefficients are expanded in the power form).
+///
+/// ```
+/// TrajectoryBank bank;
+/// std::size_t index = 0;
+/// for( ... ) bank.add( interpolator, index );
+/// std::vector<double> pos( bank.size() ), vel( bank.size() );
+/// for( double t=0.0; t < tf; t+=dT ) {
+///   bank.evaluate_all<OUTPUT_POS_VEL>( t, &pos[0], &vel[0], NULL );
+/// }
+/// ```
+class TrajectoryBank {
+public:
+  /// Constructor (empty)
+  TrajectoryBank();
+
+  /// Reserve the buffers
+  /// @param[in] trajectory_num the number of trajectories
+  /// @param[in] piece_num      the total number of pieces
+  void reserve( const std::size_t& trajectory_num, const std::size_t& piece_num );
+
+  /// Add a trajectory of polynomial pieces
+  /// @param[in]  pieces      pieces in order of start time
+  /// @param[in]  finish_time finish time of the last piece
+  /// @param[out] index       index of the added trajectory
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_INVALID_QUEUE_SIZE : pieces is empty
+  /// - SPLINE_INVALID_INPUT_INTERVAL_TIME_DT : start times are not increasing,
+  ///   or finish_time is before the start time of the last piece
+  RetCode add_pieces( const std::vector<PolynomialPiece>& pieces,
+                      const double&                       finish_time,
+                      std::size_t&                        index );
+
+  /// Add a generated cubic spline
+  /// @param[in]  interpolator generated cubic spline interpolator
+  /// @param[out] index        index of the added trajectory
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_SEGMENT_NOT_GENERATED : path is not generated
+  /// - the error of add_pieces()
+  /// @details The time scale of set_time_scale() is baked into the pieces,
+  /// so the bank agrees with pop() of the interpolator.
+  RetCode add( const CubicSplineInterpolator& interpolator, std::size_t& index );
+
+  /// Add a generated trapezoidal path
+  /// @param[in]  interpolator generated trapezoidal interpolator
+  /// @param[out] index        index of the added trajectory
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_SEGMENT_NOT_GENERATED : path is not generated
+  /// - SPLINE_FAIL_TO_GENERATE_PATH : a segment failed to generate
+  /// - the error of add_pieces()
+  /// @details Segments not generated yet in the lazy generation mode are generated here.
+  /// The time scale of set_time_scale() is baked into the pieces, the same as the cubic spline.
+  RetCode add( const TrapezoidalInterpolator& interpolator, std::size_t& index );
+
+  /// Add a generated trapezoid 5251525 path
+  /// @param[in]  trapezoid generated trapezoid 5251525 path
+  /// @param[out] index     index of the added trajectory
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_SEGMENT_NOT_GENERATED : path is not generated
+  /// - the error of add_pieces()
+  RetCode add( const Trapezoid5251525& trapezoid, std::size_t& index );
+
+  /// Remove all trajectories (the buffers are kept)
+  void clear();
+
+  /// Get the number of trajectories
+  /// @return the number of trajectories
+  const std::size_t size() const;
+
+  /// Get the total number of pieces
+  /// @return the total number of pieces
+  const std::size_t piece_num() const;
+
+  /// Get the start time of the trajectory
+  /// @param[in] index index of the trajectory (< size())
+  /// @return start time
+  const double start_time( const std::size_t& index ) const;
+
+  /// Get the finish time of the trajectory
+  /// @param[in] index index of the trajectory (< size())
+  /// @return finish time
+  const double finish_time( const std::size_t& index ) const;
+
+  /// Rewind the cursors of all trajectories to their first pieces
+  void reset_cursors();
+
+  /// Set the thread pool for parallel evaluation
+  /// @param[in] thread_pool pointer to the thread pool (not owned).
+  ///                        NULL means serial evaluation (default).
+  /// @param[in] grain       the number of trajectories per chunk (default: 0 -> automatic)
+  /// @details Parallel evaluation gives the same result as serial evaluation.
+  void set_thread_pool( SplineThreadPool* thread_pool, const std::size_t& grain=0 );
+
+  /// Get the thread pool for parallel evaluation
+  /// @return pointer to the thread pool. NULL if not set.
+  SplineThreadPool* thread_pool() const;
+
+  /// Evaluate positions, velocities and accelerations of all trajectories at the time
+  /// @param[in]  t   time
+  /// @param[out] pos positions (size() elements)
+  /// @param[out] vel velocities (size() elements)
+  /// @param[out] acc accelerations (size() elements)
+  /// @return SPLINE_SUCCESS
+  RetCode evaluate_all( const double& t, double* pos, double* vel, double* acc );
+
+  /// Evaluate the selected outputs of all trajectories at the time
+  /// @param[in]  t   time
+  /// @param[out] pos positions (size() elements, may be NULL without OUTPUT_POS)
+  /// @param[out] vel velocities (size() elements, may be NULL without OUTPUT_VEL)
+  /// @param[out] acc accelerations (size() elements, may be NULL without OUTPUT_ACC)
+  /// @tparam Mask combination of OutputMask (instantiated in the source for every combination)
+  /// @return SPLINE_SUCCESS
+  template<unsigned int Mask>
+  RetCode evaluate_all( const double& t, double* pos, double* vel, double* acc );
+
+  /// Advance the cursors and evaluate the trajectories in [begin, end)
+  /// @param[in]  t     time
+  /// @param[in]  begin the first index of trajectories
+  /// @param[in]  end   the index next to the last of trajectories
+  /// @param[out] pos   positions (size() elements)
+  /// @param[out] vel   velocities (size() elements)
+  /// @param[out] acc   accelerations (size() elements)
+  /// @tparam Mask combination of OutputMask
+  /// @details Called from the threads with disjoint ranges.
+  template<unsigned int Mask>
+  void evaluate_range( const double& t, const std::size_t& begin, const std::size_t& end,
+                       double* pos, double* vel, double* acc );
+
+private:
+  /// start times of pieces
+  std::vector<double> piece_start_;
+
+  /// coefficients of pieces (coef_[k][piece] of dt^k)
+  std::vector<double> coef_[PolynomialPiece::COEF_NUM];
+
+  /// the first piece of each trajectory
+  std::vector<std::size_t> first_piece_;
+
+  /// the piece next to the last of each trajectory
+  std::vector<std::size_t> end_piece_;
+
+  /// the current piece of each trajectory
+  std::vector<std::size_t> cursor_;
+
+  /// elapsed time from the start of the current piece of each trajectory
+  std::vector<double> elapsed_;
+
+  /// start time of each trajectory
+  std::vector<double> start_time_;
+
+  /// finish time of each trajectory
+  std::vector<double> finish_time_;
+
+  /// scratch pieces of add()
+  std::vector<PolynomialPiece> pieces_;
+
+  /// thread pool for parallel evaluation (not owned, default: NULL)
+  SplineThreadPool* thread_pool_;
+
+  /// the number of trajectories per chunk of parallel evaluation (default: 0 -> automatic)
+  std::size_t parallel_grain_;
+};
+
+} // End of namespace interp
+
+#endif // INCLUDE_TRAJECTORY_BANK_HPP_
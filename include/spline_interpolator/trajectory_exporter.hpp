@@ -0,0 +1,214 @@
+#ifndef INCLUDE_TRAJECTORY_EXPORTER_HPP_
+#define INCLUDE_TRAJECTORY_EXPORTER_HPP_
+
+#include <pthread.h>
+#include <string>
+#include <vector>
+#include <cstdio> // for FILE
+#include <cstddef> // for size_t
+
+#include "spline_data.hpp"
+#include "spline_interpolator.hpp"
+
+namespace interp {
+
+/// Format of TrajectoryExporter output
+enum ExportFormat {
+  EXPORT_CSV=1, ///< text, one row per line, ',' separated, shortest round-trip numbers
+  EXPORT_BINARY ///< raw little-endian float64 rows (no header)
+};
+
+/// Streaming exporter of sampled trajectories and queue contents
+/// @details
+/// Rows are formatted into a reusable buffer and written to the file when it is full,
+/// so memory does not grow with the number of rows. \n
+/// Columns of a row:
+/// - TPQueue                 : time, pos
+/// - TimePVA, TPVAQueue      : time, pos, vel, acc
+/// - TimePVAList, TPVAListQueue : time, [pos, vel, acc] x axes
+///
+/// EXPORT_CSV prints each double with the shortest of 15, 16, 17 significant digits
+/// that reads back to the same value (the decimal point is always '.'). \n
+/// EXPORT_BINARY writes the same columns as float64,
+/// e.g. numpy.fromfile( path, '<f8' ).reshape( -1, columns ).
+///
+/// With the background writer, a second buffer is written by a writer thread
+/// while the caller formats the next rows.
+/// Do not call one exporter from several threads.
+class TrajectoryExporter {
+public:
+  /// Constructor
+  TrajectoryExporter();
+
+  /// Destructor
+  /// @brief close the file if opened
+  ~TrajectoryExporter();
+
+  /// open the destination file (an opened file is closed first)
+  /// @param[in] path        destination file path (truncated)
+  /// @param[in] format      EXPORT_CSV or EXPORT_BINARY (default: EXPORT_CSV)
+  /// @param[in] background  flag to write on a background writer thread (default: false)
+  /// @param[in] buffer_size the size of buffer [byte] (default: 1MiB, at least MIN_BUFFER_SIZE)
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_FILE_FORMAT: invalid format
+  /// - SPLINE_FILE_IO_ERROR: cannot open the file or start the writer thread
+  RetCode open( const std::string& path,
+                const ExportFormat& format=EXPORT_CSV,
+                const bool& background=false,
+                const std::size_t& buffer_size=DEFAULT_BUFFER_SIZE );
+
+  /// flush the buffer and close the file
+  /// @return
+  /// - SPLINE_SUCCESS: no error (also if not opened)
+  /// - SPLINE_FILE_IO_ERROR: failed to write some rows
+  RetCode close();
+
+  /// check if the file is opened
+  /// @return true if opened
+  const bool is_open() const;
+
+  /// write a row of time-position
+  /// @param[in] tp time-position
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_FILE_IO_ERROR: not opened or failed to write
+  RetCode write( const TimePosition& tp );
+
+  /// write a row of time-position-velocity-acceleration
+  /// @param[in] tpva time-position-velocity-acceleration
+  /// @return the same as write( const TimePosition& )
+  RetCode write( const TimePVA& tpva );
+
+  /// write a row of time-position-velocity-acceleration of axes
+  /// @param[in] tpva_list time-position-velocity-acceleration of axes
+  /// @return the same as write( const TimePosition& )
+  RetCode write( const TimePVAList& tpva_list );
+
+  /// write all rows of the queue
+  /// @param[in] queue source queue
+  /// @return the same as write( const TimePosition& )
+  RetCode write( const TPQueue& queue );
+
+  /// write all rows of the queue
+  /// @param[in] queue source queue
+  /// @return the same as write( const TimePosition& )
+  RetCode write( const TPVAQueue& queue );
+
+  /// write all rows of the queue
+  /// @param[in] queue source queue
+  /// @return the same as write( const TimePosition& )
+  RetCode write( const TPVAListQueue& queue );
+
+  /// write rows sampled by interpolator.pop() at ts, ts+dT, ts+2dT, ... <= tf
+  /// @param[in] interpolator generated interpolator
+  /// @param[in] ts           start time of sampling
+  /// @param[in] tf           finish time of sampling
+  /// @param[in] dT           sampling cycle time
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_INPUT_INTERVAL_TIME_DT: dT <= 0
+  /// - SPLINE_INVALID_INPUT_TIME: ts > tf
+  /// - SPLINE_FILE_IO_ERROR: not opened or failed to write
+  /// @exception the same as interpolator.pop()
+  RetCode write_sampled( const SplineInterpolator& interpolator,
+                         const double& ts,
+                         const double& tf,
+                         const double& dT );
+
+  /// get the number of written rows
+  /// @return the number of rows since open()
+  const std::size_t row_size() const;
+
+  /// format the value as the shortest decimal which reads back to the same value
+  /// @param[in]  value source value
+  /// @param[out] dest  destination (at least FORMAT_SIZE bytes, '\0' terminated)
+  /// @return the length of the string
+  static std::size_t format_double( const double& value, char* dest );
+
+  /// the default size of buffer [byte]
+  static const std::size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+  /// the minimum size of buffer [byte]
+  static const std::size_t MIN_BUFFER_SIZE = 4096;
+
+  /// the size of destination of format_double()
+  static const std::size_t FORMAT_SIZE = 32;
+
+private:
+  /// Copy Constructor (prohibited)
+  TrajectoryExporter( const TrajectoryExporter& src );
+
+  /// Copy(insert) Operator (prohibited)
+  TrajectoryExporter& operator=( const TrajectoryExporter& src );
+
+  /// begin a row (make room for the row in the buffer)
+  /// @param[in] column_size the number of columns of the row
+  /// @return false if not opened or failed to write
+  bool begin_row( const std::size_t& column_size );
+
+  /// append a column to the current row
+  /// @param[in] value the value of the column
+  /// @param[in] first flag if the first column of the row
+  void append( const double& value, const bool& first=false );
+
+  /// end the current row
+  void end_row();
+
+  /// hand the buffer to the file (or the writer thread)
+  /// @return false if failed to write
+  bool flush_buffer();
+
+  /// entry point of the writer thread
+  /// @param[in] arg pointer to TrajectoryExporter
+  static void* writer_entry( void* arg );
+
+  /// loop of the writer thread
+  void writer_loop();
+
+  /// destination file
+  FILE* fp_;
+
+  /// output format
+  ExportFormat format_;
+
+  /// the buffer being filled
+  std::vector<char> buffer_;
+
+  /// the used size of buffer_
+  std::size_t fill_;
+
+  /// the buffer being written by the writer thread
+  std::vector<char> pending_;
+
+  /// the used size of pending_
+  std::size_t pending_size_;
+
+  /// the number of written rows
+  std::size_t row_size_;
+
+  /// flag if the writer thread is running
+  bool is_background_;
+
+  /// flag if pending_ is waiting to be written
+  bool has_pending_;
+
+  /// flag if the writer thread is stopping
+  bool is_stop_;
+
+  /// flag if a write failed
+  bool is_failed_;
+
+  /// writer thread
+  pthread_t writer_;
+
+  /// protects the writer state
+  pthread_mutex_t mutex_;
+
+  /// signaled when pending_ is posted, written, or the writer stops
+  pthread_cond_t cond_;
+};
+
+} // End of namespace interp
+
+#endif // INCLUDE_TRAJECTORY_EXPORTER_HPP_
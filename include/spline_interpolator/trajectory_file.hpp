@@ -0,0 +1,498 @@
+#ifndef INCLUDE_TRAJECTORY_FILE_HPP_
+#define INCLUDE_TRAJECTORY_FILE_HPP_
+
+#include <string>
+#include <vector>
+#include <cstdio> // for FILE
+#include <cstddef> // for size_t
+
+#include "spline_data.hpp"
+
+namespace interp {
+
+/// Kind of queue stored in the trajectory file
+enum TrajectoryFileKind {
+  TRAJECTORY_FILE_TP=1,     ///< TPQueue     (time, position)
+  TRAJECTORY_FILE_TPVA,     ///< TPVAQueue   (time, position, velocity, acceleration)
+  TRAJECTORY_FILE_TPVA_LIST ///< TPVAListQueue (time, [position, velocity, acceleration] x axes)
+};
+
+/// Binary trajectory file of TPQueue, TPVAQueue, TPVAListQueue
+/// @details
+/// Little-endian columnar format (version 1):
+///
+/// ```
+/// offset size
+///      0    8 magic "SPLNTRAJ"
+///      8    4 uint32 version (= 1)
+///     12    4 uint32 kind (TrajectoryFileKind)
+///     16    4 uint32 axis size (1 for TP, TPVA)
+///     20    4 uint32 column size per axis (1 for TP: pos, 3 for others: pos, vel, acc)
+///     24    8 uint64 point size
+///     32    8 uint64 data offset (= 64)
+///     40   24 reserved (0)
+///     64      time column, then pos(, vel, acc) columns of axis 0, axis 1, ...
+///             (each column is point size x float64)
+/// ```
+///
+/// Columns are 8-byte aligned, so TrajectoryFileView can read them in place.
+class TrajectoryFile {
+public:
+  /// the size of file header [byte]
+  static const std::size_t HEADER_SIZE = 64;
+
+  /// the version of file format
+  static const unsigned int VERSION = 1;
+
+  /// write TPQueue into the file
+  /// @param[in] path  destination file path
+  /// @param[in] queue source queue
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_FILE_IO_ERROR: cannot open or write the file
+  static RetCode write( const std::string& path, const TPQueue& queue );
+
+  /// write TPVAQueue into the file
+  /// @param[in] path  destination file path
+  /// @param[in] queue source queue
+  /// @return the same as write( path, TPQueue )
+  static RetCode write( const std::string& path, const TPVAQueue& queue );
+
+  /// write TPVAListQueue into the file
+  /// @param[in] path  destination file path
+  /// @param[in] queue source queue (all points must have the same axis size)
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_QUEUE_SIZE: axis sizes of points are not matched
+  /// - SPLINE_FILE_IO_ERROR: cannot open or write the file
+  static RetCode write( const std::string& path, const TPVAListQueue& queue );
+
+  /// read TPQueue from the file
+  /// @param[in]  path  source file path
+  /// @param[out] queue destination queue (replaced)
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_FILE_IO_ERROR: cannot open or read the file
+  /// - SPLINE_INVALID_FILE_FORMAT: the file is not the trajectory file of TP kind
+  /// - SPLINE_INVALID_INPUT_TIME: times are not strictly increasing
+  static RetCode read( const std::string& path, TPQueue& queue );
+
+  /// read TPVAQueue from the file (TP file is also accepted with vel = acc = 0.0)
+  /// @param[in]  path  source file path
+  /// @param[out] queue destination queue (replaced)
+  /// @return the same as read( path, TPQueue )
+  static RetCode read( const std::string& path, TPVAQueue& queue );
+
+  /// read TPVAListQueue from the file (all kinds are accepted)
+  /// @param[in]  path  source file path
+  /// @param[out] queue destination queue (replaced)
+  /// @return the same as read( path, TPQueue )
+  static RetCode read( const std::string& path, TPVAListQueue& queue );
+};
+
+
+/// Read-only view of the trajectory file mapped on memory
+/// @details
+/// open() validates only the header and the file size,
+/// and all accessors read the mapped pages directly without parsing. \n
+/// Times are not checked at open(), so the writer is responsible for strictly increasing times. \n
+/// Only available on little-endian hosts (open() returns SPLINE_INVALID_FILE_FORMAT on others).
+class TrajectoryFileView {
+public:
+  /// Constructor
+  TrajectoryFileView();
+
+  /// Destructor
+  /// @brief unmap the file
+  ~TrajectoryFileView();
+
+  /// map the file on memory
+  /// @param[in] path source file path
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_FILE_IO_ERROR: cannot open or map the file
+  /// - SPLINE_INVALID_FILE_FORMAT: the file is not the trajectory file
+  RetCode open( const std::string& path );
+
+  /// unmap the file
+  void close();
+
+  /// check the file is mapped
+  /// @return true if mapped
+  bool is_open() const;
+
+  /// get the kind of queue stored in the file
+  /// @return TrajectoryFileKind
+  TrajectoryFileKind kind() const;
+
+  /// get the axis size
+  /// @return axis size
+  const std::size_t axis_size() const;
+
+  /// get the number of points
+  /// @return number of points (0 if not opened)
+  const std::size_t size() const;
+
+  /// get the time column
+  /// @return pointer of size() times
+  const double* times() const;
+
+  /// get the position column of the axis
+  /// @param[in] axis the index of axis
+  /// @return pointer of size() positions (NULL if axis is out of range)
+  const double* positions( const std::size_t& axis=0 ) const;
+
+  /// get the velocity column of the axis
+  /// @param[in] axis the index of axis
+  /// @return pointer of size() velocities (NULL if TP kind or axis is out of range)
+  const double* velocities( const std::size_t& axis=0 ) const;
+
+  /// get the acceleration column of the axis
+  /// @param[in] axis the index of axis
+  /// @return pointer of size() accelerations (NULL if TP kind or axis is out of range)
+  const double* accelerations( const std::size_t& axis=0 ) const;
+
+  /// get the time at the index
+  /// @param[in] index the index of point
+  /// @return clock time at the index
+  /// @exception InvalidIndexAccess If invalid index is accessed.
+  const double time( const std::size_t& index ) const
+    SPLINE_THROW_SPEC(InvalidIndexAccess);
+
+  /// get the time-position-velocity-acceleration of the axis at the index
+  /// @param[in] index the index of point
+  /// @param[in] axis  the index of axis
+  /// @return TimePVA (vel = acc = 0.0 for TP kind)
+  /// @exception InvalidIndexAccess If invalid index or axis is accessed.
+  const TimePVA get( const std::size_t& index, const std::size_t& axis=0 ) const
+    SPLINE_THROW_SPEC(InvalidIndexAccess);
+
+  /// get dT at the index
+  /// @param[in] index the index getting dT (t[index+1] - t[index])
+  /// @return dT at the index
+  /// @exception InvalidIndexAccess If invalid index is accessed.
+  const double dT( const std::size_t& index ) const
+    SPLINE_THROW_SPEC(InvalidIndexAccess);
+
+  /// get total interval time from the first to the last point
+  /// @return total interval time (0.0 if the size is less than 2)
+  const double total_dT() const;
+
+private:
+  /// Copy Constructor (not copyable)
+  TrajectoryFileView( const TrajectoryFileView& src );
+
+  /// copy operator (not copyable)
+  TrajectoryFileView& operator=( const TrajectoryFileView& src );
+
+  /// get the column of the axis
+  /// @param[in] axis   the index of axis
+  /// @param[in] column the column in the axis (0: pos, 1: vel, 2: acc)
+  /// @return pointer of the column (NULL if not exist)
+  const double* column( const std::size_t& axis, const std::size_t& column ) const;
+
+  /// the mapped address
+  void* mapped_;
+
+  /// the mapped size [byte]
+  std::size_t mapped_size_;
+
+  /// the kind of queue
+  TrajectoryFileKind kind_;
+
+  /// the axis size
+  std::size_t axis_size_;
+
+  /// the column size per axis
+  std::size_t column_size_;
+
+  /// the number of points
+  std::size_t point_size_;
+
+  /// the first address of time column
+  const double* times_;
+};
+
+
+/// Writer of the chunked trajectory store for programs larger than memory
+/// @details
+/// Points are pushed one by one and written every chunk_points points,
+/// so the memory of the writer is one chunk regardless of the program size.
+/// Little-endian format (version 1):
+///
+/// ```
+/// offset size
+///      0    8 magic "SPLNSTOR"
+///      8    4 uint32 version (= 1)
+///     12    4 uint32 axis size
+///     16    8 uint64 chunk points (the number of points per chunk)
+///     24    8 uint64 point size
+///     32    8 uint64 chunk size (the number of chunks)
+///     40    8 uint64 index offset
+///     48   16 reserved (0)
+///     64      chunk 0, chunk 1, ...
+///             (each chunk: time, pos, vel, acc of axis 0, axis 1, ... columns
+///              of the points in the chunk x float64)
+///  index      coarse index of chunk size x (float64 start time, uint64 chunk offset)
+/// ```
+class TrajectoryStoreWriter {
+public:
+  /// the size of file header [byte]
+  static const std::size_t HEADER_SIZE = 64;
+
+  /// the version of file format
+  static const unsigned int VERSION = 1;
+
+  /// Constructor
+  TrajectoryStoreWriter();
+
+  /// Destructor
+  /// @brief close() if opened
+  ~TrajectoryStoreWriter();
+
+  /// create the store file
+  /// @param[in] path         destination file path
+  /// @param[in] axis_size    the axis size (>= 1)
+  /// @param[in] chunk_points the number of points per chunk (>= 2, default: 4096)
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_ARGUMENT_VALUE_ZERO: axis_size is 0 or chunk_points is less than 2
+  /// - SPLINE_FILE_IO_ERROR: cannot open the file
+  RetCode open( const std::string& path,
+                const std::size_t& axis_size,
+                const std::size_t& chunk_points=4096 );
+
+  /// push the point of one axis
+  /// @param[in] tpva time, position, velocity, acceleration
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_QUEUE_SIZE: the axis size of the store is not 1
+  /// - SPLINE_INVALID_INPUT_TIME: the time is less than or equal to the one of previous point
+  /// - SPLINE_FILE_IO_ERROR: not opened, or failed to write the chunk
+  RetCode push( const TimePVA& tpva );
+
+  /// push the point of all axes
+  /// @param[in] time     clock time
+  /// @param[in] pva_list positions, velocities, accelerations of all axes
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_QUEUE_SIZE: the size of pva_list is not the axis size
+  /// - SPLINE_INVALID_INPUT_TIME: the time is less than or equal to the one of previous point
+  /// - SPLINE_FILE_IO_ERROR: not opened, or failed to write the chunk
+  RetCode push( const double& time, const PVAList& pva_list );
+
+  /// write the last chunk, the coarse index and the header, then close the file
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_FILE_IO_ERROR: not opened, or failed to write
+  RetCode close();
+
+  /// get the number of pushed points
+  /// @return the number of pushed points
+  const std::size_t size() const;
+
+private:
+  /// Copy Constructor (not copyable)
+  TrajectoryStoreWriter( const TrajectoryStoreWriter& src );
+
+  /// copy operator (not copyable)
+  TrajectoryStoreWriter& operator=( const TrajectoryStoreWriter& src );
+
+  /// push the time of the point into the chunk & write the chunk if full
+  /// @param[in] time clock time (values of the point are already set in the chunk)
+  /// @return the same as push()
+  RetCode commit_point( const double& time );
+
+  /// write the points in the chunk buffer into the file
+  /// @return true if written
+  bool flush_chunk();
+
+  /// destination file
+  FILE* fp_;
+
+  /// flag if the writing failed
+  bool is_failed_;
+
+  /// the axis size
+  std::size_t axis_size_;
+
+  /// the number of points per chunk
+  std::size_t chunk_points_;
+
+  /// the number of pushed points
+  std::size_t point_size_;
+
+  /// the number of points in chunk_
+  std::size_t chunk_fill_;
+
+  /// columns of the current chunk (column c of point i at [c * chunk_points_ + i])
+  std::vector<double> chunk_;
+
+  /// the start time of each written chunk (coarse index)
+  std::vector<double> chunk_start_times_;
+
+  /// the time of the last pushed point
+  double last_time_;
+};
+
+
+/// Player of the chunked trajectory store with bounded resident memory
+/// @details
+/// The store is mapped on memory and the coarse index (start time of each chunk) is
+/// loaded at open(). pop() finds the chunk by the coarse index, and
+/// - advises the kernel to read ahead the chunks [current, current + lookahead],
+/// - drops the other chunks which were advised before,
+///
+/// so the resident pages of the store are bounded by (lookahead + 1) chunks
+/// while the chunks ahead of the playhead are already read when reached. \n
+/// Between points, the path is the cubic Hermite segment of the same coefficients as
+/// CubicSplineInterpolator::generate_path( TPVAQueue ). \n
+/// pop() changes the paging window, so one player must not be used from several threads.
+/// Only available on little-endian hosts (open() returns SPLINE_INVALID_FILE_FORMAT on others).
+class TrajectoryStorePlayer {
+public:
+  /// Constructor
+  /// @param[in] lookahead the number of chunks paged in ahead of the playhead (default: 2, >= 1)
+  explicit TrajectoryStorePlayer( const std::size_t& lookahead=2 );
+
+  /// Destructor
+  /// @brief unmap the file
+  ~TrajectoryStorePlayer();
+
+  /// map the store file and load the coarse index
+  /// @param[in] path source file path
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_FILE_IO_ERROR: cannot open or map the file
+  /// - SPLINE_INVALID_FILE_FORMAT: the file is not the store file
+  RetCode open( const std::string& path );
+
+  /// unmap the file
+  void close();
+
+  /// check the file is mapped
+  /// @return true if mapped
+  bool is_open() const;
+
+  /// pop the time-position-velocity-acceleration of the axis at the input time
+  /// @param[in] t    input time
+  /// @param[in] axis the index of axis
+  /// @return TimePVA at the input time
+  /// @exception
+  /// - NotSplineGenerated : the store is not opened
+  /// - TimeOutOfRange : time is not within the range of the store
+  /// - InvalidIndexAccess : axis is out of range
+  const TimePVA pop( const double& t, const std::size_t& axis=0 ) const;
+
+  /// pop the time-position-velocity-acceleration of all axes at the input time
+  /// @param[in] t input time
+  /// @return TimePVAList at the input time
+  /// @exception the same as pop()
+  const TimePVAList pop_list( const double& t ) const;
+
+  /// get the start time
+  /// @return the time of the first point
+  /// @exception NotSplineGenerated the store is not opened
+  const double start_time() const;
+
+  /// get the finish time
+  /// @return the time of the last point
+  /// @exception NotSplineGenerated the store is not opened
+  const double finish_time() const;
+
+  /// get the number of points
+  /// @return the number of points (0 if not opened)
+  const std::size_t size() const;
+
+  /// get the axis size
+  /// @return the axis size (0 if not opened)
+  const std::size_t axis_size() const;
+
+  /// get the number of chunks
+  /// @return the number of chunks (0 if not opened)
+  const std::size_t chunk_size() const;
+
+  /// get the number of chunks paged in now
+  /// @return the number of chunks in the paging window (<= lookahead + 1)
+  const std::size_t resident_chunk_size() const;
+
+private:
+  /// Copy Constructor (not copyable)
+  TrajectoryStorePlayer( const TrajectoryStorePlayer& src );
+
+  /// copy operator (not copyable)
+  TrajectoryStorePlayer& operator=( const TrajectoryStorePlayer& src );
+
+  /// find the segment of the input time & page the chunks around it
+  /// @param[in]  t           input time
+  /// @param[out] chunk_index the index of chunk including the start point of the segment
+  /// @param[out] point_index the index of the start point in the chunk
+  /// @exception the same as pop()
+  void locate( const double& t, std::size_t& chunk_index, std::size_t& point_index ) const;
+
+  /// evaluate the segment of the axis at the input time
+  /// @param[in] t           input time
+  /// @param[in] chunk_index the index of chunk including the start point of the segment
+  /// @param[in] point_index the index of the start point in the chunk
+  /// @param[in] axis        the index of axis
+  /// @return PosVelAcc at the input time
+  const PosVelAcc evaluate( const double&      t,
+                            const std::size_t& chunk_index,
+                            const std::size_t& point_index,
+                            const std::size_t& axis ) const;
+
+  /// page the chunks [chunk_index, chunk_index + lookahead] in & the others out
+  /// @param[in] chunk_index the index of chunk of the playhead
+  void page( const std::size_t& chunk_index ) const;
+
+  /// advise the kernel about the chunks
+  /// @param[in] begin     the first index of chunks
+  /// @param[in] end       the index next to the last of chunks
+  /// @param[in] will_need true: read ahead, false: drop
+  void advise( const std::size_t& begin, const std::size_t& end, const bool& will_need ) const;
+
+  /// get the column of the chunk
+  /// @param[in] chunk_index the index of chunk
+  /// @param[in] column      the index of column (0: time, 1 + 3 * axis + (0: pos, 1: vel, 2: acc))
+  /// @return pointer of the column
+  const double* column( const std::size_t& chunk_index, const std::size_t& column ) const;
+
+  /// get the number of points in the chunk
+  /// @param[in] chunk_index the index of chunk
+  /// @return the number of points in the chunk
+  const std::size_t chunk_point_size( const std::size_t& chunk_index ) const;
+
+  /// the number of chunks paged in ahead of the playhead
+  std::size_t lookahead_;
+
+  /// the mapped address
+  void* mapped_;
+
+  /// the mapped size [byte]
+  std::size_t mapped_size_;
+
+  /// the axis size
+  std::size_t axis_size_;
+
+  /// the number of points per chunk
+  std::size_t chunk_points_;
+
+  /// the number of points
+  std::size_t point_size_;
+
+  /// the start time of each chunk (coarse index)
+  std::vector<double> chunk_start_times_;
+
+  /// the offset of each chunk [byte]
+  std::vector<std::size_t> chunk_offsets_;
+
+  /// the first index of paged chunks
+  mutable std::size_t resident_begin_;
+
+  /// the index next to the last of paged chunks
+  mutable std::size_t resident_end_;
+};
+
+} // End of namespace interp
+
+#endif // INCLUDE_TRAJECTORY_FILE_HPP_
@@ -0,0 +1,272 @@
+#ifndef INCLUDE_TRAJECTORY_LUT_HPP_
+#define INCLUDE_TRAJECTORY_LUT_HPP_
+
+#include <vector>
+#include <cstddef> // for size_t
+
+#include "spline_data.hpp"
+#include "trajectory.hpp"
+
+namespace interp {
+
+class SplineInterpolator;
+
+/// Interpolation between the entries of TrajectoryLUT
+enum LUTInterpolation {
+  LUT_LINEAR,  ///< linear interpolation of position, velocity and acceleration
+  LUT_HERMITE  ///< cubic Hermite of position and velocity, linear acceleration
+};
+
+/// Pre-sampled lookup table of a generated trajectory for fixed-cycle playback
+/// @details
+/// The path is divided into cells of the same length (at most base_dT),
+/// and a cell of the level L is sampled at 2^L + 1 points (the end points are shared). \n
+/// evaluate() finds the entry in O(1) from the cell and the level without search,
+/// and interpolates between two entries (linear or cubic Hermite). \n
+/// build_uniform() samples every cell once (level 0).
+/// build_adaptive() raises the level of each cell until the deviation from pop()
+/// is within the tolerance, so that entries are dense only where the curvature is high
+/// (e.g. the quintic phases of Trapezoid5251525). \n
+/// The deviation is measured at 1/4, 1/2 and 3/4 of every interval of entries
+/// against pop() of the source, and max_deviation() reports the maximum of the position.
+///
+/// ```
+/// TrajectoryLUT lut;
+/// lut.build_adaptive( interpolator, 0.1, 1.0e-6 );
+/// std::cout << lut.size() << " entries, deviation " << lut.max_deviation() << std::endl;
+/// for( double t=lut.start_time(); t < lut.finish_time(); t+=dT ) {
+///   lut.evaluate<OUTPUT_POS>( t, pos, vel, acc );
+/// }
+/// ```
+class TrajectoryLUT : public TrajectoryBase<TrajectoryLUT> {
+public:
+  /// the maximum level of a cell (2^MAX_LEVEL intervals)
+  static const std::size_t MAX_LEVEL = 16;
+
+  /// Constructor (empty)
+  TrajectoryLUT();
+
+  /// Build the table of uniform entries
+  /// @param[in] interpolator  generated interpolator
+  /// @param[in] dT            interval of entries (the last interval is adjusted to the finish)
+  /// @param[in] interpolation interpolation between entries (default: LUT_HERMITE)
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_SEGMENT_NOT_GENERATED : path is not generated
+  /// - SPLINE_INVALID_INPUT_INTERVAL_TIME_DT : dT is not positive
+  RetCode build_uniform( const SplineInterpolator& interpolator,
+                         const double&             dT,
+                         const LUTInterpolation&   interpolation=LUT_HERMITE );
+
+  /// Build the table of entries refined by the error tolerance
+  /// @param[in] interpolator  generated interpolator
+  /// @param[in] base_dT       maximum interval of entries (length of cells)
+  /// @param[in] tolerance     tolerance of the position deviation from pop()
+  /// @param[in] interpolation interpolation between entries (default: LUT_HERMITE)
+  /// @param[in] max_level     maximum level of cells (<= MAX_LEVEL, default: 10)
+  /// @return
+  /// - SPLINE_SUCCESS : the table is built (the tolerance may be unmet at max_level,
+  ///                    see max_deviation())
+  /// - SPLINE_SEGMENT_NOT_GENERATED : path is not generated
+  /// - SPLINE_INVALID_INPUT_INTERVAL_TIME_DT : base_dT is not positive
+  /// - SPLINE_INVALID_ARGUMENT_VALUE_ZERO : tolerance is not positive
+  RetCode build_adaptive( const SplineInterpolator& interpolator,
+                          const double&             base_dT,
+                          const double&             tolerance,
+                          const LUTInterpolation&   interpolation=LUT_HERMITE,
+                          const std::size_t&        max_level=10 );
+
+  /// Clear the table
+  void clear();
+
+  /// Evaluate the position, velocity and acceleration at the input-time
+  /// @param[in]  t   input time
+  /// @param[out] pos position
+  /// @param[out] vel velocity
+  /// @param[out] acc acceleration
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_SEGMENT_NOT_GENERATED: table is not built
+  /// - SPLINE_INVALID_INPUT_TIME: time is not within the range of the table
+  RetCode evaluate( const double& t, double& pos, double& vel, double& acc ) const {
+    return evaluate<OUTPUT_PVA>( t, pos, vel, acc );
+  }
+
+  /// Evaluate the selected outputs at the input-time
+  /// @param[in]  t   input time
+  /// @param[out] pos position (written if Mask has OUTPUT_POS)
+  /// @param[out] vel velocity (written if Mask has OUTPUT_VEL)
+  /// @param[out] acc acceleration (written if Mask has OUTPUT_ACC)
+  /// @tparam Mask combination of OutputMask
+  /// @return the same as evaluate()
+  template<unsigned int Mask>
+  RetCode evaluate( const double& t, double& pos, double& vel, double& acc ) const {
+    if( pos_.empty() ) {
+      return SPLINE_SEGMENT_NOT_GENERATED;
+    }
+    if( t < start_time_ || t > finish_time_ ) {
+      return SPLINE_INVALID_INPUT_TIME;
+    }
+    // cell of the base grid
+    const double x = ( t - start_time_ ) * inverse_cell_dT_;
+    std::size_t cell = static_cast<std::size_t>( x );
+    if( cell >= cell_level_.size() ) {
+      cell = cell_level_.size() - 1;
+    }
+    // interval in the cell
+    const std::size_t level        = cell_level_[cell];
+    const std::size_t interval_num = static_cast<std::size_t>( 1 ) << level;
+    const double s = ( x - cell ) * interval_num;
+    std::size_t interval = static_cast<std::size_t>( s );
+    if( interval >= interval_num ) {
+      interval = interval_num - 1;
+    }
+    interpolate<Mask>( cell_offset_[cell] + interval, s - interval,
+                       level_dT_[level], level_inverse_dT_[level],
+                       pos, vel, acc );
+    return SPLINE_SUCCESS;
+  }
+
+  /// Get the start time
+  /// @return start time (0.0 if not built)
+  const double start_time() const;
+
+  /// Get the finish time
+  /// @return finish time (0.0 if not built)
+  const double finish_time() const;
+
+  /// Get the number of entries
+  /// @return the number of entries (0 if not built)
+  const std::size_t size() const;
+
+  /// Get the number of cells
+  /// @return the number of cells (0 if not built)
+  const std::size_t cell_num() const;
+
+  /// Get the level of the cell
+  /// @param[in] cell index of the cell (< cell_num())
+  /// @return level (2^level intervals in the cell)
+  const std::size_t level( const std::size_t& cell ) const;
+
+  /// Get the interpolation between entries
+  /// @return interpolation given at the build
+  const LUTInterpolation interpolation() const;
+
+  /// Get the achieved maximum deviation of positions from pop() of the source
+  /// @return maximum deviation at the check points (0.0 if not built)
+  const double max_deviation() const;
+
+private:
+  /// Build the table
+  /// @param[in] interpolator  generated interpolator
+  /// @param[in] base_dT       maximum length of cells
+  /// @param[in] tolerance     tolerance of the deviation (<= 0.0: no refinement)
+  /// @param[in] interpolation interpolation between entries
+  /// @param[in] max_level     maximum level of cells
+  /// @return the same as build_adaptive()
+  RetCode build( const SplineInterpolator& interpolator,
+                 const double&             base_dT,
+                 const double&             tolerance,
+                 const LUTInterpolation&   interpolation,
+                 const std::size_t&        max_level );
+
+  /// Sample the cell at the level
+  /// @param[in] interpolator generated interpolator
+  /// @param[in] cell         index of the cell
+  /// @param[in] level        level of the cell
+  /// @details Entries after the start of the cell are replaced.
+  void sample_cell( const SplineInterpolator& interpolator,
+                    const std::size_t& cell, const std::size_t& level );
+
+  /// Deviation of positions in the cell from the source
+  /// @param[in] interpolator generated interpolator
+  /// @param[in] cell         index of the cell
+  /// @return maximum deviation at 1/4, 1/2 and 3/4 of every interval in the cell
+  const double cell_deviation( const SplineInterpolator& interpolator,
+                               const std::size_t& cell ) const;
+
+  /// Interpolate between the entry and the next one
+  /// @param[in]  index      index of the entry
+  /// @param[in]  u          normalized time in the interval [0, 1]
+  /// @param[in]  h          length of the interval
+  /// @param[in]  inverse_h  1.0 / h
+  /// @param[out] pos        position (written if Mask has OUTPUT_POS)
+  /// @param[out] vel        velocity (written if Mask has OUTPUT_VEL)
+  /// @param[out] acc        acceleration (written if Mask has OUTPUT_ACC)
+  /// @tparam Mask combination of OutputMask
+  template<unsigned int Mask>
+  void interpolate( const std::size_t& index, const double& u,
+                    const double& h, const double& inverse_h,
+                    double& pos, double& vel, double& acc ) const {
+    const double p0 = pos_[index], p1 = pos_[index+1];
+    const double v0 = vel_[index], v1 = vel_[index+1];
+    if( interpolation_ == LUT_LINEAR ) {
+      if( Mask & OUTPUT_POS ) {
+        pos = p0 + ( p1 - p0 ) * u;
+      }
+      if( Mask & OUTPUT_VEL ) {
+        vel = v0 + ( v1 - v0 ) * u;
+      }
+    } else {
+      const double u2 = u * u;
+      if( Mask & OUTPUT_POS ) {
+        const double u3 = u2 * u;
+        pos =   ( 2.0 * u3 - 3.0 * u2 + 1.0 ) * p0
+              + ( u3 - 2.0 * u2 + u ) * h * v0
+              + ( -2.0 * u3 + 3.0 * u2 ) * p1
+              + ( u3 - u2 ) * h * v1;
+      }
+      if( Mask & OUTPUT_VEL ) {
+        vel =   6.0 * ( u2 - u ) * ( p0 - p1 ) * inverse_h
+              + ( 3.0 * u2 - 4.0 * u + 1.0 ) * v0
+              + ( 3.0 * u2 - 2.0 * u ) * v1;
+      }
+    }
+    if( Mask & OUTPUT_ACC ) {
+      acc = acc_[index] + ( acc_[index+1] - acc_[index] ) * u;
+    }
+  }
+
+  /// start time
+  double start_time_;
+
+  /// finish time
+  double finish_time_;
+
+  /// length of cells
+  double cell_dT_;
+
+  /// 1.0 / cell_dT_
+  double inverse_cell_dT_;
+
+  /// interval of entries of each level (cell_dT_ / 2^level)
+  double level_dT_[MAX_LEVEL + 1];
+
+  /// inverse interval of entries of each level (2^level / cell_dT_)
+  double level_inverse_dT_[MAX_LEVEL + 1];
+
+  /// interpolation between entries
+  LUTInterpolation interpolation_;
+
+  /// maximum deviation of positions at the check points
+  double max_deviation_;
+
+  /// index of the first entry of each cell
+  std::vector<std::size_t> cell_offset_;
+
+  /// level of each cell
+  std::vector<unsigned char> cell_level_;
+
+  /// positions of entries
+  std::vector<double> pos_;
+
+  /// velocities of entries
+  std::vector<double> vel_;
+
+  /// accelerations of entries
+  std::vector<double> acc_;
+};
+
+} // End of namespace interp
+
+#endif // INCLUDE_TRAJECTORY_LUT_HPP_
@@ -13,8 +13,12 @@
 #include <iostream>
 #include <iomanip>
 
+#include "spline_data.hpp" // for OutputMask
+
 namespace interp {
 
+class Trapezoid5251525Profile;
+
 /// 台形型5251525次軌道生成クラス
 class Trapezoid5251525 {
 public:
@@ -42,7 +46,7 @@ public:
   /// 代入演算子
   /// @param[in] src コピー元Trapezoid5251525クラスオブジェクト
   /// @return *this
-  Trapezoid5251525 operator=(const Trapezoid5251525& src);
+  Trapezoid5251525& operator=(const Trapezoid5251525& src);
 
   /// 構成パラメータの初期化
   /// @param[in] a_limit 第一加速(減速)度上限値
@@ -70,7 +74,9 @@ public:
   /// 1. 最大速度方向の初期設定 @n
   /// 2. 最速軌道の最大速度と最短時間の算出 @n
   /// 3. 到達限界・速度反転領域の判定 @n
-  /// @return 移動時間(tf-t0) @n
+  /// 計画は Trapezoid5251525Profile::generate_path() による.
+  /// @return 移動時間(tf-t0) @n (移動なしでは -1.0)
+  /// @exception throw_generation_error() と同じ
   double generate_path(const double& t0, const double& tf,
                        const double& x0, const double& xf,
                        const double& v0, const double& vf );
@@ -84,6 +90,18 @@ public:
   /// @exception 軌道生成が実施されていない
   const int pop(const double& t, double& xt, double& vt, double& at) const;
 
+  /// 選択した出力のみの軌道出力
+  /// @tparam Mask OutputMask の組合せ (OUTPUT_POS, OUTPUT_POS_VEL など)
+  /// @param[in]  t  入力時刻
+  /// @param[out] xt 位置 (Mask に OUTPUT_POS があれば出力)
+  /// @param[out] vt 速度 (Mask に OUTPUT_VEL があれば出力)
+  /// @param[out] at 加速度 (Mask に OUTPUT_ACC があれば出力)
+  /// @return 0
+  /// @exception pop() と同じ
+  /// @details 選択しない出力の多項式は計算しない. 出力は pop() と bitwise で同じ.
+  template<unsigned int Mask>
+  const int pop(const double& t, double& xt, double& vt, double& at) const;
+
   /// 終端時刻
   /// @return 終端時刻
   const double finish_time();
@@ -94,40 +112,18 @@ public:
   static const double DT_MAX_LIMIT_;
 
 private:
-  /// 0. 入力範囲のチェック
-  void input_check();
-
-  /// 1. 最大速度方向sign_の初期設定
-  /// @return sign_の初期設定値
-  double calc_initial_v_max_direction_sign();
-
-  /// 2. 最速軌道の最大速度と最短時間の算出
-  /// @param a_max          最速軌道を構成する第一加速度
-  /// @param d_max          最速軌道を構成する第二加速度
-  void calc_fastest_parameter( const double& a_max,
-                               const double& d_max );
-
-  /// 3. 到達限界・速度反転領域の判定
-  void judge_reach_limitation();
-
-  /// 加速度を、最短時間に対する目標移動時間の比率により、上限値と下限値の内分をとって算出
-  void calc_acceleration_with_ratio();
-
-  /// 正方向のv_max算出
-  /// @param[in] signA 第一加速(減速)度方向
-  /// @param[in] signD 第二加速(減速)度方向
-  /// @@aram[out] dT3 等速区間の時間
-  /// @param[out] ret 成功:true/失敗:false
-  /// @return v_max 等速度
-  double internal_calc_v_max_and_dT3(const double& signA, const double& signD,
-                                     double& dT3, bool& ret);
-
-  /// 5. 最大速度v_maxと等速移動時間dT3の算出
-  void calc_v_max_and_dT3();
-
-  /// 6. 軌道パラメータ算出
-  void set_parameter();
-
+  /// 計画したプロファイルの軌道パラメータの取り込み
+  /// @param[in] profile 計画済みプロファイル
+  void assign_profile( const Trapezoid5251525Profile& profile );
+
+  /// 計画失敗を従来の例外として送出
+  /// @param[in] profile 計画失敗したプロファイル
+  /// @param[in] retcode Trapezoid5251525Profile::generate_path() の戻り値
+  /// @exception
+  /// - std::invalid_argument : 入力範囲外, もしくは最短時間より前に到達不可能
+  /// - std::runtime_error : 最大速度・等速移動時間の解なし, もしくは速度リミット超過
+  void throw_generation_error( const Trapezoid5251525Profile& profile,
+                               const RetCode&                 retcode ) const;
 
   /// 入力値 ////////////////////////////////////////////////////////////////
 
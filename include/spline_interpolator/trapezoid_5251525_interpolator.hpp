@@ -9,6 +9,8 @@ namespace interp {
 
 class TrapezoidalInterpolator : public SplineInterpolator
 {
+  friend class TrapezoidSegmentTask;
+  friend class TrajectoryBank;
 public:
   /// デフォルトコンストラクタ
   TrapezoidalInterpolator();
@@ -50,6 +52,17 @@ public:
   /// @return *this
   TrapezoidalInterpolator& operator=( const TrapezoidalInterpolator& src );
 
+#ifdef SPLINE_CXX11
+  /// ムーブコンストラクタ
+  /// @param[in] src ムーブ元 (ムーブ後は軌道未生成)
+  TrapezoidalInterpolator( TrapezoidalInterpolator&& src ) SPLINE_NOEXCEPT;
+
+  /// ムーブ代入演算子
+  /// @param[in] src ムーブ元 (ムーブ後は軌道未生成)
+  /// @return *this
+  TrapezoidalInterpolator& operator=( TrapezoidalInterpolator&& src ) SPLINE_NOEXCEPT;
+#endif
+
   /// 初期化
   /// @param[in] trpzd_config_que 台形型5251525次軌道の構成データのキュー。
   ///                             補間点区間の数と同じサイズ。以下が構成要素。
@@ -82,6 +95,9 @@ public:
   /// @param[in] vf              終端速度 (default: 0.0)
   /// @return
   /// - SPLINE_SUCCESS
+  /// - SPLINE_INVALID_QUEUE_SIZE    : 目標点の数が区間軌道の数+1と異なる
+  /// - SPLINE_INVALID_INPUT_TIME    : 目標時刻が単調増加でない
+  /// - SPLINE_FAIL_TO_GENERATE_PATH : 区間軌道の計画失敗 (一括生成モードのみ)
   /// @details
   /// 入力は以下の様な位置・時刻 TimePosition のキュー
   ///
@@ -99,7 +115,10 @@ public:
   /// (tf, xf, vf,   af=0, jf=0)
   /// ```
   ///
-  /// 補間器は中間の (v1,a1,j1), (v2,a2,j2),.. を自動で補間計算する.
+  /// 補間器は中間の (v1,a1,j1), (v2,a2,j2),.. を自動で補間計算する. \n
+  /// 中間点の速度は NonUniformRoundingSpline::compute_velocities() で一括計算し,
+  /// generate_path(TPVAQueue) で区間軌道を計画する
+  /// (遅延生成モード・スレッドプールの設定に従う).
   virtual RetCode generate_path( const TPQueue& target_tp_queue,
                                  const double vs=0.0, const double vf=0.0,
                                  const double as=0.0, const double af=0.0);
@@ -108,6 +127,15 @@ public:
   /// @param[in] target_tpva_queue 目標の時刻, 位置(, 速度, 加速度)のキュー
   /// @return
   /// - SPLINE_SUCCESS
+  /// - SPLINE_INVALID_QUEUE_SIZE    : 目標点の数が区間軌道の数+1と異なる
+  /// - SPLINE_FAIL_TO_GENERATE_PATH : 区間軌道の計画失敗 (一括生成モードのみ)
+  /// @details
+  /// 遅延生成モードでは先頭から lookahead 区間先までのみ計画し,
+  /// 残りの区間は pop() / prefetch() で計画する. \n
+  /// 一括生成モードで set_thread_pool() によりスレッドプールが設定されていれば,
+  /// 各区間軌道を並列に計画する. この場合, 区間軌道の計画の例外は送出せず
+  /// SPLINE_FAIL_TO_GENERATE_PATH を返し, segment_status() で失敗区間を通知する. \n
+  /// 計画失敗(例外を含む)時は前回の軌道も破棄され, 軌道未生成となる.
   virtual RetCode generate_path( const TPVAQueue& target_tpva_queue );
 
   /// 開始＆終端の時刻, 位置(, 速度, 加速度)からスプライン軌道を生成
@@ -135,10 +163,72 @@ public:
   /// @param[in] t 入力時刻
   /// @return その入力時刻でのTimePVA(時刻,(位置,速度,加速度))の出力
   /// @exception
-  /// - NotSplineGenerated : spline-path is not genrated
+  /// - NotSplineGenerated : spline-path is not genrated,
+  ///                        or the segment of the input time failed to generate (lazy mode)
+  ///                        or is not generated (lazy mode switched off after generate_path())
   /// - TimeOutOfRange : time is not within the range of generated spline-path
+  /// @details
+  /// 遅延生成モードでは, 入力時刻の区間軌道が未計画ならばここで計画する.
+  /// 同時に先読み区間数(lookahead)分先の区間軌道まで計画する.
   virtual const TimePVA pop( const double& t ) const;
 
+  /// 生成済み軌道から入力時刻の選択した出力のみを出力
+  /// @tparam Mask OutputMask の組合せ (全ての組合せをソースで実体化)
+  /// @param[in] t 入力時刻
+  /// @return その入力時刻でのTimePVA (選択外の出力は 0.0)
+  /// @exception pop() と同じ
+  template<unsigned int Mask>
+  const TimePVA pop( const double& t ) const;
+
+  /// 遅延生成モードの設定
+  /// @param[in] enable    true : generate_path(TPVAQueue) では区間軌道を計画せず,
+  ///                             pop() / prefetch() で初めて触れた区間を計画する. \n
+  ///                      false: generate_path() で全区間を計画する (default)
+  /// @param[in] lookahead 再生位置の区間から先読みで計画する区間数 (default: 0)
+  /// @details
+  /// 遅延生成モードでは区間軌道の計画失敗は generate_path() の戻り値ではなく,
+  /// segment_status() / generation_status() で通知される. \n
+  /// pop() / prefetch() は const だが内部の区間軌道キャッシュを更新するため,
+  /// 同一インスタンスを複数スレッドから同時に pop() してはならない. \n
+  /// 設定は次の generate_path() から有効. 一括生成モードの pop() / prefetch() は計画しない.
+  void set_lazy_generation( const bool& enable, const std::size_t& lookahead=0 );
+
+  /// 遅延生成モードの取得
+  /// @return true: 遅延生成モード, false: 一括生成モード
+  const bool lazy_generation() const;
+
+  /// 先読み区間数の取得
+  /// @return 再生位置の区間から先読みで計画する区間数
+  const std::size_t lookahead() const;
+
+  /// 再生位置からの先読み計画
+  /// @param[in] t 再生位置の時刻 (pop() の入力時刻. 時間スケールは pop() と同じく適用する)
+  /// @return
+  /// - SPLINE_SUCCESS                : 先読み範囲の区間軌道は全て計画済み
+  /// - SPLINE_FAIL_TO_GENERATE_PATH  : 先読み範囲に計画失敗した区間軌道がある
+  /// - SPLINE_INVALID_INPUT_TIME     : 入力時刻が軌道の範囲外
+  /// - SPLINE_UNINITIALIZED_INTERPOLATOR : 軌道未生成
+  /// @details
+  /// 入力時刻の区間から lookahead 区間先までの未計画区間を計画する.
+  /// 再生ループの空き時間に呼び出すことで pop() 時の計画遅延を隠蔽できる.
+  RetCode prefetch( const double& t ) const;
+
+  /// 区間軌道の計画状態
+  /// @param[in] index 区間軌道のインデックス
+  /// @return
+  /// - SPLINE_SUCCESS                : 計画済み
+  /// - SPLINE_SEGMENT_NOT_GENERATED  : 未計画 (遅延生成モード)
+  /// - SPLINE_FAIL_TO_GENERATE_PATH  : 計画失敗
+  /// - SPLINE_INVALID_INPUT_INDEX    : インデックスが範囲外
+  RetCode segment_status( const std::size_t& index ) const;
+
+  /// これまでに計画した区間軌道の計画状態
+  /// @param[out] failed_index 最初に計画失敗した区間軌道のインデックス(失敗がある場合のみ更新)
+  /// @return
+  /// - SPLINE_SUCCESS               : 計画失敗した区間軌道なし
+  /// - SPLINE_FAIL_TO_GENERATE_PATH : 計画失敗した区間軌道あり
+  RetCode generation_status( std::size_t& failed_index ) const;
+
   /// clear target TPVAQueue (target_tpva_queue_)
   ///       & path parameter queue (depend on each interpolator class)
   virtual RetCode clear();
@@ -149,13 +239,60 @@ public:
 
 private:
   /// コンストラクタにてTrapzoidConfigデータからtrapzd_trajectory_que_を生成
+  /// (確保済みの要素は再利用する)
   void create_trapzd_trajectory_que();
 
+  /// target_tpva_queue_ に設定済みの目標点から全区間軌道を計画
+  /// @return generate_path(const TPVAQueue&) と同じ
+  RetCode generate_path_from_target();
+
+  /// 全区間軌道の計画状態をリセット
+  /// @param[in] status リセット後の計画状態
+  void reset_segment_status( const RetCode& status );
+
+  /// target_tpva_queue_ の index 番目と index+1 番目の点から区間軌道を計画
+  /// @param[in] index 区間軌道のインデックス
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_FAIL_TO_GENERATE_PATH
+  /// @exception
+  /// - std::invalid_argument : 到達不可能等の入力エラー (Trapezoid5251525::generate_path())
+  RetCode generate_segment( const std::size_t& index ) const;
+
+  /// 未計画の区間軌道を計画して計画状態を記録する. 例外は計画失敗として記録する.
+  /// @param[in] index 区間軌道のインデックス
+  /// @return 区間軌道の計画状態 (segment_status() と同じ)
+  RetCode ensure_segment( const std::size_t& index ) const;
+
+  /// index 番目から lookahead_ 区間先までの区間軌道を計画 (遅延生成モードのみ)
+  /// @param[in] index 再生位置の区間軌道のインデックス
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_FAIL_TO_GENERATE_PATH
+  /// @details 一括生成モードでは計画せず, index 番目の区間軌道が計画済みか否かを返す.
+  RetCode ensure_segments( const std::size_t& index ) const;
+
   /// 台形型5251525次軌道の構成データ
   TrapezoidConfigQueue trapzd_config_que_;
 
   /// 台形型5251525次軌道(＆補間器)
-  Trapezoid5251525_Queue trapzd_trajectory_que_;
+  /// 遅延生成モードでは const な pop() から計画するため mutable
+  mutable Trapezoid5251525_Queue trapzd_trajectory_que_;
+
+  /// 区間軌道毎の計画状態
+  mutable std::vector<RetCode> segment_status_que_;
+
+  /// 計画失敗した区間軌道の有無
+  mutable bool is_segment_failed_;
+
+  /// 最初に計画失敗した区間軌道のインデックス
+  mutable std::size_t failed_segment_index_;
+
+  /// 遅延生成モードフラグ (default: false)
+  bool is_lazy_;
+
+  /// 先読み区間数 (default: 0)
+  std::size_t lookahead_;
 };
 
 
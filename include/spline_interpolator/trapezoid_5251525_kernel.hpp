@@ -0,0 +1,113 @@
+#ifndef INCLUDE_TRAPEZOID_5251525_KERNEL_HPP_
+#define INCLUDE_TRAPEZOID_5251525_KERNEL_HPP_
+
+#include "spline_data.hpp" // for OutputMask, SPLINE_CONSTEXPR14
+
+namespace interp {
+
+/// 台形型5251525次軌道の各Stepの形
+/// @details
+/// Step1, Step5 は TRAPZD_ROUND_IN, Step3, Step7 は TRAPZD_ROUND_OUT,
+/// Step2, Step4, Step6 は TRAPZD_CONSTANT (Step4 は加速度0).
+enum Trapezoid5251525StepShape {
+  TRAPZD_ROUND_IN,  ///< 加速度 0 -> A の丸め区間 (5次)
+  TRAPZD_CONSTANT,  ///< 加速度 A の等加速度区間 (2次)
+  TRAPZD_ROUND_OUT  ///< 加速度 A -> 0 の丸め区間 (5次)
+};
+
+/// 台形型5251525次軌道の1Stepの出力
+/// @details
+/// Trapezoid5251525::pop(), Trapezoid5251525Profile::evaluate() の共通の計算. \n
+/// 減速側の Step5, Step6, Step7 は A = -signD * d_max で与える.
+/// @tparam Mask OutputMask の組合せ
+/// @param[in]  shape Stepの形
+/// @param[in]  dt    Step開始からの経過時間
+/// @param[in]  A     符号付き加速度 (丸め区間では到達(開始)加速度)
+/// @param[in]  dT    丸め区間の移動時間 (TRAPZD_CONSTANT では未使用)
+/// @param[in]  v     Step開始速度
+/// @param[in]  x     Step開始位置
+/// @param[out] xt    位置 (Mask に OUTPUT_POS があれば出力)
+/// @param[out] vt    速度 (Mask に OUTPUT_VEL があれば出力)
+/// @param[out] at    加速度 (Mask に OUTPUT_ACC があれば出力)
+template<unsigned int Mask>
+inline SPLINE_CONSTEXPR14 void g_trapezoid5251525_step( const Trapezoid5251525StepShape& shape,
+                                                        const double& dt, const double& A,
+                                                        const double& dT,
+                                                        const double& v, const double& x,
+                                                        double& xt, double& vt, double& at ) {
+  if( shape == TRAPZD_ROUND_IN ) {
+    if( Mask & OUTPUT_POS ) {
+      xt = (-0.1) * A/(dT * dT * dT) * dt * dt * dt * dt * dt
+         + 0.25 * A/(dT * dT) * dt * dt * dt * dt
+         + v * dt + x;
+    }
+    if( Mask & OUTPUT_VEL ) {
+      vt = (-0.5) * A/(dT * dT * dT) * dt * dt * dt * dt
+         + A/(dT * dT) * dt * dt * dt + v;
+    }
+    if( Mask & OUTPUT_ACC ) {
+      at = (-2.0) * A/(dT * dT * dT) * dt * dt * dt
+         + 3.0 * A/(dT * dT) * dt * dt;
+    }
+  } else if( shape == TRAPZD_ROUND_OUT ) {
+    if( Mask & OUTPUT_POS ) {
+      xt = 0.1 * A/(dT * dT * dT) * dt * dt * dt * dt * dt
+         - 0.25 * A/(dT * dT) * dt * dt * dt * dt
+         + 0.5 * A * dt * dt
+         + v * dt + x;
+    }
+    if( Mask & OUTPUT_VEL ) {
+      vt = 0.5 * A/(dT * dT * dT) * dt * dt * dt * dt
+         - A/(dT * dT) * dt * dt * dt
+         + A * dt + v;
+    }
+    if( Mask & OUTPUT_ACC ) {
+      at = 2.0 * A/(dT * dT * dT) * dt * dt * dt
+         - 3.0 * A/(dT * dT) * dt * dt
+         + A;
+    }
+  } else {
+    if( Mask & OUTPUT_POS ) {
+      xt = 0.5 * A * dt * dt + v * dt + x;
+    }
+    if( Mask & OUTPUT_VEL ) {
+      vt = A * dt + v;
+    }
+    if( Mask & OUTPUT_ACC ) {
+      at = A;
+    }
+  }
+}
+
+/// 台形型5251525次軌道の1Stepの位置の多項式係数
+/// @details
+/// g_trapezoid5251525_step() の位置を dt のべき乗で展開した係数
+/// (TrajectoryBank の PolynomialPiece 用).
+/// @param[in]  shape Stepの形
+/// @param[in]  A     符号付き加速度
+/// @param[in]  dT    丸め区間の移動時間 (TRAPZD_CONSTANT では未使用)
+/// @param[in]  v     Step開始速度
+/// @param[in]  x     Step開始位置
+/// @param[out] coef  dt^0, ..., dt^5 の係数 (6個)
+inline SPLINE_CONSTEXPR14 void g_trapezoid5251525_step_coef( const Trapezoid5251525StepShape& shape,
+                                                             const double& A, const double& dT,
+                                                             const double& v, const double& x,
+                                                             double* coef ) {
+  coef[0] = x;
+  coef[1] = v;
+  coef[2] = ( shape == TRAPZD_ROUND_IN ) ? 0.0 : 0.5 * A;
+  coef[3] = 0.0;
+  coef[4] = 0.0;
+  coef[5] = 0.0;
+  if( shape == TRAPZD_ROUND_IN ) {
+    coef[4] = 0.25 * A / (dT * dT);
+    coef[5] = (-0.1) * A / (dT * dT * dT);
+  } else if( shape == TRAPZD_ROUND_OUT ) {
+    coef[4] = (-0.25) * A / (dT * dT);
+    coef[5] = 0.1 * A / (dT * dT * dT);
+  }
+}
+
+} // End of namespace interp
+
+#endif // INCLUDE_TRAPEZOID_5251525_KERNEL_HPP_
@@ -0,0 +1,797 @@
+#ifndef INCLUDE_TRAPEZOID_5251525_PROFILE_HPP_
+#define INCLUDE_TRAPEZOID_5251525_PROFILE_HPP_
+
+#include <cstddef> // for size_t
+
+#include "spline_data.hpp"
+#include "spline_exception.hpp"
+#include "trajectory.hpp"
+#include "trapezoid_5251525_kernel.hpp"
+
+namespace interp {
+
+/// 絶対値 (constexpr版 fabs)
+/// @param[in] value 値
+/// @return |value|
+inline SPLINE_CONSTEXPR14 double g_constexpr_fabs( const double& value ) {
+  return ( value < 0.0 ) ? -value : value;
+}
+
+/// 平方根 (constexpr版 sqrt)
+/// @param[in] value 値 (0.0以上)
+/// @return value の平方根 (value <= 0.0 では 0.0)
+/// @details
+/// 真値より大きい初期値からのニュートン法で, 減少しなくなるまで反復する.
+/// std::sqrt() との差は高々1ulp程度.
+inline SPLINE_CONSTEXPR14 double g_constexpr_sqrt( const double& value ) {
+  if( !( value > 0.0 ) ) {
+    return 0.0;
+  }
+  double root = ( value > 1.0 ) ? value : 1.0;
+  while( true ) {
+    const double next = 0.5 * ( root + value / root );
+    if( next >= root ) {
+      break;
+    }
+    root = next;
+  }
+  return root;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+/// 台形型5251525次軌道のプロファイル (コンパイル時計算用)
+/// @details
+/// 台形型5251525次軌道の唯一の計画の実装. 例外・ヒープ確保・iostreamなしで行い,
+/// エラーは RetCode で返す. Trapezoid5251525::generate_path() もこの計画を使い,
+/// エラーを例外に変換する.
+/// 各Stepの出力は Trapezoid5251525::pop() と共通の g_trapezoid5251525_step() による. \n
+/// C++14 (SPLINE_CXX14) 以降は constexpr となり, 固定の構成パラメータと移動距離の
+/// 定型動作 (原点復帰, ツール交換, 退避等) をコンパイル時に計画できる.
+/// 平方根は g_constexpr_sqrt() による (std::sqrt() との差は高々1ulp程度). \n
+/// pop(), sample() は TrajectoryBase による.
+///
+/// ```
+/// constexpr Trapezoid5251525Profile HOMING
+///   = g_plan_trapezoid5251525( 1200, 1200, 170, 0.8, 0.8, 0.5,   // 構成パラメータ
+///                              0.0, 0.0, 0.0, 100.0 );          // ts, tf, xs, xf
+/// static_assert( HOMING.is_generated(), "homing is reachable" );
+/// ```
+class Trapezoid5251525Profile : public TrajectoryBase<Trapezoid5251525Profile> {
+  // 計画結果の取り込みと例外の送出
+  friend class Trapezoid5251525;
+public:
+  /// コンストラクタ
+  /// @param[in] a_limit 第一加速(減速)度上限値
+  /// @param[in] d_limit 第二加速(減速)度上限値
+  /// @param[in] v_limit 最大速度リミット
+  /// @param[in] asr 第一丸め率 (default : 0.0)
+  /// @param[in] dsr 第二丸め率 (default : 0.0)
+  /// @param[in] ratio_acc_dec 第一＆第二加速度上限値に対する下限値の比率 (default : 1.0)
+  SPLINE_CONSTEXPR14 Trapezoid5251525Profile( const double& a_limit=1200,
+                                              const double& d_limit=1200,
+                                              const double& v_limit=170,
+                                              const double& asr=0.0,
+                                              const double& dsr=0.0,
+                                              const double& ratio_acc_dec=1.0 ) :
+    a_limit_(a_limit), d_limit_(d_limit), v_limit_(v_limit),
+    asr_(asr), dsr_(dsr), ratio_acc_dec_(ratio_acc_dec),
+    a_lower_limit_(a_limit * ratio_acc_dec), d_lower_limit_(d_limit * ratio_acc_dec),
+    t0_(0.0), tf_(0.0), x0_(0.0), xf_(0.0), v0_(0.0), vf_(0.0),
+    sign_(1.0), signA_(1.0), signD_(1.0),
+    a_max_(0.0), d_max_(0.0), v_max_(0.0), xd_(0.0),
+    v_max_fastest_(0.0), dT3_fastest_(0.0), tf_fastest_(0.0),
+    dT1_(0.0), dT2_(0.0), dT3_(0.0), dT4_(0.0), dT5_(0.0), dT_total_(0.0),
+    t1_(0.0), t2_(0.0), t3_(0.0), t4_(0.0), t5_(0.0), t6_(0.0), t7_(0.0),
+    x1_(0.0), x2_(0.0), x3_(0.0), x4_(0.0), x5_(0.0), x6_(0.0),
+    v1_(0.0), v2_(0.0), v3_(0.0), v4_(0.0), v5_(0.0), v6_(0.0),
+    is_fastest_(false), no_movement_(false), is_generated_(false), failed_step_(-1) {
+  }
+
+  /// 軌道の計画 (Trapezoid5251525::generate_path() と同じ計算)
+  /// @param[in] ts 開始時刻
+  /// @param[in] tf 終了時刻 (0.0 : 最速軌道)
+  /// @param[in] xs 開始位置
+  /// @param[in] xf 終了位置
+  /// @param[in] vs 開始速度 (default: 0.0)
+  /// @param[in] vf 終了速度 (default: 0.0)
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_INVALID_INPUT_TIME : 開始・終了時刻が負, 逆順, もしくは移動時間が DT_MAX_LIMIT を超える
+  /// - SPLINE_FAIL_TO_GENERATE_PATH : 構成パラメータ・開始終了速度が範囲外, もしくは到達不可能
+  SPLINE_CONSTEXPR14 RetCode generate_path( const double& ts, const double& tf,
+                                            const double& xs, const double& xf,
+                                            const double& vs=0.0, const double& vf=0.0 ) {
+    is_generated_ = false;
+    no_movement_  = false;
+    is_fastest_   = false;
+    failed_step_  = 0;
+    t0_ = ts;
+    tf_ = tf;
+    x0_ = xs;
+    xf_ = xf;
+    v0_ = vs;
+    vf_ = vf;
+
+    // 0. 入力チェック
+    const RetCode input_retcode = input_check();
+    if( input_retcode != SPLINE_SUCCESS ) {
+      return input_retcode;
+    }
+    // 移動なしならば終了時刻のみ設定
+    if( no_movement_ ) {
+      t7_ = tf_;
+      failed_step_  = -1;
+      is_generated_ = true;
+      return SPLINE_SUCCESS;
+    }
+
+    // 1. 最大速度方向の初期設定
+    const double sign_init = calc_initial_v_max_direction_sign();
+
+    // 2. 加速度上限値による、最速軌道の最大速度と最短時間の算出
+    failed_step_ = 2;
+    if( !calc_fastest_parameter( a_limit_, d_limit_ ) ) {
+      return SPLINE_FAIL_TO_GENERATE_PATH;
+    }
+    a_max_ = a_limit_;
+    d_max_ = d_limit_;
+
+    // 3. 到達限界・速度反転領域の判定
+    judge_reach_limitation();
+    signA_ = sign_;
+    signD_ = sign_;
+    // 最速軌道の最大速度方向が反転していた場合は再計算
+    if( sign_ != sign_init ) {
+      if( !calc_fastest_parameter( a_limit_, d_limit_ ) ) {
+        return SPLINE_FAIL_TO_GENERATE_PATH;
+      }
+    }
+
+    // 最短時間に対する目標移動時間の比率による加速度で再計算
+    calc_acceleration_with_ratio();
+    if( !calc_fastest_parameter( a_max_, d_max_ ) ) {
+      return SPLINE_FAIL_TO_GENERATE_PATH;
+    }
+    judge_reach_limitation();
+    signA_ = sign_;
+    signD_ = sign_;
+
+    // 4. 移動距離の再計算
+    xd_ = xf_ - x0_;
+
+    // 5. 最大速度v_maxと等速移動時間dT3の算出
+    failed_step_ = 5;
+    if( !calc_v_max_and_dT3() ) {
+      return SPLINE_FAIL_TO_GENERATE_PATH;
+    }
+
+    // 6. 軌道パラメータを算出する
+    set_parameter();
+    failed_step_  = -1;
+    is_generated_ = true;
+    return SPLINE_SUCCESS;
+  }
+
+  /// 時刻tにおける位置・速度・加速度の出力 (Trapezoid5251525::pop() と同じ計算)
+  /// @param[in]  t  時刻
+  /// @param[out] xt 位置
+  /// @param[out] vt 速度
+  /// @param[out] at 加速度
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_SEGMENT_NOT_GENERATED : 軌道未生成
+  /// - SPLINE_INVALID_INPUT_TIME : 時刻が開始時刻から終了時刻の範囲外
+  SPLINE_CONSTEXPR14 RetCode evaluate( const double& t,
+                                       double& xt, double& vt, double& at ) const {
+    return evaluate<OUTPUT_PVA>( t, xt, vt, at );
+  }
+
+  /// 時刻tにおける選択した出力のみの出力 (Trapezoid5251525::pop<Mask>() と同じ計算)
+  /// @tparam Mask OutputMask の組合せ
+  /// @param[in]  t  時刻
+  /// @param[out] xt 位置 (Mask に OUTPUT_POS があれば出力)
+  /// @param[out] vt 速度 (Mask に OUTPUT_VEL があれば出力)
+  /// @param[out] at 加速度 (Mask に OUTPUT_ACC があれば出力)
+  /// @return evaluate() と同じ
+  template<unsigned int Mask>
+  SPLINE_CONSTEXPR14 RetCode evaluate( const double& t,
+                                       double& xt, double& vt, double& at ) const {
+    if( !is_generated_ ) {
+      return SPLINE_SEGMENT_NOT_GENERATED;
+    }
+    if( no_movement_ ) {
+      if( Mask & OUTPUT_POS ) {
+        xt = x0_;
+      }
+      if( Mask & OUTPUT_VEL ) {
+        vt = v0_;
+      }
+      if( Mask & OUTPUT_ACC ) {
+        at = 0.0;
+      }
+      return SPLINE_SUCCESS;
+    }
+
+    if( t0_ <= t && t < t1_ ) {
+      // Step1
+      g_trapezoid5251525_step<Mask>( TRAPZD_ROUND_IN, t - t0_, signA_ * a_max_, dT1_,
+                                     v0_, x0_, xt, vt, at );
+
+    } else if( t1_ <= t && t < t2_ ) {
+      // Step2
+      g_trapezoid5251525_step<Mask>( TRAPZD_CONSTANT, t - t1_, signA_ * a_max_, dT1_,
+                                     v1_, x1_, xt, vt, at );
+
+    } else if( t2_ <= t && t < t3_ ) {
+      // Step3
+      g_trapezoid5251525_step<Mask>( TRAPZD_ROUND_OUT, t - t2_, signA_ * a_max_, dT1_,
+                                     v2_, x2_, xt, vt, at );
+
+    } else if( t3_ <= t && t < t4_ ) {
+      // Step4
+      g_trapezoid5251525_step<Mask>( TRAPZD_CONSTANT, t - t3_, 0.0, dT1_,
+                                     v_max_, x3_, xt, vt, at );
+
+    } else if( t4_ <= t && t < t5_ ) {
+      // Step5
+      g_trapezoid5251525_step<Mask>( TRAPZD_ROUND_IN, t - t4_, -signD_ * d_max_, dT4_,
+                                     v_max_, x4_, xt, vt, at );
+
+    } else if( ( t5_ <= t && t < t6_ )
+               || ( dT4_ <= 0.0 && t5_ <= t && t <= t7_ + t_epsilon() ) ) {
+      // Step6 (丸め率0ではStep7の区間長が0となるため, 終端もStep6の式で出力)
+      g_trapezoid5251525_step<Mask>( TRAPZD_CONSTANT, t - t5_, -signD_ * d_max_, dT4_,
+                                     v5_, x5_, xt, vt, at );
+
+    } else if( t6_ <= t && t <= t7_ + t_epsilon() ) {
+      // Step7
+      g_trapezoid5251525_step<Mask>( TRAPZD_ROUND_OUT, t - t6_, -signD_ * d_max_, dT4_,
+                                     v6_, x6_, xt, vt, at );
+
+    } else {
+      return SPLINE_INVALID_INPUT_TIME;
+    }
+    return SPLINE_SUCCESS;
+  }
+
+  /// 軌道生成済みかどうか
+  /// @return true : 生成済み
+  SPLINE_CONSTEXPR14 const bool is_generated() const { return is_generated_; }
+
+  /// 移動なし軌道かどうか
+  /// @return true : 移動なし
+  SPLINE_CONSTEXPR14 const bool no_movement() const { return no_movement_; }
+
+  /// 最速軌道かどうか
+  /// @return true : 最速軌道
+  SPLINE_CONSTEXPR14 const bool is_fastest() const { return is_fastest_; }
+
+  /// 開始時刻
+  /// @return 開始時刻
+  SPLINE_CONSTEXPR14 const double t0() const { return t0_; }
+
+  /// 開始時刻 (TrajectoryBase の要求)
+  /// @return 開始時刻
+  SPLINE_CONSTEXPR14 const double start_time() const { return t0_; }
+
+  /// 最終到達時刻 (Trapezoid5251525::finish_time() と同じ)
+  /// @return 最終到達時刻
+  SPLINE_CONSTEXPR14 const double finish_time() const { return t7_; }
+
+  /// 移動時間
+  /// @return 移動時間 (移動なし軌道では 0.0)
+  SPLINE_CONSTEXPR14 const double dT_total() const { return dT_total_; }
+
+  /// 最大速度
+  /// @return 最大速度
+  SPLINE_CONSTEXPR14 const double v_max() const { return v_max_; }
+
+  /// 第一加速(減速)度
+  /// @return 第一加速(減速)度
+  SPLINE_CONSTEXPR14 const double a_max() const { return a_max_; }
+
+  /// 第二加速(減速)度
+  /// @return 第二加速(減速)度
+  SPLINE_CONSTEXPR14 const double d_max() const { return d_max_; }
+
+private:
+  /// 時刻の許容誤差
+  static SPLINE_CONSTEXPR14 double t_epsilon() { return 1.0e-12; }
+
+  /// 位置の許容誤差
+  static SPLINE_CONSTEXPR14 double x_epsilon() { return 1.0e-9; }
+
+  /// 速度の許容誤差
+  static SPLINE_CONSTEXPR14 double v_epsilon() { return 1.0e-15; }
+
+  /// 移動時間の最大閾値 (Trapezoid5251525::DT_MAX_LIMIT_ と同じ)
+  static SPLINE_CONSTEXPR14 double dt_max_limit() { return 900.0; }
+
+  /// 値の符号
+  /// @param[in] value 値
+  /// @return 1.0 : value >= 0.0, -1.0 : value < 0.0
+  static SPLINE_CONSTEXPR14 double sign_of( const double& value ) {
+    return ( value >= 0.0 ) ? 1.0 : -1.0;
+  }
+
+  /// 0. 入力チェック
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_INVALID_INPUT_TIME
+  /// - SPLINE_FAIL_TO_GENERATE_PATH
+  SPLINE_CONSTEXPR14 RetCode input_check() {
+    if( v_limit_ <= 0.0 || a_limit_ <= 0.0 || d_limit_ <= 0.0
+        || ratio_acc_dec_ < 0.0 || 1.0 < ratio_acc_dec_ ) {
+      // 構成パラメータが範囲外
+      return SPLINE_FAIL_TO_GENERATE_PATH;
+    }
+    if( t0_ < 0.0 || tf_ < 0.0 ) {
+      // 開始時刻もしくは終了時刻が負
+      return SPLINE_INVALID_INPUT_TIME;
+    }
+    if( tf_ != 0.0 && t0_ > tf_ ) {
+      // 開始時刻が終端時刻を超えている
+      return SPLINE_INVALID_INPUT_TIME;
+    }
+    if( g_constexpr_fabs( v0_ ) > v_limit_ || g_constexpr_fabs( vf_ ) > v_limit_ ) {
+      // 初期速度、終端速度が速度リミットを超えている
+      return SPLINE_FAIL_TO_GENERATE_PATH;
+    }
+    // 開始と終了地点が同じでかつ開始と終了の速度0.0ならば移動なし
+    if( g_constexpr_fabs( x0_ - xf_ ) <= x_epsilon()
+        && g_constexpr_fabs( v0_ ) <= v_epsilon()
+        && g_constexpr_fabs( vf_ ) <= v_epsilon() ) {
+      no_movement_ = true;
+    }
+    if( ( tf_ - t0_ ) > dt_max_limit() ) {
+      // 指定移動時間が最大閾値を超えている
+      return SPLINE_INVALID_INPUT_TIME;
+    }
+    // 終了時刻が0.0の場合、最速軌道
+    if( tf_ == 0.0 ) {
+      is_fastest_ = true;
+    }
+    return SPLINE_SUCCESS;
+  }
+
+  /// 1. 最大速度方向の初期設定
+  /// @return 最大速度方向の符号
+  SPLINE_CONSTEXPR14 double calc_initial_v_max_direction_sign() {
+    sign_ = ( xf_ - x0_ > 0 ) ? 1.0 : -1.0;
+    // 位置が同じ場合,
+    if( g_constexpr_fabs( x0_ - xf_ ) <= x_epsilon() ) {
+      sign_ = ( g_constexpr_fabs( v0_ ) < g_constexpr_fabs( vf_ ) ) ? sign_of( vf_ ) : sign_of( v0_ );
+    }
+    return sign_;
+  }
+
+  /// 2. 最速軌道の最大速度と最短時間の算出
+  /// @param[in] a_max 第一加速(減速)度
+  /// @param[in] d_max 第二加速(減速)度
+  /// @return false : 終了時刻が最短時間より前 (到達不可能)
+  SPLINE_CONSTEXPR14 bool calc_fastest_parameter( const double& a_max, const double& d_max ) {
+    // 移動距離
+    xd_ = sign_ * ( xf_ - x0_ );
+
+    // 三角形軌道の最高速度を算出
+    const double p1 = a_max * ( 1 + asr_ );
+    const double p2 = d_max * ( 1 + dsr_ );
+    const double p3 = ( p1 * v0_ * v0_ + p2 * vf_ * vf_ + 2 * a_max * d_max * xd_ ) / ( p1 + p2 );
+    v_max_fastest_ = sign_ * g_constexpr_sqrt( g_constexpr_fabs( p3 ) );
+    // 境界台形
+    const double xd_limit =
+      0.5 * ( 1 + asr_ ) * ( v_limit_ * v_limit_ - v0_ * v0_ ) / a_max
+      +
+      0.5 * ( 1 + dsr_ ) * ( v_limit_ * v_limit_ - vf_ * vf_ ) / d_max;
+
+    // 最速軌道が台形か三角形かチェック
+    if( g_constexpr_fabs( v_max_fastest_ ) > v_limit_ ) {
+      // 台形
+      v_max_fastest_ = sign_ * v_limit_;
+      dT3_fastest_   = g_constexpr_fabs( ( xd_limit - xd_ ) / v_limit_ );
+    } else {
+      // 三角形
+      dT3_fastest_ = 0.0;
+    }
+
+    const double dT1_fastest = asr_ * g_constexpr_fabs( v_max_fastest_ - v0_ ) / a_max;
+    const double dT2_fastest = ( 1 - asr_ ) * g_constexpr_fabs( v_max_fastest_ - v0_ ) / a_max;
+    const double dT4_fastest = dsr_ * g_constexpr_fabs( v_max_fastest_ - vf_ ) / d_max;
+    const double dT5_fastest = ( 1 - dsr_ ) * g_constexpr_fabs( v_max_fastest_ - vf_ ) / d_max;
+    tf_fastest_ = t0_ + 2 * dT1_fastest + dT2_fastest + dT3_fastest_ + 2 * dT4_fastest + dT5_fastest;
+
+    // tf_の時刻がtf_fastest_とほぼ同じ場合、最速軌道動作とする
+    if( ( is_fastest_ )
+        || ( ( tf_ - tf_fastest_ >= 0.0 ) && ( tf_ - tf_fastest_ <= t_epsilon() ) )
+        || ( g_constexpr_fabs( tf_ - tf_fastest_ ) <= x_epsilon() ) ) {
+      tf_    = ( tf_ < tf_fastest_ ) ? tf_fastest_ : tf_;
+      v_max_ = v_max_fastest_;
+      dT3_   = dT3_fastest_;
+      is_fastest_ = true;
+    } else if( tf_ < tf_fastest_ ) {
+      // 到達不可能
+      return false;
+    }
+    return true;
+  }
+
+  /// 3. 到達限界・速度反転領域の判定
+  SPLINE_CONSTEXPR14 void judge_reach_limitation() {
+    // 到達不能領域L1識別子：v_step2_square_x_eq_xfの算出
+    const double v_max_L1 = v_max_fastest_;
+    const double dT1_L1   = asr_ * g_constexpr_fabs( v_max_L1 - v0_ ) / a_max_;
+    const double x1_L1    = 0.15 * sign_ * a_max_ * dT1_L1 * dT1_L1 + v0_ * dT1_L1 + x0_;
+    const double v1_L1    = 0.50 * sign_ * a_max_ * dT1_L1 + v0_;
+    const double v_step2_square_x_eq_xf
+      = g_constexpr_fabs( sign_ * 2.0 * a_max_ * ( xf_ - x1_L1 ) + v1_L1 * v1_L1 );
+
+    // 到達不能領域L2識別子：x_step6_x_eq_0,
+    // 到達不能領域L3識別子：v_step6_square_x_eq_xfの算出
+    const double v_max_L2L3 = v0_;
+    const double xf_L2L3    = x0_;
+    const double vf_L2L3    = (-1.0) * v0_;
+    double sign_L2L3 = ( v0_ >= 0.0 ) ? 1.0 : -1.0;
+    if( v0_ == 0.0 ) {
+      sign_L2L3 = ( vf_ >= 0.0 ) ? -1.0 : 1.0;
+    }
+    const double dT4_L2L3 = dsr_ * g_constexpr_fabs( v_max_L2L3 - vf_L2L3 ) / d_max_;
+    const double dT5_L2L3 = ( 1 - dsr_ ) * g_constexpr_fabs( v_max_L2L3 - vf_L2L3 ) / d_max_;
+    const double v6_L2L3  = vf_L2L3 + 0.50 * sign_L2L3 * d_max_ * dT4_L2L3;
+    const double x6_L2L3  = xf_L2L3 + 0.35 * sign_L2L3 * d_max_ * dT4_L2L3 * dT4_L2L3
+                            - v6_L2L3 * dT4_L2L3;
+    const double v5_L2L3  = v6_L2L3 + sign_L2L3 * d_max_ * dT5_L2L3;
+    const double x5_L2L3  = x6_L2L3 + 0.50 * sign_L2L3 * d_max_ * dT5_L2L3 * dT5_L2L3
+                            - v5_L2L3 * dT5_L2L3;
+    const double x_step6_v_eq_0
+      = g_constexpr_fabs( 0.50 * sign_L2L3 * v5_L2L3 * v5_L2L3 / d_max_ + x5_L2L3 );
+    const double v_step6_square_x_eq_xf = 2.0 * sign_L2L3 * d_max_ * ( x5_L2L3 - xf_ )
+                                          + v5_L2L3 * v5_L2L3;
+
+    // 判定
+    if( v0_ * vf_ >= 0.0
+        && ( vf_ * vf_ >= v_step2_square_x_eq_xf
+             || ( v_step2_square_x_eq_xf > v_max_L1 * v_max_L1
+                  && g_constexpr_fabs( vf_ ) >= g_constexpr_fabs( v_max_L1 ) ) )
+        && sign_ * vf_ >= 0 ) {
+      // 到達不能領域L1 : 速度を反転する
+      sign_ = (-1) * sign_;
+
+    } else if( v0_ * vf_ <= 0.0
+               && ( vf_ * vf_ >= v_step6_square_x_eq_xf )
+               && ( g_constexpr_fabs( vf_ ) > g_constexpr_fabs( v0_ ) )
+               && sign_ * vf_ >= 0.0 ) {
+      // 到達不能領域L4 : 速度を反転する
+      sign_ = (-1) * sign_;
+
+    } else if( v0_ != 0.0
+               && sign_of( v0_ ) * ( ( xf_ - x0_ > 0 ) ? 1 : ( ( xf_ - x0_ == 0 ) ? 0 : -1 ) ) >= 0
+               && vf_ * vf_ <= v_step6_square_x_eq_xf
+               && xd_ <= g_constexpr_fabs( x_step6_v_eq_0 - x0_ ) ) {
+      // 到達不能領域L2,L3 : 速度を反転する
+      sign_ = (-1) * sign_;
+    }
+  }
+
+  /// 加速度を、最短時間に対する目標移動時間の比率により、上限値と下限値の内分をとって算出
+  SPLINE_CONSTEXPR14 void calc_acceleration_with_ratio() {
+    if( tf_ - t0_ == 0.0 ) {
+      a_max_ = a_lower_limit_;
+      d_max_ = d_lower_limit_;
+      return;
+    }
+    const double dt_ratio = ( tf_fastest_ - t0_ ) / ( tf_ - t0_ );
+    a_max_ = a_limit_ * dt_ratio * dt_ratio + a_lower_limit_ * ( 1.0 - dt_ratio * dt_ratio );
+    d_max_ = d_limit_ * dt_ratio * dt_ratio + d_lower_limit_ * ( 1.0 - dt_ratio * dt_ratio );
+  }
+
+  /// 5. 加減速方向の組に対する最大速度と等速移動時間の算出
+  /// @param[in]  signA 加速側の方向
+  /// @param[in]  signD 減速側の方向
+  /// @param[out] dT3   等速移動時間
+  /// @param[out] ret   false : 解なし
+  /// @return 最大速度
+  SPLINE_CONSTEXPR14 double internal_calc_v_max_and_dT3( const double& signA,
+                                                         const double& signD,
+                                                         double& dT3, bool& ret ) const {
+    const double pA = signA * 0.5 * ( 1.0 + asr_ ) / a_max_
+                    + signD * 0.5 * ( 1.0 + dsr_ ) / d_max_;
+    const double pB = tf_ - t0_ + signA * ( 1.0 + asr_ ) * v0_ / a_max_
+                                + signD * ( 1.0 + dsr_ ) * vf_ / d_max_;
+    const double pC = xd_ + signA * 0.5 * ( 1.0 + asr_ ) * v0_ * v0_ / a_max_
+                          + signD * 0.5 * ( 1.0 + dsr_ ) * vf_ * vf_ / d_max_;
+    const double pD = pB * pB - 4.0 * pA * pC;
+    double v_max = 0.0;
+    double xd = xd_;
+    ret = true;
+    if( g_constexpr_fabs( pA ) < v_epsilon() && g_constexpr_fabs( pB ) > v_epsilon() ) {
+      // pA==0 && pB!=0
+      v_max = pC / pB;
+      dT3 = ( tf_ - t0_ ) - signA * ( 1.0 + asr_ ) * ( v_max - v0_ ) / a_max_
+                          - signD * ( 1.0 + dsr_ ) * ( v_max - vf_ ) / d_max_;
+    } else if( pD < 0.0 ) {
+      if( !is_fastest_ ) {
+        // ２次方程式の判別式が0未満で最速軌道でなければ解なし
+        ret = false;
+      }
+      v_max = v_max_fastest_;
+      dT3   = dT3_fastest_;
+    } else {
+      v_max = 0.5 * ( pB - g_constexpr_sqrt( pD ) ) / pA;
+      dT3 = tf_ - t0_ - signA * ( 1.0 + asr_ ) * ( v_max - v0_ ) / a_max_
+                      - signD * ( 1.0 + dsr_ ) * ( v_max - vf_ ) / d_max_;
+      if( is_fastest_
+          && ( g_constexpr_fabs( v_max ) > g_constexpr_fabs( v_max_fastest_ ) ) ) {
+        v_max = v_max_fastest_;
+        dT3   = dT3_fastest_;
+      }
+      xd = signA * 0.5 * ( 1.0 + asr_ ) * ( v_max * v_max - v0_ * v0_ ) / a_max_
+         + signD * 0.5 * ( 1.0 + dsr_ ) * ( v_max * v_max - vf_ * vf_ ) / d_max_ + v_max * dT3;
+    }
+
+    // v_maxとv0_の大小関係, v_maxとvfの大小関係のパターンに当てはまらなければ解なし
+    if( sign_ * v_max <= -1.0 * v_epsilon()
+        || signA * ( v_max - v0_ ) < 0.0
+        || signD * ( v_max - vf_ ) < 0.0
+        || g_constexpr_fabs( xd - xd_ ) > x_epsilon()
+        || dT3 < 0.0 ) {
+      ret = false;
+    }
+    return v_max;
+  }
+
+  /// 5. 最大速度v_maxと等速移動時間dT3の算出
+  /// @return false : 解なし, もしくは最大速度が速度リミットを超える
+  SPLINE_CONSTEXPR14 bool calc_v_max_and_dT3() {
+    bool ret = false;
+    // 最大速度方向を反転しない組, 反転した組の順に加減速方向を探索
+    for( int flip = 0; flip < 2 && !ret; flip++ ) {
+      if( flip == 1 ) {
+        sign_ = (-1) * sign_;
+      }
+      for( int pattern = 0; pattern < 4 && !ret; pattern++ ) {
+        signA_ = ( pattern == 1 || pattern == 3 ) ? (-1) * sign_ : sign_;
+        signD_ = ( pattern >= 2 ) ? (-1) * sign_ : sign_;
+        v_max_ = internal_calc_v_max_and_dT3( signA_, signD_, dT3_, ret );
+      }
+    }
+    if( !ret ) {
+      return false;
+    }
+    if( g_constexpr_fabs( v_max_ ) > g_constexpr_fabs( v_limit_ ) + v_epsilon() ) {
+      return false;
+    }
+    return true;
+  }
+
+  /// 6. 軌道パラメータを算出する
+  SPLINE_CONSTEXPR14 void set_parameter() {
+    dT1_ = asr_ * g_constexpr_fabs( v_max_ - v0_ ) / a_max_;
+    dT2_ = ( 1 - asr_ ) * g_constexpr_fabs( v_max_ - v0_ ) / a_max_;
+    dT4_ = dsr_ * g_constexpr_fabs( v_max_ - vf_ ) / d_max_;
+    dT5_ = ( 1 - dsr_ ) * g_constexpr_fabs( v_max_ - vf_ ) / d_max_;
+
+    v1_ = signA_ * 0.50 * a_max_ * dT1_ + v0_;
+    x1_ = signA_ * 0.15 * a_max_ * dT1_ * dT1_ + v0_ * dT1_ + x0_;
+    v2_ = signA_ * a_max_ * dT2_ + v1_;
+    x2_ = signA_ * 0.50 * a_max_ * dT2_ * dT2_ + v1_ * dT2_ + x1_;
+    v3_ = signA_ * 0.50 * a_max_ * dT1_ + v2_;
+    x3_ = signA_ * 0.35 * a_max_ * dT1_ * dT1_ + v2_ * dT1_ + x2_;
+
+    v6_ = vf_ + signD_ * 0.50 * d_max_ * dT4_;
+    x6_ = xf_ + signD_ * 0.35 * d_max_ * dT4_ * dT4_ - v6_ * dT4_;
+    v5_ = v6_ + signD_ * d_max_ * dT5_;
+    x5_ = x6_ + signD_ * 0.50 * d_max_ * dT5_ * dT5_ - v5_ * dT5_;
+    v4_ = v_max_;
+    x4_ = x5_ + signD_ * 0.15 * d_max_ * dT4_ * dT4_ - v_max_ * dT4_;
+
+    t1_ = t0_ + dT1_;
+    t2_ = t1_ + dT2_;
+    t3_ = t2_ + dT1_;
+    t4_ = t3_ + dT3_;
+    t5_ = t4_ + dT4_;
+    t6_ = t5_ + dT5_;
+    t7_ = t6_ + dT4_;
+    dT_total_ = 2 * dT1_ + dT2_ + dT3_ + 2 * dT4_ + dT5_;
+  }
+
+  /// 第一加速(減速)度上限値
+  double a_limit_;
+  /// 第二加速(減速)度上限値
+  double d_limit_;
+  /// 最大速度リミット
+  double v_limit_;
+  /// 第一丸め率
+  double asr_;
+  /// 第二丸め率
+  double dsr_;
+  /// 第一＆第二加速度上限値に対する下限値の比率
+  double ratio_acc_dec_;
+  /// 第一加速(減速)度下限値
+  double a_lower_limit_;
+  /// 第二加速(減速)度下限値
+  double d_lower_limit_;
+
+  /// 開始時刻
+  double t0_;
+  /// 終了時刻
+  double tf_;
+  /// 開始位置
+  double x0_;
+  /// 終了位置
+  double xf_;
+  /// 開始速度
+  double v0_;
+  /// 終了速度
+  double vf_;
+
+  /// 最大速度方向の符号
+  double sign_;
+  /// 加速側の方向
+  double signA_;
+  /// 減速側の方向
+  double signD_;
+  /// 第一加速(減速)度
+  double a_max_;
+  /// 第二加速(減速)度
+  double d_max_;
+  /// 最大速度
+  double v_max_;
+  /// 移動距離
+  double xd_;
+  /// 最速軌道の最大速度
+  double v_max_fastest_;
+  /// 最速軌道の等速移動時間
+  double dT3_fastest_;
+  /// 最速軌道の終了時刻
+  double tf_fastest_;
+
+  /// 各区間の時間
+  double dT1_, dT2_, dT3_, dT4_, dT5_;
+  /// 移動時間
+  double dT_total_;
+  /// 各区間の終了時刻
+  double t1_, t2_, t3_, t4_, t5_, t6_, t7_;
+  /// 各区間の終了位置
+  double x1_, x2_, x3_, x4_, x5_, x6_;
+  /// 各区間の終了速度
+  double v1_, v2_, v3_, v4_, v5_, v6_;
+
+  /// 最速軌道フラグ
+  bool is_fastest_;
+  /// 移動なしフラグ
+  bool no_movement_;
+  /// 軌道生成完了フラグ
+  bool is_generated_;
+  /// 計画失敗した手順 (0 : 入力チェック, 2 : 最速軌道, 5 : 最大速度の算出, -1 : 失敗なし)
+  int failed_step_;
+};
+
+/// 台形型5251525次軌道のプロファイルの計画
+/// @param[in] a_limit 第一加速(減速)度上限値
+/// @param[in] d_limit 第二加速(減速)度上限値
+/// @param[in] v_limit 最大速度リミット
+/// @param[in] asr 第一丸め率
+/// @param[in] dsr 第二丸め率
+/// @param[in] ratio_acc_dec 第一＆第二加速度上限値に対する下限値の比率
+/// @param[in] ts 開始時刻
+/// @param[in] tf 終了時刻 (0.0 : 最速軌道)
+/// @param[in] xs 開始位置
+/// @param[in] xf 終了位置
+/// @param[in] vs 開始速度 (default: 0.0)
+/// @param[in] vf 終了速度 (default: 0.0)
+/// @return 計画したプロファイル (計画失敗時は is_generated() が false)
+inline SPLINE_CONSTEXPR14 Trapezoid5251525Profile
+g_plan_trapezoid5251525( const double& a_limit, const double& d_limit, const double& v_limit,
+                         const double& asr, const double& dsr, const double& ratio_acc_dec,
+                         const double& ts, const double& tf,
+                         const double& xs, const double& xf,
+                         const double& vs=0.0, const double& vf=0.0 ) {
+  Trapezoid5251525Profile profile( a_limit, d_limit, v_limit, asr, dsr, ratio_acc_dec );
+  profile.generate_path( ts, tf, xs, xf, vs, vf );
+  return profile;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+/// 台形型5251525次軌道の等時間間隔のサンプル表
+/// @tparam S サンプル数 (>= 2)
+/// @details
+/// 開始時刻から最終到達時刻までを S-1 等分した時刻の位置・速度・加速度. \n
+/// C++14 (SPLINE_CXX14) 以降は g_bake_trapezoid5251525() でコンパイル時に作成でき,
+/// constexpr 変数とすれば読み込み専用領域に配置される.
+///
+/// ```
+/// constexpr Trapezoid5251525Table<1001> HOMING_TABLE = g_bake_trapezoid5251525<1001>( HOMING );
+/// ```
+template<std::size_t S>
+class Trapezoid5251525Table {
+public:
+  /// コンストラクタ
+  SPLINE_CONSTEXPR14 Trapezoid5251525Table() :
+    time_(), pos_(), vel_(), acc_(), status_(SPLINE_SEGMENT_NOT_GENERATED) {
+    // S < 2 ならコンパイルエラー
+    typedef char size_must_be_2_or_more[ ( S >= 2 ) ? 1 : -1 ];
+    (void)sizeof( size_must_be_2_or_more );
+  }
+
+  /// プロファイルのサンプル表の作成
+  /// @param[in] profile 計画済みプロファイル
+  /// @return
+  /// - SPLINE_SUCCESS
+  /// - SPLINE_SEGMENT_NOT_GENERATED : プロファイルが未生成
+  SPLINE_CONSTEXPR14 RetCode bake( const Trapezoid5251525Profile& profile ) {
+    status_ = SPLINE_SEGMENT_NOT_GENERATED;
+    if( !profile.is_generated() ) {
+      return status_;
+    }
+    const double t0 = profile.t0();
+    const double dt = ( profile.finish_time() - t0 ) / static_cast<double>( S - 1 );
+    for( std::size_t i=0; i < S; i++ ) {
+      time_[i] = ( i == S-1 ) ? profile.finish_time() : t0 + dt * static_cast<double>( i );
+      const RetCode retcode = profile.evaluate( time_[i], pos_[i], vel_[i], acc_[i] );
+      if( retcode != SPLINE_SUCCESS ) {
+        status_ = retcode;
+        return status_;
+      }
+    }
+    status_ = SPLINE_SUCCESS;
+    return status_;
+  }
+
+  /// サンプル数
+  /// @return S
+  SPLINE_CONSTEXPR14 const std::size_t size() const { return S; }
+
+  /// 作成結果
+  /// @return bake() の戻り値 (未作成では SPLINE_SEGMENT_NOT_GENERATED)
+  SPLINE_CONSTEXPR14 const RetCode status() const { return status_; }
+
+  /// サンプル時刻
+  /// @param[in] index サンプル番号
+  /// @return 時刻
+  SPLINE_CONSTEXPR14 const double time( const std::size_t& index ) const { return time_[index]; }
+
+  /// サンプル位置
+  /// @param[in] index サンプル番号
+  /// @return 位置
+  SPLINE_CONSTEXPR14 const double pos( const std::size_t& index ) const { return pos_[index]; }
+
+  /// サンプル速度
+  /// @param[in] index サンプル番号
+  /// @return 速度
+  SPLINE_CONSTEXPR14 const double vel( const std::size_t& index ) const { return vel_[index]; }
+
+  /// サンプル加速度
+  /// @param[in] index サンプル番号
+  /// @return 加速度
+  SPLINE_CONSTEXPR14 const double acc( const std::size_t& index ) const { return acc_[index]; }
+
+private:
+  /// サンプル時刻
+  double time_[S];
+  /// サンプル位置
+  double pos_[S];
+  /// サンプル速度
+  double vel_[S];
+  /// サンプル加速度
+  double acc_[S];
+  /// 作成結果
+  RetCode status_;
+};
+
+/// 台形型5251525次軌道のサンプル表の作成
+/// @tparam S サンプル数 (>= 2)
+/// @param[in] profile 計画済みプロファイル
+/// @return サンプル表 (失敗時は status() が SPLINE_SUCCESS 以外)
+template<std::size_t S>
+inline SPLINE_CONSTEXPR14 Trapezoid5251525Table<S>
+g_bake_trapezoid5251525( const Trapezoid5251525Profile& profile ) {
+  Trapezoid5251525Table<S> table;
+  table.bake( profile );
+  return table;
+}
+
+} // End of namespace interp
+
+#endif // INCLUDE_TRAPEZOID_5251525_PROFILE_HPP_
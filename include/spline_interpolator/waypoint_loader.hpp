@@ -0,0 +1,172 @@
+#ifndef INCLUDE_WAYPOINT_LOADER_HPP_
+#define INCLUDE_WAYPOINT_LOADER_HPP_
+
+#include <string>
+#include <vector>
+#include <cstddef> // for size_t
+
+#include "spline_data.hpp"
+
+namespace interp {
+
+/// Loader of waypoint table (CSV or whitespace separated numbers)
+/// @details
+/// - Fields are separated by ',' or spaces/tabs. "\r\n" line ends are accepted.
+/// - Empty lines and lines beginning with '#' are skipped.
+/// - All rows must have the same number of columns.
+///
+/// The file is read into memory at once and numbers are parsed without locale
+/// (the decimal point is always '.'). \n
+/// Queues are built at once by TimeQueue::assign() after the whole table is parsed
+/// (times are validated only once there),
+/// and errors are reported with the line number of the file by error_line().
+class WaypointLoader {
+public:
+  /// Constructor
+  WaypointLoader();
+
+  /// Destructor
+  ~WaypointLoader();
+
+  /// load the table from the file
+  /// @param[in] path source file path
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_FILE_IO_ERROR: cannot open or read the file
+  /// - SPLINE_INVALID_FILE_FORMAT: invalid number or column size (see error_line())
+  RetCode load_file( const std::string& path );
+
+  /// load the table from the string
+  /// @param[in] text source text
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_FILE_FORMAT: invalid number or column size (see error_line())
+  RetCode load_string( const std::string& text );
+
+  /// get the number of rows
+  /// @return the number of rows
+  const std::size_t row_size() const;
+
+  /// get the number of columns
+  /// @return the number of columns (0 if no row)
+  const std::size_t column_size() const;
+
+  /// get the value
+  /// @param[in] row    the index of row
+  /// @param[in] column the index of column
+  /// @return the value
+  /// @exception InvalidIndexAccess If invalid row or column is accessed.
+  const double value( const std::size_t& row, const std::size_t& column ) const
+    SPLINE_THROW_SPEC(InvalidIndexAccess);
+
+  /// get the values of the column
+  /// @param[in]  column the index of column
+  /// @param[out] values the values of all rows
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_INPUT_INDEX: column is out of range
+  RetCode column( const std::size_t& column, std::vector<double>& values ) const;
+
+  /// get the line number of the file of the row
+  /// @param[in] row the index of row
+  /// @return the line number (1-origin)
+  /// @exception InvalidIndexAccess If invalid row is accessed.
+  const std::size_t line_of_row( const std::size_t& row ) const
+    SPLINE_THROW_SPEC(InvalidIndexAccess);
+
+  /// build TPQueue
+  /// @param[in]  time_column     the index of time column
+  /// @param[in]  position_column the index of position column
+  /// @param[out] queue           destination queue (replaced)
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_INPUT_INDEX: column is out of range
+  /// - SPLINE_INVALID_INPUT_TIME: times are not strictly increasing (see error_line())
+  RetCode to_tp_queue( const std::size_t& time_column,
+                       const std::size_t& position_column,
+                       TPQueue&           queue );
+
+  /// build TPVAQueue
+  /// @param[in]  time_column         the index of time column
+  /// @param[in]  position_column     the index of position column
+  /// @param[out] queue               destination queue (replaced)
+  /// @param[in]  velocity_column     the index of velocity column (default: NO_COLUMN -> 0.0)
+  /// @param[in]  acceleration_column the index of acceleration column (default: NO_COLUMN -> 0.0)
+  /// @return the same as to_tp_queue()
+  RetCode to_tpva_queue( const std::size_t& time_column,
+                         const std::size_t& position_column,
+                         TPVAQueue&         queue,
+                         const std::size_t& velocity_column=NO_COLUMN,
+                         const std::size_t& acceleration_column=NO_COLUMN );
+
+  /// build TPVAListQueue
+  /// @param[in]  time_column      the index of time column
+  /// @param[in]  position_columns the indices of position columns of axes
+  /// @param[out] queue            destination queue (replaced, vel = acc = 0.0)
+  /// @return the same as to_tp_queue()
+  RetCode to_tpva_list_queue( const std::size_t&              time_column,
+                              const std::vector<std::size_t>& position_columns,
+                              TPVAListQueue&                  queue );
+
+  /// get the line number of the last error
+  /// @return the line number (1-origin, 0 if no error)
+  const std::size_t error_line() const;
+
+  /// get the message of the last error
+  /// @return the message (empty if no error)
+  const std::string& error_message() const;
+
+  /// the index meaning "no column"
+  static const std::size_t NO_COLUMN;
+
+private:
+  /// clear the table (values, rows, columns)
+  void clear_table();
+
+  /// parse the text into the table (the table is cleared on error)
+  /// @param[in] begin the first address of text
+  /// @param[in] end   the address next to the last of text
+  /// @return the same as load_string()
+  RetCode parse( const char* begin, const char* end );
+
+  /// check the columns and get the times
+  /// @param[in]  time_column the index of time column
+  /// @param[in]  columns     the indices of value columns (NO_COLUMN is allowed)
+  /// @param[out] times       times of all rows
+  /// @return
+  /// - SPLINE_SUCCESS: no error
+  /// - SPLINE_INVALID_INPUT_INDEX: column is out of range
+  RetCode prepare( const std::size_t&              time_column,
+                   const std::vector<std::size_t>& columns,
+                   std::vector<double>&            times );
+
+  /// set the error line if the times are not strictly increasing
+  /// @param[in] ret   the return code of TimeQueue::assign()
+  /// @param[in] times times of all rows
+  /// @return ret
+  RetCode report_time_error( const RetCode& ret, const std::vector<double>& times );
+
+  /// set the error
+  /// @param[in] line    the line number
+  /// @param[in] message the message
+  void set_error( const std::size_t& line, const std::string& message );
+
+  /// values of all rows (row-major)
+  std::vector<double> values_;
+
+  /// the line number of each row
+  std::vector<std::size_t> row_lines_;
+
+  /// the number of columns
+  std::size_t column_size_;
+
+  /// the line number of the last error
+  std::size_t error_line_;
+
+  /// the message of the last error
+  std::string error_message_;
+};
+
+} // End of namespace interp
+
+#endif // INCLUDE_WAYPOINT_LOADER_HPP_
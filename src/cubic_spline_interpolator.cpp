@@ -1,8 +1,155 @@
 #include "cubic_spline_interpolator.hpp"
+#include "cubic_spline_kernel.hpp"
+#include "spline_thread_pool.hpp"
+#include "monotonic_arena.hpp"
+#include <algorithm> // for min
+#include <math.h>
 
 using namespace interp;
 
-CubicSplineInterpolator::CubicSplineInterpolator() {
+namespace {
+
+/// Hermite coefficients of each segment from the Time, Position, Velocity queue
+/// @details Each segment writes only its own coefficients,
+///          so any partition of the segment range gives the same result.
+class CubicHermiteCoefficientTask : public RangeTask {
+public:
+  /// Constructor
+  /// @param[in]  tpva_queue target Time, Position, Velocity queue
+  /// @param[out] a third-order parameters (sized to the number of points)
+  /// @param[out] b second-order parameters (sized to the number of points)
+  /// @param[out] c first-order parameters (sized to the number of points)
+  /// @param[out] d zero-order parameters (sized to the number of points)
+  CubicHermiteCoefficientTask( const TPVAQueue&     tpva_queue,
+                               std::vector<double>& a,
+                               std::vector<double>& b,
+                               std::vector<double>& c,
+                               std::vector<double>& d ) :
+    tpva_queue_(tpva_queue), a_(a), b_(b), c_(c), d_(d) {
+  }
+
+  /// Calculate the coefficients of segments [begin, end)
+  /// @param[in] begin the first segment index
+  /// @param[in] end   the segment index next to the last
+  virtual void run( const std::size_t& begin, const std::size_t& end ) {
+    for( std::size_t i=begin; i < end; i++ ) {
+      const TimePVA& tpva0 = tpva_queue_.at( i   );
+      const TimePVA& tpva1 = tpva_queue_.at( i+1 );
+      const double& pos1 = tpva1.value.pos;
+      const double& pos0 = tpva0.value.pos;
+      const double& vel1 = tpva1.value.vel;
+      const double& vel0 = tpva0.value.vel;
+      const double  dT0  = tpva_queue_.dT( i );
+      g_cubic_hermite( pos0, vel0, pos1, vel1, dT0, a_[i], b_[i], c_[i], d_[i] );
+    }
+  }
+
+private:
+  const TPVAQueue&     tpva_queue_;
+  std::vector<double>& a_;
+  std::vector<double>& b_;
+  std::vector<double>& c_;
+  std::vector<double>& d_;
+};
+
+/// Times of the target queue for the cubic spline kernels
+class QueueTimes {
+public:
+  /// Constructor
+  /// @param[in] tp_queue target Time, Position queue
+  explicit QueueTimes( const TPQueue& tp_queue ) : tp_queue_(tp_queue) {
+  }
+
+  /// time of the point
+  /// @param[in] index index of the point
+  /// @return time
+  const double& operator[]( const std::size_t& index ) const {
+    return tp_queue_.get( index ).time;
+  }
+
+private:
+  const TPQueue& tp_queue_;
+};
+
+/// Positions of the target queue for the cubic spline kernels
+class QueuePositions {
+public:
+  /// Constructor
+  /// @param[in] tp_queue target Time, Position queue
+  explicit QueuePositions( const TPQueue& tp_queue ) : tp_queue_(tp_queue) {
+  }
+
+  /// position of the point
+  /// @param[in] index index of the point
+  /// @return position
+  const double& operator[]( const std::size_t& index ) const {
+    return tp_queue_.get( index ).value;
+  }
+
+private:
+  const TPQueue& tp_queue_;
+};
+
+} // End of namespace
+
+CubicSplineWorkspace::CubicSplineWorkspace( const std::size_t& point_num ) {
+  reserve( point_num );
+}
+
+CubicSplineWorkspace::~CubicSplineWorkspace() {
+}
+
+void CubicSplineWorkspace::reserve( const std::size_t& point_num ) {
+  upper_.reserve( point_num );
+  diago_.reserve( point_num );
+  lower_.reserve( point_num );
+  param_.reserve( point_num );
+  times_.reserve( point_num );
+  pva_list_.reserve( point_num );
+}
+
+const std::size_t CubicSplineWorkspace::capacity() const {
+  std::size_t point_num = upper_.capacity();
+  point_num = std::min( point_num, diago_.capacity() );
+  point_num = std::min( point_num, lower_.capacity() );
+  point_num = std::min( point_num, param_.capacity() );
+  point_num = std::min( point_num, times_.capacity() );
+  point_num = std::min( point_num, pva_list_.capacity() );
+  return point_num;
+}
+
+void CubicSplineWorkspace::release() {
+  // swap with empty vectors, since clear() keeps the capacity
+  std::vector<double>().swap( upper_ );
+  std::vector<double>().swap( diago_ );
+  std::vector<double>().swap( lower_ );
+  std::vector<double>().swap( param_ );
+  std::vector<double>().swap( times_ );
+  std::vector<PosVelAcc>().swap( pva_list_ );
+  std::vector<double>().swap( uniform_inverse_diago_ );
+}
+
+void CubicSplineWorkspace::resize( const std::size_t& point_num ) {
+  upper_.resize( point_num );
+  diago_.resize( point_num );
+  lower_.resize( point_num );
+  param_.resize( point_num );
+  times_.resize( point_num );
+  pva_list_.resize( point_num );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+const double CubicSplineInterpolator::UNIFORM_KNOT_TOLERANCE = 1.0e-9;
+
+const double CubicSplineInterpolator::RETIME_MARGIN = 1.0e-3;
+
+CubicSplineInterpolator::CubicSplineInterpolator() :
+  workspace_             ( NULL  ),
+  uniform_knot_detection_( true  ),
+  is_uniform_knot_       ( false ),
+  inverse_uniform_dT_    ( 0.0   ),
+  a_limit_               ( 0.0   ) {
 }
 
 CubicSplineInterpolator::~CubicSplineInterpolator() {
@@ -10,57 +157,142 @@ CubicSplineInterpolator::~CubicSplineInterpolator() {
 
 CubicSplineInterpolator::CubicSplineInterpolator(
                            const CubicSplineInterpolator& src ) :
-  SplineInterpolator( src.is_path_generated_,
-                      src.is_v_limit_,
-                      src.v_limit_,
-                      src.target_tpva_queue_  ) {
-  this->a_.clear();
-  this->b_.clear();
-  this->c_.clear();
-  this->d_.clear();
-
-  this->a_.resize( src.a_.size() );
-  this->b_.resize( src.b_.size() );
-  this->c_.resize( src.c_.size() );
-  this->d_.resize( src.d_.size() );
-
-  std::copy( src.a_.begin(), src.a_.end(), this->a_.begin() );
-  std::copy( src.b_.begin(), src.b_.end(), this->b_.begin() );
-  std::copy( src.c_.begin(), src.c_.end(), this->c_.begin() );
-  std::copy( src.d_.begin(), src.d_.end(), this->d_.begin() );
+  SplineInterpolator( src ),
+  a_( src.a_ ),
+  b_( src.b_ ),
+  c_( src.c_ ),
+  d_( src.d_ ),
+  workspace_             ( src.workspace_              ),
+  uniform_knot_detection_( src.uniform_knot_detection_ ),
+  is_uniform_knot_       ( src.is_uniform_knot_        ),
+  inverse_uniform_dT_    ( src.inverse_uniform_dT_     ),
+  uniform_inverse_diago_ ( src.uniform_inverse_diago_  ),
+  a_limit_               ( src.a_limit_                ) {
 }
 
 CubicSplineInterpolator& CubicSplineInterpolator::operator=(
                            const CubicSplineInterpolator& src ) {
+  // vector handles self copy and reuses the allocated memory
+  SplineInterpolator::operator=( src );
+  this->a_ = src.a_;
+  this->b_ = src.b_;
+  this->c_ = src.c_;
+  this->d_ = src.d_;
+  this->workspace_              = src.workspace_;
+  this->uniform_knot_detection_ = src.uniform_knot_detection_;
+  this->is_uniform_knot_        = src.is_uniform_knot_;
+  this->inverse_uniform_dT_     = src.inverse_uniform_dT_;
+  this->uniform_inverse_diago_  = src.uniform_inverse_diago_;
+  this->a_limit_                = src.a_limit_;
+  return *this;
+}
 
-  CubicSplineInterpolator dest( src );
-
-  this->is_path_generated_ = dest.is_path_generated_;
-  this->is_v_limit_        = dest.is_v_limit_;
-  this->v_limit_           = dest.v_limit_;
-  this->target_tpva_queue_ = dest.target_tpva_queue_;
-
-  this->a_.clear();
-  this->b_.clear();
-  this->c_.clear();
-  this->d_.clear();
-
-  this->a_.resize( dest.a_.size() );
-  this->b_.resize( dest.b_.size() );
-  this->c_.resize( dest.c_.size() );
-  this->d_.resize( dest.d_.size() );
-
-  std::copy( dest.a_.begin(), dest.a_.end(), this->a_.begin() );
-  std::copy( dest.b_.begin(), dest.b_.end(), this->b_.begin() );
-  std::copy( dest.c_.begin(), dest.c_.end(), this->c_.begin() );
-  std::copy( dest.d_.begin(), dest.d_.end(), this->d_.begin() );
+#ifdef SPLINE_CXX11
+CubicSplineInterpolator::CubicSplineInterpolator(
+                           CubicSplineInterpolator&& src ) SPLINE_NOEXCEPT :
+  SplineInterpolator( std::move( src ) ),
+  a_( std::move( src.a_ ) ),
+  b_( std::move( src.b_ ) ),
+  c_( std::move( src.c_ ) ),
+  d_( std::move( src.d_ ) ),
+  workspace_             ( src.workspace_              ),
+  uniform_knot_detection_( src.uniform_knot_detection_ ),
+  is_uniform_knot_       ( src.is_uniform_knot_        ),
+  inverse_uniform_dT_    ( src.inverse_uniform_dT_     ),
+  uniform_inverse_diago_ ( std::move( src.uniform_inverse_diago_ ) ),
+  a_limit_               ( src.a_limit_                ) {
+}
 
+CubicSplineInterpolator& CubicSplineInterpolator::operator=(
+                           CubicSplineInterpolator&& src ) SPLINE_NOEXCEPT {
+  SplineInterpolator::operator=( std::move( src ) );
+  this->a_ = std::move( src.a_ );
+  this->b_ = std::move( src.b_ );
+  this->c_ = std::move( src.c_ );
+  this->d_ = std::move( src.d_ );
+  this->workspace_              = src.workspace_;
+  this->uniform_knot_detection_ = src.uniform_knot_detection_;
+  this->is_uniform_knot_        = src.is_uniform_knot_;
+  this->inverse_uniform_dT_     = src.inverse_uniform_dT_;
+  this->uniform_inverse_diago_  = std::move( src.uniform_inverse_diago_ );
+  this->a_limit_                = src.a_limit_;
   return *this;
 }
+#endif
 
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+template<class Vector, class PVAVector>
+RetCode CubicSplineInterpolator::solve_path( const TPQueue& target_tp_queue,
+                                             const double&  vs,
+                                             const double&  vf,
+                                             Vector&        upper_list,
+                                             Vector&        diago_list,
+                                             Vector&        lower_list,
+                                             Vector&        param_list,
+                                             Vector&        times,
+                                             PVAVector&     pva_list,
+                                             std::vector<double>& uniform_inverse_diago ) {
+  const std::size_t finish_index = target_tp_queue.size() - 1;
+  const std::size_t point_num    = finish_index + 1;
+  const QueueTimes     queue_times( target_tp_queue );
+  const QueuePositions queue_positions( target_tp_queue );
+  // the queue built by assign() is not checked on push()
+  RetCode retcode = g_cubic_spline_check_times<double>( point_num, queue_times );
+  if( retcode != SPLINE_SUCCESS ) {
+    return retcode;
+  }
+  double* param = &param_list[0];
+  double uniform_dT = 0.0;
+  const bool is_uniform = detect_uniform_knot( target_tp_queue, uniform_dT );
+  if( is_uniform ) {
+    // constant-coefficient matrix [1 4 1] scaled by dT/2 with the cached factorization
+    const double inverse_dT = 1.0 / uniform_dT;
+    g_uniform_tridiagonal_factorize( point_num, uniform_inverse_diago );
+    param[0] = vs; // this corresponds to start velocity.
+    for ( std::size_t i=1; i < finish_index; i++ ) {
+      param[i] = 3.0 * inverse_dT * (queue_positions[i+1] - queue_positions[i-1]);
+    }
+    param[finish_index] = vf; // this corresponds to finish velocity.
+    g_uniform_tridiagonal_solve_in_place( point_num, &uniform_inverse_diago[0], param );
+  } else {
+    double* upper = &upper_list[0];
+    double* diago = &diago_list[0];
+    double* lower = &lower_list[0];
+    g_cubic_spline_matrix( point_num, queue_times, queue_positions, vs, vf,
+                           lower, diago, upper, param );
+    // solved in place into param, so that the previous path is kept on failure
+    retcode = g_tridiagonal_solve_in_place( point_num, diago, upper, lower, param, param );
+    if( retcode != SPLINE_SUCCESS ) {
+      // diago[i]=0, SPLINE_INVALID_MATRIX_ARGUMENT_VALUE_ZERO
+      return retcode;
+    }
+  }
+  // resize() keeps the capacity of the previous path
+  a_.resize( point_num );
+  b_.resize( point_num );
+  c_.resize( point_num );
+  d_.resize( point_num );
+  // the uniform interval time needs no division per row
+  g_cubic_spline_coefficients( point_num, queue_times, queue_positions, param,
+                               &a_[0], &b_[0], &c_[0], &d_[0],
+                               is_uniform ? uniform_dT : 0.0 );
+  for ( std::size_t i=0; i < point_num; i++ ) {
+    times[i]    = queue_times[i];
+    pva_list[i] = PosVelAcc( d_[i], c_[i], b_[i] );
+  }
+  // overwrites the elements of the previous target queue
+  target_tpva_queue_.assign( times, pva_list );
+  is_uniform_knot_    = is_uniform;
+  inverse_uniform_dT_ = is_uniform ? 1.0 / uniform_dT : 0.0;
+  //
+  is_path_generated_ = true;
+  //
+  return SPLINE_SUCCESS;
+}
+
+
 RetCode CubicSplineInterpolator::generate_path(
           const TPQueue& target_tp_queue,
           const double vs, const double vf,
@@ -69,93 +301,85 @@ RetCode CubicSplineInterpolator::generate_path(
   if ( finish_index <= 1 ) {
     return SPLINE_INVALID_QUEUE_SIZE;
   }
-  //
-  std::vector<double> upper;
-  std::vector<double> diago;
-  std::vector<double> lower;
-  std::vector<double> param;
-  // the start index = 0
-  lower.push_back(0.0);
-  diago.push_back(1.0);
-  upper.push_back(0.0);
-  param.push_back( vs ); // this corresponds to start velocity.
-  // index >= 1
-  double inverse_dT = 0.0;
-  double inverse_pre_dT = 0.0;
-  for ( std::size_t i=1; i < finish_index; i++ ) {
-    if( g_isNearlyZero( target_tp_queue.dT(i) ) ) {
-      // Failed because dT = 0
-      return SPLINE_INVALID_INPUT_INTERVAL_TIME_DT;
+  const std::size_t point_num = finish_index + 1;
+  if( workspace_ != NULL ) {
+    // matrix on the workspace of the caller (no allocation within the reserved size)
+    workspace_->resize( point_num );
+    return solve_path( target_tp_queue, vs, vf,
+                       workspace_->upper_, workspace_->diago_, workspace_->lower_,
+                       workspace_->param_, workspace_->times_, workspace_->pva_list_,
+                       workspace_->uniform_inverse_diago_ );
+  }
+  // scratch buffers on the arena (heap if not set), released at the end of the scope
+  ArenaScope scope( arena_ );
+  const ArenaAllocator<double> alloc( arena_ );
+  ArenaVector<double>::type upper( point_num, 0.0, alloc );
+  ArenaVector<double>::type diago( point_num, 0.0, alloc );
+  ArenaVector<double>::type lower( point_num, 0.0, alloc );
+  ArenaVector<double>::type param( point_num, 0.0, alloc );
+  ArenaVector<double>::type times( point_num, 0.0, alloc );
+  ArenaVector<PosVelAcc>::type pva_list( point_num, PosVelAcc(), ArenaAllocator<PosVelAcc>( arena_ ) );
+  return solve_path( target_tp_queue, vs, vf,
+                     upper, diago, lower, param, times, pva_list, uniform_inverse_diago_ );
+}
+
+void CubicSplineInterpolator::set_workspace( CubicSplineWorkspace* workspace ) {
+  workspace_ = workspace;
+}
+
+CubicSplineWorkspace* CubicSplineInterpolator::workspace() {
+  return workspace_;
+}
+
+void CubicSplineInterpolator::set_uniform_knot_detection( const bool& enable ) {
+  uniform_knot_detection_ = enable;
+}
+
+const bool CubicSplineInterpolator::is_uniform_knot() const {
+  return is_path_generated_ && is_uniform_knot_;
+}
+
+template<class QueueT>
+bool CubicSplineInterpolator::detect_uniform_knot( const QueueT& queue,
+                                                   double&       out_mean_dT ) const {
+  const std::size_t finish_index = queue.size() - 1;
+  out_mean_dT = ( queue.get( finish_index ).time - queue.get( 0 ).time ) / finish_index;
+  if( !uniform_knot_detection_ ) {
+    return false;
+  }
+  const double tolerance = fabs( out_mean_dT ) * UNIFORM_KNOT_TOLERANCE;
+  for( std::size_t i=0; i < finish_index; i++ ) {
+    if( fabs( queue.dT( i ) - out_mean_dT ) > tolerance ) {
+      return false;
     }
-    inverse_dT     = 1.0 / target_tp_queue.dT(i);
-    inverse_pre_dT = 1.0 / target_tp_queue.dT(i-1);
-    lower.push_back( 2.0 * inverse_dT );
-    diago.push_back( 4.0 * (inverse_dT + inverse_pre_dT) );
-    upper.push_back( 2.0 * inverse_dT );
-    double p
-      = 6.0*(target_tp_queue.get(i+1).value - target_tp_queue.get(i).value)
-           * inverse_dT * inverse_dT
-      + 6.0*(target_tp_queue.get(i).value - target_tp_queue.get(i-1).value)
-           * inverse_pre_dT * inverse_pre_dT;
-    param.push_back(p);
-  }
-  // the finish index
-  lower.push_back(0.0);
-  diago.push_back(1.0);
-  upper.push_back(0.0);
-  param.push_back( vf ); // this corresponds to finish velocity.
-  std::vector<double> ret_c;
-  RetCode retcode = tridiagonal_matrix_eq_solver( diago, upper, lower, param, ret_c );
-  if( retcode != SPLINE_SUCCESS ) {
-    // diago[i]=0, SPLINE_INVALID_MATRIX_ARGUMENT_VALUE_ZERO
-    return retcode;
   }
-  //
-  c_.clear();
-  c_.resize( ret_c.size() );
-  std::copy( ret_c.begin(), ret_c.end(), c_.begin() );
-  //
-  a_.clear();
-  b_.clear();
-  d_.clear();
-  target_tpva_queue_.clear();
-  // the start index = 0
-  for ( std::size_t i=0; i < finish_index; i++ ) {
-    inverse_dT = 1.0 / target_tp_queue.dT(i);
-    //
-    const double dp = target_tp_queue.get(i+1).value - target_tp_queue.get(i).value;
-    //
-    a_.push_back( ( (c_[i+1] + c_[i]) * target_tp_queue.dT(i) - 2.0 * dp )
-                  * inverse_dT * inverse_dT * inverse_dT );
-    b_.push_back( ( -1.0 * (c_[i+1] + 2.0 * c_[i]) * target_tp_queue.dT(i) + 3.0 * dp )
-                  * inverse_dT * inverse_dT );
-    d_.push_back( target_tp_queue.get(i).value );
-    //
-    target_tpva_queue_.push( target_tp_queue.get(i).time,
-                             target_tp_queue.get(i).value,
-                             c_[i],
-                             b_[i] );
-    // std::cout << "a_[" << i << "] : " << a_[i] << std::endl;
-    // std::cout << "b_[" << i << "] : " << b_[i] << std::endl;
-    // std::cout << "c_[" << i << "] : " << c_[i] << std::endl;
-    // std::cout << "d_[" << i << "] : " << d_[i] << std::endl;
-  }
-  // the finish index = target_tp_queue.size() - 1
-  a_.push_back( 0.0 ); // this corresponds to finish jark :=0.0.
-  b_.push_back( 0.0 ); // this corresponds to finish velocity :=0.0.
-  d_.push_back( target_tp_queue.get(finish_index).value ); // this corresponds to finish position.
-  // std::cout << "a_[" << finish_index << "] : " << a_[finish_index] << std::endl;
-  // std::cout << "b_[" << finish_index << "] : " << b_[finish_index] << std::endl;
-  // std::cout << "c_[" << finish_index << "] : " << c_[finish_index] << std::endl;
-  // std::cout << "d_[" << finish_index << "] : " << d_[finish_index] << std::endl;
-  TimePVA finish_tpva( target_tp_queue.get(finish_index).time,
-                       PosVelAcc( target_tp_queue.get(finish_index).value,
-                                  c_[finish_index],
-                                  b_[finish_index] ) );
-  target_tpva_queue_.push( finish_tpva );
-  //
-  is_path_generated_ = true;
-  //
+  return true;
+}
+
+const RetCode CubicSplineInterpolator::uniform_index_of_time( const double& t,
+                                                              std::size_t&  output_index ) const {
+  const std::size_t last_index = target_tpva_queue_.size() - 1;
+  const double      start_time = target_tpva_queue_.get( 0 ).time;
+  const double      last_time  = target_tpva_queue_.get( last_index ).time;
+  if( t > last_time || t < start_time ) {
+    return SPLINE_INVALID_INPUT_TIME;
+  } else if( t == last_time ) {
+    output_index = last_index;
+    return SPLINE_SUCCESS;
+  }
+
+  std::size_t index = static_cast<std::size_t>( ( t - start_time ) * inverse_uniform_dT_ );
+  if( index > last_index - 1 ) {
+    index = last_index - 1;
+  }
+  // correct the rounding error of the knot times (the same index as the binary search)
+  while( index > 0 && t < target_tpva_queue_.get( index ).time ) {
+    index--;
+  }
+  while( index + 1 < last_index && target_tpva_queue_.get( index + 1 ).time <= t ) {
+    index++;
+  }
+  output_index = index;
   return SPLINE_SUCCESS;
 }
 
@@ -173,27 +397,24 @@ RetCode CubicSplineInterpolator::generate_path(
   }
   //
   target_tpva_queue_ = target_tpva_queue;
+  double uniform_dT = 0.0;
+  is_uniform_knot_    = detect_uniform_knot( target_tpva_queue_, uniform_dT )
+                        && !g_isNearlyZero( uniform_dT );
+  inverse_uniform_dT_ = is_uniform_knot_ ? 1.0 / uniform_dT : 0.0;
   //
-  a_.clear();
-  b_.clear();
-  c_.clear();
-  d_.clear();
-  for( std::size_t i=0; i < finish_index; i++ ) {
-    const double& pos1 = target_tpva_queue_.get( i+1 ).value.pos;
-    const double& pos0 = target_tpva_queue_.get( i   ).value.pos;
-    const double& vel1 = target_tpva_queue_.get( i+1 ).value.vel;
-    const double& vel0 = target_tpva_queue_.get( i   ).value.vel;
-    const double  dT0  = target_tpva_queue_.dT(  i   );
-    a_.push_back( ((vel1 + vel0)*dT0     - 2.0*(pos1 - pos0)) / (dT0 * dT0 * dT0) );
-    b_.push_back( ((vel1 + 2.0*vel0)*dT0 + 3.0*(pos1 - pos0)) / (dT0 * dT0 ) );
-    c_.push_back( vel0 );
-    d_.push_back( pos0 );
-  }
-  a_.push_back( 0.0 ); // this corresponds to finish jark :=0.0.
+  a_.assign( finish_index + 1, 0.0 );
+  b_.assign( finish_index + 1, 0.0 );
+  c_.assign( finish_index + 1, 0.0 );
+  d_.assign( finish_index + 1, 0.0 );
+  // segments are independent -- in parallel if the thread pool is set
+  CubicHermiteCoefficientTask task( target_tpva_queue_, a_, b_, c_, d_ );
+  for_each_segment( 0, finish_index, task );
+  //
+  a_[finish_index] = 0.0; // this corresponds to finish jark :=0.0.
   // this corresponds to finish acceleration.
-  b_.push_back( target_tpva_queue_.get( finish_index ).value.acc * 0.5 );
-  c_.push_back( target_tpva_queue_.get( finish_index ).value.vel );
-  d_.push_back( target_tpva_queue_.get( finish_index ).value.pos );
+  b_[finish_index] = target_tpva_queue_.at( finish_index ).value.acc * 0.5;
+  c_[finish_index] = target_tpva_queue_.at( finish_index ).value.vel;
+  d_[finish_index] = target_tpva_queue_.at( finish_index ).value.pos;
   //
   is_path_generated_ = true;
   //
@@ -213,6 +434,13 @@ RetCode CubicSplineInterpolator::generate_path_from_pva(
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
+const TimePVA CubicSplineInterpolator::pop(const double& t ) const {
+  return this->pop<OUTPUT_PVA>( t );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+template<unsigned int Mask>
 const TimePVA CubicSplineInterpolator::pop(const double& t ) const {
 
   if( !is_path_generated_ ) {
@@ -233,7 +461,10 @@ const TimePVA CubicSplineInterpolator::pop(const double& t ) const {
 
   std::size_t index = 0;
 
-  RetCode retcode = this->index_of_time( t, index );
+  // time on the generated path (time scale)
+  const double tp = path_time( t );
+  RetCode retcode = is_uniform_knot_ ? this->uniform_index_of_time( tp, index )
+                                     : this->index_of_time( tp, index );
 
   if( retcode != SPLINE_SUCCESS ) {
     std::stringstream ss1;
@@ -242,27 +473,36 @@ const TimePVA CubicSplineInterpolator::pop(const double& t ) const {
     ss1 << "time value = "
         << t
         << " is out of range of generated path between time of start index[0] t0(="
-        << target_tpva_queue_.get( 0 ).time
+        << start_time()
         << ") and time of finish index["
         << finish_index
         << "] tf(="
-        << target_tpva_queue_.get( finish_index ).time
+        << finish_time()
         << ").";
     std::cerr << ss1.str() << std::endl;
     THROW( TimeOutOfRange, ss1.str() );
   }
 
-  const double dTi    = (t - target_tpva_queue_.get(index).time);
-  const double square = dTi * dTi;
-  const double cube   = dTi * dTi * dTi;
-  const double xt     = a_[index] * cube + b_[index] * square + c_[index] * dTi + d_[index];
-  const double vt     = 3.0 * a_[index] * square + 2.0 * b_[index] * dTi + c_[index];
-  const double at     = 6.0 * a_[index] * dTi + 2.0 * b_[index];
+  const double dTi = (tp - target_tpva_queue_.at(index).time);
+  double xt = 0.0, vt = 0.0, at = 0.0;
+  g_cubic_evaluate_masked<Mask>( a_[index], b_[index], c_[index], d_[index], dTi, xt, vt, at );
+  if( is_time_scaled_ ) {
+    vt *= time_scale_;
+    at *= time_scale_ * time_scale_;
+  }
   const TimePVA dest_tpva( t, PosVelAcc(xt, vt, at) );
 
   return dest_tpva;
 }
 
+template const TimePVA CubicSplineInterpolator::pop<OUTPUT_POS>(const double& t ) const;
+template const TimePVA CubicSplineInterpolator::pop<OUTPUT_VEL>(const double& t ) const;
+template const TimePVA CubicSplineInterpolator::pop<OUTPUT_POS_VEL>(const double& t ) const;
+template const TimePVA CubicSplineInterpolator::pop<OUTPUT_ACC>(const double& t ) const;
+template const TimePVA CubicSplineInterpolator::pop<OUTPUT_POS|OUTPUT_ACC>(const double& t ) const;
+template const TimePVA CubicSplineInterpolator::pop<OUTPUT_VEL|OUTPUT_ACC>(const double& t ) const;
+template const TimePVA CubicSplineInterpolator::pop<OUTPUT_PVA>(const double& t ) const;
+
 /////////////////////////////////////////////////////////////////////////////////////////////
 
 RetCode CubicSplineInterpolator::clear() {
@@ -271,53 +511,153 @@ RetCode CubicSplineInterpolator::clear() {
   b_.clear();
   c_.clear();
   d_.clear();
+  is_uniform_knot_ = false;
 
   return SplineInterpolator::clear();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-RetCode CubicSplineInterpolator::tridiagonal_matrix_eq_solver(
-          std::vector<double> d, const std::vector<double>& u,
-          const std::vector<double>& l, std::vector<double> p,
-          std::vector<double>& out_solved_x ) {
-  out_solved_x.clear();
-  if( d.size() != u.size() || d.size() != l.size() || d.size() != p.size() ) {
-    const std::string err_msg = "all input parmeter size must be same.";
-    std::cerr << err_msg << std::endl;
-    THROW( InvalidArgumentSize, err_msg );
+void CubicSplineInterpolator::set_limit( const double& v_limit, const double& a_limit ) {
+  is_v_limit_ = ( v_limit > 0.0 );
+  v_limit_    = is_v_limit_ ? v_limit : 0.0;
+  a_limit_    = ( a_limit > 0.0 ) ? a_limit : 0.0;
+}
+
+const double CubicSplineInterpolator::a_limit() const {
+  return a_limit_;
+}
+
+RetCode CubicSplineInterpolator::segment_peak( const std::size_t& index,
+                                               double& max_abs_vel,
+                                               double& max_abs_acc ) const {
+  if( !is_path_generated_ ) {
+    return SPLINE_UNINITIALIZED_INTERPOLATOR;
   }
-  if( d.size() < 1 ) {
-    const std::string err_msg = "input parmeter size must be >= 1.";
-    std::cerr << err_msg << std::endl;
-    THROW( InvalidArgumentSize, err_msg );
+  if( index + 1 >= target_tpva_queue_.size() ) {
+    return SPLINE_INVALID_INPUT_INDEX;
   }
-  double temp;
-  // first loop from top
-  for( std::size_t i=0; i<d.size(); i++ ) {
-    if( g_isNearlyZero(d[i]) ) {
-      return SPLINE_INVALID_MATRIX_ARGUMENT_VALUE_ZERO;
-    }
-    if( i >= 1 ) {
-      temp = l[i] / d[i-1];
-      d[i] = d[i] - temp * u[i-1];
-      p[i] = p[i] - temp * p[i-1];
+  g_cubic_peak( a_[index], b_[index], c_[index], target_tpva_queue_.dT( index ),
+                max_abs_vel, max_abs_acc );
+  // the outputs of pop() with the time scale s
+  max_abs_vel *= time_scale_;
+  max_abs_acc *= time_scale_ * time_scale_;
+  return SPLINE_SUCCESS;
+}
+
+RetCode CubicSplineInterpolator::path_peak( double& max_abs_vel, double& max_abs_acc ) const {
+  if( !is_path_generated_ ) {
+    return SPLINE_UNINITIALIZED_INTERPOLATOR;
+  }
+  max_abs_vel = 0.0;
+  max_abs_acc = 0.0;
+  for( std::size_t i=0; i + 1 < target_tpva_queue_.size(); i++ ) {
+    double segment_vel = 0.0, segment_acc = 0.0;
+    g_cubic_peak( a_[i], b_[i], c_[i], target_tpva_queue_.dT( i ), segment_vel, segment_acc );
+    max_abs_vel = std::max( max_abs_vel, segment_vel );
+    max_abs_acc = std::max( max_abs_acc, segment_acc );
+  }
+  // the outputs of pop() with the time scale s
+  max_abs_vel *= time_scale_;
+  max_abs_acc *= time_scale_ * time_scale_;
+  return SPLINE_SUCCESS;
+}
+
+RetCode CubicSplineInterpolator::check_limit( std::vector<std::size_t>* violated_indexes ) const {
+  if( !is_path_generated_ ) {
+    return SPLINE_UNINITIALIZED_INTERPOLATOR;
+  }
+  if( violated_indexes != NULL ) {
+    violated_indexes->clear();
+  }
+  RetCode retcode = SPLINE_SUCCESS;
+  for( std::size_t i=0; i + 1 < target_tpva_queue_.size(); i++ ) {
+    double max_abs_vel = 0.0, max_abs_acc = 0.0;
+    segment_peak( i, max_abs_vel, max_abs_acc );
+    if( ( is_v_limit_ && max_abs_vel > v_limit_ )
+        || ( a_limit_ > 0.0 && max_abs_acc > a_limit_ ) ) {
+      retcode = SPLINE_LIMIT_EXCEEDED;
+      if( violated_indexes == NULL ) {
+        break;
+      }
+      violated_indexes->push_back( i );
     }
   }
-  //
-  // solve x
-  //
-  out_solved_x.resize( d.size() );
-  std::size_t last_index = d.size()-1;
-  out_solved_x[last_index] = p[last_index] / d[last_index];
-  if( d.size() == 1 ) {
-    return SPLINE_SUCCESS;
+  return retcode;
+}
+
+RetCode CubicSplineInterpolator::retime( const std::size_t& max_iteration ) {
+  if( !is_path_generated_ ) {
+    return SPLINE_UNINITIALIZED_INTERPOLATOR;
   }
-  // second loop from bottom
-  // list size must be >= 2.
-  for( int i=last_index-1; i>=0; i-- ) {
-    out_solved_x[i] = ( p[i] - u[i] * out_solved_x[i+1] ) / d[i];
+  const std::size_t point_num = target_tpva_queue_.size();
+  const double      vs        = c_[0];
+  const double      vf        = c_[point_num - 1];
+  // the start and finish velocities are kept, so they cannot be retimed
+  const double scale = time_scale_;
+  if( is_v_limit_ && ( scale * fabs( vs ) > v_limit_ || scale * fabs( vf ) > v_limit_ ) ) {
+    return SPLINE_LIMIT_EXCEEDED;
   }
-  //
-  return SPLINE_SUCCESS;
+  const double start_time = target_tpva_queue_.get( 0 ).time;
+  std::vector<double> dT_list( point_num - 1 );
+  std::vector<double> positions( point_num );
+  for( std::size_t i=0; i < point_num; i++ ) {
+    positions[i] = target_tpva_queue_.get( i ).value.pos;
+    if( i + 1 < point_num ) {
+      dT_list[i] = target_tpva_queue_.dT( i );
+    }
+  }
+
+  for( std::size_t iteration=0; ; iteration++ ) {
+    // stretch the offending segments
+    bool is_within_limit = true;
+    for( std::size_t i=0; i + 1 < point_num; i++ ) {
+      double max_abs_vel = 0.0, max_abs_acc = 0.0;
+      g_cubic_peak( a_[i], b_[i], c_[i], dT_list[i], max_abs_vel, max_abs_acc );
+      // the outputs of pop() with the time scale s
+      max_abs_vel *= scale;
+      max_abs_acc *= scale * scale;
+      // velocity scales with 1/k and acceleration with 1/k^2 by the stretch k
+      double stretch = 1.0;
+      if( is_v_limit_ && max_abs_vel > v_limit_ ) {
+        stretch = max_abs_vel / v_limit_;
+      }
+      if( a_limit_ > 0.0 && max_abs_acc > a_limit_ ) {
+        stretch = std::max( stretch, sqrt( max_abs_acc / a_limit_ ) );
+      }
+      if( stretch > 1.0 ) {
+        dT_list[i] *= stretch * ( 1.0 + RETIME_MARGIN );
+        is_within_limit = false;
+      }
+    }
+    if( is_within_limit ) {
+      return SPLINE_SUCCESS;
+    }
+    if( iteration >= max_iteration ) {
+      return SPLINE_LIMIT_EXCEEDED;
+    }
+    // re-solve with the stretched interval times
+    TPQueue tp_queue;
+    double time = start_time;
+    for( std::size_t i=0; i < point_num; i++ ) {
+      tp_queue.push( TimePosition( time, positions[i] ) );
+      if( i + 1 < point_num ) {
+        time += dT_list[i];
+      }
+    }
+    const RetCode retcode = generate_path( tp_queue, vs, vf );
+    if( retcode != SPLINE_SUCCESS ) {
+      return retcode;
+    }
+  } // End of for( iteration )
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////
+
+RetCode CubicSplineInterpolator::tridiagonal_matrix_eq_solver(
+          std::vector<double> d, const std::vector<double>& u,
+          const std::vector<double>& l, std::vector<double> p,
+          std::vector<double>& out_solved_x ) {
+  // the same solver as the kernel of BasicCubicSpline
+  return g_tridiagonal_solve( d, u, l, p, out_solved_x );
 }
@@ -0,0 +1,151 @@
+#include "feed_override_controller.hpp"
+#include "spline_interpolator.hpp"
+
+#include <math.h>
+
+using namespace interp;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+FeedOverrideController::FeedOverrideController() :
+  interpolator_(NULL), max_rate_(1.0), max_rate_change_(4.0),
+  target_(1.0), ratio_(1.0), rate_(0.0),
+  path_time_(0.0), finish_time_(0.0), start_time_(0.0), elapsed_time_(0.0) {
+}
+
+
+RetCode FeedOverrideController::set_limit( const double& max_rate,
+                                           const double& max_rate_change ) {
+  if( !( max_rate > 0.0 ) || !( max_rate_change > 0.0 ) ) {
+    return SPLINE_INVALID_ARGUMENT_VALUE_ZERO;
+  }
+  max_rate_        = max_rate;
+  max_rate_change_ = max_rate_change;
+  return SPLINE_SUCCESS;
+}
+
+
+RetCode FeedOverrideController::start( const SplineInterpolator& interpolator,
+                                       const double&             ratio ) {
+  if( !( ratio >= 0.0 ) ) {
+    return SPLINE_INVALID_ARGUMENT_VALUE_ZERO;
+  }
+  try {
+    start_time_  = interpolator.start_time();
+    finish_time_ = interpolator.finish_time();
+  } catch( const NotSplineGenerated& e ) {
+    interpolator_ = NULL;
+    return SPLINE_SEGMENT_NOT_GENERATED;
+  }
+  interpolator_ = &interpolator;
+  target_       = ratio;
+  ratio_        = ratio;
+  rate_         = 0.0;
+  path_time_    = start_time_;
+  elapsed_time_ = 0.0;
+  return SPLINE_SUCCESS;
+}
+
+
+RetCode FeedOverrideController::set_override( const double& ratio ) {
+  if( !( ratio >= 0.0 ) ) {
+    return SPLINE_INVALID_ARGUMENT_VALUE_ZERO;
+  }
+  target_ = ratio;
+  return SPLINE_SUCCESS;
+}
+
+
+RetCode FeedOverrideController::step( const double& dT, TimePVA& tpva ) {
+  if( interpolator_ == NULL ) {
+    return SPLINE_UNINITIALIZED_INTERPOLATOR;
+  }
+  if( !( dT > 0.0 ) ) {
+    return SPLINE_INVALID_INPUT_INTERVAL_TIME_DT;
+  }
+  // tau += integral of s(t) = s0 + v0 t + j t^2 / 2 over the tick
+  const double s0 = ratio_;
+  const double v0 = rate_;
+  const double j  = advance_ratio( dT );
+  path_time_ += dT * ( s0 + dT * ( 0.5 * v0 + dT * j / 6.0 ) );
+  if( path_time_ > finish_time_ ) {
+    path_time_ = finish_time_;
+  }
+  elapsed_time_ += dT;
+
+  const TimePVA path_tpva = interpolator_->pop( path_time_ );
+  tpva.time  = start_time_ + elapsed_time_;
+  tpva.P.pos = path_tpva.P.pos;
+  tpva.P.vel = ratio_ * path_tpva.P.vel;
+  tpva.P.acc = ratio_ * ratio_ * path_tpva.P.acc + rate_ * path_tpva.P.vel;
+  return SPLINE_SUCCESS;
+}
+
+
+const double FeedOverrideController::override_ratio() const {
+  return ratio_;
+}
+
+
+const double FeedOverrideController::override_rate() const {
+  return rate_;
+}
+
+
+const double FeedOverrideController::target_override() const {
+  return target_;
+}
+
+
+const double FeedOverrideController::path_time() const {
+  return path_time_;
+}
+
+
+const double FeedOverrideController::elapsed_time() const {
+  return elapsed_time_;
+}
+
+
+const bool FeedOverrideController::is_finished() const {
+  return interpolator_ != NULL && path_time_ >= finish_time_;
+}
+
+
+const double FeedOverrideController::advance_ratio( const double& dT ) {
+  const double max_change = max_rate_change_ * dT;
+  const double s0 = ratio_;
+  const double v0 = rate_;
+
+  // the rate at the end of the tick, from which the ratio stops at the target
+  // by decreasing the rate at the maximum change: v1^2 / (2 J) + v1 dT / 2 = e
+  const double e     = target_ - s0 - 0.5 * v0 * dT;
+  const double speed = -0.5 * max_change
+                       + sqrt( 0.25 * max_change * max_change + 2.0 * max_rate_change_ * fabs( e ) );
+  double v1 = ( e >= 0.0 ) ? speed : -speed;
+  if( v1 > v0 + max_change ) {
+    v1 = v0 + max_change;
+  } else if( v1 < v0 - max_change ) {
+    v1 = v0 - max_change;
+  }
+  if( v1 > max_rate_ ) {
+    v1 = max_rate_;
+  } else if( v1 < -max_rate_ ) {
+    v1 = -max_rate_;
+  }
+  const double j = ( v1 - v0 ) / dT;
+
+  double s1 = s0 + 0.5 * ( v0 + v1 ) * dT;
+  // land on the target when the ratio reaches it at a rate stoppable in one tick
+  if( ( target_ - s0 ) * ( target_ - s1 ) <= 0.0 && fabs( v1 ) <= max_change ) {
+    s1 = target_;
+    v1 = 0.0;
+  }
+  if( s1 < 0.0 ) {
+    s1 = 0.0;
+    v1 = 0.0;
+  }
+  ratio_ = s1;
+  rate_  = v1;
+  return j;
+}
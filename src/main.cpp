@@ -1,14 +1,192 @@
 #include "spline_interpolator.hpp"
+#include "spline_thread_pool.hpp"
+#include "trajectory_baker.hpp"
+#include "waypoint_loader.hpp"
 #include <stdlib.h>
+#include <unistd.h> // for getopt
+#include <time.h>
+#include <cstdio>
+#include <cstring>
 
 using namespace interp;
 
+namespace {
+
+/// print the usage
+/// @param[in] name the name of command
+void print_usage( const char* name ) {
+  const BakeConfig config;
+  std::fprintf( stderr,
+    "usage: %s [options] waypoint_file...\n"
+    "  bake waypoint files (CSV) into trajectories sampled at every control cycle.\n"
+    "  output: {output_dir}/{basename}.csv (or .bin) of rows time,[pos,vel,acc] x axes\n"
+    "\n"
+    "  -i cubic|trapezoid  interpolator (default: cubic)\n"
+    "  -c CYCLE            control cycle [s] (default: %g)\n"
+    "  -t COLUMN           index of time column (default: none, see -u)\n"
+    "  -u INTERVAL         time interval between waypoints without -t [s] (default: %g)\n"
+    "  -p COLUMNS          comma separated indices of position columns (default: all but time)\n"
+    "  -f csv|bin          output format (default: csv)\n"
+    "  -o DIR              output directory (default: %s)\n"
+    "  -j THREADS          the number of threads (default: 0 -> online processors)\n"
+    "  -b                  write on a background writer thread\n"
+    "  -A A_LIMIT          trapezoid: acceleration limit (default: %g)\n"
+    "  -D D_LIMIT          trapezoid: deceleration limit (default: %g)\n"
+    "  -V V_LIMIT          trapezoid: velocity limit (default: %g)\n"
+    "  -S ASR              trapezoid: rounding ratio of acceleration (default: %g)\n"
+    "  -s DSR              trapezoid: rounding ratio of deceleration (default: %g)\n"
+    "  -R RATIO            trapezoid: ratio of lower to upper acceleration (default: %g)\n"
+    "  -h                  print this help\n",
+    name, config.cycle, config.waypoint_interval, config.output_dir.c_str(),
+    config.trapezoid.a_limit, config.trapezoid.d_limit, config.trapezoid.v_limit,
+    config.trapezoid.asr, config.trapezoid.dsr, config.trapezoid.ratio_acc_dec );
+}
+
+/// parse the number
+/// @param[in]  text  source text
+/// @param[out] value parsed value
+/// @return false if the text is not a number
+bool parse_double( const char* text, double& value ) {
+  char* end = NULL;
+  value = strtod( text, &end );
+  return ( end != text && *end == '\0' );
+}
+
+/// parse the index
+/// @param[in]  text  source text
+/// @param[out] index parsed index
+/// @return false if the text is not an index
+bool parse_index( const char* text, std::size_t& index ) {
+  char* end = NULL;
+  const long value = strtol( text, &end, 10 );
+  index = static_cast<std::size_t>( value );
+  return ( end != text && *end == '\0' && value >= 0 );
+}
+
+/// parse comma separated indices
+/// @param[in]  text    source text
+/// @param[out] indices parsed indices
+/// @return false if the text is not indices
+bool parse_indices( const char* text, std::vector<std::size_t>& indices ) {
+  indices.clear();
+  std::string field;
+  for( const char* c=text; ; c++ ) {
+    if( *c == ',' || *c == '\0' ) {
+      std::size_t index;
+      if( !parse_index( field.c_str(), index ) ) {
+        return false;
+      }
+      indices.push_back( index );
+      field.clear();
+      if( *c == '\0' ) {
+        break;
+      }
+    } else {
+      field += *c;
+    }
+  }
+  return true;
+}
+
+/// current monotonic time
+/// @return [sec]
+double now_sec() {
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec + ts.tv_nsec * 1.0e-9;
+}
+
+} // End of namespace
+
+
 int main(int argc, char* argv[]) {
-  (void)argc;
-  (void)argv;
+  BakeConfig config;
+  std::size_t thread_num = 0;
+  bool is_valid = true;
+
+  int opt;
+  while( ( opt = getopt( argc, argv, "i:c:t:u:p:f:o:j:bA:D:V:S:s:R:h" ) ) != -1 ) {
+    switch( opt ) {
+    case 'i':
+      if( std::strcmp( optarg, "cubic" ) == 0 ) {
+        config.interpolator = BAKE_CUBIC;
+      } else if( std::strcmp( optarg, "trapezoid" ) == 0 ) {
+        config.interpolator = BAKE_TRAPEZOID;
+      } else {
+        is_valid = false;
+      }
+      break;
+    case 'c': is_valid = is_valid && parse_double( optarg, config.cycle );                 break;
+    case 't': is_valid = is_valid && parse_index( optarg, config.time_column );            break;
+    case 'u': is_valid = is_valid && parse_double( optarg, config.waypoint_interval );     break;
+    case 'p': is_valid = is_valid && parse_indices( optarg, config.position_columns );     break;
+    case 'o': config.output_dir = optarg;                                                  break;
+    case 'j': is_valid = is_valid && parse_index( optarg, thread_num );                    break;
+    case 'b': config.background = true;                                                    break;
+    case 'A': is_valid = is_valid && parse_double( optarg, config.trapezoid.a_limit );       break;
+    case 'D': is_valid = is_valid && parse_double( optarg, config.trapezoid.d_limit );       break;
+    case 'V': is_valid = is_valid && parse_double( optarg, config.trapezoid.v_limit );       break;
+    case 'S': is_valid = is_valid && parse_double( optarg, config.trapezoid.asr );           break;
+    case 's': is_valid = is_valid && parse_double( optarg, config.trapezoid.dsr );           break;
+    case 'R': is_valid = is_valid && parse_double( optarg, config.trapezoid.ratio_acc_dec ); break;
+    case 'f':
+      if( std::strcmp( optarg, "csv" ) == 0 ) {
+        config.format = EXPORT_CSV;
+      } else if( std::strcmp( optarg, "bin" ) == 0 ) {
+        config.format = EXPORT_BINARY;
+      } else {
+        is_valid = false;
+      }
+      break;
+    case 'h':
+      print_usage( argv[0] );
+      exit(EXIT_SUCCESS);
+    default:
+      is_valid = false;
+      break;
+    }
+  }
+  if( !is_valid || optind >= argc ) {
+    print_usage( argv[0] );
+    exit(EXIT_FAILURE);
+  }
+
+  const std::vector<std::string> input_paths( argv + optind, argv + argc );
+  const TrajectoryBaker baker( config );
+  SplineThreadPool thread_pool( thread_num );
+  std::vector<BakeResult> results;
+
+  const double start_sec = now_sec();
+  const RetCode ret = baker.bake( input_paths, results, &thread_pool );
+  const double wall_sec = now_sec() - start_sec;
 
+  // per-file statistics
+  std::size_t total_samples = 0;
+  std::size_t failed_num    = 0;
+  for( std::size_t i=0; i < results.size(); i++ ) {
+    const BakeResult& result = results[i];
+    if( result.status != SPLINE_SUCCESS ) {
+      std::fprintf( stderr, "%s: error(%d): %s\n",
+                    result.input_path.c_str(), (int)result.status, result.message.c_str() );
+      failed_num++;
+      continue;
+    }
+    const double total_sec = result.total_sec();
+    std::printf( "%s -> %s: %lu waypoints, %lu axes, %lu samples, "
+                 "load %.3f ms, plan %.3f ms, export %.3f ms, %.0f samples/s\n",
+                 result.input_path.c_str(), result.output_path.c_str(),
+                 (unsigned long)result.waypoint_size, (unsigned long)result.axis_size,
+                 (unsigned long)result.sample_size,
+                 result.load_sec * 1.0e3, result.plan_sec * 1.0e3, result.export_sec * 1.0e3,
+                 ( total_sec > 0.0 ) ? result.sample_size / total_sec : 0.0 );
+    total_samples += result.sample_size;
+  }
 
-  std::cout << "End." << std::endl;
+  // total statistics
+  std::printf( "%lu files (%lu failed), %lu samples, %lu threads, %.3f s, %.0f samples/s\n",
+               (unsigned long)results.size(), (unsigned long)failed_num,
+               (unsigned long)total_samples, (unsigned long)thread_pool.thread_num(),
+               wall_sec, ( wall_sec > 0.0 ) ? total_samples / wall_sec : 0.0 );
 
-  exit(EXIT_SUCCESS);
+  exit( ( ret == SPLINE_SUCCESS ) ? EXIT_SUCCESS : EXIT_FAILURE );
 }
@@ -0,0 +1,122 @@
+#include "monotonic_arena.hpp"
+
+using namespace interp;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+const std::size_t MonotonicArena::DEFAULT_CHUNK_SIZE;
+const std::size_t MonotonicArena::MAX_ALIGNMENT;
+
+
+MonotonicArena::MonotonicArena( const std::size_t& chunk_size ) :
+  chunk_index_(0),
+  offset_(0),
+  chunk_size_( ( chunk_size > 0 ) ? chunk_size : DEFAULT_CHUNK_SIZE ),
+  heap_allocation_num_(0) {
+}
+
+
+MonotonicArena::~MonotonicArena() {
+  release();
+}
+
+
+void* MonotonicArena::allocate( const std::size_t& size, const std::size_t& alignment ) {
+  const std::size_t mask = ( alignment > 0 ) ? alignment - 1 : 0;
+  // search the current and following (unused) chunks
+  for( std::size_t index=chunk_index_; index < chunks_.size(); index++ ) {
+    const Chunk&      chunk  = chunks_[index];
+    const std::size_t used   = ( index == chunk_index_ ) ? offset_ : 0;
+    const std::size_t head   = reinterpret_cast<std::size_t>( chunk.data + used );
+    const std::size_t offset = used + ( ( ( head + mask ) & ~mask ) - head );
+    if( offset <= chunk.size && size <= chunk.size - offset ) {
+      chunk_index_ = index;
+      offset_      = offset + size;
+      return chunk.data + offset;
+    }
+  }
+
+  // new chunk of twice the size of the last one (at least enough for the request)
+  std::size_t new_size = chunks_.empty() ? chunk_size_ : chunks_.back().size * 2;
+  if( new_size < size + mask ) {
+    new_size = size + mask;
+  }
+  Chunk chunk;
+  chunk.data = static_cast<char*>( ::operator new( new_size ) );
+  chunk.size = new_size;
+  try {
+    chunks_.push_back( chunk );
+  } catch( ... ) {
+    ::operator delete( chunk.data );
+    throw;
+  }
+  heap_allocation_num_++;
+
+  const std::size_t head   = reinterpret_cast<std::size_t>( chunk.data );
+  const std::size_t offset = ( ( head + mask ) & ~mask ) - head;
+  chunk_index_ = chunks_.size() - 1;
+  offset_      = offset + size;
+  return chunk.data + offset;
+}
+
+
+const MonotonicArena::Mark MonotonicArena::mark() const {
+  Mark position;
+  position.chunk_index = chunk_index_;
+  position.offset      = offset_;
+  return position;
+}
+
+
+void MonotonicArena::rewind( const Mark& position ) {
+  if( position.chunk_index > chunk_index_
+      || ( position.chunk_index == chunk_index_ && position.offset > offset_ ) ) {
+    // the position is ahead of the current one
+    return;
+  }
+  chunk_index_ = position.chunk_index;
+  offset_      = position.offset;
+}
+
+
+void MonotonicArena::reset() {
+  rewind( Mark() );
+}
+
+
+void MonotonicArena::release() {
+  for( std::size_t i=0; i < chunks_.size(); i++ ) {
+    ::operator delete( chunks_[i].data );
+  }
+  chunks_.clear();
+  chunk_index_ = 0;
+  offset_      = 0;
+}
+
+
+const std::size_t MonotonicArena::used_size() const {
+  std::size_t size = offset_;
+  for( std::size_t i=0; i < chunk_index_; i++ ) {
+    size += chunks_[i].size;
+  }
+  return size;
+}
+
+
+const std::size_t MonotonicArena::capacity() const {
+  std::size_t size = 0;
+  for( std::size_t i=0; i < chunks_.size(); i++ ) {
+    size += chunks_[i].size;
+  }
+  return size;
+}
+
+
+const std::size_t MonotonicArena::chunk_num() const {
+  return chunks_.size();
+}
+
+
+const std::size_t MonotonicArena::heap_allocation_num() const {
+  return heap_allocation_num_;
+}
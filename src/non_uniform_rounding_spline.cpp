@@ -1,7 +1,109 @@
 #include "non_uniform_rounding_spline.hpp"
+#include "spline_thread_pool.hpp"
+#include "monotonic_arena.hpp"
 
 using namespace interp;
 
+namespace {
+
+/// pass 1 : unit chord vector (dt, dx) / |(dt, dx)| of each segment
+class ChordTask : public RangeTask {
+public:
+  ChordTask( const double* t, const double* x, double* unit_t, double* unit_x ) :
+    t_(t), x_(x), unit_t_(unit_t), unit_x_(unit_x) {
+  }
+
+  virtual void run( const std::size_t& begin, const std::size_t& end ) {
+    const double* t      = t_;
+    const double* x      = x_;
+    double*       unit_t = unit_t_;
+    double*       unit_x = unit_x_;
+    for( std::size_t i=begin; i < end; i++ ) {
+      const double dt       = t[i+1] - t[i];
+      const double dx       = x[i+1] - x[i];
+      const double distance = sqrt( dt*dt + dx*dx );
+      unit_t[i] = dt / distance;
+      unit_x[i] = dx / distance;
+    }
+  }
+
+private:
+  const double* t_;
+  const double* x_;
+  double*       unit_t_;
+  double*       unit_x_;
+};
+
+/// pass 2 : velocity of each intermediate point from the neighboring unit chords
+class VelocityTask : public RangeTask {
+public:
+  VelocityTask( const double* unit_t, const double* unit_x, double* v ) :
+    unit_t_(unit_t), unit_x_(unit_x), v_(v) {
+  }
+
+  virtual void run( const std::size_t& begin, const std::size_t& end ) {
+    const double* unit_t = unit_t_;
+    const double* unit_x = unit_x_;
+    double*       v      = v_;
+    for( std::size_t i=begin; i < end; i++ ) {
+      v[i] = ( unit_x[i] + unit_x[i-1] ) / ( unit_t[i] + unit_t[i-1] );
+    }
+  }
+
+private:
+  const double* unit_t_;
+  const double* unit_x_;
+  double*       v_;
+};
+
+/// velocities of all points over flat arrays
+/// @param[in]  point_size  the number of points (>= 2)
+/// @param[in]  times       clock times of points
+/// @param[in]  positions   positions of points
+/// @param[out] velocities  velocities of points
+/// @param[out] unit_t      work area of point_size - 1 elements
+/// @param[out] unit_x      work area of point_size - 1 elements
+/// @param[in]  vs          start velocity
+/// @param[in]  vf          finish velocity
+/// @param[in]  thread_pool thread pool (NULL: serial)
+/// @return the same as NonUniformRoundingSpline::compute_velocities()
+RetCode compute_velocities_on( const std::size_t& point_size,
+                               const double*      times,
+                               const double*      positions,
+                               double*            velocities,
+                               double*            unit_t,
+                               double*            unit_x,
+                               const double&      vs,
+                               const double&      vf,
+                               SplineThreadPool*  thread_pool ) {
+  for( std::size_t i=1; i < point_size; i++ ) {
+    if( times[i] <= times[i-1] ) {
+      return SPLINE_INVALID_INPUT_TIME;
+    }
+  }
+
+  velocities[0]            = vs;
+  velocities[point_size-1] = vf;
+  if( point_size == 2 ) {
+    return SPLINE_SUCCESS;
+  }
+
+  // each chord length is calculated only once and shared by both end points
+  ChordTask    chord_task( times, positions, unit_t, unit_x );
+  VelocityTask velocity_task( unit_t, unit_x, velocities );
+
+  if( thread_pool == NULL ) {
+    chord_task.run( 0, point_size - 1 );
+    velocity_task.run( 1, point_size - 1 );
+  } else {
+    thread_pool->parallel_for( 0, point_size - 1, chord_task );
+    thread_pool->parallel_for( 1, point_size - 1, velocity_task );
+  }
+  return SPLINE_SUCCESS;
+}
+
+} // End of namespace
+
 NonUniformRoundingSpline::NonUniformRoundingSpline() {
 }
 
@@ -27,13 +129,26 @@ NonUniformRoundingSpline::~NonUniformRoundingSpline() {
   this->clear();
 };
 
-NonUniformRoundingSpline NonUniformRoundingSpline::operator=(
-                           const NonUniformRoundingSpline& src
-                         ) {
-  NonUniformRoundingSpline dest(src);
-  tpva_buffer_ = dest.tpva_buffer_;
+NonUniformRoundingSpline& NonUniformRoundingSpline::operator=(
+                            const NonUniformRoundingSpline& src
+                          ) {
+  tpva_buffer_ = src.tpva_buffer_;
+  return *this;
+}
+
+#ifdef SPLINE_CXX11
+NonUniformRoundingSpline::NonUniformRoundingSpline(
+                           NonUniformRoundingSpline&& src ) SPLINE_NOEXCEPT :
+  tpva_buffer_( std::move( src.tpva_buffer_ ) )
+{
+}
+
+NonUniformRoundingSpline& NonUniformRoundingSpline::operator=(
+                            NonUniformRoundingSpline&& src ) SPLINE_NOEXCEPT {
+  tpva_buffer_ = std::move( src.tpva_buffer_ );
   return *this;
 }
+#endif
 
 double NonUniformRoundingSpline::calculate_velocity( const TimePVA& tp0,
                                                      const TimePVA& tp1,
@@ -73,6 +188,65 @@ double NonUniformRoundingSpline::calculate_velocity( const TimePVA& tp0,
 }
 
 
+RetCode NonUniformRoundingSpline::compute_velocities(
+                                    const std::vector<double>& times,
+                                    const std::vector<double>& positions,
+                                    std::vector<double>&       out_velocities,
+                                    const double&              vs,
+                                    const double&              vf,
+                                    SplineThreadPool*          thread_pool ) {
+  const std::size_t point_size = times.size();
+  if( point_size < 2 || positions.size() != point_size ) {
+    return SPLINE_INVALID_QUEUE_SIZE;
+  }
+  out_velocities.resize( point_size );
+  std::vector<double> unit_t( point_size - 1 );
+  std::vector<double> unit_x( point_size - 1 );
+  return compute_velocities_on( point_size, &times[0], &positions[0], &out_velocities[0],
+                                &unit_t[0], &unit_x[0], vs, vf, thread_pool );
+}
+
+
+RetCode NonUniformRoundingSpline::compute_tpva_queue( const TPQueue&    tp_queue,
+                                                      TPVAQueue&        out_tpva_queue,
+                                                      const double&     vs,
+                                                      const double&     vf,
+                                                      SplineThreadPool* thread_pool,
+                                                      MonotonicArena*   arena ) {
+  const std::size_t point_size = tp_queue.size();
+  if( point_size < 2 ) {
+    return SPLINE_INVALID_QUEUE_SIZE;
+  }
+
+  // scratch buffers on the arena (heap if not set), released at the end of the scope
+  ArenaScope scope( arena );
+  const ArenaAllocator<double> alloc( arena );
+  ArenaVector<double>::type times( point_size, 0.0, alloc );
+  ArenaVector<double>::type positions( point_size, 0.0, alloc );
+  for( std::size_t i=0; i < point_size; i++ ) {
+    const TimePosition& tp = tp_queue.at( i );
+    times[i]     = tp.time;
+    positions[i] = tp.value;
+  }
+
+  ArenaVector<double>::type velocities( point_size, 0.0, alloc );
+  ArenaVector<double>::type unit_t( point_size - 1, 0.0, alloc );
+  ArenaVector<double>::type unit_x( point_size - 1, 0.0, alloc );
+  RetCode retcode = compute_velocities_on( point_size, &times[0], &positions[0], &velocities[0],
+                                           &unit_t[0], &unit_x[0], vs, vf, thread_pool );
+  if( retcode != SPLINE_SUCCESS ) {
+    return retcode;
+  }
+
+  ArenaVector<PosVelAcc>::type pva_list( point_size, PosVelAcc(),
+                                         ArenaAllocator<PosVelAcc>( arena ) );
+  for( std::size_t i=0; i < point_size; i++ ) {
+    pva_list[i] = PosVelAcc( positions[i], velocities[i], 0.0 );
+  }
+  return out_tpva_queue.assign( times, pva_list );
+}
+
+
 RetCode NonUniformRoundingSpline::push_without_velocity_change(
                                     const double& clock_time,
                                     const double& position ) {
@@ -108,14 +282,15 @@ RetCode NonUniformRoundingSpline::push( const double& clock_time,
   const unsigned int buffer_size = tpva_buffer_.size();
 
   if ( buffer_size >= 3 ) {
-    PosVelAcc pva( tpva_buffer_.get( buffer_size-2 ).P.pos,     // position
+    const TimePVA& tpva1 = tpva_buffer_.at( buffer_size-2 );
+    PosVelAcc pva( tpva1.P.pos,                                 // position
                    this->calculate_velocity(
-                           tpva_buffer_.get( buffer_size-3 ),
-                           tpva_buffer_.get( buffer_size-2 ),
-                           tpva_buffer_.get( buffer_size-1 ) ), // velocity
+                           tpva_buffer_.at( buffer_size-3 ),
+                           tpva1,
+                           tpva_buffer_.at( buffer_size-1 ) ),  // velocity
                    0.0 );                                       // acceleration
 
-    TimePVA tpva( tpva_buffer_.get( buffer_size-2 ).time,       // time
+    TimePVA tpva( tpva1.time,                                   // time
                   pva );                                        // PosVelAcc
 
     RetCode ret_set = tpva_buffer_.set( buffer_size-2, tpva );
@@ -137,14 +312,15 @@ RetCode NonUniformRoundingSpline::push( const TimePVA& time_pva ) {
   const unsigned int buffer_size = tpva_buffer_.size();
 
   if ( buffer_size >= 3 ) {
-    PosVelAcc pva( tpva_buffer_.get( buffer_size-2 ).P.pos,     // position
+    const TimePVA& tpva1 = tpva_buffer_.at( buffer_size-2 );
+    PosVelAcc pva( tpva1.P.pos,                                 // position
                    this->calculate_velocity(
-                           tpva_buffer_.get( buffer_size-3 ),
-                           tpva_buffer_.get( buffer_size-2 ),
-                           tpva_buffer_.get( buffer_size-1 ) ), // velocity
+                           tpva_buffer_.at( buffer_size-3 ),
+                           tpva1,
+                           tpva_buffer_.at( buffer_size-1 ) ),  // velocity
                    0.0 );                                       // acceleration
 
-    TimePVA tpva( tpva_buffer_.get( buffer_size-2 ).time,       // time
+    TimePVA tpva( tpva1.time,                                   // time
                   pva );                                        // PosVelAcc
 
     RetCode ret_set = tpva_buffer_.set( buffer_size-2, tpva );
@@ -214,19 +390,19 @@ RetCode NonUniformRoundingSpline::force_set_velocity( const std::size_t& index,
 }
 
 
-const TPVAQueue NonUniformRoundingSpline::tpva_queue() const {
+const TPVAQueue& NonUniformRoundingSpline::tpva_queue() const {
   return tpva_buffer_;
 }
 
-const TimePVA NonUniformRoundingSpline::get( const std::size_t& index ) const {
+const TimePVA& NonUniformRoundingSpline::get( const std::size_t& index ) const {
   return tpva_buffer_.get(index);
 }
 
-const TimePVA NonUniformRoundingSpline::front() const {
+const TimePVA& NonUniformRoundingSpline::front() const {
   return tpva_buffer_.front();
 }
 
-const TimePVA NonUniformRoundingSpline::back() const {
+const TimePVA& NonUniformRoundingSpline::back() const {
   return tpva_buffer_.back();
 }
 
@@ -253,7 +429,7 @@ unsigned int NonUniformRoundingSpline::size() {
 }
 
 const double NonUniformRoundingSpline::dT( const std::size_t& index ) const
-  throw(InvalidIndexAccess) {
+  SPLINE_THROW_SPEC(InvalidIndexAccess) {
 
   return tpva_buffer_.dT(index);
 }
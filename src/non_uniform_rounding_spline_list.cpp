@@ -0,0 +1,349 @@
+#include "non_uniform_rounding_spline_list.hpp"
+#include "spline_thread_pool.hpp"
+
+using namespace interp;
+
+namespace {
+
+/// pass 1 : joint unit chord (dt, dx_0, ..., dx_N-1) / d of each segment
+class ChordListTask : public RangeTask {
+public:
+  ChordListTask( const std::vector<double>&                times,
+                 const std::vector< std::vector<double> >& positions,
+                 std::vector<double>&                      unit_t,
+                 std::vector< std::vector<double> >&       unit_x ) :
+    times_(times), positions_(positions), unit_t_(unit_t), unit_x_(unit_x) {
+  }
+
+  virtual void run( const std::size_t& begin, const std::size_t& end ) {
+    const std::size_t axis_size = positions_.size();
+    for( std::size_t i=begin; i < end; i++ ) {
+      const double dt = times_[i+1] - times_[i];
+      double square_sum = dt*dt;
+      for( std::size_t k=0; k < axis_size; k++ ) {
+        const double dx = positions_[k][i+1] - positions_[k][i];
+        square_sum += dx*dx;
+      }
+      const double distance = sqrt( square_sum );
+      unit_t_[i] = dt / distance;
+      for( std::size_t k=0; k < axis_size; k++ ) {
+        unit_x_[k][i] = ( positions_[k][i+1] - positions_[k][i] ) / distance;
+      }
+    }
+  }
+
+private:
+  const std::vector<double>&                times_;
+  const std::vector< std::vector<double> >& positions_;
+  std::vector<double>&                      unit_t_;
+  std::vector< std::vector<double> >&       unit_x_;
+};
+
+/// pass 2 : velocities of all axes of each intermediate point
+class VelocityListTask : public RangeTask {
+public:
+  VelocityListTask( const std::vector<double>&                unit_t,
+                    const std::vector< std::vector<double> >& unit_x,
+                    std::vector< std::vector<double> >&       velocities ) :
+    unit_t_(unit_t), unit_x_(unit_x), velocities_(velocities) {
+  }
+
+  virtual void run( const std::size_t& begin, const std::size_t& end ) {
+    for( std::size_t k=0; k < unit_x_.size(); k++ ) {
+      const double* unit_t = &unit_t_[0];
+      const double* unit_x = &unit_x_[k][0];
+      double*       v      = &velocities_[k][0];
+      for( std::size_t i=begin; i < end; i++ ) {
+        v[i] = ( unit_x[i] + unit_x[i-1] ) / ( unit_t[i] + unit_t[i-1] );
+      }
+    }
+  }
+
+private:
+  const std::vector<double>&                unit_t_;
+  const std::vector< std::vector<double> >& unit_x_;
+  std::vector< std::vector<double> >&       velocities_;
+};
+
+} // End of namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+NonUniformRoundingSplineList::NonUniformRoundingSplineList() :
+  axis_size_(0), last_chord_time_(0.0), has_last_chord_(false) {
+}
+
+NonUniformRoundingSplineList::NonUniformRoundingSplineList(
+                               const NonUniformRoundingSplineList& src ) :
+  tpva_list_buffer_( src.tpva_list_buffer_ ),
+  axis_size_       ( src.axis_size_        ),
+  last_unit_chord_ ( src.last_unit_chord_  ),
+  last_chord_time_ ( src.last_chord_time_  ),
+  has_last_chord_  ( src.has_last_chord_   ) {
+}
+
+NonUniformRoundingSplineList::~NonUniformRoundingSplineList() {
+}
+
+NonUniformRoundingSplineList& NonUniformRoundingSplineList::operator=(
+                                const NonUniformRoundingSplineList& src ) {
+  if( this == &src ) {
+    return *this;
+  }
+  if( src.tpva_list_buffer_.size() > 0 ) {
+    tpva_list_buffer_ = src.tpva_list_buffer_;
+  } else {
+    tpva_list_buffer_.clear();
+  }
+  axis_size_       = src.axis_size_;
+  last_unit_chord_ = src.last_unit_chord_;
+  last_chord_time_ = src.last_chord_time_;
+  has_last_chord_  = src.has_last_chord_;
+  return *this;
+}
+
+#ifdef SPLINE_CXX11
+NonUniformRoundingSplineList::NonUniformRoundingSplineList(
+                               NonUniformRoundingSplineList&& src ) SPLINE_NOEXCEPT :
+  tpva_list_buffer_( std::move( src.tpva_list_buffer_ ) ),
+  axis_size_       ( src.axis_size_                    ),
+  last_unit_chord_ ( std::move( src.last_unit_chord_ ) ),
+  last_chord_time_ ( src.last_chord_time_              ),
+  has_last_chord_  ( src.has_last_chord_               ) {
+}
+
+NonUniformRoundingSplineList& NonUniformRoundingSplineList::operator=(
+                                NonUniformRoundingSplineList&& src ) SPLINE_NOEXCEPT {
+  tpva_list_buffer_ = std::move( src.tpva_list_buffer_ );
+  axis_size_        = src.axis_size_;
+  last_unit_chord_  = std::move( src.last_unit_chord_ );
+  last_chord_time_  = src.last_chord_time_;
+  has_last_chord_   = src.has_last_chord_;
+  return *this;
+}
+#endif
+
+
+RetCode NonUniformRoundingSplineList::compute_velocities(
+                                const std::vector<double>&                times,
+                                const std::vector< std::vector<double> >& positions,
+                                std::vector< std::vector<double> >&       out_velocities,
+                                const std::vector<double>&                vs,
+                                const std::vector<double>&                vf,
+                                SplineThreadPool*                         thread_pool ) {
+  const std::size_t point_size = times.size();
+  const std::size_t axis_size  = positions.size();
+  if( point_size < 2
+      || ( !vs.empty() && vs.size() != axis_size )
+      || ( !vf.empty() && vf.size() != axis_size ) ) {
+    return SPLINE_INVALID_QUEUE_SIZE;
+  }
+  for( std::size_t k=0; k < axis_size; k++ ) {
+    if( positions[k].size() != point_size ) {
+      return SPLINE_INVALID_QUEUE_SIZE;
+    }
+  }
+  for( std::size_t i=1; i < point_size; i++ ) {
+    if( times[i] <= times[i-1] ) {
+      return SPLINE_INVALID_INPUT_TIME;
+    }
+  }
+
+  out_velocities.resize( axis_size );
+  for( std::size_t k=0; k < axis_size; k++ ) {
+    out_velocities[k].resize( point_size );
+    out_velocities[k][0]            = vs.empty() ? 0.0 : vs[k];
+    out_velocities[k][point_size-1] = vf.empty() ? 0.0 : vf[k];
+  }
+  if( point_size == 2 || axis_size == 0 ) {
+    return SPLINE_SUCCESS;
+  }
+
+  // one square root per chord, shared by all axes and both end points
+  std::vector<double>                unit_t( point_size - 1 );
+  std::vector< std::vector<double> > unit_x( axis_size, std::vector<double>( point_size - 1 ) );
+  ChordListTask    chord_task( times, positions, unit_t, unit_x );
+  VelocityListTask velocity_task( unit_t, unit_x, out_velocities );
+
+  if( thread_pool == NULL ) {
+    chord_task.run( 0, point_size - 1 );
+    velocity_task.run( 1, point_size - 1 );
+  } else {
+    thread_pool->parallel_for( 0, point_size - 1, chord_task );
+    thread_pool->parallel_for( 1, point_size - 1, velocity_task );
+  }
+  return SPLINE_SUCCESS;
+}
+
+
+RetCode NonUniformRoundingSplineList::compute_tpva_list_queue(
+                                const TPVAListQueue&       target_queue,
+                                TPVAListQueue&             out_tpva_queue,
+                                const std::vector<double>& vs,
+                                const std::vector<double>& vf,
+                                SplineThreadPool*          thread_pool ) {
+  const std::size_t point_size = target_queue.size();
+  if( point_size < 2 ) {
+    return SPLINE_INVALID_QUEUE_SIZE;
+  }
+  const std::size_t axis_size = target_queue.at( 0 ).value.size();
+
+  std::vector<double>                times( point_size );
+  std::vector< std::vector<double> > positions( axis_size, std::vector<double>( point_size ) );
+  for( std::size_t i=0; i < point_size; i++ ) {
+    const TimePVAList& tpva_list = target_queue.at( i );
+    if( tpva_list.value.size() != axis_size ) {
+      return SPLINE_INVALID_QUEUE_SIZE;
+    }
+    times[i] = tpva_list.time;
+    for( std::size_t k=0; k < axis_size; k++ ) {
+      positions[k][i] = tpva_list.value[k].pos;
+    }
+  }
+
+  std::vector< std::vector<double> > velocities;
+  RetCode retcode = compute_velocities( times, positions, velocities, vs, vf, thread_pool );
+  if( retcode != SPLINE_SUCCESS ) {
+    return retcode;
+  }
+
+  std::vector<PVAList> pva_lists( point_size );
+  for( std::size_t i=0; i < point_size; i++ ) {
+    pva_lists[i].resize( axis_size );
+    for( std::size_t k=0; k < axis_size; k++ ) {
+      pva_lists[i][k] = PosVelAcc( positions[k][i], velocities[k][i], 0.0 );
+    }
+  }
+  return out_tpva_queue.assign( times, pva_lists );
+}
+
+
+void NonUniformRoundingSplineList::calculate_unit_chord( const double&        time0,
+                                                         const PVAList&       pva_list0,
+                                                         const double&        time1,
+                                                         const PVAList&       pva_list1,
+                                                         std::vector<double>& out_unit ) {
+  const std::size_t axis_size = pva_list0.size();
+  out_unit.resize( axis_size + 1 );
+
+  const double dt = time1 - time0;
+  double square_sum = dt*dt;
+  for( std::size_t k=0; k < axis_size; k++ ) {
+    const double dx = pva_list1[k].pos - pva_list0[k].pos;
+    square_sum += dx*dx;
+  }
+  const double distance = sqrt( square_sum );
+  out_unit[0] = dt / distance;
+  for( std::size_t k=0; k < axis_size; k++ ) {
+    out_unit[k+1] = ( pva_list1[k].pos - pva_list0[k].pos ) / distance;
+  }
+}
+
+
+RetCode NonUniformRoundingSplineList::push( const double&              clock_time,
+                                            const std::vector<double>& positions ) {
+  PVAList pva_list;
+  pva_list.resize( positions.size() );
+  for( std::size_t k=0; k < positions.size(); k++ ) {
+    pva_list[k] = PosVelAcc( positions[k], 0.0, 0.0 );
+  }
+  return push( TimePVAList( clock_time, pva_list ) );
+}
+
+
+RetCode NonUniformRoundingSplineList::push( const TimePVAList& time_pva_list ) {
+
+  if( tpva_list_buffer_.size() > 0 && time_pva_list.value.size() != axis_size_ ) {
+    return SPLINE_INVALID_QUEUE_SIZE;
+  }
+
+  TimePVAList new_tpva_list( time_pva_list );
+  for( std::size_t k=0; k < new_tpva_list.value.size(); k++ ) {
+    new_tpva_list.value[k].vel = 0.0;
+    new_tpva_list.value[k].acc = 0.0;
+  }
+  RetCode ret_push = tpva_list_buffer_.push( new_tpva_list );
+  if( ret_push != SPLINE_SUCCESS ) {
+    return ret_push;
+  }
+  axis_size_ = new_tpva_list.value.size();
+
+  const std::size_t buffer_size = tpva_list_buffer_.size();
+  if( buffer_size < 2 ) {
+    has_last_chord_ = false;
+    return SPLINE_SUCCESS;
+  }
+
+  const TimePVAList& tpva_list1 = tpva_list_buffer_.at( buffer_size-2 );
+  const TimePVAList& tpva_list2 = tpva_list_buffer_.at( buffer_size-1 );
+
+  std::vector<double> unit_chord_12;
+  calculate_unit_chord( tpva_list1.time, tpva_list1.value,
+                        tpva_list2.time, tpva_list2.value,
+                        unit_chord_12 );
+
+  if( buffer_size >= 3 ) {
+    // reuse the chord which ends at the previous point
+    if( !has_last_chord_ || last_chord_time_ != tpva_list1.time ) {
+      const TimePVAList& tpva_list0 = tpva_list_buffer_.at( buffer_size-3 );
+      calculate_unit_chord( tpva_list0.time, tpva_list0.value,
+                            tpva_list1.time, tpva_list1.value,
+                            last_unit_chord_ );
+    }
+    TimePVAList tpva_list( tpva_list1 );
+    for( std::size_t k=0; k < axis_size_; k++ ) {
+      tpva_list.value[k].vel = ( unit_chord_12[k+1] + last_unit_chord_[k+1] )
+                               / ( unit_chord_12[0] + last_unit_chord_[0] );
+    }
+    RetCode ret_set = tpva_list_buffer_.set( buffer_size-2, tpva_list );
+    if( ret_set != SPLINE_SUCCESS ) {
+      return ret_set;
+    }
+  } // End of if( buffer_size >= 3 )
+
+  last_unit_chord_ = unit_chord_12;
+  last_chord_time_ = tpva_list2.time;
+  has_last_chord_  = true;
+
+  return SPLINE_SUCCESS;
+}
+
+
+const TPVAListQueue& NonUniformRoundingSplineList::tpva_list_queue() const {
+  return tpva_list_buffer_;
+}
+
+const TimePVAList& NonUniformRoundingSplineList::get( const std::size_t& index ) const {
+  return tpva_list_buffer_.get( index );
+}
+
+const TimePVAList& NonUniformRoundingSplineList::front() const {
+  return tpva_list_buffer_.front();
+}
+
+const TimePVAList& NonUniformRoundingSplineList::back() const {
+  return tpva_list_buffer_.back();
+}
+
+const TimePVAList NonUniformRoundingSplineList::pop() {
+  return tpva_list_buffer_.pop();
+}
+
+RetCode NonUniformRoundingSplineList::pop_delete() {
+  return tpva_list_buffer_.pop_delete();
+}
+
+void NonUniformRoundingSplineList::clear() {
+  tpva_list_buffer_.clear();
+  axis_size_      = 0;
+  has_last_chord_ = false;
+  last_unit_chord_.clear();
+}
+
+const std::size_t NonUniformRoundingSplineList::size() const {
+  return tpva_list_buffer_.size();
+}
+
+const std::size_t NonUniformRoundingSplineList::axis_size() const {
+  return axis_size_;
+}
@@ -7,6 +7,10 @@ using namespace interp;
 template
 class TimeQueue<double>;
 
+const bool ScalarTraits<int>::is_numeric;
+const bool ScalarTraits<float>::is_numeric;
+const bool ScalarTraits<double>::is_numeric;
+
 /////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -0,0 +1,304 @@
+#include "spline_executor.hpp"
+#include "spline_interpolator.hpp"
+
+using namespace interp;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+SplineJob::SplineJob() :
+  status_(SPLINE_NOT_RETURN) {
+}
+
+SplineJob::~SplineJob() {
+}
+
+const RetCode SplineJob::status() const {
+  return status_;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+SplineWorkerContext::SplineWorkerContext( SplineExecutor& executor,
+                                          const std::size_t& worker_index ) :
+  executor_(executor), worker_index_(worker_index) {
+}
+
+const std::size_t SplineWorkerContext::worker_index() const {
+  return worker_index_;
+}
+
+MonotonicArena* SplineWorkerContext::arena() const {
+  return &executor_.workers_[worker_index_]->state.arena;
+}
+
+void SplineWorkerContext::submit( SplineJob& job ) {
+  // count the job before it can be taken, and wake idle workers after it is visible
+  pthread_mutex_lock( &executor_.mutex_ );
+  executor_.remaining_num_++;
+  pthread_mutex_unlock( &executor_.mutex_ );
+  executor_.push_job( worker_index_, job );
+  pthread_mutex_lock( &executor_.mutex_ );
+  executor_.submit_sequence_++;
+  pthread_cond_broadcast( &executor_.idle_cond_ );
+  pthread_mutex_unlock( &executor_.mutex_ );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+GeneratePathJob::GeneratePathJob( SplineInterpolator& interpolator,
+                                  const TPQueue&      target_tp_queue,
+                                  SplineJob*          next ) :
+  interpolator_(interpolator),
+  target_tp_queue_(&target_tp_queue),
+  target_tpva_queue_(NULL),
+  next_(next) {
+}
+
+GeneratePathJob::GeneratePathJob( SplineInterpolator& interpolator,
+                                  const TPVAQueue&    target_tpva_queue,
+                                  SplineJob*          next ) :
+  interpolator_(interpolator),
+  target_tp_queue_(NULL),
+  target_tpva_queue_(&target_tpva_queue),
+  next_(next) {
+}
+
+RetCode GeneratePathJob::run( SplineWorkerContext& context ) {
+  // scratch buffers from the arena of the worker
+  MonotonicArena* const original_arena = interpolator_.arena();
+  interpolator_.set_arena( context.arena() );
+  RetCode retcode = SPLINE_SUCCESS;
+  try {
+    retcode = ( target_tp_queue_ != NULL ) ? interpolator_.generate_path( *target_tp_queue_ )
+                                           : interpolator_.generate_path( *target_tpva_queue_ );
+  } catch( ... ) {
+    interpolator_.set_arena( original_arena );
+    throw;
+  }
+  interpolator_.set_arena( original_arena );
+
+  if( retcode == SPLINE_SUCCESS && next_ != NULL ) {
+    context.submit( *next_ );
+  }
+  return retcode;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+SampleJob::SampleJob( const SplineInterpolator& interpolator,
+                      const double& ts, const double& dT, const std::size_t& size,
+                      double* pos, double* vel, double* acc ) :
+  interpolator_(interpolator),
+  ts_(ts), dT_(dT), size_(size),
+  pos_(pos), vel_(vel), acc_(acc) {
+}
+
+RetCode SampleJob::run( SplineWorkerContext& context ) {
+  (void)context;
+  try {
+    for( std::size_t i=0; i < size_; i++ ) {
+      const TimePVA tpva = interpolator_.pop( ts_ + dT_ * i );
+      pos_[i] = tpva.P.pos;
+      if( vel_ != NULL ) {
+        vel_[i] = tpva.P.vel;
+      }
+      if( acc_ != NULL ) {
+        acc_[i] = tpva.P.acc;
+      }
+    }
+  } catch( const NotSplineGenerated& e ) {
+    return SPLINE_SEGMENT_NOT_GENERATED;
+  } catch( const TimeOutOfRange& e ) {
+    return SPLINE_INVALID_INPUT_TIME;
+  }
+  return SPLINE_SUCCESS;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+SplineExecutor::WorkerState::WorkerState( const std::size_t& arena_chunk_size ) :
+  arena(arena_chunk_size), executed_num(0), stolen_num(0) {
+  pthread_mutex_init( &mutex, NULL );
+}
+
+SplineExecutor::WorkerState::~WorkerState() {
+  pthread_mutex_destroy( &mutex );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+SplineExecutor::SplineExecutor( const std::size_t& thread_num,
+                                const std::size_t& arena_chunk_size ) :
+  pool_(thread_num),
+  remaining_num_(0), submit_sequence_(0), failed_status_(SPLINE_SUCCESS) {
+
+  pthread_mutex_init( &call_mutex_, NULL );
+  pthread_mutex_init( &mutex_, NULL );
+  pthread_cond_init( &idle_cond_, NULL );
+
+  // one slot per thread of the pool (fewer if the pool failed to create threads)
+  for( std::size_t i=0; i < pool_.thread_num(); i++ ) {
+    workers_.push_back( new PaddedWorkerState( arena_chunk_size ) );
+  }
+}
+
+
+SplineExecutor::~SplineExecutor() {
+  for( std::size_t i=0; i < workers_.size(); i++ ) {
+    delete workers_[i];
+  }
+
+  pthread_cond_destroy( &idle_cond_ );
+  pthread_mutex_destroy( &mutex_ );
+  pthread_mutex_destroy( &call_mutex_ );
+}
+
+
+void SplineExecutor::submit( SplineJob& job ) {
+  pthread_mutex_lock( &call_mutex_ );
+  submitted_jobs_.push_back( &job );
+  pthread_mutex_unlock( &call_mutex_ );
+}
+
+
+RetCode SplineExecutor::run_all() {
+  pthread_mutex_lock( &call_mutex_ );
+  const std::size_t job_num = submitted_jobs_.size();
+  if( job_num == 0 ) {
+    pthread_mutex_unlock( &call_mutex_ );
+    return SPLINE_SUCCESS;
+  }
+  // the batch is counted before any job is visible to the workers
+  pthread_mutex_lock( &mutex_ );
+  remaining_num_ = job_num;
+  failed_status_ = SPLINE_SUCCESS;
+  pthread_mutex_unlock( &mutex_ );
+  for( std::size_t i=0; i < workers_.size(); i++ ) {
+    workers_[i]->state.executed_num = 0;
+    workers_[i]->state.stolen_num   = 0;
+  }
+  // deal the jobs round-robin
+  for( std::size_t i=0; i < job_num; i++ ) {
+    submitted_jobs_[i]->status_ = SPLINE_NOT_RETURN;
+    push_job( i % workers_.size(), *submitted_jobs_[i] );
+  }
+  submitted_jobs_.clear();
+
+  // returns after every slot has left the batch
+  BatchTask task( *this );
+  pool_.parallel_for( 0, workers_.size(), task, 1 );
+
+  pthread_mutex_lock( &mutex_ );
+  const RetCode retcode = failed_status_;
+  pthread_mutex_unlock( &mutex_ );
+  pthread_mutex_unlock( &call_mutex_ );
+  return retcode;
+}
+
+
+const std::size_t SplineExecutor::thread_num() const {
+  return workers_.size();
+}
+
+
+const std::size_t SplineExecutor::executed_job_num( const std::size_t& worker_index ) const {
+  return workers_[worker_index]->state.executed_num;
+}
+
+
+const std::size_t SplineExecutor::stolen_job_num( const std::size_t& worker_index ) const {
+  return workers_[worker_index]->state.stolen_num;
+}
+
+
+void SplineExecutor::BatchTask::run( const std::size_t& begin, const std::size_t& end ) {
+  for( std::size_t i=begin; i < end; i++ ) {
+    executor_.run_jobs( i );
+  }
+}
+
+
+void SplineExecutor::run_jobs( const std::size_t& worker_index ) {
+  WorkerState& worker = workers_[worker_index]->state;
+  SplineWorkerContext context( *this, worker_index );
+  while( true ) {
+    pthread_mutex_lock( &mutex_ );
+    const unsigned long seen_sequence = submit_sequence_;
+    pthread_mutex_unlock( &mutex_ );
+
+    SplineJob* job = take_job( worker_index );
+    if( job == NULL ) {
+      // sleep until a job is submitted or the batch has finished
+      pthread_mutex_lock( &mutex_ );
+      while( remaining_num_ > 0 && seen_sequence == submit_sequence_ ) {
+        pthread_cond_wait( &idle_cond_, &mutex_ );
+      }
+      const bool is_finished = ( remaining_num_ == 0 );
+      pthread_mutex_unlock( &mutex_ );
+      if( is_finished ) {
+        break;
+      }
+      continue;
+    }
+
+    RetCode status = SPLINE_SUCCESS;
+    try {
+      status = job->run( context );
+    } catch( ... ) {
+      // the job status reports the failure, not the thread pool
+      status = SPLINE_FAIL_TO_GENERATE_PATH;
+    }
+    worker.arena.reset();
+    worker.executed_num++;
+    job->status_ = status;
+
+    pthread_mutex_lock( &mutex_ );
+    if( status != SPLINE_SUCCESS && failed_status_ == SPLINE_SUCCESS ) {
+      failed_status_ = status;
+    }
+    remaining_num_--;
+    const bool is_last = ( remaining_num_ == 0 );
+    pthread_mutex_unlock( &mutex_ );
+    if( is_last ) {
+      pthread_cond_broadcast( &idle_cond_ );
+    }
+  } // End of while( true )
+}
+
+
+SplineJob* SplineExecutor::take_job( const std::size_t& worker_index ) {
+  // the newest job of the own queue
+  WorkerState& worker = workers_[worker_index]->state;
+  pthread_mutex_lock( &worker.mutex );
+  if( !worker.jobs.empty() ) {
+    SplineJob* const job = worker.jobs.back();
+    worker.jobs.pop_back();
+    pthread_mutex_unlock( &worker.mutex );
+    return job;
+  }
+  pthread_mutex_unlock( &worker.mutex );
+
+  // the oldest job of the other queues
+  const std::size_t worker_num = workers_.size();
+  for( std::size_t i=1; i < worker_num; i++ ) {
+    WorkerState& victim = workers_[( worker_index + i ) % worker_num]->state;
+    pthread_mutex_lock( &victim.mutex );
+    if( !victim.jobs.empty() ) {
+      SplineJob* const job = victim.jobs.front();
+      victim.jobs.pop_front();
+      pthread_mutex_unlock( &victim.mutex );
+      worker.stolen_num++;
+      return job;
+    }
+    pthread_mutex_unlock( &victim.mutex );
+  }
+  return NULL;
+}
+
+
+void SplineExecutor::push_job( const std::size_t& worker_index, SplineJob& job ) {
+  WorkerState& worker = workers_[worker_index]->state;
+  pthread_mutex_lock( &worker.mutex );
+  worker.jobs.push_back( &job );
+  pthread_mutex_unlock( &worker.mutex );
+}
@@ -1,11 +1,14 @@
 #include "spline_interpolator.hpp"
+#include "spline_thread_pool.hpp"
 
 using namespace interp;
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
 SplineInterpolator::SplineInterpolator() :
-  is_path_generated_(false), is_v_limit_(false) {
+  is_path_generated_(false), is_v_limit_(false),
+  is_time_scaled_(false), time_scale_(1.0), scale_input_origin_(0.0), scale_path_origin_(0.0),
+  thread_pool_(NULL), parallel_grain_(0), arena_(NULL) {
 }
 
 SplineInterpolator::~SplineInterpolator() {
@@ -15,10 +18,68 @@ SplineInterpolator::SplineInterpolator( const SplineInterpolator& src ) :
   is_path_generated_ ( src.is_path_generated_ ),
   is_v_limit_        ( src.is_v_limit_        ),
   v_limit_           ( src.v_limit_           ),
-  target_tpva_queue_ ( src.target_tpva_queue_ ) {
+  target_tpva_queue_ ( src.target_tpva_queue_ ),
+  is_time_scaled_    ( src.is_time_scaled_    ),
+  time_scale_        ( src.time_scale_        ),
+  scale_input_origin_( src.scale_input_origin_ ),
+  scale_path_origin_ ( src.scale_path_origin_ ),
+  thread_pool_       ( src.thread_pool_       ),
+  parallel_grain_    ( src.parallel_grain_    ),
+  arena_             ( src.arena_             ) {
 }
 
 
+SplineInterpolator& SplineInterpolator::operator=( const SplineInterpolator& src ) {
+  is_path_generated_ = src.is_path_generated_;
+  is_v_limit_        = src.is_v_limit_;
+  v_limit_           = src.v_limit_;
+  target_tpva_queue_ = src.target_tpva_queue_;
+  is_time_scaled_    = src.is_time_scaled_;
+  time_scale_        = src.time_scale_;
+  scale_input_origin_ = src.scale_input_origin_;
+  scale_path_origin_ = src.scale_path_origin_;
+  thread_pool_       = src.thread_pool_;
+  parallel_grain_    = src.parallel_grain_;
+  arena_             = src.arena_;
+  return *this;
+}
+
+
+#ifdef SPLINE_CXX11
+SplineInterpolator::SplineInterpolator( SplineInterpolator&& src ) SPLINE_NOEXCEPT :
+  is_path_generated_ ( src.is_path_generated_             ),
+  is_v_limit_        ( src.is_v_limit_                    ),
+  v_limit_           ( src.v_limit_                       ),
+  target_tpva_queue_ ( std::move( src.target_tpva_queue_ ) ),
+  is_time_scaled_    ( src.is_time_scaled_                ),
+  time_scale_        ( src.time_scale_                    ),
+  scale_input_origin_( src.scale_input_origin_            ),
+  scale_path_origin_ ( src.scale_path_origin_             ),
+  thread_pool_       ( src.thread_pool_                   ),
+  parallel_grain_    ( src.parallel_grain_                ),
+  arena_             ( src.arena_                         ) {
+  src.is_path_generated_ = false;
+}
+
+
+SplineInterpolator& SplineInterpolator::operator=( SplineInterpolator&& src ) SPLINE_NOEXCEPT {
+  is_path_generated_ = src.is_path_generated_;
+  is_v_limit_        = src.is_v_limit_;
+  v_limit_           = src.v_limit_;
+  target_tpva_queue_ = std::move( src.target_tpva_queue_ );
+  is_time_scaled_    = src.is_time_scaled_;
+  time_scale_        = src.time_scale_;
+  scale_input_origin_ = src.scale_input_origin_;
+  scale_path_origin_ = src.scale_path_origin_;
+  thread_pool_       = src.thread_pool_;
+  parallel_grain_    = src.parallel_grain_;
+  arena_             = src.arena_;
+  src.is_path_generated_ = false;
+  return *this;
+}
+#endif
+
+
 SplineInterpolator::SplineInterpolator(
                       const bool&      is_path_generated,
                       const bool&      is_v_limit,
@@ -27,7 +88,14 @@ SplineInterpolator::SplineInterpolator(
   is_path_generated_ ( is_path_generated ),
   is_v_limit_        ( is_v_limit        ),
   v_limit_           ( v_limit           ),
-  target_tpva_queue_ ( target_tpva_queue ) {
+  target_tpva_queue_ ( target_tpva_queue ),
+  is_time_scaled_    ( false             ),
+  time_scale_        ( 1.0               ),
+  scale_input_origin_( 0.0               ),
+  scale_path_origin_ ( 0.0               ),
+  thread_pool_       ( NULL              ),
+  parallel_grain_    ( 0                 ),
+  arena_             ( NULL              ) {
 }
 
 
@@ -36,8 +104,8 @@ const double SplineInterpolator::total_dT() const {
     THROW( NotSplineGenerated,
            "total dT not exists -- spline-path has not be generated yet.");
   }
-  const double out_dT = target_tpva_queue_.get( target_tpva_queue_.size() - 1 ).time
-                        - target_tpva_queue_.get( 0 ).time;
+  const double out_dT = input_time( target_tpva_queue_.get( target_tpva_queue_.size() - 1 ).time )
+                        - input_time( target_tpva_queue_.get( 0 ).time );
   return out_dT;
 }
 
@@ -54,7 +122,7 @@ const double SplineInterpolator::start_time() const {
     THROW( NotSplineGenerated,
            "start time not exists -- spline-path has not be generated yet.");
   }
-  return target_tpva_queue_.get( 0 ).time;
+  return input_time( target_tpva_queue_.get( 0 ).time );
 }
 
 const double SplineInterpolator::finish_time() const {
@@ -62,38 +130,39 @@ const double SplineInterpolator::finish_time() const {
     THROW( NotSplineGenerated,
            "finish time not exists -- spline-path has not be generated yet.");
   }
-  return target_tpva_queue_.get( target_tpva_queue_.size() - 1 ).time;
+  return input_time( target_tpva_queue_.get( target_tpva_queue_.size() - 1 ).time );
 }
 
 const RetCode SplineInterpolator::index_of_time( const double& t,
                                                  std::size_t&  output_index ) const {
   const std::size_t& target_tpva_queue_size = target_tpva_queue_.size();
   const std::size_t last_index = target_tpva_queue_size - 1;
-  bool is_out_of_range = true;
 
-  if( t > target_tpva_queue_.get( last_index ).time ) {
+  if( t > target_tpva_queue_.get( last_index ).time
+      || t < target_tpva_queue_.get( 0 ).time ) {
 
     return SPLINE_INVALID_INPUT_TIME;
 
   } else if( t == target_tpva_queue_.get( last_index ).time ) {
 
-    output_index    = last_index;
-    is_out_of_range = false;
+    output_index = last_index;
     return SPLINE_SUCCESS;
   }
-  for ( std::size_t idx=0; idx < target_tpva_queue_size; idx++ ) {
 
-    if( target_tpva_queue_.get( idx ).time <= t
-        && t < target_tpva_queue_.get( idx+1 ).time ) {
-      output_index    = idx;
-      is_out_of_range = false;
-      break;
+  // binary search of the index which satisfies time[idx] <= t < time[idx+1]
+  // ( the time of target_tpva_queue is monotonically increasing )
+  std::size_t lower = 0;
+  std::size_t upper = last_index;
+  while( upper - lower > 1 ) {
+    const std::size_t middle = lower + (upper - lower) / 2;
+    if( target_tpva_queue_.at( middle ).time <= t ) {
+      lower = middle;
+    } else {
+      upper = middle;
     }
-  } // End of for loop idx=0 -> target_tpva_queue_size-1
+  } // End of while upper - lower > 1
 
-  if( is_out_of_range ) {
-    return SPLINE_INVALID_INPUT_TIME;
-  }
+  output_index = lower;
 
   return SPLINE_SUCCESS;
 }
@@ -140,10 +209,103 @@ RetCode SplineInterpolator::clear() {
   target_tpva_queue_.clear();
 
   is_path_generated_ = false;
+  is_time_scaled_    = false;
+  time_scale_        = 1.0;
 
   return SPLINE_SUCCESS;
 }
 
+RetCode SplineInterpolator::set_time_scale( const double& scale ) {
+  if( !is_path_generated_ ) {
+    return SPLINE_UNINITIALIZED_INTERPOLATOR;
+  }
+  if( !( scale > 0.0 ) ) {
+    return SPLINE_INVALID_ARGUMENT_VALUE_ZERO;
+  }
+  // t' = t0 + s (t - t0)
+  const double t0 = target_tpva_queue_.get( 0 ).time;
+  scale_input_origin_ = t0;
+  scale_path_origin_  = t0;
+  time_scale_         = scale;
+  is_time_scaled_     = ( scale != 1.0 );
+  return SPLINE_SUCCESS;
+}
+
+RetCode SplineInterpolator::set_time_scale( const double& scale, const double& anchor ) {
+  if( !is_path_generated_ ) {
+    return SPLINE_UNINITIALIZED_INTERPOLATOR;
+  }
+  if( !( scale > 0.0 ) ) {
+    return SPLINE_INVALID_ARGUMENT_VALUE_ZERO;
+  }
+  // t' = path_time( anchor ) + s (t - anchor)
+  scale_path_origin_  = path_time( anchor );
+  scale_input_origin_ = anchor;
+  time_scale_         = scale;
+  is_time_scaled_     = !( scale == 1.0 && scale_input_origin_ == scale_path_origin_ );
+  return SPLINE_SUCCESS;
+}
+
+const double SplineInterpolator::time_scale() const {
+  return time_scale_;
+}
+
+const double SplineInterpolator::path_time( const double& t ) const {
+  if( !is_time_scaled_ ) {
+    return t;
+  }
+  double path_t = scale_path_origin_ + time_scale_ * ( t - scale_input_origin_ );
+  if( target_tpva_queue_.size() > 0 ) {
+    // the ends of the path are not rounded out of range
+    const double t0 = target_tpva_queue_.get( 0 ).time;
+    const double tf = target_tpva_queue_.get( target_tpva_queue_.size() - 1 ).time;
+    if( path_t > tf && t <= input_time( tf ) ) {
+      path_t = tf;
+    } else if( path_t < t0 && t >= input_time( t0 ) ) {
+      path_t = t0;
+    }
+  }
+  return path_t;
+}
+
+const double SplineInterpolator::input_time( const double& t ) const {
+  if( !is_time_scaled_ ) {
+    return t;
+  }
+  return scale_input_origin_ + ( t - scale_path_origin_ ) / time_scale_;
+}
+
 const std::size_t SplineInterpolator::target_tpva_queue_size() const {
   return target_tpva_queue_.size();
 }
+
+void SplineInterpolator::set_thread_pool( SplineThreadPool* thread_pool,
+                                          const std::size_t& grain ) {
+  thread_pool_    = thread_pool;
+  parallel_grain_ = grain;
+}
+
+SplineThreadPool* SplineInterpolator::thread_pool() const {
+  return thread_pool_;
+}
+
+void SplineInterpolator::set_arena( MonotonicArena* arena ) {
+  arena_ = arena;
+}
+
+MonotonicArena* SplineInterpolator::arena() const {
+  return arena_;
+}
+
+void SplineInterpolator::for_each_segment( const std::size_t& begin,
+                                           const std::size_t& end,
+                                           RangeTask&         task ) const {
+  if( begin >= end ) {
+    return;
+  }
+  if( thread_pool_ == NULL ) {
+    task.run( begin, end );
+    return;
+  }
+  thread_pool_->parallel_for( begin, end, task, parallel_grain_ );
+}
@@ -0,0 +1,189 @@
+#include "spline_thread_pool.hpp"
+
+#include <unistd.h>
+#include <stdexcept>
+
+using namespace interp;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+SplineThreadPool::SplineThreadPool( const std::size_t& thread_num ) :
+  task_(NULL), next_(0), end_(0), grain_(1), busy_(0), generation_(0), is_stop_(false),
+  is_failed_(false) {
+
+  pthread_key_create( &running_key_, NULL );
+  pthread_mutex_init( &call_mutex_, NULL );
+  pthread_mutex_init( &mutex_, NULL );
+  pthread_cond_init( &work_cond_, NULL );
+  pthread_cond_init( &done_cond_, NULL );
+
+  const std::size_t total_thread_num =
+    ( thread_num == 0 ) ? hardware_concurrency() : thread_num;
+
+  // the calling thread of parallel_for() is the last one
+  for( std::size_t i=1; i < total_thread_num; i++ ) {
+    pthread_t worker;
+    if( pthread_create( &worker, NULL, &SplineThreadPool::worker_entry, this ) != 0 ) {
+      std::cerr << "failed to create a worker thread of SplineThreadPool. "
+                << "continue with " << workers_.size() + 1 << " threads." << std::endl;
+      break;
+    }
+    workers_.push_back( worker );
+  }
+}
+
+
+SplineThreadPool::~SplineThreadPool() {
+  pthread_mutex_lock( &mutex_ );
+  is_stop_ = true;
+  pthread_cond_broadcast( &work_cond_ );
+  pthread_mutex_unlock( &mutex_ );
+
+  for( std::size_t i=0; i < workers_.size(); i++ ) {
+    pthread_join( workers_[i], NULL );
+  }
+
+  pthread_cond_destroy( &done_cond_ );
+  pthread_cond_destroy( &work_cond_ );
+  pthread_mutex_destroy( &mutex_ );
+  pthread_mutex_destroy( &call_mutex_ );
+  pthread_key_delete( running_key_ );
+}
+
+
+RetCode SplineThreadPool::parallel_for( const std::size_t& begin,
+                                        const std::size_t& end,
+                                        RangeTask&         task,
+                                        const std::size_t& grain ) {
+  if( begin > end ) {
+    return SPLINE_INVALID_INPUT_INDEX;
+  }
+  if( begin == end ) {
+    return SPLINE_SUCCESS;
+  }
+
+  std::size_t chunk = grain;
+  if( chunk == 0 ) {
+    chunk = ( end - begin ) / ( 4 * thread_num() );
+  }
+  if( chunk == 0 ) {
+    chunk = 1;
+  }
+
+  if( workers_.empty() || chunk >= end - begin
+      || pthread_getspecific( running_key_ ) != NULL ) {
+    // nothing to share, or called from a task of this pool:
+    // waiting for the pool here would deadlock, so run serially
+    task.run( begin, end );
+    return SPLINE_SUCCESS;
+  }
+
+  pthread_mutex_lock( &call_mutex_ );
+  pthread_mutex_lock( &mutex_ );
+  task_  = &task;
+  next_  = begin;
+  end_   = end;
+  grain_ = chunk;
+  generation_++;
+  pthread_cond_broadcast( &work_cond_ );
+
+  // the calling thread works too
+  run_chunks();
+
+  // wait for the chunks still running on workers
+  while( busy_ > 0 ) {
+    pthread_cond_wait( &done_cond_, &mutex_ );
+  }
+  task_ = NULL;
+  const bool  is_failed = is_failed_;
+  std::string error_message;
+  error_message.swap( error_message_ );
+  is_failed_ = false;
+  pthread_mutex_unlock( &mutex_ );
+  pthread_mutex_unlock( &call_mutex_ );
+
+  if( is_failed ) {
+    throw std::runtime_error( error_message );
+  }
+  return SPLINE_SUCCESS;
+}
+
+
+const std::size_t SplineThreadPool::thread_num() const {
+  return workers_.size() + 1;
+}
+
+
+const std::size_t SplineThreadPool::hardware_concurrency() {
+  const long processor_num = sysconf( _SC_NPROCESSORS_ONLN );
+  if( processor_num < 1 ) {
+    return 1;
+  }
+  return (std::size_t)processor_num;
+}
+
+
+void* SplineThreadPool::worker_entry( void* arg ) {
+  static_cast<SplineThreadPool*>( arg )->worker_loop();
+  return NULL;
+}
+
+
+void SplineThreadPool::worker_loop() {
+  pthread_mutex_lock( &mutex_ );
+  // the thread may start after the first job is posted
+  unsigned long seen_generation = 0;
+  while( true ) {
+    while( !is_stop_ && seen_generation == generation_ ) {
+      pthread_cond_wait( &work_cond_, &mutex_ );
+    }
+    if( is_stop_ ) {
+      break;
+    }
+    seen_generation = generation_;
+    //
+    busy_++;
+    run_chunks();
+    busy_--;
+    if( busy_ == 0 ) {
+      pthread_cond_signal( &done_cond_ );
+    }
+  } // End of while( true )
+  pthread_mutex_unlock( &mutex_ );
+}
+
+
+void SplineThreadPool::run_chunks() {
+  pthread_setspecific( running_key_, this );
+  while( next_ < end_ ) {
+    const std::size_t chunk_begin = next_;
+    const std::size_t chunk_end   = ( end_ - next_ > grain_ ) ? next_ + grain_ : end_;
+    next_ = chunk_end;
+    RangeTask* task = task_;
+    //
+    pthread_mutex_unlock( &mutex_ );
+    try {
+      task->run( chunk_begin, chunk_end );
+    } catch( const std::exception& e ) {
+      pthread_mutex_lock( &mutex_ );
+      cancel_job( e.what() );
+      continue;
+    } catch( ... ) {
+      pthread_mutex_lock( &mutex_ );
+      cancel_job( "unknown exception in RangeTask::run()" );
+      continue;
+    }
+    pthread_mutex_lock( &mutex_ );
+  }
+  pthread_setspecific( running_key_, NULL );
+}
+
+
+void SplineThreadPool::cancel_job( const std::string& error_message ) {
+  if( !is_failed_ ) {
+    is_failed_     = true;
+    error_message_ = error_message;
+  }
+  // chunks not handed out yet are not executed
+  next_ = end_;
+}
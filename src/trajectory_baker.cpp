@@ -0,0 +1,346 @@
+#include "trajectory_baker.hpp"
+#include "waypoint_loader.hpp"
+#include "spline_thread_pool.hpp"
+#include "cubic_spline_interpolator.hpp"
+#include "trapezoid_5251525_interpolator.hpp"
+
+#include <time.h>
+#include <sstream>
+#include <map>
+
+using namespace interp;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// current monotonic time
+/// @return [sec]
+double now_sec() {
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return ts.tv_sec + ts.tv_nsec * 1.0e-9;
+}
+
+/// Task to bake files of the sub-range
+class BakeTask : public RangeTask {
+public:
+  /// Constructor
+  /// @param[in]  baker       baker
+  /// @param[in]  input_paths waypoint file paths
+  /// @param[out] results     results of baking (same size as input_paths)
+  BakeTask( const TrajectoryBaker&          baker,
+            const std::vector<std::string>& input_paths,
+            std::vector<BakeResult>&        results ) :
+    baker_(baker), input_paths_(input_paths), results_(results) {
+  }
+
+  /// bake files [begin, end)
+  /// @param[in] begin the first index of files
+  /// @param[in] end   the index next to the last of files
+  virtual void run( const std::size_t& begin, const std::size_t& end ) {
+    for( std::size_t i=begin; i < end; i++ ) {
+      if( results_[i].status != SPLINE_SUCCESS ) {
+        // rejected before dispatch (duplicate output path)
+        continue;
+      }
+      try {
+        baker_.bake( input_paths_[i], results_[i] );
+      } catch( const std::exception& e ) {
+        // exceptions cannot be thrown from worker threads
+        results_[i].status  = SPLINE_FAIL_TO_GENERATE_PATH;
+        results_[i].message = e.what();
+      }
+    }
+  }
+
+private:
+  /// baker
+  const TrajectoryBaker& baker_;
+  /// waypoint file paths
+  const std::vector<std::string>& input_paths_;
+  /// results of baking
+  std::vector<BakeResult>& results_;
+};
+
+/// Owner of interpolators of axes
+class InterpolatorList {
+public:
+  /// Constructor
+  InterpolatorList() {}
+
+  /// Destructor
+  /// @brief delete all interpolators
+  ~InterpolatorList() {
+    for( std::size_t k=0; k < list_.size(); k++ ) {
+      delete list_[k];
+    }
+  }
+
+  /// add the interpolator (deleted by this)
+  /// @param[in] interpolator new interpolator
+  void push_back( SplineInterpolator* interpolator ) {
+    list_.push_back( interpolator );
+  }
+
+  /// get the interpolator
+  /// @param[in] k the index of axis
+  /// @return the interpolator of the axis
+  const SplineInterpolator& operator[]( const std::size_t& k ) const {
+    return *list_[k];
+  }
+
+private:
+  /// Copy Constructor (prohibited)
+  InterpolatorList( const InterpolatorList& src );
+
+  /// Copy(insert) Operator (prohibited)
+  InterpolatorList& operator=( const InterpolatorList& src );
+
+  /// interpolators of axes
+  std::vector<SplineInterpolator*> list_;
+};
+
+/// set the error of the result
+/// @param[out] result  result of baking
+/// @param[in]  status  error code
+/// @param[in]  message error message
+/// @return status
+RetCode set_error( BakeResult& result, const RetCode& status, const std::string& message ) {
+  result.status  = status;
+  result.message = message;
+  return status;
+}
+
+} // End of namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BakeConfig::BakeConfig() :
+  interpolator(BAKE_CUBIC),
+  trapezoid(),
+  cycle(0.001),
+  time_column(WaypointLoader::NO_COLUMN),
+  waypoint_interval(1.0),
+  position_columns(),
+  format(EXPORT_CSV),
+  output_dir("./"),
+  background(false) {
+}
+
+
+BakeResult::BakeResult() :
+  status(SPLINE_SUCCESS),
+  waypoint_size(0), axis_size(0), sample_size(0),
+  load_sec(0.0), plan_sec(0.0), export_sec(0.0) {
+}
+
+
+const double BakeResult::total_sec() const {
+  return load_sec + plan_sec + export_sec;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+TrajectoryBaker::TrajectoryBaker( const BakeConfig& config ) :
+  config_(config) {
+}
+
+
+TrajectoryBaker::~TrajectoryBaker() {
+}
+
+
+RetCode TrajectoryBaker::bake( const std::string& input_path, BakeResult& result ) const {
+  result = BakeResult();
+  result.input_path  = input_path;
+  result.output_path = output_path( input_path );
+
+  if( config_.cycle <= 0.0
+      || ( config_.time_column == WaypointLoader::NO_COLUMN && config_.waypoint_interval <= 0.0 ) ) {
+    return set_error( result, SPLINE_INVALID_INPUT_INTERVAL_TIME_DT,
+                      "control cycle and waypoint interval must be positive" );
+  }
+
+  ///////////////////////////////////////////////////////////////////////
+  // load
+  double start_sec = now_sec();
+  WaypointLoader loader;
+  RetCode ret = loader.load_file( input_path );
+  if( ret != SPLINE_SUCCESS ) {
+    std::stringstream message;
+    if( ret == SPLINE_FILE_IO_ERROR ) {
+      message << "cannot read the file";
+    } else {
+      message << "line " << loader.error_line() << ": " << loader.error_message();
+    }
+    return set_error( result, ret, message.str() );
+  }
+  result.waypoint_size = loader.row_size();
+  if( result.waypoint_size < 2 ) {
+    return set_error( result, SPLINE_INVALID_QUEUE_SIZE, "at least 2 waypoints are required" );
+  }
+
+  std::vector<std::size_t> position_columns = config_.position_columns;
+  if( position_columns.empty() ) {
+    for( std::size_t col=0; col < loader.column_size(); col++ ) {
+      if( col != config_.time_column ) {
+        position_columns.push_back( col );
+      }
+    }
+  }
+  result.axis_size = position_columns.size();
+
+  std::vector<double> times;
+  if( config_.time_column == WaypointLoader::NO_COLUMN ) {
+    times.resize( result.waypoint_size );
+    for( std::size_t i=0; i < times.size(); i++ ) {
+      times[i] = config_.waypoint_interval * i;
+    }
+  } else if( loader.column( config_.time_column, times ) != SPLINE_SUCCESS ) {
+    return set_error( result, SPLINE_INVALID_INPUT_INDEX, "time column is out of range" );
+  }
+
+  std::vector<TPQueue> tp_queues( result.axis_size );
+  std::vector<double>  positions;
+  for( std::size_t k=0; k < result.axis_size; k++ ) {
+    if( loader.column( position_columns[k], positions ) != SPLINE_SUCCESS ) {
+      return set_error( result, SPLINE_INVALID_INPUT_INDEX, "position column is out of range" );
+    }
+    if( tp_queues[k].assign( times, positions ) != SPLINE_SUCCESS ) {
+      return set_error( result, SPLINE_INVALID_INPUT_TIME, "times are not strictly increasing" );
+    }
+  }
+  result.load_sec = now_sec() - start_sec;
+
+  ///////////////////////////////////////////////////////////////////////
+  // generate path of each axis
+  start_sec = now_sec();
+  InterpolatorList interpolators;
+  for( std::size_t k=0; k < result.axis_size; k++ ) {
+    try {
+      if( config_.interpolator == BAKE_TRAPEZOID ) {
+        const TrapezoidConfigQueue trapzd_config_que( result.waypoint_size - 1, config_.trapezoid );
+        TrapezoidalInterpolator* interpolator = new TrapezoidalInterpolator( trapzd_config_que );
+        interpolators.push_back( interpolator );
+        ret = interpolator->generate_path( tp_queues[k] );
+      } else {
+        CubicSplineInterpolator* interpolator = new CubicSplineInterpolator();
+        interpolators.push_back( interpolator );
+        ret = interpolator->generate_path( tp_queues[k] );
+      }
+    } catch( const std::exception& e ) {
+      // unreachable waypoints under the limits, etc.
+      ret = SPLINE_FAIL_TO_GENERATE_PATH;
+    }
+    if( ret != SPLINE_SUCCESS ) {
+      std::stringstream message;
+      message << "failed to generate the path of axis " << k;
+      return set_error( result, ret, message.str() );
+    }
+  }
+  result.plan_sec = now_sec() - start_sec;
+
+  ///////////////////////////////////////////////////////////////////////
+  // sample & write
+  start_sec = now_sec();
+  TrajectoryExporter exporter;
+  ret = exporter.open( result.output_path, config_.format, config_.background );
+  if( ret != SPLINE_SUCCESS ) {
+    return set_error( result, ret, "cannot open the output file" );
+  }
+  TimePVAList tpva_list;
+  tpva_list.P.resize( result.axis_size );
+  const double ts = times.front();
+  const double tf = times.back();
+  try {
+    // time is not accumulated, so the error does not grow with the number of samples
+    for( std::size_t i=0; ; i++ ) {
+      tpva_list.time = ts + config_.cycle * i;
+      if( tpva_list.time > tf ) {
+        break;
+      }
+      for( std::size_t k=0; k < result.axis_size; k++ ) {
+        tpva_list.P[k] = interpolators[k].pop( tpva_list.time ).P;
+      }
+      ret = exporter.write( tpva_list );
+      if( ret != SPLINE_SUCCESS ) {
+        break;
+      }
+    }
+  } catch( const std::exception& e ) {
+    exporter.close();
+    return set_error( result, SPLINE_FAIL_TO_GENERATE_PATH, e.what() );
+  }
+  result.sample_size = exporter.row_size();
+  if( exporter.close() != SPLINE_SUCCESS ) {
+    ret = SPLINE_FILE_IO_ERROR;
+  }
+  result.export_sec = now_sec() - start_sec;
+  if( ret != SPLINE_SUCCESS ) {
+    return set_error( result, ret, "failed to write the output file" );
+  }
+
+  return SPLINE_SUCCESS;
+}
+
+
+RetCode TrajectoryBaker::bake( const std::vector<std::string>& input_paths,
+                               std::vector<BakeResult>&        results,
+                               SplineThreadPool*               thread_pool ) const {
+  results.assign( input_paths.size(), BakeResult() );
+
+  // files of the same basename are baked into the same output file,
+  // so only the first of them is baked (concurrent writers would corrupt the file)
+  std::map<std::string, std::size_t> output_indices;
+  for( std::size_t i=0; i < input_paths.size(); i++ ) {
+    results[i].input_path  = input_paths[i];
+    results[i].output_path = output_path( input_paths[i] );
+    const std::pair<std::map<std::string, std::size_t>::iterator, bool> inserted
+      = output_indices.insert( std::make_pair( results[i].output_path, i ) );
+    if( !inserted.second ) {
+      std::stringstream message;
+      message << "the output file is the same as that of " << input_paths[inserted.first->second];
+      set_error( results[i], SPLINE_FILE_IO_ERROR, message.str() );
+    }
+  }
+
+  BakeTask task( *this, input_paths, results );
+  if( thread_pool != NULL ) {
+    // one file per chunk, files are much larger than the overhead of the pool
+    thread_pool->parallel_for( 0, input_paths.size(), task, 1 );
+  } else {
+    task.run( 0, input_paths.size() );
+  }
+
+  for( std::size_t i=0; i < results.size(); i++ ) {
+    if( results[i].status != SPLINE_SUCCESS ) {
+      return SPLINE_FAIL_TO_GENERATE_PATH;
+    }
+  }
+  return SPLINE_SUCCESS;
+}
+
+
+const std::string TrajectoryBaker::output_path( const std::string& input_path ) const {
+  const std::size_t slash = input_path.find_last_of( '/' );
+  std::string basename =
+    ( slash == std::string::npos ) ? input_path : input_path.substr( slash + 1 );
+  const std::size_t dot = basename.find_last_of( '.' );
+  if( dot != std::string::npos && dot > 0 ) {
+    basename.erase( dot );
+  }
+
+  std::string path = config_.output_dir;
+  if( !path.empty() && path[path.size() - 1] != '/' ) {
+    path += '/';
+  }
+  path += basename;
+  path += ( config_.format == EXPORT_BINARY ) ? ".bin" : ".csv";
+  return path;
+}
+
+
+const BakeConfig& TrajectoryBaker::config() const {
+  return config_;
+}
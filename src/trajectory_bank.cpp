@@ -0,0 +1,375 @@
+#include "trajectory_bank.hpp"
+#include "spline_thread_pool.hpp"
+#include "cubic_spline_interpolator.hpp"
+#include "trapezoid_5251525_interpolator.hpp"
+#include "trapezoid_5251525_kernel.hpp"
+
+#include <algorithm> // for upper_bound
+
+using namespace interp;
+
+namespace interp {
+
+/// Parallel evaluation task of TrajectoryBank
+/// @tparam Mask combination of OutputMask
+/// @details Each trajectory writes only its own cursor and outputs.
+template<unsigned int Mask>
+class TrajectoryBankTask : public RangeTask {
+public:
+  /// Constructor
+  /// @param[in]  bank bank to evaluate
+  /// @param[in]  t    time
+  /// @param[out] pos  positions
+  /// @param[out] vel  velocities
+  /// @param[out] acc  accelerations
+  TrajectoryBankTask( TrajectoryBank& bank, const double& t,
+                      double* pos, double* vel, double* acc ) :
+    bank_(bank), t_(t), pos_(pos), vel_(vel), acc_(acc) {
+  }
+
+  /// Evaluate the trajectories in [begin, end)
+  /// @param[in] begin the first index of trajectories
+  /// @param[in] end   the index next to the last of trajectories
+  virtual void run( const std::size_t& begin, const std::size_t& end ) {
+    bank_.evaluate_range<Mask>( t_, begin, end, pos_, vel_, acc_ );
+  }
+
+private:
+  /// bank to evaluate
+  TrajectoryBank& bank_;
+
+  /// time
+  const double t_;
+
+  /// positions
+  double* pos_;
+
+  /// velocities
+  double* vel_;
+
+  /// accelerations
+  double* acc_;
+};
+
+/// Append the pieces of the steps of the trapezoid 5251525 path
+/// @param[in]  trapezoid generated trapezoid 5251525 path
+/// @param[out] pieces    pieces appended in order of start time
+/// @details
+/// The expansion of each step of Trapezoid5251525::pop() in dt = t - (start of the step)
+/// by g_trapezoid5251525_step_coef().
+/// Steps of zero duration are skipped.
+static void append_trapezoid_pieces( const Trapezoid5251525&       trapezoid,
+                                     std::vector<PolynomialPiece>& pieces ) {
+  if( trapezoid.no_movement() ) {
+    pieces.push_back( PolynomialPiece( trapezoid.t0(), trapezoid.x0() ) );
+    return;
+  }
+  const double A     = trapezoid.signA() * trapezoid.a_max();
+  const double D     = -trapezoid.signD() * trapezoid.d_max();
+  const double dT1   = trapezoid.dT1();
+  const double dT4   = trapezoid.dT4();
+  const double v_max = trapezoid.v_max();
+  // Step1, ..., Step7 : start time, shape, acceleration, rounding time, start velocity and position
+  const double start_time[] = { trapezoid.t0(), trapezoid.t1(), trapezoid.t2(), trapezoid.t3(),
+                                trapezoid.t4(), trapezoid.t5(), trapezoid.t6(), trapezoid.t7() };
+  const Trapezoid5251525StepShape shape[] = { TRAPZD_ROUND_IN, TRAPZD_CONSTANT, TRAPZD_ROUND_OUT,
+                                              TRAPZD_CONSTANT,
+                                              TRAPZD_ROUND_IN, TRAPZD_CONSTANT, TRAPZD_ROUND_OUT };
+  const double acc[] = { A, A, A, 0.0, D, D, D };
+  const double dT[]  = { dT1, dT1, dT1, dT1, dT4, dT4, dT4 };
+  const double vel[] = { trapezoid.v0(), trapezoid.v1(), trapezoid.v2(), v_max,
+                         v_max, trapezoid.v5(), trapezoid.v6() };
+  const double pos[] = { trapezoid.x0(), trapezoid.x1(), trapezoid.x2(), trapezoid.x3(),
+                         trapezoid.x4(), trapezoid.x5(), trapezoid.x6() };
+  for( std::size_t step=0; step < 7; step++ ) {
+    if( start_time[step+1] > start_time[step] ) {
+      double coef[PolynomialPiece::COEF_NUM];
+      g_trapezoid5251525_step_coef( shape[step], acc[step], dT[step], vel[step], pos[step], coef );
+      pieces.push_back( PolynomialPiece( start_time[step], coef[0], coef[1], coef[2],
+                                         coef[3], coef[4], coef[5] ) );
+    }
+  }
+  if( pieces.empty() ) {
+    // path of zero duration
+    pieces.push_back( PolynomialPiece( trapezoid.t0(), trapezoid.x0() ) );
+  }
+}
+
+/// Map the pieces of the generated path into the time of pop() of the interpolator
+/// @param[in]     interpolator    generated interpolator (with the time scale s)
+/// @param[in]     path_start_time start time of the generated path
+/// @param[in,out] pieces          pieces in the time of the generated path
+/// @param[in,out] finish_time     finish time of the generated path
+/// @details
+/// pop(t) evaluates the path at t' = t'0 + s (t - t0), so the piece x(t' - t'i) = sum c_k (t' - t'i)^k
+/// becomes sum c_k s^k (t - ti)^k with ti = t0 + (t'i - t'0) / s. \n
+/// Nothing is done without the time scale.
+static void scale_pieces( const SplineInterpolator&     interpolator,
+                          const double&                 path_start_time,
+                          std::vector<PolynomialPiece>& pieces,
+                          double&                       finish_time ) {
+  const double scale      = interpolator.time_scale();
+  const double start_time = interpolator.start_time();
+  if( scale == 1.0 && start_time == path_start_time ) {
+    return;
+  }
+  for( std::size_t i=0; i < pieces.size(); i++ ) {
+    pieces[i].start_time = start_time + ( pieces[i].start_time - path_start_time ) / scale;
+    double scale_k = scale;
+    for( std::size_t k=1; k < PolynomialPiece::COEF_NUM; k++ ) {
+      pieces[i].coef[k] *= scale_k;
+      scale_k *= scale;
+    }
+  }
+  finish_time = interpolator.finish_time();
+}
+
+} // End of namespace interp
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+const std::size_t PolynomialPiece::COEF_NUM;
+
+PolynomialPiece::PolynomialPiece() :
+  start_time(0.0) {
+  for( std::size_t k=0; k < COEF_NUM; k++ ) {
+    coef[k] = 0.0;
+  }
+}
+
+PolynomialPiece::PolynomialPiece( const double& start_time,
+                                  const double& c0, const double& c1,
+                                  const double& c2, const double& c3,
+                                  const double& c4, const double& c5 ) :
+  start_time(start_time) {
+  coef[0] = c0;
+  coef[1] = c1;
+  coef[2] = c2;
+  coef[3] = c3;
+  coef[4] = c4;
+  coef[5] = c5;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+TrajectoryBank::TrajectoryBank() :
+  thread_pool_(NULL),
+  parallel_grain_(0) {
+}
+
+void TrajectoryBank::reserve( const std::size_t& trajectory_num,
+                              const std::size_t& piece_num ) {
+  piece_start_.reserve( piece_num );
+  for( std::size_t k=0; k < PolynomialPiece::COEF_NUM; k++ ) {
+    coef_[k].reserve( piece_num );
+  }
+  first_piece_.reserve( trajectory_num );
+  end_piece_.reserve( trajectory_num );
+  cursor_.reserve( trajectory_num );
+  elapsed_.reserve( trajectory_num );
+  start_time_.reserve( trajectory_num );
+  finish_time_.reserve( trajectory_num );
+}
+
+RetCode TrajectoryBank::add_pieces( const std::vector<PolynomialPiece>& pieces,
+                                    const double&                       finish_time,
+                                    std::size_t&                        index ) {
+  if( pieces.empty() ) {
+    return SPLINE_INVALID_QUEUE_SIZE;
+  }
+  for( std::size_t i=1; i < pieces.size(); i++ ) {
+    if( pieces[i].start_time <= pieces[i-1].start_time ) {
+      return SPLINE_INVALID_INPUT_INTERVAL_TIME_DT;
+    }
+  }
+  if( finish_time < pieces.back().start_time ) {
+    return SPLINE_INVALID_INPUT_INTERVAL_TIME_DT;
+  }
+
+  const std::size_t first_piece = piece_start_.size();
+  for( std::size_t i=0; i < pieces.size(); i++ ) {
+    piece_start_.push_back( pieces[i].start_time );
+    for( std::size_t k=0; k < PolynomialPiece::COEF_NUM; k++ ) {
+      coef_[k].push_back( pieces[i].coef[k] );
+    }
+  }
+  index = first_piece_.size();
+  first_piece_.push_back( first_piece );
+  end_piece_.push_back( piece_start_.size() );
+  cursor_.push_back( first_piece );
+  elapsed_.push_back( 0.0 );
+  start_time_.push_back( pieces.front().start_time );
+  finish_time_.push_back( finish_time );
+  return SPLINE_SUCCESS;
+}
+
+RetCode TrajectoryBank::add( const CubicSplineInterpolator& interpolator,
+                             std::size_t&                   index ) {
+  const TPVAQueue& target_tpva_queue = interpolator.target_tpva_queue_;
+  if( !interpolator.is_path_generated_ || target_tpva_queue.size() < 2 ) {
+    return SPLINE_SEGMENT_NOT_GENERATED;
+  }
+  pieces_.clear();
+  // the finish point is a piece of zero duration, the same as pop()
+  const std::size_t point_num = target_tpva_queue.size();
+  for( std::size_t i=0; i < point_num; i++ ) {
+    pieces_.push_back( PolynomialPiece( target_tpva_queue.get( i ).time,
+                                        interpolator.d_[i], interpolator.c_[i],
+                                        interpolator.b_[i], interpolator.a_[i] ) );
+  }
+  double finish_time = target_tpva_queue.get( point_num - 1 ).time;
+  scale_pieces( interpolator, target_tpva_queue.get( 0 ).time, pieces_, finish_time );
+  return add_pieces( pieces_, finish_time, index );
+}
+
+RetCode TrajectoryBank::add( const TrapezoidalInterpolator& interpolator,
+                             std::size_t&                   index ) {
+  const TPVAQueue& target_tpva_queue = interpolator.target_tpva_queue_;
+  if( !interpolator.is_path_generated_ || target_tpva_queue.size() < 2 ) {
+    return SPLINE_SEGMENT_NOT_GENERATED;
+  }
+  pieces_.clear();
+  const std::size_t segment_num = target_tpva_queue.size() - 1;
+  for( std::size_t i=0; i < segment_num; i++ ) {
+    if( interpolator.ensure_segment( i ) != SPLINE_SUCCESS ) {
+      return SPLINE_FAIL_TO_GENERATE_PATH;
+    }
+    append_trapezoid_pieces( interpolator.trapzd_trajectory_que_[i], pieces_ );
+  }
+  double finish_time = target_tpva_queue.get( segment_num ).time;
+  scale_pieces( interpolator, target_tpva_queue.get( 0 ).time, pieces_, finish_time );
+  return add_pieces( pieces_, finish_time, index );
+}
+
+RetCode TrajectoryBank::add( const Trapezoid5251525& trapezoid, std::size_t& index ) {
+  if( !trapezoid.is_generated() ) {
+    return SPLINE_SEGMENT_NOT_GENERATED;
+  }
+  pieces_.clear();
+  append_trapezoid_pieces( trapezoid, pieces_ );
+  return add_pieces( pieces_, trapezoid.t7(), index );
+}
+
+void TrajectoryBank::clear() {
+  piece_start_.clear();
+  for( std::size_t k=0; k < PolynomialPiece::COEF_NUM; k++ ) {
+    coef_[k].clear();
+  }
+  first_piece_.clear();
+  end_piece_.clear();
+  cursor_.clear();
+  elapsed_.clear();
+  start_time_.clear();
+  finish_time_.clear();
+}
+
+const std::size_t TrajectoryBank::size() const {
+  return first_piece_.size();
+}
+
+const std::size_t TrajectoryBank::piece_num() const {
+  return piece_start_.size();
+}
+
+const double TrajectoryBank::start_time( const std::size_t& index ) const {
+  return start_time_[index];
+}
+
+const double TrajectoryBank::finish_time( const std::size_t& index ) const {
+  return finish_time_[index];
+}
+
+void TrajectoryBank::reset_cursors() {
+  for( std::size_t i=0; i < cursor_.size(); i++ ) {
+    cursor_[i] = first_piece_[i];
+  }
+}
+
+void TrajectoryBank::set_thread_pool( SplineThreadPool* thread_pool,
+                                      const std::size_t& grain ) {
+  thread_pool_    = thread_pool;
+  parallel_grain_ = grain;
+}
+
+SplineThreadPool* TrajectoryBank::thread_pool() const {
+  return thread_pool_;
+}
+
+RetCode TrajectoryBank::evaluate_all( const double& t, double* pos, double* vel, double* acc ) {
+  return evaluate_all<OUTPUT_PVA>( t, pos, vel, acc );
+}
+
+template<unsigned int Mask>
+RetCode TrajectoryBank::evaluate_all( const double& t, double* pos, double* vel, double* acc ) {
+  const std::size_t trajectory_num = size();
+  if( trajectory_num == 0 ) {
+    return SPLINE_SUCCESS;
+  }
+  if( thread_pool_ == NULL ) {
+    evaluate_range<Mask>( t, 0, trajectory_num, pos, vel, acc );
+    return SPLINE_SUCCESS;
+  }
+  TrajectoryBankTask<Mask> task( *this, t, pos, vel, acc );
+  return thread_pool_->parallel_for( 0, trajectory_num, task, parallel_grain_ );
+}
+
+template<unsigned int Mask>
+void TrajectoryBank::evaluate_range( const double& t,
+                                     const std::size_t& begin, const std::size_t& end,
+                                     double* pos, double* vel, double* acc ) {
+  // 1. advance the cursors (forward walk, binary search if the time goes backward)
+  const double* const piece_start = &piece_start_[0];
+  for( std::size_t i=begin; i < end; i++ ) {
+    double clamped_t = t;
+    if( clamped_t < start_time_[i] ) {
+      clamped_t = start_time_[i];
+    } else if( clamped_t > finish_time_[i] ) {
+      clamped_t = finish_time_[i];
+    }
+    std::size_t piece = cursor_[i];
+    if( clamped_t < piece_start[piece] ) {
+      piece = std::upper_bound( piece_start + first_piece_[i] + 1,
+                                piece_start + end_piece_[i], clamped_t ) - piece_start - 1;
+    }
+    const std::size_t last_piece = end_piece_[i] - 1;
+    while( piece < last_piece && piece_start[piece + 1] <= clamped_t ) {
+      piece++;
+    }
+    cursor_[i]  = piece;
+    elapsed_[i] = clamped_t - piece_start[piece];
+  }
+
+  // 2. evaluate by Horner's method without branch
+  const double* const c0 = &coef_[0][0];
+  const double* const c1 = &coef_[1][0];
+  const double* const c2 = &coef_[2][0];
+  const double* const c3 = &coef_[3][0];
+  const double* const c4 = &coef_[4][0];
+  const double* const c5 = &coef_[5][0];
+  const std::size_t* const cursor = &cursor_[0];
+  const double* const elapsed = &elapsed_[0];
+  for( std::size_t i=begin; i < end; i++ ) {
+    const std::size_t piece = cursor[i];
+    const double dt = elapsed[i];
+    if( Mask & OUTPUT_POS ) {
+      pos[i] = c0[piece] + dt * ( c1[piece] + dt * ( c2[piece]
+             + dt * ( c3[piece] + dt * ( c4[piece] + dt * c5[piece] ) ) ) );
+    }
+    if( Mask & OUTPUT_VEL ) {
+      vel[i] = c1[piece] + dt * ( 2.0 * c2[piece]
+             + dt * ( 3.0 * c3[piece] + dt * ( 4.0 * c4[piece] + dt * 5.0 * c5[piece] ) ) );
+    }
+    if( Mask & OUTPUT_ACC ) {
+      acc[i] = 2.0 * c2[piece]
+             + dt * ( 6.0 * c3[piece] + dt * ( 12.0 * c4[piece] + dt * 20.0 * c5[piece] ) );
+    }
+  }
+}
+
+template RetCode TrajectoryBank::evaluate_all<OUTPUT_POS>( const double&, double*, double*, double* );
+template RetCode TrajectoryBank::evaluate_all<OUTPUT_VEL>( const double&, double*, double*, double* );
+template RetCode TrajectoryBank::evaluate_all<OUTPUT_POS_VEL>( const double&, double*, double*, double* );
+template RetCode TrajectoryBank::evaluate_all<OUTPUT_ACC>( const double&, double*, double*, double* );
+template RetCode TrajectoryBank::evaluate_all<OUTPUT_POS|OUTPUT_ACC>( const double&, double*, double*, double* );
+template RetCode TrajectoryBank::evaluate_all<OUTPUT_VEL|OUTPUT_ACC>( const double&, double*, double*, double* );
+template RetCode TrajectoryBank::evaluate_all<OUTPUT_PVA>( const double&, double*, double*, double* );
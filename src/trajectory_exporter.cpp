@@ -0,0 +1,354 @@
+#include "trajectory_exporter.hpp"
+
+#include <cstdio>
+#include <cstdlib> // for strtod
+#include <cstring>
+#include <stdint.h>
+
+using namespace interp;
+
+const std::size_t TrajectoryExporter::DEFAULT_BUFFER_SIZE;
+const std::size_t TrajectoryExporter::MIN_BUFFER_SIZE;
+const std::size_t TrajectoryExporter::FORMAT_SIZE;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// the size of a binary column [byte]
+const std::size_t BINARY_COLUMN_SIZE = 8;
+
+/// store the double as little-endian float64
+/// @param[in]  value source value
+/// @param[out] dest  destination (8 bytes)
+inline void store_double_le( const double& value, char* dest ) {
+  uint64_t bits;
+  std::memcpy( &bits, &value, sizeof(bits) );
+  for( std::size_t i=0; i < BINARY_COLUMN_SIZE; i++ ) {
+    dest[i] = static_cast<char>( ( bits >> ( 8 * i ) ) & 0xff );
+  }
+}
+
+} // End of namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+TrajectoryExporter::TrajectoryExporter() :
+  fp_(NULL), format_(EXPORT_CSV), fill_(0), pending_size_(0), row_size_(0),
+  is_background_(false), has_pending_(false), is_stop_(false), is_failed_(false) {
+  pthread_mutex_init( &mutex_, NULL );
+  pthread_cond_init( &cond_, NULL );
+}
+
+
+TrajectoryExporter::~TrajectoryExporter() {
+  close();
+  pthread_cond_destroy( &cond_ );
+  pthread_mutex_destroy( &mutex_ );
+}
+
+
+RetCode TrajectoryExporter::open( const std::string& path,
+                                  const ExportFormat& format,
+                                  const bool& background,
+                                  const std::size_t& buffer_size ) {
+  close();
+
+  if( format != EXPORT_CSV && format != EXPORT_BINARY ) {
+    return SPLINE_INVALID_FILE_FORMAT;
+  }
+
+  fp_ = std::fopen( path.c_str(), "wb" );
+  if( fp_ == NULL ) {
+    return SPLINE_FILE_IO_ERROR;
+  }
+  // the buffer of this class is enough
+  std::setvbuf( fp_, NULL, _IONBF, 0 );
+
+  format_       = format;
+  fill_         = 0;
+  pending_size_ = 0;
+  row_size_     = 0;
+  has_pending_  = false;
+  is_stop_      = false;
+  is_failed_    = false;
+  const std::size_t size = ( buffer_size < MIN_BUFFER_SIZE ) ? MIN_BUFFER_SIZE : buffer_size;
+  buffer_.resize( size );
+
+  is_background_ = false;
+  if( background ) {
+    pending_.resize( size );
+    if( pthread_create( &writer_, NULL, &TrajectoryExporter::writer_entry, this ) != 0 ) {
+      std::fclose( fp_ );
+      fp_ = NULL;
+      return SPLINE_FILE_IO_ERROR;
+    }
+    is_background_ = true;
+  }
+  return SPLINE_SUCCESS;
+}
+
+
+RetCode TrajectoryExporter::close() {
+  if( fp_ == NULL ) {
+    return SPLINE_SUCCESS;
+  }
+
+  flush_buffer();
+
+  if( is_background_ ) {
+    pthread_mutex_lock( &mutex_ );
+    is_stop_ = true;
+    pthread_cond_broadcast( &cond_ );
+    pthread_mutex_unlock( &mutex_ );
+    pthread_join( writer_, NULL );
+    is_background_ = false;
+  }
+
+  if( std::fclose( fp_ ) != 0 ) {
+    is_failed_ = true;
+  }
+  fp_ = NULL;
+
+  // release the memory of buffers
+  std::vector<char>().swap( buffer_ );
+  std::vector<char>().swap( pending_ );
+  fill_ = 0;
+
+  return ( is_failed_ ) ? SPLINE_FILE_IO_ERROR : SPLINE_SUCCESS;
+}
+
+
+const bool TrajectoryExporter::is_open() const {
+  return ( fp_ != NULL );
+}
+
+
+RetCode TrajectoryExporter::write( const TimePosition& tp ) {
+  if( !begin_row( 2 ) ) {
+    return SPLINE_FILE_IO_ERROR;
+  }
+  append( tp.time, true );
+  append( tp.P );
+  end_row();
+  return SPLINE_SUCCESS;
+}
+
+
+RetCode TrajectoryExporter::write( const TimePVA& tpva ) {
+  if( !begin_row( 4 ) ) {
+    return SPLINE_FILE_IO_ERROR;
+  }
+  append( tpva.time, true );
+  append( tpva.P.pos );
+  append( tpva.P.vel );
+  append( tpva.P.acc );
+  end_row();
+  return SPLINE_SUCCESS;
+}
+
+
+RetCode TrajectoryExporter::write( const TimePVAList& tpva_list ) {
+  const std::size_t axis_size = tpva_list.P.size();
+  if( !begin_row( 1 + 3 * axis_size ) ) {
+    return SPLINE_FILE_IO_ERROR;
+  }
+  append( tpva_list.time, true );
+  for( std::size_t k=0; k < axis_size; k++ ) {
+    append( tpva_list.P[k].pos );
+    append( tpva_list.P[k].vel );
+    append( tpva_list.P[k].acc );
+  }
+  end_row();
+  return SPLINE_SUCCESS;
+}
+
+
+RetCode TrajectoryExporter::write( const TPQueue& queue ) {
+  for( std::size_t i=0; i < queue.size(); i++ ) {
+    const RetCode ret = write( queue.at(i) );
+    if( ret != SPLINE_SUCCESS ) {
+      return ret;
+    }
+  }
+  return SPLINE_SUCCESS;
+}
+
+
+RetCode TrajectoryExporter::write( const TPVAQueue& queue ) {
+  for( std::size_t i=0; i < queue.size(); i++ ) {
+    const RetCode ret = write( queue.at(i) );
+    if( ret != SPLINE_SUCCESS ) {
+      return ret;
+    }
+  }
+  return SPLINE_SUCCESS;
+}
+
+
+RetCode TrajectoryExporter::write( const TPVAListQueue& queue ) {
+  for( std::size_t i=0; i < queue.size(); i++ ) {
+    const RetCode ret = write( queue.at(i) );
+    if( ret != SPLINE_SUCCESS ) {
+      return ret;
+    }
+  }
+  return SPLINE_SUCCESS;
+}
+
+
+RetCode TrajectoryExporter::write_sampled( const SplineInterpolator& interpolator,
+                                           const double& ts,
+                                           const double& tf,
+                                           const double& dT ) {
+  if( dT <= 0.0 ) {
+    return SPLINE_INVALID_INPUT_INTERVAL_TIME_DT;
+  }
+  if( ts > tf ) {
+    return SPLINE_INVALID_INPUT_TIME;
+  }
+  if( fp_ == NULL ) {
+    return SPLINE_FILE_IO_ERROR;
+  }
+
+  // time is not accumulated, so the error does not grow with the number of samples
+  for( std::size_t i=0; ; i++ ) {
+    const double t = ts + dT * i;
+    if( t > tf ) {
+      break;
+    }
+    const RetCode ret = write( interpolator.pop( t ) );
+    if( ret != SPLINE_SUCCESS ) {
+      return ret;
+    }
+  }
+  return SPLINE_SUCCESS;
+}
+
+
+const std::size_t TrajectoryExporter::row_size() const {
+  return row_size_;
+}
+
+
+std::size_t TrajectoryExporter::format_double( const double& value, char* dest ) {
+  // 17 significant digits always read back to the same double
+  int length = 0;
+  for( int precision=15; precision <= 17; precision++ ) {
+    length = snprintf( dest, FORMAT_SIZE, "%.*g", precision, value );
+    if( precision == 17 || std::strtod( dest, NULL ) == value ) {
+      break;
+    }
+  }
+
+  // replace the decimal point of locale with '.'
+  for( int i=0; i < length; i++ ) {
+    const char c = dest[i];
+    if( !( ( c >= '0' && c <= '9' ) || ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' )
+           || c == '-' || c == '+' ) ) {
+      dest[i] = '.';
+    }
+  }
+  return static_cast<std::size_t>( length );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+bool TrajectoryExporter::begin_row( const std::size_t& column_size ) {
+  if( fp_ == NULL ) {
+    return false;
+  }
+
+  const std::size_t row_bytes =
+    ( format_ == EXPORT_CSV ) ? column_size * FORMAT_SIZE + 1 : column_size * BINARY_COLUMN_SIZE;
+  if( fill_ + row_bytes > buffer_.size() ) {
+    if( !flush_buffer() ) {
+      return false;
+    }
+    // a row larger than the buffer
+    if( row_bytes > buffer_.size() ) {
+      buffer_.resize( row_bytes );
+    }
+  }
+  return true;
+}
+
+
+void TrajectoryExporter::append( const double& value, const bool& first ) {
+  if( format_ == EXPORT_CSV ) {
+    if( !first ) {
+      buffer_[fill_++] = ',';
+    }
+    fill_ += format_double( value, &buffer_[fill_] );
+  } else {
+    store_double_le( value, &buffer_[fill_] );
+    fill_ += BINARY_COLUMN_SIZE;
+  }
+}
+
+
+void TrajectoryExporter::end_row() {
+  if( format_ == EXPORT_CSV ) {
+    buffer_[fill_++] = '\n';
+  }
+  row_size_++;
+}
+
+
+bool TrajectoryExporter::flush_buffer() {
+  if( !is_background_ ) {
+    if( fill_ > 0 && std::fwrite( &buffer_[0], 1, fill_, fp_ ) != fill_ ) {
+      is_failed_ = true;
+    }
+    fill_ = 0;
+    return !is_failed_;
+  }
+
+  pthread_mutex_lock( &mutex_ );
+  // wait for the writer thread to finish the previous buffer
+  while( has_pending_ ) {
+    pthread_cond_wait( &cond_, &mutex_ );
+  }
+  const bool is_failed = is_failed_;
+  if( fill_ > 0 && !is_failed ) {
+    buffer_.swap( pending_ );
+    pending_size_ = fill_;
+    has_pending_  = true;
+    pthread_cond_broadcast( &cond_ );
+  }
+  pthread_mutex_unlock( &mutex_ );
+
+  fill_ = 0;
+  return !is_failed;
+}
+
+
+void* TrajectoryExporter::writer_entry( void* arg ) {
+  static_cast<TrajectoryExporter*>( arg )->writer_loop();
+  return NULL;
+}
+
+
+void TrajectoryExporter::writer_loop() {
+  pthread_mutex_lock( &mutex_ );
+  while( true ) {
+    while( !has_pending_ && !is_stop_ ) {
+      pthread_cond_wait( &cond_, &mutex_ );
+    }
+    if( !has_pending_ ) {
+      break;
+    }
+    // pending_ is not touched by the caller until has_pending_ is cleared
+    pthread_mutex_unlock( &mutex_ );
+    const bool is_written =
+      ( std::fwrite( &pending_[0], 1, pending_size_, fp_ ) == pending_size_ );
+    pthread_mutex_lock( &mutex_ );
+
+    if( !is_written ) {
+      is_failed_ = true;
+    }
+    has_pending_ = false;
+    pthread_cond_broadcast( &cond_ );
+  }
+  pthread_mutex_unlock( &mutex_ );
+}
@@ -0,0 +1,1026 @@
+#include "trajectory_file.hpp"
+#include "cubic_spline_kernel.hpp"
+
+#include <cstdio>
+#include <algorithm> // for min, upper_bound
+#include <iomanip> // for setprecision
+#include <cstring>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace interp;
+
+const std::size_t  TrajectoryFile::HEADER_SIZE;
+const unsigned int TrajectoryFile::VERSION;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// magic number at the head of file
+const char TRAJECTORY_FILE_MAGIC[8] = { 'S', 'P', 'L', 'N', 'T', 'R', 'A', 'J' };
+
+/// the number of doubles written at once
+const std::size_t WRITE_CHUNK_SIZE = 4096;
+
+/// Header of trajectory file
+struct TrajectoryFileHeader {
+  /// the kind of queue
+  uint32_t kind;
+  /// the axis size
+  uint32_t axis_size;
+  /// the column size per axis
+  uint32_t column_size;
+  /// the number of points
+  uint64_t point_size;
+  /// the offset of time column
+  uint64_t data_offset;
+};
+
+/// check the host byte order
+/// @return true if little-endian
+bool is_little_endian() {
+  const uint32_t one = 1;
+  unsigned char first;
+  std::memcpy( &first, &one, 1 );
+  return first == 1;
+}
+
+/// store the value into bytes in little-endian
+/// @param[in]  value source value
+/// @param[in]  size  the byte size of value
+/// @param[out] dest  destination bytes
+void store_le( const uint64_t& value, const std::size_t& size, unsigned char* dest ) {
+  for( std::size_t i=0; i < size; i++ ) {
+    dest[i] = (unsigned char)( ( value >> ( 8 * i ) ) & 0xff );
+  }
+}
+
+/// load the value from bytes in little-endian
+/// @param[in] src  source bytes
+/// @param[in] size the byte size of value
+/// @return loaded value
+uint64_t load_le( const unsigned char* src, const std::size_t& size ) {
+  uint64_t value = 0;
+  for( std::size_t i=0; i < size; i++ ) {
+    value |= ( (uint64_t)src[i] ) << ( 8 * i );
+  }
+  return value;
+}
+
+/// write doubles into the file in little-endian
+/// @param[in] fp     destination file
+/// @param[in] values source values
+/// @param[in] num    the number of values
+/// @return true if all values are written
+bool write_doubles( FILE* fp, const double* values, const std::size_t& num ) {
+  if( is_little_endian() ) {
+    return std::fwrite( values, sizeof(double), num, fp ) == num;
+  }
+  for( std::size_t i=0; i < num; i++ ) {
+    uint64_t bits;
+    unsigned char bytes[sizeof(double)];
+    std::memcpy( &bits, &values[i], sizeof(double) );
+    store_le( bits, sizeof(double), bytes );
+    if( std::fwrite( bytes, 1, sizeof(bytes), fp ) != sizeof(bytes) ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// decode and validate the header
+/// @param[in]  bytes     the first HEADER_SIZE bytes of file
+/// @param[in]  file_size the byte size of file
+/// @param[out] header    decoded header
+/// @return
+/// - SPLINE_SUCCESS: no error
+/// - SPLINE_INVALID_FILE_FORMAT: invalid header or file size
+RetCode decode_header( const unsigned char* bytes,
+                       const uint64_t& file_size,
+                       TrajectoryFileHeader& header ) {
+  if( file_size < TrajectoryFile::HEADER_SIZE
+      || std::memcmp( bytes, TRAJECTORY_FILE_MAGIC, sizeof(TRAJECTORY_FILE_MAGIC) ) != 0
+      || load_le( bytes + 8, 4 ) != TrajectoryFile::VERSION ) {
+    return SPLINE_INVALID_FILE_FORMAT;
+  }
+  header.kind        = (uint32_t)load_le( bytes + 12, 4 );
+  header.axis_size   = (uint32_t)load_le( bytes + 16, 4 );
+  header.column_size = (uint32_t)load_le( bytes + 20, 4 );
+  header.point_size  = load_le( bytes + 24, 8 );
+  header.data_offset = load_le( bytes + 32, 8 );
+
+  const bool is_valid_kind =
+    ( header.kind == TRAJECTORY_FILE_TP
+      && header.axis_size == 1 && header.column_size == 1 )
+    || ( header.kind == TRAJECTORY_FILE_TPVA
+         && header.axis_size == 1 && header.column_size == 3 )
+    || ( header.kind == TRAJECTORY_FILE_TPVA_LIST
+         && header.axis_size >= 1 && header.column_size == 3 );
+  if( !is_valid_kind
+      || header.data_offset < TrajectoryFile::HEADER_SIZE
+      || header.data_offset % sizeof(double) != 0
+      || header.data_offset > file_size ) {
+    return SPLINE_INVALID_FILE_FORMAT;
+  }
+  // compare by the number of doubles against overflow
+  const uint64_t column_num = 1 + (uint64_t)header.axis_size * header.column_size;
+  const uint64_t double_num = ( file_size - header.data_offset ) / sizeof(double);
+  if( header.point_size > double_num / column_num ) {
+    return SPLINE_INVALID_FILE_FORMAT;
+  }
+  return SPLINE_SUCCESS;
+}
+
+/// Source of columns for write_file()
+class ColumnSource {
+public:
+  /// Destructor
+  virtual ~ColumnSource() {}
+  /// get the value
+  /// @param[in] index  the index of point
+  /// @param[in] column the index of column (0: time, 1 + axis * column_size + (0: pos, 1: vel, 2: acc))
+  /// @return the value
+  virtual double value( const std::size_t& index, const std::size_t& column ) const = 0;
+};
+
+/// Column source of TPQueue
+class TPColumnSource : public ColumnSource {
+public:
+  explicit TPColumnSource( const TPQueue& queue ) : queue_(queue) {}
+  virtual double value( const std::size_t& index, const std::size_t& column ) const {
+    const TimePosition& tp = queue_.at( index );
+    return ( column == 0 ) ? tp.time : tp.value;
+  }
+private:
+  const TPQueue& queue_;
+};
+
+/// Column source of TPVAQueue
+class TPVAColumnSource : public ColumnSource {
+public:
+  explicit TPVAColumnSource( const TPVAQueue& queue ) : queue_(queue) {}
+  virtual double value( const std::size_t& index, const std::size_t& column ) const {
+    const TimePVA& tpva = queue_.at( index );
+    switch( column ) {
+    case 0:  return tpva.time;
+    case 1:  return tpva.P.pos;
+    case 2:  return tpva.P.vel;
+    default: return tpva.P.acc;
+    }
+  }
+private:
+  const TPVAQueue& queue_;
+};
+
+/// Column source of TPVAListQueue
+class TPVAListColumnSource : public ColumnSource {
+public:
+  explicit TPVAListColumnSource( const TPVAListQueue& queue ) : queue_(queue) {}
+  virtual double value( const std::size_t& index, const std::size_t& column ) const {
+    const TimePVAList& tpva_list = queue_.at( index );
+    if( column == 0 ) {
+      return tpva_list.time;
+    }
+    const PosVelAcc& pva = tpva_list.value[ ( column - 1 ) / 3 ];
+    switch( ( column - 1 ) % 3 ) {
+    case 0:  return pva.pos;
+    case 1:  return pva.vel;
+    default: return pva.acc;
+    }
+  }
+private:
+  const TPVAListQueue& queue_;
+};
+
+/// write the header & all columns into the file
+/// @param[in] path        destination file path
+/// @param[in] kind        the kind of queue
+/// @param[in] axis_size   the axis size
+/// @param[in] column_size the column size per axis
+/// @param[in] point_size  the number of points
+/// @param[in] source      source of columns
+/// @return
+/// - SPLINE_SUCCESS: no error
+/// - SPLINE_FILE_IO_ERROR: cannot open or write the file
+RetCode write_file( const std::string&        path,
+                    const TrajectoryFileKind& kind,
+                    const std::size_t&        axis_size,
+                    const std::size_t&        column_size,
+                    const std::size_t&        point_size,
+                    const ColumnSource&       source ) {
+  FILE* fp = std::fopen( path.c_str(), "wb" );
+  if( fp == NULL ) {
+    return SPLINE_FILE_IO_ERROR;
+  }
+
+  unsigned char header[TrajectoryFile::HEADER_SIZE];
+  std::memset( header, 0, sizeof(header) );
+  std::memcpy( header, TRAJECTORY_FILE_MAGIC, sizeof(TRAJECTORY_FILE_MAGIC) );
+  store_le( TrajectoryFile::VERSION,     4, header + 8 );
+  store_le( kind,                        4, header + 12 );
+  store_le( axis_size,                   4, header + 16 );
+  store_le( column_size,                 4, header + 20 );
+  store_le( point_size,                  8, header + 24 );
+  store_le( TrajectoryFile::HEADER_SIZE, 8, header + 32 );
+  bool is_ok = ( std::fwrite( header, 1, sizeof(header), fp ) == sizeof(header) );
+
+  // each column is written through the chunk buffer
+  std::vector<double> chunk( WRITE_CHUNK_SIZE );
+  const std::size_t column_num = 1 + axis_size * column_size;
+  for( std::size_t c=0; is_ok && c < column_num; c++ ) {
+    for( std::size_t begin=0; is_ok && begin < point_size; begin+=WRITE_CHUNK_SIZE ) {
+      const std::size_t num = std::min( WRITE_CHUNK_SIZE, point_size - begin );
+      for( std::size_t i=0; i < num; i++ ) {
+        chunk[i] = source.value( begin + i, c );
+      }
+      is_ok = write_doubles( fp, &chunk[0], num );
+    }
+  }
+
+  if( std::fclose( fp ) != 0 ) {
+    is_ok = false;
+  }
+  return is_ok ? SPLINE_SUCCESS : SPLINE_FILE_IO_ERROR;
+}
+
+/// read the header & all columns from the file
+/// @param[in]  path    source file path
+/// @param[out] header  decoded header
+/// @param[out] columns all columns (time, pos(, vel, acc) of axis 0, ...)
+/// @return
+/// - SPLINE_SUCCESS: no error
+/// - SPLINE_FILE_IO_ERROR: cannot open or read the file
+/// - SPLINE_INVALID_FILE_FORMAT: the file is not the trajectory file
+RetCode read_file( const std::string&                  path,
+                   TrajectoryFileHeader&               header,
+                   std::vector< std::vector<double> >& columns ) {
+  FILE* fp = std::fopen( path.c_str(), "rb" );
+  if( fp == NULL ) {
+    return SPLINE_FILE_IO_ERROR;
+  }
+  struct stat file_stat;
+  unsigned char header_bytes[TrajectoryFile::HEADER_SIZE];
+  if( fstat( fileno( fp ), &file_stat ) != 0 ) {
+    std::fclose( fp );
+    return SPLINE_FILE_IO_ERROR;
+  }
+  if( (uint64_t)file_stat.st_size < TrajectoryFile::HEADER_SIZE
+      || std::fread( header_bytes, 1, sizeof(header_bytes), fp ) != sizeof(header_bytes) ) {
+    std::fclose( fp );
+    return SPLINE_INVALID_FILE_FORMAT;
+  }
+  RetCode ret = decode_header( header_bytes, file_stat.st_size, header );
+  if( ret == SPLINE_SUCCESS
+      && std::fseek( fp, (long)header.data_offset, SEEK_SET ) != 0 ) {
+    ret = SPLINE_FILE_IO_ERROR;
+  }
+  if( ret != SPLINE_SUCCESS ) {
+    std::fclose( fp );
+    return ret;
+  }
+
+  const bool is_le = is_little_endian();
+  const std::size_t column_num = 1 + header.axis_size * header.column_size;
+  columns.assign( column_num, std::vector<double>( header.point_size ) );
+  for( std::size_t c=0; c < column_num; c++ ) {
+    std::vector<double>& column = columns[c];
+    if( header.point_size > 0
+        && std::fread( &column[0], sizeof(double), column.size(), fp ) != column.size() ) {
+      ret = SPLINE_FILE_IO_ERROR;
+      break;
+    }
+    if( !is_le ) {
+      for( std::size_t i=0; i < column.size(); i++ ) {
+        unsigned char bytes[sizeof(double)];
+        std::memcpy( bytes, &column[i], sizeof(double) );
+        const uint64_t bits = load_le( bytes, sizeof(double) );
+        std::memcpy( &column[i], &bits, sizeof(double) );
+      }
+    }
+  }
+  std::fclose( fp );
+  return ret;
+}
+
+} // End of namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+RetCode TrajectoryFile::write( const std::string& path, const TPQueue& queue ) {
+  return write_file( path, TRAJECTORY_FILE_TP, 1, 1, queue.size(),
+                     TPColumnSource( queue ) );
+}
+
+
+RetCode TrajectoryFile::write( const std::string& path, const TPVAQueue& queue ) {
+  return write_file( path, TRAJECTORY_FILE_TPVA, 1, 3, queue.size(),
+                     TPVAColumnSource( queue ) );
+}
+
+
+RetCode TrajectoryFile::write( const std::string& path, const TPVAListQueue& queue ) {
+  const std::size_t axis_size = ( queue.size() > 0 ) ? queue.at( 0 ).value.size() : 1;
+  for( std::size_t i=0; i < queue.size(); i++ ) {
+    if( queue.at( i ).value.size() != axis_size ) {
+      return SPLINE_INVALID_QUEUE_SIZE;
+    }
+  }
+  if( axis_size == 0 ) {
+    return SPLINE_INVALID_QUEUE_SIZE;
+  }
+  return write_file( path, TRAJECTORY_FILE_TPVA_LIST, axis_size, 3, queue.size(),
+                     TPVAListColumnSource( queue ) );
+}
+
+
+RetCode TrajectoryFile::read( const std::string& path, TPQueue& queue ) {
+  TrajectoryFileHeader header;
+  std::vector< std::vector<double> > columns;
+  RetCode ret = read_file( path, header, columns );
+  if( ret != SPLINE_SUCCESS ) {
+    return ret;
+  }
+  if( header.kind != TRAJECTORY_FILE_TP ) {
+    return SPLINE_INVALID_FILE_FORMAT;
+  }
+  return queue.assign( columns[0], columns[1] );
+}
+
+
+RetCode TrajectoryFile::read( const std::string& path, TPVAQueue& queue ) {
+  TrajectoryFileHeader header;
+  std::vector< std::vector<double> > columns;
+  RetCode ret = read_file( path, header, columns );
+  if( ret != SPLINE_SUCCESS ) {
+    return ret;
+  }
+  if( header.kind == TRAJECTORY_FILE_TPVA_LIST ) {
+    return SPLINE_INVALID_FILE_FORMAT;
+  }
+  std::vector<PosVelAcc> values( header.point_size );
+  for( std::size_t i=0; i < values.size(); i++ ) {
+    values[i].pos = columns[1][i];
+    if( header.column_size == 3 ) {
+      values[i].vel = columns[2][i];
+      values[i].acc = columns[3][i];
+    }
+  }
+  return queue.assign( columns[0], values );
+}
+
+
+RetCode TrajectoryFile::read( const std::string& path, TPVAListQueue& queue ) {
+  TrajectoryFileHeader header;
+  std::vector< std::vector<double> > columns;
+  RetCode ret = read_file( path, header, columns );
+  if( ret != SPLINE_SUCCESS ) {
+    return ret;
+  }
+  std::vector<PVAList> values( header.point_size );
+  for( std::size_t i=0; i < values.size(); i++ ) {
+    values[i].resize( header.axis_size );
+    for( std::size_t k=0; k < header.axis_size; k++ ) {
+      const std::size_t c = 1 + k * header.column_size;
+      values[i][k].pos = columns[c][i];
+      if( header.column_size == 3 ) {
+        values[i][k].vel = columns[c + 1][i];
+        values[i][k].acc = columns[c + 2][i];
+      }
+    }
+  }
+  return queue.assign( columns[0], values );
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+TrajectoryFileView::TrajectoryFileView() :
+  mapped_(NULL), mapped_size_(0),
+  kind_(TRAJECTORY_FILE_TP), axis_size_(0), column_size_(0), point_size_(0),
+  times_(NULL) {
+}
+
+
+TrajectoryFileView::~TrajectoryFileView() {
+  close();
+}
+
+
+RetCode TrajectoryFileView::open( const std::string& path ) {
+  close();
+  if( !is_little_endian() ) {
+    return SPLINE_INVALID_FILE_FORMAT;
+  }
+
+  const int fd = ::open( path.c_str(), O_RDONLY );
+  if( fd < 0 ) {
+    return SPLINE_FILE_IO_ERROR;
+  }
+  struct stat file_stat;
+  if( fstat( fd, &file_stat ) != 0 ) {
+    ::close( fd );
+    return SPLINE_FILE_IO_ERROR;
+  }
+  if( (uint64_t)file_stat.st_size < TrajectoryFile::HEADER_SIZE ) {
+    ::close( fd );
+    return SPLINE_INVALID_FILE_FORMAT;
+  }
+  void* mapped = mmap( NULL, file_stat.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+  // the mapping is kept after closing the file descriptor
+  ::close( fd );
+  if( mapped == MAP_FAILED ) {
+    return SPLINE_FILE_IO_ERROR;
+  }
+
+  TrajectoryFileHeader header;
+  const RetCode ret = decode_header( (const unsigned char*)mapped, file_stat.st_size, header );
+  if( ret != SPLINE_SUCCESS ) {
+    munmap( mapped, file_stat.st_size );
+    return ret;
+  }
+  mapped_      = mapped;
+  mapped_size_ = file_stat.st_size;
+  kind_        = (TrajectoryFileKind)header.kind;
+  axis_size_   = header.axis_size;
+  column_size_ = header.column_size;
+  point_size_  = header.point_size;
+  times_       = (const double*)( (const unsigned char*)mapped + header.data_offset );
+  return SPLINE_SUCCESS;
+}
+
+
+void TrajectoryFileView::close() {
+  if( mapped_ != NULL ) {
+    munmap( mapped_, mapped_size_ );
+  }
+  mapped_      = NULL;
+  mapped_size_ = 0;
+  axis_size_   = 0;
+  column_size_ = 0;
+  point_size_  = 0;
+  times_       = NULL;
+}
+
+
+bool TrajectoryFileView::is_open() const {
+  return mapped_ != NULL;
+}
+
+
+TrajectoryFileKind TrajectoryFileView::kind() const {
+  return kind_;
+}
+
+
+const std::size_t TrajectoryFileView::axis_size() const {
+  return axis_size_;
+}
+
+
+const std::size_t TrajectoryFileView::size() const {
+  return point_size_;
+}
+
+
+const double* TrajectoryFileView::times() const {
+  return times_;
+}
+
+
+const double* TrajectoryFileView::positions( const std::size_t& axis ) const {
+  return column( axis, 0 );
+}
+
+
+const double* TrajectoryFileView::velocities( const std::size_t& axis ) const {
+  return column( axis, 1 );
+}
+
+
+const double* TrajectoryFileView::accelerations( const std::size_t& axis ) const {
+  return column( axis, 2 );
+}
+
+
+const double TrajectoryFileView::time( const std::size_t& index ) const
+  SPLINE_THROW_SPEC(InvalidIndexAccess) {
+  if( index >= point_size_ ) {
+    std::stringstream err_ss;
+    err_ss << "index is invalid. the size of trajectory file : " << point_size_
+           << ", but input index : " << index;
+    THROW( InvalidIndexAccess, err_ss.str() );
+  }
+  return times_[index];
+}
+
+
+const TimePVA TrajectoryFileView::get( const std::size_t& index,
+                                       const std::size_t& axis ) const
+  SPLINE_THROW_SPEC(InvalidIndexAccess) {
+  if( axis >= axis_size_ ) {
+    std::stringstream err_ss;
+    err_ss << "axis is invalid. the axis size of trajectory file : " << axis_size_
+           << ", but input axis : " << axis;
+    THROW( InvalidIndexAccess, err_ss.str() );
+  }
+  TimePVA tpva( time( index ), PosVelAcc( positions( axis )[index] ) );
+  if( column_size_ == 3 ) {
+    tpva.P.vel = velocities( axis )[index];
+    tpva.P.acc = accelerations( axis )[index];
+  }
+  return tpva;
+}
+
+
+const double TrajectoryFileView::dT( const std::size_t& index ) const
+  SPLINE_THROW_SPEC(InvalidIndexAccess) {
+  if( index + 1 >= point_size_ ) {
+    std::stringstream ss;
+    ss << "the index=" << index
+       << " is out of range between 0<= and < the number of dT="
+       << ( ( point_size_ > 0 ) ? point_size_ - 1 : 0 );
+    THROW( InvalidIndexAccess, ss.str() );
+  }
+  return times_[index + 1] - times_[index];
+}
+
+
+const double TrajectoryFileView::total_dT() const {
+  if( point_size_ < 2 ) {
+    return 0.0;
+  }
+  return times_[point_size_ - 1] - times_[0];
+}
+
+
+const double* TrajectoryFileView::column( const std::size_t& axis,
+                                          const std::size_t& column ) const {
+  if( times_ == NULL || axis >= axis_size_ || column >= column_size_ ) {
+    return NULL;
+  }
+  return times_ + ( 1 + axis * column_size_ + column ) * point_size_;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+const std::size_t  TrajectoryStoreWriter::HEADER_SIZE;
+const unsigned int TrajectoryStoreWriter::VERSION;
+
+namespace {
+
+/// magic number at the head of store file
+const char TRAJECTORY_STORE_MAGIC[8] = { 'S', 'P', 'L', 'N', 'S', 'T', 'O', 'R' };
+
+/// the byte size of one entry of the coarse index (start time, chunk offset)
+const std::size_t STORE_INDEX_ENTRY_SIZE = 16;
+
+} // End of namespace
+
+
+TrajectoryStoreWriter::TrajectoryStoreWriter() :
+  fp_(NULL), is_failed_(false),
+  axis_size_(0), chunk_points_(0), point_size_(0), chunk_fill_(0),
+  last_time_(0.0) {
+}
+
+
+TrajectoryStoreWriter::~TrajectoryStoreWriter() {
+  if( fp_ != NULL ) {
+    close();
+  }
+}
+
+
+RetCode TrajectoryStoreWriter::open( const std::string& path,
+                                     const std::size_t& axis_size,
+                                     const std::size_t& chunk_points ) {
+  if( fp_ != NULL ) {
+    close();
+  }
+  if( axis_size == 0 || chunk_points < 2 ) {
+    return SPLINE_INVALID_ARGUMENT_VALUE_ZERO;
+  }
+  fp_ = std::fopen( path.c_str(), "wb" );
+  if( fp_ == NULL ) {
+    return SPLINE_FILE_IO_ERROR;
+  }
+  is_failed_    = false;
+  axis_size_    = axis_size;
+  chunk_points_ = chunk_points;
+  point_size_   = 0;
+  chunk_fill_   = 0;
+  chunk_.assign( ( 1 + 3 * axis_size ) * chunk_points, 0.0 );
+  chunk_start_times_.clear();
+
+  // the header is rewritten at close()
+  unsigned char header[HEADER_SIZE];
+  std::memset( header, 0, sizeof(header) );
+  if( std::fwrite( header, 1, sizeof(header), fp_ ) != sizeof(header) ) {
+    is_failed_ = true;
+  }
+  return is_failed_ ? SPLINE_FILE_IO_ERROR : SPLINE_SUCCESS;
+}
+
+
+RetCode TrajectoryStoreWriter::push( const TimePVA& tpva ) {
+  if( fp_ == NULL || is_failed_ ) {
+    return SPLINE_FILE_IO_ERROR;
+  }
+  if( axis_size_ != 1 ) {
+    return SPLINE_INVALID_QUEUE_SIZE;
+  }
+  if( point_size_ > 0 && tpva.time <= last_time_ ) {
+    return SPLINE_INVALID_INPUT_TIME;
+  }
+  chunk_[ 1 * chunk_points_ + chunk_fill_ ] = tpva.P.pos;
+  chunk_[ 2 * chunk_points_ + chunk_fill_ ] = tpva.P.vel;
+  chunk_[ 3 * chunk_points_ + chunk_fill_ ] = tpva.P.acc;
+  return commit_point( tpva.time );
+}
+
+
+RetCode TrajectoryStoreWriter::push( const double& time, const PVAList& pva_list ) {
+  if( fp_ == NULL || is_failed_ ) {
+    return SPLINE_FILE_IO_ERROR;
+  }
+  if( pva_list.size() != axis_size_ ) {
+    return SPLINE_INVALID_QUEUE_SIZE;
+  }
+  if( point_size_ > 0 && time <= last_time_ ) {
+    return SPLINE_INVALID_INPUT_TIME;
+  }
+  for( std::size_t k=0; k < axis_size_; k++ ) {
+    chunk_[ ( 1 + 3 * k ) * chunk_points_ + chunk_fill_ ] = pva_list[k].pos;
+    chunk_[ ( 2 + 3 * k ) * chunk_points_ + chunk_fill_ ] = pva_list[k].vel;
+    chunk_[ ( 3 + 3 * k ) * chunk_points_ + chunk_fill_ ] = pva_list[k].acc;
+  }
+  return commit_point( time );
+}
+
+
+RetCode TrajectoryStoreWriter::commit_point( const double& time ) {
+  chunk_[ chunk_fill_ ] = time;
+  chunk_fill_++;
+  point_size_++;
+  last_time_ = time;
+  if( chunk_fill_ == chunk_points_ && !flush_chunk() ) {
+    is_failed_ = true;
+    return SPLINE_FILE_IO_ERROR;
+  }
+  return SPLINE_SUCCESS;
+}
+
+
+bool TrajectoryStoreWriter::flush_chunk() {
+  if( chunk_fill_ == 0 ) {
+    return true;
+  }
+  chunk_start_times_.push_back( chunk_[0] );
+  const std::size_t column_num = 1 + 3 * axis_size_;
+  for( std::size_t c=0; c < column_num; c++ ) {
+    if( !write_doubles( fp_, &chunk_[ c * chunk_points_ ], chunk_fill_ ) ) {
+      return false;
+    }
+  }
+  chunk_fill_ = 0;
+  return true;
+}
+
+
+RetCode TrajectoryStoreWriter::close() {
+  if( fp_ == NULL ) {
+    return SPLINE_FILE_IO_ERROR;
+  }
+  bool is_ok = !is_failed_ && flush_chunk();
+
+  // coarse index: chunks except the last one have chunk_points_ points
+  const uint64_t chunk_bytes = (uint64_t)( 1 + 3 * axis_size_ ) * chunk_points_ * sizeof(double);
+  const uint64_t index_offset =
+    HEADER_SIZE + (uint64_t)( 1 + 3 * axis_size_ ) * point_size_ * sizeof(double);
+  for( std::size_t i=0; is_ok && i < chunk_start_times_.size(); i++ ) {
+    unsigned char offset_bytes[8];
+    store_le( HEADER_SIZE + i * chunk_bytes, 8, offset_bytes );
+    is_ok = write_doubles( fp_, &chunk_start_times_[i], 1 )
+      && std::fwrite( offset_bytes, 1, sizeof(offset_bytes), fp_ ) == sizeof(offset_bytes);
+  }
+
+  unsigned char header[HEADER_SIZE];
+  std::memset( header, 0, sizeof(header) );
+  std::memcpy( header, TRAJECTORY_STORE_MAGIC, sizeof(TRAJECTORY_STORE_MAGIC) );
+  store_le( VERSION,                   4, header + 8 );
+  store_le( axis_size_,                4, header + 12 );
+  store_le( chunk_points_,             8, header + 16 );
+  store_le( point_size_,               8, header + 24 );
+  store_le( chunk_start_times_.size(), 8, header + 32 );
+  store_le( index_offset,              8, header + 40 );
+  is_ok = is_ok
+    && std::fseek( fp_, 0, SEEK_SET ) == 0
+    && std::fwrite( header, 1, sizeof(header), fp_ ) == sizeof(header);
+
+  if( std::fclose( fp_ ) != 0 ) {
+    is_ok = false;
+  }
+  fp_ = NULL;
+  chunk_.clear();
+  return is_ok ? SPLINE_SUCCESS : SPLINE_FILE_IO_ERROR;
+}
+
+
+const std::size_t TrajectoryStoreWriter::size() const {
+  return point_size_;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+TrajectoryStorePlayer::TrajectoryStorePlayer( const std::size_t& lookahead ) :
+  lookahead_( ( lookahead < 1 ) ? 1 : lookahead ),
+  mapped_(NULL), mapped_size_(0),
+  axis_size_(0), chunk_points_(0), point_size_(0),
+  resident_begin_(0), resident_end_(0) {
+}
+
+
+TrajectoryStorePlayer::~TrajectoryStorePlayer() {
+  close();
+}
+
+
+RetCode TrajectoryStorePlayer::open( const std::string& path ) {
+  close();
+  if( !is_little_endian() ) {
+    return SPLINE_INVALID_FILE_FORMAT;
+  }
+
+  const int fd = ::open( path.c_str(), O_RDONLY );
+  if( fd < 0 ) {
+    return SPLINE_FILE_IO_ERROR;
+  }
+  struct stat file_stat;
+  if( fstat( fd, &file_stat ) != 0 ) {
+    ::close( fd );
+    return SPLINE_FILE_IO_ERROR;
+  }
+  const uint64_t file_size = file_stat.st_size;
+  if( file_size < TrajectoryStoreWriter::HEADER_SIZE ) {
+    ::close( fd );
+    return SPLINE_INVALID_FILE_FORMAT;
+  }
+  void* mapped = mmap( NULL, file_size, PROT_READ, MAP_SHARED, fd, 0 );
+  ::close( fd );
+  if( mapped == MAP_FAILED ) {
+    return SPLINE_FILE_IO_ERROR;
+  }
+
+  // validate the header & the coarse index
+  const unsigned char* bytes = (const unsigned char*)mapped;
+  const uint64_t axis_size    = load_le( bytes + 12, 4 );
+  const uint64_t chunk_points = load_le( bytes + 16, 8 );
+  const uint64_t point_size   = load_le( bytes + 24, 8 );
+  const uint64_t chunk_size   = load_le( bytes + 32, 8 );
+  const uint64_t index_offset = load_le( bytes + 40, 8 );
+  const uint64_t column_num   = 1 + 3 * axis_size;
+  const bool is_valid =
+    std::memcmp( bytes, TRAJECTORY_STORE_MAGIC, sizeof(TRAJECTORY_STORE_MAGIC) ) == 0
+    && load_le( bytes + 8, 4 ) == TrajectoryStoreWriter::VERSION
+    && axis_size >= 1 && chunk_points >= 2 && point_size >= 1
+    && point_size <= ( file_size / sizeof(double) ) / column_num
+    && chunk_size == ( point_size + chunk_points - 1 ) / chunk_points
+    && index_offset == TrajectoryStoreWriter::HEADER_SIZE + column_num * point_size * sizeof(double)
+    && index_offset + chunk_size * STORE_INDEX_ENTRY_SIZE <= file_size;
+  if( !is_valid ) {
+    munmap( mapped, file_size );
+    return SPLINE_INVALID_FILE_FORMAT;
+  }
+
+  mapped_       = mapped;
+  mapped_size_  = file_size;
+  axis_size_    = axis_size;
+  chunk_points_ = chunk_points;
+  point_size_   = point_size;
+  chunk_start_times_.resize( chunk_size );
+  chunk_offsets_.resize( chunk_size );
+  const uint64_t chunk_bytes = column_num * chunk_points * sizeof(double);
+  for( std::size_t i=0; i < chunk_size; i++ ) {
+    const unsigned char* entry = bytes + index_offset + i * STORE_INDEX_ENTRY_SIZE;
+    std::memcpy( &chunk_start_times_[i], entry, sizeof(double) );
+    chunk_offsets_[i] = load_le( entry + 8, 8 );
+    if( chunk_offsets_[i] != TrajectoryStoreWriter::HEADER_SIZE + i * chunk_bytes
+        || ( i >= 1 && chunk_start_times_[i] <= chunk_start_times_[i-1] ) ) {
+      close();
+      return SPLINE_INVALID_FILE_FORMAT;
+    }
+  }
+  // nothing is resident until the first pop()
+  advise( 0, chunk_size, false );
+  return SPLINE_SUCCESS;
+}
+
+
+void TrajectoryStorePlayer::close() {
+  if( mapped_ != NULL ) {
+    munmap( mapped_, mapped_size_ );
+  }
+  mapped_       = NULL;
+  mapped_size_  = 0;
+  axis_size_    = 0;
+  chunk_points_ = 0;
+  point_size_   = 0;
+  chunk_start_times_.clear();
+  chunk_offsets_.clear();
+  resident_begin_ = 0;
+  resident_end_   = 0;
+}
+
+
+bool TrajectoryStorePlayer::is_open() const {
+  return mapped_ != NULL;
+}
+
+
+const TimePVA TrajectoryStorePlayer::pop( const double& t, const std::size_t& axis ) const {
+  if( axis >= axis_size_ && is_open() ) {
+    std::stringstream err_ss;
+    err_ss << "axis is invalid. the axis size of trajectory store : " << axis_size_
+           << ", but input axis : " << axis;
+    THROW( InvalidIndexAccess, err_ss.str() );
+  }
+  std::size_t chunk_index, point_index;
+  locate( t, chunk_index, point_index );
+  return TimePVA( t, evaluate( t, chunk_index, point_index, axis ) );
+}
+
+
+const TimePVAList TrajectoryStorePlayer::pop_list( const double& t ) const {
+  std::size_t chunk_index, point_index;
+  locate( t, chunk_index, point_index );
+  TimePVAList tpva_list( t );
+  tpva_list.value.resize( axis_size_ );
+  for( std::size_t k=0; k < axis_size_; k++ ) {
+    tpva_list.value[k] = evaluate( t, chunk_index, point_index, k );
+  }
+  return tpva_list;
+}
+
+
+const double TrajectoryStorePlayer::start_time() const {
+  if( !is_open() ) {
+    THROW( NotSplineGenerated, "trajectory store is not opened." );
+  }
+  return chunk_start_times_.front();
+}
+
+
+const double TrajectoryStorePlayer::finish_time() const {
+  if( !is_open() ) {
+    THROW( NotSplineGenerated, "trajectory store is not opened." );
+  }
+  const std::size_t last_chunk = chunk_start_times_.size() - 1;
+  return column( last_chunk, 0 )[ chunk_point_size( last_chunk ) - 1 ];
+}
+
+
+const std::size_t TrajectoryStorePlayer::size() const {
+  return point_size_;
+}
+
+
+const std::size_t TrajectoryStorePlayer::axis_size() const {
+  return axis_size_;
+}
+
+
+const std::size_t TrajectoryStorePlayer::chunk_size() const {
+  return chunk_start_times_.size();
+}
+
+
+const std::size_t TrajectoryStorePlayer::resident_chunk_size() const {
+  return resident_end_ - resident_begin_;
+}
+
+
+void TrajectoryStorePlayer::locate( const double& t,
+                                    std::size_t& chunk_index,
+                                    std::size_t& point_index ) const {
+  const double ts = start_time();
+  const double tf = finish_time();
+  if( t < ts || t > tf ) {
+    std::stringstream err_ss;
+    err_ss << std::fixed << std::setprecision(15);
+    err_ss << "time value = " << t
+           << " is out of range of trajectory store between start time (=" << ts
+           << ") and finish time (=" << tf << ").";
+    THROW( TimeOutOfRange, err_ss.str() );
+  }
+
+  // coarse index: the last chunk which starts at or before t
+  chunk_index = std::upper_bound( chunk_start_times_.begin(), chunk_start_times_.end(), t )
+    - chunk_start_times_.begin() - 1;
+  page( chunk_index );
+
+  // the last point in the chunk at or before t
+  const double* times = column( chunk_index, 0 );
+  point_index = std::upper_bound( times, times + chunk_point_size( chunk_index ), t )
+    - times - 1;
+}
+
+
+const PosVelAcc TrajectoryStorePlayer::evaluate( const double&      t,
+                                                 const std::size_t& chunk_index,
+                                                 const std::size_t& point_index,
+                                                 const std::size_t& axis ) const {
+  const std::size_t pos_column = 1 + 3 * axis;
+  const double& time0 = column( chunk_index, 0 )[point_index];
+  const double& pos0  = column( chunk_index, pos_column     )[point_index];
+  const double& vel0  = column( chunk_index, pos_column + 1 )[point_index];
+  const double& acc0  = column( chunk_index, pos_column + 2 )[point_index];
+
+  // the end point of the segment is the next in the chunk or the first of the next chunk
+  std::size_t next_chunk = chunk_index;
+  std::size_t next_point = point_index + 1;
+  if( next_point == chunk_point_size( chunk_index ) ) {
+    if( chunk_index + 1 == chunk_start_times_.size() ) {
+      // t is the finish time
+      return PosVelAcc( pos0, vel0, acc0 );
+    }
+    next_chunk++;
+    next_point = 0;
+  }
+  const double& time1 = column( next_chunk, 0 )[next_point];
+  const double& pos1  = column( next_chunk, pos_column     )[next_point];
+  const double& vel1  = column( next_chunk, pos_column + 1 )[next_point];
+
+  // the same coefficients as CubicSplineInterpolator
+  double a = 0.0, b = 0.0, c = 0.0, d = 0.0;
+  g_cubic_hermite( pos0, vel0, pos1, vel1, time1 - time0, a, b, c, d );
+  PosVelAcc pva;
+  g_cubic_evaluate( a, b, c, d, t - time0, pva.pos, pva.vel, pva.acc );
+  return pva;
+}
+
+
+void TrajectoryStorePlayer::page( const std::size_t& chunk_index ) const {
+  const std::size_t begin = chunk_index;
+  const std::size_t end   = std::min( chunk_index + lookahead_ + 1, chunk_start_times_.size() );
+  if( begin == resident_begin_ && end == resident_end_ ) {
+    return;
+  }
+  // drop the chunks out of the new window
+  if( resident_begin_ < begin ) {
+    advise( resident_begin_, std::min( resident_end_, begin ), false );
+  }
+  if( end < resident_end_ ) {
+    advise( std::max( resident_begin_, end ), resident_end_, false );
+  }
+  // read ahead the chunks which are new in the window
+  if( begin < resident_begin_ || begin >= resident_end_ ) {
+    advise( begin, end, true );
+  } else if( resident_end_ < end ) {
+    advise( resident_end_, end, true );
+  }
+  resident_begin_ = begin;
+  resident_end_   = end;
+}
+
+
+void TrajectoryStorePlayer::advise( const std::size_t& begin,
+                                    const std::size_t& end,
+                                    const bool& will_need ) const {
+  if( begin >= end ) {
+    return;
+  }
+  const std::size_t page_size = sysconf( _SC_PAGESIZE );
+  std::size_t first = chunk_offsets_[begin];
+  std::size_t last  = ( end < chunk_offsets_.size() ) ?
+    chunk_offsets_[end] : TrajectoryStoreWriter::HEADER_SIZE
+                          + ( 1 + 3 * axis_size_ ) * point_size_ * sizeof(double);
+  if( will_need ) {
+    // whole pages including the chunks
+    first = first / page_size * page_size;
+    last  = std::min( ( last + page_size - 1 ) / page_size * page_size, mapped_size_ );
+  } else {
+    // only the pages inside the chunks, not to drop the neighbors
+    first = ( first + page_size - 1 ) / page_size * page_size;
+    last  = last / page_size * page_size;
+  }
+  if( first < last ) {
+    madvise( (char*)mapped_ + first, last - first,
+             will_need ? MADV_WILLNEED : MADV_DONTNEED );
+  }
+}
+
+
+const double* TrajectoryStorePlayer::column( const std::size_t& chunk_index,
+                                             const std::size_t& column ) const {
+  const unsigned char* chunk = (const unsigned char*)mapped_ + chunk_offsets_[chunk_index];
+  return (const double*)chunk + column * chunk_point_size( chunk_index );
+}
+
+
+const std::size_t TrajectoryStorePlayer::chunk_point_size( const std::size_t& chunk_index ) const {
+  const std::size_t first_point = chunk_index * chunk_points_;
+  return std::min( chunk_points_, point_size_ - first_point );
+}
@@ -0,0 +1,195 @@
+#include "trajectory_lut.hpp"
+#include "spline_interpolator.hpp"
+
+#include <math.h>
+
+using namespace interp;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+const std::size_t TrajectoryLUT::MAX_LEVEL;
+
+TrajectoryLUT::TrajectoryLUT() :
+  start_time_(0.0), finish_time_(0.0), cell_dT_(0.0), inverse_cell_dT_(0.0),
+  interpolation_(LUT_HERMITE), max_deviation_(0.0) {
+  for( std::size_t level=0; level <= MAX_LEVEL; level++ ) {
+    level_dT_[level]         = 0.0;
+    level_inverse_dT_[level] = 0.0;
+  }
+}
+
+
+RetCode TrajectoryLUT::build_uniform( const SplineInterpolator& interpolator,
+                                      const double&             dT,
+                                      const LUTInterpolation&   interpolation ) {
+  return build( interpolator, dT, 0.0, interpolation, 0 );
+}
+
+
+RetCode TrajectoryLUT::build_adaptive( const SplineInterpolator& interpolator,
+                                       const double&             base_dT,
+                                       const double&             tolerance,
+                                       const LUTInterpolation&   interpolation,
+                                       const std::size_t&        max_level ) {
+  if( tolerance <= 0.0 ) {
+    return SPLINE_INVALID_ARGUMENT_VALUE_ZERO;
+  }
+  return build( interpolator, base_dT, tolerance, interpolation,
+                ( max_level < MAX_LEVEL ) ? max_level : MAX_LEVEL );
+}
+
+
+void TrajectoryLUT::clear() {
+  start_time_      = 0.0;
+  finish_time_     = 0.0;
+  cell_dT_         = 0.0;
+  inverse_cell_dT_ = 0.0;
+  max_deviation_   = 0.0;
+  cell_offset_.clear();
+  cell_level_.clear();
+  pos_.clear();
+  vel_.clear();
+  acc_.clear();
+}
+
+
+const double TrajectoryLUT::start_time() const {
+  return start_time_;
+}
+
+
+const double TrajectoryLUT::finish_time() const {
+  return finish_time_;
+}
+
+
+const std::size_t TrajectoryLUT::size() const {
+  return pos_.size();
+}
+
+
+const std::size_t TrajectoryLUT::cell_num() const {
+  return cell_level_.size();
+}
+
+
+const std::size_t TrajectoryLUT::level( const std::size_t& cell ) const {
+  return cell_level_[cell];
+}
+
+
+const LUTInterpolation TrajectoryLUT::interpolation() const {
+  return interpolation_;
+}
+
+
+const double TrajectoryLUT::max_deviation() const {
+  return max_deviation_;
+}
+
+
+RetCode TrajectoryLUT::build( const SplineInterpolator& interpolator,
+                              const double&             base_dT,
+                              const double&             tolerance,
+                              const LUTInterpolation&   interpolation,
+                              const std::size_t&        max_level ) {
+  clear();
+  if( !( base_dT > 0.0 ) ) {
+    return SPLINE_INVALID_INPUT_INTERVAL_TIME_DT;
+  }
+  try {
+    start_time_  = interpolator.start_time();
+    finish_time_ = interpolator.finish_time();
+
+    // cells of the same length within base_dT
+    const double span = finish_time_ - start_time_;
+    std::size_t cell_num = static_cast<std::size_t>( ceil( span / base_dT - 1.0e-9 ) );
+    if( cell_num == 0 ) {
+      cell_num = 1;
+    }
+    cell_dT_         = span / cell_num;
+    inverse_cell_dT_ = g_isNearlyZero( cell_dT_ ) ? 0.0 : 1.0 / cell_dT_;
+    for( std::size_t level=0; level <= MAX_LEVEL; level++ ) {
+      const double interval_num = static_cast<double>( static_cast<std::size_t>( 1 ) << level );
+      level_dT_[level]         = cell_dT_ / interval_num;
+      level_inverse_dT_[level] = inverse_cell_dT_ * interval_num;
+    }
+    interpolation_   = interpolation;
+    cell_offset_.resize( cell_num );
+    cell_level_.resize( cell_num );
+
+    const TimePVA start = interpolator.pop( start_time_ );
+    pos_.push_back( start.P.pos );
+    vel_.push_back( start.P.vel );
+    acc_.push_back( start.P.acc );
+
+    for( std::size_t cell=0; cell < cell_num; cell++ ) {
+      cell_offset_[cell] = pos_.size() - 1;
+      std::size_t level = 0;
+      sample_cell( interpolator, cell, level );
+      double deviation = cell_deviation( interpolator, cell );
+      while( deviation > tolerance && level < max_level ) {
+        level++;
+        sample_cell( interpolator, cell, level );
+        deviation = cell_deviation( interpolator, cell );
+      }
+      if( deviation > max_deviation_ ) {
+        max_deviation_ = deviation;
+      }
+    }
+  } catch( const NotSplineGenerated& e ) {
+    clear();
+    return SPLINE_SEGMENT_NOT_GENERATED;
+  }
+  return SPLINE_SUCCESS;
+}
+
+
+void TrajectoryLUT::sample_cell( const SplineInterpolator& interpolator,
+                                 const std::size_t& cell, const std::size_t& level ) {
+  const std::size_t offset       = cell_offset_[cell];
+  const std::size_t interval_num = static_cast<std::size_t>( 1 ) << level;
+  const bool        is_last_cell = ( cell + 1 == cell_level_.size() );
+  cell_level_[cell] = static_cast<unsigned char>( level );
+  pos_.resize( offset + 1 );
+  vel_.resize( offset + 1 );
+  acc_.resize( offset + 1 );
+  for( std::size_t i=1; i <= interval_num; i++ ) {
+    double t = start_time_ + cell_dT_ * ( cell + static_cast<double>( i ) / interval_num );
+    // the end of the path is not rounded out of range
+    if( ( is_last_cell && i == interval_num ) || t > finish_time_ ) {
+      t = finish_time_;
+    }
+    const TimePVA tpva = interpolator.pop( t );
+    pos_.push_back( tpva.P.pos );
+    vel_.push_back( tpva.P.vel );
+    acc_.push_back( tpva.P.acc );
+  }
+}
+
+
+const double TrajectoryLUT::cell_deviation( const SplineInterpolator& interpolator,
+                                            const std::size_t& cell ) const {
+  static const double CHECK_POINTS[] = { 0.25, 0.5, 0.75 };
+  const std::size_t level        = cell_level_[cell];
+  const std::size_t interval_num = static_cast<std::size_t>( 1 ) << level;
+  const double      h            = level_dT_[level];
+  const double      inverse_h    = level_inverse_dT_[level];
+  double deviation = 0.0;
+  double pos = 0.0, unused = 0.0;
+  for( std::size_t i=0; i < interval_num; i++ ) {
+    for( std::size_t k=0; k < sizeof( CHECK_POINTS ) / sizeof( CHECK_POINTS[0] ); k++ ) {
+      const double u = CHECK_POINTS[k];
+      double t = start_time_ + cell_dT_ * cell + h * ( i + u );
+      if( t > finish_time_ ) {
+        t = finish_time_;
+      }
+      interpolate<OUTPUT_POS>( cell_offset_[cell] + i, u, h, inverse_h, pos, unused, unused );
+      const double error = fabs( interpolator.pop( t ).P.pos - pos );
+      if( error > deviation ) {
+        deviation = error;
+      }
+    }
+  }
+  return deviation;
+}
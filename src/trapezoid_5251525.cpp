@@ -1,13 +1,10 @@
 #include "trapezoid_5251525.hpp"
-
-// #define DEBUG_ 1
+#include "trapezoid_5251525_kernel.hpp"
+#include "trapezoid_5251525_profile.hpp"
 
 #define V_EPSILON 1.0e-15
-#define X_EPSILON 1.0e-9
 #define T_EPSILON 1.0e-12
 
-#define SIGNV(a) ((a>=0) ? 1: -1)
-
 using namespace interp;
 
 const double Trapezoid5251525::DT_MAX_LIMIT_ = 900.0; // [sec] = 15[min]
@@ -97,8 +94,9 @@ Trapezoid5251525::Trapezoid5251525(const Trapezoid5251525& src) :
   is_fastest_     ( src.is_fastest()     ) {
 }
 
-Trapezoid5251525 Trapezoid5251525::operator=(const Trapezoid5251525& src) {
-  Trapezoid5251525 dest(src);
+Trapezoid5251525& Trapezoid5251525::operator=(const Trapezoid5251525& src) {
+  // 全てスカラー値のため、自己代入でも一時コピーは不要
+  const Trapezoid5251525& dest = src;
   this->x0_ = dest.x0();
   this->v0_ = dest.v0();
   this->xf_ = dest.xf();
@@ -220,11 +218,6 @@ void Trapezoid5251525::initialize(const double& a_limit,
 double Trapezoid5251525::generate_path(const double& ts, const double& tf,
                                        const double& xs, const double& xf,
                                        const double& vs, const double& vf ) {
-  // if ( !is_initialized_ ) {
-  //   // 軌道構成パラメータが与えられてない
-  //   throw std::runtime_error("Not initialized config parameter yet.");
-  // }
-
   is_generated_ = false;
   no_movement_  = false;
   is_fastest_   = false;
@@ -235,697 +228,110 @@ double Trapezoid5251525::generate_path(const double& ts, const double& tf,
   v0_ = vs;
   vf_ = vf;
 
-  // 0. 入力チェック
-  this->input_check();
+  // 計画は constexpr の Trapezoid5251525Profile と共通
+  Trapezoid5251525Profile profile( a_limit_, d_limit_, v_limit_, asr_, dsr_, ratio_acc_dec_ );
+  const RetCode retcode = profile.generate_path( ts, tf, xs, xf, vs, vf );
+  if( retcode != SPLINE_SUCCESS ) {
+    this->throw_generation_error( profile, retcode );
+  }
+  this->assign_profile( profile );
+
+  // 軌道生成完了フラグを立てる
+  this->is_generated_ = true;
 
   // 移動なしフラグが立っていれば軌道を生成しない
   if (no_movement_) {
-    // 最終到達時刻を終了時間にしておく
-    t7_ = tf_;
-    // 軌道生成完了フラグを立てる
-    this->is_generated_ = true;
     return -1.0;
   }
-
-  // 1. 最大速度方向の初期設定
-  double sign_init = calc_initial_v_max_direction_sign();
-
-#ifdef DEBUG_
-  std::cout << std::fixed << std::setprecision(15);
-  std::cout << "\n ==== Tragectory Generator ====\n";
-  std::cout << "accleration_limit: " << a_limit_ << std::endl;
-  std::cout << "decceleration_limit: " << d_limit_ << std::endl;
-  std::cout << "v_limit: " << v_limit_ << std::endl;
-  std::cout << "a_smoothing_rate: " << asr_ << std::endl;
-  std::cout << "d_smoothing_rate: " << dsr_ << std::endl;
-  std::cout << "sign : " << sign_ << std::endl;
-  std::cout << "t0 : " << t0_  << std::endl;
-  std::cout << "x0 : " << x0_  << std::endl;
-  std::cout << "v0 : " << v0_  << std::endl;
-  std::cout << "tf : " << tf_  << std::endl;
-  std::cout << "xf : " << xf_  << std::endl;
-  std::cout << "vf : " << vf_  << std::endl;
-  std::cout << std::endl;
-#endif
-
-  // 2. 加速度上限値による、最速軌道の最大速度と最短時間の算出
-  this->calc_fastest_parameter(a_limit_, d_limit_);
-  a_max_ = a_limit_;
-  d_max_ = d_limit_;
-
-  // 3. 到達限界・速度反転領域の判定
-  this->judge_reach_limitation();
-  signA_ = sign_;
-  signD_ = sign_;
-#ifdef DEBUG_
-    std::cout << "sign on v_max_fastest : " << sign_ << std::endl;
-#endif
-
-  // 最速軌道の最大速度方向が反転していた場合
-  if ( sign_ != sign_init ) {
-#ifdef DEBUG_
-    std::cout << "recalculate v_max_fastest." << std::endl;
-#endif
-
-    // 反転符号で再度最速軌道の最大速度を再計算
-    this->calc_fastest_parameter(a_limit_, d_limit_);
-  }
-
-
-  // 最終到達時刻が与えられている場合 = 最速軌道でない場合
-  // 最速軌道でも、上で時間＆パラメータを求めた後、以降4, 5の計算で再度パラメータ値を確定させる
-  {
-    // 加速度を、最短時間に対する目標移動時間の比率により、上限値と下限値の内分をとって算出
-    calc_acceleration_with_ratio();
-
-#ifdef DEBUG_
-    std::cout << "a_max_ : " << a_max_ << std::endl;
-    std::cout << "d_max_ : " << d_max_ << std::endl;
-#endif
-
-    // 新しい加速度による、最速軌道の最大速度と最短時間の算出
-    this->calc_fastest_parameter(a_max_, d_max_);
-    // 新しい加速度による、到達限界・速度反転領域の判定
-    this->judge_reach_limitation();
-    signA_ = sign_;
-    signD_ = sign_;
-#ifdef DEBUG_
-    std::cout << "sign : " << sign_ << std::endl;
-#endif
-    // 4. 移動距離の再計算
-    xd_ = xf_ - x0_;
-
-    // 5. 最大速度v_maxと等速移動時間dT3の算出
-    this->calc_v_max_and_dT3();
-  }
-
-  // 6. 軌道パラメータを算出する
-  this->set_parameter();
-
-  // 7, 軌道生成完了フラグを立てる
-  this->is_generated_ = true;
-
   return dT_total_;
 }
 
-/// 0.
-void Trapezoid5251525::input_check() {
-  if(t0_ < 0.0 || tf_ < 0.0){
-    // 開始時刻もしくは終了時刻が負の場合エラー
-    std::stringstream ss;
-    ss << "t0 < 0.0 or tf < 0.0\n : t0 = "
-       << std::fixed << std::setprecision(15)
-       << t0_ << "\n   tf = " << tf_;
-    std::cerr << ss.str() << std::endl;
-    throw std::invalid_argument( ss.str() );
+void Trapezoid5251525::assign_profile( const Trapezoid5251525Profile& profile ) {
+  no_movement_ = profile.no_movement_;
+  is_fastest_  = profile.is_fastest_;
+  // 最終到達時刻 (移動なしでは終了時刻)
+  t7_ = profile.t7_;
+  if (no_movement_) {
+    return;
   }
-  if (tf_ != 0.0 && t0_ > tf_) {
-    // 開始時刻が終端時刻を超えていたらエラー
-    std::stringstream ss;
-    ss << "t0 exceeds tf (t0 > tf) : "
-       << std::fixed << std::setprecision(15)
-       << t0_ << " > " << tf_;
+  // 最速軌道では終了時刻は最短時刻となる
+  tf_ = profile.tf_;
+
+  a_max_ = profile.a_max_;
+  d_max_ = profile.d_max_;
+  sign_  = profile.sign_;
+  signA_ = profile.signA_;
+  signD_ = profile.signD_;
+  v_max_ = profile.v_max_;
+  xd_    = profile.xd_;
+  v_max_fastest_ = profile.v_max_fastest_;
+  dT3_fastest_   = profile.dT3_fastest_;
+  tf_fastest_    = profile.tf_fastest_;
+
+  dT1_ = profile.dT1_;
+  dT2_ = profile.dT2_;
+  dT3_ = profile.dT3_;
+  dT4_ = profile.dT4_;
+  dT5_ = profile.dT5_;
+  dT_total_ = profile.dT_total_;
+
+  t1_ = profile.t1_;  x1_ = profile.x1_;  v1_ = profile.v1_;
+  t2_ = profile.t2_;  x2_ = profile.x2_;  v2_ = profile.v2_;
+  t3_ = profile.t3_;  x3_ = profile.x3_;  v3_ = profile.v3_;
+  t4_ = profile.t4_;  x4_ = profile.x4_;  v4_ = profile.v4_;
+  t5_ = profile.t5_;  x5_ = profile.x5_;  v5_ = profile.v5_;
+  t6_ = profile.t6_;  x6_ = profile.x6_;  v6_ = profile.v6_;
+}
+
+void Trapezoid5251525::throw_generation_error( const Trapezoid5251525Profile& profile,
+                                               const RetCode&                 retcode ) const {
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(15);
+  if (retcode == SPLINE_INVALID_INPUT_TIME) {
+    // 0. 開始時刻もしくは終了時刻が負, 逆順, もしくは移動時間が最大閾値を超えている
+    ss << "invalid time : t0 = " << t0_ << ", tf = " << tf_
+       << " (0.0 <= t0 <= tf (or tf = 0.0) and tf - t0 <= DT_MAX_LIMIT ("
+       << this->DT_MAX_LIMIT_ << ") are required)";
     std::cerr << ss.str() << std::endl;
     throw std::invalid_argument( ss.str() );
   }
-  if((fabs(v0_) > v_limit_) || (fabs(vf_) > v_limit_)) {
-    // 初期速度、終端速度が速度リミットを超えていたらエラー
-    std::stringstream ss;
-    ss << "|v0| or |v1| ("
-       << std::fixed << std::setprecision(15)
-       << fabs(v0_) << " or " << fabs(vf_)
+  if (profile.failed_step_ == 0) {
+    // 0. 初期速度、終端速度が速度リミットを超えている (構成パラメータは initialize() で確認済み)
+    ss << "|v0| or |v1| (" << fabs(v0_) << " or " << fabs(vf_)
        << ") exceeds v_limit (" << v_limit_ <<  ")";
     std::cerr << ss.str() << std::endl;
     throw std::invalid_argument( ss.str() );
   }
-  // 開始と終了地点が同じでかつ開始と終了の速度0.0ならば移動なしフラグを立てる
-  if ( fabs(x0_-xf_)<= X_EPSILON && fabs(v0_)<= V_EPSILON && fabs(vf_)<= V_EPSILON) {
-      no_movement_ = true;
-#ifdef DEBUG_
-      std::cout << "no_movement_ : " << no_movement_ << std::endl;
-#endif
-  }
-  if( (tf_ - t0_) > this->DT_MAX_LIMIT_ ) {
-    // 指定移動時間が最大閾値を超えていたらエラー
-    std::stringstream ss;
-    ss << "interval time (tf - t0 : "
-       << std::fixed << std::setprecision(15)
-       << tf_ << " - " << t0_ << " = " << (tf_ - t0_)
-       << ") exceeds DT_MAX_LIMIT (" << this->DT_MAX_LIMIT_ <<  ")";
-    std::cerr << ss.str() << std::endl;
-    throw std::invalid_argument( ss.str() );
-  }
-  // 終了時刻が0.0の場合、最速軌道フラグを立てる
-  if( tf_ == 0.0 )
-  {
-    is_fastest_ = true;
-  }
-
-}
-
-/// 1.
-double Trapezoid5251525::calc_initial_v_max_direction_sign() {
-  sign_ = (xf_ - x0_ > 0) ? 1 : -1;
-  // 位置が同じ場合,
-  if (fabs(x0_-xf_) <= X_EPSILON) {
-    sign_ = ( fabs(v0_) < fabs(vf_) ) ? SIGNV(vf_) : SIGNV(v0_);
-  }
-  return sign_;
-}
-
-/// 2.
-void Trapezoid5251525::calc_fastest_parameter( const double& a_max,
-                                               const double& d_max ) {
-  // 移動距離
-  xd_ = sign_ * (xf_-x0_);
-
-  // 三角形軌道の最高速度を算出
-  double p1 = a_max*(1+asr_);
-  double p2 = d_max*(1+dsr_);
-  double p3 =  (p1*v0_*v0_+ p2*vf_*vf_+ 2*a_max*d_max*xd_) / (p1 + p2);
-  v_max_fastest_ = sign_*std::sqrt(fabs(p3));
-#ifdef DEBUG_
-  std::cout << "p3 : " << p3 << std::endl;
-#endif
-  // 境界台形
-  double xd_limit =
-    0.5*(1+asr_)*(v_limit_*v_limit_ - v0_*v0_)/a_max
-    +
-    0.5*(1+dsr_)*(v_limit_*v_limit_ - vf_*vf_)/d_max;
-#ifdef DEBUG_
-  std::cout << "xd_: " << xd_ << std::endl;
-  std::cout << "xd_limit: " << xd_limit << std::endl;
-#endif
-
-  // 最速軌道が台形か三角形かチェック
-  if( fabs(v_max_fastest_) > v_limit_) {
-    // 台形
-    v_max_fastest_ = sign_ * v_limit_;
-    dT3_fastest_   = fabs( (xd_limit - xd_) / v_limit_ );
-  } else {
-    // 三角形
-    dT3_fastest_ = 0.0;
-  }
-
-  double dT1_fastest = asr_*fabs(v_max_fastest_ - v0_) / a_max;
-  double dT2_fastest = (1-asr_)*fabs(v_max_fastest_ - v0_) / a_max;
-  double dT4_fastest = dsr_*fabs(v_max_fastest_ - vf_) / d_max;
-  double dT5_fastest = (1-dsr_)*fabs(v_max_fastest_ - vf_) / d_max;
-  tf_fastest_ = t0_ + 2*dT1_fastest + dT2_fastest + dT3_fastest_ + 2*dT4_fastest + dT5_fastest;
-
-#ifdef DEBUG_
-  std::cout << "is_fastest_ : " << is_fastest_ << std::endl;
-  std::cout << "v_max_fastest : " << v_max_fastest_ << std::endl;
-  std::cout << "dT3_fastest : " << dT3_fastest_ << std::endl;
-  std::cout << "tf_fastest : " << tf_fastest_ << std::endl;
-#endif
-
-  // tf_の時刻がtf_fastest_とほぼ同じ場合、最速軌道動作とする
-  if ( (is_fastest_)
-       || ((tf_ - tf_fastest_ >= 0.0) && (tf_ - tf_fastest_ <= T_EPSILON))
-       || (fabs(tf_ - tf_fastest_) <= X_EPSILON)
-     ) {
-
-    tf_    = (tf_ < tf_fastest_) ? tf_fastest_ : tf_;
-    v_max_ = v_max_fastest_;
-    dT3_   = dT3_fastest_;
-    is_fastest_ = true;
-
-  } else if ( tf_ < tf_fastest_ ) {
-    std::stringstream ss;
+  if (profile.failed_step_ == 2) {
+    // 2. 到達不可能
     ss << "unreachable parameter. tf < fastest time: "
-       << std::fixed << std::setprecision(15)
-       << tf_ << " < " << tf_fastest_;
+       << profile.tf_ << " < " << profile.tf_fastest_;
     std::cerr << ss.str() << std::endl;
-    // 到達不可能！エラー！
     throw std::invalid_argument( ss.str() );
   }
-
-}
-
-/// 3.
-void Trapezoid5251525::judge_reach_limitation() {
-  // 到達不能領域L1識別子：v_step2_square_x_eq_xfの算出
-  double v_max_L1 = v_max_fastest_;
-  // double v_max_L1 = v_limit_;
-  double dT1_L1   = asr_ * fabs(v_max_L1 - v0_) / a_max_;
-  double x1_L1    = 0.15*sign_*a_max_*dT1_L1*dT1_L1 + v0_*dT1_L1 + x0_;
-  double v1_L1    = 0.50*sign_*a_max_*dT1_L1 + v0_;
-  double v_step2_square_x_eq_xf = fabs(sign_*2.0*a_max_*(xf_ - x1_L1) + v1_L1*v1_L1);
-#ifdef DEBUG_
-  std::cout << "v_max_L1 : " << v_max_L1 << std::endl;
-  std::cout << "v_step2_square_x_eq_xf : " << v_step2_square_x_eq_xf << std::endl;
-#endif
-
-  // 到達不能領域L2識別子：x_step6_x_eq_0,
-  // 到達不能領域L3識別子：v_step6_square_x_eq_xfの算出
-  double v_max_L2L3 = v0_;
-  double xf_L2L3    = x0_;
-  double vf_L2L3    = (-1.0) * v0_;
-  double sign_L2L3   = (v0_ >= 0.0) ? 1 : -1;
-  if(v0_ == 0.0) {
-    sign_L2L3 = (vf_>= 0.0) ? -1 : 1;
-  }
-#ifdef DEBUG_
-  std::cout << "sign_L2L3 : " << sign_L2L3 << std::endl;
-#endif
-  double dT4_L2L3 = dsr_*fabs(v_max_L2L3 - vf_L2L3) / d_max_;
-  double dT5_L2L3 = (1-dsr_)*fabs(v_max_L2L3 - vf_L2L3) / d_max_;
-  double v6_L2L3  = vf_L2L3 + 0.50*sign_L2L3*d_max_*dT4_L2L3;
-  double x6_L2L3  = xf_L2L3 + 0.35*sign_L2L3*d_max_*dT4_L2L3*dT4_L2L3 - v6_L2L3*dT4_L2L3;
-  double v5_L2L3  = v6_L2L3 + sign_L2L3*d_max_*dT5_L2L3;
-  double x5_L2L3  = x6_L2L3 + 0.50*sign_L2L3*d_max_*dT5_L2L3*dT5_L2L3 - v5_L2L3*dT5_L2L3;
-  double x_step6_v_eq_0 = fabs(0.50*sign_L2L3*v5_L2L3*v5_L2L3 / d_max_ + x5_L2L3);
-#ifdef DEBUG_
-  std::cout << "x_step6_v_eq_0 : " << x_step6_v_eq_0 << std::endl;
-#endif
-  double v_step6_square_x_eq_xf = 2.0*sign_L2L3*d_max_*(x5_L2L3 - xf_)
-                                   + v5_L2L3*v5_L2L3;
-#ifdef DEBUG_
-  std::cout <<  "v_step6_square_x_eq_xf : " << v_step6_square_x_eq_xf << std::endl;
-  std::cout <<  "vf^2 : " << vf_*vf_ << std::endl;
-#endif
-
-  // 判定
-
-#ifdef DEBUG_ // デバッグ出力
-  std::cout << std::endl;
-  std::cout << "in L1? " << std::endl;
-  std::cout << "- v0_*vf(=" << (v0_*vf_) << ") >= 0.0 ? : "
-            << (v0_*vf_ >= 0.0)
-            << std::endl;
-  std::cout << "- vf_*vf_(=" << (vf_*vf_)
-            << ") >= v_step2_square_x_eq_xf(="
-            << v_step2_square_x_eq_xf << ") ? : "
-            << ( vf_*vf_ >= v_step6_square_x_eq_xf )
-            << std::endl;
-  std::cout << "- v_step2_square_x_eq_xf(="
-            << v_step2_square_x_eq_xf
-            << ") > v_max_L1*v_max_L1(="
-            << v_max_L1*v_max_L1 << ") ? : "
-            << ( v_step2_square_x_eq_xf > v_max_L1*v_max_L1 )
-            << std::endl;
-  std::cout << "- fabs(vf_)(=" << fabs(vf_)
-            << ") >= fabs(v_max_L1)(=" << fabs(v_max_L1) << ") ? : "
-            << ( fabs(vf_) >= fabs(v_max_L1) )
-            << std::endl;
-  std::cout << "- ( v0_*vf_ >= 0.0" << std::endl;
-  std::cout << "   && ( vf_*vf_ >= v_step2_square_x_eq_xf" << std::endl;
-  std::cout << "        || ( v_step2_square_x_eq_xf > v_max_L1*v_max_L1" << std::endl;
-  std::cout << "             && fabs(vf_) >= fabs(v_max_L1) ))" << std::endl;
-  std::cout << "   && sign_*vf_ >=0 ) ? : "
-            << ( v0_*vf_ >= 0.0
-                 && ( vf_*vf_ >= v_step2_square_x_eq_xf
-                      || ( v_step2_square_x_eq_xf > v_max_L1*v_max_L1
-                           && fabs(vf_) >= fabs(v_max_L1) ) )
-                 && sign_*vf_ >=0 )
-            << std::endl;
-  std::cout << std::endl;
-  std::cout << "in L4?" << std::endl;
-  std::cout << "- v0_*vf_(="<< v0_*vf_<< ") <= 0.0 ? : "
-            << (v0_*vf_ <= 0.0)
-            << std::endl;
-  std::cout << "- ( vf_*vf_(=" << vf_*vf_
-            << ") >= v_step6_square_x_eq_xf(="
-            << v_step6_square_x_eq_xf
-            << ") ) ? : " << ( vf_*vf_ >= v_step6_square_x_eq_xf )
-            << std::endl;
-  std::cout << "- fabs(vf_)(=" << fabs(vf_)
-            << ") > fabs(v0_)(=" << fabs(v0_) << ") ? : "
-            << ( fabs(vf_) > fabs(v0_) )
-            << std::endl;
-  std::cout << "- sign_*vf_(" << sign_*vf_ << ") >= 0.0 ? : "
-            << ( sign_*vf_ >= 0.0 )
-            << std::endl;
-  std::cout << "- ( (v0_*vf_ <= 0.0)" << std::endl;
-  std::cout << "   && ( vf_*vf_ >= v_step6_square_x_eq_xf )" << std::endl;
-  std::cout << "   && ( fabs(vf_) > fabs(v0_) )" << std::endl;
-  std::cout << "   && sign_*vf_ >= 0.0 ) ? : "
-            << ( (v0_*vf_ <= 0.0)
-                 && ( vf_*vf_ >= v_step6_square_x_eq_xf )
-                 && ( fabs(vf_) > fabs(v0_) )
-                 && sign_*vf_ >= 0.0 )
-            << std::endl;
-  std::cout << std::endl;
-  std::cout << "in L2 or L3?" << std::endl;
-  std::cout << "- v0_(=" << v0_ << ") != 0.0 ? :"
-            << (v0_ != 0.0)
-            << std::endl;
-  std::cout << "- SIGNV(v0_)(=" << SIGNV(v0_)
-            << ") * ( (xf_-x0_ > 0) ? 1 : ((xf_-x0_ == 0) ? 0 : -1) )(="
-            << ( (xf_-x0_ > 0) ? 1 : ((xf_-x0_ == 0) ? 0 : -1) ) << ") >= 0 ? :"
-            << ( SIGNV(v0_) * ( (xf_-x0_ > 0) ? 1 : ((xf_-x0_ == 0) ? 0 : -1) ) >= 0 )
-            << std::endl;
-  std::cout << "- vf_*vf_(=" << vf_*vf_
-            << ") <= v_step6_square_x_eq_xf(="
-            << v_step6_square_x_eq_xf << ") ? : "
-            << (vf_*vf_<= v_step6_square_x_eq_xf)
-            << std::endl;
-  std::cout << "- xd_(=" << xd_
-            << ") <= fabs(x_step6_v_eq_0 - x0_)(="
-            << fabs(x_step6_v_eq_0 - x0_) << ") ? : "
-            << (xd_ <= fabs(x_step6_v_eq_0 - x0_))
-            << std::endl;
-  std::cout << "- ( v0_ != 0.0" << std::endl;
-  std::cout << "   && SIGNV(v0_) * ( (xf_-x0_ > 0) ? 1 : ((xf_-x0_ == 0) ? 0 : -1) ) >= 0"
-            << std::endl;
-  std::cout << "   && vf_*vf_<= v_step6_square_x_eq_xf" << std::endl;
-  std::cout << "   && xd_ <= fabs(x_step6_v_eq_0 - x0_ ) ? : ";
-  std::cout << ( v0_ != 0.0
-                 && SIGNV(v0_) * ( (xf_-x0_ > 0) ? 1 : ((xf_-x0_ == 0) ? 0 : -1) ) >= 0
-                 && vf_*vf_<= v_step6_square_x_eq_xf
-                 && xd_ <= fabs(x_step6_v_eq_0 - x0_) )
-            << std::endl;
-  std::cout << std::endl;
-#endif // ここまでデバッグ出力用
-
-  if ( v0_*vf_ >= 0.0
-       && ( vf_*vf_ >= v_step2_square_x_eq_xf
-            || ( v_step2_square_x_eq_xf > v_max_L1*v_max_L1
-                 && fabs(vf_) >= fabs(v_max_L1) ))
-       && sign_*vf_ >=0 ) {
-#ifdef DEBUG_
-    std::cout << ">>>> (region L1 : vf^2 < v_step2_square_x_eq_xf) :"
-              << (vf_*vf_) << " < " << v_step2_square_x_eq_xf << std::endl;
-#endif
-    // 到達不能領域L1
-    // 速度を反転する
-    sign_ = (-1) * sign_;
-
-    // if (tf_ != 0.0) {
-    //   // 終端時刻を指定した場合、加速度リミットエラーとする
-    //   std::stringstream ss1, ss2;
-    //   ss1 << (vf_*vf_);
-    //   ss2 << v_step2_square_x_eq_xf;
-    //   throw std::runtime_error( "unreachable parameter -- acceleratopn limit error.\n"
-    //                             "  (region L1 : vf^2 < v_step2_square_x_eq_xf) :"
-    //                             + ss1.str() + " < " + ss2.str() );
-    // }
-
-  } else if ( v0_*vf_ <= 0.0
-              && ( vf_*vf_ >= v_step6_square_x_eq_xf )
-              && ( fabs(vf_) > fabs(v0_) )
-              && sign_*vf_ >= 0.0 ) {
-#ifdef DEBUG_
-    std::cout << ">>>> (region L4 : vf^2 >= v_step6_square_x_eq_xf) :"
-              << (vf_*vf_) << " >= " << v_step6_square_x_eq_xf << std::endl;
-#endif
-    // // 到達不能領域L4
-    sign_ = (-1) * sign_;
-
-    // if (tf_ != 0.0) {
-    //   // 終端時刻を指定した場合、加速度リミットエラーとする
-    //   std::stringstream ss1, ss2;
-    //   ss1 << (vf_*vf_);
-    //   ss2 << v_step6_square_x_eq_xf;
-    //   throw std::runtime_error( "unreachable parameter  -- acceleratopn limit error.\n"
-    //                             "  (region L4 : vf^2 < v_step6_square_x_eq_xf) :"
-    //                             + ss1.str() + " < " + ss2.str() );
-    // }
-
-  } else if ( v0_ != 0.0
-              && SIGNV(v0_) * ( (xf_-x0_ > 0) ? 1 : ((xf_-x0_ == 0) ? 0 : -1) ) >= 0
-              && vf_*vf_<= v_step6_square_x_eq_xf
-              && xd_ <= fabs(x_step6_v_eq_0 - x0_) ) {
-#ifdef DEBUG_
-    std::cout << ">>>> (region L2,L3 : xd < |x_step6_v_eq_0 - x0|) :"
-              << xd_ << " < " << fabs(x_step6_v_eq_0 - x0_) << std::endl;
-#endif
-    // 速度を反転する
-    sign_ = (-1) * sign_;
-
-    // if (tf_ != 0.0) {
-    //   // 終端時刻を指定した場合、加速度リミットエラーとする
-    //   std::stringstream ss1, ss2;
-    //   ss1 << xd_;
-    //   ss2 << fabs(x_step6_v_eq_0 - x0_);
-    //   throw std::runtime_error( "unreachable parameter  -- acceleratopn limit error.\n"
-    //                             "  (region L2,L3 : xd < |x_step6_v_eq_0 - x0|) :"
-    //                             + ss1.str() + " < " + ss2.str() );
-    // }
-  }
-}
-
-///
-void Trapezoid5251525::calc_acceleration_with_ratio() {
-  // 前提として,ここでは
-  // tf_ != 0.0 && tf_ >= t0_ >= 0.0
-  // tf_ > tf_fastest_ が保証されている
-  if (tf_ - t0_ == 0.0) {
-    a_max_ = a_lower_limit_;
-    d_max_ = d_lower_limit_;
-    return;
-  }
-  double dt_ratio = (tf_fastest_ - t0_) / (tf_ - t0_);
-  a_max_ = a_limit_*dt_ratio*dt_ratio + a_lower_limit_*(1.0 - dt_ratio*dt_ratio);
-  d_max_ = d_limit_*dt_ratio*dt_ratio + d_lower_limit_*(1.0 - dt_ratio*dt_ratio);
-}
-
-
-/// 5.
-double Trapezoid5251525::internal_calc_v_max_and_dT3(const double& signA,
-                                                     const double& signD,
-                                                     double& dT3, bool& ret) {
-  double pA = signA*0.5*(1.0+asr_)/a_max_
-            + signD*0.5*(1.0+dsr_)/d_max_;
-  double pB = tf_-t0_ + signA*(1.0+asr_)*v0_/a_max_
-                      + signD*(1.0+dsr_)*vf_/d_max_;
-  double pC = xd_ + signA * 0.5*(1.0+asr_)*v0_*v0_/a_max_
-                  + signD * 0.5*(1.0+dsr_)*vf_*vf_/d_max_;
-  double pD = pB*pB - 4.0*pA*pC;
-  double v_max;
-  double xd = xd_;
-  ret = true;
-  // pA==0 && pB!=0
-  if ( fabs(pA) < V_EPSILON && fabs(pB)>V_EPSILON ) {
-#ifdef DEBUG_
-    std::cout << std::endl;
-    std::cout << "Case 2,3" << std::endl;
-#endif
-    v_max = pC / pB;
-    dT3 = (tf_ - t0_) - signA * (1.0+asr_)*(v_max - v0_)/a_max_
-                      - signD * (1.0+dsr_)*(v_max - vf_)/d_max_;
-  } else if (pD < 0.0 ) {
-#ifdef DEBUG_
-    std::cout << std::endl;
-    std::cout << "pD no solution" << std::endl;
-#endif
-    if(!is_fastest_) {
-      // ２次方程式の判別式が0未満で最速軌道でなければ解なしで終了
-      ret = false;
-    }
-    v_max = v_max_fastest_;
-    dT3   = dT3_fastest_;
-
+  // 5. 最大速度v_maxと等速移動時間dT3の解なし, もしくは速度リミット超過
+  if (fabs(profile.v_max_) > fabs(v_limit_) + V_EPSILON) {
+    ss << "unreachable parameter. solved v_max(=" << fabs(profile.v_max_)
+       << ") exceeds v_limit(=" << v_limit_ << ").";
   } else {
-#ifdef DEBUG_
-    std::cout << std::endl;
-    std::cout << "Case 1,4" << std::endl;
-#endif
-    v_max = 0.5*( pB - std::sqrt(pD) )/pA;
-    dT3 = tf_ - t0_ - signA * (1.0+asr_)*(v_max - v0_)/a_max_
-                    - signD * (1.0+dsr_)*(v_max - vf_)/d_max_;
-
-    if( is_fastest_
-        && (fabs(v_max) > fabs(v_max_fastest_)) ) {
-#ifdef DEBUG_
-    std::cout << std::endl;
-    std::cout << "v_max(=" << v_max
-              << ") > v_max_fastest(=" << v_max_fastest_
-              << ")" << std::endl;
-#endif
-      v_max = v_max_fastest_;
-      dT3   = dT3_fastest_;
-    }
-
-    xd = signA*0.5*(1.0+asr_)*(v_max*v_max - v0_*v0_)/a_max_
-       + signD*0.5*(1.0+dsr_)*(v_max*v_max - vf_*vf_)/d_max_ + v_max*dT3 ;
-  }
-
-  // v_maxとv0_の大小関係, v_maxとvfの大小関係のパターンに
-  // 当てはまらなければ解なしで終了
-  if(sign_*v_max <= -1.0 * V_EPSILON
-     || signA*(v_max - v0_) < 0.0
-     || signD*(v_max - vf_) < 0.0
-     || fabs(xd - xd_) > X_EPSILON
-     || dT3 < 0.0) {
-    ret = false;
-#ifdef DEBUG_
-    std::cout << std::endl;
-    std::cout << "not satisfied with all condition" << std::endl;
-#endif
-  }
-#ifdef DEBUG_
-  std::cout << std::endl;
-  std::cout << "v0 : " << v0_ << std::endl;
-  std::cout << "vf : " << vf_ << std::endl;
-  std::cout << "sign : " << sign_ << std::endl;
-  std::cout << "signA : " << signA << std::endl;
-  std::cout << "signD : " << signD << std::endl;
-  std::cout << "pA : " << pA << std::endl;
-  std::cout << "pB : " << pB << std::endl;
-  std::cout << "pC : " << pC << std::endl;
-  std::cout << "pD : " << pD << std::endl;
-  std::cout << "tf - t0 : " << tf_-t0_ << std::endl;
-  std::cout << "v_max : " << v_max << std::endl;
-  std::cout << "dT3 : " << dT3 << std::endl;
-  std::cout << "xd_ : " << xd_ << std::endl;
-  std::cout << "xd : " << xd << std::endl;
-  std::cout << "sign_*v_max(="<<(sign_*v_max)<<") <= -"<<V_EPSILON<<" : "
-            << (sign_*v_max < -1.0*V_EPSILON) << std::endl;
-  std::cout << "signA*(v_max - v0_)(="<<(signA*(v_max - v0_))<<") < 0.0 : "
-            << (signA*(v_max - v0_) < 0.0) << std::endl;
-  std::cout << "signD*(v_max - vf_)(="<<(signD*(v_max - vf_))<<") < 0.0 : "
-            << (signD*(v_max - vf_) < 0.0) << std::endl;
-  std::cout << "fabs(xd - xd_)(="<<(fabs(xd - xd_))<< ") > "<< X_EPSILON<<" : "
-            << (fabs(xd - xd_) > X_EPSILON) << std::endl;
-  std::cout << "dT3 < 0.0 : " << (dT3 < 0.0) << std::endl;
-#endif
-  return v_max;
-}
-
-void Trapezoid5251525::calc_v_max_and_dT3() {
-  bool ret;
-  signA_ = sign_;
-  signD_ = sign_;
-  v_max_ = this->internal_calc_v_max_and_dT3(signA_, signD_, dT3_, ret);
-  if ( !ret ) {
-    signA_ = (-1)*sign_;
-    signD_ = sign_;
-    v_max_ = this->internal_calc_v_max_and_dT3(signA_, signD_, dT3_, ret);
-  }
-  if ( !ret ) {
-    signA_ = sign_;
-    signD_ = (-1)*sign_;
-    v_max_ = this->internal_calc_v_max_and_dT3(signA_, signD_, dT3_, ret);
-  }
-  if ( !ret ) {
-    signA_ = (-1)*sign_;
-    signD_ = (-1)*sign_;
-    v_max_ = this->internal_calc_v_max_and_dT3(signA_, signD_, dT3_, ret);
-  }
-
-  ////
-
-  if ( !ret ) {
-    sign_ = (-1)*sign_;
-    signA_ = sign_;
-    signD_ = sign_;
-    v_max_ = this->internal_calc_v_max_and_dT3(signA_, signD_, dT3_, ret);
-  }
-  if ( !ret ) {
-    signA_ = (-1)*sign_;
-    signD_ = sign_;
-    v_max_ = this->internal_calc_v_max_and_dT3(signA_, signD_, dT3_, ret);
-  }
-  if ( !ret ) {
-    signA_ = sign_;
-    signD_ = (-1)*sign_;
-    v_max_ = this->internal_calc_v_max_and_dT3(signA_, signD_, dT3_, ret);
-  }
-  if ( !ret ) {
-    signA_ = (-1)*sign_;
-    signD_ = (-1)*sign_;
-    v_max_ = this->internal_calc_v_max_and_dT3(signA_, signD_, dT3_, ret);
-  }
-
-  ///
-
-  if ( !ret ) {
-    std::stringstream ss1;
-    ss1 << std::fixed << std::setprecision(15);
-    if (dT3_ < 0.0) {
-      ss1 << "unreachable parameter. dT3 is not able to be solved.\n & ";
-    }
-    ss1 << "unreachable parameter. v_max is not able to be solved." << std::endl
-        << "It seems that acceleration limit(a_max="<< a_max_ <<",d max=" << d_max_
-        << ") could not be satisfied with inputs:" << std::endl
-        << "   - time(=tf-t0)="       << tf_-t0_  << std::endl
-        << "   - start position(x0)=" << x0_      << std::endl
-        << "   - start_velocity(v0)=" << v0_      << std::endl
-        << "   - goal_position(xf)="  << xf_      << std::endl
-        << "   - goal_velocity(vf)="  << vf_      << std::endl
-        << "   - v_limit: "           << v_limit_ << std::endl
-        << "   - a_smoothing_rate: "  << asr_     << std::endl
-        << "   - d_smoothing_rate: "  << dsr_     << std::endl;
-    std::cerr << ss1.str() << std::endl;
-    throw std::runtime_error( ss1.str() );
-  }
-
-  if (fabs(v_max_) > fabs(v_limit_)+V_EPSILON) {
-    std::stringstream ss2;
-    ss2 << std::fixed << std::setprecision(15)
-        << "unreachable parameter. solved v_max(="
-        << fabs(v_max_)
-        << ") exceeds v_limit+" << V_EPSILON << "(="
-        << (fabs(v_limit_)+V_EPSILON) << ").";
-    std::cerr << ss2.str() << std::endl;
-    throw std::runtime_error( ss2.str() );
-  }
-}
-
-/// 6.
-void Trapezoid5251525::set_parameter() {
-  dT1_ = asr_ * fabs(v_max_ - v0_)/a_max_;
-  dT2_ = (1-asr_) * fabs(v_max_ - v0_)/a_max_;
-  dT4_ = dsr_ * fabs(v_max_ - vf_)/d_max_;
-  dT5_ = (1-dsr_) * fabs(v_max_ - vf_)/d_max_;
-
-  v1_ = signA_ * 0.50 * a_max_ * dT1_ + v0_;
-  x1_ = signA_ * 0.15 * a_max_ * dT1_ * dT1_ + v0_ * dT1_ + x0_;
-  v2_ = signA_ * a_max_ * dT2_ + v1_;
-  x2_ = signA_ * 0.50 * a_max_ * dT2_ * dT2_ + v1_ * dT2_ + x1_;
-  v3_ = signA_ * 0.50 * a_max_ * dT1_ + v2_;
-  x3_ = signA_ * 0.35 * a_max_ * dT1_ * dT1_ + v2_ * dT1_ + x2_;
-
-  v6_ = vf_ + signD_ * 0.50 * d_max_ * dT4_;
-  x6_ = xf_ + signD_ * 0.35 * d_max_ * dT4_ * dT4_ - v6_ * dT4_;
-  v5_ = v6_ + signD_ * d_max_ * dT5_;
-  x5_ = x6_ + signD_ * 0.50 * d_max_ * dT5_ * dT5_ - v5_ * dT5_;
-  v4_ = v_max_;
-  x4_ = x5_ + signD_ * 0.15 * d_max_ * dT4_ * dT4_ - v_max_ * dT4_;
-
-  t1_ = t0_ + dT1_;
-  t2_ = t1_ + dT2_;
-  t3_ = t2_ + dT1_;
-  t4_ = t3_ + dT3_;
-  t5_ = t4_ + dT4_;
-  t6_ = t5_ + dT5_;
-  t7_ = t6_ + dT4_;
-  dT_total_ = 2*dT1_ + dT2_ + dT3_ + 2*dT4_ + dT5_;
-
-#ifdef DEBUG_
-  std::cout << "dT1 : " << dT1_ << std::endl;
-  std::cout << "dT2 : " << dT2_ << std::endl;
-  std::cout << "dT3 : " << dT3_ << std::endl;
-  std::cout << "dT4 : " << dT4_ << std::endl;
-  std::cout << "dT5 : " << dT5_ << std::endl;
-  std::cout << "xd : " << xd_ << std::endl;
-  std::cout << "v0 : " << v0_ << std::endl;
-  std::cout << "x0 : " << x0_ << std::endl;
-  std::cout << "v1 : " << v1_ << std::endl;
-  std::cout << "x1 : " << x1_ << std::endl;
-  std::cout << "v2 : " << v2_ << std::endl;
-  std::cout << "x2 : " << x2_ << std::endl;
-  std::cout << "v3 : " << v3_ << std::endl;
-  std::cout << "x3 : " << x3_ << std::endl;
-  std::cout << "v6 : " << v6_ << std::endl;
-  std::cout << "x6 : " << x6_ << std::endl;
-  std::cout << "v5 : " << v5_ << std::endl;
-  std::cout << "x5 : " << x5_ << std::endl;
-  std::cout << "v4 : " << v4_ << std::endl;
-  std::cout << "x4 : " << x4_ << std::endl;
-  std::cout << "t1 : " << t1_ << std::endl;
-  std::cout << "t2 : " << t2_ << std::endl;
-  std::cout << "t3 : " << t3_ << std::endl;
-  std::cout << "t4 : " << t4_ << std::endl;
-  std::cout << "t5 : " << t5_ << std::endl;
-  std::cout << "t6 : " << t6_ << std::endl;
-  std::cout << "t7 : " << t7_ << std::endl;
-#endif
-
+    ss << "unreachable parameter. v_max is not able to be solved." << std::endl
+       << "It seems that acceleration limit(a_max="<< profile.a_max_
+       << ",d max=" << profile.d_max_
+       << ") could not be satisfied with inputs:" << std::endl
+       << "   - time(=tf-t0)="       << profile.tf_ - t0_ << std::endl
+       << "   - start position(x0)=" << x0_      << std::endl
+       << "   - start_velocity(v0)=" << v0_      << std::endl
+       << "   - goal_position(xf)="  << xf_      << std::endl
+       << "   - goal_velocity(vf)="  << vf_      << std::endl
+       << "   - v_limit: "           << v_limit_ << std::endl
+       << "   - a_smoothing_rate: "  << asr_     << std::endl
+       << "   - d_smoothing_rate: "  << dsr_     << std::endl;
+  }
+  std::cerr << ss.str() << std::endl;
+  throw std::runtime_error( ss.str() );
 }
 
+template<unsigned int Mask>
 const int Trapezoid5251525::pop(const double& t, double& xt, double& vt, double& at) const {
   if (!is_generated_) {
     std::string err_msg = "Not generated path yet.";
@@ -934,108 +340,54 @@ const int Trapezoid5251525::pop(const double& t, double& xt, double& vt, double&
   }
 
   if (no_movement_) {
-    xt = x0_;
-    vt = v0_;
-    at = 0.0;
+    if( Mask & OUTPUT_POS ) {
+      xt = x0_;
+    }
+    if( Mask & OUTPUT_VEL ) {
+      vt = v0_;
+    }
+    if( Mask & OUTPUT_ACC ) {
+      at = 0.0;
+    }
     return 0;
   }
 
+  // 各Stepの出力は g_trapezoid5251525_step() による (Trapezoid5251525Profile と共通)
   if ( t0_ <= t && t < t1_) {
     // Step1
-    xt = signA_ * (-0.1) * a_max_/(dT1_ * dT1_ * dT1_)
-          * (t-t0_) * (t-t0_) * (t-t0_) * (t-t0_) * (t-t0_)
-       + signA_ * 0.25 * a_max_/(dT1_ * dT1_)
-          * (t-t0_) * (t-t0_) * (t-t0_) * (t-t0_)
-       + v0_ * (t-t0_) + x0_;
-
-    vt = signA_ * (-0.50) * a_max_/(dT1_ * dT1_ * dT1_)
-          * (t-t0_) * (t-t0_) * (t-t0_) * (t-t0_)
-       + signA_ * a_max_/(dT1_ * dT1_)
-          * (t-t0_) * (t-t0_) * (t-t0_) + v0_;
-
-    at = signA_ * (2.0) * a_max_/(dT1_ * dT1_ * dT1_)
-          * (t-t0_) * (t-t0_) * (t-t0_)
-       + signA_ * (3.0) * a_max_/(dT1_ * dT1_)
-          * (t-t0_) * (t-t0_);
+    g_trapezoid5251525_step<Mask>( TRAPZD_ROUND_IN, t-t0_, signA_ * a_max_, dT1_,
+                                   v0_, x0_, xt, vt, at );
 
   } else if ( t1_ <= t && t < t2_) {
     // Step2
-    xt = signA_ * 0.50 * a_max_ * (t-t1_) * (t-t1_) + v1_ * (t-t1_) + x1_;
-
-    vt = signA_ * 1.00 * a_max_ * (t-t1_) + v1_;
-
-    at = signA_ * a_max_;
+    g_trapezoid5251525_step<Mask>( TRAPZD_CONSTANT, t-t1_, signA_ * a_max_, dT1_,
+                                   v1_, x1_, xt, vt, at );
 
   } else if ( t2_ <= t && t < t3_) {
     // Step3
-    xt = signA_ * 0.10 * a_max_/(dT1_ * dT1_ * dT1_)
-          * (t-t2_) * (t-t2_) * (t-t2_) * (t-t2_) * (t-t2_)
-       - signA_ * (0.25) * a_max_/(dT1_ * dT1_)
-          * (t-t2_) * (t-t2_) * (t-t2_) * (t-t2_)
-       + signA_ * 0.50 * a_max_ * (t-t2_) * (t-t2_)
-       + v2_ * (t-t2_) + x2_;
-
-    vt = signA_ * 0.50 * a_max_/(dT1_ * dT1_ * dT1_)
-          * (t-t2_) * (t-t2_) * (t-t2_) * (t-t2_)
-       - signA_ * a_max_/(dT1_ * dT1_) * (t-t2_) * (t-t2_) * (t-t2_)
-       + signA_ * a_max_ * (t-t2_) + v2_;
-
-    at = signA_ * 2.0 * a_max_/(dT1_ * dT1_ * dT1_)
-          * (t-t2_) * (t-t2_) * (t-t2_)
-       - signA_ * 3.0 * a_max_/(dT1_ * dT1_) * (t-t2_) * (t-t2_)
-       + signA_ * a_max_;
+    g_trapezoid5251525_step<Mask>( TRAPZD_ROUND_OUT, t-t2_, signA_ * a_max_, dT1_,
+                                   v2_, x2_, xt, vt, at );
 
   } else if ( t3_ <= t && t < t4_) {
     // Step4
-    xt = v_max_ * (t-t3_) + x3_;
-    vt = v_max_;
-    at = 0.0;
+    g_trapezoid5251525_step<Mask>( TRAPZD_CONSTANT, t-t3_, 0.0, dT1_,
+                                   v_max_, x3_, xt, vt, at );
+
   } else if ( t4_ <= t && t < t5_) {
     // Step5
-    xt = signD_ * 0.10 * d_max_/(dT4_ * dT4_ * dT4_)
-          * (t-t4_) * (t-t4_) * (t-t4_) * (t-t4_) * (t-t4_)
-       - signD_ * 0.25 * d_max_/(dT4_ * dT4_)
-           * (t-t4_) * (t-t4_) * (t-t4_) * (t-t4_)
-       + v_max_ * (t-t4_) + x4_;
-
-    vt = signD_ * 0.50 * d_max_/(dT4_ * dT4_ * dT4_)
-          * (t-t4_) * (t-t4_) * (t-t4_) * (t-t4_)
-       - signD_ * d_max_/(dT4_ * dT4_)
-          * (t-t4_) * (t-t4_) * (t-t4_) + v_max_;
-
-    at = signD_ * 2.0 * d_max_/(dT4_ * dT4_ * dT4_)
-          * (t-t4_) * (t-t4_) * (t-t4_)
-       - signD_ * 3.0 * d_max_/(dT4_ * dT4_)
-          * (t-t4_) * (t-t4_);
+    g_trapezoid5251525_step<Mask>( TRAPZD_ROUND_IN, t-t4_, -signD_ * d_max_, dT4_,
+                                   v_max_, x4_, xt, vt, at );
 
-  } else if ( t5_ <= t && t < t6_) {
-    // Step6
-    xt = signD_ * (-0.5) * d_max_ * (t-t5_) * (t-t5_) + v5_ * (t-t5_) + x5_;
-
-    vt = signD_ * (-d_max_) * (t-t5_) + v5_;
-
-    at = signD_ * (-d_max_);
+  } else if ( ( t5_ <= t && t < t6_ )
+              || ( dT4_ <= 0.0 && t5_ <= t && t <= t7_+T_EPSILON ) ) {
+    // Step6 (丸め率0ではStep7の区間長が0となるため, 終端もStep6の式で出力)
+    g_trapezoid5251525_step<Mask>( TRAPZD_CONSTANT, t-t5_, -signD_ * d_max_, dT4_,
+                                   v5_, x5_, xt, vt, at );
 
   } else if ( t6_ <= t && t <= t7_+T_EPSILON) {
     // Step7
-    xt = signD_ * (-0.1) * d_max_/(dT4_ * dT4_ * dT4_)
-          * (t-t6_) * (t-t6_) * (t-t6_) * (t-t6_) * (t-t6_)
-       + signD_ * 0.25 * d_max_/(dT4_ * dT4_)
-          * (t-t6_) * (t-t6_) * (t-t6_) * (t-t6_)
-       - signD_ * 0.50 * d_max_ * (t-t6_) * (t-t6_)
-       + v6_ * (t-t6_) + x6_;
-
-    vt = signD_ *  (-0.5) * d_max_/(dT4_ * dT4_ * dT4_)
-          * (t-t6_) * (t-t6_) * (t-t6_) * (t-t6_)
-       + signD_ * d_max_/(dT4_ * dT4_)
-          * (t-t6_) * (t-t6_) * (t-t6_)
-       - signD_ * d_max_ * (t-t6_) + v6_;
-
-    at = signD_ *  (-2.0) * d_max_/(dT4_ * dT4_ * dT4_)
-          * (t-t6_) * (t-t6_) * (t-t6_)
-       + signD_ *  (-3.0) * d_max_/(dT4_ * dT4_)
-          * (t-t6_) * (t-t6_)
-       - signD_ * d_max_;
+    g_trapezoid5251525_step<Mask>( TRAPZD_ROUND_OUT, t-t6_, -signD_ * d_max_, dT4_,
+                                   v6_, x6_, xt, vt, at );
 
   } else {
     std::stringstream ss1;
@@ -1049,6 +401,18 @@ const int Trapezoid5251525::pop(const double& t, double& xt, double& vt, double&
   return 0;
 }
 
+template const int Trapezoid5251525::pop<OUTPUT_POS>(const double&, double&, double&, double&) const;
+template const int Trapezoid5251525::pop<OUTPUT_VEL>(const double&, double&, double&, double&) const;
+template const int Trapezoid5251525::pop<OUTPUT_POS_VEL>(const double&, double&, double&, double&) const;
+template const int Trapezoid5251525::pop<OUTPUT_ACC>(const double&, double&, double&, double&) const;
+template const int Trapezoid5251525::pop<OUTPUT_POS|OUTPUT_ACC>(const double&, double&, double&, double&) const;
+template const int Trapezoid5251525::pop<OUTPUT_VEL|OUTPUT_ACC>(const double&, double&, double&, double&) const;
+template const int Trapezoid5251525::pop<OUTPUT_PVA>(const double&, double&, double&, double&) const;
+
+const int Trapezoid5251525::pop(const double& t, double& xt, double& vt, double& at) const {
+  return this->pop<OUTPUT_PVA>( t, xt, vt, at );
+}
+
 
 const double Trapezoid5251525::finish_time() {
   return t7_;
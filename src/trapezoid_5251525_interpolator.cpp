@@ -1,47 +1,202 @@
 #include "trapezoid_5251525_interpolator.hpp"
+#include "spline_thread_pool.hpp"
 
 using namespace interp;
 
+namespace interp {
+
+/// 区間軌道の並列計画タスク
+/// @details 各区間は自身の区間軌道と計画状態のみ書き込むため, 分割の仕方によらず同じ結果となる.
+class TrapezoidSegmentTask : public RangeTask {
+public:
+  /// コンストラクタ
+  /// @param[in] interpolator 計画対象の補間器
+  explicit TrapezoidSegmentTask( const TrapezoidalInterpolator& interpolator ) :
+    interpolator_(interpolator) {
+  }
+
+  /// 区間 [begin, end) の区間軌道を計画
+  /// @param[in] begin 先頭の区間軌道のインデックス
+  /// @param[in] end   末尾の次の区間軌道のインデックス
+  virtual void run( const std::size_t& begin, const std::size_t& end ) {
+    for( std::size_t idx=begin; idx < end; idx++ ) {
+      RetCode status = SPLINE_SUCCESS;
+      try {
+        status = interpolator_.generate_segment( idx );
+      } catch( const std::exception& e ) {
+        // ワーカースレッドからは例外を送出できないため計画失敗として記録
+        status = SPLINE_FAIL_TO_GENERATE_PATH;
+      }
+      interpolator_.segment_status_que_[idx] = status;
+    }
+  }
+
+private:
+  /// 計画対象の補間器
+  const TrapezoidalInterpolator& interpolator_;
+};
+
+} // End of namespace interp
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void TrapezoidalInterpolator::create_trapzd_trajectory_que()
 {
-  for( std::deque<TrapezoidConfig>::iterator trapzd_config_itr = trapzd_config_que_.begin();
-       trapzd_config_itr != trapzd_config_que_.end();
-       trapzd_config_itr++ )
+  // 再初期化時は確保済みの区間軌道を上書きし, 余った分のみ削除する
+  const std::size_t trajectory_num = trapzd_config_que_.size();
+  if( trapzd_trajectory_que_.size() > trajectory_num ) {
+    trapzd_trajectory_que_.erase( trapzd_trajectory_que_.begin() + trajectory_num,
+                                  trapzd_trajectory_que_.end() );
+  }
+  for( std::size_t i=0; i < trajectory_num; i++ )
   {
-    Trapezoid5251525 trapzd( trapzd_config_itr->a_limit,
-                             trapzd_config_itr->d_limit,
-                             trapzd_config_itr->v_limit,
-                             trapzd_config_itr->asr,
-                             trapzd_config_itr->dsr,
-                             trapzd_config_itr->ratio_acc_dec );
+    const TrapezoidConfig& trapzd_config = trapzd_config_que_[i];
+    Trapezoid5251525 trapzd( trapzd_config.a_limit,
+                             trapzd_config.d_limit,
+                             trapzd_config.v_limit,
+                             trapzd_config.asr,
+                             trapzd_config.dsr,
+                             trapzd_config.ratio_acc_dec );
     //
-    trapzd_trajectory_que_.push_back( trapzd );
+    if( i < trapzd_trajectory_que_.size() ) {
+      trapzd_trajectory_que_[i] = trapzd;
+    } else {
+      trapzd_trajectory_que_.push_back( trapzd );
+    }
   } // End of for i=0 -> trapzd_config_que_.size()
+  //
+  reset_segment_status( SPLINE_SEGMENT_NOT_GENERATED );
+}
+
+
+void TrapezoidalInterpolator::reset_segment_status( const RetCode& status )
+{
+  segment_status_que_.assign( trapzd_trajectory_que_.size(), status );
+  is_segment_failed_    = false;
+  failed_segment_index_ = 0;
+}
+
+
+RetCode TrapezoidalInterpolator::generate_segment( const std::size_t& index ) const
+{
+  const TimePVA& target_start = target_tpva_queue_.at( index );
+  const TimePVA& target_goal  = target_tpva_queue_.at( index+1 );
+  //
+  Trapezoid5251525& ref_trapzd = trapzd_trajectory_que_[index];
+  const double dT_total =
+                 ref_trapzd.generate_path( target_start.time,  target_goal.time,
+                                           target_start.P.pos, target_goal.P.pos,
+                                           target_start.P.vel, target_goal.P.vel );
+  if( dT_total < 0.0 )
+  {
+    // 移動なしフラグが立っていればスルー、そうでなければエラー
+    if( !ref_trapzd.no_movement() )
+    {
+      return SPLINE_FAIL_TO_GENERATE_PATH;
+    }
+  }
+  return SPLINE_SUCCESS;
+}
+
+
+RetCode TrapezoidalInterpolator::ensure_segment( const std::size_t& index ) const
+{
+  if( index >= segment_status_que_.size() ) {
+    return SPLINE_INVALID_INPUT_INDEX;
+  }
+  if( segment_status_que_[index] != SPLINE_SEGMENT_NOT_GENERATED ) {
+    // 計画済み or 計画失敗済み
+    return segment_status_que_[index];
+  }
+
+  RetCode status = SPLINE_SUCCESS;
+  try {
+    status = generate_segment( index );
+  } catch( const std::exception& e ) {
+    // 到達不可能等の入力エラーは計画失敗として記録
+    status = SPLINE_FAIL_TO_GENERATE_PATH;
+  }
+  segment_status_que_[index] = status;
+  //
+  if( status != SPLINE_SUCCESS
+      && ( !is_segment_failed_ || index < failed_segment_index_ ) )
+  {
+    is_segment_failed_    = true;
+    failed_segment_index_ = index;
+  }
+  return status;
+}
+
+
+RetCode TrapezoidalInterpolator::ensure_segments( const std::size_t& index ) const
+{
+  const std::size_t segment_size = segment_status_que_.size();
+  if( !is_lazy_ ) {
+    // 一括生成モードでは generate_path() でのみ計画し, ここでは計画状態を返す
+    if( index < segment_size && segment_status_que_[index] == SPLINE_SUCCESS ) {
+      return SPLINE_SUCCESS;
+    }
+    return SPLINE_FAIL_TO_GENERATE_PATH;
+  }
+  std::size_t end_index = index + 1 + lookahead_;
+  if( end_index > segment_size ) {
+    end_index = segment_size;
+  }
+
+  RetCode retcode = SPLINE_SUCCESS;
+  for( std::size_t idx=index; idx < end_index; idx++ ) {
+    if( ensure_segment( idx ) != SPLINE_SUCCESS ) {
+      retcode = SPLINE_FAIL_TO_GENERATE_PATH;
+    }
+  }
+  return retcode;
 }
 
 
 TrapezoidalInterpolator::TrapezoidalInterpolator () :
-  SplineInterpolator() {
+  SplineInterpolator(),
+  is_segment_failed_   ( false ),
+  failed_segment_index_( 0     ),
+  is_lazy_             ( false ),
+  lookahead_           ( 0     ) {
   is_v_limit_ = true;
 }
 
 
 TrapezoidalInterpolator::TrapezoidalInterpolator(
                            const TrapezoidalInterpolator& src ) :
-  SplineInterpolator(     src.is_path_generated_,
-                          src.is_v_limit_,
-                          src.v_limit_,
-                          src.target_tpva_queue_     ),
+  SplineInterpolator    ( src                        ),
   trapzd_config_que_    ( src.trapzd_config_que_     ),
-  trapzd_trajectory_que_( src.trapzd_trajectory_que_ ) {
+  trapzd_trajectory_que_( src.trapzd_trajectory_que_ ),
+  segment_status_que_   ( src.segment_status_que_    ),
+  is_segment_failed_    ( src.is_segment_failed_     ),
+  failed_segment_index_ ( src.failed_segment_index_  ),
+  is_lazy_              ( src.is_lazy_               ),
+  lookahead_            ( src.lookahead_             ) {
 }
 
+#ifdef SPLINE_CXX11
+TrapezoidalInterpolator::TrapezoidalInterpolator(
+                           TrapezoidalInterpolator&& src ) SPLINE_NOEXCEPT :
+  SplineInterpolator    ( std::move( src )                        ),
+  trapzd_config_que_    ( std::move( src.trapzd_config_que_     ) ),
+  trapzd_trajectory_que_( std::move( src.trapzd_trajectory_que_ ) ),
+  segment_status_que_   ( std::move( src.segment_status_que_    ) ),
+  is_segment_failed_    ( src.is_segment_failed_                  ),
+  failed_segment_index_ ( src.failed_segment_index_               ),
+  is_lazy_              ( src.is_lazy_                            ),
+  lookahead_            ( src.lookahead_                          ) {
+}
+#endif
+
 TrapezoidalInterpolator::TrapezoidalInterpolator (
                          const TrapezoidConfigQueue& trapzd_config_que ) :
   SplineInterpolator(),
-  trapzd_config_que_( trapzd_config_que ) {
+  trapzd_config_que_   ( trapzd_config_que ),
+  is_segment_failed_   ( false ),
+  failed_segment_index_( 0     ),
+  is_lazy_             ( false ),
+  lookahead_           ( 0     ) {
   is_v_limit_ = true;
 
   create_trapzd_trajectory_que();
@@ -54,7 +209,11 @@ TrapezoidalInterpolator::TrapezoidalInterpolator (
                          const double& asr,
                          const double& dsr,
                          const double& ratio_acc_dec) :
-  SplineInterpolator() {
+  SplineInterpolator(),
+  is_segment_failed_   ( false ),
+  failed_segment_index_( 0     ),
+  is_lazy_             ( false ),
+  lookahead_           ( 0     ) {
   is_v_limit_ = true;
   initialize( a_limit,
               d_limit,
@@ -70,22 +229,37 @@ TrapezoidalInterpolator::~TrapezoidalInterpolator() {
 
 TrapezoidalInterpolator& TrapezoidalInterpolator::operator=(
                            const TrapezoidalInterpolator& src ) {
-  TrapezoidalInterpolator dest(src);
-  is_path_generated_     = dest.is_path_generated_;
-  is_v_limit_            = dest.is_v_limit_;
-  v_limit_               = dest.v_limit_;
-  target_tpva_queue_     = dest.target_tpva_queue_;
-  trapzd_config_que_     = dest.trapzd_config_que_;
-  trapzd_trajectory_que_ = dest.trapzd_trajectory_que_;
+  // コンテナの代入は自己代入に対応し、確保済みのメモリを再利用する
+  SplineInterpolator::operator=( src );
+  trapzd_config_que_     = src.trapzd_config_que_;
+  trapzd_trajectory_que_ = src.trapzd_trajectory_que_;
+  segment_status_que_    = src.segment_status_que_;
+  is_segment_failed_     = src.is_segment_failed_;
+  failed_segment_index_  = src.failed_segment_index_;
+  is_lazy_               = src.is_lazy_;
+  lookahead_             = src.lookahead_;
   return *this;
 }
 
+#ifdef SPLINE_CXX11
+TrapezoidalInterpolator& TrapezoidalInterpolator::operator=(
+                           TrapezoidalInterpolator&& src ) SPLINE_NOEXCEPT {
+  SplineInterpolator::operator=( std::move( src ) );
+  trapzd_config_que_     = std::move( src.trapzd_config_que_ );
+  trapzd_trajectory_que_ = std::move( src.trapzd_trajectory_que_ );
+  segment_status_que_    = std::move( src.segment_status_que_ );
+  is_segment_failed_     = src.is_segment_failed_;
+  failed_segment_index_  = src.failed_segment_index_;
+  is_lazy_               = src.is_lazy_;
+  lookahead_             = src.lookahead_;
+  return *this;
+}
+#endif
+
 
 void TrapezoidalInterpolator::initialize(
                               const TrapezoidConfigQueue& trapzd_config_que ) {
-  trapzd_config_que_.clear();
   trapzd_config_que_ = trapzd_config_que;
-  trapzd_trajectory_que_.clear();
   create_trapzd_trajectory_que();
   //
   is_path_generated_ = false; // reset
@@ -106,7 +280,6 @@ void TrapezoidalInterpolator::initialize(
                                  asr,  dsr,
                                  ratio_acc_dec );
   trapzd_config_que_.push_back( trapzd_config );
-  trapzd_trajectory_que_.clear();
   create_trapzd_trajectory_que();
   //
   is_path_generated_ = false; // reset
@@ -128,112 +301,86 @@ RetCode TrapezoidalInterpolator::generate_path (
     return SPLINE_INVALID_QUEUE_SIZE;
   }
 
-  TPQueue target_TimePosition_queue = target_tp_queue;
-  TimePosition target_tp;
-  NonUniformRoundingSpline nurs;
-
-  // 開始点を予め挿入しておく
-  target_tp = target_TimePosition_queue.pop();
-  nurs.push( target_tp.time,
-             target_tp.value );
-  //
-  // 教示点キューをクリア
-  target_tpva_queue_.clear();
-  //
-  TimePVA target_start( target_tp.time,
-                        PosVelAcc( target_tp.value, vs, as ) );
-  target_tpva_queue_.push( target_start );
-  TimePVA target_goal;
-  bool endflag = false;
-  for( std::size_t trajectory_idx=0;
-       (trajectory_idx < trapzd_trajectory_que_.size())
-         && (endflag == false)
-         && (target_TimePosition_queue.size() > 0);
-       trajectory_idx++ ) {
-
-    target_tp = target_TimePosition_queue.pop();
-    // 目標時刻・位置から時刻・位置・速度の点を生成(3点分貯める)
-    nurs.push( target_tp.time,
-               target_tp.value );
-
-    if( target_tp_queue_size == 2 ) {
-      // 教示点キューの数が2個しかない場合はループしない
-      target_goal.time  = target_tp.time;
-      target_goal.P.pos = target_tp.value;
-      target_goal.P.vel = vf;
-      target_goal.P.acc = af;
-      endflag = true;
-    }
-    else if ( nurs.size() >= 3 ){
-      target_goal = nurs.pop();
-    }
-    else {
-      // nursが３点未満の場合、丸み不均一スプラインの速度計算未実施のため
-      // まだ軌道生成できるような(目標速度をもった)目標点(target_goal)はpopできないためcontinue
-      trajectory_idx--; // 軌道を生成するまでカウントしない
-      continue;
-    }
-    // popしたことでnurs.size()==2
-    //
-    target_tpva_queue_.push( target_goal );
-    //
-    Trapezoid5251525& ref_trapzd = trapzd_trajectory_que_.at( trajectory_idx );
-    double dT_total = ref_trapzd.generate_path( target_start.time,  target_goal.time,
-                                                target_start.P.pos, target_goal.P.pos,
-                                                target_start.P.vel, target_goal.P.vel );
-    if( dT_total < 0.0 )
-    {
-      // 移動なしフラグが立っていればスルー、そうでなければエラー
-      if( !ref_trapzd.no_movement() )
-      {
-        return SPLINE_FAIL_TO_GENERATE_PATH;
-      }
-    }
-    //
-    target_start = target_goal;
-
-  } // End of for trajectory_idx=0 -> trapzd_trajectory_que_.size()
-  //
-  is_path_generated_ = true;
-  //
-  return SPLINE_SUCCESS;
+  // 目標時刻・位置から丸み不均一スプラインで全点の速度を一括計算.
+  // 作業領域はアリーナから確保し, 結果は target_tpva_queue_ に直接書き込む(コピーしない).
+  // 計算失敗時は target_tpva_queue_ は変更されない.
+  RetCode retcode = NonUniformRoundingSpline::compute_tpva_queue( target_tp_queue,
+                                                                  target_tpva_queue_,
+                                                                  vs, vf,
+                                                                  thread_pool_,
+                                                                  arena_ );
+  if( retcode != SPLINE_SUCCESS ) {
+    return retcode;
+  }
+  // 開始＆終端の加速度
+  TimePVA target_start = target_tpva_queue_.front();
+  target_start.P.acc = as;
+  target_tpva_queue_.set( 0, target_start );
+  TimePVA target_goal = target_tpva_queue_.back();
+  target_goal.P.acc = af;
+  target_tpva_queue_.set( target_tp_queue_size-1, target_goal );
+
+  return generate_path_from_target();
 }
 
 
 RetCode TrapezoidalInterpolator::generate_path(
                                  const TPVAQueue& target_tpva_queue ) {
+  if( trapzd_trajectory_que_.size() == 0 ) {
+    return SPLINE_UNINITIALIZED_INTERPOLATOR;
+  }
 
   if( (target_tpva_queue.size()-1) != trapzd_trajectory_que_.size() )
   {
     return SPLINE_INVALID_QUEUE_SIZE;
   }
-  TPVAQueue target_TimePVA_queue = target_tpva_queue;
-  target_tpva_queue_             = target_tpva_queue;
+  target_tpva_queue_ = target_tpva_queue;
+
+  return generate_path_from_target();
+}
 
-  TimePVA target_start = target_TimePVA_queue.pop();
-  TimePVA target_goal;
+
+RetCode TrapezoidalInterpolator::generate_path_from_target() {
+  // 計画失敗(例外を含む)時に前回の軌道を再生しないよう, 計画前に未生成とする
+  is_path_generated_ = false;
+  reset_segment_status( SPLINE_SEGMENT_NOT_GENERATED );
+
+  if( is_lazy_ ) {
+    // 遅延生成モード : 先頭から先読み区間数分のみ計画し, 残りは pop()/prefetch() で計画.
+    // 計画失敗は segment_status() / generation_status() で通知する.
+    is_path_generated_ = true;
+    ensure_segments( 0 );
+    return SPLINE_SUCCESS;
+  }
+
+  if( thread_pool_ != NULL ) {
+    // 各区間軌道は独立しているため並列に計画
+    TrapezoidSegmentTask task( *this );
+    for_each_segment( 0, trapzd_trajectory_que_.size(), task );
+    for( std::size_t trajectory_idx=0;
+         trajectory_idx < segment_status_que_.size();
+         trajectory_idx++ ) {
+      if( segment_status_que_[trajectory_idx] != SPLINE_SUCCESS ) {
+        is_segment_failed_    = true;
+        failed_segment_index_ = trajectory_idx;
+        return SPLINE_FAIL_TO_GENERATE_PATH;
+      }
+    }
+    is_path_generated_ = true;
+    return SPLINE_SUCCESS;
+  }
 
   for( std::size_t trajectory_idx=0;
-       (trajectory_idx < trapzd_trajectory_que_.size())
-         && (target_TimePVA_queue.size() > 0);
+       trajectory_idx < trapzd_trajectory_que_.size();
        trajectory_idx++ ) {
-    target_goal = target_TimePVA_queue.pop();
-    //
-    Trapezoid5251525& ref_trapzd = trapzd_trajectory_que_.at( trajectory_idx );
-    const double dT_total =
-                   ref_trapzd.generate_path( target_start.time,  target_goal.time,
-                                             target_start.P.pos, target_goal.P.pos,
-                                             target_start.P.vel, target_goal.P.vel );
-    if( dT_total < 0.0 )
+    const RetCode retcode = generate_segment( trajectory_idx );
+    segment_status_que_[trajectory_idx] = retcode;
+    if( retcode != SPLINE_SUCCESS )
     {
-      // 移動なしフラグが立っていればスルー、そうでなければエラー
-      if( !ref_trapzd.no_movement() )
-      {
-        return SPLINE_FAIL_TO_GENERATE_PATH;
-      }
+      is_segment_failed_    = true;
+      failed_segment_index_ = trajectory_idx;
+      return retcode;
     }
-    //
-    target_start = target_goal;
   }
   //
   is_path_generated_ = true;
@@ -267,12 +414,20 @@ RetCode TrapezoidalInterpolator::generate_path_from_pva(
   target_tpva_queue_.push( 0.0,      xs, vs, as );
   target_tpva_queue_.push( dT_total, xf, vf, af );
   //
+  reset_segment_status( SPLINE_SEGMENT_NOT_GENERATED );
+  segment_status_que_[0] = SPLINE_SUCCESS;
   is_path_generated_ = true;
   //
   return SPLINE_SUCCESS;
 }
 
 
+const TimePVA TrapezoidalInterpolator::pop( const double& t ) const {
+  return this->pop<OUTPUT_PVA>( t );
+}
+
+
+template<unsigned int Mask>
 const TimePVA TrapezoidalInterpolator::pop( const double& t ) const {
 
   if( !is_path_generated_ ) {
@@ -293,7 +448,9 @@ const TimePVA TrapezoidalInterpolator::pop( const double& t ) const {
 
   std::size_t trajectory_idx = 0;
 
-  RetCode retcode = this->index_of_time( t, trajectory_idx );
+  // 時間スケールを適用した経路上の時刻
+  const double tp = path_time( t );
+  RetCode retcode = this->index_of_time( tp, trajectory_idx );
 
   if( retcode != SPLINE_SUCCESS )
   {
@@ -303,23 +460,52 @@ const TimePVA TrapezoidalInterpolator::pop( const double& t ) const {
     ss1 << "time value = "
         << t
         << " is out of range of generated path between time of start index[0] t0(="
-        << target_tpva_queue_.get( 0 ).time
+        << start_time()
         << ") and time of finish index["
         << finish_index
         << "] tf(="
-        << target_tpva_queue_.get( finish_index ).time
+        << finish_time()
         << ").";
     std::cerr << ss1.str() << std::endl;
     THROW( TimeOutOfRange, ss1.str() );
   }
 
-  double xt, vt, at;
-  trapzd_trajectory_que_[trajectory_idx].pop( t, xt, vt, at );
+  // 終端時刻は最終区間軌道の終端として出力
+  const std::size_t last_trajectory_idx = target_tpva_queue_size - 2;
+  if( trajectory_idx > last_trajectory_idx ) {
+    trajectory_idx = last_trajectory_idx;
+  }
+
+  // 遅延生成モードで未計画ならば先読み区間分まで含めて計画
+  if( ensure_segments( trajectory_idx ) != SPLINE_SUCCESS
+      && segment_status_que_[trajectory_idx] != SPLINE_SUCCESS ) {
+    std::stringstream ss2;
+    ss2 << "pop data does not exist -- failed to generate the trajectory index["
+        << trajectory_idx << "] of time value = "
+        << std::fixed << std::setprecision(15) << t << ".";
+    std::cerr << ss2.str() << std::endl;
+    THROW( NotSplineGenerated, ss2.str() );
+  }
+
+  double xt = 0.0, vt = 0.0, at = 0.0;
+  trapzd_trajectory_que_[trajectory_idx].pop<Mask>( tp, xt, vt, at );
+  if( is_time_scaled_ ) {
+    vt *= time_scale_;
+    at *= time_scale_ * time_scale_;
+  }
   const TimePVA dest_tpva( t, PosVelAcc( xt, vt, at ) );
 
   return dest_tpva;
 }
 
+template const TimePVA TrapezoidalInterpolator::pop<OUTPUT_POS>( const double& t ) const;
+template const TimePVA TrapezoidalInterpolator::pop<OUTPUT_VEL>( const double& t ) const;
+template const TimePVA TrapezoidalInterpolator::pop<OUTPUT_POS_VEL>( const double& t ) const;
+template const TimePVA TrapezoidalInterpolator::pop<OUTPUT_ACC>( const double& t ) const;
+template const TimePVA TrapezoidalInterpolator::pop<OUTPUT_POS|OUTPUT_ACC>( const double& t ) const;
+template const TimePVA TrapezoidalInterpolator::pop<OUTPUT_VEL|OUTPUT_ACC>( const double& t ) const;
+template const TimePVA TrapezoidalInterpolator::pop<OUTPUT_PVA>( const double& t ) const;
+
 
 RetCode TrapezoidalInterpolator::clear() {
 
@@ -327,6 +513,8 @@ RetCode TrapezoidalInterpolator::clear() {
 
   trapzd_trajectory_que_.clear();
 
+  reset_segment_status( SPLINE_SEGMENT_NOT_GENERATED );
+
   return SplineInterpolator::clear();
 }
 
@@ -334,3 +522,54 @@ const std::size_t TrapezoidalInterpolator::trapzd_trajectory_que_size() const {
   return trapzd_trajectory_que_.size();
 }
 
+
+
+void TrapezoidalInterpolator::set_lazy_generation( const bool& enable,
+                                                   const std::size_t& lookahead ) {
+  is_lazy_   = enable;
+  lookahead_ = lookahead;
+}
+
+const bool TrapezoidalInterpolator::lazy_generation() const {
+  return is_lazy_;
+}
+
+const std::size_t TrapezoidalInterpolator::lookahead() const {
+  return lookahead_;
+}
+
+
+RetCode TrapezoidalInterpolator::prefetch( const double& t ) const {
+  if( !is_path_generated_ || target_tpva_queue_.size() < 2 ) {
+    return SPLINE_UNINITIALIZED_INTERPOLATOR;
+  }
+
+  // pop() と同じく時間スケールを適用した経路上の時刻で区間を探す
+  std::size_t trajectory_idx = 0;
+  if( this->index_of_time( path_time( t ), trajectory_idx ) != SPLINE_SUCCESS ) {
+    return SPLINE_INVALID_INPUT_TIME;
+  }
+  const std::size_t last_trajectory_idx = target_tpva_queue_.size() - 2;
+  if( trajectory_idx > last_trajectory_idx ) {
+    trajectory_idx = last_trajectory_idx;
+  }
+
+  return ensure_segments( trajectory_idx );
+}
+
+
+RetCode TrapezoidalInterpolator::segment_status( const std::size_t& index ) const {
+  if( index >= segment_status_que_.size() ) {
+    return SPLINE_INVALID_INPUT_INDEX;
+  }
+  return segment_status_que_[index];
+}
+
+
+RetCode TrapezoidalInterpolator::generation_status( std::size_t& failed_index ) const {
+  if( !is_segment_failed_ ) {
+    return SPLINE_SUCCESS;
+  }
+  failed_index = failed_segment_index_;
+  return SPLINE_FAIL_TO_GENERATE_PATH;
+}
@@ -0,0 +1,422 @@
+#include "waypoint_loader.hpp"
+
+#include <cstdio>
+#include <cstdlib> // for strtod
+#include <clocale> // for localeconv
+#include <cstring>
+#include <sstream>
+
+using namespace interp;
+
+const std::size_t WaypointLoader::NO_COLUMN = (std::size_t)-1;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// exactly representable powers of ten
+const double EXACT_POW10[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/// the maximum integer exactly representable by double (2^53)
+const unsigned long long EXACT_MANTISSA_MAX = 9007199254740992ULL;
+
+/// check the character is the field separator
+/// @param[in] c character
+/// @return true if ',', ' ' or '\t'
+inline bool is_separator( const char& c ) {
+  return c == ',' || c == ' ' || c == '\t';
+}
+
+/// parse the number by strtod (for the numbers out of the fast path)
+/// @param[in]  begin the first address of the field
+/// @param[in]  end   the address next to the last of the field
+/// @param[out] value parsed value
+/// @return true if the whole field is the number
+bool parse_number_strtod( const char* begin, const char* end, double& value ) {
+  // strtod depends on the decimal point of the locale
+  std::string field( begin, end );
+  const char locale_point = std::localeconv()->decimal_point[0];
+  if( locale_point != '.' ) {
+    for( std::size_t i=0; i < field.size(); i++ ) {
+      if( field[i] == '.' ) { field[i] = locale_point; }
+    }
+  }
+  char* parsed_end = NULL;
+  value = std::strtod( field.c_str(), &parsed_end );
+  return !field.empty() && parsed_end == field.c_str() + field.size();
+}
+
+/// parse the number without locale
+/// @param[in]  begin the first address of the field
+/// @param[in]  end   the address next to the last of the field
+/// @param[out] value parsed value
+/// @return true if the whole field is the number
+/// @details
+/// If the digits are less than 2^53 and the exponent is within +-22,
+/// the value is calculated exactly by one multiplication or division (correctly rounded).
+/// Otherwise the field is parsed by strtod.
+bool parse_number( const char* begin, const char* end, double& value ) {
+  const char* p = begin;
+  bool is_negative = false;
+  if( p < end && ( *p == '+' || *p == '-' ) ) {
+    is_negative = ( *p == '-' );
+    p++;
+  }
+  unsigned long long mantissa = 0;
+  int exponent = 0;
+  int digit_num = 0;
+  bool is_exact = true;
+  for( ; p < end && '0' <= *p && *p <= '9'; p++, digit_num++ ) {
+    if( mantissa < EXACT_MANTISSA_MAX / 10 ) {
+      mantissa = mantissa * 10 + ( *p - '0' );
+    } else {
+      is_exact = false;
+    }
+  }
+  if( p < end && *p == '.' ) {
+    p++;
+    for( ; p < end && '0' <= *p && *p <= '9'; p++, digit_num++ ) {
+      if( mantissa < EXACT_MANTISSA_MAX / 10 ) {
+        mantissa = mantissa * 10 + ( *p - '0' );
+        exponent--;
+      } else if( *p != '0' ) {
+        is_exact = false;
+      }
+    }
+  }
+  if( digit_num == 0 ) {
+    // "inf", "nan", etc.
+    return parse_number_strtod( begin, end, value );
+  }
+  if( p < end && ( *p == 'e' || *p == 'E' ) ) {
+    p++;
+    bool is_negative_exponent = false;
+    if( p < end && ( *p == '+' || *p == '-' ) ) {
+      is_negative_exponent = ( *p == '-' );
+      p++;
+    }
+    if( p == end || *p < '0' || '9' < *p ) {
+      return false;
+    }
+    int exponent_value = 0;
+    for( ; p < end && '0' <= *p && *p <= '9'; p++ ) {
+      if( exponent_value < 100000 ) {
+        exponent_value = exponent_value * 10 + ( *p - '0' );
+      }
+    }
+    exponent += is_negative_exponent ? -exponent_value : exponent_value;
+  }
+  if( p != end ) {
+    return false;
+  }
+  if( !is_exact || exponent < -22 || 22 < exponent ) {
+    return parse_number_strtod( begin, end, value );
+  }
+  value = (double)mantissa;
+  if( exponent < 0 ) {
+    value /= EXACT_POW10[-exponent];
+  } else {
+    value *= EXACT_POW10[exponent];
+  }
+  if( is_negative ) {
+    value = -value;
+  }
+  return true;
+}
+
+} // End of namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+WaypointLoader::WaypointLoader() :
+  column_size_(0), error_line_(0) {
+}
+
+
+WaypointLoader::~WaypointLoader() {
+}
+
+
+RetCode WaypointLoader::load_file( const std::string& path ) {
+  clear_table();
+  set_error( 0, "" );
+
+  FILE* fp = std::fopen( path.c_str(), "rb" );
+  if( fp == NULL ) {
+    set_error( 0, "cannot open the file: " + path );
+    return SPLINE_FILE_IO_ERROR;
+  }
+  // read the whole file at once
+  std::vector<char> buffer;
+  bool is_ok = ( std::fseek( fp, 0, SEEK_END ) == 0 );
+  const long file_size = is_ok ? std::ftell( fp ) : -1;
+  is_ok = is_ok && file_size >= 0 && std::fseek( fp, 0, SEEK_SET ) == 0;
+  if( is_ok && file_size > 0 ) {
+    buffer.resize( file_size );
+    is_ok = ( std::fread( &buffer[0], 1, buffer.size(), fp ) == buffer.size() );
+  }
+  std::fclose( fp );
+  if( !is_ok ) {
+    set_error( 0, "cannot read the file: " + path );
+    return SPLINE_FILE_IO_ERROR;
+  }
+  if( buffer.empty() ) {
+    return SPLINE_SUCCESS;
+  }
+  return parse( &buffer[0], &buffer[0] + buffer.size() );
+}
+
+
+RetCode WaypointLoader::load_string( const std::string& text ) {
+  clear_table();
+  set_error( 0, "" );
+  if( text.empty() ) {
+    return SPLINE_SUCCESS;
+  }
+  return parse( text.data(), text.data() + text.size() );
+}
+
+
+void WaypointLoader::clear_table() {
+  values_.clear();
+  row_lines_.clear();
+  column_size_ = 0;
+}
+
+
+RetCode WaypointLoader::parse( const char* begin, const char* end ) {
+  std::size_t line = 0;
+  const char* line_begin = begin;
+  while( line_begin < end ) {
+    line++;
+    const char* line_end = static_cast<const char*>(
+      std::memchr( line_begin, '\n', end - line_begin ) );
+    if( line_end == NULL ) {
+      line_end = end;
+    }
+    const char* next_line = ( line_end < end ) ? line_end + 1 : end;
+    if( line_end > line_begin && *( line_end - 1 ) == '\r' ) {
+      line_end--;
+    }
+
+    // skip leading spaces, empty lines & comment lines
+    const char* p = line_begin;
+    while( p < line_end && ( *p == ' ' || *p == '\t' ) ) {
+      p++;
+    }
+    line_begin = next_line;
+    if( p == line_end || *p == '#' ) {
+      continue;
+    }
+
+    std::size_t column_num = 0;
+    while( true ) {
+      const char* field_begin = p;
+      while( p < line_end && !is_separator( *p ) ) {
+        p++;
+      }
+      double value;
+      if( !parse_number( field_begin, p, value ) ) {
+        std::stringstream ss;
+        ss << "invalid number \"" << std::string( field_begin, p )
+           << "\" at column " << column_num + 1;
+        set_error( line, ss.str() );
+        clear_table();
+        return SPLINE_INVALID_FILE_FORMAT;
+      }
+      values_.push_back( value );
+      column_num++;
+
+      // one ',' (with spaces around it) or spaces separate fields
+      while( p < line_end && ( *p == ' ' || *p == '\t' ) ) {
+        p++;
+      }
+      if( p < line_end && *p == ',' ) {
+        p++;
+        while( p < line_end && ( *p == ' ' || *p == '\t' ) ) {
+          p++;
+        }
+      } else if( p == line_end ) {
+        break;
+      }
+    }
+
+    if( row_lines_.empty() ) {
+      column_size_ = column_num;
+    } else if( column_num != column_size_ ) {
+      std::stringstream ss;
+      ss << "the number of columns is " << column_num
+         << ", but the one of previous rows is " << column_size_;
+      set_error( line, ss.str() );
+      clear_table();
+      return SPLINE_INVALID_FILE_FORMAT;
+    }
+    row_lines_.push_back( line );
+  }
+  return SPLINE_SUCCESS;
+}
+
+
+const std::size_t WaypointLoader::row_size() const {
+  return row_lines_.size();
+}
+
+
+const std::size_t WaypointLoader::column_size() const {
+  return column_size_;
+}
+
+
+const double WaypointLoader::value( const std::size_t& row,
+                                    const std::size_t& column ) const
+  SPLINE_THROW_SPEC(InvalidIndexAccess) {
+  if( row >= row_size() || column >= column_size_ ) {
+    std::stringstream err_ss;
+    err_ss << "index is invalid. the size of table : " << row_size() << " x " << column_size_
+           << ", but input index : (" << row << ", " << column << ")";
+    THROW( InvalidIndexAccess, err_ss.str() );
+  }
+  return values_[ row * column_size_ + column ];
+}
+
+
+RetCode WaypointLoader::column( const std::size_t& column,
+                                std::vector<double>& values ) const {
+  if( column >= column_size_ ) {
+    return SPLINE_INVALID_INPUT_INDEX;
+  }
+  values.resize( row_size() );
+  for( std::size_t i=0; i < values.size(); i++ ) {
+    values[i] = values_[ i * column_size_ + column ];
+  }
+  return SPLINE_SUCCESS;
+}
+
+
+const std::size_t WaypointLoader::line_of_row( const std::size_t& row ) const
+  SPLINE_THROW_SPEC(InvalidIndexAccess) {
+  if( row >= row_size() ) {
+    std::stringstream err_ss;
+    err_ss << "row is invalid. the number of rows : " << row_size()
+           << ", but input row : " << row;
+    THROW( InvalidIndexAccess, err_ss.str() );
+  }
+  return row_lines_[row];
+}
+
+
+RetCode WaypointLoader::to_tp_queue( const std::size_t& time_column,
+                                     const std::size_t& position_column,
+                                     TPQueue&           queue ) {
+  std::vector<double> times;
+  RetCode ret = prepare( time_column,
+                         std::vector<std::size_t>( 1, position_column ), times );
+  if( ret != SPLINE_SUCCESS ) {
+    return ret;
+  }
+  std::vector<double> positions;
+  column( position_column, positions );
+  return report_time_error( queue.assign( times, positions ), times );
+}
+
+
+RetCode WaypointLoader::to_tpva_queue( const std::size_t& time_column,
+                                       const std::size_t& position_column,
+                                       TPVAQueue&         queue,
+                                       const std::size_t& velocity_column,
+                                       const std::size_t& acceleration_column ) {
+  std::vector<std::size_t> columns;
+  columns.push_back( position_column );
+  columns.push_back( velocity_column );
+  columns.push_back( acceleration_column );
+  std::vector<double> times;
+  RetCode ret = prepare( time_column, columns, times );
+  if( ret != SPLINE_SUCCESS ) {
+    return ret;
+  }
+  std::vector<PosVelAcc> pvas( row_size() );
+  for( std::size_t i=0; i < pvas.size(); i++ ) {
+    const double* row = &values_[ i * column_size_ ];
+    pvas[i].pos = row[position_column];
+    pvas[i].vel = ( velocity_column     == NO_COLUMN ) ? 0.0 : row[velocity_column];
+    pvas[i].acc = ( acceleration_column == NO_COLUMN ) ? 0.0 : row[acceleration_column];
+  }
+  return report_time_error( queue.assign( times, pvas ), times );
+}
+
+
+RetCode WaypointLoader::to_tpva_list_queue( const std::size_t&              time_column,
+                                            const std::vector<std::size_t>& position_columns,
+                                            TPVAListQueue&                  queue ) {
+  std::vector<double> times;
+  RetCode ret = prepare( time_column, position_columns, times );
+  if( ret != SPLINE_SUCCESS ) {
+    return ret;
+  }
+  std::vector<PVAList> pva_lists( row_size() );
+  for( std::size_t i=0; i < pva_lists.size(); i++ ) {
+    const double* row = &values_[ i * column_size_ ];
+    pva_lists[i].resize( position_columns.size() );
+    for( std::size_t k=0; k < position_columns.size(); k++ ) {
+      pva_lists[i][k].pos = ( position_columns[k] == NO_COLUMN ) ? 0.0 : row[position_columns[k]];
+    }
+  }
+  return report_time_error( queue.assign( times, pva_lists ), times );
+}
+
+
+RetCode WaypointLoader::prepare( const std::size_t&              time_column,
+                                 const std::vector<std::size_t>& columns,
+                                 std::vector<double>&            times ) {
+  set_error( 0, "" );
+  if( time_column >= column_size_ ) {
+    set_error( 0, "time column is out of range" );
+    return SPLINE_INVALID_INPUT_INDEX;
+  }
+  for( std::size_t k=0; k < columns.size(); k++ ) {
+    if( columns[k] != NO_COLUMN && columns[k] >= column_size_ ) {
+      set_error( 0, "value column is out of range" );
+      return SPLINE_INVALID_INPUT_INDEX;
+    }
+  }
+  column( time_column, times );
+  return SPLINE_SUCCESS;
+}
+
+
+RetCode WaypointLoader::report_time_error( const RetCode& ret,
+                                           const std::vector<double>& times ) {
+  if( ret != SPLINE_INVALID_INPUT_TIME ) {
+    return ret;
+  }
+  // the queue validated the times, so search the row only on error
+  for( std::size_t i=1; i < times.size(); i++ ) {
+    if( times[i] <= times[i-1] ) {
+      std::stringstream ss;
+      ss << "time " << times[i] << " is not greater than the one of previous row "
+         << times[i-1];
+      set_error( row_lines_[i], ss.str() );
+      break;
+    }
+  }
+  return ret;
+}
+
+
+const std::size_t WaypointLoader::error_line() const {
+  return error_line_;
+}
+
+
+const std::string& WaypointLoader::error_message() const {
+  return error_message_;
+}
+
+
+void WaypointLoader::set_error( const std::size_t& line, const std::string& message ) {
+  error_line_    = line;
+  error_message_ = message;
+}
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include "cubic_spline_interpolator.hpp"
 #include "test/util/test_graph_plot.hpp"
+#include "test/util/test_trajectories.hpp"
+
+#include <math.h>
+#include <algorithm> // for find
 
 
 namespace interp {
@@ -64,6 +68,14 @@ protected:
     //
     return cubic_spline_.tridiagonal_matrix_eq_solver( d, u, l, p, out_solved_x );
   }
+
+  const RetCode m_uniform_index_of_time( const double& t, std::size_t& output_index ) {
+    return cubic_spline_.uniform_index_of_time( t, output_index );
+  }
+
+  const TimePVA m_knot( const std::size_t& index ) {
+    return cubic_spline_.target_tpva_queue_.get( index );
+  }
 };
 
 } // end of namespace interp
@@ -253,3 +265,435 @@ TEST_F( CubicSplineTest, index_of_time ) {
   EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, tg.index_of_time(7.1, index) );
   EXPECT_EQ( 100, index );
 }
+
+
+TEST( CubicSplineInterpolatorTest, copy_and_move ) {
+  TPQueue tp_queue;
+  tp_queue.push_on_clocktime( 0.0, -1.0 );
+  tp_queue.push_on_clocktime( 1.0, 2.0 );
+  tp_queue.push_on_clocktime( 2.5, 0.5 );
+  tp_queue.push_on_clocktime( 3.0, 4.0 );
+  CubicSplineInterpolator planner;
+  ASSERT_EQ( SPLINE_SUCCESS, planner.generate_path( tp_queue ) );
+
+  CubicSplineInterpolator copied( planner );
+  CubicSplineInterpolator assigned;
+  assigned = planner;
+  assigned = assigned; // self copy
+  for( double t=0.0; t <= 3.0; t+=0.25 ) {
+    EXPECT_EQ( planner.pop( t ).P.pos, copied.pop( t ).P.pos );
+    EXPECT_EQ( planner.pop( t ).P.vel, assigned.pop( t ).P.vel );
+  }
+
+#ifdef SPLINE_CXX11
+  EXPECT_TRUE( std::is_nothrow_move_constructible<CubicSplineInterpolator>::value );
+  EXPECT_TRUE( std::is_nothrow_move_assignable<CubicSplineInterpolator>::value );
+  // hand the generated path over to the player without copy
+  CubicSplineInterpolator player( std::move( planner ) );
+  EXPECT_THROW( planner.start_time(), NotSplineGenerated );
+  EXPECT_EQ( 0u, planner.target_tpva_queue_size() );
+  for( double t=0.0; t <= 3.0; t+=0.25 ) {
+    EXPECT_EQ( copied.pop( t ).P.pos, player.pop( t ).P.pos );
+  }
+  planner = std::move( player );
+  EXPECT_EQ( 3.0, planner.finish_time() );
+  EXPECT_THROW( player.pop( 1.0 ), NotSplineGenerated );
+#endif
+}
+
+
+TEST( CubicSplineInterpolatorTest, workspace ) {
+  const TPQueue tp_queue = make_sine_tp_queue( 201, 0.5 );
+  TPQueue short_tp_queue;
+  for( std::size_t i=0; i <= 50; i++ ) {
+    short_tp_queue.push_on_clocktime( 0.5 * i, 5.0 * cos( 0.3 * i ) );
+  }
+  CubicSplineInterpolator expected;
+  ASSERT_EQ( SPLINE_SUCCESS, expected.generate_path( tp_queue, 1.0, -1.0 ) );
+
+  CubicSplineWorkspace workspace( 201 );
+  EXPECT_LE( 201u, workspace.capacity() );
+  CubicSplineInterpolator planner;
+  EXPECT_TRUE( planner.workspace() == NULL );
+  planner.set_workspace( &workspace );
+  EXPECT_EQ( &workspace, planner.workspace() );
+  const std::size_t capacity = workspace.capacity();
+
+  // re-planning of the same or smaller size keeps the capacity
+  ASSERT_EQ( SPLINE_SUCCESS, planner.generate_path( short_tp_queue ) );
+  ASSERT_EQ( SPLINE_SUCCESS, planner.generate_path( tp_queue, 1.0, -1.0 ) );
+  EXPECT_EQ( capacity, workspace.capacity() );
+  EXPECT_EQ( tp_queue.size(), planner.target_tpva_queue_size() );
+  EXPECT_EQ( expected.finish_time(), planner.finish_time() );
+  for( double t=0.0; t <= 100.0; t+=0.13 ) {
+    const TimePVA expected_tpva = expected.pop( t );
+    const TimePVA actual_tpva   = planner.pop( t );
+    ASSERT_EQ( expected_tpva.P.pos, actual_tpva.P.pos );
+    ASSERT_EQ( expected_tpva.P.vel, actual_tpva.P.vel );
+    ASSERT_EQ( expected_tpva.P.acc, actual_tpva.P.acc );
+  }
+
+  // shorter path after longer one
+  ASSERT_EQ( SPLINE_SUCCESS, planner.generate_path( short_tp_queue ) );
+  EXPECT_EQ( short_tp_queue.size(), planner.target_tpva_queue_size() );
+  EXPECT_EQ( 25.0, planner.finish_time() );
+  EXPECT_THROW( planner.pop( 25.1 ), TimeOutOfRange );
+
+  // back to the temporary buffers
+  planner.set_workspace( NULL );
+  EXPECT_TRUE( planner.workspace() == NULL );
+  ASSERT_EQ( SPLINE_SUCCESS, planner.generate_path( tp_queue, 1.0, -1.0 ) );
+  EXPECT_EQ( expected.pop( 42.0 ).P.pos, planner.pop( 42.0 ).P.pos );
+  workspace.release();
+  EXPECT_EQ( 0u, workspace.capacity() );
+}
+
+
+TEST( CubicSplineInterpolatorTest, uniform_knot ) {
+  // 1 kHz sensor data
+  TPQueue tp_queue;
+  for( std::size_t i=0; i <= 5000; i++ ) {
+    tp_queue.push_on_clocktime( 100.0 + 0.001 * i, 10.0 * sin( 0.01 * i ) );
+  }
+  CubicSplineInterpolator generic;
+  generic.set_uniform_knot_detection( false );
+  ASSERT_EQ( SPLINE_SUCCESS, generic.generate_path( tp_queue, 1.0, -1.0 ) );
+  EXPECT_FALSE( generic.is_uniform_knot() );
+
+  CubicSplineInterpolator uniform;
+  EXPECT_FALSE( uniform.is_uniform_knot() );
+  ASSERT_EQ( SPLINE_SUCCESS, uniform.generate_path( tp_queue, 1.0, -1.0 ) );
+  EXPECT_TRUE( uniform.is_uniform_knot() );
+
+  for( double t=100.0; t <= 105.0; t+=0.000731 ) {
+    const TimePVA expected = generic.pop( t );
+    const TimePVA actual   = uniform.pop( t );
+    ASSERT_NEAR( expected.P.pos, actual.P.pos, 1.0e-9 );
+    ASSERT_NEAR( expected.P.vel, actual.P.vel, 1.0e-6 );
+    ASSERT_NEAR( expected.P.acc, actual.P.acc, 1.0e-3 );
+  }
+  // passes through the knots
+  for( std::size_t i=0; i <= 5000; i++ ) {
+    EXPECT_NEAR( tp_queue.get( i ).value, uniform.pop( tp_queue.get( i ).time ).P.pos, 1.0e-12 );
+  }
+  EXPECT_EQ( 1.0, uniform.pop( 100.0 ).P.vel );
+  EXPECT_EQ( -1.0, uniform.pop( 105.0 ).P.vel );
+  EXPECT_THROW( uniform.pop( 99.9999 ), TimeOutOfRange );
+  EXPECT_THROW( uniform.pop( 105.0001 ), TimeOutOfRange );
+
+  // the lookup of TPVAQueue
+  TPVAQueue tpva_queue;
+  for( std::size_t i=0; i <= 100; i++ ) {
+    tpva_queue.push_on_clocktime( 0.1 * i, PosVelAcc( sin( 0.1 * i ), cos( 0.1 * i ), 0.0 ) );
+  }
+  ASSERT_EQ( SPLINE_SUCCESS, uniform.generate_path( tpva_queue ) );
+  EXPECT_TRUE( uniform.is_uniform_knot() );
+  generic.set_uniform_knot_detection( false );
+  ASSERT_EQ( SPLINE_SUCCESS, generic.generate_path( tpva_queue ) );
+  for( double t=0.0; t <= 10.0; t+=0.01 ) {
+    // bitwise equal since the coefficients are the same
+    ASSERT_EQ( generic.pop( t ).P.pos, uniform.pop( t ).P.pos );
+  }
+
+  // non-uniform interval
+  TPQueue nonuniform_tp_queue;
+  for( std::size_t i=0; i <= 10; i++ ) {
+    nonuniform_tp_queue.push_on_clocktime( 0.1 * i + 0.001 * i * i, (double)i );
+  }
+  ASSERT_EQ( SPLINE_SUCCESS, uniform.generate_path( nonuniform_tp_queue ) );
+  EXPECT_FALSE( uniform.is_uniform_knot() );
+  uniform.clear();
+  EXPECT_FALSE( uniform.is_uniform_knot() );
+
+  // the factorization cached by the interpolator is reused and extended across plans
+  const std::size_t point_nums[] = { 20, 8, 30 };
+  for( std::size_t k=0; k < 3; k++ ) {
+    TPQueue uniform_tp_queue;
+    for( std::size_t i=0; i < point_nums[k]; i++ ) {
+      uniform_tp_queue.push_on_clocktime( 0.1 * i, sin( 0.3 * i ) );
+    }
+    CubicSplineInterpolator fresh;
+    ASSERT_EQ( SPLINE_SUCCESS, fresh.generate_path( uniform_tp_queue ) );
+    ASSERT_EQ( SPLINE_SUCCESS, uniform.generate_path( uniform_tp_queue ) );
+    ASSERT_TRUE( uniform.is_uniform_knot() );
+    for( double t=0.0; t <= uniform.finish_time(); t+=0.03 ) {
+      ASSERT_EQ( fresh.pop( t ).P.pos, uniform.pop( t ).P.pos ) << "points = " << point_nums[k];
+    }
+  }
+}
+
+
+TEST_F( CubicSplineTest, uniform_index_of_time ) {
+  TPQueue tp_queue;
+  for( std::size_t i=0; i <= 3000; i++ ) {
+    tp_queue.push_on_clocktime( 10.0 + 0.001 * i, cos( 0.01 * i ) );
+  }
+  ASSERT_EQ( SPLINE_SUCCESS, cubic_spline_.generate_path( tp_queue ) );
+  ASSERT_TRUE( cubic_spline_.is_uniform_knot() );
+  // the same index as the binary search on, before and after the knots
+  for( std::size_t i=0; i <= 3000; i++ ) {
+    const double knot = tp_queue.get( i ).time;
+    const double times[3] = { knot, nextafter( knot, 0.0 ), nextafter( knot, 20.0 ) };
+    for( std::size_t j=0; j < 3; j++ ) {
+      std::size_t expected = 0;
+      std::size_t actual   = 0;
+      const RetCode retcode = cubic_spline_.index_of_time( times[j], expected );
+      ASSERT_EQ( retcode, m_uniform_index_of_time( times[j], actual ) );
+      if( retcode == SPLINE_SUCCESS ) {
+        ASSERT_EQ( expected, actual );
+      }
+    }
+  }
+}
+
+
+TEST( CubicSplineInterpolatorTest, hermite_from_tpva_queue ) {
+  // non-zero velocities at the knots and non-uniform interval times
+  TPVAQueue tpva_queue;
+  for( std::size_t i=0; i < 8; i++ ) {
+    tpva_queue.push_on_clocktime( 0.4 * i + 0.05 * i * i,
+                                  PosVelAcc( 5.0 * sin( 0.8 * i ), 3.0 * cos( 1.1 * i ), 0.0 ) );
+  }
+  CubicSplineInterpolator spline;
+  ASSERT_EQ( SPLINE_SUCCESS, spline.generate_path( tpva_queue ) );
+
+  for( std::size_t i=0; i + 1 < tpva_queue.size(); i++ ) {
+    const TimePVA& tpva0 = tpva_queue.get( i );
+    const TimePVA& tpva1 = tpva_queue.get( i+1 );
+    const double dT = tpva1.time - tpva0.time;
+    const double dp = tpva1.value.pos - tpva0.value.pos;
+    // the knot itself
+    const TimePVA knot = spline.pop( tpva0.time );
+    EXPECT_NEAR( tpva0.value.pos, knot.P.pos, 1.0e-12 );
+    EXPECT_NEAR( tpva0.value.vel, knot.P.vel, 1.0e-12 );
+    // x''(0) of the Hermite cubic through (p0, v0) and (p1, v1)
+    const double expected_acc = 6.0 * dp / ( dT * dT )
+                                - 2.0 * ( tpva1.value.vel + 2.0 * tpva0.value.vel ) / dT;
+    EXPECT_NEAR( expected_acc, knot.P.acc, 1.0e-9 );
+    // the segment reaches the next knot
+    const TimePVA end = spline.pop( tpva1.time - 1.0e-9 );
+    EXPECT_NEAR( tpva1.value.pos, end.P.pos, 1.0e-6 );
+    EXPECT_NEAR( tpva1.value.vel, end.P.vel, 1.0e-6 );
+  }
+}
+
+
+TEST( CubicSplineInterpolatorTest, peak_and_check_limit ) {
+  CubicSplineInterpolator spline;
+  double max_abs_vel = 0.0, max_abs_acc = 0.0;
+  EXPECT_EQ( SPLINE_UNINITIALIZED_INTERPOLATOR, spline.segment_peak( 0, max_abs_vel, max_abs_acc ) );
+  EXPECT_EQ( SPLINE_UNINITIALIZED_INTERPOLATOR, spline.path_peak( max_abs_vel, max_abs_acc ) );
+  EXPECT_EQ( SPLINE_UNINITIALIZED_INTERPOLATOR, spline.check_limit() );
+
+  TPQueue tp_queue;
+  for( std::size_t i=0; i < 12; i++ ) {
+    tp_queue.push_on_clocktime( 0.5 * i + 0.02 * i * i, 10.0 * sin( 0.9 * i ) );
+  }
+  ASSERT_EQ( SPLINE_SUCCESS, spline.generate_path( tp_queue ) );
+
+  // the same peaks as the dense sampling
+  double sampled_vel = 0.0, sampled_acc = 0.0;
+  for( double t=spline.start_time(); t <= spline.finish_time(); t+=1.0e-4 ) {
+    const TimePVA tpva = spline.pop( t );
+    sampled_vel = std::max( sampled_vel, fabs( tpva.P.vel ) );
+    sampled_acc = std::max( sampled_acc, fabs( tpva.P.acc ) );
+  }
+  ASSERT_EQ( SPLINE_SUCCESS, spline.path_peak( max_abs_vel, max_abs_acc ) );
+  EXPECT_GE( max_abs_vel, sampled_vel );
+  EXPECT_NEAR( sampled_vel, max_abs_vel, 1.0e-6 );
+  EXPECT_GE( max_abs_acc, sampled_acc );
+  EXPECT_NEAR( sampled_acc, max_abs_acc, 1.0e-2 );
+
+  double segment_vel = 0.0, segment_acc = 0.0;
+  EXPECT_EQ( SPLINE_SUCCESS, spline.segment_peak( 10, segment_vel, segment_acc ) );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_INDEX, spline.segment_peak( 11, segment_vel, segment_acc ) );
+
+  // no limit
+  EXPECT_EQ( SPLINE_SUCCESS, spline.check_limit() );
+  EXPECT_THROW( spline.v_limit(), NoVelocityLimit );
+  EXPECT_EQ( 0.0, spline.a_limit() );
+
+  spline.set_limit( 0.5 * max_abs_vel );
+  EXPECT_EQ( 0.5 * max_abs_vel, spline.v_limit() );
+  std::vector<std::size_t> violated_indexes;
+  EXPECT_EQ( SPLINE_LIMIT_EXCEEDED, spline.check_limit( &violated_indexes ) );
+  EXPECT_LT( 0u, violated_indexes.size() );
+  for( std::size_t i=0; i < 11; i++ ) {
+    spline.segment_peak( i, segment_vel, segment_acc );
+    const bool is_violated =
+      std::find( violated_indexes.begin(), violated_indexes.end(), i ) != violated_indexes.end();
+    EXPECT_EQ( segment_vel > 0.5 * max_abs_vel, is_violated );
+  }
+
+  spline.set_limit( 2.0 * max_abs_vel, 0.5 * max_abs_acc );
+  EXPECT_EQ( SPLINE_LIMIT_EXCEEDED, spline.check_limit() );
+  spline.set_limit( 0.0, 2.0 * max_abs_acc );
+  EXPECT_EQ( SPLINE_SUCCESS, spline.check_limit() );
+}
+
+
+TEST_F( CubicSplineTest, retime ) {
+  TPQueue tp_queue;
+  for( std::size_t i=0; i < 12; i++ ) {
+    // a spike at the point 6 on a slow slope
+    tp_queue.push_on_clocktime( 0.5 * i, 0.1 * i + ( ( i == 6 ) ? 8.0 : 0.0 ) );
+  }
+  EXPECT_EQ( SPLINE_UNINITIALIZED_INTERPOLATOR, cubic_spline_.retime() );
+  ASSERT_EQ( SPLINE_SUCCESS, cubic_spline_.generate_path( tp_queue, 0.5, -0.5 ) );
+  double max_abs_vel = 0.0, max_abs_acc = 0.0;
+  ASSERT_EQ( SPLINE_SUCCESS, cubic_spline_.path_peak( max_abs_vel, max_abs_acc ) );
+  const double v_limit = 0.7 * max_abs_vel;
+  const double a_limit = 0.7 * max_abs_acc;
+  std::vector<double> vel_peaks( 11 ), acc_peaks( 11 );
+  for( std::size_t i=0; i < 11; i++ ) {
+    cubic_spline_.segment_peak( i, vel_peaks[i], acc_peaks[i] );
+  }
+
+  // nothing to do within the limits
+  ASSERT_EQ( SPLINE_SUCCESS, cubic_spline_.retime() );
+  EXPECT_EQ( tp_queue.get( 11 ).time, cubic_spline_.finish_time() );
+
+  cubic_spline_.set_limit( v_limit, a_limit );
+  ASSERT_EQ( SPLINE_LIMIT_EXCEEDED, cubic_spline_.check_limit() );
+  ASSERT_EQ( SPLINE_SUCCESS, cubic_spline_.retime() );
+  EXPECT_EQ( SPLINE_SUCCESS, cubic_spline_.check_limit() );
+  ASSERT_EQ( SPLINE_SUCCESS, cubic_spline_.path_peak( max_abs_vel, max_abs_acc ) );
+  EXPECT_GE( v_limit, max_abs_vel );
+  EXPECT_GE( a_limit, max_abs_acc );
+
+  // the same positions, start time and end velocities
+  EXPECT_EQ( tp_queue.get( 0 ).time, cubic_spline_.start_time() );
+  EXPECT_LT( tp_queue.get( 11 ).time, cubic_spline_.finish_time() );
+  EXPECT_DOUBLE_EQ( 0.5, cubic_spline_.pop( cubic_spline_.start_time() ).P.vel );
+  EXPECT_DOUBLE_EQ( -0.5, cubic_spline_.pop( cubic_spline_.finish_time() ).P.vel );
+  // the segments far from the limits are not stretched
+  std::size_t kept_num = 0;
+  for( std::size_t i=0; i < 11; i++ ) {
+    EXPECT_DOUBLE_EQ( tp_queue.get( i ).value, m_knot( i ).value.pos );
+    const double dT = m_knot( i+1 ).time - m_knot( i ).time;
+    EXPECT_LE( 0.5 - 1.0e-12, dT );
+    if( vel_peaks[i] < 0.5 * v_limit && acc_peaks[i] < 0.5 * a_limit ) {
+      EXPECT_NEAR( 0.5, dT, 1.0e-12 );
+      kept_num++;
+    }
+  }
+  EXPECT_LT( 0u, kept_num );
+
+  // the finish velocity over the limit
+  ASSERT_EQ( SPLINE_SUCCESS, cubic_spline_.generate_path( tp_queue, 0.0, 2.0 * v_limit ) );
+  EXPECT_EQ( SPLINE_LIMIT_EXCEEDED, cubic_spline_.retime() );
+}
+
+
+TEST( CubicSplineInterpolatorTest, time_scale ) {
+  CubicSplineInterpolator spline;
+  EXPECT_EQ( SPLINE_UNINITIALIZED_INTERPOLATOR, spline.set_time_scale( 2.0 ) );
+  EXPECT_EQ( SPLINE_UNINITIALIZED_INTERPOLATOR, spline.set_time_scale( 2.0, 1.0 ) );
+
+  TPQueue tp_queue;
+  for( std::size_t i=0; i < 12; i++ ) {
+    tp_queue.push_on_clocktime( 1.0 + 0.5 * i + 0.02 * i * i, 10.0 * sin( 0.9 * i ) );
+  }
+  ASSERT_EQ( SPLINE_SUCCESS, spline.generate_path( tp_queue ) );
+  const CubicSplineInterpolator original( spline );
+  const double t0 = original.start_time();
+  const double tf = original.finish_time();
+
+  EXPECT_EQ( SPLINE_INVALID_ARGUMENT_VALUE_ZERO, spline.set_time_scale( 0.0 ) );
+  EXPECT_EQ( SPLINE_INVALID_ARGUMENT_VALUE_ZERO, spline.set_time_scale( -1.0 ) );
+  EXPECT_EQ( 1.0, spline.time_scale() );
+
+  // double speed from the start
+  const double scale = 2.0;
+  ASSERT_EQ( SPLINE_SUCCESS, spline.set_time_scale( scale ) );
+  EXPECT_EQ( scale, spline.time_scale() );
+  EXPECT_EQ( t0, spline.start_time() );
+  EXPECT_NEAR( t0 + ( tf - t0 ) / scale, spline.finish_time(), 1.0e-12 );
+  EXPECT_NEAR( ( tf - t0 ) / scale, spline.total_dT(), 1.0e-12 );
+  // index_of_time() takes the path time, not the input time of pop()
+  std::size_t index = 0;
+  EXPECT_EQ( SPLINE_SUCCESS, spline.index_of_time( tf, index ) );
+  EXPECT_EQ( SPLINE_SUCCESS, spline.index_of_time( spline.path_time( spline.finish_time() ), index ) );
+  EXPECT_EQ( tp_queue.size() - 1, index );
+  for( double t=spline.start_time(); t <= spline.finish_time(); t+=0.01 ) {
+    const TimePVA expected = original.pop( t0 + scale * ( t - t0 ) );
+    const TimePVA actual   = spline.pop( t );
+    ASSERT_EQ( t, actual.time );
+    ASSERT_NEAR( expected.P.pos, actual.P.pos, 1.0e-9 );
+    ASSERT_NEAR( scale * expected.P.vel, actual.P.vel, 1.0e-9 );
+    ASSERT_NEAR( scale * scale * expected.P.acc, actual.P.acc, 1.0e-9 );
+  }
+  EXPECT_NO_THROW( spline.pop( spline.finish_time() ) );
+  EXPECT_NEAR( original.pop( tf ).P.pos, spline.pop( spline.finish_time() ).P.pos, 1.0e-12 );
+  EXPECT_THROW( spline.pop( spline.finish_time() + 0.01 ), TimeOutOfRange );
+
+  // half speed from the anchor keeps the position continuous
+  const double anchor = t0 + 1.0;
+  const TimePVA before = spline.pop( anchor );
+  ASSERT_EQ( SPLINE_SUCCESS, spline.set_time_scale( 0.5, anchor ) );
+  const TimePVA after = spline.pop( anchor );
+  EXPECT_NEAR( before.P.pos, after.P.pos, 1.0e-12 );
+  EXPECT_NEAR( 0.25 * before.P.vel, after.P.vel, 1.0e-9 );
+  EXPECT_NEAR( t0 + scale * 1.0, spline.path_time( anchor ), 1.0e-12 );
+  EXPECT_NEAR( anchor + ( tf - ( t0 + scale * 1.0 ) ) / 0.5, spline.finish_time(), 1.0e-9 );
+  EXPECT_NO_THROW( spline.pop( spline.finish_time() ) );
+
+  // clear() resets the time scale
+  ASSERT_EQ( SPLINE_SUCCESS, spline.clear() );
+  EXPECT_EQ( 1.0, spline.time_scale() );
+  ASSERT_EQ( SPLINE_SUCCESS, spline.generate_path( tp_queue ) );
+  EXPECT_EQ( tf, spline.finish_time() );
+  EXPECT_EQ( original.pop( 2.0 ).P.pos, spline.pop( 2.0 ).P.pos );
+}
+
+
+TEST( CubicSplineInterpolatorTest, time_scale_and_limit ) {
+  TPQueue tp_queue;
+  for( std::size_t i=0; i < 12; i++ ) {
+    tp_queue.push_on_clocktime( 0.5 * i + 0.02 * i * i, 10.0 * sin( 0.9 * i ) );
+  }
+  CubicSplineInterpolator spline;
+  ASSERT_EQ( SPLINE_SUCCESS, spline.generate_path( tp_queue ) );
+  double vel_peak = 0.0, acc_peak = 0.0;
+  ASSERT_EQ( SPLINE_SUCCESS, spline.path_peak( vel_peak, acc_peak ) );
+
+  // the peaks of pop() at double speed
+  const double scale = 2.0;
+  ASSERT_EQ( SPLINE_SUCCESS, spline.set_time_scale( scale ) );
+  double max_abs_vel = 0.0, max_abs_acc = 0.0;
+  ASSERT_EQ( SPLINE_SUCCESS, spline.path_peak( max_abs_vel, max_abs_acc ) );
+  EXPECT_NEAR( scale * vel_peak, max_abs_vel, 1.0e-12 );
+  EXPECT_NEAR( scale * scale * acc_peak, max_abs_acc, 1.0e-9 );
+  double segment_vel = 0.0, segment_acc = 0.0, sampled_vel = 0.0, sampled_acc = 0.0;
+  for( std::size_t i=0; i < 11; i++ ) {
+    ASSERT_EQ( SPLINE_SUCCESS, spline.segment_peak( i, segment_vel, segment_acc ) );
+    sampled_vel = std::max( sampled_vel, segment_vel );
+    sampled_acc = std::max( sampled_acc, segment_acc );
+  }
+  EXPECT_EQ( max_abs_vel, sampled_vel );
+  EXPECT_EQ( max_abs_acc, sampled_acc );
+
+  // within the limits as generated, over the limits at double speed
+  const double v_limit = 1.2 * vel_peak;
+  const double a_limit = 1.2 * acc_peak;
+  spline.set_limit( v_limit, a_limit );
+  EXPECT_EQ( SPLINE_LIMIT_EXCEEDED, spline.check_limit() );
+
+  // retime keeps the scale and meets the limits in the outputs of pop()
+  ASSERT_EQ( SPLINE_SUCCESS, spline.retime() );
+  EXPECT_EQ( scale, spline.time_scale() );
+  EXPECT_EQ( SPLINE_SUCCESS, spline.check_limit() );
+  sampled_vel = 0.0;
+  sampled_acc = 0.0;
+  for( double t=spline.start_time(); t <= spline.finish_time(); t+=1.0e-4 ) {
+    const TimePVA tpva = spline.pop( t );
+    sampled_vel = std::max( sampled_vel, fabs( tpva.P.vel ) );
+    sampled_acc = std::max( sampled_acc, fabs( tpva.P.acc ) );
+  }
+  EXPECT_GE( v_limit, sampled_vel );
+  EXPECT_GE( a_limit, sampled_acc );
+
+  // the start velocity over the limit at the scale
+  ASSERT_EQ( SPLINE_SUCCESS, spline.generate_path( tp_queue, 0.8 * v_limit, 0.0 ) );
+  EXPECT_EQ( SPLINE_LIMIT_EXCEEDED, spline.retime() );
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "cubic_spline_kernel.hpp"
+#include "cubic_spline_interpolator.hpp"
+#include "test/util/test_trajectories.hpp"
+
+using namespace interp;
+
+/// the number of sampled times to compare paths
+#define KERNEL_SAMPLE_NUM 1000
+
+
+TEST(CubicSplineKernelTest, same_as_interpolator_from_tp ) {
+  // non-uniform interval
+  const TPQueue tp_queue = make_sine_tp_queue( 20, 0.5, 0.01 );
+  std::vector<double> times;
+  std::vector<double> positions;
+  split_tp_queue( tp_queue, times, positions );
+  CubicSplineInterpolator interpolator;
+  ASSERT_EQ( SPLINE_SUCCESS, interpolator.generate_path( tp_queue, 1.0, -2.0 ) );
+  CubicSpline spline;
+  ASSERT_EQ( SPLINE_SUCCESS, spline.generate_path( times, positions, 1.0, -2.0 ) );
+  EXPECT_EQ( times.front(), spline.start_time() );
+  EXPECT_EQ( times.back(),  spline.finish_time() );
+
+  const double tf = times.back();
+  std::vector<double> pos( KERNEL_SAMPLE_NUM + 1 );
+  std::vector<double> vel( KERNEL_SAMPLE_NUM + 1 );
+  std::vector<double> acc( KERNEL_SAMPLE_NUM + 1 );
+  spline.sample( 0.0, tf / KERNEL_SAMPLE_NUM, pos.size(), &pos[0], &vel[0], &acc[0] );
+  for( std::size_t i=0; i <= KERNEL_SAMPLE_NUM; i++ ) {
+    const double t = tf / KERNEL_SAMPLE_NUM * i;
+    const TimePVA expected = interpolator.pop( t );
+    const TimePVA actual   = spline.pop( t );
+    // bitwise equal
+    EXPECT_EQ( expected.P.pos, actual.P.pos );
+    EXPECT_EQ( expected.P.vel, actual.P.vel );
+    EXPECT_EQ( expected.P.acc, actual.P.acc );
+    EXPECT_EQ( actual.P.pos, pos[i] );
+    EXPECT_EQ( actual.P.vel, vel[i] );
+    EXPECT_EQ( actual.P.acc, acc[i] );
+  }
+}
+
+
+TEST(CubicSplineKernelTest, same_as_interpolator_from_tpva ) {
+  const TPVAQueue tpva_queue = make_sine_tpva_queue( 20, 0.3, true );
+  CubicSplineInterpolator interpolator;
+  ASSERT_EQ( SPLINE_SUCCESS, interpolator.generate_path( tpva_queue ) );
+  CubicSpline spline;
+  ASSERT_EQ( SPLINE_SUCCESS, spline.generate_path( tpva_queue ) );
+
+  const double tf = spline.finish_time();
+  for( std::size_t i=0; i <= KERNEL_SAMPLE_NUM; i++ ) {
+    const double t = tf / KERNEL_SAMPLE_NUM * i;
+    const TimePVA expected = interpolator.pop( t );
+    const TimePVA actual   = spline.pop( t );
+    EXPECT_EQ( expected.P.pos, actual.P.pos );
+    EXPECT_EQ( expected.P.vel, actual.P.vel );
+    EXPECT_EQ( expected.P.acc, actual.P.acc );
+  }
+}
+
+
+TEST(CubicSplineKernelTest, float_close_to_double ) {
+  std::vector<double> times;
+  std::vector<double> positions;
+  std::vector<float>  positions_f;
+  for( std::size_t i=0; i < 50; i++ ) {
+    // large absolute time to check the error does not grow with time
+    times.push_back( 1.0e5 + 0.1 * i );
+    positions.push_back( sine_position( i ) );
+    positions_f.push_back( static_cast<float>( positions.back() ) );
+  }
+  CubicSpline  spline;
+  CubicSplineF spline_f;
+  ASSERT_EQ( SPLINE_SUCCESS, spline.generate_path( times, positions ) );
+  ASSERT_EQ( SPLINE_SUCCESS, spline_f.generate_path( times, positions_f ) );
+
+  const double ts = times.front();
+  const double dT = ( times.back() - ts ) / KERNEL_SAMPLE_NUM;
+  std::vector<float> pos( KERNEL_SAMPLE_NUM + 1 );
+  std::vector<float> vel( KERNEL_SAMPLE_NUM + 1 );
+  std::vector<float> acc( KERNEL_SAMPLE_NUM + 1 );
+  spline_f.sample( ts, dT, pos.size(), &pos[0], &vel[0], &acc[0] );
+  for( std::size_t i=0; i <= KERNEL_SAMPLE_NUM; i++ ) {
+    const double t = ts + dT * i;
+    const TimePVA  expected = spline.pop( t );
+    const TimePVAF actual   = spline_f.pop( t );
+    EXPECT_NEAR( expected.P.pos, actual.P.pos, 1.0e-3 );
+    EXPECT_NEAR( expected.P.vel, actual.P.vel, 1.0e-2 );
+    EXPECT_NEAR( expected.P.acc, actual.P.acc, 1.0e-1 );
+    EXPECT_EQ( actual.P.pos, pos[i] );
+    EXPECT_EQ( actual.P.vel, vel[i] );
+    EXPECT_EQ( actual.P.acc, acc[i] );
+  }
+}
+
+
+TEST(CubicSplineKernelTest, errors ) {
+  CubicSplineF spline;
+  EXPECT_FALSE( spline.is_generated() );
+  EXPECT_THROW( spline.pop( 0.0 ), NotSplineGenerated );
+
+  std::vector<double> times( 2, 0.0 );
+  std::vector<float>  positions( 2, 0.0f );
+  EXPECT_EQ( SPLINE_INVALID_QUEUE_SIZE, spline.generate_path( times, positions ) );
+  times.push_back( 1.0 );
+  EXPECT_EQ( SPLINE_INVALID_QUEUE_SIZE, spline.generate_path( times, positions ) );
+  positions.push_back( 1.0f );
+  times[1] = 1.0;
+  // duplicate and non-monotonic times
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, spline.generate_path( times, positions ) );
+  times[1] = 2.0;
+  times[2] = 1.0;
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, spline.generate_path( times, positions ) );
+  // the interval time is nearly zero in float
+  times[1] = 1.0;
+  times[2] = 1.0 + 1.0e-8;
+  EXPECT_EQ( SPLINE_INVALID_INPUT_INTERVAL_TIME_DT, spline.generate_path( times, positions ) );
+  EXPECT_FALSE( spline.is_generated() );
+
+  times[2] = 2.0;
+  ASSERT_EQ( SPLINE_SUCCESS, spline.generate_path( times, positions ) );
+  EXPECT_EQ( 3u, spline.size() );
+  EXPECT_THROW( spline.pop( -0.1 ), TimeOutOfRange );
+  EXPECT_THROW( spline.pop( 2.1 ),  TimeOutOfRange );
+  float pos[3], vel[3], acc[3];
+  EXPECT_THROW( spline.sample( 0.0, 1.1, 3, pos, vel, acc ), TimeOutOfRange );
+  EXPECT_EQ( 1.0f, spline.pop( 2.0 ).P.pos );
+
+  spline.clear();
+  EXPECT_FALSE( spline.is_generated() );
+}
+
+
+TEST(CubicSplineKernelTest, output_mask ) {
+  // unselected outputs are not written
+  double pos = -1.0, vel = -1.0, acc = -1.0;
+  g_cubic_evaluate_masked<OUTPUT_POS>( 1.0, 2.0, 3.0, 4.0, 0.5, pos, vel, acc );
+  EXPECT_EQ( 1.0 * 0.125 + 2.0 * 0.25 + 3.0 * 0.5 + 4.0, pos );
+  EXPECT_EQ( -1.0, vel );
+  EXPECT_EQ( -1.0, acc );
+  g_cubic_evaluate_masked<OUTPUT_VEL | OUTPUT_ACC>( 1.0, 2.0, 3.0, 4.0, 0.5, pos, vel, acc );
+  EXPECT_EQ( 3.0 * 0.25 + 2.0 * 2.0 * 0.5 + 3.0, vel );
+  EXPECT_EQ( 6.0 * 0.5 + 2.0 * 2.0, acc );
+
+  const TPQueue tp_queue = make_sine_tp_queue( 20, 0.5, 0.01 );
+  std::vector<double> times;
+  std::vector<double> positions;
+  split_tp_queue( tp_queue, times, positions );
+  CubicSplineInterpolator interpolator;
+  ASSERT_EQ( SPLINE_SUCCESS, interpolator.generate_path( tp_queue ) );
+  CubicSpline spline;
+  ASSERT_EQ( SPLINE_SUCCESS, spline.generate_path( times, positions ) );
+
+  // position-only sampling without the arrays of velocity and acceleration
+  const double tf = times.back();
+  std::vector<double> sampled_pos( KERNEL_SAMPLE_NUM + 1 );
+  spline.sample<OUTPUT_POS>( 0.0, tf / KERNEL_SAMPLE_NUM, sampled_pos.size(),
+                             &sampled_pos[0], NULL, NULL );
+  for( std::size_t i=0; i <= KERNEL_SAMPLE_NUM; i++ ) {
+    const double t = tf / KERNEL_SAMPLE_NUM * i;
+    const TimePVA expected = interpolator.pop( t );
+    // bitwise equal to the full evaluation
+    EXPECT_EQ( expected.P.pos, sampled_pos[i] );
+    const TimePVA pos_only = interpolator.pop<OUTPUT_POS>( t );
+    EXPECT_EQ( expected.P.pos, pos_only.P.pos );
+    EXPECT_EQ( 0.0, pos_only.P.vel );
+    EXPECT_EQ( 0.0, pos_only.P.acc );
+    const TimePVA pos_vel = interpolator.pop<OUTPUT_POS_VEL>( t );
+    EXPECT_EQ( expected.P.pos, pos_vel.P.pos );
+    EXPECT_EQ( expected.P.vel, pos_vel.P.vel );
+    EXPECT_EQ( 0.0, pos_vel.P.acc );
+  }
+  EXPECT_THROW( interpolator.pop<OUTPUT_POS>( tf + 0.1 ), TimeOutOfRange );
+}
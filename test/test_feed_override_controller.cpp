@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "feed_override_controller.hpp"
+#include "test/util/test_trajectories.hpp"
+
+#include <math.h>
+
+using namespace interp;
+
+/// interval time of the playback
+#define OVERRIDE_CYCLE 0.001
+
+
+TEST(FeedOverrideControllerTest, constant_override ) {
+  CubicSplineInterpolator interpolator;
+  make_cubic_spline( interpolator, 0, true );
+
+  // the same as pop() without override
+  FeedOverrideController controller;
+  ASSERT_EQ( SPLINE_SUCCESS, controller.start( interpolator ) );
+  TimePVA tpva;
+  while( !controller.is_finished() ) {
+    ASSERT_EQ( SPLINE_SUCCESS, controller.step( OVERRIDE_CYCLE, tpva ) );
+    const TimePVA expected = interpolator.pop( controller.path_time() );
+    if( !controller.is_finished() ) {
+      ASSERT_NEAR( controller.path_time(), tpva.time, 1.0e-9 );
+    }
+    ASSERT_EQ( expected.P.pos, tpva.P.pos );
+    ASSERT_EQ( expected.P.vel, tpva.P.vel );
+    ASSERT_EQ( expected.P.acc, tpva.P.acc );
+  }
+  EXPECT_EQ( interpolator.finish_time(), controller.path_time() );
+
+  // the same as set_time_scale() at a constant ratio
+  CubicSplineInterpolator scaled( interpolator );
+  ASSERT_EQ( SPLINE_SUCCESS, scaled.set_time_scale( 0.5 ) );
+  ASSERT_EQ( SPLINE_SUCCESS, controller.start( interpolator, 0.5 ) );
+  for( std::size_t i=0; i < 1000; i++ ) {
+    ASSERT_EQ( SPLINE_SUCCESS, controller.step( OVERRIDE_CYCLE, tpva ) );
+    const TimePVA expected = scaled.pop( tpva.time );
+    ASSERT_NEAR( expected.P.pos, tpva.P.pos, 1.0e-9 );
+    ASSERT_NEAR( expected.P.vel, tpva.P.vel, 1.0e-9 );
+    ASSERT_NEAR( expected.P.acc, tpva.P.acc, 1.0e-9 );
+  }
+}
+
+
+TEST(FeedOverrideControllerTest, smooth_change ) {
+  CubicSplineInterpolator interpolator;
+  make_cubic_spline( interpolator, 0, true );
+
+  const double max_rate = 2.0, max_rate_change = 10.0;
+  FeedOverrideController controller;
+  ASSERT_EQ( SPLINE_SUCCESS, controller.set_limit( max_rate, max_rate_change ) );
+  ASSERT_EQ( SPLINE_SUCCESS, controller.start( interpolator ) );
+
+  // turn the knob during the motion: 1.0 -> 0.3 -> 1.5 -> hold -> 1.0
+  TimePVA prev;
+  ASSERT_EQ( SPLINE_SUCCESS, controller.step( OVERRIDE_CYCLE, prev ) );
+  double prev_rate = controller.override_rate();
+  double max_vel_jump = 0.0, max_acc_jump = 0.0, max_vel_error = 0.0;
+  std::size_t tick = 1;
+  bool is_held = false;
+  while( !controller.is_finished() ) {
+    const double elapsed = controller.elapsed_time();
+    const double knob = ( elapsed < 0.5 ) ? 1.0
+                      : ( elapsed < 1.0 ) ? 0.3
+                      : ( elapsed < 2.0 ) ? 1.5
+                      : ( elapsed < 4.0 ) ? 0.0 : 1.0;
+    ASSERT_EQ( SPLINE_SUCCESS, controller.set_override( knob ) );
+    TimePVA tpva;
+    ASSERT_EQ( SPLINE_SUCCESS, controller.step( OVERRIDE_CYCLE, tpva ) );
+    ASSERT_LT( tick++, 100000u );
+
+    // the ratio follows the knob within the limits
+    const double rate = controller.override_rate();
+    ASSERT_GE( max_rate + 1.0e-12, fabs( rate ) );
+    ASSERT_GE( max_rate_change * OVERRIDE_CYCLE * ( 1.0 + 1.0e-9 ), fabs( rate - prev_rate ) );
+    ASSERT_LE( 0.0, controller.override_ratio() );
+    prev_rate = rate;
+    if( elapsed > 3.5 && elapsed < 4.0 ) {
+      EXPECT_EQ( 0.0, controller.override_ratio() );
+      EXPECT_EQ( prev.P.pos, tpva.P.pos );
+      is_held = true;
+    }
+
+    // continuous outputs, and the velocity is the derivative of the position
+    // (the finish knot of the cubic spline outputs no acceleration)
+    if( controller.is_finished() ) {
+      prev = tpva;
+      break;
+    }
+    max_vel_jump  = std::max( max_vel_jump, fabs( tpva.P.vel - prev.P.vel ) );
+    max_acc_jump  = std::max( max_acc_jump, fabs( tpva.P.acc - prev.P.acc ) );
+    max_vel_error = std::max( max_vel_error,
+                              fabs( ( tpva.P.pos - prev.P.pos ) / OVERRIDE_CYCLE
+                                    - 0.5 * ( tpva.P.vel + prev.P.vel ) ) );
+    prev = tpva;
+  }
+  EXPECT_TRUE( is_held );
+  EXPECT_GT( 0.2, max_vel_jump );
+  EXPECT_GT( 1.0, max_acc_jump );
+  EXPECT_GT( 0.02, max_vel_error );
+  EXPECT_EQ( interpolator.pop( interpolator.finish_time() ).P.pos, prev.P.pos );
+  EXPECT_EQ( 1.0, controller.override_ratio() );
+  EXPECT_EQ( 0.0, controller.override_rate() );
+}
+
+
+TEST(FeedOverrideControllerTest, trapezoidal ) {
+  TrapezoidalInterpolator interpolator;
+  make_trapezoidal( interpolator );
+
+  // slower override takes longer
+  FeedOverrideController controller;
+  ASSERT_EQ( SPLINE_SUCCESS, controller.start( interpolator ) );
+  ASSERT_EQ( SPLINE_SUCCESS, controller.set_override( 0.5 ) );
+  TimePVA tpva;
+  while( !controller.is_finished() ) {
+    ASSERT_EQ( SPLINE_SUCCESS, controller.step( OVERRIDE_CYCLE, tpva ) );
+    ASSERT_GE( 1.0, controller.override_ratio() );
+  }
+  EXPECT_LT( interpolator.finish_time() / 0.9, controller.elapsed_time() );
+  EXPECT_NEAR( 500.0, tpva.P.pos, 1.0e-9 );
+  EXPECT_NEAR( 0.5, controller.override_ratio(), 1.0e-12 );
+
+  // the state at the finish is kept
+  ASSERT_EQ( SPLINE_SUCCESS, controller.step( OVERRIDE_CYCLE, tpva ) );
+  EXPECT_NEAR( 500.0, tpva.P.pos, 1.0e-9 );
+}
+
+
+TEST(FeedOverrideControllerTest, errors ) {
+  FeedOverrideController controller;
+  TimePVA tpva;
+  EXPECT_EQ( SPLINE_UNINITIALIZED_INTERPOLATOR, controller.step( OVERRIDE_CYCLE, tpva ) );
+  EXPECT_FALSE( controller.is_finished() );
+  EXPECT_EQ( SPLINE_INVALID_ARGUMENT_VALUE_ZERO, controller.set_limit( 0.0, 1.0 ) );
+  EXPECT_EQ( SPLINE_INVALID_ARGUMENT_VALUE_ZERO, controller.set_limit( 1.0, -1.0 ) );
+  EXPECT_EQ( SPLINE_INVALID_ARGUMENT_VALUE_ZERO, controller.set_override( -0.1 ) );
+
+  CubicSplineInterpolator interpolator;
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, controller.start( interpolator ) );
+  make_cubic_spline( interpolator, 0, true );
+  EXPECT_EQ( SPLINE_INVALID_ARGUMENT_VALUE_ZERO, controller.start( interpolator, -1.0 ) );
+  ASSERT_EQ( SPLINE_SUCCESS, controller.start( interpolator ) );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_INTERVAL_TIME_DT, controller.step( 0.0, tpva ) );
+  EXPECT_EQ( 0.0, controller.elapsed_time() );
+}
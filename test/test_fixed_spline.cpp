@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include "fixed_spline.hpp"
+#include "trapezoid_5251525_interpolator.hpp"
+#include "test/util/test_trajectories.hpp"
+
+using namespace interp;
+
+/// the number of sampled times to compare paths
+#define FIXED_SAMPLE_NUM 500
+
+#ifdef SPLINE_CXX14
+/// spline of constant waypoints calculated at compile time
+/// @return position at t=1.5
+constexpr double g_constexpr_position() {
+  const double times[4]     = { 0.0, 1.0, 2.0, 3.0 };
+  const double positions[4] = { 0.0, 1.0, 0.5, 2.0 };
+  FixedCubicSpline<4> spline;
+  spline.generate_path( times, positions );
+  double pos = 0.0, vel = 0.0, acc = 0.0;
+  spline.evaluate( 1.5, pos, vel, acc );
+  return pos;
+}
+#endif
+
+
+TEST(FixedSplineTest, cubic_same_as_kernel ) {
+  double              times[8]     = {};
+  double              positions[8] = {};
+  std::vector<double> times_list;
+  std::vector<double> positions_list;
+  for( std::size_t i=0; i < 8; i++ ) {
+    times[i]     = 0.3 * i + 0.02 * i * i;
+    positions[i] = sine_position( i );
+    times_list.push_back( times[i] );
+    positions_list.push_back( positions[i] );
+  }
+  CubicSpline spline;
+  ASSERT_EQ( SPLINE_SUCCESS, spline.generate_path( times_list, positions_list, 1.0, -2.0 ) );
+  FixedCubicSpline<8> fixed_spline;
+  EXPECT_FALSE( fixed_spline.is_generated() );
+  ASSERT_EQ( SPLINE_SUCCESS, fixed_spline.generate_path( times, positions, 1.0, -2.0 ) );
+  EXPECT_TRUE( fixed_spline.is_generated() );
+  EXPECT_EQ( 8u, fixed_spline.size() );
+  EXPECT_EQ( times[0], fixed_spline.start_time() );
+  EXPECT_EQ( times[7], fixed_spline.finish_time() );
+
+  const double tf = times[7];
+  for( std::size_t i=0; i <= FIXED_SAMPLE_NUM; i++ ) {
+    const double t = tf / FIXED_SAMPLE_NUM * i;
+    const TimePVA expected = spline.pop( t );
+    const TimePVA actual   = fixed_spline.pop( t );
+    // bitwise equal
+    ASSERT_EQ( expected.P.pos, actual.P.pos );
+    ASSERT_EQ( expected.P.vel, actual.P.vel );
+    ASSERT_EQ( expected.P.acc, actual.P.acc );
+  }
+
+  // float
+  float positions_f[8] = {};
+  for( std::size_t i=0; i < 8; i++ ) {
+    positions_f[i] = static_cast<float>( positions[i] );
+  }
+  FixedCubicSpline<8, float> fixed_spline_f;
+  ASSERT_EQ( SPLINE_SUCCESS, fixed_spline_f.generate_path( times, positions_f, 1.0f, -2.0f ) );
+  EXPECT_NEAR( spline.pop( 1.0 ).P.pos, fixed_spline_f.pop( 1.0 ).P.pos, 1.0e-4 );
+}
+
+
+TEST(FixedSplineTest, cubic_errors ) {
+  FixedCubicSpline<3> spline;
+  double pos = 0.0, vel = 0.0, acc = 0.0;
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, spline.evaluate( 0.0, pos, vel, acc ) );
+  EXPECT_THROW( spline.pop( 0.0 ), NotSplineGenerated );
+
+  // times not strictly increasing
+  const double same_times[3]      = { 0.0, 1.0, 1.0 };
+  const double duplicate_times[3] = { 0.0, 0.0, 1.0 };
+  const double positions[3]       = { 0.0, 1.0, 2.0 };
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, spline.generate_path( same_times, positions ) );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, spline.generate_path( duplicate_times, positions ) );
+  EXPECT_FALSE( spline.is_generated() );
+  FixedCubicSpline<4> spline4;
+  const double reversed_times[4] = { 0.0, 2.0, 1.0, 3.0 };
+  const double positions4[4]     = { 0.0, 1.0, 2.0, 3.0 };
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, spline4.generate_path( reversed_times, positions4 ) );
+  EXPECT_FALSE( spline4.is_generated() );
+  // interval time nearly zero
+  const double close_times[3] = { 0.0, 1.0e-17, 1.0 };
+  EXPECT_EQ( SPLINE_INVALID_INPUT_INTERVAL_TIME_DT, spline.generate_path( close_times, positions ) );
+  EXPECT_FALSE( spline.is_generated() );
+
+  const double times[3] = { 0.0, 1.0, 2.0 };
+  ASSERT_EQ( SPLINE_SUCCESS, spline.generate_path( times, positions ) );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, spline.evaluate( 2.1, pos, vel, acc ) );
+  EXPECT_THROW( spline.pop( -0.1 ), TimeOutOfRange );
+  ASSERT_EQ( SPLINE_SUCCESS, spline.evaluate( 2.0, pos, vel, acc ) );
+  EXPECT_EQ( 2.0, pos );
+  EXPECT_EQ( 0.0, vel );
+  EXPECT_EQ( 0.0, acc );
+}
+
+
+#ifdef SPLINE_CXX14
+TEST(FixedSplineTest, cubic_constexpr ) {
+  constexpr double position = g_constexpr_position();
+  static_assert( position > 0.5 && position < 1.0, "position between waypoints" );
+
+  std::vector<double> times;
+  std::vector<double> positions;
+  const double waypoints[4] = { 0.0, 1.0, 0.5, 2.0 };
+  for( std::size_t i=0; i < 4; i++ ) {
+    times.push_back( (double)i );
+    positions.push_back( waypoints[i] );
+  }
+  CubicSpline spline;
+  ASSERT_EQ( SPLINE_SUCCESS, spline.generate_path( times, positions ) );
+  EXPECT_EQ( spline.pop( 1.5 ).P.pos, position );
+}
+#endif
+
+
+TEST(FixedSplineTest, trapezoid_same_as_interpolator ) {
+  double  times[6]     = {};
+  double  positions[6] = {};
+  TPQueue tp_queue;
+  for( std::size_t i=0; i < 6; i++ ) {
+    times[i]     = 1.0 * i;
+    positions[i] = sine_position( i );
+    tp_queue.push( TimePosition( times[i], positions[i] ) );
+  }
+  TrapezoidalInterpolator interpolator( make_trapezoid_config_queue( 5 ) );
+  ASSERT_EQ( SPLINE_SUCCESS, interpolator.generate_path( tp_queue ) );
+
+  FixedTrapezoid<6> trapezoid( 1200, 1200, 170, 0.8, 0.8, 0.5 );
+  EXPECT_THROW( trapezoid.pop( 0.0 ), NotSplineGenerated );
+  ASSERT_EQ( SPLINE_SUCCESS, trapezoid.generate_path( times, positions ) );
+  EXPECT_TRUE( trapezoid.is_generated() );
+  EXPECT_EQ( 6u, trapezoid.size() );
+  EXPECT_EQ( 5.0, trapezoid.finish_time() );
+
+  for( std::size_t i=0; i <= FIXED_SAMPLE_NUM; i++ ) {
+    const double t = 5.0 / FIXED_SAMPLE_NUM * i;
+    const TimePVA expected = interpolator.pop( t );
+    const TimePVA actual   = trapezoid.pop( t );
+    ASSERT_EQ( expected.P.pos, actual.P.pos );
+    ASSERT_EQ( expected.P.vel, actual.P.vel );
+    ASSERT_EQ( expected.P.acc, actual.P.acc );
+  }
+  EXPECT_THROW( trapezoid.pop( 5.1 ), TimeOutOfRange );
+
+  // unreachable
+  const double far_positions[6] = { 0.0, 1.0e5, 0.0, 0.0, 0.0, 0.0 };
+  EXPECT_EQ( SPLINE_FAIL_TO_GENERATE_PATH, trapezoid.generate_path( times, far_positions ) );
+  EXPECT_FALSE( trapezoid.is_generated() );
+  const double reversed_times[6] = { 0.0, 1.0, 0.5, 3.0, 4.0, 5.0 };
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, trapezoid.generate_path( reversed_times, positions ) );
+}
@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include "monotonic_arena.hpp"
+#include "cubic_spline_interpolator.hpp"
+#include "non_uniform_rounding_spline.hpp"
+#include "trapezoid_5251525_interpolator.hpp"
+#include "test/util/test_trajectories.hpp"
+
+#include <numeric> // for accumulate
+
+using namespace interp;
+
+
+TEST(MonotonicArenaTest, allocate_and_reset ) {
+  MonotonicArena arena( 1024 );
+  EXPECT_EQ( 0u, arena.chunk_num() );
+  EXPECT_EQ( 0u, arena.capacity() );
+
+  void* first = arena.allocate( 10 );
+  EXPECT_EQ( 0u, reinterpret_cast<std::size_t>( first ) % MonotonicArena::MAX_ALIGNMENT );
+  void* second = arena.allocate( 8, 8 );
+  EXPECT_EQ( 0u, reinterpret_cast<std::size_t>( second ) % 8 );
+  EXPECT_NE( first, second );
+  EXPECT_EQ( 1u, arena.chunk_num() );
+  EXPECT_EQ( 1u, arena.heap_allocation_num() );
+  EXPECT_LE( 18u, arena.used_size() );
+
+  // reset keeps chunks and reuses them from the beginning
+  arena.reset();
+  EXPECT_EQ( 0u, arena.used_size() );
+  EXPECT_EQ( first, arena.allocate( 10 ) );
+  EXPECT_EQ( 1u, arena.heap_allocation_num() );
+
+  // larger than the chunk size
+  void* large = arena.allocate( 4096 );
+  EXPECT_TRUE( large != NULL );
+  EXPECT_EQ( 2u, arena.chunk_num() );
+  EXPECT_LE( 1024u + 4096u, arena.capacity() );
+  arena.reset();
+  arena.allocate( 10 );
+  EXPECT_EQ( large, arena.allocate( 4096 ) );
+  EXPECT_EQ( 2u, arena.heap_allocation_num() );
+
+  arena.release();
+  EXPECT_EQ( 0u, arena.chunk_num() );
+  EXPECT_EQ( 0u, arena.used_size() );
+}
+
+
+TEST(MonotonicArenaTest, rewind_by_scope ) {
+  MonotonicArena arena( 256 );
+  arena.allocate( 32 );
+  const std::size_t used_size = arena.used_size();
+  {
+    ArenaScope scope( &arena );
+    for( std::size_t i=0; i < 100; i++ ) {
+      arena.allocate( 64 );
+    }
+    EXPECT_LT( used_size, arena.used_size() );
+  }
+  EXPECT_EQ( used_size, arena.used_size() );
+  // rewinding ahead of the current position is ignored
+  MonotonicArena::Mark ahead;
+  ahead.chunk_index = arena.chunk_num();
+  arena.rewind( ahead );
+  EXPECT_EQ( used_size, arena.used_size() );
+  // NULL arena does nothing
+  ArenaScope null_scope( NULL );
+}
+
+
+TEST(MonotonicArenaTest, allocator_with_containers ) {
+  MonotonicArena arena;
+  {
+    ArenaVector<double>::type values( ( ArenaAllocator<double>( &arena ) ) );
+    for( std::size_t i=0; i < 1000; i++ ) {
+      values.push_back( 0.5 * i );
+    }
+    EXPECT_EQ( 499.5, values.back() );
+    EXPECT_TRUE( values.get_allocator().arena() == &arena );
+    EXPECT_LE( 1000u * sizeof(double), arena.used_size() );
+  }
+
+  // time queue on the arena
+  typedef TimeQueue<PosVelAcc, ArenaAllocator<TimePVA> > ArenaTPVAQueue;
+  ArenaTPVAQueue tpva_queue( ( ArenaAllocator<TimePVA>( &arena ) ) );
+  for( std::size_t i=0; i < 100; i++ ) {
+    EXPECT_EQ( SPLINE_SUCCESS,
+               tpva_queue.push_on_clocktime( 0.1 * i, PosVelAcc( (double)i, 0.0, 0.0 ) ) );
+  }
+  EXPECT_EQ( 100u, tpva_queue.size() );
+  EXPECT_NEAR( 0.1, tpva_queue.dT( 50 ), 1.0e-12 );
+  EXPECT_EQ( 42.0, tpva_queue.get( 42 ).P.pos );
+  EXPECT_TRUE( tpva_queue.get_allocator() == ArenaAllocator<TimePVA>( &arena ) );
+
+  // without arena, the heap is used
+  ArenaAllocator<double> heap_alloc;
+  EXPECT_TRUE( heap_alloc.arena() == NULL );
+  ArenaVector<double>::type heap_values( 100, 1.0, heap_alloc );
+  EXPECT_EQ( 100.0, std::accumulate( heap_values.begin(), heap_values.end(), 0.0 ) );
+  EXPECT_TRUE( heap_alloc != ArenaAllocator<int>( &arena ) );
+}
+
+
+TEST(MonotonicArenaTest, tpva_queue_on_arena ) {
+  const TPQueue target_tp_queue = make_sine_tp_queue( 500 + 1 );
+  TPVAQueue expected;
+  ASSERT_EQ( SPLINE_SUCCESS,
+             NonUniformRoundingSpline::compute_tpva_queue( target_tp_queue, expected, 1.0, -1.0 ) );
+
+  MonotonicArena arena;
+  TPVAQueue tpva_queue;
+  ASSERT_EQ( SPLINE_SUCCESS,
+             NonUniformRoundingSpline::compute_tpva_queue( target_tp_queue, tpva_queue, 1.0, -1.0,
+                                                           NULL, &arena ) );
+  // scratch buffers are released at the end of the calculation
+  EXPECT_EQ( 0u, arena.used_size() );
+  const std::size_t heap_allocation_num = arena.heap_allocation_num();
+  EXPECT_LT( 0u, heap_allocation_num );
+
+  // repeated calculations reuse the chunks of the arena
+  for( std::size_t i=0; i < 10; i++ ) {
+    ASSERT_EQ( SPLINE_SUCCESS,
+               NonUniformRoundingSpline::compute_tpva_queue( target_tp_queue, tpva_queue, 1.0, -1.0,
+                                                             NULL, &arena ) );
+  }
+  EXPECT_EQ( heap_allocation_num, arena.heap_allocation_num() );
+
+  ASSERT_EQ( expected.size(), tpva_queue.size() );
+  for( std::size_t i=0; i < expected.size(); i++ ) {
+    ASSERT_EQ( expected.get( i ).time,  tpva_queue.get( i ).time );
+    ASSERT_EQ( expected.get( i ).P.pos, tpva_queue.get( i ).P.pos );
+    ASSERT_EQ( expected.get( i ).P.vel, tpva_queue.get( i ).P.vel );
+  }
+}
+
+
+TEST(MonotonicArenaTest, cubic_spline_on_arena ) {
+  const TPQueue target_tp_queue = make_sine_tp_queue( 500 + 1 );
+  CubicSplineInterpolator heap_interpolator;
+  ASSERT_EQ( SPLINE_SUCCESS, heap_interpolator.generate_path( target_tp_queue ) );
+
+  MonotonicArena arena;
+  CubicSplineInterpolator interpolator;
+  interpolator.set_arena( &arena );
+  EXPECT_EQ( &arena, interpolator.arena() );
+  ASSERT_EQ( SPLINE_SUCCESS, interpolator.generate_path( target_tp_queue ) );
+  // scratch buffers are released at the end of the plan
+  EXPECT_EQ( 0u, arena.used_size() );
+  const std::size_t heap_allocation_num = arena.heap_allocation_num();
+  EXPECT_LT( 0u, heap_allocation_num );
+
+  // repeated plans reuse the chunks of the arena (also without the uniform-knot fast path)
+  for( std::size_t i=0; i < 10; i++ ) {
+    interpolator.set_uniform_knot_detection( i % 2 == 0 );
+    ASSERT_EQ( SPLINE_SUCCESS, interpolator.generate_path( target_tp_queue ) );
+    EXPECT_EQ( 0u, arena.used_size() );
+  }
+  EXPECT_EQ( heap_allocation_num, arena.heap_allocation_num() );
+
+  for( double t=0.0; t <= 500.0; t+=0.37 ) {
+    const TimePVA expected = heap_interpolator.pop( t );
+    const TimePVA actual   = interpolator.pop( t );
+    ASSERT_NEAR( expected.P.pos, actual.P.pos, 1.0e-9 );
+    ASSERT_NEAR( expected.P.vel, actual.P.vel, 1.0e-9 );
+    ASSERT_NEAR( expected.P.acc, actual.P.acc, 1.0e-9 );
+  }
+}
+
+
+TEST(MonotonicArenaTest, trapezoid_on_arena ) {
+  const std::size_t segment_num = 100;
+  const TPQueue target_tp_queue = make_sine_tp_queue( segment_num + 1 );
+  const TrapezoidConfigQueue trapzd_config_que = make_trapezoid_config_queue( segment_num );
+  TrapezoidalInterpolator heap_interpolator( trapzd_config_que );
+  ASSERT_EQ( SPLINE_SUCCESS, heap_interpolator.generate_path( target_tp_queue ) );
+
+  MonotonicArena arena;
+  TrapezoidalInterpolator interpolator( trapzd_config_que );
+  interpolator.set_arena( &arena );
+  ASSERT_EQ( SPLINE_SUCCESS, interpolator.generate_path( target_tp_queue ) );
+  EXPECT_EQ( 0u, arena.used_size() );
+  const std::size_t heap_allocation_num = arena.heap_allocation_num();
+  // re-initialization reuses the trajectories
+  interpolator.initialize( trapzd_config_que );
+  ASSERT_EQ( SPLINE_SUCCESS, interpolator.generate_path( target_tp_queue ) );
+  EXPECT_EQ( heap_allocation_num, arena.heap_allocation_num() );
+  EXPECT_EQ( segment_num, interpolator.trapzd_trajectory_que_size() );
+
+  for( double t=0.0; t <= segment_num; t+=0.13 ) {
+    const TimePVA expected = heap_interpolator.pop( t );
+    const TimePVA actual   = interpolator.pop( t );
+    ASSERT_EQ( expected.P.pos, actual.P.pos );
+    ASSERT_EQ( expected.P.vel, actual.P.vel );
+    ASSERT_EQ( expected.P.acc, actual.P.acc );
+  }
+
+  // an invalid target keeps the arena rewound
+  TPQueue invalid_tp_queue;
+  invalid_tp_queue.push( TimePosition( 0.0, 0.0 ) );
+  EXPECT_EQ( SPLINE_INVALID_QUEUE_SIZE, interpolator.generate_path( invalid_tp_queue ) );
+  EXPECT_EQ( 0u, arena.used_size() );
+
+  // shrinking re-initialization
+  interpolator.initialize( 1200, 1200, 170, 0.8, 0.8, 0.5 );
+  EXPECT_EQ( 1u, interpolator.trapzd_trajectory_que_size() );
+}
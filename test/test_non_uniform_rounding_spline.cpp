@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "non_uniform_rounding_spline.hpp"
+#include "trapezoid_5251525_interpolator.hpp"
+#include "spline_thread_pool.hpp"
+
+#include <math.h>
+
+using namespace interp;
+
+/// the number of points
+#define NURS_POINT_NUM 1001
+
+/// make times (non-uniform interval) & positions
+static void make_points( std::vector<double>& times, std::vector<double>& positions ) {
+  times.clear();
+  positions.clear();
+  double t = 0.0;
+  for( std::size_t i=0; i < NURS_POINT_NUM; i++ ) {
+    times.push_back( t );
+    positions.push_back( 10.0 * sin( 0.3 * i ) + 0.5 * i );
+    t += 0.5 + 0.25 * ( i % 3 );
+  }
+}
+
+
+TEST(NonUniformRoundingSplineTest, compute_velocities_same_as_push ) {
+  std::vector<double> times, positions;
+  make_points( times, positions );
+
+  // point by point
+  NonUniformRoundingSpline nurs;
+  for( std::size_t i=0; i < times.size(); i++ ) {
+    EXPECT_EQ( SPLINE_SUCCESS, nurs.push( times[i], positions[i] ) );
+  }
+
+  std::vector<double> velocities;
+  EXPECT_EQ( SPLINE_SUCCESS,
+             NonUniformRoundingSpline::compute_velocities( times, positions, velocities ) );
+  ASSERT_EQ( times.size(), velocities.size() );
+  EXPECT_EQ( 0.0, velocities.front() );
+  EXPECT_EQ( 0.0, velocities.back() );
+  for( std::size_t i=1; i < times.size()-1; i++ ) {
+    ASSERT_EQ( nurs.get( i ).P.vel, velocities[i] ) << "index = " << i;
+  }
+
+  // parallel
+  SplineThreadPool pool( 4 );
+  std::vector<double> parallel_velocities;
+  EXPECT_EQ( SPLINE_SUCCESS,
+             NonUniformRoundingSpline::compute_velocities( times, positions,
+                                                           parallel_velocities,
+                                                           1.5, -2.5, &pool ) );
+  EXPECT_EQ( 1.5,  parallel_velocities.front() );
+  EXPECT_EQ( -2.5, parallel_velocities.back() );
+  for( std::size_t i=1; i < times.size()-1; i++ ) {
+    ASSERT_EQ( velocities[i], parallel_velocities[i] ) << "index = " << i;
+  }
+}
+
+
+TEST(NonUniformRoundingSplineTest, compute_velocities_invalid ) {
+  std::vector<double> times, positions, velocities;
+  times.push_back( 0.0 );
+  positions.push_back( 1.0 );
+  EXPECT_EQ( SPLINE_INVALID_QUEUE_SIZE,
+             NonUniformRoundingSpline::compute_velocities( times, positions, velocities ) );
+
+  times.push_back( 1.0 );
+  EXPECT_EQ( SPLINE_INVALID_QUEUE_SIZE,
+             NonUniformRoundingSpline::compute_velocities( times, positions, velocities ) );
+
+  positions.push_back( 2.0 );
+  EXPECT_EQ( SPLINE_SUCCESS,
+             NonUniformRoundingSpline::compute_velocities( times, positions, velocities,
+                                                           0.1, 0.2 ) );
+  ASSERT_EQ( 2, velocities.size() );
+  EXPECT_EQ( 0.1, velocities[0] );
+  EXPECT_EQ( 0.2, velocities[1] );
+
+  times.push_back( 1.0 );
+  positions.push_back( 3.0 );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME,
+             NonUniformRoundingSpline::compute_velocities( times, positions, velocities ) );
+}
+
+
+TEST(NonUniformRoundingSplineTest, compute_tpva_queue ) {
+  std::vector<double> times, positions;
+  make_points( times, positions );
+  TPQueue tp_queue;
+  for( std::size_t i=0; i < times.size(); i++ ) {
+    tp_queue.push_on_clocktime( times[i], positions[i] );
+  }
+
+  TPVAQueue tpva_queue;
+  EXPECT_EQ( SPLINE_SUCCESS,
+             NonUniformRoundingSpline::compute_tpva_queue( tp_queue, tpva_queue, 0.5, 0.0 ) );
+  std::vector<double> velocities;
+  NonUniformRoundingSpline::compute_velocities( times, positions, velocities, 0.5, 0.0 );
+
+  ASSERT_EQ( times.size(), tpva_queue.size() );
+  for( std::size_t i=0; i < times.size(); i++ ) {
+    EXPECT_EQ( times[i],      tpva_queue.at( i ).time );
+    EXPECT_EQ( positions[i],  tpva_queue.at( i ).P.pos );
+    EXPECT_EQ( velocities[i], tpva_queue.at( i ).P.vel );
+    EXPECT_EQ( 0.0,           tpva_queue.at( i ).P.acc );
+  }
+  EXPECT_DOUBLE_EQ( times.back() - times.front(), tpva_queue.total_dT() );
+  EXPECT_DOUBLE_EQ( times[1] - times[0], tpva_queue.dT( 0 ) );
+}
+
+
+TEST(NonUniformRoundingSplineTest, trapezoid_generate_path_from_tp_queue ) {
+  std::vector<double> times, positions;
+  make_points( times, positions );
+  TPQueue tp_queue;
+  for( std::size_t i=0; i < times.size(); i++ ) {
+    tp_queue.push_on_clocktime( times[i], positions[i] );
+  }
+  TrapezoidConfigQueue trapzd_config_que;
+  for( std::size_t i=0; i < times.size()-1; i++ ) {
+    trapzd_config_que.push_back( TrapezoidConfig( 1200, 1200, 170, 0.8, 0.8, 0.5 ) );
+  }
+
+  TrapezoidalInterpolator tg( trapzd_config_que );
+  EXPECT_EQ( SPLINE_SUCCESS, tg.generate_path( tp_queue ) );
+  EXPECT_DOUBLE_EQ( times.front(), tg.start_time() );
+  EXPECT_DOUBLE_EQ( times.back(),  tg.finish_time() );
+
+  std::vector<double> velocities;
+  NonUniformRoundingSpline::compute_velocities( times, positions, velocities );
+  // the path passes through every target point with the calculated velocity
+  for( std::size_t i=0; i < times.size(); i++ ) {
+    const TimePVA tpva = tg.pop( times[i] );
+    EXPECT_NEAR( positions[i],  tpva.P.pos, 1.0e-6 ) << "index = " << i;
+    EXPECT_NEAR( velocities[i], tpva.P.vel, 1.0e-6 ) << "index = " << i;
+  }
+}
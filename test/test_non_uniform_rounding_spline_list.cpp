@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "non_uniform_rounding_spline.hpp"
+#include "non_uniform_rounding_spline_list.hpp"
+#include "spline_thread_pool.hpp"
+
+#include <math.h>
+
+using namespace interp;
+
+/// the number of points
+#define NURS_LIST_POINT_NUM 501
+
+/// make times (non-uniform interval) & xy positions on a spiral
+static void make_xy_points( std::vector<double>& times,
+                            std::vector< std::vector<double> >& positions ) {
+  times.clear();
+  positions.assign( 2, std::vector<double>() );
+  double t = 0.0;
+  for( std::size_t i=0; i < NURS_LIST_POINT_NUM; i++ ) {
+    times.push_back( t );
+    positions[0].push_back( ( 1.0 + 0.02 * i ) * cos( 0.2 * i ) );
+    positions[1].push_back( ( 1.0 + 0.02 * i ) * sin( 0.2 * i ) );
+    t += 0.1 + 0.05 * ( i % 4 );
+  }
+}
+
+
+TEST(NonUniformRoundingSplineListTest, one_axis_same_as_nurs ) {
+  std::vector<double> times;
+  std::vector< std::vector<double> > positions;
+  make_xy_points( times, positions );
+  positions.resize( 1 );
+
+  std::vector<double> nurs_velocities;
+  EXPECT_EQ( SPLINE_SUCCESS,
+             NonUniformRoundingSpline::compute_velocities( times, positions[0],
+                                                           nurs_velocities ) );
+  std::vector< std::vector<double> > velocities;
+  EXPECT_EQ( SPLINE_SUCCESS,
+             NonUniformRoundingSplineList::compute_velocities( times, positions, velocities ) );
+  ASSERT_EQ( 1, velocities.size() );
+  for( std::size_t i=0; i < times.size(); i++ ) {
+    ASSERT_EQ( nurs_velocities[i], velocities[0][i] ) << "index = " << i;
+  }
+}
+
+
+TEST(NonUniformRoundingSplineListTest, joint_chord_velocity ) {
+  std::vector<double> times;
+  std::vector< std::vector<double> > positions;
+  make_xy_points( times, positions );
+
+  std::vector< std::vector<double> > velocities;
+  EXPECT_EQ( SPLINE_SUCCESS,
+             NonUniformRoundingSplineList::compute_velocities( times, positions, velocities ) );
+  ASSERT_EQ( 2, velocities.size() );
+
+  for( std::size_t i=1; i < times.size()-1; i++ ) {
+    // reference of the joint chord in (t, x, y)
+    const double dt0 = times[i] - times[i-1];
+    const double dx0 = positions[0][i] - positions[0][i-1];
+    const double dy0 = positions[1][i] - positions[1][i-1];
+    const double dt1 = times[i+1] - times[i];
+    const double dx1 = positions[0][i+1] - positions[0][i];
+    const double dy1 = positions[1][i+1] - positions[1][i];
+    const double d0  = sqrt( dt0*dt0 + dx0*dx0 + dy0*dy0 );
+    const double d1  = sqrt( dt1*dt1 + dx1*dx1 + dy1*dy1 );
+    const double tangent_t = dt1 / d1 + dt0 / d0;
+    const double tangent_x = dx1 / d1 + dx0 / d0;
+    const double tangent_y = dy1 / d1 + dy0 / d0;
+    EXPECT_NEAR( tangent_x / tangent_t, velocities[0][i], 1.0e-12 );
+    EXPECT_NEAR( tangent_y / tangent_t, velocities[1][i], 1.0e-12 );
+    // xy velocity is parallel to the joint tangent
+    EXPECT_NEAR( 0.0, velocities[0][i] * tangent_y - velocities[1][i] * tangent_x, 1.0e-12 );
+  }
+
+  // parallel
+  SplineThreadPool pool( 3 );
+  std::vector<double> vs( 2, 0.5 );
+  std::vector<double> vf( 2, -0.5 );
+  std::vector< std::vector<double> > parallel_velocities;
+  EXPECT_EQ( SPLINE_SUCCESS,
+             NonUniformRoundingSplineList::compute_velocities( times, positions,
+                                                               parallel_velocities,
+                                                               vs, vf, &pool ) );
+  for( std::size_t k=0; k < 2; k++ ) {
+    EXPECT_EQ( vs[k], parallel_velocities[k].front() );
+    EXPECT_EQ( vf[k], parallel_velocities[k].back() );
+    for( std::size_t i=1; i < times.size()-1; i++ ) {
+      ASSERT_EQ( velocities[k][i], parallel_velocities[k][i] );
+    }
+  }
+
+  // invalid size
+  EXPECT_EQ( SPLINE_INVALID_QUEUE_SIZE,
+             NonUniformRoundingSplineList::compute_velocities( times, positions,
+                                                               velocities,
+                                                               std::vector<double>( 3, 0.0 ) ) );
+  positions[1].pop_back();
+  EXPECT_EQ( SPLINE_INVALID_QUEUE_SIZE,
+             NonUniformRoundingSplineList::compute_velocities( times, positions, velocities ) );
+}
+
+
+TEST(NonUniformRoundingSplineListTest, push_same_as_bulk ) {
+  std::vector<double> times;
+  std::vector< std::vector<double> > positions;
+  make_xy_points( times, positions );
+
+  std::vector< std::vector<double> > velocities;
+  NonUniformRoundingSplineList::compute_velocities( times, positions, velocities );
+
+  NonUniformRoundingSplineList nurs_list;
+  TPVAListQueue target_queue;
+  for( std::size_t i=0; i < times.size(); i++ ) {
+    std::vector<double> xy( 2 );
+    xy[0] = positions[0][i];
+    xy[1] = positions[1][i];
+    EXPECT_EQ( SPLINE_SUCCESS, nurs_list.push( times[i], xy ) );
+    target_queue.push( times[i], PVAList( xy, std::vector<double>( 2, 0.0 ),
+                                          std::vector<double>( 2, 0.0 ) ) );
+    // pop the oldest point in the middle like a streaming buffer
+    if( i == times.size() / 2 ) {
+      EXPECT_EQ( SPLINE_SUCCESS, nurs_list.pop_delete() );
+    }
+  }
+  EXPECT_EQ( 2, nurs_list.axis_size() );
+  EXPECT_EQ( times.size() - 1, nurs_list.size() );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME,
+             nurs_list.push( times.back(), std::vector<double>( 2, 0.0 ) ) );
+  EXPECT_EQ( SPLINE_INVALID_QUEUE_SIZE,
+             nurs_list.push( times.back() + 1.0, std::vector<double>( 3, 0.0 ) ) );
+
+  for( std::size_t i=1; i < times.size()-1; i++ ) {
+    const TimePVAList& tpva_list = nurs_list.tpva_list_queue().at( i-1 );
+    EXPECT_EQ( times[i], tpva_list.time );
+    ASSERT_EQ( velocities[0][i], tpva_list.value[0].vel ) << "index = " << i;
+    ASSERT_EQ( velocities[1][i], tpva_list.value[1].vel ) << "index = " << i;
+  }
+
+  // bulk into TPVAListQueue
+  TPVAListQueue tpva_list_queue;
+  EXPECT_EQ( SPLINE_SUCCESS,
+             NonUniformRoundingSplineList::compute_tpva_list_queue( target_queue,
+                                                                    tpva_list_queue ) );
+  ASSERT_EQ( times.size(), tpva_list_queue.size() );
+  for( std::size_t i=0; i < times.size(); i++ ) {
+    const TimePVAList& tpva_list = tpva_list_queue.at( i );
+    EXPECT_EQ( positions[0][i],  tpva_list.value[0].pos );
+    EXPECT_EQ( velocities[1][i], tpva_list.value[1].vel );
+  }
+}
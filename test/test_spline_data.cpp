@@ -57,6 +57,21 @@ TEST(g_isNearlyZero, test) {
   EXPECT_TRUE( g_isNearlyZero( a_double+PRECISION ) );
 }
 
+TEST(ScalarTraitsTest, precision) {
+  EXPECT_FALSE( ScalarTraits<char>::is_numeric );
+  EXPECT_TRUE( ScalarTraits<float>::is_numeric );
+  EXPECT_EQ( std::numeric_limits<float>::epsilon(), ScalarTraits<float>::precision() );
+  EXPECT_EQ( PRECISION, ScalarTraits<double>::precision() );
+  // per-type tolerance of float
+  const float one_float = 1.0f;
+  EXPECT_TRUE( g_isNearlyEq( one_float, one_float + std::numeric_limits<float>::epsilon() ) );
+  EXPECT_FALSE( g_isNearlyEq( one_float, one_float + 2.0f * std::numeric_limits<float>::epsilon() ) );
+  EXPECT_TRUE( g_isNearlyZero( 0.5f * std::numeric_limits<float>::epsilon() ) );
+  EXPECT_FALSE( g_isNearlyZero( 1.0e-6f ) );
+  EXPECT_TRUE( g_isNearlyZero( 1.0e-17 ) );
+  EXPECT_FALSE( g_isNearlyZero( 1.0e-6 ) );
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////
 
 TEST(PosVelAccTest, constructor ) {
@@ -489,6 +504,58 @@ TEST(TPQueueTest, insert_operator){
   EXPECT_EQ( tp_queue_dest.get(3).value, tp_queue_src.get(3).value );
 }
 
+TEST(TPQueueTest, swap_and_reference_accessor){
+  TPQueue tp_queue_src;
+  TPQueue tp_queue_dest;
+  EXPECT_EQ( tp_queue_src.push( TimePosition( 0.0, 1.0 ) ), SPLINE_SUCCESS );
+  EXPECT_EQ( tp_queue_src.push( TimePosition( 2.0, 3.0 ) ), SPLINE_SUCCESS );
+  // accessors refer to the element without copy
+  EXPECT_EQ( &tp_queue_src.at(0), &tp_queue_src.get(0) );
+  EXPECT_EQ( &tp_queue_src.at(0), &tp_queue_src.front() );
+  EXPECT_EQ( &tp_queue_src.at(1), &tp_queue_src.back() );
+  const TimePosition* element = &tp_queue_src.at(1);
+  //
+  tp_queue_dest.swap( tp_queue_src );
+  EXPECT_EQ( 0u,  tp_queue_src.size() );
+  EXPECT_EQ( 0.0, tp_queue_src.total_dT() );
+  EXPECT_EQ( 2u,  tp_queue_dest.size() );
+  EXPECT_EQ( 2.0, tp_queue_dest.total_dT() );
+  EXPECT_EQ( 2.0, tp_queue_dest.dT(0) );
+  // elements are handed over without copy
+  EXPECT_EQ( element, &tp_queue_dest.back() );
+}
+
+#ifdef SPLINE_CXX11
+TEST(TPQueueTest, move){
+  EXPECT_TRUE( std::is_nothrow_move_constructible<TPVAQueue>::value );
+  EXPECT_TRUE( std::is_nothrow_move_assignable<TPVAQueue>::value );
+  EXPECT_TRUE( std::is_nothrow_move_constructible<PVAList>::value );
+
+  TPVAListQueue tpva_list_queue;
+  PVAList pva_list;
+  pva_list.push_back( PosVelAcc( 1.0, 2.0, 3.0 ) );
+  EXPECT_EQ( tpva_list_queue.push( 0.0, pva_list ), SPLINE_SUCCESS );
+  EXPECT_EQ( tpva_list_queue.push( 1.5, pva_list ), SPLINE_SUCCESS );
+  const PosVelAcc* element = &tpva_list_queue.back().P[0];
+  //
+  TPVAListQueue moved( std::move( tpva_list_queue ) );
+  EXPECT_EQ( 0u,  tpva_list_queue.size() );
+  EXPECT_EQ( 2u,  moved.size() );
+  EXPECT_EQ( 1.5, moved.total_dT() );
+  EXPECT_EQ( element, &moved.back().P[0] );
+  // empty source is allowed for move
+  moved = std::move( tpva_list_queue );
+  EXPECT_EQ( 0u, moved.size() );
+  EXPECT_EQ( 0.0, moved.total_dT() );
+  //
+  TimePVAList tpva_list( 0.5, pva_list );
+  TimePVAList moved_tpva_list( std::move( tpva_list ) );
+  EXPECT_EQ( 0u, tpva_list.P.size() );
+  EXPECT_EQ( 1u, moved_tpva_list.P.size() );
+  EXPECT_EQ( &moved_tpva_list.value, &moved_tpva_list.P );
+}
+#endif
+
 TEST(TPQueueTest, push_set){
   TimeVal<double> tp0(0.0, 0.0);
   TimeVal<double> tp0_swap(0.0, -77.7);
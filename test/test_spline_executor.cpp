@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "spline_executor.hpp"
+#include "cubic_spline_interpolator.hpp"
+#include "spline_exception.hpp"
+#include "test/util/test_trajectories.hpp"
+
+#include <unistd.h>
+#include <vector>
+
+using namespace interp;
+
+/// the number of samples of each axis
+#define EXECUTOR_SAMPLE_NUM 200
+
+/// Job counting its executions
+class CountJob : public SplineJob {
+public:
+  CountJob() : count(0) {}
+  virtual RetCode run( SplineWorkerContext& context ) {
+    (void)context;
+    count++;
+    return SPLINE_SUCCESS;
+  }
+  int count;
+};
+
+/// Job sleeping 1[ms]
+class SleepJob : public CountJob {
+public:
+  virtual RetCode run( SplineWorkerContext& context ) {
+    usleep( 1000 );
+    return CountJob::run( context );
+  }
+};
+
+/// Job submitting slow children from one worker
+class SpawnJob : public SplineJob {
+public:
+  SpawnJob( std::vector<SleepJob>& children ) : children_(children) {}
+  virtual RetCode run( SplineWorkerContext& context ) {
+    for( std::size_t i=0; i < children_.size(); i++ ) {
+      context.submit( children_[i] );
+    }
+    return SPLINE_SUCCESS;
+  }
+private:
+  std::vector<SleepJob>& children_;
+};
+
+/// Job failing or throwing
+class FailJob : public SplineJob {
+public:
+  FailJob( const bool& is_throw ) : is_throw_(is_throw) {}
+  virtual RetCode run( SplineWorkerContext& context ) {
+    (void)context;
+    if( is_throw_ ) {
+      throw InvalidArgumentValue( "FailJob" );
+    }
+    return SPLINE_INVALID_QUEUE_SIZE;
+  }
+private:
+  bool is_throw_;
+};
+
+
+TEST(SplineExecutorTest, same_as_sequential ) {
+  const std::size_t axis_num = 32;
+  std::vector<TPQueue> tp_queues( axis_num );
+  std::vector<CubicSplineInterpolator> interpolators( axis_num );
+  std::vector<double> pos( axis_num * EXECUTOR_SAMPLE_NUM ), vel( axis_num * EXECUTOR_SAMPLE_NUM );
+  std::vector<SampleJob*>       sample_jobs;
+  std::vector<GeneratePathJob*> generate_jobs;
+
+  SplineExecutor executor( 4 );
+  EXPECT_EQ( 4u, executor.thread_num() );
+  for( std::size_t axis=0; axis < axis_num; axis++ ) {
+    tp_queues[axis] = make_sine_tp_queue( 10, 0.5, 0.01, axis );
+    sample_jobs.push_back( new SampleJob( interpolators[axis], 0.0, 0.025, EXECUTOR_SAMPLE_NUM,
+                                          &pos[axis * EXECUTOR_SAMPLE_NUM],
+                                          &vel[axis * EXECUTOR_SAMPLE_NUM] ) );
+    generate_jobs.push_back( new GeneratePathJob( interpolators[axis], tp_queues[axis],
+                                                  sample_jobs[axis] ) );
+    executor.submit( *generate_jobs[axis] );
+  }
+  ASSERT_EQ( SPLINE_SUCCESS, executor.run_all() );
+
+  std::size_t executed_num = 0;
+  for( std::size_t i=0; i < executor.thread_num(); i++ ) {
+    executed_num += executor.executed_job_num( i );
+  }
+  EXPECT_EQ( 2 * axis_num, executed_num );
+
+  for( std::size_t axis=0; axis < axis_num; axis++ ) {
+    EXPECT_EQ( SPLINE_SUCCESS, generate_jobs[axis]->status() );
+    EXPECT_EQ( SPLINE_SUCCESS, sample_jobs[axis]->status() );
+    // the interpolator keeps its arena
+    EXPECT_TRUE( interpolators[axis].arena() == NULL );
+
+    CubicSplineInterpolator expected;
+    ASSERT_EQ( SPLINE_SUCCESS, expected.generate_path( tp_queues[axis] ) );
+    for( std::size_t i=0; i < EXECUTOR_SAMPLE_NUM; i++ ) {
+      const TimePVA tpva = expected.pop( 0.025 * i );
+      ASSERT_EQ( tpva.P.pos, pos[axis * EXECUTOR_SAMPLE_NUM + i] );
+      ASSERT_EQ( tpva.P.vel, vel[axis * EXECUTOR_SAMPLE_NUM + i] );
+    }
+    delete generate_jobs[axis];
+    delete sample_jobs[axis];
+  }
+}
+
+
+TEST(SplineExecutorTest, many_jobs ) {
+  std::vector<CountJob> jobs( 1000 );
+  SplineExecutor executor( 3 );
+  for( int repeat=0; repeat < 10; repeat++ ) {
+    for( std::size_t i=0; i < jobs.size(); i++ ) {
+      executor.submit( jobs[i] );
+    }
+    ASSERT_EQ( SPLINE_SUCCESS, executor.run_all() );
+    std::size_t executed_num = 0;
+    for( std::size_t i=0; i < executor.thread_num(); i++ ) {
+      executed_num += executor.executed_job_num( i );
+    }
+    ASSERT_EQ( jobs.size(), executed_num );
+  }
+  for( std::size_t i=0; i < jobs.size(); i++ ) {
+    EXPECT_EQ( 10, jobs[i].count );
+  }
+  // no job
+  EXPECT_EQ( SPLINE_SUCCESS, executor.run_all() );
+}
+
+
+TEST(SplineExecutorTest, steal ) {
+  std::vector<SleepJob> sleep_jobs( 40 );
+  SpawnJob spawn_job( sleep_jobs );
+  // the children are submitted to the queue of one worker, so the others must steal them
+  SplineExecutor executor( 4 );
+  executor.submit( spawn_job );
+  ASSERT_EQ( SPLINE_SUCCESS, executor.run_all() );
+
+  std::size_t executed_num = 0;
+  std::size_t stolen_num   = 0;
+  for( std::size_t i=0; i < executor.thread_num(); i++ ) {
+    executed_num += executor.executed_job_num( i );
+    stolen_num   += executor.stolen_job_num( i );
+  }
+  EXPECT_EQ( sleep_jobs.size() + 1, executed_num );
+  EXPECT_LT( 0u, stolen_num );
+  for( std::size_t i=0; i < sleep_jobs.size(); i++ ) {
+    EXPECT_EQ( 1, sleep_jobs[i].count );
+  }
+}
+
+
+TEST(SplineExecutorTest, failure ) {
+  SplineExecutor executor( 2 );
+  CountJob  success_job;
+  FailJob   fail_job( false );
+  FailJob   throw_job( true );
+
+  CubicSplineInterpolator interpolator;
+  TPQueue short_queue;
+  short_queue.push( TimePosition( 0.0, 0.0 ) );
+  double pos = 0.0;
+  SampleJob sample_job( interpolator, 0.0, 0.1, 1, &pos );
+  GeneratePathJob generate_job( interpolator, short_queue, &sample_job );
+
+  EXPECT_EQ( SPLINE_NOT_RETURN, fail_job.status() );
+  executor.submit( success_job );
+  executor.submit( fail_job );
+  EXPECT_EQ( SPLINE_INVALID_QUEUE_SIZE, executor.run_all() );
+  EXPECT_EQ( SPLINE_SUCCESS, success_job.status() );
+  EXPECT_EQ( SPLINE_INVALID_QUEUE_SIZE, fail_job.status() );
+
+  executor.submit( throw_job );
+  EXPECT_EQ( SPLINE_FAIL_TO_GENERATE_PATH, executor.run_all() );
+  EXPECT_EQ( SPLINE_FAIL_TO_GENERATE_PATH, throw_job.status() );
+
+  // the next job is not submitted after the failed generation
+  executor.submit( generate_job );
+  EXPECT_EQ( SPLINE_INVALID_QUEUE_SIZE, executor.run_all() );
+  EXPECT_EQ( SPLINE_INVALID_QUEUE_SIZE, generate_job.status() );
+  EXPECT_EQ( SPLINE_NOT_RETURN, sample_job.status() );
+
+  executor.submit( sample_job );
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, executor.run_all() );
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include "spline_thread_pool.hpp"
+#include "cubic_spline_interpolator.hpp"
+#include "trapezoid_5251525_interpolator.hpp"
+#include "test/util/test_trajectories.hpp"
+
+#include <stdexcept>
+
+using namespace interp;
+
+/// count how many times each index is visited
+class CountTask : public RangeTask {
+public:
+  explicit CountTask( std::vector<int>& count ) : count_(count) {}
+  virtual void run( const std::size_t& begin, const std::size_t& end ) {
+    for( std::size_t i=begin; i < end; i++ ) {
+      count_[i]++;
+    }
+  }
+private:
+  std::vector<int>& count_;
+};
+
+/// throw at the given index
+class ThrowTask : public RangeTask {
+public:
+  explicit ThrowTask( const std::size_t& throw_index ) : throw_index_(throw_index) {}
+  virtual void run( const std::size_t& begin, const std::size_t& end ) {
+    if( begin <= throw_index_ && throw_index_ < end ) {
+      throw std::invalid_argument( "thrown by ThrowTask" );
+    }
+  }
+private:
+  std::size_t throw_index_;
+};
+
+/// call parallel_for() of the same pool from each chunk
+class NestedTask : public RangeTask {
+public:
+  NestedTask( SplineThreadPool& pool, std::vector<int>& count )
+    : pool_(pool), count_(count) {}
+  virtual void run( const std::size_t& begin, const std::size_t& end ) {
+    for( std::size_t i=begin; i < end; i++ ) {
+      std::vector<int> inner_count( 100, 0 );
+      CountTask inner_task( inner_count );
+      if( pool_.parallel_for( 0, 100, inner_task, 1 ) == SPLINE_SUCCESS ) {
+        for( std::size_t j=0; j < inner_count.size(); j++ ) {
+          count_[i] += inner_count[j];
+        }
+      }
+    }
+  }
+private:
+  SplineThreadPool& pool_;
+  std::vector<int>& count_;
+};
+
+
+TEST(SplineThreadPoolTest, parallel_for ) {
+  SplineThreadPool pool( 4 );
+  EXPECT_EQ( 4, pool.thread_num() );
+
+  const std::size_t size = 10007;
+  for( std::size_t grain=0; grain < 50; grain+=7 ) {
+    std::vector<int> count( size, 0 );
+    CountTask task( count );
+    EXPECT_EQ( SPLINE_SUCCESS, pool.parallel_for( 3, size, task, grain ) );
+    EXPECT_EQ( 0, count[0] );
+    EXPECT_EQ( 0, count[2] );
+    for( std::size_t i=3; i < size; i++ ) {
+      ASSERT_EQ( 1, count[i] ) << "index = " << i << ", grain = " << grain;
+    }
+  }
+  std::vector<int> count( 10, 0 );
+  CountTask task( count );
+  EXPECT_EQ( SPLINE_SUCCESS,             pool.parallel_for( 5, 5, task ) );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_INDEX, pool.parallel_for( 6, 5, task ) );
+  EXPECT_EQ( 0, count[5] );
+}
+
+
+TEST(SplineThreadPoolTest, exception_and_nested_call ) {
+  SplineThreadPool pool( 4 );
+  const std::size_t size = 1000;
+
+  // thrown on the calling thread or a worker, the pool stays usable
+  const std::size_t throw_indices[] = { 0, 500, 999 };
+  for( std::size_t k=0; k < 3; k++ ) {
+    ThrowTask throw_task( throw_indices[k] );
+    EXPECT_THROW( pool.parallel_for( 0, size, throw_task, 1 ), std::runtime_error );
+    std::vector<int> count( size, 0 );
+    CountTask task( count );
+    EXPECT_EQ( SPLINE_SUCCESS, pool.parallel_for( 0, size, task, 1 ) );
+    for( std::size_t i=0; i < size; i++ ) {
+      ASSERT_EQ( 1, count[i] ) << "index = " << i;
+    }
+  }
+  // not shared: thrown as it is
+  ThrowTask throw_task( 0 );
+  EXPECT_THROW( pool.parallel_for( 0, size, throw_task, size ), std::invalid_argument );
+
+  // nested calls run serially instead of deadlocking
+  std::vector<int> count( 50, 0 );
+  NestedTask nested_task( pool, count );
+  EXPECT_EQ( SPLINE_SUCCESS, pool.parallel_for( 0, count.size(), nested_task, 1 ) );
+  for( std::size_t i=0; i < count.size(); i++ ) {
+    ASSERT_EQ( 100, count[i] ) << "index = " << i;
+  }
+}
+
+
+TEST(SplineThreadPoolTest, cubic_parallel_same_as_serial ) {
+  const TPVAQueue target_tpva_queue = make_sine_tpva_queue( 1001, 1.0, true );
+
+  CubicSplineInterpolator serial;
+  EXPECT_EQ( SPLINE_SUCCESS, serial.generate_path( target_tpva_queue ) );
+
+  SplineThreadPool pool( 3 );
+  CubicSplineInterpolator parallel;
+  parallel.set_thread_pool( &pool, 16 );
+  EXPECT_EQ( &pool, parallel.thread_pool() );
+  EXPECT_EQ( SPLINE_SUCCESS, parallel.generate_path( target_tpva_queue ) );
+
+  for( double t=0.0; t <= 1000.0; t+=0.37 ) {
+    const TimePVA serial_tpva   = serial.pop( t );
+    const TimePVA parallel_tpva = parallel.pop( t );
+    ASSERT_EQ( serial_tpva.P.pos, parallel_tpva.P.pos );
+    ASSERT_EQ( serial_tpva.P.vel, parallel_tpva.P.vel );
+    ASSERT_EQ( serial_tpva.P.acc, parallel_tpva.P.acc );
+  }
+  // Hermite segment passes through the target points
+  for( std::size_t i=0; i <= 1000; i++ ) {
+    const TimePVA& target = target_tpva_queue.at( i );
+    EXPECT_NEAR( target.P.pos, parallel.pop( target.time ).P.pos, 1.0e-9 );
+    EXPECT_NEAR( target.P.vel, parallel.pop( target.time ).P.vel, 1.0e-9 );
+  }
+}
+
+
+TEST(SplineThreadPoolTest, trapezoid_parallel_same_as_serial ) {
+  const std::size_t segment_num = 300;
+  const TPVAQueue target_tpva_queue = make_sine_tpva_queue( segment_num + 1 );
+  const TrapezoidConfigQueue trapzd_config_que = make_trapezoid_config_queue( segment_num );
+
+  TrapezoidalInterpolator serial( trapzd_config_que );
+  EXPECT_EQ( SPLINE_SUCCESS, serial.generate_path( target_tpva_queue ) );
+
+  SplineThreadPool pool( 4 );
+  TrapezoidalInterpolator parallel( trapzd_config_que );
+  parallel.set_thread_pool( &pool );
+  EXPECT_EQ( SPLINE_SUCCESS, parallel.generate_path( target_tpva_queue ) );
+
+  for( double t=0.0; t <= segment_num; t+=0.13 ) {
+    const TimePVA serial_tpva   = serial.pop( t );
+    const TimePVA parallel_tpva = parallel.pop( t );
+    ASSERT_EQ( serial_tpva.P.pos, parallel_tpva.P.pos );
+    ASSERT_EQ( serial_tpva.P.vel, parallel_tpva.P.vel );
+    ASSERT_EQ( serial_tpva.P.acc, parallel_tpva.P.acc );
+  }
+
+  // failure is reported by RetCode & segment_status in parallel
+  TPVAQueue failed_tpva_queue;
+  for( std::size_t i=0; i <= segment_num; i++ ) {
+    const double pos = ( i == 201 ) ? 1.0e4 : sine_position( i );
+    failed_tpva_queue.push_on_clocktime( (double)i, PosVelAcc( pos, 0.0, 0.0 ) );
+  }
+  EXPECT_EQ( SPLINE_FAIL_TO_GENERATE_PATH, parallel.generate_path( failed_tpva_queue ) );
+  EXPECT_EQ( SPLINE_SUCCESS,               parallel.segment_status( 199 ) );
+  EXPECT_EQ( SPLINE_FAIL_TO_GENERATE_PATH, parallel.segment_status( 200 ) );
+  EXPECT_EQ( SPLINE_FAIL_TO_GENERATE_PATH, parallel.segment_status( 201 ) );
+  std::size_t failed_index = 0;
+  EXPECT_EQ( SPLINE_FAIL_TO_GENERATE_PATH, parallel.generation_status( failed_index ) );
+  EXPECT_EQ( 200, failed_index );
+}
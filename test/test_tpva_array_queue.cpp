@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "tpva_array_queue.hpp"
+#include "cubic_spline_interpolator.hpp"
+
+#include <math.h>
+
+using namespace interp;
+
+/// the number of axes
+#define ARRAY_AXIS_NUM 6
+
+/// make PVAArray of 6 axes at the index
+static PVAArray<ARRAY_AXIS_NUM> make_pva_array( const std::size_t& index ) {
+  PVAArray<ARRAY_AXIS_NUM> pva_array;
+  for( std::size_t k=0; k < ARRAY_AXIS_NUM; k++ ) {
+    pva_array[k] = PosVelAcc( sin( 0.3 * index + k ),
+                              cos( 0.3 * index + k ),
+                              0.1 * k );
+  }
+  return pva_array;
+}
+
+
+TEST(TPVAArrayQueueTest, push_pop ) {
+  TPVAArrayQueue<ARRAY_AXIS_NUM> queue;
+  EXPECT_EQ( ARRAY_AXIS_NUM, queue.axis_size() );
+  EXPECT_EQ( 0, queue.size() );
+  EXPECT_THROW( queue.pop(), QueueSizeEmpty );
+  EXPECT_THROW( queue.front(), InvalidIndexAccess );
+
+  for( std::size_t i=0; i < 100; i++ ) {
+    EXPECT_EQ( SPLINE_SUCCESS, queue.push( 0.5 * i, make_pva_array( i ) ) );
+  }
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, queue.push( 49.5, make_pva_array( 0 ) ) );
+  EXPECT_EQ( SPLINE_SUCCESS, queue.push_on_dT( 0.5, make_pva_array( 100 ) ) );
+  EXPECT_EQ( 101, queue.size() );
+  EXPECT_DOUBLE_EQ( 50.0, queue.total_dT() );
+  EXPECT_DOUBLE_EQ( 0.5,  queue.dT( 99 ) );
+  EXPECT_THROW( queue.dT( 100 ), InvalidIndexAccess );
+  EXPECT_THROW( queue.get( 101 ), InvalidIndexAccess );
+
+  // copy
+  const TPVAArrayQueue<ARRAY_AXIS_NUM> copied_queue( queue );
+
+  // FIFO pop over the compaction of buffer
+  for( std::size_t i=0; i < 80; i++ ) {
+    const TimeVal< PVAArray<ARRAY_AXIS_NUM> > tpva_array = queue.pop();
+    EXPECT_EQ( 0.5 * i, tpva_array.time );
+    for( std::size_t k=0; k < ARRAY_AXIS_NUM; k++ ) {
+      EXPECT_EQ( make_pva_array( i )[k].pos, tpva_array.P[k].pos );
+      EXPECT_EQ( make_pva_array( i )[k].vel, tpva_array.P[k].vel );
+    }
+    EXPECT_EQ( 100 - i, queue.size() );
+  }
+  EXPECT_EQ( 40.0, queue.front().time );
+  EXPECT_EQ( 50.0, queue.back().time );
+  EXPECT_DOUBLE_EQ( 10.0, queue.total_dT() );
+  EXPECT_EQ( make_pva_array( 85 )[3].pos, queue.get( 5 ).value[3].pos );
+  EXPECT_EQ( make_pva_array( 85 )[3].vel, queue.data( 5 )[3*3 + 1] );
+
+  EXPECT_EQ( 50.0, queue.pop_back().time );
+  EXPECT_EQ( 49.5, queue.back().time );
+
+  // set
+  TimeVal< PVAArray<ARRAY_AXIS_NUM> > newval( 41.2, make_pva_array( 7 ) );
+  EXPECT_EQ( SPLINE_SUCCESS,             queue.set( 2, newval ) );
+  EXPECT_EQ( make_pva_array( 7 )[5].acc, queue.get( 2 ).value[5].acc );
+  newval.time = 40.0;
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME,  queue.set( 2, newval ) );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_INDEX, queue.set( 20, newval ) );
+
+  // the copy is not changed
+  EXPECT_EQ( 101, copied_queue.size() );
+  EXPECT_EQ( 0.0, copied_queue.front().time );
+  EXPECT_EQ( make_pva_array( 42 )[1].pos, copied_queue.get( 42 ).value[1].pos );
+
+  queue.clear();
+  EXPECT_EQ( 0, queue.size() );
+  EXPECT_EQ( 0.0, queue.total_dT() );
+}
+
+
+TEST(TPVAArrayQueueTest, list_queue_compatibility ) {
+  TPVAListQueue list_queue;
+  TPVAArrayQueue<ARRAY_AXIS_NUM> array_queue;
+  for( std::size_t i=0; i < 50; i++ ) {
+    list_queue.push( 0.1 * ( i + 1 ), make_pva_array( i ).to_list() );
+    array_queue.push( 0.1 * ( i + 1 ), make_pva_array( i ) );
+  }
+
+  std::string list_dump, array_dump;
+  list_queue.dump( list_dump );
+  array_queue.dump( array_dump );
+  EXPECT_EQ( list_dump, array_dump );
+
+  TPVAArrayQueue<ARRAY_AXIS_NUM> assigned_queue;
+  EXPECT_EQ( SPLINE_SUCCESS, assigned_queue.assign( list_queue ) );
+  assigned_queue.dump( array_dump );
+  EXPECT_EQ( list_dump, array_dump );
+
+  TPVAListQueue converted_queue;
+  array_queue.to_list_queue( converted_queue );
+  converted_queue.dump( list_dump );
+  EXPECT_EQ( list_dump, array_dump );
+
+  TPVAArrayQueue<3> invalid_queue;
+  EXPECT_EQ( SPLINE_INVALID_QUEUE_SIZE, invalid_queue.assign( list_queue ) );
+  EXPECT_THROW( PVAArray<3>( make_pva_array( 0 ).to_list() ), InvalidArgumentSize );
+}
+
+
+TEST(TPVAArrayQueueTest, axis_queue_generate_path ) {
+  TPVAArrayQueue<ARRAY_AXIS_NUM> array_queue;
+  for( std::size_t i=0; i < 50; i++ ) {
+    array_queue.push( (double)i, make_pva_array( i ) );
+  }
+
+  TPVAQueue axis_queue;
+  EXPECT_EQ( SPLINE_INVALID_INPUT_INDEX, array_queue.axis_queue( ARRAY_AXIS_NUM, axis_queue ) );
+  for( std::size_t k=0; k < ARRAY_AXIS_NUM; k++ ) {
+    EXPECT_EQ( SPLINE_SUCCESS, array_queue.axis_queue( k, axis_queue ) );
+    ASSERT_EQ( array_queue.size(), axis_queue.size() );
+
+    CubicSplineInterpolator interpolator;
+    EXPECT_EQ( SPLINE_SUCCESS, interpolator.generate_path( axis_queue ) );
+    for( std::size_t i=0; i < array_queue.size(); i++ ) {
+      EXPECT_NEAR( array_queue.get( i ).value[k].pos,
+                   interpolator.pop( (double)i ).P.pos, 1.0e-9 );
+    }
+  }
+}
@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+#include "trajectory.hpp"
+#include "fixed_spline.hpp"
+#include "trapezoid_5251525_profile.hpp"
+
+#include <math.h>
+#include <vector>
+
+using namespace interp;
+
+/// trajectory of constant velocity counting live copies
+class CountedTrajectory : public TrajectoryBase<CountedTrajectory> {
+public:
+  /// the number of live objects
+  static int live_num;
+
+  /// Constructor
+  /// @param[in] velocity velocity
+  explicit CountedTrajectory( const double& velocity ) :
+    velocity_(velocity) {
+    live_num++;
+  }
+
+  /// Copy Constructor
+  CountedTrajectory( const CountedTrajectory& src ) :
+    TrajectoryBase<CountedTrajectory>(),
+    velocity_(src.velocity_) {
+    live_num++;
+  }
+
+  /// Destructor
+  ~CountedTrajectory() {
+    live_num--;
+  }
+
+  /// x(t) = velocity * t in [0, 1]
+  RetCode evaluate( const double& t, double& pos, double& vel, double& acc ) const {
+    return evaluate<OUTPUT_PVA>( t, pos, vel, acc );
+  }
+
+  /// x(t) = velocity * t in [0, 1] (only the outputs of Mask)
+  template<unsigned int Mask>
+  RetCode evaluate( const double& t, double& pos, double& vel, double& acc ) const {
+    if( t < 0.0 || t > 1.0 ) {
+      return SPLINE_INVALID_INPUT_TIME;
+    }
+    if( Mask & OUTPUT_POS ) {
+      pos = velocity_ * t;
+    }
+    if( Mask & OUTPUT_VEL ) {
+      vel = velocity_;
+    }
+    if( Mask & OUTPUT_ACC ) {
+      acc = 0.0;
+    }
+    return SPLINE_SUCCESS;
+  }
+
+  /// start time
+  double start_time() const { return 0.0; }
+
+  /// finish time
+  double finish_time() const { return 1.0; }
+
+private:
+  /// velocity
+  double velocity_;
+};
+
+int CountedTrajectory::live_num = 0;
+
+
+TEST(TrajectoryTest, static_dispatch ) {
+  const double times[4]     = { 0.0, 1.0, 2.0, 3.0 };
+  const double positions[4] = { 0.0, 1.0, 0.5, 2.0 };
+  FixedCubicSpline<4> spline;
+  ASSERT_EQ( SPLINE_SUCCESS, spline.generate_path( times, positions ) );
+
+  double pos[31] = {}, vel[31] = {}, acc[31] = {};
+  ASSERT_EQ( SPLINE_SUCCESS, spline.sample( 0.0, 0.1, 31, pos, vel, acc ) );
+  for( std::size_t i=0; i < 31; i++ ) {
+    const TimePVA expected = spline.pop( 0.1 * i );
+    EXPECT_EQ( expected.P.pos, pos[i] );
+    EXPECT_EQ( expected.P.vel, vel[i] );
+    EXPECT_EQ( expected.P.acc, acc[i] );
+  }
+  // the samples after the finish time are not written
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, spline.sample( 2.0, 0.5, 4, pos, vel, acc ) );
+
+  Trapezoid5251525Profile profile( 1200, 1200, 170, 0.8, 0.8, 0.5 );
+  ASSERT_EQ( SPLINE_SUCCESS, profile.generate_path( 1.0, 0.0, 0.0, 10.0 ) );
+  EXPECT_EQ( 1.0, profile.start_time() );
+  EXPECT_EQ( 10.0, profile.pop( profile.finish_time() ).P.pos );
+  EXPECT_THROW( profile.pop( 0.5 ), TimeOutOfRange );
+}
+
+
+TEST(TrajectoryTest, type_erased_value ) {
+  Trajectory empty_trajectory;
+  double pos = 0.0, vel = 0.0, acc = 0.0;
+  EXPECT_TRUE( empty_trajectory.empty() );
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, empty_trajectory.evaluate( 0.0, pos, vel, acc ) );
+  EXPECT_THROW( empty_trajectory.pop( 0.0 ), NotSplineGenerated );
+  EXPECT_EQ( 0.0, empty_trajectory.finish_time() );
+
+  const double times[4]     = { 0.0, 1.0, 2.0, 3.0 };
+  const double positions[4] = { 0.0, 1.0, 0.5, 2.0 };
+  FixedCubicSpline<4> spline;
+  ASSERT_EQ( SPLINE_SUCCESS, spline.generate_path( times, positions ) );
+  Trapezoid5251525Profile profile( 1200, 1200, 170, 0.8, 0.8, 0.5 );
+  ASSERT_EQ( SPLINE_SUCCESS, profile.generate_path( 0.0, 3.0, 0.0, 10.0 ) );
+
+  // axes of mixed trajectories
+  std::vector<Trajectory> axes;
+  axes.push_back( Trajectory( spline ) );
+  axes.push_back( Trajectory( profile ) );
+  axes.push_back( axes[0] );
+  ASSERT_FALSE( axes[0].empty() );
+  EXPECT_EQ( 3.0, axes[1].finish_time() );
+  for( double t=0.0; t <= 3.0; t+=0.05 ) {
+    ASSERT_EQ( SPLINE_SUCCESS, axes[0].evaluate( t, pos, vel, acc ) );
+    EXPECT_EQ( spline.pop( t ).P.pos, pos );
+    ASSERT_EQ( SPLINE_SUCCESS, axes[1].evaluate( t, pos, vel, acc ) );
+    EXPECT_EQ( profile.pop( t ).P.vel, vel );
+    EXPECT_EQ( spline.pop( t ).P.acc, axes[2].pop( t ).P.acc );
+  }
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, axes[0].evaluate( 3.5, pos, vel, acc ) );
+  EXPECT_THROW( axes[1].pop( 3.5 ), TimeOutOfRange );
+
+  // reassignment to the other type
+  axes[0] = axes[1];
+  EXPECT_EQ( profile.pop( 1.0 ).P.pos, axes[0].pop( 1.0 ).P.pos );
+  axes[2].assign( profile );
+  EXPECT_EQ( profile.pop( 2.0 ).P.pos, axes[2].pop( 2.0 ).P.pos );
+
+  // larger buffer
+  FixedTrapezoid<2> trapezoid( 1200, 1200, 170, 0.8, 0.8, 0.5 );
+  const double trapezoid_times[2]     = { 0.0, 1.0 };
+  const double trapezoid_positions[2] = { 0.0, 1.0 };
+  ASSERT_EQ( SPLINE_SUCCESS, trapezoid.generate_path( trapezoid_times, trapezoid_positions ) );
+  BasicTrajectory<1024> large_trajectory( trapezoid );
+  EXPECT_EQ( trapezoid.pop( 0.3 ).P.pos, large_trajectory.pop( 0.3 ).P.pos );
+}
+
+
+TEST(TrajectoryTest, lifetime_of_held_object ) {
+  EXPECT_EQ( 0, CountedTrajectory::live_num );
+  {
+    const CountedTrajectory counted( 2.0 );
+    Trajectory trajectory( counted );
+    EXPECT_EQ( 2, CountedTrajectory::live_num );
+    Trajectory copied( trajectory );
+    EXPECT_EQ( 3, CountedTrajectory::live_num );
+    EXPECT_EQ( 1.0, copied.pop( 0.5 ).P.pos );
+    copied = trajectory;
+    EXPECT_EQ( 3, CountedTrajectory::live_num );
+    copied = copied;
+    EXPECT_EQ( 3, CountedTrajectory::live_num );
+    copied.reset();
+    EXPECT_TRUE( copied.empty() );
+    EXPECT_EQ( 2, CountedTrajectory::live_num );
+    trajectory = copied;
+    EXPECT_EQ( 1, CountedTrajectory::live_num );
+    trajectory.assign( counted );
+  }
+  EXPECT_EQ( 0, CountedTrajectory::live_num );
+}
+
+
+TEST(TrajectoryTest, output_mask ) {
+  const double times[4]     = { 0.0, 1.0, 2.0, 3.0 };
+  const double positions[4] = { 0.0, 1.0, 0.5, 2.0 };
+  FixedCubicSpline<4> spline;
+  ASSERT_EQ( SPLINE_SUCCESS, spline.generate_path( times, positions ) );
+  Trapezoid5251525Profile profile( 1200, 1200, 170, 0.8, 0.8, 0.5 );
+  ASSERT_EQ( SPLINE_SUCCESS, profile.generate_path( 0.0, 3.0, 0.0, 10.0 ) );
+  std::vector<Trajectory> axes;
+  axes.push_back( Trajectory( spline ) );
+  axes.push_back( Trajectory( profile ) );
+  axes.push_back( Trajectory( CountedTrajectory( 2.0 ) ) );
+  for( std::size_t axis=0; axis < axes.size(); axis++ ) {
+    const std::size_t size = ( axis == 2 ) ? 11 : 31;
+    double pos[31] = {}, vel[31] = {}, acc[31] = {};
+    ASSERT_EQ( SPLINE_SUCCESS, axes[axis].sample( 0.0, 0.1, size, pos, vel, acc ) );
+    // position only, without the arrays of velocity and acceleration
+    double pos_only[31] = {};
+    ASSERT_EQ( SPLINE_SUCCESS,
+               axes[axis].sample<OUTPUT_POS>( 0.0, 0.1, size, pos_only, NULL, NULL ) );
+    // unselected outputs are not written
+    double vel_only[31] = {}, untouched[31] = {};
+    ASSERT_EQ( SPLINE_SUCCESS,
+               axes[axis].sample<OUTPUT_VEL>( 0.0, 0.1, size, untouched, vel_only, NULL ) );
+    for( std::size_t i=0; i < size; i++ ) {
+      EXPECT_EQ( pos[i], pos_only[i] );
+      EXPECT_EQ( vel[i], vel_only[i] );
+      EXPECT_EQ( 0.0, untouched[i] );
+    }
+  }
+
+  // static dispatch
+  double pos = 0.0, vel = -1.0, acc = -1.0;
+  ASSERT_EQ( SPLINE_SUCCESS, spline.evaluate<OUTPUT_POS>( 1.5, pos, vel, acc ) );
+  EXPECT_EQ( spline.pop( 1.5 ).P.pos, pos );
+  EXPECT_EQ( -1.0, vel );
+  EXPECT_EQ( -1.0, acc );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, spline.evaluate<OUTPUT_POS>( 3.5, pos, vel, acc ) );
+  Trajectory empty_trajectory;
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED,
+             empty_trajectory.evaluate<OUTPUT_POS>( 0.0, pos, vel, acc ) );
+
+  FixedTrapezoid<4> trapezoid( 1200, 1200, 170, 0.8, 0.8, 0.5 );
+  ASSERT_EQ( SPLINE_SUCCESS, trapezoid.generate_path( times, positions ) );
+  double trapezoid_pos[31] = {};
+  ASSERT_EQ( SPLINE_SUCCESS,
+             trapezoid.sample<OUTPUT_POS>( 0.0, 0.1, 31, trapezoid_pos, NULL, NULL ) );
+  for( std::size_t i=0; i < 31; i++ ) {
+    EXPECT_EQ( trapezoid.pop( 0.1 * i ).P.pos, trapezoid_pos[i] );
+  }
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include "trajectory_baker.hpp"
+#include "waypoint_loader.hpp"
+#include "spline_thread_pool.hpp"
+#include "cubic_spline_interpolator.hpp"
+
+#include <math.h>
+#include <cstdio>
+
+using namespace interp;
+
+/// waypoint file of tests
+#define BAKER_WAYPOINT_FILE "test/data/teaching_points_5p.csv"
+
+/// destination directory of baked files
+#define BAKER_DIR "./images/"
+
+
+TEST(TrajectoryBakerTest, output_path ) {
+  BakeConfig config;
+  config.output_dir = "out";
+  EXPECT_EQ( "out/teaching_points_5p.csv",
+             TrajectoryBaker( config ).output_path( BAKER_WAYPOINT_FILE ) );
+  config.output_dir = "out/";
+  config.format     = EXPORT_BINARY;
+  EXPECT_EQ( "out/program.1.bin", TrajectoryBaker( config ).output_path( "program.1.txt" ) );
+  EXPECT_EQ( "out/.hidden.bin",   TrajectoryBaker( config ).output_path( "dir/.hidden" ) );
+}
+
+
+TEST(TrajectoryBakerTest, bake_cubic_same_as_interpolator ) {
+  BakeConfig config;
+  config.cycle             = 0.01;
+  config.waypoint_interval = 0.5;
+  config.position_columns.push_back( 0 );
+  config.position_columns.push_back( 7 );
+  config.output_dir        = BAKER_DIR;
+  const TrajectoryBaker baker( config );
+
+  BakeResult result;
+  ASSERT_EQ( SPLINE_SUCCESS, baker.bake( BAKER_WAYPOINT_FILE, result ) );
+  EXPECT_EQ( 5,   result.waypoint_size );
+  EXPECT_EQ( 2,   result.axis_size );
+  EXPECT_EQ( 201, result.sample_size );
+  EXPECT_LE( 0.0, result.total_sec() );
+
+  WaypointLoader loader;
+  ASSERT_EQ( SPLINE_SUCCESS, loader.load_file( BAKER_WAYPOINT_FILE ) );
+  WaypointLoader baked;
+  ASSERT_EQ( SPLINE_SUCCESS, baked.load_file( result.output_path ) );
+  ASSERT_EQ( result.sample_size, baked.row_size() );
+  ASSERT_EQ( 1 + 3 * 2, baked.column_size() );
+
+  for( std::size_t k=0; k < 2; k++ ) {
+    TPQueue tp_queue;
+    for( std::size_t i=0; i < loader.row_size(); i++ ) {
+      tp_queue.push( TimePosition( 0.5 * i, loader.value( i, config.position_columns[k] ) ) );
+    }
+    CubicSplineInterpolator interpolator;
+    ASSERT_EQ( SPLINE_SUCCESS, interpolator.generate_path( tp_queue ) );
+    for( std::size_t i=0; i < baked.row_size(); i++ ) {
+      const TimePVA tpva = interpolator.pop( 0.01 * i );
+      EXPECT_EQ( tpva.time,  baked.value( i, 0 ) );
+      EXPECT_EQ( tpva.P.pos, baked.value( i, 1 + 3 * k ) );
+      EXPECT_EQ( tpva.P.vel, baked.value( i, 2 + 3 * k ) );
+      EXPECT_EQ( tpva.P.acc, baked.value( i, 3 + 3 * k ) );
+    }
+  }
+  std::remove( result.output_path.c_str() );
+}
+
+
+TEST(TrajectoryBakerTest, bake_trapezoid_files_in_parallel ) {
+  // copies of the waypoint file under other names
+  WaypointLoader loader;
+  ASSERT_EQ( SPLINE_SUCCESS, loader.load_file( BAKER_WAYPOINT_FILE ) );
+  std::vector<std::string> input_paths;
+  for( std::size_t n=0; n < 6; n++ ) {
+    char path[64];
+    std::snprintf( path, sizeof(path), BAKER_DIR "baker_input_%lu.csv", (unsigned long)n );
+    FILE* fp = std::fopen( path, "w" );
+    ASSERT_TRUE( fp != NULL );
+    for( std::size_t i=0; i < loader.row_size(); i++ ) {
+      // scale the position to make files different
+      std::fprintf( fp, "%.17g,%.17g\n",
+                    loader.value( i, 0 ) * ( n + 1 ), loader.value( i, 1 ) * ( n + 1 ) );
+    }
+    std::fclose( fp );
+    input_paths.push_back( path );
+  }
+  input_paths.push_back( BAKER_DIR "not_exist.csv" );
+
+  BakeConfig config;
+  config.interpolator      = BAKE_TRAPEZOID;
+  config.trapezoid         = TrapezoidConfig( 30, 30, 2, 0.0, 0.0, 1.0 );
+  config.waypoint_interval = 1.0;
+  config.format            = EXPORT_BINARY;
+  config.output_dir        = BAKER_DIR;
+  const TrajectoryBaker baker( config );
+
+  std::vector<BakeResult> serial_results;
+  std::vector<BakeResult> parallel_results;
+  SplineThreadPool thread_pool( 4 );
+  EXPECT_EQ( SPLINE_FAIL_TO_GENERATE_PATH, baker.bake( input_paths, serial_results ) );
+  std::vector<std::string> serial_outputs;
+  for( std::size_t n=0; n < input_paths.size() - 1; n++ ) {
+    ASSERT_EQ( SPLINE_SUCCESS, serial_results[n].status ) << serial_results[n].message;
+    EXPECT_EQ( 4001, serial_results[n].sample_size );
+    FILE* fp = std::fopen( serial_results[n].output_path.c_str(), "rb" );
+    ASSERT_TRUE( fp != NULL );
+    std::vector<double> rows( serial_results[n].sample_size * 7 );
+    ASSERT_EQ( rows.size(), std::fread( &rows[0], sizeof(double), rows.size(), fp ) );
+    std::fclose( fp );
+    // the last sample is the last waypoint
+    EXPECT_NEAR( loader.value( 4, 0 ) * ( n + 1 ), rows[rows.size() - 7 + 1], 1.0e-9 );
+    EXPECT_NEAR( loader.value( 4, 1 ) * ( n + 1 ), rows[rows.size() - 7 + 4], 1.0e-9 );
+    serial_outputs.push_back( std::string( (const char*)&rows[0], rows.size() * sizeof(double) ) );
+  }
+  EXPECT_EQ( SPLINE_FILE_IO_ERROR, serial_results.back().status );
+
+  EXPECT_EQ( SPLINE_FAIL_TO_GENERATE_PATH,
+             baker.bake( input_paths, parallel_results, &thread_pool ) );
+  ASSERT_EQ( input_paths.size(), parallel_results.size() );
+  for( std::size_t n=0; n < input_paths.size() - 1; n++ ) {
+    ASSERT_EQ( SPLINE_SUCCESS, parallel_results[n].status );
+    EXPECT_EQ( input_paths[n], parallel_results[n].input_path );
+    std::string data( serial_outputs[n].size(), '\0' );
+    FILE* fp = std::fopen( parallel_results[n].output_path.c_str(), "rb" );
+    ASSERT_TRUE( fp != NULL );
+    EXPECT_EQ( data.size(), std::fread( &data[0], 1, data.size(), fp ) );
+    std::fclose( fp );
+    EXPECT_EQ( serial_outputs[n], data );
+    std::remove( parallel_results[n].output_path.c_str() );
+    std::remove( input_paths[n].c_str() );
+  }
+  EXPECT_EQ( SPLINE_FILE_IO_ERROR, parallel_results.back().status );
+}
+
+
+TEST(TrajectoryBakerTest, duplicate_output_paths ) {
+  // the same basename in other directories is the same output file
+  std::vector<std::string> input_paths;
+  input_paths.push_back( BAKER_WAYPOINT_FILE );
+  input_paths.push_back( BAKER_DIR "teaching_points_5p.csv" );
+  input_paths.push_back( "test/teaching_points_5p.txt" );
+
+  BakeConfig config;
+  config.waypoint_interval = 1.0;
+  config.output_dir        = BAKER_DIR;
+  const TrajectoryBaker baker( config );
+  SplineThreadPool thread_pool( 4 );
+  std::vector<BakeResult> results;
+  EXPECT_EQ( SPLINE_FAIL_TO_GENERATE_PATH, baker.bake( input_paths, results, &thread_pool ) );
+  ASSERT_EQ( input_paths.size(), results.size() );
+  EXPECT_EQ( SPLINE_SUCCESS, results[0].status ) << results[0].message;
+  EXPECT_LT( 0u, results[0].sample_size );
+  for( std::size_t n=1; n < results.size(); n++ ) {
+    EXPECT_EQ( SPLINE_FILE_IO_ERROR, results[n].status );
+    EXPECT_EQ( input_paths[n], results[n].input_path );
+    EXPECT_EQ( results[0].output_path, results[n].output_path );
+    EXPECT_NE( std::string::npos, results[n].message.find( BAKER_WAYPOINT_FILE ) );
+    EXPECT_EQ( 0u, results[n].sample_size );
+  }
+  std::remove( results[0].output_path.c_str() );
+}
+
+
+TEST(TrajectoryBakerTest, errors ) {
+  BakeConfig config;
+  config.output_dir = BAKER_DIR;
+  config.cycle      = 0.0;
+  BakeResult result;
+  EXPECT_EQ( SPLINE_INVALID_INPUT_INTERVAL_TIME_DT,
+             TrajectoryBaker( config ).bake( BAKER_WAYPOINT_FILE, result ) );
+
+  // x column is not strictly increasing as time
+  config.cycle       = 0.001;
+  config.time_column = 0;
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME,
+             TrajectoryBaker( config ).bake( BAKER_WAYPOINT_FILE, result ) );
+  EXPECT_FALSE( result.message.empty() );
+
+  config.time_column = 13;
+  EXPECT_EQ( SPLINE_INVALID_INPUT_INDEX,
+             TrajectoryBaker( config ).bake( BAKER_WAYPOINT_FILE, result ) );
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include "trajectory_bank.hpp"
+#include "spline_thread_pool.hpp"
+#include "test/util/test_trajectories.hpp"
+
+#include <math.h>
+#include <vector>
+
+using namespace interp;
+
+/// control cycle [s]
+#define BANK_CYCLE 0.01
+
+/// tolerance against pop() (expansion in the power form)
+#define BANK_TOLERANCE 1.0e-9
+
+
+TEST(TrajectoryBankTest, same_as_pop ) {
+  std::vector<CubicSplineInterpolator> splines( 8 );
+  TrapezoidalInterpolator trapezoidal;
+  make_trapezoidal_segments( trapezoidal );
+  Trapezoid5251525 trapezoid( 1200, 1200, 170, 0.8, 0.8, 0.5 );
+  trapezoid.generate_path( 0.5, 0.0, 0.0, 50.0, 0.0, 0.0 );
+
+  TrajectoryBank bank;
+  bank.reserve( splines.size() + 2, 100 );
+  std::size_t index = 1000;
+  for( std::size_t axis=0; axis < splines.size(); axis++ ) {
+    make_cubic_spline( splines[axis], axis );
+    ASSERT_EQ( SPLINE_SUCCESS, bank.add( splines[axis], index ) );
+    EXPECT_EQ( axis, index );
+  }
+  ASSERT_EQ( SPLINE_SUCCESS, bank.add( trapezoidal, index ) );
+  ASSERT_EQ( SPLINE_SUCCESS, bank.add( trapezoid, index ) );
+  ASSERT_EQ( splines.size() + 2, bank.size() );
+  EXPECT_EQ( splines[0].finish_time(), bank.finish_time( 0 ) );
+  EXPECT_EQ( 0.5, bank.start_time( index ) );
+  EXPECT_EQ( trapezoid.t7(), bank.finish_time( index ) );
+
+  std::vector<double> pos( bank.size() ), vel( bank.size() ), acc( bank.size() );
+  for( double t=0.0; t <= 6.0; t+=BANK_CYCLE ) {
+    ASSERT_EQ( SPLINE_SUCCESS, bank.evaluate_all( t, &pos[0], &vel[0], &acc[0] ) );
+    for( std::size_t axis=0; axis < splines.size(); axis++ ) {
+      // hold the finish state after the finish time
+      const double tc = ( t < splines[axis].finish_time() ) ? t : splines[axis].finish_time();
+      const TimePVA expected = splines[axis].pop( tc );
+      ASSERT_NEAR( expected.P.pos, pos[axis], BANK_TOLERANCE );
+      ASSERT_NEAR( expected.P.vel, vel[axis], BANK_TOLERANCE );
+      ASSERT_NEAR( expected.P.acc, acc[axis], BANK_TOLERANCE );
+    }
+    const double tc = ( t < trapezoidal.finish_time() ) ? t : trapezoidal.finish_time();
+    const TimePVA expected = trapezoidal.pop( tc );
+    ASSERT_NEAR( expected.P.pos, pos[splines.size()], BANK_TOLERANCE );
+    ASSERT_NEAR( expected.P.vel, vel[splines.size()], 1.0e-6 );
+    ASSERT_NEAR( expected.P.acc, acc[splines.size()], 1.0e-3 );
+    if( t >= 0.5 && t <= trapezoid.t7() ) {
+      double x = 0.0, v = 0.0, a = 0.0;
+      trapezoid.pop( t, x, v, a );
+      ASSERT_NEAR( x, pos[index], BANK_TOLERANCE );
+      ASSERT_NEAR( v, vel[index], 1.0e-6 );
+      ASSERT_NEAR( a, acc[index], 1.0e-3 );
+    }
+  }
+  // hold the start state before the start time
+  ASSERT_EQ( SPLINE_SUCCESS, bank.evaluate_all<OUTPUT_POS>( 0.0, &pos[0], NULL, NULL ) );
+  EXPECT_EQ( 0.0, pos[index] );
+
+  // backward in time
+  ASSERT_EQ( SPLINE_SUCCESS, bank.evaluate_all<OUTPUT_POS_VEL>( 1.234, &pos[0], &vel[0], NULL ) );
+  EXPECT_NEAR( splines[3].pop( 1.234 ).P.pos, pos[3], BANK_TOLERANCE );
+  EXPECT_NEAR( trapezoidal.pop( 1.234 ).P.vel, vel[splines.size()], 1.0e-6 );
+  bank.reset_cursors();
+  ASSERT_EQ( SPLINE_SUCCESS, bank.evaluate_all<OUTPUT_POS>( 3.21, &pos[0], NULL, NULL ) );
+  EXPECT_NEAR( splines[5].pop( 3.21 ).P.pos, pos[5], BANK_TOLERANCE );
+}
+
+
+TEST(TrajectoryBankTest, time_scale ) {
+  CubicSplineInterpolator spline;
+  make_cubic_spline( spline );
+  TrapezoidalInterpolator trapezoidal;
+  make_trapezoidal_segments( trapezoidal );
+  // double speed from the anchor, half speed from the start
+  ASSERT_EQ( SPLINE_SUCCESS, spline.set_time_scale( 2.0, 1.0 ) );
+  ASSERT_EQ( SPLINE_SUCCESS, trapezoidal.set_time_scale( 0.5 ) );
+
+  TrajectoryBank bank;
+  std::size_t spline_index = 0, trapezoidal_index = 0;
+  ASSERT_EQ( SPLINE_SUCCESS, bank.add( spline, spline_index ) );
+  ASSERT_EQ( SPLINE_SUCCESS, bank.add( trapezoidal, trapezoidal_index ) );
+  EXPECT_NEAR( spline.start_time(), bank.start_time( spline_index ), 1.0e-12 );
+  EXPECT_NEAR( spline.finish_time(), bank.finish_time( spline_index ), 1.0e-12 );
+  EXPECT_NEAR( trapezoidal.finish_time(), bank.finish_time( trapezoidal_index ), 1.0e-12 );
+
+  std::vector<double> pos( bank.size() ), vel( bank.size() ), acc( bank.size() );
+  for( double t=0.0; t <= trapezoidal.finish_time(); t+=BANK_CYCLE ) {
+    ASSERT_EQ( SPLINE_SUCCESS, bank.evaluate_all( t, &pos[0], &vel[0], &acc[0] ) );
+    if( t >= spline.start_time() && t < spline.finish_time() ) {
+      const TimePVA expected = spline.pop( t );
+      ASSERT_NEAR( expected.P.pos, pos[spline_index], BANK_TOLERANCE );
+      ASSERT_NEAR( expected.P.vel, vel[spline_index], BANK_TOLERANCE );
+      ASSERT_NEAR( expected.P.acc, acc[spline_index], 1.0e-6 );
+    }
+    const TimePVA expected = trapezoidal.pop( t );
+    ASSERT_NEAR( expected.P.pos, pos[trapezoidal_index], BANK_TOLERANCE );
+    ASSERT_NEAR( expected.P.vel, vel[trapezoidal_index], 1.0e-6 );
+    ASSERT_NEAR( expected.P.acc, acc[trapezoidal_index], 1.0e-3 );
+  }
+}
+
+
+TEST(TrajectoryBankTest, parallel_same_as_serial ) {
+  const std::size_t axis_num = 1000;
+  std::vector<CubicSplineInterpolator> splines( axis_num );
+  TrajectoryBank serial_bank;
+  for( std::size_t axis=0; axis < axis_num; axis++ ) {
+    make_cubic_spline( splines[axis], axis );
+    std::size_t index = 0;
+    ASSERT_EQ( SPLINE_SUCCESS, serial_bank.add( splines[axis], index ) );
+  }
+  TrajectoryBank parallel_bank( serial_bank );
+  SplineThreadPool thread_pool( 4 );
+  parallel_bank.set_thread_pool( &thread_pool, 64 );
+  EXPECT_EQ( &thread_pool, parallel_bank.thread_pool() );
+
+  std::vector<double> pos( axis_num ), vel( axis_num ), acc( axis_num );
+  std::vector<double> parallel_pos( axis_num ), parallel_vel( axis_num ), parallel_acc( axis_num );
+  for( double t=0.0; t <= 5.0; t+=0.05 ) {
+    ASSERT_EQ( SPLINE_SUCCESS, serial_bank.evaluate_all( t, &pos[0], &vel[0], &acc[0] ) );
+    ASSERT_EQ( SPLINE_SUCCESS, parallel_bank.evaluate_all( t, &parallel_pos[0],
+                                                           &parallel_vel[0], &parallel_acc[0] ) );
+    for( std::size_t axis=0; axis < axis_num; axis++ ) {
+      ASSERT_EQ( pos[axis], parallel_pos[axis] );
+      ASSERT_EQ( vel[axis], parallel_vel[axis] );
+      ASSERT_EQ( acc[axis], parallel_acc[axis] );
+    }
+  }
+}
+
+
+TEST(TrajectoryBankTest, errors ) {
+  TrajectoryBank bank;
+  std::size_t index = 1000;
+  EXPECT_EQ( SPLINE_SUCCESS, bank.evaluate_all( 0.0, NULL, NULL, NULL ) );
+
+  CubicSplineInterpolator spline;
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, bank.add( spline, index ) );
+  Trapezoid5251525 trapezoid( 1200, 1200, 170, 0.8, 0.8, 0.5 );
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, bank.add( trapezoid, index ) );
+
+  std::vector<PolynomialPiece> pieces;
+  EXPECT_EQ( SPLINE_INVALID_QUEUE_SIZE, bank.add_pieces( pieces, 1.0, index ) );
+  pieces.push_back( PolynomialPiece( 0.0, 1.0, 2.0 ) );
+  pieces.push_back( PolynomialPiece( 0.0, 3.0 ) );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_INTERVAL_TIME_DT, bank.add_pieces( pieces, 1.0, index ) );
+  pieces[1].start_time = 1.0;
+  EXPECT_EQ( SPLINE_INVALID_INPUT_INTERVAL_TIME_DT, bank.add_pieces( pieces, 0.5, index ) );
+  EXPECT_EQ( 1000u, index );
+  EXPECT_EQ( 0u, bank.size() );
+
+  // x = 1 + 2t in [0, 1), x = 3 in [1, 2]
+  ASSERT_EQ( SPLINE_SUCCESS, bank.add_pieces( pieces, 2.0, index ) );
+  EXPECT_EQ( 0u, index );
+  EXPECT_EQ( 2u, bank.piece_num() );
+  double pos = 0.0, vel = 0.0, acc = -1.0;
+  ASSERT_EQ( SPLINE_SUCCESS, bank.evaluate_all<OUTPUT_POS_VEL>( 0.5, &pos, &vel, &acc ) );
+  EXPECT_EQ( 2.0, pos );
+  EXPECT_EQ( 2.0, vel );
+  EXPECT_EQ( -1.0, acc );
+  ASSERT_EQ( SPLINE_SUCCESS, bank.evaluate_all( 5.0, &pos, &vel, &acc ) );
+  EXPECT_EQ( 3.0, pos );
+  EXPECT_EQ( 0.0, vel );
+
+  bank.clear();
+  EXPECT_EQ( 0u, bank.size() );
+  EXPECT_EQ( 0u, bank.piece_num() );
+}
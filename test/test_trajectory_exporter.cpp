@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include "trajectory_exporter.hpp"
+#include "waypoint_loader.hpp"
+#include "cubic_spline_interpolator.hpp"
+#include "test/util/test_trajectories.hpp"
+
+#include <math.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+
+using namespace interp;
+
+/// the number of points
+#define EXPORTER_POINT_NUM 10007
+
+/// destination directory of exported files
+#define EXPORTER_DIR "./images/"
+
+/// read the whole file
+static std::string read_all( const std::string& path ) {
+  std::string text;
+  FILE* fp = std::fopen( path.c_str(), "rb" );
+  if( fp == NULL ) {
+    return text;
+  }
+  char chunk[4096];
+  std::size_t read_size;
+  while( ( read_size = std::fread( chunk, 1, sizeof(chunk), fp ) ) > 0 ) {
+    text.append( chunk, read_size );
+  }
+  std::fclose( fp );
+  return text;
+}
+
+
+TEST(TrajectoryExporterTest, format_double_shortest_round_trip ) {
+  char dest[TrajectoryExporter::FORMAT_SIZE];
+  EXPECT_EQ( 3, TrajectoryExporter::format_double( 0.1, dest ) );
+  EXPECT_STREQ( "0.1", dest );
+  TrajectoryExporter::format_double( -2.5e-30, dest );
+  EXPECT_STREQ( "-2.5e-30", dest );
+  TrajectoryExporter::format_double( 0.0, dest );
+  EXPECT_STREQ( "0", dest );
+
+  // 0.1 + 0.2 needs 17 digits
+  TrajectoryExporter::format_double( 0.1 + 0.2, dest );
+  EXPECT_STREQ( "0.30000000000000004", dest );
+
+  for( std::size_t i=1; i < 10000; i++ ) {
+    const double value = sin( 0.37 * i ) * pow( 10.0, (double)( i % 40 ) - 20.0 );
+    const std::size_t length = TrajectoryExporter::format_double( value, dest );
+    EXPECT_GT( TrajectoryExporter::FORMAT_SIZE, length );
+    EXPECT_EQ( value, std::strtod( dest, NULL ) );
+  }
+}
+
+
+TEST(TrajectoryExporterTest, csv_round_trip ) {
+  TPVAQueue tpva_queue;
+  for( std::size_t i=0; i < EXPORTER_POINT_NUM; i++ ) {
+    tpva_queue.push( 0.001 * ( i + 1 ),
+                     sin( 0.01 * i ) / 3.0, cos( 0.01 * i ) / 7.0, -sin( 0.01 * i ) );
+  }
+
+  // small buffer to flush many times, with / without the background writer
+  const std::string path            = EXPORTER_DIR "exporter_tpva.csv";
+  const std::string background_path = EXPORTER_DIR "exporter_tpva_background.csv";
+  TrajectoryExporter exporter;
+  EXPECT_EQ( SPLINE_SUCCESS, exporter.open( path, EXPORT_CSV, false,
+                                            TrajectoryExporter::MIN_BUFFER_SIZE ) );
+  EXPECT_EQ( SPLINE_SUCCESS, exporter.write( tpva_queue ) );
+  EXPECT_EQ( EXPORTER_POINT_NUM, exporter.row_size() );
+  EXPECT_EQ( SPLINE_SUCCESS, exporter.close() );
+  EXPECT_FALSE( exporter.is_open() );
+
+  EXPECT_EQ( SPLINE_SUCCESS, exporter.open( background_path, EXPORT_CSV, true,
+                                            TrajectoryExporter::MIN_BUFFER_SIZE ) );
+  EXPECT_EQ( SPLINE_SUCCESS, exporter.write( tpva_queue ) );
+  EXPECT_EQ( SPLINE_SUCCESS, exporter.close() );
+  EXPECT_EQ( read_all( path ), read_all( background_path ) );
+
+  // read back the same values
+  WaypointLoader loader;
+  ASSERT_EQ( SPLINE_SUCCESS, loader.load_file( background_path ) );
+  ASSERT_EQ( EXPORTER_POINT_NUM, loader.row_size() );
+  ASSERT_EQ( 4, loader.column_size() );
+  for( std::size_t i=0; i < EXPORTER_POINT_NUM; i++ ) {
+    EXPECT_EQ( tpva_queue.at(i).time,  loader.value( i, 0 ) );
+    EXPECT_EQ( tpva_queue.at(i).P.pos, loader.value( i, 1 ) );
+    EXPECT_EQ( tpva_queue.at(i).P.vel, loader.value( i, 2 ) );
+    EXPECT_EQ( tpva_queue.at(i).P.acc, loader.value( i, 3 ) );
+  }
+  std::remove( path.c_str() );
+  std::remove( background_path.c_str() );
+}
+
+
+TEST(TrajectoryExporterTest, binary_sampled ) {
+  const TPVAQueue target_queue = make_sine_tpva_queue( 20, 0.5 );
+  CubicSplineInterpolator interpolator;
+  ASSERT_EQ( SPLINE_SUCCESS, interpolator.generate_path( target_queue ) );
+
+  const double dT = 0.001;
+  const std::string path = EXPORTER_DIR "exporter_sampled.bin";
+  TrajectoryExporter exporter;
+  EXPECT_EQ( SPLINE_SUCCESS, exporter.open( path, EXPORT_BINARY, true, 10000 ) );
+  EXPECT_EQ( SPLINE_SUCCESS, exporter.write_sampled( interpolator, 0.0, 9.5, dT ) );
+  const std::size_t row_size = exporter.row_size();
+  EXPECT_EQ( 9501, row_size );
+  EXPECT_EQ( SPLINE_SUCCESS, exporter.close() );
+
+  const std::string data = read_all( path );
+  ASSERT_EQ( row_size * 4 * 8, data.size() );
+  for( std::size_t i=0; i < row_size; i++ ) {
+    double row[4];
+    for( std::size_t j=0; j < 4; j++ ) {
+      uint64_t bits = 0;
+      for( std::size_t b=0; b < 8; b++ ) {
+        bits |= (uint64_t)(unsigned char)data[( i * 4 + j ) * 8 + b] << ( 8 * b );
+      }
+      std::memcpy( &row[j], &bits, sizeof(bits) );
+    }
+    const TimePVA expected = interpolator.pop( dT * i );
+    EXPECT_EQ( expected.time,  row[0] );
+    EXPECT_EQ( expected.P.pos, row[1] );
+    EXPECT_EQ( expected.P.vel, row[2] );
+    EXPECT_EQ( expected.P.acc, row[3] );
+  }
+  std::remove( path.c_str() );
+}
+
+
+TEST(TrajectoryExporterTest, errors ) {
+  TrajectoryExporter exporter;
+  EXPECT_EQ( SPLINE_FILE_IO_ERROR, exporter.write( TimePVA( 0.0, PosVelAcc() ) ) );
+  EXPECT_EQ( SPLINE_FILE_IO_ERROR,
+             exporter.open( EXPORTER_DIR "not_exist/exporter.csv" ) );
+  EXPECT_FALSE( exporter.is_open() );
+  EXPECT_EQ( SPLINE_SUCCESS, exporter.close() );
+
+  TPVAQueue target_queue;
+  target_queue.push( 0.0, 0.0, 0.0, 0.0 );
+  target_queue.push( 1.0, 1.0, 0.0, 0.0 );
+  CubicSplineInterpolator interpolator;
+  ASSERT_EQ( SPLINE_SUCCESS, interpolator.generate_path( target_queue ) );
+
+  const std::string path = EXPORTER_DIR "exporter_list.csv";
+  EXPECT_EQ( SPLINE_SUCCESS, exporter.open( path ) );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_INTERVAL_TIME_DT,
+             exporter.write_sampled( interpolator, 0.0, 1.0, 0.0 ) );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME,
+             exporter.write_sampled( interpolator, 1.0, 0.0, 0.1 ) );
+
+  // a row of multi axes
+  PVAList pva_list;
+  pva_list.push_back( PosVelAcc( 1.5, 0.25, 0.0 ) );
+  pva_list.push_back( PosVelAcc( -1.0, 0.0, 1e-10 ) );
+  EXPECT_EQ( SPLINE_SUCCESS, exporter.write( TimePVAList( 0.1, pva_list ) ) );
+  EXPECT_EQ( SPLINE_SUCCESS, exporter.write( TimePosition( 0.2, 3.0 ) ) );
+  EXPECT_EQ( SPLINE_SUCCESS, exporter.close() );
+  EXPECT_EQ( std::string( "0.1,1.5,0.25,0,-1,0,1e-10\n0.2,3\n" ), read_all( path ) );
+  std::remove( path.c_str() );
+}
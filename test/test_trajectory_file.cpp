@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+#include "trajectory_file.hpp"
+#include "cubic_spline_interpolator.hpp"
+
+#include <math.h>
+#include <cstdio>
+#include <unistd.h> // for truncate
+
+using namespace interp;
+
+/// the number of points
+#define TRAJECTORY_FILE_POINT_NUM 10007
+
+/// destination directory of binary files
+#define TRAJECTORY_FILE_DIR "./images/"
+
+
+TEST(TrajectoryFileTest, tpva_queue_write_read_view ) {
+  TPVAQueue tpva_queue;
+  for( std::size_t i=0; i < TRAJECTORY_FILE_POINT_NUM; i++ ) {
+    tpva_queue.push( 0.001 * ( i + 1 ) + 1.0e-13 * i,
+                     sin( 0.01 * i ) / 3.0, cos( 0.01 * i ) / 7.0, -sin( 0.01 * i ) );
+  }
+  const std::string path = TRAJECTORY_FILE_DIR "trajectory_tpva.bin";
+  EXPECT_EQ( SPLINE_SUCCESS, TrajectoryFile::write( path, tpva_queue ) );
+
+  // read without loss of precision
+  TPVAQueue read_queue;
+  EXPECT_EQ( SPLINE_SUCCESS, TrajectoryFile::read( path, read_queue ) );
+  ASSERT_EQ( tpva_queue.size(), read_queue.size() );
+  for( std::size_t i=0; i < tpva_queue.size(); i++ ) {
+    ASSERT_EQ( tpva_queue.at( i ).time,  read_queue.at( i ).time );
+    ASSERT_EQ( tpva_queue.at( i ).P.pos, read_queue.at( i ).P.pos );
+    ASSERT_EQ( tpva_queue.at( i ).P.vel, read_queue.at( i ).P.vel );
+    ASSERT_EQ( tpva_queue.at( i ).P.acc, read_queue.at( i ).P.acc );
+  }
+  EXPECT_DOUBLE_EQ( tpva_queue.total_dT(), read_queue.total_dT() );
+
+  // view on the mapped file
+  TrajectoryFileView view;
+  EXPECT_FALSE( view.is_open() );
+  EXPECT_EQ( SPLINE_SUCCESS, view.open( path ) );
+  EXPECT_TRUE( view.is_open() );
+  EXPECT_EQ( TRAJECTORY_FILE_TPVA, view.kind() );
+  EXPECT_EQ( 1, view.axis_size() );
+  ASSERT_EQ( tpva_queue.size(), view.size() );
+  for( std::size_t i=0; i < tpva_queue.size(); i++ ) {
+    const TimePVA tpva = view.get( i );
+    ASSERT_EQ( tpva_queue.at( i ).time,  tpva.time );
+    ASSERT_EQ( tpva_queue.at( i ).P.pos, tpva.P.pos );
+    ASSERT_EQ( tpva_queue.at( i ).P.acc, view.accelerations()[i] );
+  }
+  EXPECT_EQ( tpva_queue.dT( 5 ), view.dT( 5 ) );
+  EXPECT_DOUBLE_EQ( tpva_queue.total_dT(), view.total_dT() );
+  EXPECT_TRUE( view.positions( 1 ) == NULL );
+  EXPECT_THROW( view.get( tpva_queue.size() ), InvalidIndexAccess );
+  EXPECT_THROW( view.get( 0, 1 ), InvalidIndexAccess );
+  view.close();
+  EXPECT_EQ( 0, view.size() );
+
+  // different kind
+  TPQueue tp_queue;
+  EXPECT_EQ( SPLINE_INVALID_FILE_FORMAT, TrajectoryFile::read( path, tp_queue ) );
+  std::remove( path.c_str() );
+}
+
+
+TEST(TrajectoryFileTest, tp_and_list_queue ) {
+  TPQueue tp_queue;
+  TPVAListQueue list_queue;
+  for( std::size_t i=0; i < 100; i++ ) {
+    tp_queue.push_on_clocktime( 0.1 * i, 2.0 * i );
+    PVAList pva_list;
+    for( std::size_t k=0; k < 6; k++ ) {
+      pva_list.push_back( PosVelAcc( 1.0 * i + k, 0.5 * k, -0.5 * k ) );
+    }
+    list_queue.push( 0.1 * i, pva_list );
+  }
+  const std::string tp_path   = TRAJECTORY_FILE_DIR "trajectory_tp.bin";
+  const std::string list_path = TRAJECTORY_FILE_DIR "trajectory_tpva_list.bin";
+  EXPECT_EQ( SPLINE_SUCCESS, TrajectoryFile::write( tp_path,   tp_queue ) );
+  EXPECT_EQ( SPLINE_SUCCESS, TrajectoryFile::write( list_path, list_queue ) );
+
+  std::string src_dump, dest_dump;
+  TPQueue read_tp_queue;
+  EXPECT_EQ( SPLINE_SUCCESS, TrajectoryFile::read( tp_path, read_tp_queue ) );
+  tp_queue.dump( src_dump );
+  read_tp_queue.dump( dest_dump );
+  EXPECT_EQ( src_dump, dest_dump );
+
+  // TP file into TPVAQueue with vel = acc = 0.0
+  TPVAQueue read_tpva_queue;
+  EXPECT_EQ( SPLINE_SUCCESS, TrajectoryFile::read( tp_path, read_tpva_queue ) );
+  EXPECT_EQ( 198.0, read_tpva_queue.back().P.pos );
+  EXPECT_EQ( 0.0,   read_tpva_queue.back().P.vel );
+
+  TPVAListQueue read_list_queue;
+  EXPECT_EQ( SPLINE_SUCCESS, TrajectoryFile::read( list_path, read_list_queue ) );
+  list_queue.dump( src_dump );
+  read_list_queue.dump( dest_dump );
+  EXPECT_EQ( src_dump, dest_dump );
+
+  TrajectoryFileView view;
+  EXPECT_EQ( SPLINE_SUCCESS, view.open( list_path ) );
+  EXPECT_EQ( TRAJECTORY_FILE_TPVA_LIST, view.kind() );
+  EXPECT_EQ( 6, view.axis_size() );
+  EXPECT_EQ( 99.0 + 4, view.get( 99, 4 ).P.pos );
+  EXPECT_EQ( 0.5 * 4,  view.velocities( 4 )[99] );
+  EXPECT_TRUE( view.velocities( 6 ) == NULL );
+
+  EXPECT_EQ( SPLINE_SUCCESS, view.open( tp_path ) );
+  EXPECT_TRUE( view.velocities() == NULL );
+  EXPECT_EQ( 0.0, view.get( 3 ).P.vel );
+  EXPECT_EQ( 6.0, view.get( 3 ).P.pos );
+
+  std::remove( tp_path.c_str() );
+  std::remove( list_path.c_str() );
+}
+
+
+TEST(TrajectoryFileTest, invalid_file ) {
+  TPVAQueue tpva_queue;
+  TrajectoryFileView view;
+  EXPECT_EQ( SPLINE_FILE_IO_ERROR,
+             TrajectoryFile::read( TRAJECTORY_FILE_DIR "not_exist.bin", tpva_queue ) );
+  EXPECT_EQ( SPLINE_FILE_IO_ERROR, view.open( TRAJECTORY_FILE_DIR "not_exist.bin" ) );
+
+  // text file
+  const std::string path = TRAJECTORY_FILE_DIR "trajectory_invalid.bin";
+  FILE* fp = std::fopen( path.c_str(), "wb" );
+  ASSERT_TRUE( fp != NULL );
+  for( std::size_t i=0; i < 10; i++ ) {
+    std::fprintf( fp, "%f, %f, %f, %f\n", 0.1 * i, 1.0, 0.0, 0.0 );
+  }
+  std::fclose( fp );
+  EXPECT_EQ( SPLINE_INVALID_FILE_FORMAT, TrajectoryFile::read( path, tpva_queue ) );
+  EXPECT_EQ( SPLINE_INVALID_FILE_FORMAT, view.open( path ) );
+  EXPECT_FALSE( view.is_open() );
+
+  // truncated file
+  for( std::size_t i=0; i < 10; i++ ) {
+    tpva_queue.push( 0.1 * ( i + 1 ), 1.0 );
+  }
+  EXPECT_EQ( SPLINE_SUCCESS, TrajectoryFile::write( path, tpva_queue ) );
+  ASSERT_EQ( 0, truncate( path.c_str(), TrajectoryFile::HEADER_SIZE + 8 * 39 ) );
+  EXPECT_EQ( SPLINE_INVALID_FILE_FORMAT, TrajectoryFile::read( path, tpva_queue ) );
+  EXPECT_EQ( SPLINE_INVALID_FILE_FORMAT, view.open( path ) );
+  std::remove( path.c_str() );
+}
+
+
+TEST(TrajectoryStoreTest, playback_same_as_cubic ) {
+  const std::string path = TRAJECTORY_FILE_DIR "trajectory_store.bin";
+  TPVAQueue tpva_queue;
+  TrajectoryStoreWriter writer;
+  EXPECT_EQ( SPLINE_SUCCESS, writer.open( path, 1, 1000 ) );
+  for( std::size_t i=0; i < 20500; i++ ) {
+    const TimePVA tpva( 0.01 * i + 1.0e-5 * ( i % 7 ),
+                        PosVelAcc( sin( 0.003 * i ), 0.3 * cos( 0.003 * i ), 0.0 ) );
+    tpva_queue.push( tpva );
+    EXPECT_EQ( SPLINE_SUCCESS, writer.push( tpva ) );
+  }
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, writer.push( tpva_queue.back() ) );
+  EXPECT_EQ( SPLINE_INVALID_QUEUE_SIZE, writer.push( 1000.0, PVAList() ) );
+  EXPECT_EQ( 20500, writer.size() );
+  EXPECT_EQ( SPLINE_SUCCESS, writer.close() );
+
+  CubicSplineInterpolator cubic;
+  EXPECT_EQ( SPLINE_SUCCESS, cubic.generate_path( tpva_queue ) );
+
+  TrajectoryStorePlayer player( 2 );
+  EXPECT_THROW( player.pop( 0.0 ), NotSplineGenerated );
+  EXPECT_EQ( SPLINE_SUCCESS, player.open( path ) );
+  EXPECT_EQ( 20500, player.size() );
+  EXPECT_EQ( 21,    player.chunk_size() );
+  EXPECT_EQ( 1,     player.axis_size() );
+  EXPECT_EQ( 0,     player.resident_chunk_size() );
+  EXPECT_EQ( tpva_queue.front().time, player.start_time() );
+  EXPECT_EQ( tpva_queue.back().time,  player.finish_time() );
+
+  // sequential playback across chunk boundaries keeps the window bounded
+  for( double t=player.start_time(); t < player.finish_time(); t+=0.0037 ) {
+    const TimePVA expected = cubic.pop( t );
+    const TimePVA actual   = player.pop( t );
+    ASSERT_EQ( expected.P.pos, actual.P.pos ) << "t = " << t;
+    ASSERT_EQ( expected.P.vel, actual.P.vel ) << "t = " << t;
+    ASSERT_EQ( expected.P.acc, actual.P.acc ) << "t = " << t;
+    ASSERT_GE( 3, player.resident_chunk_size() );
+  }
+  // at the target points & the finish time
+  for( std::size_t i=0; i < tpva_queue.size(); i+=999 ) {
+    EXPECT_EQ( tpva_queue.at( i ).P.pos, player.pop( tpva_queue.at( i ).time ).P.pos );
+  }
+  EXPECT_EQ( 2, player.resident_chunk_size() );
+  EXPECT_EQ( tpva_queue.back().P.pos, player.pop( player.finish_time() ).P.pos );
+  EXPECT_EQ( 1, player.resident_chunk_size() );
+
+  // seek backward
+  EXPECT_EQ( cubic.pop( 12.345 ).P.pos, player.pop( 12.345 ).P.pos );
+  EXPECT_EQ( 3, player.resident_chunk_size() );
+
+  EXPECT_THROW( player.pop( player.finish_time() + 0.1 ), TimeOutOfRange );
+  EXPECT_THROW( player.pop( 1.0, 1 ), InvalidIndexAccess );
+  std::remove( path.c_str() );
+}
+
+
+TEST(TrajectoryStoreTest, multi_axis ) {
+  const std::string path = TRAJECTORY_FILE_DIR "trajectory_store_list.bin";
+  TrajectoryStoreWriter writer;
+  EXPECT_EQ( SPLINE_INVALID_ARGUMENT_VALUE_ZERO, writer.open( path, 0 ) );
+  EXPECT_EQ( SPLINE_SUCCESS, writer.open( path, 3, 4 ) );
+  EXPECT_EQ( SPLINE_INVALID_QUEUE_SIZE, writer.push( TimePVA( 0.0 ) ) );
+  std::vector<TPVAQueue> axis_queues( 3 );
+  for( std::size_t i=0; i < 10; i++ ) {
+    PVAList pva_list;
+    for( std::size_t k=0; k < 3; k++ ) {
+      pva_list.push_back( PosVelAcc( 1.0 * i * ( k + 1 ), 0.5 * k, 0.0 ) );
+      axis_queues[k].push( 0.5 * i, pva_list[k] );
+    }
+    EXPECT_EQ( SPLINE_SUCCESS, writer.push( 0.5 * i, pva_list ) );
+  }
+  EXPECT_EQ( SPLINE_SUCCESS, writer.close() );
+
+  TrajectoryStorePlayer player;
+  EXPECT_EQ( SPLINE_SUCCESS, player.open( path ) );
+  EXPECT_EQ( 3, player.axis_size() );
+  EXPECT_EQ( 3, player.chunk_size() );
+  for( std::size_t k=0; k < 3; k++ ) {
+    CubicSplineInterpolator cubic;
+    EXPECT_EQ( SPLINE_SUCCESS, cubic.generate_path( axis_queues[k] ) );
+    for( double t=0.0; t <= 4.5; t+=0.1 ) {
+      const TimePVAList tpva_list = player.pop_list( t );
+      ASSERT_EQ( 3, tpva_list.value.size() );
+      EXPECT_EQ( cubic.pop( t ).P.pos, tpva_list.value[k].pos );
+      EXPECT_EQ( cubic.pop( t ).P.vel, player.pop( t, k ).P.vel );
+    }
+  }
+
+  // the columnar trajectory file is not the store file
+  TPQueue tp_queue;
+  tp_queue.push_on_clocktime( 0.0, 1.0 );
+  EXPECT_EQ( SPLINE_SUCCESS, TrajectoryFile::write( path, tp_queue ) );
+  EXPECT_EQ( SPLINE_INVALID_FILE_FORMAT, player.open( path ) );
+  EXPECT_FALSE( player.is_open() );
+  std::remove( path.c_str() );
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "trajectory_lut.hpp"
+#include "test/util/test_trajectories.hpp"
+
+#include <math.h>
+
+using namespace interp;
+
+/// maximum deviation of positions from pop() on a dense grid
+/// @param[in] lut          lookup table
+/// @param[in] interpolator source of the table
+/// @return maximum deviation
+static double dense_deviation( const TrajectoryLUT& lut, const SplineInterpolator& interpolator ) {
+  double deviation = 0.0;
+  const double dT = ( lut.finish_time() - lut.start_time() ) / 9973;
+  for( std::size_t i=0; i <= 9973; i++ ) {
+    const double t = ( i == 9973 ) ? lut.finish_time() : lut.start_time() + dT * i;
+    double pos = 0.0, vel = 0.0, acc = 0.0;
+    EXPECT_EQ( SPLINE_SUCCESS, lut.evaluate( t, pos, vel, acc ) );
+    deviation = std::max( deviation, fabs( interpolator.pop( t ).P.pos - pos ) );
+  }
+  return deviation;
+}
+
+
+TEST(TrajectoryLUTTest, uniform ) {
+  CubicSplineInterpolator interpolator;
+  make_cubic_spline( interpolator );
+
+  TrajectoryLUT lut;
+  ASSERT_EQ( SPLINE_SUCCESS, lut.build_uniform( interpolator, 0.01 ) );
+  EXPECT_EQ( interpolator.start_time(), lut.start_time() );
+  EXPECT_EQ( interpolator.finish_time(), lut.finish_time() );
+  EXPECT_EQ( lut.cell_num() + 1, lut.size() );
+  EXPECT_EQ( LUT_HERMITE, lut.interpolation() );
+  EXPECT_GT( 1.0e-6, lut.max_deviation() );
+  EXPECT_GT( 2.0 * lut.max_deviation() + 1.0e-12, dense_deviation( lut, interpolator ) );
+
+  // the entries are exact
+  const double cell_dT = ( lut.finish_time() - lut.start_time() ) / lut.cell_num();
+  for( std::size_t i=0; i < lut.cell_num(); i++ ) {
+    const TimePVA expected = interpolator.pop( lut.start_time() + cell_dT * i );
+    const TimePVA actual   = lut.pop( lut.start_time() + cell_dT * i );
+    ASSERT_NEAR( expected.P.pos, actual.P.pos, 1.0e-12 );
+    ASSERT_NEAR( expected.P.vel, actual.P.vel, 1.0e-9 );
+    ASSERT_NEAR( expected.P.acc, actual.P.acc, 1.0e-9 );
+  }
+  const TimePVA finish = lut.pop( lut.finish_time() );
+  EXPECT_EQ( interpolator.pop( interpolator.finish_time() ).P.pos, finish.P.pos );
+
+  // linear interpolation needs denser entries for the same deviation
+  TrajectoryLUT linear_lut;
+  ASSERT_EQ( SPLINE_SUCCESS, linear_lut.build_uniform( interpolator, 0.01, LUT_LINEAR ) );
+  EXPECT_LT( lut.max_deviation(), linear_lut.max_deviation() );
+  double pos = 0.0, vel = 0.0, acc = -1.0;
+  ASSERT_EQ( SPLINE_SUCCESS, linear_lut.evaluate<OUTPUT_POS_VEL>( 1.234, pos, vel, acc ) );
+  EXPECT_NEAR( interpolator.pop( 1.234 ).P.pos, pos, linear_lut.max_deviation() * 2.0 );
+  EXPECT_EQ( -1.0, acc );
+}
+
+
+TEST(TrajectoryLUTTest, adaptive ) {
+  TrapezoidalInterpolator interpolator;
+  make_trapezoidal( interpolator );
+
+  const double tolerance = 1.0e-6;
+  TrajectoryLUT lut;
+  ASSERT_EQ( SPLINE_SUCCESS, lut.build_adaptive( interpolator, 0.1, tolerance ) );
+  EXPECT_GE( tolerance, lut.max_deviation() );
+  EXPECT_GT( 2.0 * tolerance, dense_deviation( lut, interpolator ) );
+
+  // entries are dense only in the accelerating and decelerating phases
+  std::size_t min_level = TrajectoryLUT::MAX_LEVEL, max_level = 0;
+  for( std::size_t cell=0; cell < lut.cell_num(); cell++ ) {
+    min_level = std::min( min_level, lut.level( cell ) );
+    max_level = std::max( max_level, lut.level( cell ) );
+  }
+  EXPECT_EQ( 0u, min_level );
+  EXPECT_LT( 0u, max_level );
+
+  // fewer entries than the uniform table at the finest interval
+  TrajectoryLUT uniform_lut;
+  ASSERT_EQ( SPLINE_SUCCESS,
+             uniform_lut.build_uniform( interpolator, 0.1 / ( 1 << max_level ) ) );
+  EXPECT_GT( uniform_lut.size(), 2 * lut.size() );
+
+  // the tolerance is not met at the maximum level
+  TrajectoryLUT coarse_lut;
+  ASSERT_EQ( SPLINE_SUCCESS, coarse_lut.build_adaptive( interpolator, 0.5, 1.0e-12, LUT_LINEAR, 2 ) );
+  EXPECT_LT( 1.0e-12, coarse_lut.max_deviation() );
+  for( std::size_t cell=0; cell < coarse_lut.cell_num(); cell++ ) {
+    EXPECT_GE( 2u, coarse_lut.level( cell ) );
+  }
+}
+
+
+TEST(TrajectoryLUTTest, errors ) {
+  TrajectoryLUT lut;
+  double pos = 0.0, vel = 0.0, acc = 0.0;
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, lut.evaluate( 0.0, pos, vel, acc ) );
+  EXPECT_THROW( lut.pop( 0.0 ), NotSplineGenerated );
+
+  CubicSplineInterpolator interpolator;
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, lut.build_uniform( interpolator, 0.1 ) );
+  EXPECT_EQ( 0u, lut.size() );
+
+  make_cubic_spline( interpolator );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_INTERVAL_TIME_DT, lut.build_uniform( interpolator, 0.0 ) );
+  EXPECT_EQ( SPLINE_INVALID_ARGUMENT_VALUE_ZERO, lut.build_adaptive( interpolator, 0.1, 0.0 ) );
+
+  // the interval longer than the path
+  ASSERT_EQ( SPLINE_SUCCESS, lut.build_uniform( interpolator, 100.0 ) );
+  EXPECT_EQ( 1u, lut.cell_num() );
+  EXPECT_EQ( 2u, lut.size() );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, lut.evaluate( -0.1, pos, vel, acc ) );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, lut.evaluate( lut.finish_time() + 0.1, pos, vel, acc ) );
+  EXPECT_THROW( lut.pop( -0.1 ), TimeOutOfRange );
+
+  lut.clear();
+  EXPECT_EQ( 0u, lut.size() );
+  EXPECT_EQ( 0.0, lut.max_deviation() );
+}
@@ -1,5 +1,6 @@
 #include "trapezoid_5251525.hpp"
 #include "non_uniform_rounding_spline.hpp"
+#include "waypoint_loader.hpp"
 #include "test/util/gnuplot_realtime.hpp"
 #include "test/util/test_graph_plot.hpp"
 #include <deque>
@@ -863,6 +864,67 @@ TEST(TrackingTest, speed_limit) {
 }
 
 
+/// @test 計画失敗の例外 @n
+/// Trapezoid5251525Profile の計画失敗が従来の例外に変換されることを確認
+TEST(TrackingTest, generation_errors) {
+  Trapezoid5251525 tg( 1200, 1200, 170, 0.8, 0.8, 0.5 );
+  // 時刻が負, 逆順
+  EXPECT_THROW( tg.generate_path( -1.0, 1.0, 0.0, 1.0, 0.0, 0.0 ), std::invalid_argument );
+  EXPECT_THROW( tg.generate_path( 2.0, 1.0, 0.0, 1.0, 0.0, 0.0 ), std::invalid_argument );
+  // 開始速度が速度リミットを超える
+  EXPECT_THROW( tg.generate_path( 0.0, 1.0, 0.0, 1.0, 200.0, 0.0 ), std::invalid_argument );
+  // 最短時間より前
+  EXPECT_THROW( tg.generate_path( 0.0, 0.1, 0.0, 1.0e5, 0.0, 0.0 ), std::invalid_argument );
+  EXPECT_FALSE( tg.is_generated() );
+  // 計画成功後は最速軌道の終了時刻が最短時刻となる
+  EXPECT_LT( 0.0, tg.generate_path( 0.0, 0.0, 0.0, 100.0, 0.0, 0.0 ) );
+  EXPECT_TRUE( tg.is_fastest() );
+  EXPECT_EQ( tg.tf_fastest(), tg.tf() );
+  EXPECT_EQ( tg.t7(), tg.finish_time() );
+}
+
+
+/// @test 丸め区間の加速度 @n
+/// Step1, Step7 の加速度が t1, t6, t7 で連続で、速度の微分と一致することを確認 @n
+TEST(TrackingTest, rounding_acceleration_continuity) {
+  const double dt = 1.0e-6;
+  const double xf_set[] = { 100.0, -100.0 };
+  for( std::size_t i=0; i < 2; i++ ) {
+    Trapezoid5251525 tg( 1200, 1200, 170, 0.8, 0.8, 0.5 );
+    tg.generate_path( 0.0, 0.0, 0.0, xf_set[i], 0.0, 0.0 );
+    ASSERT_LT( tg.t0(), tg.t1() );
+    ASSERT_LT( tg.t6(), tg.t7() );
+    const double a = tg.signA() * tg.a_max();
+    const double d = tg.signD() * tg.d_max();
+    double xt, vt, at, xt2, vt2, at2;
+
+    // t1 : 0 -> a_max
+    tg.pop( tg.t1() - dt, xt, vt, at );
+    tg.pop( tg.t1(), xt2, vt2, at2 );
+    EXPECT_NEAR( a, at, 1.0e-3 );
+    EXPECT_NEAR( a, at2, 1.0e-9 );
+    // t6 : -d_max -> 0
+    tg.pop( tg.t6() - dt, xt, vt, at );
+    tg.pop( tg.t6() + dt, xt2, vt2, at2 );
+    EXPECT_NEAR( -d, at, 1.0e-3 );
+    EXPECT_NEAR( -d, at2, 1.0e-3 );
+    // t7 : 0
+    tg.pop( tg.t7(), xt, vt, at );
+    EXPECT_NEAR( 0.0, at, 1.0e-9 );
+
+    // 加速度は速度の微分
+    const double t_set[] = { 0.5 * ( tg.t0() + tg.t1() ), 0.5 * ( tg.t6() + tg.t7() ) };
+    for( std::size_t k=0; k < 2; k++ ) {
+      tg.pop( t_set[k] - dt, xt, vt, at );
+      tg.pop( t_set[k] + dt, xt2, vt2, at2 );
+      double x, v, acc;
+      tg.pop( t_set[k], x, v, acc );
+      EXPECT_NEAR( ( vt2 - vt ) / ( 2.0 * dt ), acc, 1.0e-3 );
+    }
+  }
+}
+
+
 /////////////////////////////////////////////////////////////////////////////////////
 
 /// @test ランダムプロット @n
@@ -1334,29 +1396,14 @@ TEST(TrackingTest, datafile_xy) {
   // 直交系の最大加速、速度リミット
   const double acc_limit = 30;
   const double vel_limit = 2;
-  // データファイル(csv形式)
-  std::ifstream ifstrm("test/data/teaching_points_5p.csv");
-  if (ifstrm.fail()) {
-    std::cerr << "cannot open input temporary file."<< std::endl;
+  // データファイル(csv形式)のパース
+  // データテーブル[行][列] (一行目はラベル)
+  WaypointLoader loader;
+  if (loader.load_file("test/data/teaching_points_5p.csv") != SPLINE_SUCCESS) {
+    std::cerr << "cannot load input file. line " << loader.error_line()
+              << ": " << loader.error_message() << std::endl;
     FAIL();
   }
-  // パース
-  // データテーブル[行][列]
-  std::vector< std::vector<double> > table_data;
-  std::string line;
-  while (std::getline(ifstrm, line)) {
-    if(line.c_str()[0] == '#') continue; // 一行目はラベル
-    std::istringstream isstrm(line);
-    std::string element;
-    std::vector<double> line_data;
-    while (std::getline(isstrm, element, ',')) {
-      line_data.push_back(atof(element.c_str()));
-      std::cerr << element << ",";
-    }
-    std::cerr << std::endl;
-    table_data.push_back(line_data);
-  }
-  ifstrm.close();
   // 描画入力目標点の生成
   const double target_time[] = {0.0,      0.504564, 0.219867,
                                 0.544634, 0.289216, 0.296369,
@@ -1368,10 +1415,10 @@ TEST(TrackingTest, datafile_xy) {
   std::vector<double> target_position_x;
   std::vector<double> target_position_y;
   ///
-  for (unsigned int i=0; i<table_data.size(); i++) {
-    target_position_x.push_back(table_data[i][0]);
-    target_position_y.push_back(table_data[i][1]);
-    std::cerr << "[" << i << "] x, y :" << table_data[i][0] << ", " << table_data[i][1] << std::endl;
+  loader.column(0, target_position_x);
+  loader.column(1, target_position_y);
+  for (unsigned int i=0; i<loader.row_size(); i++) {
+    std::cerr << "[" << i << "] x, y :" << loader.value(i, 0) << ", " << loader.value(i, 1) << std::endl;
   }
   // 終了後のデータ
   target_position_x.push_back(target_position_x[0]);
@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+#include "trapezoid_5251525_interpolator.hpp"
+#include "test/util/test_trajectories.hpp"
+
+using namespace interp;
+
+/// 補間周期 [s]
+#define LAZY_CYCLE 0.01
+/// 区間軌道の数
+#define LAZY_SEGMENT_NUM 200
+
+
+TEST(TrapezoidalInterpolatorTest, index_of_time ) {
+  const TPVAQueue target_tpva_queue = make_sine_tpva_queue( LAZY_SEGMENT_NUM + 1 );
+  TrapezoidalInterpolator tg( make_trapezoid_config_queue( LAZY_SEGMENT_NUM ) );
+  EXPECT_EQ( SPLINE_SUCCESS, tg.generate_path( target_tpva_queue ) );
+
+  std::size_t index=1000;
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, tg.index_of_time( -0.5, index ) );
+  EXPECT_EQ( 1000, index );
+  EXPECT_EQ( SPLINE_SUCCESS, tg.index_of_time( 0.0, index ) );
+  EXPECT_EQ( 0, index );
+  EXPECT_EQ( SPLINE_SUCCESS, tg.index_of_time( 0.5, index ) );
+  EXPECT_EQ( 0, index );
+  EXPECT_EQ( SPLINE_SUCCESS, tg.index_of_time( 1.0, index ) );
+  EXPECT_EQ( 1, index );
+  EXPECT_EQ( SPLINE_SUCCESS, tg.index_of_time( 123.25, index ) );
+  EXPECT_EQ( 123, index );
+  EXPECT_EQ( SPLINE_SUCCESS, tg.index_of_time( LAZY_SEGMENT_NUM - 0.5, index ) );
+  EXPECT_EQ( LAZY_SEGMENT_NUM - 1, index );
+  EXPECT_EQ( SPLINE_SUCCESS, tg.index_of_time( LAZY_SEGMENT_NUM, index ) );
+  EXPECT_EQ( LAZY_SEGMENT_NUM, index );
+  index=1000;
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, tg.index_of_time( LAZY_SEGMENT_NUM + 0.1, index ) );
+  EXPECT_EQ( 1000, index );
+}
+
+
+TEST(TrapezoidalInterpolatorTest, lazy_generation_same_as_eager ) {
+  const TPVAQueue target_tpva_queue = make_sine_tpva_queue( LAZY_SEGMENT_NUM + 1 );
+
+  TrapezoidalInterpolator eager_tg( make_trapezoid_config_queue( LAZY_SEGMENT_NUM ) );
+  EXPECT_EQ( SPLINE_SUCCESS, eager_tg.generate_path( target_tpva_queue ) );
+  for( std::size_t i=0; i < LAZY_SEGMENT_NUM; i++ ) {
+    EXPECT_EQ( SPLINE_SUCCESS, eager_tg.segment_status( i ) );
+  }
+
+  TrapezoidalInterpolator lazy_tg( make_trapezoid_config_queue( LAZY_SEGMENT_NUM ) );
+  lazy_tg.set_lazy_generation( true, 2 );
+  EXPECT_TRUE( lazy_tg.lazy_generation() );
+  EXPECT_EQ( 2, lazy_tg.lookahead() );
+  EXPECT_EQ( SPLINE_SUCCESS, lazy_tg.generate_path( target_tpva_queue ) );
+  // 先頭から先読み区間数分のみ計画済み
+  EXPECT_EQ( SPLINE_SUCCESS,               lazy_tg.segment_status( 0 ) );
+  EXPECT_EQ( SPLINE_SUCCESS,               lazy_tg.segment_status( 2 ) );
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, lazy_tg.segment_status( 3 ) );
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, lazy_tg.segment_status( LAZY_SEGMENT_NUM - 1 ) );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_INDEX,   lazy_tg.segment_status( LAZY_SEGMENT_NUM ) );
+
+  // 途中の時刻から再生しても一括生成と同じ軌道
+  const double tf = eager_tg.finish_time();
+  for( double t=tf/2.0; t <= tf; t+=LAZY_CYCLE ) {
+    const TimePVA eager_tpva = eager_tg.pop( t );
+    const TimePVA lazy_tpva  = lazy_tg.pop( t );
+    EXPECT_DOUBLE_EQ( eager_tpva.P.pos, lazy_tpva.P.pos );
+    EXPECT_DOUBLE_EQ( eager_tpva.P.vel, lazy_tpva.P.vel );
+    EXPECT_DOUBLE_EQ( eager_tpva.P.acc, lazy_tpva.P.acc );
+  }
+  // 終端時刻
+  EXPECT_DOUBLE_EQ( eager_tg.pop( tf ).P.pos, lazy_tg.pop( tf ).P.pos );
+  EXPECT_DOUBLE_EQ( target_tpva_queue.back().P.pos, lazy_tg.pop( tf ).P.pos );
+  // 再生していない前半区間は未計画のまま
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, lazy_tg.segment_status( 10 ) );
+
+  // 先読み計画
+  EXPECT_EQ( SPLINE_SUCCESS, lazy_tg.prefetch( 10.5 ) );
+  EXPECT_EQ( SPLINE_SUCCESS,               lazy_tg.segment_status( 10 ) );
+  EXPECT_EQ( SPLINE_SUCCESS,               lazy_tg.segment_status( 12 ) );
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, lazy_tg.segment_status( 13 ) );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, lazy_tg.prefetch( tf + 1.0 ) );
+
+  std::size_t failed_index = 1000;
+  EXPECT_EQ( SPLINE_SUCCESS, lazy_tg.generation_status( failed_index ) );
+  EXPECT_EQ( 1000, failed_index );
+
+  // コピーしても計画状態を引き継ぐ
+  TrapezoidalInterpolator copy_tg( lazy_tg );
+  EXPECT_TRUE( copy_tg.lazy_generation() );
+  EXPECT_EQ( SPLINE_SUCCESS,               copy_tg.segment_status( 10 ) );
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, copy_tg.segment_status( 13 ) );
+  EXPECT_DOUBLE_EQ( eager_tg.pop( 13.3 ).P.pos, copy_tg.pop( 13.3 ).P.pos );
+}
+
+
+TEST(TrapezoidalInterpolatorTest, lazy_generation_time_scale ) {
+  const TPVAQueue target_tpva_queue = make_sine_tpva_queue( LAZY_SEGMENT_NUM + 1 );
+  TrapezoidalInterpolator eager_tg( make_trapezoid_config_queue( LAZY_SEGMENT_NUM ) );
+  ASSERT_EQ( SPLINE_SUCCESS, eager_tg.generate_path( target_tpva_queue ) );
+  ASSERT_EQ( SPLINE_SUCCESS, eager_tg.set_time_scale( 0.5 ) );
+
+  // 半速の再生 : 入力時刻 t は経路上の時刻 t/2
+  TrapezoidalInterpolator lazy_tg( make_trapezoid_config_queue( LAZY_SEGMENT_NUM ) );
+  lazy_tg.set_lazy_generation( true, 2 );
+  ASSERT_EQ( SPLINE_SUCCESS, lazy_tg.generate_path( target_tpva_queue ) );
+  ASSERT_EQ( SPLINE_SUCCESS, lazy_tg.set_time_scale( 0.5 ) );
+  const double tf = lazy_tg.finish_time();
+  EXPECT_DOUBLE_EQ( 2.0 * LAZY_SEGMENT_NUM, tf );
+
+  // 先読みは pop() と同じ区間を計画する
+  EXPECT_EQ( SPLINE_SUCCESS, lazy_tg.prefetch( 21.0 ) );
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, lazy_tg.segment_status( 9 ) );
+  EXPECT_EQ( SPLINE_SUCCESS,               lazy_tg.segment_status( 10 ) );
+  EXPECT_EQ( SPLINE_SUCCESS,               lazy_tg.segment_status( 12 ) );
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, lazy_tg.segment_status( 13 ) );
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, lazy_tg.segment_status( 21 ) );
+  // 経路の終端時刻より後でも再生時刻の範囲内
+  EXPECT_EQ( SPLINE_SUCCESS, lazy_tg.prefetch( 1.5 * LAZY_SEGMENT_NUM ) );
+  EXPECT_EQ( SPLINE_SUCCESS, lazy_tg.segment_status( 3 * LAZY_SEGMENT_NUM / 4 ) );
+  EXPECT_EQ( SPLINE_SUCCESS, lazy_tg.prefetch( tf ) );
+  EXPECT_EQ( SPLINE_SUCCESS, lazy_tg.segment_status( LAZY_SEGMENT_NUM - 1 ) );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, lazy_tg.prefetch( tf + 1.0 ) );
+
+  for( double t=20.0; t <= 30.0; t+=LAZY_CYCLE ) {
+    const TimePVA eager_tpva = eager_tg.pop( t );
+    const TimePVA lazy_tpva  = lazy_tg.pop( t );
+    ASSERT_DOUBLE_EQ( eager_tpva.P.pos, lazy_tpva.P.pos );
+    ASSERT_DOUBLE_EQ( eager_tpva.P.vel, lazy_tpva.P.vel );
+    ASSERT_DOUBLE_EQ( eager_tpva.P.acc, lazy_tpva.P.acc );
+  }
+}
+
+
+TEST(TrapezoidalInterpolatorTest, lazy_generation_failed_segment ) {
+  // 区間100 の終点を到達不可能な位置にする
+  const std::size_t failed_segment = 100;
+  TPVAQueue target_tpva_queue;
+  for( std::size_t i=0; i <= LAZY_SEGMENT_NUM; i++ ) {
+    const double pos = ( i == failed_segment + 1 ) ? 1.0e4 : sine_position( i );
+    target_tpva_queue.push_on_clocktime( (double)i, PosVelAcc( pos, 0.0, 0.0 ) );
+  }
+
+  // 一括生成モードでは例外
+  TrapezoidalInterpolator eager_tg( make_trapezoid_config_queue( LAZY_SEGMENT_NUM ) );
+  EXPECT_THROW( eager_tg.generate_path( target_tpva_queue ), std::invalid_argument );
+
+  // 遅延生成モードでは計画状態で通知
+  TrapezoidalInterpolator lazy_tg( make_trapezoid_config_queue( LAZY_SEGMENT_NUM ) );
+  lazy_tg.set_lazy_generation( true, 4 );
+  EXPECT_EQ( SPLINE_SUCCESS, lazy_tg.generate_path( target_tpva_queue ) );
+
+  std::size_t failed_index = 1000;
+  EXPECT_EQ( SPLINE_SUCCESS, lazy_tg.generation_status( failed_index ) );
+
+  // 先読みで失敗区間に触れる
+  EXPECT_NO_THROW( lazy_tg.pop( failed_segment - 2.0 ) );
+  EXPECT_EQ( SPLINE_FAIL_TO_GENERATE_PATH, lazy_tg.segment_status( failed_segment ) );
+  EXPECT_EQ( SPLINE_FAIL_TO_GENERATE_PATH, lazy_tg.generation_status( failed_index ) );
+  EXPECT_EQ( failed_segment, failed_index );
+  EXPECT_EQ( SPLINE_FAIL_TO_GENERATE_PATH, lazy_tg.prefetch( failed_segment - 1.0 ) );
+
+  // 失敗区間のpopは例外
+  EXPECT_THROW( lazy_tg.pop( failed_segment + 0.5 ), NotSplineGenerated );
+  // 失敗区間以外は再生可能
+  EXPECT_NO_THROW( lazy_tg.pop( failed_segment + 2.5 ) );
+}
+
+
+TEST(TrapezoidalInterpolatorTest, failed_eager_replan ) {
+  const std::size_t failed_segment = 100;
+  TPVAQueue failed_tpva_queue;
+  for( std::size_t i=0; i <= LAZY_SEGMENT_NUM; i++ ) {
+    const double pos = ( i == failed_segment + 1 ) ? 1.0e4 : sine_position( i );
+    failed_tpva_queue.push_on_clocktime( (double)i, PosVelAcc( pos, 0.0, 0.0 ) );
+  }
+
+  // 一括生成の再計画失敗後は前回の軌道も再生しない
+  TrapezoidalInterpolator eager_tg( make_trapezoid_config_queue( LAZY_SEGMENT_NUM ) );
+  ASSERT_EQ( SPLINE_SUCCESS, eager_tg.generate_path( make_sine_tpva_queue( LAZY_SEGMENT_NUM + 1 ) ) );
+  EXPECT_NO_THROW( eager_tg.pop( failed_segment + 2.5 ) );
+  EXPECT_THROW( eager_tg.generate_path( failed_tpva_queue ), std::invalid_argument );
+  EXPECT_THROW( eager_tg.pop( failed_segment + 2.5 ), NotSplineGenerated );
+  EXPECT_EQ( SPLINE_UNINITIALIZED_INTERPOLATOR, eager_tg.prefetch( 0.0 ) );
+
+  // 遅延生成モードを解除した後の pop() / prefetch() は計画しない
+  TrapezoidalInterpolator lazy_tg( make_trapezoid_config_queue( LAZY_SEGMENT_NUM ) );
+  lazy_tg.set_lazy_generation( true, 0 );
+  ASSERT_EQ( SPLINE_SUCCESS, lazy_tg.generate_path( make_sine_tpva_queue( LAZY_SEGMENT_NUM + 1 ) ) );
+  lazy_tg.set_lazy_generation( false );
+  EXPECT_NO_THROW( lazy_tg.pop( 0.5 ) );
+  EXPECT_EQ( SPLINE_FAIL_TO_GENERATE_PATH, lazy_tg.prefetch( 50.5 ) );
+  EXPECT_THROW( lazy_tg.pop( 50.5 ), NotSplineGenerated );
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, lazy_tg.segment_status( 50 ) );
+}
+
+
+TEST(TrapezoidalInterpolatorTest, output_mask ) {
+  const TPVAQueue target_tpva_queue = make_sine_tpva_queue( LAZY_SEGMENT_NUM + 1 );
+  TrapezoidalInterpolator tg( make_trapezoid_config_queue( LAZY_SEGMENT_NUM ) );
+  ASSERT_EQ( SPLINE_SUCCESS, tg.generate_path( target_tpva_queue ) );
+
+  // 選択した出力は pop() と bitwise で同じ, 選択外は 0.0
+  const double tf = tg.finish_time();
+  for( double t=0.0; t <= tf; t+=LAZY_CYCLE ) {
+    const TimePVA expected = tg.pop( t );
+    const TimePVA pos_only = tg.pop<OUTPUT_POS>( t );
+    EXPECT_EQ( expected.P.pos, pos_only.P.pos );
+    EXPECT_EQ( 0.0, pos_only.P.vel );
+    EXPECT_EQ( 0.0, pos_only.P.acc );
+    const TimePVA vel_acc = tg.pop<OUTPUT_VEL | OUTPUT_ACC>( t );
+    EXPECT_EQ( 0.0, vel_acc.P.pos );
+    EXPECT_EQ( expected.P.vel, vel_acc.P.vel );
+    EXPECT_EQ( expected.P.acc, vel_acc.P.acc );
+  }
+  EXPECT_THROW( tg.pop<OUTPUT_POS>( tf + 1.0 ), TimeOutOfRange );
+
+  // 区間軌道単体 : 選択外の出力は書き換えない
+  Trapezoid5251525 trapezoid( 1200, 1200, 170, 0.8, 0.8, 0.5 );
+  trapezoid.generate_path( 0.0, 0.0, 0.0, 10.0, 0.0, 0.0 );
+  double x = 0.0, v = 0.0, a = 0.0;
+  trapezoid.pop( 0.1, x, v, a );
+  double masked_x = -1.0, masked_v = -1.0, masked_a = -1.0;
+  trapezoid.pop<OUTPUT_POS>( 0.1, masked_x, masked_v, masked_a );
+  EXPECT_EQ( x, masked_x );
+  EXPECT_EQ( -1.0, masked_v );
+  EXPECT_EQ( -1.0, masked_a );
+}
+
+
+TEST(TrapezoidalInterpolatorTest, time_scale ) {
+  const std::size_t segment_num = 10;
+  const TPVAQueue target_tpva_queue = make_sine_tpva_queue( segment_num + 1 );
+  TrapezoidalInterpolator tg( make_trapezoid_config_queue( segment_num ) );
+  ASSERT_EQ( SPLINE_SUCCESS, tg.generate_path( target_tpva_queue ) );
+  const TrapezoidalInterpolator original( tg );
+  const double tf = original.finish_time();
+
+  // 半分の速度 : 速度は 1/2 倍, 加速度は 1/4 倍
+  const double scale = 0.5;
+  ASSERT_EQ( SPLINE_SUCCESS, tg.set_time_scale( scale ) );
+  EXPECT_NEAR( tf / scale, tg.finish_time(), 1.0e-12 );
+  for( double t=0.0; t <= tg.finish_time(); t+=LAZY_CYCLE ) {
+    const TimePVA expected = original.pop( scale * t );
+    const TimePVA actual   = tg.pop( t );
+    ASSERT_NEAR( expected.P.pos, actual.P.pos, 1.0e-9 );
+    ASSERT_NEAR( scale * expected.P.vel, actual.P.vel, 1.0e-9 );
+    ASSERT_NEAR( scale * scale * expected.P.acc, actual.P.acc, 1.0e-9 );
+  }
+  EXPECT_NO_THROW( tg.pop( tg.finish_time() ) );
+  EXPECT_NEAR( original.pop( tf ).P.pos, tg.pop( tg.finish_time() ).P.pos, 1.0e-12 );
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "trapezoid_5251525_kernel.hpp"
+
+#include <math.h>
+
+using namespace interp;
+
+/// 数値微分の時間刻み
+#define KERNEL_DIFF_DT 1.0e-6
+
+
+/// @test 各Stepの形で 加速度 = 速度の微分, 速度 = 位置の微分, 端点の加速度
+TEST(Trapezoid5251525KernelTest, derivatives ) {
+  const Trapezoid5251525StepShape shapes[] = { TRAPZD_ROUND_IN, TRAPZD_CONSTANT, TRAPZD_ROUND_OUT };
+  const double A = -800.0, dT = 0.05, v = 3.0, x = 1.0;
+  for( std::size_t i=0; i < 3; i++ ) {
+    for( double dt=0.005; dt < dT; dt+=0.005 ) {
+      double x0 = 0.0, v0 = 0.0, a0 = 0.0, x1 = 0.0, v1 = 0.0, a1 = 0.0, xt = 0.0, vt = 0.0, at = 0.0;
+      g_trapezoid5251525_step<OUTPUT_PVA>( shapes[i], dt - KERNEL_DIFF_DT, A, dT, v, x, x0, v0, a0 );
+      g_trapezoid5251525_step<OUTPUT_PVA>( shapes[i], dt + KERNEL_DIFF_DT, A, dT, v, x, x1, v1, a1 );
+      g_trapezoid5251525_step<OUTPUT_PVA>( shapes[i], dt, A, dT, v, x, xt, vt, at );
+      EXPECT_NEAR( ( x1 - x0 ) / ( 2.0 * KERNEL_DIFF_DT ), vt, 1.0e-6 );
+      EXPECT_NEAR( ( v1 - v0 ) / ( 2.0 * KERNEL_DIFF_DT ), at, 1.0e-3 );
+    }
+  }
+
+  // 丸め区間の端点 : 0 -> A, A -> 0
+  double xt = 0.0, vt = 0.0, at = -1.0;
+  g_trapezoid5251525_step<OUTPUT_ACC>( TRAPZD_ROUND_IN, 0.0, A, dT, v, x, xt, vt, at );
+  EXPECT_EQ( 0.0, at );
+  g_trapezoid5251525_step<OUTPUT_ACC>( TRAPZD_ROUND_IN, dT, A, dT, v, x, xt, vt, at );
+  EXPECT_NEAR( A, at, 1.0e-9 );
+  g_trapezoid5251525_step<OUTPUT_ACC>( TRAPZD_ROUND_OUT, 0.0, A, dT, v, x, xt, vt, at );
+  EXPECT_EQ( A, at );
+  g_trapezoid5251525_step<OUTPUT_ACC>( TRAPZD_ROUND_OUT, dT, A, dT, v, x, xt, vt, at );
+  EXPECT_NEAR( 0.0, at, 1.0e-9 );
+  // 選択外の出力は書き換えない
+  EXPECT_EQ( 0.0, xt );
+  EXPECT_EQ( 0.0, vt );
+}
+
+
+/// @test 多項式係数の位置は g_trapezoid5251525_step() と同じ
+TEST(Trapezoid5251525KernelTest, coefficients ) {
+  const Trapezoid5251525StepShape shapes[] = { TRAPZD_ROUND_IN, TRAPZD_CONSTANT, TRAPZD_ROUND_OUT };
+  const double A = 1200.0, dT = 0.04, v = -2.0, x = 5.0;
+  for( std::size_t i=0; i < 3; i++ ) {
+    double coef[6];
+    g_trapezoid5251525_step_coef( shapes[i], A, dT, v, x, coef );
+    for( double dt=0.0; dt <= dT; dt+=0.004 ) {
+      double xt = 0.0, vt = 0.0, at = 0.0;
+      g_trapezoid5251525_step<OUTPUT_PVA>( shapes[i], dt, A, dT, v, x, xt, vt, at );
+      double pos = 0.0, vel = 0.0, acc = 0.0;
+      for( std::size_t k=6; k > 0; k-- ) {
+        pos = pos * dt + coef[k-1];
+        if( k > 1 ) {
+          vel = vel * dt + ( k - 1 ) * coef[k-1];
+        }
+        if( k > 2 ) {
+          acc = acc * dt + ( k - 1 ) * ( k - 2 ) * coef[k-1];
+        }
+      }
+      EXPECT_NEAR( xt, pos, 1.0e-12 );
+      EXPECT_NEAR( vt, vel, 1.0e-9 );
+      EXPECT_NEAR( at, acc, 1.0e-6 );
+    }
+  }
+}
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include "trapezoid_5251525_profile.hpp"
+#include "trapezoid_5251525.hpp"
+
+#include <math.h>
+
+using namespace interp;
+
+/// the number of sampled times to compare paths
+#define PROFILE_SAMPLE_NUM 500
+
+#ifdef SPLINE_CXX14
+/// homing move planned at compile time
+constexpr Trapezoid5251525Profile HOMING
+  = g_plan_trapezoid5251525( 1200, 1200, 170, 0.8, 0.8, 0.5,
+                             0.0, 0.0, 0.0, 100.0 );
+
+/// sampled table of the homing move baked at compile time
+constexpr Trapezoid5251525Table<101> HOMING_TABLE = g_bake_trapezoid5251525<101>( HOMING );
+#endif
+
+
+/// compare the profile with Trapezoid5251525 of the same inputs
+/// (Trapezoid5251525 is planned by the profile, so the paths are bitwise equal)
+static void expect_same_as_trapezoid( const double& ts, const double& tf,
+                                      const double& xs, const double& xf,
+                                      const double& vs, const double& vf ) {
+  Trapezoid5251525 trapezoid( 1200, 1200, 170, 0.8, 0.8, 0.5 );
+  trapezoid.generate_path( ts, tf, xs, xf, vs, vf );
+  Trapezoid5251525Profile profile( 1200, 1200, 170, 0.8, 0.8, 0.5 );
+  ASSERT_EQ( SPLINE_SUCCESS, profile.generate_path( ts, tf, xs, xf, vs, vf ) );
+  ASSERT_TRUE( profile.is_generated() );
+  EXPECT_EQ( trapezoid.no_movement(), profile.no_movement() );
+  EXPECT_EQ( trapezoid.finish_time(), profile.finish_time() );
+  if( !profile.no_movement() ) {
+    EXPECT_EQ( trapezoid.v_max(), profile.v_max() );
+  }
+
+  const double t0 = ts;
+  const double t7 = profile.finish_time();
+  for( std::size_t i=0; i <= PROFILE_SAMPLE_NUM; i++ ) {
+    const double t = t0 + ( t7 - t0 ) / PROFILE_SAMPLE_NUM * i;
+    double expected_x = 0.0, expected_v = 0.0, expected_a = 0.0;
+    trapezoid.pop( t, expected_x, expected_v, expected_a );
+    double x = 0.0, v = 0.0, a = 0.0;
+    ASSERT_EQ( SPLINE_SUCCESS, profile.evaluate( t, x, v, a ) );
+    ASSERT_EQ( expected_x, x );
+    ASSERT_EQ( expected_v, v );
+    ASSERT_EQ( expected_a, a );
+  }
+}
+
+
+TEST(Trapezoid5251525ProfileTest, same_as_trapezoid ) {
+  // fastest
+  expect_same_as_trapezoid( 0.0, 0.0, 0.0, 100.0, 0.0, 0.0 );
+  expect_same_as_trapezoid( 0.0, 0.0, 0.0, -3.0, 0.0, 0.0 );
+  expect_same_as_trapezoid( 1.0, 0.0, 5.0, 10.0, 20.0, -10.0 );
+  // given finish time
+  expect_same_as_trapezoid( 0.0, 2.0, 0.0, 100.0, 0.0, 0.0 );
+  expect_same_as_trapezoid( 1.0, 3.0, 0.0, -50.0, 10.0, 0.0 );
+  expect_same_as_trapezoid( 0.0, 1.0, 0.0, 1.0, 0.0, 5.0 );
+  // reversal of velocity
+  expect_same_as_trapezoid( 0.0, 0.0, 0.0, 1.0, -100.0, 0.0 );
+  expect_same_as_trapezoid( 0.0, 0.0, 0.0, 0.0, 50.0, 0.0 );
+  // no movement
+  expect_same_as_trapezoid( 0.0, 1.0, 2.0, 2.0, 0.0, 0.0 );
+}
+
+
+TEST(Trapezoid5251525ProfileTest, errors ) {
+  Trapezoid5251525Profile profile( 1200, 1200, 170, 0.8, 0.8, 0.5 );
+  double x = 0.0, v = 0.0, a = 0.0;
+  EXPECT_FALSE( profile.is_generated() );
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, profile.evaluate( 0.0, x, v, a ) );
+
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, profile.generate_path( -1.0, 1.0, 0.0, 1.0 ) );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, profile.generate_path( 2.0, 1.0, 0.0, 1.0 ) );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, profile.generate_path( 0.0, 1000.0, 0.0, 1.0 ) );
+  EXPECT_EQ( SPLINE_FAIL_TO_GENERATE_PATH, profile.generate_path( 0.0, 1.0, 0.0, 1.0, 200.0 ) );
+  // unreachable (the same input throws in Trapezoid5251525)
+  EXPECT_EQ( SPLINE_FAIL_TO_GENERATE_PATH, profile.generate_path( 0.0, 0.1, 0.0, 1.0e5 ) );
+  EXPECT_FALSE( profile.is_generated() );
+  Trapezoid5251525 trapezoid( 1200, 1200, 170, 0.8, 0.8, 0.5 );
+  EXPECT_ANY_THROW( trapezoid.generate_path( 0.0, 0.1, 0.0, 1.0e5, 0.0, 0.0 ) );
+
+  ASSERT_EQ( SPLINE_SUCCESS, profile.generate_path( 0.0, 1.0, 0.0, 1.0 ) );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, profile.evaluate( 1.1, x, v, a ) );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, profile.evaluate( -0.1, x, v, a ) );
+
+  // invalid configuration
+  Trapezoid5251525Profile invalid_profile( 1200, 1200, 170, 0.8, 0.8, 1.5 );
+  EXPECT_EQ( SPLINE_FAIL_TO_GENERATE_PATH, invalid_profile.generate_path( 0.0, 1.0, 0.0, 1.0 ) );
+}
+
+
+TEST(Trapezoid5251525ProfileTest, constexpr_math ) {
+  EXPECT_EQ( 0.0, g_constexpr_sqrt( 0.0 ) );
+  EXPECT_EQ( 0.0, g_constexpr_sqrt( -1.0 ) );
+  EXPECT_EQ( 3.0, g_constexpr_sqrt( 9.0 ) );
+  const double values[5] = { 1.0e-12, 0.5, 2.0, 1234.5678, 1.0e12 };
+  for( std::size_t i=0; i < 5; i++ ) {
+    EXPECT_NEAR( sqrt( values[i] ), g_constexpr_sqrt( values[i] ), 2.0e-16 * sqrt( values[i] ) );
+  }
+  EXPECT_EQ( 2.5, g_constexpr_fabs( -2.5 ) );
+}
+
+
+TEST(Trapezoid5251525ProfileTest, bake_table ) {
+  const Trapezoid5251525Profile profile
+    = g_plan_trapezoid5251525( 1200, 1200, 170, 0.8, 0.8, 0.5, 0.0, 0.0, 0.0, 100.0 );
+  ASSERT_TRUE( profile.is_generated() );
+  const Trapezoid5251525Table<101> table = g_bake_trapezoid5251525<101>( profile );
+  ASSERT_EQ( SPLINE_SUCCESS, table.status() );
+  EXPECT_EQ( 101u, table.size() );
+  EXPECT_EQ( 0.0, table.time( 0 ) );
+  EXPECT_EQ( profile.finish_time(), table.time( 100 ) );
+  EXPECT_EQ( 0.0, table.pos( 0 ) );
+  EXPECT_NEAR( 100.0, table.pos( 100 ), 1.0e-9 );
+  for( std::size_t i=0; i < table.size(); i++ ) {
+    double x = 0.0, v = 0.0, a = 0.0;
+    profile.evaluate( table.time( i ), x, v, a );
+    EXPECT_EQ( x, table.pos( i ) );
+    EXPECT_EQ( v, table.vel( i ) );
+    EXPECT_EQ( a, table.acc( i ) );
+  }
+
+  // not generated
+  const Trapezoid5251525Table<3> empty_table
+    = g_bake_trapezoid5251525<3>( Trapezoid5251525Profile() );
+  EXPECT_EQ( SPLINE_SEGMENT_NOT_GENERATED, empty_table.status() );
+}
+
+
+#ifdef SPLINE_CXX14
+TEST(Trapezoid5251525ProfileTest, compile_time_table ) {
+  static_assert( HOMING.is_generated(), "homing is planned at compile time" );
+  static_assert( HOMING_TABLE.status() == SPLINE_SUCCESS, "homing table is baked at compile time" );
+  static_assert( HOMING_TABLE.pos( 0 ) == 0.0, "start position" );
+  static_assert( HOMING_TABLE.pos( 100 ) > 100.0 - 1.0e-9 && HOMING_TABLE.pos( 100 ) < 100.0 + 1.0e-9,
+                 "finish position" );
+
+  Trapezoid5251525 trapezoid( 1200, 1200, 170, 0.8, 0.8, 0.5 );
+  trapezoid.generate_path( 0.0, 0.0, 0.0, 100.0, 0.0, 0.0 );
+  // the same planner evaluated at compile time
+  EXPECT_DOUBLE_EQ( trapezoid.finish_time(), HOMING_TABLE.time( 100 ) );
+  for( std::size_t i=0; i < HOMING_TABLE.size(); i++ ) {
+    double x = 0.0, v = 0.0, a = 0.0;
+    trapezoid.pop( HOMING_TABLE.time( i ), x, v, a );
+    EXPECT_DOUBLE_EQ( x, HOMING_TABLE.pos( i ) );
+    EXPECT_DOUBLE_EQ( v, HOMING_TABLE.vel( i ) );
+  }
+}
+#endif
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "waypoint_loader.hpp"
+
+#include <math.h>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace interp;
+
+
+TEST(WaypointLoaderTest, load_file ) {
+  WaypointLoader loader;
+  EXPECT_EQ( SPLINE_SUCCESS, loader.load_file( "test/data/teaching_points_5p.csv" ) );
+  EXPECT_EQ( 13, loader.column_size() );
+  ASSERT_EQ( 5,  loader.row_size() );
+  EXPECT_EQ( 0.15,       loader.value( 0, 0 ) );
+  EXPECT_EQ( -27.685954, loader.value( 0, 7 ) );
+  EXPECT_EQ( -30.939029, loader.value( 2, 12 ) );
+  EXPECT_EQ( 2, loader.line_of_row( 0 ) );
+  EXPECT_THROW( loader.value( 5, 0 ),  InvalidIndexAccess );
+  EXPECT_THROW( loader.value( 0, 13 ), InvalidIndexAccess );
+
+  EXPECT_EQ( SPLINE_FILE_IO_ERROR, loader.load_file( "test/data/not_exist.csv" ) );
+  EXPECT_EQ( 0, loader.row_size() );
+}
+
+
+TEST(WaypointLoaderTest, parse_number_same_as_strtod ) {
+  // fast path & fallback of strtod
+  const char* numbers[] = {
+    "0", "-0.5", "+3.25", "1e3", "1.5E-3", "0.1", "0.3", "123456.789012",
+    "-27.685954", "3.14159265358979323846", "9007199254740993", "1e-300", "2.5e+30",
+    ".5", "5.", "0.000000000000000000000000001"
+  };
+  const std::size_t number_num = sizeof(numbers) / sizeof(numbers[0]);
+  std::string text;
+  for( std::size_t i=0; i < number_num; i++ ) {
+    text += numbers[i];
+    text += ( i + 1 < number_num ) ? "," : "\n";
+  }
+  WaypointLoader loader;
+  EXPECT_EQ( SPLINE_SUCCESS, loader.load_string( text ) );
+  ASSERT_EQ( number_num, loader.column_size() );
+  for( std::size_t i=0; i < number_num; i++ ) {
+    EXPECT_EQ( std::strtod( numbers[i], NULL ), loader.value( 0, i ) ) << numbers[i];
+  }
+
+  // random numbers printed with 17 digits round trip
+  std::string random_text;
+  std::vector<double> expected;
+  srand( 1 );
+  for( std::size_t i=0; i < 1000; i++ ) {
+    const double value = ( rand() - RAND_MAX / 2 ) / 1024.0 / ( 1 + rand() % 1000 );
+    char buffer[64];
+    std::snprintf( buffer, sizeof(buffer), "%.17g\t%.6f\n", value, value );
+    random_text += buffer;
+    expected.push_back( value );
+  }
+  EXPECT_EQ( SPLINE_SUCCESS, loader.load_string( random_text ) );
+  ASSERT_EQ( 1000, loader.row_size() );
+  for( std::size_t i=0; i < expected.size(); i++ ) {
+    char buffer[64];
+    std::snprintf( buffer, sizeof(buffer), "%.6f", expected[i] );
+    ASSERT_EQ( expected[i],                      loader.value( i, 0 ) );
+    ASSERT_EQ( std::strtod( buffer, NULL ),      loader.value( i, 1 ) );
+  }
+}
+
+
+TEST(WaypointLoaderTest, build_queues ) {
+  const std::string text =
+    "# time, x, y, vx\r\n"
+    "0.0, 1.0, 2.0, 0.5\r\n"
+    "\r\n"
+    "  0.5 ,1.5 , 2.5,0.25\r\n"
+    "1.0\t2.0\t3.0\t0.0\r\n";
+  WaypointLoader loader;
+  EXPECT_EQ( SPLINE_SUCCESS, loader.load_string( text ) );
+  EXPECT_EQ( 3, loader.row_size() );
+  EXPECT_EQ( 4, loader.column_size() );
+  EXPECT_EQ( 4, loader.line_of_row( 1 ) );
+
+  TPQueue tp_queue;
+  EXPECT_EQ( SPLINE_SUCCESS, loader.to_tp_queue( 0, 2, tp_queue ) );
+  ASSERT_EQ( 3, tp_queue.size() );
+  EXPECT_EQ( 2.5, tp_queue.at( 1 ).value );
+  EXPECT_DOUBLE_EQ( 1.0, tp_queue.total_dT() );
+  EXPECT_DOUBLE_EQ( 0.5, tp_queue.dT( 1 ) );
+
+  TPVAQueue tpva_queue;
+  EXPECT_EQ( SPLINE_SUCCESS, loader.to_tpva_queue( 0, 1, tpva_queue, 3 ) );
+  EXPECT_EQ( 1.5,  tpva_queue.at( 1 ).P.pos );
+  EXPECT_EQ( 0.25, tpva_queue.at( 1 ).P.vel );
+  EXPECT_EQ( 0.0,  tpva_queue.at( 1 ).P.acc );
+
+  std::vector<std::size_t> columns;
+  columns.push_back( 1 );
+  columns.push_back( 2 );
+  TPVAListQueue tpva_list_queue;
+  EXPECT_EQ( SPLINE_SUCCESS, loader.to_tpva_list_queue( 0, columns, tpva_list_queue ) );
+  ASSERT_EQ( 3, tpva_list_queue.size() );
+  EXPECT_EQ( 2, tpva_list_queue.at( 2 ).value.size() );
+  EXPECT_EQ( 3.0, tpva_list_queue.at( 2 ).value[1].pos );
+
+  EXPECT_EQ( SPLINE_INVALID_INPUT_INDEX, loader.to_tp_queue( 4, 1, tp_queue ) );
+  EXPECT_EQ( SPLINE_INVALID_INPUT_INDEX, loader.to_tp_queue( 0, 4, tp_queue ) );
+}
+
+
+TEST(WaypointLoaderTest, error_line ) {
+  WaypointLoader loader;
+  // invalid number
+  EXPECT_EQ( SPLINE_INVALID_FILE_FORMAT,
+             loader.load_string( "# label\n0.0, 1.0\n0.1, 1.x\n" ) );
+  EXPECT_EQ( 3, loader.error_line() );
+  EXPECT_EQ( 0, loader.row_size() );
+  // empty field
+  EXPECT_EQ( SPLINE_INVALID_FILE_FORMAT, loader.load_string( "0.0,,1.0\n" ) );
+  EXPECT_EQ( 1, loader.error_line() );
+  // column size
+  EXPECT_EQ( SPLINE_INVALID_FILE_FORMAT,
+             loader.load_string( "0.0, 1.0\n\n0.1, 1.0\n0.2, 1.0, 3.0\n" ) );
+  EXPECT_EQ( 4, loader.error_line() );
+  // time
+  EXPECT_EQ( SPLINE_SUCCESS,
+             loader.load_string( "0.0, 1.0\n0.1, 1.0\n# comment\n0.1, 2.0\n" ) );
+  EXPECT_EQ( 0, loader.error_line() );
+  TPQueue tp_queue;
+  EXPECT_EQ( SPLINE_INVALID_INPUT_TIME, loader.to_tp_queue( 0, 1, tp_queue ) );
+  EXPECT_EQ( 4, loader.error_line() );
+  EXPECT_FALSE( loader.error_message().empty() );
+}
@@ -81,8 +81,7 @@ private:
 public:
   /// コンストラクタ
   /// @exception gnuplotを開けない場合エラー
-  Gnuplot()
-  throw(GnuplotException) {
+  Gnuplot() {
     this->set_signal(SIGINT);
     fp_ = popen(GNUPLOT_PATH, "w");
     if (fp_ == NULL) {
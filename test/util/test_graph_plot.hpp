@@ -3,6 +3,7 @@
 
 #include "spline_interpolator.hpp"
 #include "test/util/gnuplot_realtime.hpp"
+#include "trajectory_exporter.hpp"
 
 #include <fstream>
 
@@ -52,27 +53,21 @@ public:
            << prefix_file_label
            << "time-"<< prefix_pva_label <<"position-velocity-acceleration.csv";
 
-    std::ofstream ofstrm( numstr.str().c_str(), std::ios::out );
-    if (ofstrm.fail()) {
-      std::cerr << "cannot open output file: "<< numstr.str() << "." << std::endl;
-      FAIL();
-    }
-
-    // fix digit
-    ofstrm << std::fixed << std::setprecision(8);
-
     /////////////////////////////////////////////////////////////////////////
     /// output time-position-velocity-acceleration data into the text file
     /////////////////////////////////////////////////////////////////////////
-    for(std::size_t i=0; i < interp_path_tpva.size(); i++) {
-      ofstrm << interp_path_tpva.get(i).time      << ","
-             << interp_path_tpva.get(i).value.pos << ","
-             << interp_path_tpva.get(i).value.vel << ","
-             << interp_path_tpva.get(i).value.acc << std::endl;
+    TrajectoryExporter exporter;
+    if( exporter.open( numstr.str() ) != SPLINE_SUCCESS ) {
+      std::cerr << "cannot open output file: "<< numstr.str() << "." << std::endl;
+      FAIL();
     }
+    exporter.write( interp_path_tpva );
 
     numstr.str("");
-    ofstrm.close();
+    if( exporter.close() != SPLINE_SUCCESS ) {
+      std::cerr << "failed to write output file." << std::endl;
+      FAIL();
+    }
   }; // End of dump_csv()
 }; // End of class TestDumpCSV
 
@@ -0,0 +1,119 @@
+#ifndef INCLUDE_TEST_TRAJECTORIES_HPP_
+#define INCLUDE_TEST_TRAJECTORIES_HPP_
+
+#include <gtest/gtest.h>
+#include "cubic_spline_interpolator.hpp"
+#include "trapezoid_5251525_interpolator.hpp"
+
+#include <math.h>
+#include <vector>
+
+namespace interp {
+
+/// position of the point of the test trajectories (sine wave)
+/// @param[in] index index of the point
+/// @param[in] axis  index of the axis, i.e. phase of the positions (default: 0)
+/// @return 10 sin(0.7 index + 0.1 axis)
+inline double sine_position( const std::size_t& index, const std::size_t& axis=0 ) {
+  return 10.0 * sin( 0.7 * index + 0.1 * axis );
+}
+
+/// velocity of the point of the test trajectories, i.e. the derivative of sine_position() by index
+/// @param[in] index index of the point
+/// @return 7 cos(0.7 index)
+inline double sine_velocity( const std::size_t& index ) {
+  return 7.0 * cos( 0.7 * index );
+}
+
+/// make the target time & position queue on the sine wave
+/// @param[in] point_num the number of points
+/// @param[in] dT        interval time of the first segment [s] (default: 1.0)
+/// @param[in] dT_growth time of the point i is dT i + dT_growth i^2 (default: 0.0, uniform)
+/// @param[in] axis      index of the axis, i.e. phase of the positions (default: 0)
+/// @return the queue from 0.0 [s]
+inline TPQueue make_sine_tp_queue( const std::size_t& point_num,
+                                   const double&      dT=1.0,
+                                   const double&      dT_growth=0.0,
+                                   const std::size_t& axis=0 ) {
+  TPQueue tp_queue;
+  for( std::size_t i=0; i < point_num; i++ ) {
+    tp_queue.push( TimePosition( dT * i + dT_growth * i * i, sine_position( i, axis ) ) );
+  }
+  return tp_queue;
+}
+
+/// make the target time & PVA queue on the sine wave
+/// @param[in] point_num     the number of points
+/// @param[in] dT            uniform interval time [s] (default: 1.0)
+/// @param[in] with_velocity true: sine_velocity() at the points, false: stops at the points (default)
+/// @return the queue from 0.0 [s] with zero accelerations
+inline TPVAQueue make_sine_tpva_queue( const std::size_t& point_num,
+                                       const double&      dT=1.0,
+                                       const bool&        with_velocity=false ) {
+  TPVAQueue tpva_queue;
+  for( std::size_t i=0; i < point_num; i++ ) {
+    const double vel = with_velocity ? sine_velocity( i ) : 0.0;
+    tpva_queue.push_on_clocktime( dT * i, PosVelAcc( sine_position( i ), vel, 0.0 ) );
+  }
+  return tpva_queue;
+}
+
+/// make the configurations of the trapezoidal segments
+/// @param[in] segment_num the number of segments
+/// @return the same configuration (1200, 1200, 170, 0.8, 0.8, 0.5) for every segment
+inline TrapezoidConfigQueue make_trapezoid_config_queue( const std::size_t& segment_num ) {
+  return TrapezoidConfigQueue( segment_num, TrapezoidConfig( 1200, 1200, 170, 0.8, 0.8, 0.5 ) );
+}
+
+/// split the queue into the lists of times and positions
+/// @param[in]  tp_queue  source queue
+/// @param[out] times     times of the points
+/// @param[out] positions positions of the points
+inline void split_tp_queue( const TPQueue&       tp_queue,
+                            std::vector<double>& times,
+                            std::vector<double>& positions ) {
+  times.clear();
+  positions.clear();
+  for( std::size_t i=0; i < tp_queue.size(); i++ ) {
+    times.push_back( tp_queue.get( i ).time );
+    positions.push_back( tp_queue.get( i ).value );
+  }
+}
+
+/// make a generated cubic spline (stops at the start and the finish)
+/// @param[out] interpolator generated interpolator
+/// @param[in]  axis         index of the axis, i.e. phase of the positions (default: 0)
+/// @param[in]  is_uniform   true: uniform interval time 0.5 [s] (default: false)
+/// @details
+/// 10 points from 0.0 [s], with the interval times growing from 0.51 [s] to 0.67 [s]
+/// if not uniform.
+inline void make_cubic_spline( CubicSplineInterpolator& interpolator,
+                               const std::size_t&       axis=0,
+                               const bool&              is_uniform=false ) {
+  const TPQueue tp_queue = make_sine_tp_queue( 10, 0.5, is_uniform ? 0.0 : 0.01, axis );
+  ASSERT_EQ( SPLINE_SUCCESS, interpolator.generate_path( tp_queue ) );
+}
+
+/// make a generated trapezoidal path of one segment
+/// (accelerating, constant and decelerating phases)
+/// @param[out] interpolator generated interpolator
+/// @details from 0.0 to 500.0 in 4.0 [s]
+inline void make_trapezoidal( TrapezoidalInterpolator& interpolator ) {
+  TPVAQueue target_tpva_queue;
+  target_tpva_queue.push( 0.0, PosVelAcc( 0.0, 0.0, 0.0 ) );
+  target_tpva_queue.push( 4.0, PosVelAcc( 500.0, 0.0, 0.0 ) );
+  interpolator = TrapezoidalInterpolator( make_trapezoid_config_queue( 1 ) );
+  ASSERT_EQ( SPLINE_SUCCESS, interpolator.generate_path( target_tpva_queue ) );
+}
+
+/// make a generated trapezoidal path of several segments
+/// @param[out] interpolator generated interpolator
+/// @details 5 segments of 1.0 [s] through 6 points
+inline void make_trapezoidal_segments( TrapezoidalInterpolator& interpolator ) {
+  interpolator = TrapezoidalInterpolator( make_trapezoid_config_queue( 5 ) );
+  ASSERT_EQ( SPLINE_SUCCESS, interpolator.generate_path( make_sine_tpva_queue( 6 ) ) );
+}
+
+} // end of namespace interp
+
+#endif // INCLUDE_TEST_TRAJECTORIES_HPP_